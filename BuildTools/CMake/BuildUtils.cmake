@@ -466,6 +466,23 @@ function(add_format_validation_target MODULE_NAME MODULE_ROOT_PATH IDE_FOLDER)
 
 endfunction()
 
+# Adds a custom target that packs shader source files from SRC_DIR into DST_FILE.
+# The pack can be loaded by the packed shader source factory (see CreatePackedShaderSourceFactory).
+# Optional additional arguments specify the extensions of the files to pack (e.g. .fxh .hlsl).
+# If no extensions are given, all files in the directory are packed.
+function(add_shader_source_pack_target TARGET_NAME SRC_DIR DST_FILE)
+    find_package(Python3 REQUIRED)
+
+    file(GLOB_RECURSE PACK_SOURCE_FILES LIST_DIRECTORIES false "${SRC_DIR}/*")
+    add_custom_command(OUTPUT ${DST_FILE}
+                       COMMAND ${Python3_EXECUTABLE} ${SHADER_SOURCE_PACK_PATH} ${SRC_DIR} ${DST_FILE} ${ARGN}
+                       DEPENDS ${PACK_SOURCE_FILES} ${SHADER_SOURCE_PACK_PATH}
+                       COMMENT "Packing shader sources from ${SRC_DIR}"
+                       VERBATIM
+    )
+    add_custom_target(${TARGET_NAME} DEPENDS ${DST_FILE})
+endfunction()
+
 # FetchContent's GIT_SHALLOW option is buggy and does not actually do a shallow
 # clone. This macro takes care of it.
 macro(FetchContent_DeclareShallowGit Name GIT_REPOSITORY GitRepository GIT_TAG GitTag)
@@ -0,0 +1,117 @@
+# ----------------------------------------------------------------------------
+# Copyright 2019-2024 Diligent Graphics LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# In no event and under no legal theory, whether in tort (including negligence),
+# contract, or otherwise, unless required by applicable law (such as deliberate
+# and grossly negligent acts) or agreed to in writing, shall any Contributor be
+# liable for any damages, including any direct, indirect, special, incidental,
+# or consequential damages of any character arising as a result of this License or
+# out of the use or inability to use the software (including but not limited to damages
+# for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+# all other commercial damages or losses), even if such Contributor has been advised
+# of the possibility of such damages.
+# ----------------------------------------------------------------------------
+
+# Packs all files in a directory into a shader source pack that can be loaded
+# by the packed shader source factory (see CreatePackedShaderSourceFactory).
+#
+# Usage:
+#     script.py <source directory> <destination file> [<extension> ...]
+#
+# If extensions (e.g. .fxh .hlsl) are given, only the files with these extensions are packed.
+# File names in the pack are relative to the source directory and use forward slashes.
+#
+# The pack layout must match the one in Graphics/GraphicsTools/src/ShaderSourceFactoryUtils.cpp:
+#     | Magic | Version | NumFiles | Name 0 | Data 0 | ... | Name N-1 | Data N-1 |
+# All integers are 32-bit little-endian. A name is written as its length including the
+# null terminator followed by the null-terminated string. Data is written as its size
+# followed by the bytes that start at an offset aligned to 8 bytes.
+
+import os
+import struct
+import sys
+
+PACK_MAGIC = 0x50535344  # 'DSSP'
+PACK_VERSION = 1
+DATA_ALIGNMENT = 8
+
+
+def write_uint32(pack, value):
+    pack += struct.pack("<I", value)
+
+
+def write_string(pack, string):
+    data = string.encode("utf-8")
+    if len(data) == 0:
+        write_uint32(pack, 0)
+    else:
+        write_uint32(pack, len(data) + 1)
+        pack += data + b"\0"
+
+
+def write_bytes(pack, data):
+    write_uint32(pack, len(data))
+    pack += b"\0" * ((DATA_ALIGNMENT - len(pack) % DATA_ALIGNMENT) % DATA_ALIGNMENT)
+    pack += data
+
+
+def find_files(src_dir, extensions):
+    files = []
+    for root, _, file_names in os.walk(src_dir):
+        for file_name in file_names:
+            if extensions and os.path.splitext(file_name)[1].lower() not in extensions:
+                continue
+            path = os.path.join(root, file_name)
+            files.append((os.path.relpath(path, src_dir).replace(os.sep, "/"), path))
+    # Sort the files to make the pack deterministic
+    files.sort()
+    return files
+
+
+def main():
+    try:
+        if len(sys.argv) < 3:
+            raise ValueError("Incorrect number of command line arguments. Expected arguments: src directory, dst file, [extensions]")
+
+        src_dir = sys.argv[1]
+        dst_file = sys.argv[2]
+        extensions = set(ext.lower() if ext.startswith(".") else "." + ext.lower() for ext in sys.argv[3:])
+
+        if not os.path.isdir(src_dir):
+            raise ValueError("{} is not a directory".format(src_dir))
+
+        files = find_files(src_dir, extensions)
+
+        pack = bytearray()
+        write_uint32(pack, PACK_MAGIC)
+        write_uint32(pack, PACK_VERSION)
+        write_uint32(pack, len(files))
+        for name, path in files:
+            with open(path, "rb") as src_file:
+                data = src_file.read()
+            write_string(pack, name)
+            write_bytes(pack, data)
+
+        with open(dst_file, "wb") as dst:
+            dst.write(pack)
+
+        print("ShaderSourcePack: packed {} files from {} to {}".format(len(files), src_dir, dst_file))
+    except (ValueError, IOError) as error:
+        print(error)
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -32,17 +32,23 @@
 
 #include <vector>
 #include <cstring>
+#include <algorithm>
 
 #include "../../Primitives/interface/BasicTypes.h"
 #include "../../Primitives/interface/MemoryAllocator.h"
 #include "../../Platforms/Basic/interface/DebugUtilities.hpp"
 #include "CompilerDefinitions.h"
 #include "Align.hpp"
+#include "VirtualMemory.hpp"
 
 namespace Diligent
 {
 
 /// Implementation of a linear allocator on fixed memory pages
+///
+/// \remarks   Memory is allocated from the current block only; when it is exhausted, the allocator
+///            moves to the next block. All blocks past the current one are always empty, which allows
+///            rewinding the allocator to a previously obtained marker (see GetMarker() and RewindTo()).
 class DynamicLinearAllocator
 {
 public:
@@ -53,13 +59,30 @@ public:
     DynamicLinearAllocator& operator=(DynamicLinearAllocator&&)      = delete;
     // clang-format on
 
-    explicit DynamicLinearAllocator(IMemoryAllocator& Allocator, Uint32 BlockSize = 4 << 10) :
+    /// The size of the virtual address range that is reserved for one block
+    /// when the allocator uses virtual memory.
+    static constexpr size_t VirtualBlockReserveSize = size_t{2} << 20;
+
+    /// \param [in] Allocator        - Allocator that is used to allocate blocks.
+    /// \param [in] BlockSize        - Minimal block size, must be power of two.
+    /// \param [in] UseVirtualMemory - Whether to reserve large (VirtualBlockReserveSize) virtual address
+    ///                                ranges for blocks and commit memory in BlockSize chunks as it is used.
+    ///                                If virtual memory is not available, blocks are allocated with Allocator.
+    explicit DynamicLinearAllocator(IMemoryAllocator& Allocator, Uint32 BlockSize = 4 << 10, bool UseVirtualMemory = false) :
         m_BlockSize{BlockSize},
+        m_UseVirtualMemory{UseVirtualMemory},
         m_pAllocator{&Allocator}
     {
         VERIFY(IsPowerOfTwo(BlockSize), "Block size (", BlockSize, ") is not power of two");
     }
 
+    /// Position of the allocator that can be restored with RewindTo()
+    struct Marker
+    {
+        size_t BlockIndex = 0;
+        size_t Offset     = 0;
+    };
+
     ~DynamicLinearAllocator()
     {
         Free();
@@ -69,9 +92,13 @@ public:
     {
         for (Block& block : m_Blocks)
         {
-            m_pAllocator->Free(block.Data);
+            if (block.IsVirtual)
+                ReleaseVirtualMemory(block.Data, block.Size);
+            else
+                m_pAllocator->Free(block.Data);
         }
         m_Blocks.clear();
+        m_CurrBlock = 0;
 
         m_pAllocator = nullptr;
     }
@@ -82,6 +109,41 @@ public:
         {
             block.CurrPtr = block.Data;
         }
+        m_CurrBlock = 0;
+    }
+
+    /// Returns the current position of the allocator.
+    Marker GetMarker() const
+    {
+        if (m_Blocks.empty())
+            return {};
+
+        const Block& block = m_Blocks[m_CurrBlock];
+        return {m_CurrBlock, static_cast<size_t>(block.CurrPtr - block.Data)};
+    }
+
+    /// Releases all allocations made after the marker was obtained.
+
+    /// \remarks   The memory is not returned to the parent allocator and is reused by
+    ///            subsequent allocations.
+    void RewindTo(const Marker& M)
+    {
+        if (m_Blocks.empty())
+        {
+            VERIFY(M.BlockIndex == 0 && M.Offset == 0, "Invalid marker");
+            return;
+        }
+
+        VERIFY(M.BlockIndex <= m_CurrBlock, "The marker is ahead of the current allocator position");
+        for (size_t b = M.BlockIndex + 1; b <= m_CurrBlock; ++b)
+        {
+            m_Blocks[b].CurrPtr = m_Blocks[b].Data;
+        }
+
+        Block& block = m_Blocks[M.BlockIndex];
+        VERIFY(block.Data + M.Offset <= block.CurrPtr, "The marker is ahead of the current allocator position");
+        block.CurrPtr = block.Data + M.Offset;
+        m_CurrBlock   = M.BlockIndex;
     }
 
     NODISCARD void* Allocate(size_t size, size_t align)
@@ -89,26 +151,35 @@ public:
         if (size == 0)
             return nullptr;
 
-        for (Block& block : m_Blocks)
+        // Blocks past the current one are empty. If the allocation does not fit into the current block,
+        // try the next ones before creating a new block.
+        for (; m_CurrBlock < m_Blocks.size(); ++m_CurrBlock)
         {
-            uint8_t* Ptr = AlignUp(block.CurrPtr, align);
-            if (Ptr + size <= block.Data + block.Size)
-            {
-                block.CurrPtr = Ptr + size;
+            if (void* Ptr = m_Blocks[m_CurrBlock].Allocate(size, align, m_BlockSize))
                 return Ptr;
-            }
         }
 
         // Create a new block
-        size_t BlockSize = m_BlockSize;
-        while (BlockSize < size + align - 1)
-            BlockSize *= 2;
-        m_Blocks.emplace_back(m_pAllocator->Allocate(BlockSize, "dynamic linear allocator page", __FILE__, __LINE__), BlockSize);
-
-        Block&   block = m_Blocks.back();
-        uint8_t* Ptr   = AlignUp(block.Data, align);
-        VERIFY(Ptr + size <= block.Data + block.Size, "Not enough space in the new block - this is a bug");
-        block.CurrPtr = Ptr + size;
+        if (m_UseVirtualMemory)
+        {
+            size_t ReserveSize = VirtualBlockReserveSize;
+            while (ReserveSize < size + align - 1)
+                ReserveSize *= 2;
+            if (void* pData = ReserveVirtualMemory(ReserveSize))
+                m_Blocks.emplace_back(pData, ReserveSize, /*IsVirtual = */ true);
+        }
+
+        if (m_CurrBlock == m_Blocks.size())
+        {
+            size_t BlockSize = m_BlockSize;
+            while (BlockSize < size + align - 1)
+                BlockSize *= 2;
+            m_Blocks.emplace_back(m_pAllocator->Allocate(BlockSize, "dynamic linear allocator page", __FILE__, __LINE__), BlockSize, /*IsVirtual = */ false);
+        }
+
+        VERIFY_EXPR(m_CurrBlock + 1 == m_Blocks.size());
+        void* Ptr = m_Blocks.back().Allocate(size, align, m_BlockSize);
+        VERIFY(Ptr != nullptr || m_Blocks.back().IsVirtual, "Not enough space in the new block - this is a bug");
         return Ptr;
     }
 
@@ -208,17 +279,113 @@ public:
 private:
     struct Block
     {
-        uint8_t* const Data    = nullptr;
-        size_t const   Size    = 0;
-        uint8_t*       CurrPtr = nullptr;
+        uint8_t* const Data         = nullptr;
+        size_t const   Size         = 0;
+        uint8_t*       CurrPtr      = nullptr;
+        uint8_t*       CommittedEnd = nullptr;
+        bool const     IsVirtual    = false;
+
+        Block(void* _Data, size_t _Size, bool _IsVirtual) :
+            Data{static_cast<uint8_t*>(_Data)},
+            Size{_Size},
+            CurrPtr{Data},
+            CommittedEnd{_IsVirtual ? Data : Data + Size},
+            IsVirtual{_IsVirtual}
+        {}
+
+        void* Allocate(size_t size, size_t align, size_t CommitGranularity)
+        {
+            uint8_t* Ptr = AlignUp(CurrPtr, align);
+            if (Ptr + size > Data + Size)
+                return nullptr;
+
+            if (Ptr + size > CommittedEnd)
+            {
+                VERIFY_EXPR(IsVirtual);
+                CommitGranularity = AlignUp(CommitGranularity, GetVirtualMemoryPageSize());
+
+                uint8_t* NewCommittedEnd = Data + std::min(AlignUp(static_cast<size_t>(Ptr + size - Data), CommitGranularity), Size);
+                if (!CommitVirtualMemory(CommittedEnd, NewCommittedEnd - CommittedEnd))
+                    return nullptr;
+                CommittedEnd = NewCommittedEnd;
+            }
 
-        Block(void* _Data, size_t _Size) :
-            Data{static_cast<uint8_t*>(_Data)}, Size{_Size}, CurrPtr{Data} {}
+            CurrPtr = Ptr + size;
+            return Ptr;
+        }
     };
 
     std::vector<Block> m_Blocks;
-    const Uint32       m_BlockSize  = 4 << 10;
-    IMemoryAllocator*  m_pAllocator = nullptr;
+    size_t             m_CurrBlock        = 0;
+    const Uint32       m_BlockSize        = 4 << 10;
+    const bool         m_UseVirtualMemory = false;
+    IMemoryAllocator*  m_pAllocator       = nullptr;
+};
+
+/// Returns the dynamic linear allocator owned by the calling thread.
+
+/// \remarks   The allocator uses virtual memory and is never freed until the thread exits.
+///            Use ThreadScratchArena to release the memory allocated in a scope.
+DynamicLinearAllocator& GetThreadScratchAllocator();
+
+/// Scratch memory arena that uses the linear allocator owned by the calling thread.
+///
+/// All allocations made through the arena are released when the arena goes out of scope.
+/// Arenas may be nested, but only the innermost arena on the thread may be used to allocate memory.
+class ThreadScratchArena
+{
+public:
+    ThreadScratchArena() :
+        m_Allocator{GetThreadScratchAllocator()},
+        m_Marker{m_Allocator.GetMarker()}
+    {
+#ifdef DILIGENT_DEBUG
+        m_pParent           = GetInnermostArena();
+        GetInnermostArena() = this;
+#endif
+    }
+
+    ~ThreadScratchArena()
+    {
+#ifdef DILIGENT_DEBUG
+        VERIFY(GetInnermostArena() == this, "Scratch arenas must be destroyed in reverse order of creation");
+        GetInnermostArena() = m_pParent;
+#endif
+        m_Allocator.RewindTo(m_Marker);
+    }
+
+    // clang-format off
+    ThreadScratchArena           (const ThreadScratchArena&) = delete;
+    ThreadScratchArena           (ThreadScratchArena&&)      = delete;
+    ThreadScratchArena& operator=(const ThreadScratchArena&) = delete;
+    ThreadScratchArena& operator=(ThreadScratchArena&&)      = delete;
+    // clang-format on
+
+    DynamicLinearAllocator& Get()
+    {
+        VERIFY(GetInnermostArena() == this, "Only the innermost scratch arena may be used to allocate memory");
+        return m_Allocator;
+    }
+
+    DynamicLinearAllocator* operator->()
+    {
+        return &Get();
+    }
+
+private:
+#ifdef DILIGENT_DEBUG
+    static ThreadScratchArena*& GetInnermostArena()
+    {
+        static thread_local ThreadScratchArena* pInnermostArena = nullptr;
+        return pInnermostArena;
+    }
+#endif
+
+    DynamicLinearAllocator&              m_Allocator;
+    const DynamicLinearAllocator::Marker m_Marker;
+#ifdef DILIGENT_DEBUG
+    ThreadScratchArena* m_pParent = nullptr;
+#endif
 };
 
 } // namespace Diligent
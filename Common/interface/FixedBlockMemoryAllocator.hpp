@@ -39,15 +39,30 @@
 #include "../../Primitives/interface/Errors.hpp"
 #include "../../Primitives/interface/MemoryAllocator.h"
 #include "STDAllocator.hpp"
+#include "SpinLock.hpp"
 
 namespace Diligent
 {
 
 /// Memory allocator that allocates memory in a fixed-size chunks
+///
+/// \remarks   All pages are protected by a single mutex. When ThreadCacheSize is not zero, the allocator
+///            additionally keeps a small set of caches (magazines) of free blocks. Allocations and
+///            deallocations are served from the cache without taking the mutex, and blocks are moved
+///            between the cache and the pages in batches.
+///            The caches are striped rather than strictly per-thread: there is one cache per hardware
+///            thread (up to 64), and every thread uses the cache selected by its index. If there are
+///            more threads than caches, several threads share the same cache, which is why every
+///            cache is protected by a spin lock.
 class FixedBlockMemoryAllocator final : public IMemoryAllocator
 {
 public:
-    FixedBlockMemoryAllocator(IMemoryAllocator& RawMemoryAllocator, size_t BlockSize, Uint32 NumBlocksInPage);
+    /// \param [in] RawMemoryAllocator - Allocator that is used to allocate pages.
+    /// \param [in] BlockSize          - Block size.
+    /// \param [in] NumBlocksInPage    - The number of blocks in one page.
+    /// \param [in] ThreadCacheSize    - The maximum number of free blocks that every thread cache may
+    ///                                  keep. Zero disables thread caching.
+    FixedBlockMemoryAllocator(IMemoryAllocator& RawMemoryAllocator, size_t BlockSize, Uint32 NumBlocksInPage, Uint32 ThreadCacheSize = 0);
     ~FixedBlockMemoryAllocator();
 
     /// Allocates block of memory
@@ -62,6 +77,43 @@ public:
     /// Releases memory allocated with AllocateAligned
     virtual void FreeAligned(void* Ptr) override final;
 
+    /// Thread cache statistics
+    struct ThreadCacheStats
+    {
+        /// The number of allocations that were served from the thread cache.
+        Uint64 NumHits = 0;
+
+        /// The number of times the thread cache was refilled from the pages.
+        Uint64 NumRefills = 0;
+
+        /// The number of times the blocks were returned from the thread cache to the pages.
+        Uint64 NumFlushes = 0;
+
+        /// The total size of free blocks currently held in the thread cache.
+        size_t BytesHeld = 0;
+
+        ThreadCacheStats& operator+=(const ThreadCacheStats& rhs)
+        {
+            NumHits += rhs.NumHits;
+            NumRefills += rhs.NumRefills;
+            NumFlushes += rhs.NumFlushes;
+            BytesHeld += rhs.BytesHeld;
+            return *this;
+        }
+    };
+
+    /// Returns the statistics of the cache used by the calling thread.
+    /// Note that the cache may be shared with other threads.
+    ThreadCacheStats GetThreadCacheStats() const;
+
+    /// Returns the statistics accumulated over all thread caches.
+    ThreadCacheStats GetTotalThreadCacheStats() const;
+
+    /// Returns all blocks held by thread caches back to the pages.
+    void FlushThreadCaches();
+
+    Uint32 GetThreadCacheSize() const { return m_ThreadCacheSize; }
+
 private:
     // clang-format off
     FixedBlockMemoryAllocator             (const FixedBlockMemoryAllocator&) = delete;
@@ -72,6 +124,26 @@ private:
 
     void CreateNewPage();
 
+    // The following two methods must be called with m_Mutex locked
+    void* AllocateBlock();
+    void  FreeBlock(void* Ptr);
+
+    // The cache is selected by the thread index and may be shared by several threads
+    struct alignas(64) ThreadCache
+    {
+        Threading::SpinLock Lock;
+
+        // Free blocks are linked into a singly-linked list through their first bytes
+        void*  pHead     = nullptr;
+        Uint32 NumBlocks = 0;
+
+        ThreadCacheStats Stats;
+    };
+
+    ThreadCache& GetThreadCache() const;
+    void         RefillThreadCache(ThreadCache& Cache);
+    void         FlushThreadCache(ThreadCache& Cache, Uint32 NumBlocksToKeep);
+
     // Memory page class is based on the fixed-size memory pool described in "Fast Efficient Fixed-Size Memory Pool"
     // by Ben Kenwright
     class MemoryPage
@@ -122,6 +194,12 @@ private:
     IMemoryAllocator& m_RawMemoryAllocator;
     const size_t      m_BlockSize;
     const Uint32      m_NumBlocksInPage;
+    const Uint32      m_ThreadCacheSize;
+
+    // The number of thread caches is a power of two. Threads whose indices map
+    // to the same cache share it under the cache's spin lock.
+    Uint32       m_NumThreadCaches = 0;
+    ThreadCache* m_ThreadCaches    = nullptr;
 };
 
 IMemoryAllocator& GetRawAllocator();
@@ -150,6 +228,16 @@ public:
 #endif
         m_NumAllocationsInPage = NumAllocationsInPage;
     }
+    static void SetThreadCacheSize(Uint32 ThreadCacheSize)
+    {
+#ifdef DILIGENT_DEBUG
+        if (m_bPoolInitialized && m_ThreadCacheSize != ThreadCacheSize)
+        {
+            LOG_WARNING_MESSAGE("Setting pool thread cache size after the pool has been initialized has no effect");
+        }
+#endif
+        m_ThreadCacheSize = ThreadCacheSize;
+    }
     static ObjectPool& GetPool()
     {
         static ObjectPool ThePool;
@@ -185,10 +273,11 @@ public:
 
 private:
     static Uint32            m_NumAllocationsInPage;
+    static Uint32            m_ThreadCacheSize;
     static IMemoryAllocator* m_pRawAllocator;
 
     ObjectPool() :
-        m_FixedBlockAllocator(m_pRawAllocator ? *m_pRawAllocator : GetRawAllocator(), sizeof(ObjectType), m_NumAllocationsInPage)
+        m_FixedBlockAllocator(m_pRawAllocator ? *m_pRawAllocator : GetRawAllocator(), sizeof(ObjectType), m_NumAllocationsInPage, m_ThreadCacheSize)
     {}
 #ifdef DILIGENT_DEBUG
     static bool m_bPoolInitialized;
@@ -198,6 +287,9 @@ private:
 template <typename ObjectType>
 Uint32 ObjectPool<ObjectType>::m_NumAllocationsInPage = 64;
 
+template <typename ObjectType>
+Uint32 ObjectPool<ObjectType>::m_ThreadCacheSize = 0;
+
 template <typename ObjectType>
 IMemoryAllocator* ObjectPool<ObjectType>::m_pRawAllocator = nullptr;
 
@@ -208,6 +300,7 @@ bool ObjectPool<ObjectType>::m_bPoolInitialized = false;
 
 #define SET_POOL_RAW_ALLOCATOR(ObjectType, Allocator)        ObjectPool<ObjectType>::SetRawAllocator(Allocator)
 #define SET_POOL_PAGE_SIZE(ObjectType, NumAllocationsInPage) ObjectPool<ObjectType>::SetPageSize(NumAllocationsInPage)
+#define SET_POOL_THREAD_CACHE_SIZE(ObjectType, CacheSize)    ObjectPool<ObjectType>::SetThreadCacheSize(CacheSize)
 #define NEW_POOL_OBJECT(ObjectType, Desc, ...)               ObjectPool<ObjectType>::GetPool().NewObject(Desc, __FILE__, __LINE__, ##__VA_ARGS__)
 #define DESTROY_POOL_OBJECT(pObject)                         ObjectPool<std::remove_reference<decltype(*pObject)>::type>::GetPool().Destroy(pObject)
 
@@ -31,6 +31,7 @@
 
 #include "../../Primitives/interface/DataBlob.h"
 #include "../../Primitives/interface/FlagEnum.h"
+#include "ThreadPool.h"
 
 DILIGENT_BEGIN_NAMESPACE(Diligent)
 
@@ -107,6 +108,11 @@ struct GeometryPrimitiveAttributes
     /// per face.
     Uint32 NumSubdivisions DEFAULT_INITIALIZER(0);
 
+    /// An optional thread pool that is used to generate the geometry in parallel.
+
+    /// If the pointer is null, the geometry is generated by the calling thread.
+    IThreadPool* pThreadPool DEFAULT_INITIALIZER(nullptr);
+
 #if DILIGENT_CPP_INTERFACE
     GeometryPrimitiveAttributes() noexcept = default;
 
@@ -24,12 +24,89 @@
 #include <algorithm>
 #include <atomic>
 #include <vector>
+#include <array>
 
+#include "../../Primitives/interface/BasicTypes.h"
 #include "../../../DiligentCore/Platforms/Basic/interface/DebugUtilities.hpp"
 
 namespace Diligent
 {
 
+// Data wrapper that is used by LRUCache and ShardedLRUCache.
+// The wrapper makes sure that the data is initialized only once, while
+// the cache mutex is not locked.
+template <typename DataType>
+class LRUCacheDataWrapper
+{
+public:
+    enum class DataState
+    {
+        InitFailure = -1,
+        Default,
+        InitializedUnaccounted,
+        InitializedAccounted
+    };
+
+    template <typename InitDataType>
+    const DataType& GetData(InitDataType&& InitData, bool& IsNewObject) noexcept(false)
+    {
+        std::lock_guard<std::mutex> Lock{m_InitDataMtx};
+        if (m_DataSize == 0)
+        {
+            VERIFY_EXPR(m_State == DataState::Default || m_State == DataState::InitFailure);
+            m_State.store(DataState::Default); /* <F2D> */
+            try
+            {
+                size_t DataSize = 0;
+                InitData(m_Data, DataSize); // May throw
+                VERIFY_EXPR(DataSize > 0);
+                m_DataSize.store((std::max)(DataSize, size_t{1}));
+                m_State.store(DataState::InitializedUnaccounted); /* <D2U> */
+                IsNewObject = true;                               /* <NewObj> */
+            }
+            catch (...)
+            {
+                m_Data = {};
+                m_State.store(DataState::InitFailure); /* <D2F> */
+                throw;
+            }
+        }
+        else
+        {
+            VERIFY_EXPR(m_State == DataState::InitializedUnaccounted || m_State == DataState::InitializedAccounted);
+            VERIFY_EXPR(m_DataSize != 0);
+        }
+        return m_Data;
+    }
+
+    void SetAccounted()
+    {
+        VERIFY(m_State == DataState::InitializedUnaccounted, "Initializing accounted size for an object that is not initialized.");
+        VERIFY(m_AccountedSize == 0, "Accounted size has already been initialized.");
+        VERIFY(m_DataSize != 0, "Data size has not been initialized.");
+        m_AccountedSize.store(m_DataSize.load());
+        m_State.store(DataState::InitializedAccounted); /* <U2A> */
+    }
+
+    size_t GetAccountedSize() const
+    {
+        VERIFY_EXPR((m_State == DataState::InitializedAccounted && m_AccountedSize != 0) || (m_AccountedSize == 0));
+        return m_AccountedSize.load();
+    }
+
+    DataState GetState() const { return m_State; }
+
+private:
+    std::mutex m_InitDataMtx;
+    DataType   m_Data;
+
+    std::atomic<DataState> m_State{DataState::Default};
+
+    std::atomic<size_t> m_DataSize{0};
+    // The size that was accounted in the cache
+    std::atomic<size_t> m_AccountedSize{0};
+};
+
 /// A thread-safe and exception-safe LRU cache.
 
 /// Usage example:
@@ -242,76 +319,7 @@ public:
     }
 
 private:
-    class DataWrapper
-    {
-    public:
-        enum class DataState
-        {
-            InitFailure = -1,
-            Default,
-            InitializedUnaccounted,
-            InitializedAccounted
-        };
-
-        template <typename InitDataType>
-        const DataType& GetData(InitDataType&& InitData, bool& IsNewObject) noexcept(false)
-        {
-            std::lock_guard<std::mutex> Lock{m_InitDataMtx};
-            if (m_DataSize == 0)
-            {
-                VERIFY_EXPR(m_State == DataState::Default || m_State == DataState::InitFailure);
-                m_State.store(DataState::Default); /* <F2D> */
-                try
-                {
-                    size_t DataSize = 0;
-                    InitData(m_Data, DataSize); // May throw
-                    VERIFY_EXPR(DataSize > 0);
-                    m_DataSize.store((std::max)(DataSize, size_t{1}));
-                    m_State.store(DataState::InitializedUnaccounted); /* <D2U> */
-                    IsNewObject = true;                               /* <NewObj> */
-                }
-                catch (...)
-                {
-                    m_Data = {};
-                    m_State.store(DataState::InitFailure); /* <D2F> */
-                    throw;
-                }
-            }
-            else
-            {
-                VERIFY_EXPR(m_State == DataState::InitializedUnaccounted || m_State == DataState::InitializedAccounted);
-                VERIFY_EXPR(m_DataSize != 0);
-            }
-            return m_Data;
-        }
-
-        void SetAccounted()
-        {
-            VERIFY(m_State == DataState::InitializedUnaccounted, "Initializing accounted size for an object that is not initialized.");
-            VERIFY(m_AccountedSize == 0, "Accounted size has already been initialized.");
-            VERIFY(m_DataSize != 0, "Data size has not been initialized.");
-            m_AccountedSize.store(m_DataSize.load());
-            m_State.store(DataState::InitializedAccounted); /* <U2A> */
-        }
-
-        size_t GetAccountedSize() const
-        {
-            VERIFY_EXPR((m_State == DataState::InitializedAccounted && m_AccountedSize != 0) || (m_AccountedSize == 0));
-            return m_AccountedSize.load();
-        }
-
-        DataState GetState() const { return m_State; }
-
-    private:
-        std::mutex m_InitDataMtx;
-        DataType   m_Data;
-
-        std::atomic<DataState> m_State{DataState::Default};
-
-        std::atomic<size_t> m_DataSize{0};
-        // The size that was accounted in the cache
-        std::atomic<size_t> m_AccountedSize{0};
-    };
+    using DataWrapper = LRUCacheDataWrapper<DataType>;
 
     std::shared_ptr<DataWrapper> GetDataWrapper(const KeyType& Key)
     {
@@ -349,4 +357,272 @@ private:
     std::atomic<size_t> m_MaxSize{0};
 };
 
+
+/// A thread-safe and exception-safe LRU cache that is split into independent shards.
+
+/// The cache has the same interface and semantics as LRUCache: the data is initialized
+/// by the initializer function outside of the cache lock, and only once for every key.
+///
+/// The keys are distributed between NumShards shards, each protected by its own mutex, so
+/// that the threads that access different keys rarely contend for the same lock. Every shard
+/// keeps its entries in an intrusive doubly-linked LRU list, so that promoting an entry to the
+/// front of the list and evicting the least recently used entry are constant-time operations.
+///
+/// The maximum cache size is split evenly between the shards. Every shard evicts its own
+/// least recently used entries when its size exceeds its part of the budget.
+template <typename KeyType, typename DataType, typename KeyHasher = std::hash<KeyType>, size_t NumShards = 16>
+class ShardedLRUCache
+{
+public:
+    static_assert(NumShards > 0 && (NumShards & (NumShards - 1)) == 0, "The number of shards must be a power of two");
+
+    ShardedLRUCache() noexcept
+    {}
+
+    explicit ShardedLRUCache(size_t MaxSize) noexcept :
+        m_MaxSize{MaxSize}
+    {}
+
+    // clang-format off
+    ShardedLRUCache           (const ShardedLRUCache&) = delete;
+    ShardedLRUCache& operator=(const ShardedLRUCache&) = delete;
+    ShardedLRUCache           (ShardedLRUCache&&)      = delete;
+    ShardedLRUCache& operator=(ShardedLRUCache&&)      = delete;
+    // clang-format on
+
+    /// Finds the data in the cache and returns it. If the data is not found, it is atomically created
+    /// using the provided initializer.
+    ///
+    /// \param [in] Key      - The data key.
+    /// \param [in] InitData - Initializer function that is called if the data is not found in the cache.
+    ///
+    /// \return     Data with the specified key, either retrieved from the cache or initialized with
+    ///             the InitData function.
+    ///
+    /// \remarks    InitData function may throw in case of an error.
+    template <typename InitDataType>
+    DataType Get(const KeyType& Key,
+                 InitDataType&& InitData // May throw
+                 ) noexcept(false)
+    {
+        if (m_MaxSize.load() == 0 && m_CurrSize.load() == 0)
+        {
+            DataType Data;
+            size_t   DataSize = 0;
+            InitData(Data, DataSize); // May throw
+            return Data;
+        }
+
+        Shard& CacheShard = m_Shards[GetShardIndex(Key)];
+
+        // Get the data wrapper. Since this is a shared pointer, it may not be destroyed
+        // while we keep one, even if it is evicted from the cache by another thread.
+        auto pDataWrpr = CacheShard.GetDataWrapper(Key);
+        VERIFY_EXPR(pDataWrpr);
+
+        // Get data by value. It will be atomically initialized if necessary,
+        // while the shard mutex is not locked.
+        bool IsNewObject = false;
+        // InitData may throw, which will leave the wrapper in the cache in the 'InitFailure' state.
+        // It will be removed from the cache later when the shard is trimmed.
+        auto Data = pDataWrpr->GetData(std::forward<InitDataType>(InitData), IsNewObject);
+
+        std::vector<std::shared_ptr<DataWrapper>> DeleteList;
+        {
+            std::lock_guard<std::mutex> Lock{CacheShard.Mtx};
+
+            if (IsNewObject)
+            {
+                VERIFY_EXPR(pDataWrpr->GetState() == DataWrapper::DataState::InitializedUnaccounted);
+
+                // The wrapper may have been evicted by another thread while the mutex was released,
+                // and there may even be a new wrapper with the same key in the cache. Only account
+                // for the wrapper if it is still in the cache; otherwise it will be released when
+                // the function exits (see LRUCache::Get()).
+                auto it = CacheShard.Entries.find(Key);
+                if (it != CacheShard.Entries.end() && it->second.pWrpr == pDataWrpr)
+                {
+                    pDataWrpr->SetAccounted();
+
+                    const size_t AccountedSize = pDataWrpr->GetAccountedSize();
+                    CacheShard.CurrSize += AccountedSize;
+                    m_CurrSize.fetch_add(AccountedSize);
+                }
+            }
+
+            const size_t EvictedSize = CacheShard.Trim(GetShardMaxSize(), DeleteList);
+            VERIFY_EXPR(m_CurrSize.load() >= EvictedSize);
+            m_CurrSize.fetch_sub(EvictedSize);
+        }
+
+        // Delete objects after releasing the shard mutex
+        DeleteList.clear();
+
+        return Data;
+    }
+
+    /// Sets the maximum cache size.
+    void SetMaxSize(size_t MaxSize)
+    {
+        m_MaxSize = MaxSize;
+    }
+
+    /// Returns the current cache size.
+    size_t GetCurrSize() const
+    {
+        return m_CurrSize;
+    }
+
+    ~ShardedLRUCache()
+    {
+#ifdef DILIGENT_DEBUG
+        size_t DbgSize = 0;
+        for (const Shard& CacheShard : m_Shards)
+        {
+            size_t DbgShardSize = 0;
+            size_t NumEntries   = 0;
+            for (const Entry* pEntry = CacheShard.LRUHead.pNext; pEntry != &CacheShard.LRUHead; pEntry = pEntry->pNext)
+            {
+                DbgShardSize += pEntry->pWrpr->GetAccountedSize();
+                ++NumEntries;
+            }
+            VERIFY_EXPR(NumEntries == CacheShard.Entries.size());
+            VERIFY_EXPR(DbgShardSize == CacheShard.CurrSize);
+            DbgSize += DbgShardSize;
+        }
+        VERIFY_EXPR(DbgSize == m_CurrSize);
+#endif
+    }
+
+private:
+    using DataWrapper = LRUCacheDataWrapper<DataType>;
+
+    // Cache entry that is also a node of the intrusive LRU list
+    struct Entry
+    {
+        std::shared_ptr<DataWrapper> pWrpr;
+
+        // Points to the key stored in the hash map node
+        const KeyType* pKey = nullptr;
+
+        Entry* pPrev = nullptr;
+        Entry* pNext = nullptr;
+    };
+
+    struct alignas(64) Shard
+    {
+        std::mutex Mtx;
+
+        std::unordered_map<KeyType, Entry, KeyHasher> Entries;
+
+        // The sentinel node of the LRU list.
+        // LRUHead.pNext is the most recently used entry, LRUHead.pPrev is the least recently used one.
+        Entry LRUHead;
+
+        // The total accounted size of the entries in this shard
+        size_t CurrSize = 0;
+
+        Shard() noexcept
+        {
+            LRUHead.pPrev = &LRUHead;
+            LRUHead.pNext = &LRUHead;
+        }
+
+        // clang-format off
+        Shard           (const Shard&) = delete;
+        Shard& operator=(const Shard&) = delete;
+        // clang-format on
+
+        void Unlink(Entry& E)
+        {
+            E.pPrev->pNext = E.pNext;
+            E.pNext->pPrev = E.pPrev;
+        }
+
+        void PushFront(Entry& E)
+        {
+            E.pPrev              = &LRUHead;
+            E.pNext              = LRUHead.pNext;
+            LRUHead.pNext->pPrev = &E;
+            LRUHead.pNext        = &E;
+        }
+
+        std::shared_ptr<DataWrapper> GetDataWrapper(const KeyType& Key)
+        {
+            std::lock_guard<std::mutex> Lock{Mtx};
+
+            auto it = Entries.find(Key);
+            if (it == Entries.end())
+            {
+                it = Entries.emplace(Key, Entry{}).first;
+                // Hash map nodes are never relocated, so the pointers are stable
+                it->second.pWrpr = std::make_shared<DataWrapper>();
+                it->second.pKey  = &it->first;
+            }
+            else
+            {
+                Unlink(it->second);
+            }
+            PushFront(it->second);
+
+            return it->second.pWrpr;
+        }
+
+        // Evicts the least recently used entries until the shard size does not exceed MaxSize.
+        // Returns the total accounted size of the evicted entries.
+        // The mutex must be locked by the caller.
+        size_t Trim(size_t MaxSize, std::vector<std::shared_ptr<DataWrapper>>& DeleteList)
+        {
+            size_t EvictedSize = 0;
+            for (Entry* pEntry = LRUHead.pPrev; pEntry != &LRUHead && CurrSize > MaxSize;)
+            {
+                Entry* const pPrevEntry = pEntry->pPrev;
+
+                // See LRUCache::Get() for the state transition table and the reasoning below.
+                const auto State = pEntry->pWrpr->GetState();
+                if (State == DataWrapper::DataState::Default ||
+                    State == DataWrapper::DataState::InitializedUnaccounted)
+                {
+                    // The object is being initialized in another thread, or has been initialized
+                    // but has not been accounted for yet.
+                    pEntry = pPrevEntry;
+                    continue;
+                }
+
+                const size_t AccountedSize = pEntry->pWrpr->GetAccountedSize();
+                DeleteList.emplace_back(std::move(pEntry->pWrpr));
+                Unlink(*pEntry);
+                // NB: pKey points to the node that is being erased, so erase by iterator
+                Entries.erase(Entries.find(*pEntry->pKey));
+
+                VERIFY_EXPR(CurrSize >= AccountedSize);
+                CurrSize -= AccountedSize;
+                EvictedSize += AccountedSize;
+
+                pEntry = pPrevEntry;
+            }
+            return EvictedSize;
+        }
+    };
+
+    size_t GetShardIndex(const KeyType& Key) const
+    {
+        // Mix the hash so that the shard index does not correlate with the
+        // bucket index in the shard's hash map.
+        const Uint64 Hash = static_cast<Uint64>(KeyHasher{}(Key)) * Uint64{0x9E3779B97F4A7C15};
+        return static_cast<size_t>(Hash >> 32) & (NumShards - 1);
+    }
+
+    size_t GetShardMaxSize() const
+    {
+        return (m_MaxSize.load() + NumShards - 1) / NumShards;
+    }
+
+private:
+    std::array<Shard, NumShards> m_Shards;
+
+    std::atomic<size_t> m_CurrSize{0};
+    std::atomic<size_t> m_MaxSize{0};
+};
+
 } // namespace Diligent
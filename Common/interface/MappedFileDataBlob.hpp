@@ -0,0 +1,101 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Implementation of the IDataBlob interface for memory-mapped files
+
+#include "../../Primitives/interface/BasicTypes.h"
+#include "../../Primitives/interface/DataBlob.h"
+#include "ObjectBase.hpp"
+#include "RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Data blob that provides access to the contents of a file mapped into memory.
+///
+/// \remarks    The file is mapped copy-on-write: the data may be modified through GetDataPtr(),
+///             but the changes are never written back to the file.
+///             Pages are loaded by the operating system on first access, so creating the blob
+///             does not read the file.
+class MappedFileDataBlob final : public ObjectBase<IDataBlob>
+{
+public:
+    using TBase = ObjectBase<IDataBlob>;
+
+    /// Maps the file into memory.
+
+    /// \param [in] FilePath - Path to the file.
+    /// \param [in] Silent   - Whether to suppress error messages.
+    /// \return     The data blob with the file contents, or null if the file could not be opened.
+    ///
+    /// \remarks    On platforms that do not support memory-mapped files, or if mapping fails,
+    ///             the file is read into a regular data blob.
+    static RefCntAutoPtr<IDataBlob> Create(const Char* FilePath, bool Silent = false);
+
+    ~MappedFileDataBlob() override;
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_DataBlob, TBase)
+
+    /// Sets the size of the internal data buffer
+    virtual void DILIGENT_CALL_TYPE Resize(size_t NewSize) override final;
+
+    /// Returns the size of the internal data buffer
+    virtual size_t DILIGENT_CALL_TYPE GetSize() const override final
+    {
+        return m_Size;
+    }
+
+    /// Returns the pointer to the internal data buffer
+    virtual void* DILIGENT_CALL_TYPE GetDataPtr(size_t Offset = 0) override final
+    {
+        VERIFY(Offset < m_Size, "Offset (", Offset, ") exceeds the data size (", m_Size, ")");
+        return static_cast<Uint8*>(m_pData) + Offset;
+    }
+
+    /// Returns the pointer to the internal data buffer
+    virtual const void* DILIGENT_CALL_TYPE GetConstDataPtr(size_t Offset = 0) const override final
+    {
+        VERIFY(Offset < m_Size, "Offset (", Offset, ") exceeds the data size (", m_Size, ")");
+        return static_cast<const Uint8*>(m_pData) + Offset;
+    }
+
+private:
+    template <typename AllocatorType, typename ObjectType>
+    friend class MakeNewRCObj;
+
+    MappedFileDataBlob(IReferenceCounters* pRefCounters, void* pData, size_t Size, void* pMappingHandle) noexcept;
+
+private:
+    void* const  m_pData          = nullptr;
+    const size_t m_Size           = 0;
+    void* const  m_pMappingHandle = nullptr;
+};
+
+} // namespace Diligent
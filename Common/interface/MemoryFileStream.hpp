@@ -44,6 +44,9 @@ class MemoryFileStream final : public ObjectBase<IFileStream>
 public:
     typedef ObjectBase<IFileStream> TBase;
 
+    static constexpr INTERFACE_ID IID_InternalImpl =
+        {0x93b4346e, 0xf1ba, 0x4524, {0xae, 0xd7, 0x44, 0x22, 0xbf, 0x9a, 0x39, 0x97}};
+
     MemoryFileStream(IReferenceCounters* pRefCounters,
                      IDataBlob*          pData);
 
@@ -68,6 +71,14 @@ public:
 
     static RefCntAutoPtr<MemoryFileStream> Create(IDataBlob* pData);
 
+    /// Returns the data blob the stream reads from and writes to.
+    ///
+    /// \remarks   This allows the stream contents to be accessed without copying.
+    IDataBlob* GetDataBlob() const
+    {
+        return m_DataBlob;
+    }
+
 private:
     RefCntAutoPtr<IDataBlob> m_DataBlob;
     size_t                   m_CurrentOffset = 0;
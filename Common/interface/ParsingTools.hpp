@@ -34,6 +34,9 @@
 #include <limits>
 #include <vector>
 #include <algorithm>
+#include <iterator>
+#include <string>
+#include <type_traits>
 
 #include "../../Primitives/interface/BasicTypes.h"
 #include "../../Primitives/interface/FlagEnum.h"
@@ -76,6 +79,70 @@ inline bool IsDigit(Char Symbol) noexcept
     return Symbol >= '0' && Symbol <= '9';
 }
 
+/// Returns true if the character may be used in an identifier (a Latin letter, a digit or an underscore)
+inline bool IsIdentifierChar(Char Symbol) noexcept
+{
+    return (Symbol >= 'a' && Symbol <= 'z') || (Symbol >= 'A' && Symbol <= 'Z') || IsDigit(Symbol) || Symbol == '_';
+}
+
+
+/// Vectorized scanning functions for contiguous character strings.
+/// They are used by the functions below when the iterator type is a character pointer
+/// or a std::string iterator, and fall back to scalar loops on platforms without SIMD support.
+
+/// Returns the position of the first non-delimiter character (see IsDelimiter()).
+const char* SkipDelimitersFast(const char* Start, const char* End) noexcept;
+
+/// Returns the position of the first new line or null character.
+const char* FindLineEndFast(const char* Start, const char* End) noexcept;
+
+/// Returns the position of the first '*' or null character.
+const char* FindCommentMarkerFast(const char* Start, const char* End) noexcept;
+
+/// Returns the position of the first character that may not be used in an identifier (see IsIdentifierChar()).
+const char* SkipIdentifierCharsFast(const char* Start, const char* End) noexcept;
+
+
+/// Indicates if the iterator references contiguous character storage and can thus be
+/// processed by the vectorized scanning functions.
+template <typename IteratorType>
+struct IsContiguousCharIterator : std::integral_constant<bool, std::is_same<IteratorType, const char*>::value || std::is_same<IteratorType, char*>::value || std::is_same<IteratorType, std::string::const_iterator>::value || std::is_same<IteratorType, std::string::iterator>::value>
+{};
+
+template <typename IteratorType, typename FastScanFuncType, typename PredicateType>
+IteratorType ScanWhile(const IteratorType& Start, const IteratorType& End, FastScanFuncType FastScan, PredicateType, std::true_type) noexcept
+{
+    if (Start == End)
+        return Start;
+
+    const char* pStart = &*Start;
+    return Start + (FastScan(pStart, pStart + (End - Start)) - pStart);
+}
+
+template <typename IteratorType, typename FastScanFuncType, typename PredicateType>
+IteratorType ScanWhile(const IteratorType& Start, const IteratorType& End, FastScanFuncType, PredicateType Predicate, std::false_type) noexcept
+{
+    auto Pos = Start;
+    while (Pos != End && Predicate(*Pos))
+        ++Pos;
+    return Pos;
+}
+
+/// Skips all characters for which the predicate returns true.
+
+/// \param[in] Start     - starting position.
+/// \param[in] End       - end of the input string.
+/// \param[in] FastScan  - vectorized scanning function equivalent to the predicate
+///                        that is used for contiguous character iterators.
+/// \param[in] Predicate - predicate that is used for other iterator types.
+///
+/// \return      position of the first character for which the predicate returns false.
+template <typename IteratorType, typename FastScanFuncType, typename PredicateType>
+IteratorType ScanWhile(const IteratorType& Start, const IteratorType& End, FastScanFuncType FastScan, PredicateType Predicate) noexcept
+{
+    return ScanWhile(Start, End, FastScan, Predicate, IsContiguousCharIterator<IteratorType>{});
+}
+
 /// Skips all characters until the end of the line.
 
 /// \param[in] Start        - starting position.
@@ -91,9 +158,7 @@ inline bool IsDigit(Char Symbol) noexcept
 template <typename InteratorType>
 InteratorType SkipLine(const InteratorType& Start, const InteratorType& End, bool GoToNextLine = false) noexcept
 {
-    auto Pos = Start;
-    while (Pos != End && *Pos != '\0' && !IsNewLine(*Pos))
-        ++Pos;
+    auto Pos = ScanWhile(Start, End, FindLineEndFast, [](Char Symbol) { return Symbol != '\0' && !IsNewLine(Symbol); });
     if (GoToNextLine && Pos != End && IsNewLine(*Pos))
     {
         ++Pos;
@@ -179,31 +244,28 @@ InteratorType SkipComment(const InteratorType& Start, const InteratorType& End,
         ++Pos;
         //  /* Comment
         //    ^
-        while (Pos != End && *Pos != '\0')
+        while (true)
         {
-            if (*Pos == '*')
-            {
-                //  /* Comment */
-                //             ^
-                //             Pos
-                ++Pos;
+            Pos = ScanWhile(Pos, End, FindCommentMarkerFast, [](Char Symbol) { return Symbol != '\0' && Symbol != '*'; });
+            if (Pos == End || *Pos == '\0')
+                break;
 
-                if (Pos != End && *Pos == '/')
-                {
-                    //  /* Comment */
-                    //              ^
-                    //              Pos
+            //  /* Comment */
+            //             ^
+            //             Pos
+            ++Pos;
 
-                    ++Pos;
-                    //  /* Comment */
-                    //               ^
-                    //              Pos
-                    return Pos;
-                }
-            }
-            else
+            if (Pos != End && *Pos == '/')
             {
+                //  /* Comment */
+                //              ^
+                //              Pos
+
                 ++Pos;
+                //  /* Comment */
+                //               ^
+                //              Pos
+                return Pos;
             }
         }
 
@@ -230,8 +292,7 @@ InteratorType SkipDelimiters(const InteratorType& Start, const InteratorType& En
     }
     else
     {
-        while (Pos != End && IsDelimiter(*Pos))
-            ++Pos;
+        Pos = ScanWhile(Pos, End, SkipDelimitersFast, IsDelimiter);
     }
     return Pos;
 }
@@ -284,15 +345,12 @@ IteratorType SkipIdentifier(const IteratorType& Start, const IteratorType& End)
         return Start;
 
     auto Pos = Start;
-    if (isalpha(*Pos) || *Pos == '_')
+    if (IsIdentifierChar(*Pos) && !IsDigit(*Pos))
         ++Pos;
     else
         return Pos;
 
-    while (Pos != End && (isalnum(*Pos) || *Pos == '_'))
-        ++Pos;
-
-    return Pos;
+    return ScanWhile(Pos, End, SkipIdentifierCharsFast, IsIdentifierChar);
 }
 
 
@@ -567,13 +625,13 @@ std::string GetContext(const IteratorType& Start, const IteratorType& End, Itera
 
 /// Tokenizes the given string using the C-language syntax
 
-/// \param [in] SourceStart  - start of the source string.
-/// \param [in] SourceEnd    - end of the source string.
-/// \param [in] CreateToken  - a handler called every time a new token should
-///                            be created.
-/// \param [in] GetTokenType - a function that should return the token type
-///                            for the given literal.
-/// \return     Tokenized representation of the source string
+/// \param [in]  SourceStart  - start of the source string.
+/// \param [in]  SourceEnd    - end of the source string.
+/// \param [in]  CreateToken  - a handler called every time a new token should
+///                             be created.
+/// \param [in]  GetTokenType - a function that should return the token type
+///                             for the given literal.
+/// \param [out] Tokens       - container to append the tokens to.
 ///
 /// \remarks    In case of a parsing error, the function throws std::runtime_error.
 template <typename TokenClass,
@@ -581,14 +639,14 @@ template <typename TokenClass,
           typename IteratorType,
           typename CreateTokenFuncType,
           typename GetTokenTypeFunctType>
-ContainerType Tokenize(const IteratorType&   SourceStart,
-                       const IteratorType&   SourceEnd,
-                       CreateTokenFuncType   CreateToken,
-                       GetTokenTypeFunctType GetTokenType) noexcept(false)
+void Tokenize(const IteratorType&   SourceStart,
+              const IteratorType&   SourceEnd,
+              CreateTokenFuncType   CreateToken,
+              GetTokenTypeFunctType GetTokenType,
+              ContainerType&        Tokens) noexcept(false)
 {
     using TokenType = typename TokenClass::TokenType;
 
-    ContainerType Tokens;
     // Push empty node in the beginning of the list to facilitate
     // backwards searching
     Tokens.emplace_back(TokenClass{});
@@ -807,7 +865,31 @@ ContainerType Tokenize(const IteratorType&   SourceStart,
         LOG_ERROR_MESSAGE(ErrInfo.second, "\n", GetContext(SourceStart, SourceEnd, ErrInfo.first, NumContextLines));
         LOG_ERROR_AND_THROW("Unable to tokenize string.");
     }
+}
+
+/// Tokenizes the given string using the C-language syntax
 
+/// \param [in] SourceStart  - start of the source string.
+/// \param [in] SourceEnd    - end of the source string.
+/// \param [in] CreateToken  - a handler called every time a new token should
+///                            be created.
+/// \param [in] GetTokenType - a function that should return the token type
+///                            for the given literal.
+/// \return     Tokenized representation of the source string
+///
+/// \remarks    In case of a parsing error, the function throws std::runtime_error.
+template <typename TokenClass,
+          typename ContainerType,
+          typename IteratorType,
+          typename CreateTokenFuncType,
+          typename GetTokenTypeFunctType>
+ContainerType Tokenize(const IteratorType&   SourceStart,
+                       const IteratorType&   SourceEnd,
+                       CreateTokenFuncType   CreateToken,
+                       GetTokenTypeFunctType GetTokenType) noexcept(false)
+{
+    ContainerType Tokens;
+    Tokenize<TokenClass>(SourceStart, SourceEnd, CreateToken, GetTokenType, Tokens);
     return Tokens;
 }
 
@@ -1350,6 +1432,72 @@ inline void StripPreprocessorDirectives(std::string& Source, const std::vector<s
     }
 }
 
+/// Removes comments, leading and trailing white spaces, and empty lines from the source.
+
+/// \param[in] Start - start of the input string.
+/// \param[in] End   - end of the input string.
+///
+/// \return     the stripped source string. Every remaining line is terminated with '\n'.
+///
+/// Line breaks are only removed together with empty lines, so that preprocessor
+/// directives remain on separate lines. Multi-line comments are replaced with a single
+/// space, in the same way as the C preprocessor does.
+///
+/// \note  The function does not recognize string literals, so comment-like sequences
+///        inside strings are treated as comments.
+///
+/// In case of an error (e.g. `/*` is not closed), the function throws an exception
+/// of type `std::pair<IteratorType, const char*>`, see SkipComment().
+template <typename IteratorType>
+std::string StripCommentsAndEmptyLines(const IteratorType& Start, const IteratorType& End) noexcept(false)
+{
+    std::string Result;
+    Result.reserve(static_cast<size_t>(std::distance(Start, End)));
+
+    // Position of the current line start in the result string
+    size_t LineStart = 0;
+
+    auto EndLine = [&]() {
+        while (Result.size() > LineStart && IsWhitespace(Result.back()))
+            Result.pop_back();
+        if (Result.size() > LineStart)
+        {
+            Result.push_back('\n');
+            LineStart = Result.size();
+        }
+    };
+
+    auto Pos = Start;
+    while (Pos != End && *Pos != '\0')
+    {
+        const auto CommentEnd = SkipComment(Pos, End);
+        if (CommentEnd != Pos)
+        {
+            // Single-line comment also skips the new line
+            const bool IsSingleLine = *std::next(Pos) == '/';
+            Pos                     = CommentEnd;
+            if (IsSingleLine)
+                EndLine();
+            else if (Result.size() > LineStart)
+                Result.push_back(' ');
+            continue;
+        }
+
+        if (IsNewLine(*Pos))
+        {
+            EndLine();
+        }
+        else if (!IsWhitespace(*Pos) || Result.size() > LineStart)
+        {
+            Result.push_back(*Pos);
+        }
+        ++Pos;
+    }
+    EndLine();
+
+    return Result;
+}
+
 } // namespace Parsing
 
 } // namespace Diligent
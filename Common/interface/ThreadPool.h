@@ -119,6 +119,17 @@ DILIGENT_BEGIN_INTERFACE(IAsyncTask, IObject)
     ///         running the task or a deadlock will occur.
     VIRTUAL void METHOD(WaitForCompletion)(THIS) CONST PURE;
 
+    /// Waits until the task is complete or the timeout expires.
+
+    /// \param [in] TimeoutMicroseconds - The maximum time to wait, in microseconds.
+    ///
+    /// \return     true if the task is finished, and false if the timeout has expired.
+    ///
+    /// \note   This method must not be called from the same thread that is
+    ///         running the task or a deadlock will occur.
+    VIRTUAL bool METHOD(WaitForCompletionWithTimeout)(THIS_
+                                                      Uint64 TimeoutMicroseconds) CONST PURE;
+
     /// Waits until the tasks is running.
 
     /// \warning  An application is responsible to make sure that
@@ -134,15 +145,16 @@ DILIGENT_END_INTERFACE
 
 #if DILIGENT_C_INTERFACE
 
-#    define IAsyncTask_Run(This, ...)          CALL_IFACE_METHOD(AsyncTask, Run, This, __VA_ARGS__)
-#    define IAsyncTask_Cancel(This)            CALL_IFACE_METHOD(AsyncTask, Cancel, This)
-#    define IAsyncTask_SetStatus(This, ...)    CALL_IFACE_METHOD(AsyncTask, SetStatus, This, __VA_ARGS__)
-#    define IAsyncTask_GetStatus(This)         CALL_IFACE_METHOD(AsyncTask, GetStatus, This)
-#    define IAsyncTask_SetPriority(This, ...)  CALL_IFACE_METHOD(AsyncTask, SetPriority, This, __VA_ARGS__)
-#    define IAsyncTask_GetPriority(This)       CALL_IFACE_METHOD(AsyncTask, GetPriority, This)
-#    define IAsyncTask_IsFinished(This)        CALL_IFACE_METHOD(AsyncTask, IsFinished, This)
-#    define IAsyncTask_WaitForCompletion(This) CALL_IFACE_METHOD(AsyncTask, WaitForCompletion, This)
-#    define IAsyncTask_WaitUntilRunning(This)  CALL_IFACE_METHOD(AsyncTask, WaitUntilRunning, This)
+#    define IAsyncTask_Run(This, ...)                          CALL_IFACE_METHOD(AsyncTask, Run, This, __VA_ARGS__)
+#    define IAsyncTask_Cancel(This)                            CALL_IFACE_METHOD(AsyncTask, Cancel, This)
+#    define IAsyncTask_SetStatus(This, ...)                    CALL_IFACE_METHOD(AsyncTask, SetStatus, This, __VA_ARGS__)
+#    define IAsyncTask_GetStatus(This)                         CALL_IFACE_METHOD(AsyncTask, GetStatus, This)
+#    define IAsyncTask_SetPriority(This, ...)                  CALL_IFACE_METHOD(AsyncTask, SetPriority, This, __VA_ARGS__)
+#    define IAsyncTask_GetPriority(This)                       CALL_IFACE_METHOD(AsyncTask, GetPriority, This)
+#    define IAsyncTask_IsFinished(This)                        CALL_IFACE_METHOD(AsyncTask, IsFinished, This)
+#    define IAsyncTask_WaitForCompletion(This)                 CALL_IFACE_METHOD(AsyncTask, WaitForCompletion, This)
+#    define IAsyncTask_WaitForCompletionWithTimeout(This, ...) CALL_IFACE_METHOD(AsyncTask, WaitForCompletionWithTimeout, This, __VA_ARGS__)
+#    define IAsyncTask_WaitUntilRunning(This)                  CALL_IFACE_METHOD(AsyncTask, WaitUntilRunning, This)
 
 #endif
 
@@ -170,6 +182,11 @@ DILIGENT_BEGIN_INTERFACE(IThreadPool, IObject)
     ///
     /// Thread pool will keep a strong reference to the task,
     /// so an application is free to release it after enqueuing.
+    ///
+    /// If some prerequisites have been enqueued into the same pool and are not finished yet,
+    /// the task is kept aside and is only added to the queue when the last of them completes.
+    /// Prerequisites that are not in the pool (e.g. the tasks that run in another pool)
+    /// are checked every time the task is dequeued.
     /// 
     /// \note       An application must ensure that the task prerequisites are not circular
     ///             to avoid deadlocks.
@@ -220,7 +237,7 @@ DILIGENT_BEGIN_INTERFACE(IThreadPool, IObject)
     VIRTUAL void METHOD(WaitForAllTasks)(THIS) PURE;
 
 
-    /// Returns the current queue size.
+    /// Returns the current queue size, including the tasks that wait for their prerequisites.
     VIRTUAL Uint32 METHOD(GetQueueSize)(THIS) PURE;
 
     /// Returns the number of currently running tasks
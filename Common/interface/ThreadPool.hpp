@@ -34,6 +34,11 @@
 #include <atomic>
 #include <functional>
 #include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <vector>
+#include <initializer_list>
 
 #include "../../Platforms/Basic/interface/DebugUtilities.hpp"
 
@@ -61,6 +66,22 @@ struct ThreadPoolCreateInfo
     /// An optional function that will be called by the thread pool from
     /// the worker thread before the worker thread exits.
     std::function<void(Uint32)> OnThreadExiting = nullptr;
+
+    /// Whether to use the work-stealing scheduler.
+
+    /// By default, all tasks are kept in a single priority queue protected by one mutex.
+    /// When work stealing is enabled, every worker thread owns its own priority queue.
+    /// Tasks enqueued from a worker thread are placed into that thread's queue, while
+    /// tasks enqueued from other threads are distributed between the queues in a round-robin
+    /// fashion. A worker thread that runs out of tasks steals the highest-priority task from
+    /// the queues of other threads.
+    ///
+    /// If the pool is created with zero threads, the number of queues is defined by the number
+    /// of hardware threads, and the ThreadId passed to IThreadPool::ProcessTask() selects the queue.
+    ///
+    /// \note  In work-stealing mode, task priorities are only respected within each queue,
+    ///        so the tasks from different queues may start in any order.
+    bool EnableWorkStealing = false;
 };
 
 RefCntAutoPtr<IThreadPool> CreateThreadPool(const ThreadPoolCreateInfo& ThreadPoolCI);
@@ -136,6 +157,20 @@ public:
         }
 #endif
         m_TaskStatus.store(TaskStatus);
+
+        // NB: the status must be stored before the number of waiting threads is checked, while
+        //     WaitForStatus() increments the number of waiting threads before checking the status.
+        //     Since both are sequentially consistent, at least one of the threads is guaranteed to
+        //     see the other thread's modification.
+        if (m_NumWaitingThreads.load() > 0)
+        {
+            // Lock the mutex to make sure that the waiting thread is either not checking
+            // the status or is already waiting on the condition variable.
+            {
+                std::lock_guard<std::mutex> Lock{m_StatusMtx};
+            }
+            m_StatusChangedCond.notify_all();
+        }
     }
 
     virtual ASYNC_TASK_STATUS DILIGENT_CALL_TYPE GetStatus() const override final
@@ -162,22 +197,70 @@ public:
 
     virtual void DILIGENT_CALL_TYPE WaitForCompletion() const override final
     {
-        while (!IsFinished())
-            std::this_thread::yield();
+        WaitForStatus([this]() { return IsFinished(); });
+    }
+
+    virtual bool DILIGENT_CALL_TYPE WaitForCompletionWithTimeout(Uint64 TimeoutMicroseconds) const override final
+    {
+        return WaitForStatus([this]() { return IsFinished(); }, TimeoutMicroseconds);
     }
 
     virtual void DILIGENT_CALL_TYPE WaitUntilRunning() const override final
     {
-        while (GetStatus() == ASYNC_TASK_STATUS_NOT_STARTED)
-            std::this_thread::yield();
+        WaitForStatus([this]() { return GetStatus() != ASYNC_TASK_STATUS_NOT_STARTED; });
+    }
+
+protected:
+    // Resets the task to the initial state so that it can be enqueued again.
+    // The caller is responsible for making sure that the task is not referenced
+    // by any thread pool.
+    void ResetTask(float fPriority)
+    {
+        m_TaskStatus.store(ASYNC_TASK_STATUS_NOT_STARTED);
+        m_fPriority.store(fPriority);
+        m_bSafelyCancel.store(false);
     }
 
 protected:
     std::atomic<bool> m_bSafelyCancel{false};
 
+private:
+    // Blocks the calling thread until the predicate is satisfied or the timeout expires.
+    // Returns the predicate value.
+    template <typename PredicateType>
+    bool WaitForStatus(PredicateType Predicate, Uint64 TimeoutMicroseconds = ~Uint64{0}) const
+    {
+        if (Predicate())
+            return true;
+
+        // Timeouts that are too long to be represented by the steady clock are treated as infinite
+        constexpr Uint64 MaxTimeoutMicroseconds = Uint64{1} << 50;
+
+        std::unique_lock<std::mutex> Lock{m_StatusMtx};
+        m_NumWaitingThreads.fetch_add(1);
+        bool Result = true;
+        if (TimeoutMicroseconds < MaxTimeoutMicroseconds)
+        {
+            const std::chrono::microseconds Timeout{static_cast<std::chrono::microseconds::rep>(TimeoutMicroseconds)};
+            Result = m_StatusChangedCond.wait_for(Lock, Timeout, Predicate);
+        }
+        else
+        {
+            m_StatusChangedCond.wait(Lock, Predicate);
+        }
+        m_NumWaitingThreads.fetch_add(-1);
+        return Result;
+    }
+
 private:
     std::atomic<float>             m_fPriority{0};
     std::atomic<ASYNC_TASK_STATUS> m_TaskStatus{ASYNC_TASK_STATUS_NOT_STARTED};
+
+    // Threads that wait for the status change block on the condition variable
+    // instead of spinning.
+    mutable std::mutex              m_StatusMtx;
+    mutable std::condition_variable m_StatusChangedCond;
+    mutable std::atomic<int>        m_NumWaitingThreads{0};
 };
 
 
@@ -226,4 +309,140 @@ RefCntAutoPtr<IAsyncTask> EnqueueAsyncWork(IThreadPool* pThreadPool,
     return EnqueueAsyncWork(pThreadPool, nullptr, 0, std::move(Handler), fPriority);
 }
 
+
+/// Type-erased chunk handler used by Diligent::ParallelFor().
+using ParallelForChunkHandlerType = void (*)(void* pUserData, Uint32 ChunkBegin, Uint32 ChunkEnd);
+
+/// Non-template implementation of Diligent::ParallelFor().
+void ParallelFor(IThreadPool*                pThreadPool,
+                 Uint32                      RangeBegin,
+                 Uint32                      RangeEnd,
+                 Uint32                      Grain,
+                 ParallelForChunkHandlerType ChunkHandler,
+                 void*                       pUserData);
+
+/// Processes the range [RangeBegin, RangeEnd) in parallel using the thread pool.
+
+/// \param [in] pThreadPool - The thread pool. If it is null, the range is processed by the calling thread.
+/// \param [in] RangeBegin  - The first item of the range.
+/// \param [in] RangeEnd    - The item past the last item of the range.
+/// \param [in] Grain       - The number of items in one chunk. Chunk k covers the items
+///                           [RangeBegin + k * Grain, min(RangeBegin + (k + 1) * Grain, RangeEnd)).
+/// \param [in] Handler     - The function that processes one chunk:
+///
+///                               void Handler(Uint32 ChunkBegin, Uint32 ChunkEnd);
+///
+/// The chunks are distributed between the worker threads and the calling thread,
+/// which processes the chunks too rather than just waiting for the workers.
+/// The function returns when all chunks have been processed, so the handler may
+/// safely reference the local variables of the caller.
+///
+/// \remarks   The function may be called from the thread pool worker thread.
+///            The task objects that carry the chunks to the worker threads
+///            are taken from the per-thread pool and are not allocated for every call.
+template <typename HandlerType>
+void ParallelFor(IThreadPool* pThreadPool,
+                 Uint32       RangeBegin,
+                 Uint32       RangeEnd,
+                 Uint32       Grain,
+                 HandlerType  Handler)
+{
+    ParallelFor(
+        pThreadPool, RangeBegin, RangeEnd, Grain,
+        [](void* pUserData, Uint32 ChunkBegin, Uint32 ChunkEnd) {
+            (*static_cast<HandlerType*>(pUserData))(ChunkBegin, ChunkEnd);
+        },
+        &Handler);
+}
+
+
+/// Static task graph.
+
+/// The graph is built once by adding the nodes with their prerequisites and can then
+/// be executed by the thread pool any number of times. The prerequisites of every node
+/// must be added before the node itself, so the graph can't contain cycles.
+///
+/// The dependencies between the nodes are passed to IThreadPool::EnqueueTask(), so the
+/// nodes are only dequeued by the worker threads when all their prerequisites are finished.
+/// The task objects are reused between the executions.
+///
+/// \warning   The graph must not be modified or destroyed while it is being executed.
+///            The destructor waits for the execution to finish.
+class TaskGraph
+{
+public:
+    /// Node handler type. The argument is the id of the thread that runs the node.
+    using NodeHandlerType = std::function<void(Uint32 ThreadId)>;
+
+    /// Node index type.
+    using NodeIndex = Uint32;
+
+    TaskGraph() noexcept;
+    ~TaskGraph();
+
+    // clang-format off
+    TaskGraph           (const TaskGraph&) = delete;
+    TaskGraph& operator=(const TaskGraph&) = delete;
+    TaskGraph           (TaskGraph&&)      = delete;
+    TaskGraph& operator=(TaskGraph&&)      = delete;
+    // clang-format on
+
+    /// Adds a node to the graph.
+
+    /// \param [in] Handler          - The node handler.
+    /// \param [in] pPrerequisites   - Indices of the nodes that must finish before this node starts.
+    ///                                All prerequisites must have been added to the graph before.
+    /// \param [in] NumPrerequisites - The number of elements in the pPrerequisites array.
+    /// \param [in] fPriority        - The node task priority.
+    ///
+    /// \return     The index of the new node.
+    NodeIndex AddNode(NodeHandlerType  Handler,
+                      const NodeIndex* pPrerequisites   = nullptr,
+                      Uint32           NumPrerequisites = 0,
+                      float            fPriority        = 0);
+
+    NodeIndex AddNode(NodeHandlerType                  Handler,
+                      std::initializer_list<NodeIndex> Prerequisites,
+                      float                            fPriority = 0)
+    {
+        return AddNode(std::move(Handler), Prerequisites.begin(), static_cast<Uint32>(Prerequisites.size()), fPriority);
+    }
+
+    /// Enqueues all nodes of the graph into the thread pool and returns immediately.
+    void Execute(IThreadPool* pThreadPool);
+
+    /// Waits until all nodes of the graph are finished.
+
+    /// \note  This method must not be called from the worker thread
+    ///        of the thread pool that executes the graph.
+    void Wait() const;
+
+    /// Returns true if all nodes of the last execution are finished.
+    bool IsFinished() const;
+
+    /// Returns the task of the given node for the last execution, or null if
+    /// the graph has not been executed.
+    IAsyncTask* GetNodeTask(NodeIndex Node) const
+    {
+        return Node < m_Nodes.size() ? m_Nodes[Node].pTask.RawPtr() : nullptr;
+    }
+
+    /// Returns the number of nodes in the graph.
+    Uint32 GetNumNodes() const
+    {
+        return static_cast<Uint32>(m_Nodes.size());
+    }
+
+private:
+    struct NodeInfo
+    {
+        NodeHandlerType        Handler;
+        std::vector<NodeIndex> Prerequisites;
+        float                  fPriority = 0;
+
+        RefCntAutoPtr<IAsyncTask> pTask;
+    };
+    std::vector<NodeInfo> m_Nodes;
+};
+
 } // namespace Diligent
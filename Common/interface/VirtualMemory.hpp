@@ -0,0 +1,66 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Virtual memory reservation functions
+
+#include <cstddef>
+
+#include "../../Primitives/interface/BasicTypes.h"
+
+namespace Diligent
+{
+
+/// Returns the virtual memory page size.
+size_t GetVirtualMemoryPageSize();
+
+/// Reserves a range of virtual address space.
+
+/// \param [in] Size - The size of the range to reserve, must be a multiple of the page size.
+/// \return     The start of the reserved range, or null if virtual memory reservation
+///             is not supported on this platform or the reservation failed.
+///
+/// \remarks    Memory in the reserved range must be committed with CommitVirtualMemory()
+///             before it is accessed.
+void* ReserveVirtualMemory(size_t Size);
+
+/// Commits pages in the range previously reserved with ReserveVirtualMemory().
+
+/// \param [in] Ptr  - The start of the range to commit, must be page-aligned.
+/// \param [in] Size - The size of the range to commit.
+/// \return     true if the pages were committed successfully, and false otherwise.
+///
+/// \remarks    On platforms that provide physical pages on first access, this function
+///             does nothing.
+bool CommitVirtualMemory(void* Ptr, size_t Size);
+
+/// Releases the range previously reserved with ReserveVirtualMemory().
+void ReleaseVirtualMemory(void* Ptr, size_t Size);
+
+} // namespace Diligent
@@ -27,6 +27,8 @@
 
 #include "pch.h"
 #include <algorithm>
+#include <atomic>
+#include <thread>
 #include "FixedBlockMemoryAllocator.hpp"
 #include "Align.hpp"
 
@@ -169,16 +171,37 @@ static size_t AdjustBlockSize(size_t BlockSize)
     return AlignUp(BlockSize, sizeof(void*));
 }
 
+static Uint32 GetNumThreadCaches()
+{
+    constexpr Uint32 MaxThreadCaches = 64;
+
+    const Uint32 NumCores = std::max(std::thread::hardware_concurrency(), 1u);
+    Uint32       NumCaches{1};
+    while (NumCaches < NumCores && NumCaches < MaxThreadCaches)
+        NumCaches *= 2;
+    return NumCaches;
+}
+
+// Returns the index that is assigned to the calling thread when it first uses any thread-caching allocator.
+static Uint32 GetThreadIndex()
+{
+    static std::atomic<Uint32> NextThreadIndex{0};
+    thread_local const Uint32  ThreadIndex = NextThreadIndex.fetch_add(1, std::memory_order_relaxed);
+    return ThreadIndex;
+}
+
 FixedBlockMemoryAllocator::FixedBlockMemoryAllocator(IMemoryAllocator& RawMemoryAllocator,
                                                      size_t            BlockSize,
-                                                     Uint32            NumBlocksInPage) :
+                                                     Uint32            NumBlocksInPage,
+                                                     Uint32            ThreadCacheSize) :
     // clang-format off
     m_PagePool          (STD_ALLOCATOR_RAW_MEM(MemoryPage, RawMemoryAllocator, "Allocator for vector<MemoryPage>")),
     m_AvailablePages    (STD_ALLOCATOR_RAW_MEM(size_t, RawMemoryAllocator, "Allocator for unordered_set<size_t>") ),
     m_AddrToPageId      (STD_ALLOCATOR_RAW_MEM(AddrToPageIdMapElem, RawMemoryAllocator, "Allocator for unordered_map<void*, size_t>")),
     m_RawMemoryAllocator{RawMemoryAllocator        },
     m_BlockSize         {AdjustBlockSize(BlockSize)},
-    m_NumBlocksInPage   {NumBlocksInPage           }
+    m_NumBlocksInPage   {NumBlocksInPage           },
+    m_ThreadCacheSize   {BlockSize > 0 ? ThreadCacheSize : 0}
 // clang-format on
 {
     // Allocate one page
@@ -186,10 +209,30 @@ FixedBlockMemoryAllocator::FixedBlockMemoryAllocator(IMemoryAllocator& RawMemory
     {
         CreateNewPage();
     }
+
+    if (m_ThreadCacheSize > 0)
+    {
+        m_NumThreadCaches = GetNumThreadCaches();
+
+        void* pRawMem = m_RawMemoryAllocator.AllocateAligned(sizeof(ThreadCache) * m_NumThreadCaches, alignof(ThreadCache),
+                                                             "Memory for FixedBlockMemoryAllocator thread caches", __FILE__, __LINE__);
+
+        m_ThreadCaches = reinterpret_cast<ThreadCache*>(pRawMem);
+        for (Uint32 i = 0; i < m_NumThreadCaches; ++i)
+            new (m_ThreadCaches + i) ThreadCache{};
+    }
 }
 
 FixedBlockMemoryAllocator::~FixedBlockMemoryAllocator()
 {
+    if (m_ThreadCaches != nullptr)
+    {
+        FlushThreadCaches();
+        for (Uint32 i = 0; i < m_NumThreadCaches; ++i)
+            m_ThreadCaches[i].~ThreadCache();
+        m_RawMemoryAllocator.FreeAligned(m_ThreadCaches);
+    }
+
 #ifdef DILIGENT_DEBUG
     for (size_t p = 0; p < m_PagePool.size(); ++p)
     {
@@ -207,15 +250,8 @@ void FixedBlockMemoryAllocator::CreateNewPage()
     m_AddrToPageId.reserve(m_PagePool.size() * m_NumBlocksInPage);
 }
 
-void* FixedBlockMemoryAllocator::Allocate(size_t Size, const Char* dbgDescription, const char* dbgFileName, const Int32 dbgLineNumber)
+void* FixedBlockMemoryAllocator::AllocateBlock()
 {
-    VERIFY_EXPR(Size > 0);
-
-    Size = AdjustBlockSize(Size);
-    VERIFY(m_BlockSize == Size, "Requested size (", Size, ") does not match the block size (", m_BlockSize, ")");
-
-    std::lock_guard<std::mutex> LockGuard(m_Mutex);
-
     if (m_AvailablePages.empty())
     {
         CreateNewPage();
@@ -233,10 +269,9 @@ void* FixedBlockMemoryAllocator::Allocate(size_t Size, const Char* dbgDescriptio
     return Ptr;
 }
 
-void FixedBlockMemoryAllocator::Free(void* Ptr)
+void FixedBlockMemoryAllocator::FreeBlock(void* Ptr)
 {
-    std::lock_guard<std::mutex> LockGuard(m_Mutex);
-    auto                        PageIdIt = m_AddrToPageId.find(Ptr);
+    auto PageIdIt = m_AddrToPageId.find(Ptr);
     if (PageIdIt != m_AddrToPageId.end())
     {
         size_t PageId = PageIdIt->second;
@@ -259,6 +294,152 @@ void FixedBlockMemoryAllocator::Free(void* Ptr)
     }
 }
 
+FixedBlockMemoryAllocator::ThreadCache& FixedBlockMemoryAllocator::GetThreadCache() const
+{
+    // Thread caches are striped: threads whose indices are equal modulo the number of caches share the same cache
+    VERIFY_EXPR(m_ThreadCaches != nullptr && IsPowerOfTwo(m_NumThreadCaches));
+    return m_ThreadCaches[GetThreadIndex() & (m_NumThreadCaches - 1)];
+}
+
+void FixedBlockMemoryAllocator::RefillThreadCache(ThreadCache& Cache)
+{
+    VERIFY_EXPR(Cache.pHead == nullptr && Cache.NumBlocks == 0);
+
+    // Take half of the cache capacity so that the following frees do not immediately overflow it
+    const Uint32 NumBlocksToMove = std::max(m_ThreadCacheSize / 2, 1u);
+
+    std::lock_guard<std::mutex> LockGuard{m_Mutex};
+    for (Uint32 i = 0; i < NumBlocksToMove; ++i)
+    {
+        void* pBlock                      = AllocateBlock();
+        *reinterpret_cast<void**>(pBlock) = Cache.pHead;
+        Cache.pHead                       = pBlock;
+    }
+    Cache.NumBlocks = NumBlocksToMove;
+    ++Cache.Stats.NumRefills;
+}
+
+void FixedBlockMemoryAllocator::FlushThreadCache(ThreadCache& Cache, Uint32 NumBlocksToKeep)
+{
+    if (Cache.NumBlocks <= NumBlocksToKeep)
+        return;
+
+    std::lock_guard<std::mutex> LockGuard{m_Mutex};
+    while (Cache.NumBlocks > NumBlocksToKeep)
+    {
+        void* pBlock = Cache.pHead;
+        VERIFY_EXPR(pBlock != nullptr);
+        Cache.pHead = *reinterpret_cast<void**>(pBlock);
+        --Cache.NumBlocks;
+        FreeBlock(pBlock);
+    }
+    ++Cache.Stats.NumFlushes;
+}
+
+void* FixedBlockMemoryAllocator::Allocate(size_t Size, const Char* dbgDescription, const char* dbgFileName, const Int32 dbgLineNumber)
+{
+    VERIFY_EXPR(Size > 0);
+
+    Size = AdjustBlockSize(Size);
+    VERIFY(m_BlockSize == Size, "Requested size (", Size, ") does not match the block size (", m_BlockSize, ")");
+
+    if (m_ThreadCaches == nullptr)
+    {
+        std::lock_guard<std::mutex> LockGuard(m_Mutex);
+        return AllocateBlock();
+    }
+
+    ThreadCache& Cache = GetThreadCache();
+
+    std::lock_guard<Threading::SpinLock> CacheGuard{Cache.Lock};
+    if (Cache.pHead == nullptr)
+        RefillThreadCache(Cache);
+    else
+        ++Cache.Stats.NumHits;
+
+    void* Ptr   = Cache.pHead;
+    Cache.pHead = *reinterpret_cast<void**>(Ptr);
+    --Cache.NumBlocks;
+    FillWithDebugPattern(Ptr, MemoryPage::AllocatedBlockMemPattern, m_BlockSize);
+
+    return Ptr;
+}
+
+void FixedBlockMemoryAllocator::Free(void* Ptr)
+{
+    if (m_ThreadCaches == nullptr || Ptr == nullptr)
+    {
+        std::lock_guard<std::mutex> LockGuard(m_Mutex);
+        FreeBlock(Ptr);
+        return;
+    }
+
+#ifdef DILIGENT_DEBUG
+    {
+        // Blocks in the thread caches remain allocated from the pages' point of view,
+        // so the address must be in the allocations list.
+        std::lock_guard<std::mutex> LockGuard{m_Mutex};
+        VERIFY(m_AddrToPageId.find(Ptr) != m_AddrToPageId.end(),
+               "Address not found in the allocations list - double freeing memory or freeing memory not allocated by this allocator?");
+    }
+#endif
+
+    ThreadCache& Cache = GetThreadCache();
+
+    std::lock_guard<Threading::SpinLock> CacheGuard{Cache.Lock};
+    FillWithDebugPattern(Ptr, MemoryPage::DeallocatedBlockMemPattern, m_BlockSize);
+    *reinterpret_cast<void**>(Ptr) = Cache.pHead;
+    Cache.pHead                    = Ptr;
+    ++Cache.NumBlocks;
+    if (Cache.NumBlocks > m_ThreadCacheSize)
+    {
+        // Return the blocks to the pages in one batch, but keep half of the cache
+        // so that the following allocations do not immediately need a refill.
+        FlushThreadCache(Cache, m_ThreadCacheSize / 2);
+    }
+}
+
+FixedBlockMemoryAllocator::ThreadCacheStats FixedBlockMemoryAllocator::GetThreadCacheStats() const
+{
+    if (m_ThreadCaches == nullptr)
+        return {};
+
+    ThreadCache& Cache = GetThreadCache();
+
+    std::lock_guard<Threading::SpinLock> CacheGuard{Cache.Lock};
+
+    ThreadCacheStats Stats = Cache.Stats;
+    Stats.BytesHeld        = Cache.NumBlocks * m_BlockSize;
+    return Stats;
+}
+
+FixedBlockMemoryAllocator::ThreadCacheStats FixedBlockMemoryAllocator::GetTotalThreadCacheStats() const
+{
+    ThreadCacheStats TotalStats;
+    for (Uint32 i = 0; i < m_NumThreadCaches; ++i)
+    {
+        ThreadCache& Cache = m_ThreadCaches[i];
+
+        std::lock_guard<Threading::SpinLock> CacheGuard{Cache.Lock};
+
+        ThreadCacheStats Stats = Cache.Stats;
+        Stats.BytesHeld        = Cache.NumBlocks * m_BlockSize;
+        TotalStats += Stats;
+    }
+    return TotalStats;
+}
+
+void FixedBlockMemoryAllocator::FlushThreadCaches()
+{
+    for (Uint32 i = 0; i < m_NumThreadCaches; ++i)
+    {
+        ThreadCache& Cache = m_ThreadCaches[i];
+
+        std::lock_guard<Threading::SpinLock> CacheGuard{Cache.Lock};
+        FlushThreadCache(Cache, 0);
+    }
+}
+
 void* FixedBlockMemoryAllocator::AllocateAligned(size_t Size, size_t Alignment, const Char* dbgDescription, const char* dbgFileName, const Int32 dbgLineNumber)
 {
     VERIFY(Alignment <= sizeof(void*), "Alignment (", Alignment, ") exceeds the default alignment (", sizeof(void*), ")");
@@ -27,10 +27,12 @@
 #include "GeometryPrimitives.h"
 
 #include <array>
+#include <algorithm>
 
 #include "DebugUtilities.hpp"
 #include "BasicMath.hpp"
 #include "DataBlobImpl.hpp"
+#include "ThreadPool.hpp"
 
 namespace Diligent
 {
@@ -45,6 +47,7 @@ Uint32 GetGeometryPrimitiveVertexSize(GEOMETRY_PRIMITIVE_VERTEX_FLAGS VertexFlag
 template <typename VertexHandlerType>
 void CreateCubeGeometryInternal(Uint32                          NumSubdivisions,
                                 GEOMETRY_PRIMITIVE_VERTEX_FLAGS VertexFlags,
+                                IThreadPool*                    pThreadPool,
                                 IDataBlob**                     ppVertices,
                                 IDataBlob**                     ppIndices,
                                 GeometryPrimitiveInfo*          pInfo,
@@ -113,21 +116,28 @@ void CreateCubeGeometryInternal(Uint32                          NumSubdivisions,
         float3{0, 0, -1},
     };
 
-    for (Uint32 FaceIndex = 0; FaceIndex < NumFaces; ++FaceIndex)
-    {
-        if (pVert != nullptr)
+    // Every face is split into rows of vertices. Every row has its own range
+    // in the vertex and index buffers, so the rows can be processed in parallel.
+    const Uint32 NumFaceRows = NumSubdivisions + 1;
+
+    auto ProcessRows = [&](Uint32 RowBegin, Uint32 RowEnd) {
+        for (Uint32 Row = RowBegin; Row < RowEnd; ++Row)
         {
-            // 6 ______7______ 8
-            //  |    .'|    .'|
-            //  |  .'  |  .'  |
-            //  |.'____|.'____|
-            // 3|    .'|4   .'|5
-            //  |  .'  |  .'  |
-            //  |.'____|.'____|
-            // 0       1      2
-
-            for (Uint32 y = 0; y <= NumSubdivisions; ++y)
+            const Uint32 FaceIndex = Row / NumFaceRows;
+            const Uint32 y         = Row % NumFaceRows;
+
+            if (pVert != nullptr)
             {
+                // 6 ______7______ 8
+                //  |    .'|    .'|
+                //  |  .'  |  .'  |
+                //  |.'____|.'____|
+                // 3|    .'|4   .'|5
+                //  |  .'  |  .'  |
+                //  |.'____|.'____|
+                // 0       1      2
+
+                Uint8* pRowVert = pVert + (FaceIndex * NumFaceVertices + y * (NumSubdivisions + 1)) * VertexSize;
                 for (Uint32 x = 0; x <= NumSubdivisions; ++x)
                 {
                     float2 UV{
@@ -156,30 +166,28 @@ void CreateCubeGeometryInternal(Uint32                          NumSubdivisions,
 
                     if (VertexFlags & GEOMETRY_PRIMITIVE_VERTEX_FLAG_POSITION)
                     {
-                        memcpy(pVert, &Pos, sizeof(Pos));
-                        pVert += sizeof(Pos);
+                        memcpy(pRowVert, &Pos, sizeof(Pos));
+                        pRowVert += sizeof(Pos);
                     }
 
                     if (VertexFlags & GEOMETRY_PRIMITIVE_VERTEX_FLAG_NORMAL)
                     {
-                        memcpy(pVert, &Normal, sizeof(Normal));
-                        pVert += sizeof(Normal);
+                        memcpy(pRowVert, &Normal, sizeof(Normal));
+                        pRowVert += sizeof(Normal);
                     }
 
                     if (VertexFlags & GEOMETRY_PRIMITIVE_VERTEX_FLAG_TEXCOORD)
                     {
-                        memcpy(pVert, &UV, sizeof(UV));
-                        pVert += sizeof(UV);
+                        memcpy(pRowVert, &UV, sizeof(UV));
+                        pRowVert += sizeof(UV);
                     }
                 }
             }
-        }
 
-        if (pIdx != nullptr)
-        {
-            Uint32 FaceBaseVertex = FaceIndex * NumFaceVertices;
-            for (Uint32 y = 0; y < NumSubdivisions; ++y)
+            if (pIdx != nullptr && y < NumSubdivisions)
             {
+                Uint32  FaceBaseVertex = FaceIndex * NumFaceVertices;
+                Uint32* pRowIdx        = pIdx + FaceIndex * NumFaceIndices + y * NumSubdivisions * 6;
                 for (Uint32 x = 0; x < NumSubdivisions; ++x)
                 {
                     //  01     11
@@ -193,20 +201,21 @@ void CreateCubeGeometryInternal(Uint32                          NumSubdivisions,
                     Uint32 v01 = v00 + NumSubdivisions + 1;
                     Uint32 v11 = v01 + 1;
 
-                    *pIdx++ = v00;
-                    *pIdx++ = v10;
-                    *pIdx++ = v11;
+                    *pRowIdx++ = v00;
+                    *pRowIdx++ = v10;
+                    *pRowIdx++ = v11;
 
-                    *pIdx++ = v00;
-                    *pIdx++ = v11;
-                    *pIdx++ = v01;
+                    *pRowIdx++ = v00;
+                    *pRowIdx++ = v11;
+                    *pRowIdx++ = v01;
                 }
             }
         }
-    }
+    };
 
-    VERIFY_EXPR(pVert == nullptr || pVert == pVertexData->GetConstDataPtr<Uint8>() + VertexDataSize);
-    VERIFY_EXPR(pIdx == nullptr || pIdx == pIndexData->GetConstDataPtr<Uint32>() + IndexDataSize / sizeof(Uint32));
+    // Process about 4096 vertices per chunk
+    const Uint32 RowsPerChunk = std::max(4096u / NumFaceRows, 1u);
+    ParallelFor(pThreadPool, 0, NumFaces * NumFaceRows, RowsPerChunk, ProcessRows);
 }
 
 void CreateCubeGeometry(const CubeGeometryPrimitiveAttributes& Attribs,
@@ -223,6 +232,7 @@ void CreateCubeGeometry(const CubeGeometryPrimitiveAttributes& Attribs,
 
     CreateCubeGeometryInternal(Attribs.NumSubdivisions,
                                Attribs.VertexFlags,
+                               Attribs.pThreadPool,
                                ppVertices,
                                ppIndices,
                                pInfo,
@@ -245,6 +255,7 @@ void CreateSphereGeometry(const SphereGeometryPrimitiveAttributes& Attribs,
 
     CreateCubeGeometryInternal(Attribs.NumSubdivisions,
                                Attribs.VertexFlags,
+                               Attribs.pThreadPool,
                                ppVertices,
                                ppIndices,
                                pInfo,
@@ -0,0 +1,126 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "pch.h"
+#include "MappedFileDataBlob.hpp"
+#include "FileWrapper.hpp"
+
+#if PLATFORM_WIN32
+#    include "StringTools.hpp"
+#    include "WinHPreface.h"
+#    include <Windows.h>
+#    include "WinHPostface.h"
+#    define USE_WIN32_FILE_MAPPING 1
+#elif PLATFORM_LINUX || PLATFORM_MACOS || PLATFORM_IOS || PLATFORM_TVOS
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <fcntl.h>
+#    include <unistd.h>
+#    define USE_POSIX_FILE_MAPPING 1
+#endif
+
+namespace Diligent
+{
+
+MappedFileDataBlob::MappedFileDataBlob(IReferenceCounters* pRefCounters, void* pData, size_t Size, void* pMappingHandle) noexcept :
+    TBase{pRefCounters},
+    m_pData{pData},
+    m_Size{Size},
+    m_pMappingHandle{pMappingHandle}
+{
+}
+
+MappedFileDataBlob::~MappedFileDataBlob()
+{
+#if USE_WIN32_FILE_MAPPING
+    UnmapViewOfFile(m_pData);
+    CloseHandle(static_cast<HANDLE>(m_pMappingHandle));
+#elif USE_POSIX_FILE_MAPPING
+    munmap(m_pData, m_Size);
+#endif
+}
+
+void MappedFileDataBlob::Resize(size_t NewSize)
+{
+    UNEXPECTED("Resize is not supported by mapped file data blob.");
+}
+
+RefCntAutoPtr<IDataBlob> MappedFileDataBlob::Create(const Char* FilePath, bool Silent)
+{
+    if (FilePath == nullptr || FilePath[0] == '\0')
+    {
+        DEV_ERROR("File path must not be null or empty");
+        return {};
+    }
+
+#if USE_WIN32_FILE_MAPPING
+    {
+        const std::wstring WPath = WidenString(FilePath);
+
+        HANDLE hFile = CreateFileW(WPath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (hFile != INVALID_HANDLE_VALUE)
+        {
+            LARGE_INTEGER FileSize{};
+            HANDLE        hMapping = nullptr;
+            if (GetFileSizeEx(hFile, &FileSize) && FileSize.QuadPart > 0)
+                hMapping = CreateFileMappingW(hFile, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+            // The mapping keeps the file open
+            CloseHandle(hFile);
+
+            if (hMapping != nullptr)
+            {
+                if (void* pData = MapViewOfFile(hMapping, FILE_MAP_COPY, 0, 0, 0))
+                    return RefCntAutoPtr<IDataBlob>{MakeNewRCObj<MappedFileDataBlob>()(pData, static_cast<size_t>(FileSize.QuadPart), hMapping)};
+                CloseHandle(hMapping);
+            }
+        }
+    }
+#elif USE_POSIX_FILE_MAPPING
+    {
+        const int fd = open(FilePath, O_RDONLY);
+        if (fd >= 0)
+        {
+            void*       pData    = MAP_FAILED;
+            struct stat FileStat = {};
+            if (fstat(fd, &FileStat) == 0 && FileStat.st_size > 0)
+                pData = mmap(nullptr, static_cast<size_t>(FileStat.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+            // The mapping keeps the file open
+            close(fd);
+
+            if (pData != MAP_FAILED)
+                return RefCntAutoPtr<IDataBlob>{MakeNewRCObj<MappedFileDataBlob>()(pData, static_cast<size_t>(FileStat.st_size), nullptr)};
+        }
+    }
+#endif
+
+    // Memory mapping is not available or the file is empty - read the file
+    RefCntAutoPtr<IDataBlob> pData;
+    FileWrapper::ReadWholeFile(FilePath, &pData, Silent);
+    return pData;
+}
+
+} // namespace Diligent
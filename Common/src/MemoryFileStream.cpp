@@ -33,6 +33,8 @@
 namespace Diligent
 {
 
+constexpr INTERFACE_ID MemoryFileStream::IID_InternalImpl;
+
 RefCntAutoPtr<MemoryFileStream> MemoryFileStream::Create(IDataBlob* pData)
 {
     return RefCntAutoPtr<MemoryFileStream>{MakeNewRCObj<MemoryFileStream>()(pData)};
@@ -45,7 +47,7 @@ MemoryFileStream::MemoryFileStream(IReferenceCounters* pRefCounters,
 {
 }
 
-IMPLEMENT_QUERY_INTERFACE(MemoryFileStream, IID_FileStream, TBase)
+IMPLEMENT_QUERY_INTERFACE2(MemoryFileStream, IID_FileStream, IID_InternalImpl, TBase)
 
 bool MemoryFileStream::Read(void* Data, size_t Size)
 {
@@ -0,0 +1,160 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "ParsingTools.hpp"
+
+#include "PlatformMisc.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    include <emmintrin.h>
+#    define DILIGENT_PARSING_SSE2 1
+#endif
+
+namespace Diligent
+{
+
+namespace Parsing
+{
+
+#if DILIGENT_PARSING_SSE2
+
+namespace
+{
+
+// Each function returns a 16-bit mask where bit i is set if the i-th character
+// in the block should stop the scanning.
+
+inline int NonDelimiterMask(__m128i Chars)
+{
+    const __m128i IsDelim = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(Chars, _mm_set1_epi8(' ')),
+                                                      _mm_cmpeq_epi8(Chars, _mm_set1_epi8('\t'))),
+                                         _mm_or_si128(_mm_cmpeq_epi8(Chars, _mm_set1_epi8('\r')),
+                                                      _mm_cmpeq_epi8(Chars, _mm_set1_epi8('\n'))));
+    return _mm_movemask_epi8(IsDelim) ^ 0xFFFF;
+}
+
+inline int LineEndMask(__m128i Chars)
+{
+    const __m128i IsLineEnd = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(Chars, _mm_set1_epi8('\r')),
+                                                        _mm_cmpeq_epi8(Chars, _mm_set1_epi8('\n'))),
+                                           _mm_cmpeq_epi8(Chars, _mm_setzero_si128()));
+    return _mm_movemask_epi8(IsLineEnd);
+}
+
+inline int CommentMarkerMask(__m128i Chars)
+{
+    const __m128i IsMarker = _mm_or_si128(_mm_cmpeq_epi8(Chars, _mm_set1_epi8('*')),
+                                          _mm_cmpeq_epi8(Chars, _mm_setzero_si128()));
+    return _mm_movemask_epi8(IsMarker);
+}
+
+// Returns true for characters in [First, Last] range. Both bounds must be in [0, 127].
+inline __m128i InRange(__m128i Chars, char First, char Last)
+{
+    // Characters above 127 are negative and thus fail the first comparison
+    return _mm_and_si128(_mm_cmpgt_epi8(Chars, _mm_set1_epi8(static_cast<char>(First - 1))),
+                         _mm_cmplt_epi8(Chars, _mm_set1_epi8(static_cast<char>(Last + 1))));
+}
+
+inline int NonIdentifierMask(__m128i Chars)
+{
+    const __m128i IsIdentifierChar = _mm_or_si128(_mm_or_si128(InRange(Chars, 'a', 'z'),
+                                                               InRange(Chars, 'A', 'Z')),
+                                                  _mm_or_si128(InRange(Chars, '0', '9'),
+                                                               _mm_cmpeq_epi8(Chars, _mm_set1_epi8('_'))));
+    return _mm_movemask_epi8(IsIdentifierChar) ^ 0xFFFF;
+}
+
+// Scans the string in 16-byte blocks until the mask function reports a match.
+// Returns the position of the first match, or the start of the incomplete tail block.
+template <typename MaskFuncType>
+const char* ScanBlocks(const char* Pos, const char* End, MaskFuncType MaskFunc)
+{
+    while (End - Pos >= 16)
+    {
+        const int Mask = MaskFunc(_mm_loadu_si128(reinterpret_cast<const __m128i*>(Pos)));
+        if (Mask != 0)
+            return Pos + PlatformMisc::GetLSB(static_cast<Uint32>(Mask));
+        Pos += 16;
+    }
+    return Pos;
+}
+
+} // namespace
+
+#endif
+
+const char* SkipDelimitersFast(const char* Start, const char* End) noexcept
+{
+    const char* Pos = Start;
+    // Most delimiter runs are short, so check the first character before entering the vector loop
+    if (Pos == End || !IsDelimiter(*Pos))
+        return Pos;
+#if DILIGENT_PARSING_SSE2
+    Pos = ScanBlocks(Pos, End, NonDelimiterMask);
+#endif
+    while (Pos != End && IsDelimiter(*Pos))
+        ++Pos;
+    return Pos;
+}
+
+const char* FindLineEndFast(const char* Start, const char* End) noexcept
+{
+    const char* Pos = Start;
+#if DILIGENT_PARSING_SSE2
+    Pos = ScanBlocks(Pos, End, LineEndMask);
+#endif
+    while (Pos != End && *Pos != '\0' && !IsNewLine(*Pos))
+        ++Pos;
+    return Pos;
+}
+
+const char* FindCommentMarkerFast(const char* Start, const char* End) noexcept
+{
+    const char* Pos = Start;
+#if DILIGENT_PARSING_SSE2
+    Pos = ScanBlocks(Pos, End, CommentMarkerMask);
+#endif
+    while (Pos != End && *Pos != '\0' && *Pos != '*')
+        ++Pos;
+    return Pos;
+}
+
+const char* SkipIdentifierCharsFast(const char* Start, const char* End) noexcept
+{
+    const char* Pos = Start;
+#if DILIGENT_PARSING_SSE2
+    Pos = ScanBlocks(Pos, End, NonIdentifierMask);
+#endif
+    while (Pos != End && IsIdentifierChar(*Pos))
+        ++Pos;
+    return Pos;
+}
+
+} // namespace Parsing
+
+} // namespace Diligent
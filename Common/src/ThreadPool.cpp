@@ -33,8 +33,12 @@
 #include <vector>
 #include <condition_variable>
 #include <cfloat>
+#include <memory>
+#include <unordered_map>
+#include <array>
 
 #include "PlatformMisc.hpp"
+#include "SpinLock.hpp"
 
 namespace Diligent
 {
@@ -43,6 +47,389 @@ AsyncTaskBase::~AsyncTaskBase()
 {
 }
 
+namespace
+{
+
+struct QueuedTaskInfo
+{
+    RefCntAutoPtr<IAsyncTask> pTask;
+
+    // Prerequisites that are not tracked by the thread pool and must be polled
+    std::vector<RefCntWeakPtr<IAsyncTask>> Prerequisites;
+};
+
+// Priority queue
+using TaskQueueType = std::multimap<float, QueuedTaskInfo, std::greater<float>>;
+
+// Runs the task if all its prerequisites are met.
+// Returns true if the task is finished, and false if the task must be re-enqueued.
+bool RunQueuedTask(QueuedTaskInfo& TaskInfo, Uint32 ThreadId)
+{
+    // Check prerequisites
+    bool  PrerequisitesMet  = true;
+    float MinPrereqPriority = +FLT_MAX;
+    for (auto& pPrereq : TaskInfo.Prerequisites)
+    {
+        if (auto pPrereqTask = pPrereq.Lock())
+        {
+            if (!pPrereqTask->IsFinished())
+            {
+                PrerequisitesMet  = false;
+                MinPrereqPriority = std::min(MinPrereqPriority, pPrereqTask->GetPriority());
+            }
+        }
+    }
+
+    bool TaskFinished = false;
+    if (PrerequisitesMet)
+    {
+        TaskInfo.pTask->SetStatus(ASYNC_TASK_STATUS_RUNNING);
+        ASYNC_TASK_STATUS ReturnStatus = TaskInfo.pTask->Run(ThreadId);
+        // NB: It is essential to set the task status after the Run() method returns.
+        //     This way if the GetStatus() method returns any value other than ASYNC_TASK_STATUS_RUNNING,
+        //     it is guaranteed that the task is not executed by any thread.
+        TaskInfo.pTask->SetStatus(ReturnStatus);
+        TaskFinished = TaskInfo.pTask->IsFinished();
+        DEV_CHECK_ERR((TaskFinished || TaskInfo.pTask->GetStatus() == ASYNC_TASK_STATUS_NOT_STARTED),
+                      "Finished tasks must be in COMPLETE, CANCELLED or NOT_STARTED state");
+    }
+
+    if (!TaskFinished)
+    {
+        // If prerequisites are not met or the task requested to be re-run,
+        // the task will be re-enqueued with the minimum prerequisite priority
+        if (TaskInfo.pTask->GetPriority() > MinPrereqPriority)
+            TaskInfo.pTask->SetPriority(MinPrereqPriority);
+    }
+
+    return TaskFinished;
+}
+
+// Tracks dependencies between the tasks in the thread pool.
+//
+// Every task enqueued into the pool gets a node that keeps the list of its dependents
+// and the number of prerequisites that are not finished yet. A task with unfinished
+// prerequisites is kept in its node and is only added to the queue when the last
+// prerequisite completes, so that the worker threads never dequeue tasks that can't run.
+//
+// Prerequisites that are not tracked by the pool (e.g. the tasks that run in another pool
+// or have not been enqueued yet) are added to QueuedTaskInfo::Prerequisites and are polled
+// by RunQueuedTask().
+//
+// The nodes are distributed between the shards by the task pointer. Every shard is
+// protected by its own spin lock, and no two shard locks are ever held at the same time.
+class TaskDependencyTracker
+{
+public:
+    // Adds the task to the tracker.
+    // Returns true if the task is ready to run and must be added to the queue.
+    // Otherwise, the task is kept in the tracker until its prerequisites are finished.
+    bool AddTask(QueuedTaskInfo& TaskInfo, IAsyncTask** ppPrerequisites, Uint32 NumPrerequisites)
+    {
+        IAsyncTask* pTask = TaskInfo.pTask;
+
+        if (ppPrerequisites != nullptr && NumPrerequisites > 0)
+        {
+            float MinPrereqPriority = +FLT_MAX;
+            for (Uint32 i = 0; i < NumPrerequisites; ++i)
+            {
+                if (ppPrerequisites[i] != nullptr)
+                    MinPrereqPriority = std::min(MinPrereqPriority, ppPrerequisites[i]->GetPriority());
+            }
+            if (pTask->GetPriority() > MinPrereqPriority)
+            {
+                pTask->SetPriority(MinPrereqPriority);
+            }
+        }
+
+        TaskNode* pNode  = nullptr;
+        Uint64    NodeId = 0;
+        {
+            Shard&                   TaskShard = GetShard(pTask);
+            Threading::SpinLockGuard Guard{TaskShard.Lock};
+
+            // NB: if the task is already in the pool, keep its dependents
+            pNode = &TaskShard.Nodes[pTask];
+            DEV_CHECK_ERR(pNode->NumPendingPrerequisites.load() == 0, "The task is already waiting for its prerequisites");
+            NodeId = m_NextNodeId.fetch_add(1);
+            // The guard reference prevents the task from being released while
+            // we are processing its prerequisites.
+            pNode->NumPendingPrerequisites.store(1);
+            pNode->Id          = NodeId;
+            pNode->WaitingInfo = std::move(TaskInfo);
+        }
+
+        std::vector<RefCntWeakPtr<IAsyncTask>> PolledPrerequisites;
+        for (Uint32 i = 0; i < NumPrerequisites && ppPrerequisites != nullptr; ++i)
+        {
+            IAsyncTask* pPrereq = ppPrerequisites[i];
+            if (pPrereq == nullptr || pPrereq == pTask)
+                continue;
+
+            {
+                Shard&                   PrereqShard = GetShard(pPrereq);
+                Threading::SpinLockGuard Guard{PrereqShard.Lock};
+
+                auto it = PrereqShard.Nodes.find(pPrereq);
+                if (it != PrereqShard.Nodes.end())
+                {
+                    // The node is removed only after the prerequisite is finished, so it
+                    // is guaranteed that the task will be notified.
+                    it->second.Dependents.emplace_back(pTask, NodeId);
+                    pNode->NumPendingPrerequisites.fetch_add(1);
+                    continue;
+                }
+            }
+
+            if (!pPrereq->IsFinished())
+            {
+                // The prerequisite is not tracked by this pool
+                PolledPrerequisites.emplace_back(pPrereq);
+            }
+        }
+
+        Shard&                   TaskShard = GetShard(pTask);
+        Threading::SpinLockGuard Guard{TaskShard.Lock};
+        if (!PolledPrerequisites.empty())
+        {
+            auto& Prerequisites = pNode->WaitingInfo.Prerequisites;
+            Prerequisites.insert(Prerequisites.end(), std::make_move_iterator(PolledPrerequisites.begin()), std::make_move_iterator(PolledPrerequisites.end()));
+        }
+        // Release the guard reference
+        if (pNode->NumPendingPrerequisites.fetch_add(-1) == 1)
+        {
+            TaskInfo = std::move(pNode->WaitingInfo);
+            return true;
+        }
+
+        m_NumWaitingTasks.fetch_add(1);
+        return false;
+    }
+
+    // Removes the finished task from the tracker and calls EnqueueReadyTask
+    // for every dependent task that became ready to run.
+    template <typename EnqueueHandlerType>
+    void OnTaskFinished(IAsyncTask* pTask, EnqueueHandlerType&& EnqueueReadyTask)
+    {
+        std::vector<DependentInfo> Dependents;
+        {
+            Shard&                   TaskShard = GetShard(pTask);
+            Threading::SpinLockGuard Guard{TaskShard.Lock};
+
+            auto it = TaskShard.Nodes.find(pTask);
+            if (it == TaskShard.Nodes.end())
+                return;
+
+            Dependents = std::move(it->second.Dependents);
+            TaskShard.Nodes.erase(it);
+        }
+
+        ReleaseDependents(Dependents, nullptr, EnqueueReadyTask);
+    }
+
+    // Removes the task that is waiting for its prerequisites.
+    // Returns true if the task was found and removed, and false otherwise.
+    template <typename EnqueueHandlerType>
+    bool RemoveWaitingTask(IAsyncTask* pTask, EnqueueHandlerType&& EnqueueReadyTask)
+    {
+        return RemoveTask(pTask, /*WaitingOnly = */ true, EnqueueReadyTask);
+    }
+
+    // Removes the task that was removed from the queue.
+    template <typename EnqueueHandlerType>
+    void OnTaskRemoved(IAsyncTask* pTask, EnqueueHandlerType&& EnqueueReadyTask)
+    {
+        RemoveTask(pTask, /*WaitingOnly = */ false, EnqueueReadyTask);
+    }
+
+    // Returns true if the task is waiting for its prerequisites.
+    bool IsTaskWaiting(IAsyncTask* pTask)
+    {
+        Shard&                   TaskShard = GetShard(pTask);
+        Threading::SpinLockGuard Guard{TaskShard.Lock};
+
+        auto it = TaskShard.Nodes.find(pTask);
+        return it != TaskShard.Nodes.end() && it->second.NumPendingPrerequisites.load() > 0;
+    }
+
+    // Returns the number of tasks that are waiting for their prerequisites.
+    Uint32 GetNumWaitingTasks() const
+    {
+        return m_NumWaitingTasks.load();
+    }
+
+private:
+    struct DependentInfo
+    {
+        RefCntAutoPtr<IAsyncTask> pTask;
+        // Node id is used to detect the case when the dependent was removed
+        // and then enqueued again
+        Uint64 NodeId = 0;
+
+        DependentInfo(IAsyncTask* _pTask, Uint64 _NodeId) :
+            pTask{_pTask},
+            NodeId{_NodeId}
+        {}
+    };
+
+    struct TaskNode
+    {
+        Uint64                     Id = 0;
+        std::atomic<Uint32>        NumPendingPrerequisites{0};
+        QueuedTaskInfo             WaitingInfo;
+        std::vector<DependentInfo> Dependents;
+    };
+
+    // Align the shards to the cache line size to avoid false sharing
+    struct alignas(64) Shard
+    {
+        Threading::SpinLock                       Lock;
+        std::unordered_map<IAsyncTask*, TaskNode> Nodes;
+    };
+
+    Shard& GetShard(IAsyncTask* pTask)
+    {
+        // Discard the lower bits that are the same for all objects due to alignment
+        return m_Shards[(reinterpret_cast<size_t>(pTask) >> 6) % NumShards];
+    }
+
+    // Decrements the number of pending prerequisites of the dependent task.
+    // Returns true if the task became ready to run.
+    // If pRemovedPrereq is not null, the prerequisite was removed from the pool
+    // without being finished and must be polled.
+    bool ReleasePrerequisite(DependentInfo& Dependent, IAsyncTask* pRemovedPrereq, QueuedTaskInfo& ReadyTask)
+    {
+        Shard&                   DependentShard = GetShard(Dependent.pTask);
+        Threading::SpinLockGuard Guard{DependentShard.Lock};
+
+        auto it = DependentShard.Nodes.find(Dependent.pTask);
+        if (it == DependentShard.Nodes.end() || it->second.Id != Dependent.NodeId)
+            return false; // The dependent was removed
+
+        TaskNode& Node = it->second;
+        VERIFY_EXPR(Node.NumPendingPrerequisites.load() > 0);
+        if (pRemovedPrereq != nullptr)
+            Node.WaitingInfo.Prerequisites.emplace_back(pRemovedPrereq);
+
+        if (Node.NumPendingPrerequisites.fetch_add(-1) != 1)
+            return false;
+
+        ReadyTask = std::move(Node.WaitingInfo);
+        return true;
+    }
+
+    template <typename EnqueueHandlerType>
+    void ReleaseDependents(std::vector<DependentInfo>& Dependents, IAsyncTask* pRemovedPrereq, EnqueueHandlerType&& EnqueueReadyTask)
+    {
+        for (DependentInfo& Dependent : Dependents)
+        {
+            QueuedTaskInfo ReadyTask;
+            if (ReleasePrerequisite(Dependent, pRemovedPrereq, ReadyTask))
+            {
+                EnqueueReadyTask(std::move(ReadyTask));
+                // NB: the counter must be decremented after the task is added to the queue,
+                //     otherwise WaitForAllTasks() may find no tasks in the pool and return early.
+                m_NumWaitingTasks.fetch_add(-1);
+            }
+        }
+    }
+
+    template <typename EnqueueHandlerType>
+    bool RemoveTask(IAsyncTask* pTask, bool WaitingOnly, EnqueueHandlerType&& EnqueueReadyTask)
+    {
+        std::vector<DependentInfo> Dependents;
+        {
+            Shard&                   TaskShard = GetShard(pTask);
+            Threading::SpinLockGuard Guard{TaskShard.Lock};
+
+            auto it = TaskShard.Nodes.find(pTask);
+            if (it == TaskShard.Nodes.end())
+                return false;
+
+            const bool IsWaiting = it->second.NumPendingPrerequisites.load() > 0;
+            if (WaitingOnly && !IsWaiting)
+                return false;
+
+            Dependents = std::move(it->second.Dependents);
+            TaskShard.Nodes.erase(it);
+            if (IsWaiting)
+                m_NumWaitingTasks.fetch_add(-1);
+        }
+
+        // The dependents of the removed task will poll it as the task may be enqueued again
+        ReleaseDependents(Dependents, pTask, EnqueueReadyTask);
+
+        return true;
+    }
+
+private:
+    static constexpr size_t NumShards = 64;
+
+    std::array<Shard, NumShards> m_Shards;
+    std::atomic<Uint64>          m_NextNodeId{1};
+    std::atomic<Uint32>          m_NumWaitingTasks{0};
+};
+
+void ReprioritizeQueue(TaskQueueType& Queue, std::vector<std::pair<float, QueuedTaskInfo>>& ReprioritizationList)
+{
+    ReprioritizationList.clear();
+    for (auto it = Queue.begin(); it != Queue.end();)
+    {
+        QueuedTaskInfo& TaskInfo = it->second;
+        float           Priority = TaskInfo.pTask->GetPriority();
+        if (it->first != Priority)
+        {
+            ReprioritizationList.emplace_back(Priority, std::move(TaskInfo));
+            it = Queue.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    for (auto& it : ReprioritizationList)
+    {
+        Queue.emplace(it.first, std::move(it.second));
+    }
+
+    ReprioritizationList.clear();
+}
+
+TaskQueueType::iterator FindTask(TaskQueueType& Queue, IAsyncTask* pTask)
+{
+    auto it = Queue.begin();
+    while (it != Queue.end() && it->second.pTask != pTask)
+        ++it;
+    return it;
+}
+
+template <typename ThreadPoolImplType>
+std::vector<std::thread> StartWorkerThreads(ThreadPoolImplType& ThreadPool, const ThreadPoolCreateInfo& PoolCI)
+{
+    std::vector<std::thread> WorkerThreads;
+    WorkerThreads.reserve(PoolCI.NumThreads);
+    for (Uint32 i = 0; i < PoolCI.NumThreads; ++i)
+    {
+        WorkerThreads.emplace_back(
+            [&ThreadPool, PoolCI, i] //
+            {
+                if (PoolCI.OnThreadStarted)
+                    PoolCI.OnThreadStarted(i);
+
+                while (ThreadPool.ProcessTask(i, /*WaitForTask =*/true))
+                {
+                }
+
+                if (PoolCI.OnThreadExiting)
+                    PoolCI.OnThreadExiting(i);
+            });
+    }
+    return WorkerThreads;
+}
+
+} // namespace
+
 class ThreadPoolImpl final : public ObjectBase<IThreadPool>
 {
 public:
@@ -52,23 +439,7 @@ public:
                    const ThreadPoolCreateInfo& PoolCI) :
         TBase{pRefCounters}
     {
-        m_WorkerThreads.reserve(PoolCI.NumThreads);
-        for (Uint32 i = 0; i < PoolCI.NumThreads; ++i)
-        {
-            m_WorkerThreads.emplace_back(
-                [this, PoolCI, i] //
-                {
-                    if (PoolCI.OnThreadStarted)
-                        PoolCI.OnThreadStarted(i);
-
-                    while (ProcessTask(i, /*WaitForTask =*/true))
-                    {
-                    }
-
-                    if (PoolCI.OnThreadExiting)
-                        PoolCI.OnThreadExiting(i);
-                });
-        }
+        m_WorkerThreads = StartWorkerThreads(*this, PoolCI);
     }
 
     IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_ThreadPool, TBase)
@@ -112,33 +483,13 @@ public:
 
         if (TaskInfo.pTask)
         {
-            // Check prerequisites
-            bool  PrerequisitesMet  = true;
-            float MinPrereqPriority = +FLT_MAX;
-            for (auto& pPrereq : TaskInfo.Prerequisites)
+            const bool TaskFinished = RunQueuedTask(TaskInfo, ThreadId);
+            if (TaskFinished)
             {
-                if (auto pPrereqTask = pPrereq.Lock())
-                {
-                    if (!pPrereqTask->IsFinished())
-                    {
-                        PrerequisitesMet  = false;
-                        MinPrereqPriority = std::min(MinPrereqPriority, pPrereqTask->GetPriority());
-                    }
-                }
-            }
-
-            bool TaskFinished = false;
-            if (PrerequisitesMet)
-            {
-                TaskInfo.pTask->SetStatus(ASYNC_TASK_STATUS_RUNNING);
-                ASYNC_TASK_STATUS ReturnStatus = TaskInfo.pTask->Run(ThreadId);
-                // NB: It is essential to set the task status after the Run() method returns.
-                //     This way if the GetStatus() method returns any value other than ASYNC_TASK_STATUS_RUNNING,
-                //     it is guaranteed that the task is not executed by any thread.
-                TaskInfo.pTask->SetStatus(ReturnStatus);
-                TaskFinished = TaskInfo.pTask->IsFinished();
-                DEV_CHECK_ERR((TaskFinished || TaskInfo.pTask->GetStatus() == ASYNC_TASK_STATUS_NOT_STARTED),
-                              "Finished tasks must be in COMPLETE, CANCELLED or NOT_STARTED state");
+                m_DependencyTracker.OnTaskFinished(TaskInfo.pTask,
+                                                   [this](QueuedTaskInfo&& ReadyTask) {
+                                                       EnqueueReadyTask(std::move(ReadyTask));
+                                                   });
             }
 
             {
@@ -148,17 +499,13 @@ public:
 
                 if (TaskFinished)
                 {
-                    if (m_TasksQueue.empty() && NumRunningTasks == 0)
+                    if (m_TasksQueue.empty() && NumRunningTasks == 0 && m_DependencyTracker.GetNumWaitingTasks() == 0)
                     {
                         m_TasksFinishedCond.notify_one();
                     }
                 }
                 else
                 {
-                    // If prerequisites are not met or the task requested to be re-run,
-                    // re-enqueue the task with the minimum prerequisite priority
-                    if (TaskInfo.pTask->GetPriority() > MinPrereqPriority)
-                        TaskInfo.pTask->SetPriority(MinPrereqPriority);
                     m_TasksQueue.emplace(TaskInfo.pTask->GetPriority(), std::move(TaskInfo));
                 }
             }
@@ -180,44 +527,26 @@ public:
         if (pTask == nullptr)
             return;
 
-        {
-            std::unique_lock<std::mutex> lock{m_TasksQueueMtx};
-            DEV_CHECK_ERR(!m_Stop, "Enqueue on a stopped ThreadPool");
+        DEV_CHECK_ERR(!m_Stop, "Enqueue on a stopped ThreadPool");
 
-            QueuedTaskInfo TaskInfo;
-            TaskInfo.pTask = pTask;
-            if (ppPrerequisites != nullptr && NumPrerequisites > 0)
-            {
-                TaskInfo.Prerequisites.reserve(NumPrerequisites);
-                float MinPrereqPriority = +FLT_MAX;
-                for (Uint32 i = 0; i < NumPrerequisites; ++i)
-                {
-                    if (ppPrerequisites[i] != nullptr)
-                    {
-                        TaskInfo.Prerequisites.emplace_back(ppPrerequisites[i]);
-                        MinPrereqPriority = std::min(MinPrereqPriority, ppPrerequisites[i]->GetPriority());
-                    }
-                }
-                if (pTask->GetPriority() > MinPrereqPriority)
-                {
-                    TaskInfo.pTask->SetPriority(MinPrereqPriority);
-                }
-            }
-
-            m_TasksQueue.emplace(pTask->GetPriority(), std::move(TaskInfo));
+        QueuedTaskInfo TaskInfo;
+        TaskInfo.pTask = pTask;
+        if (m_DependencyTracker.AddTask(TaskInfo, ppPrerequisites, NumPrerequisites))
+        {
+            EnqueueReadyTask(std::move(TaskInfo));
         }
-        m_NextTaskCond.notify_one();
+        // Otherwise, the task will be added to the queue when its last prerequisite is finished
     }
 
     virtual void DILIGENT_CALL_TYPE WaitForAllTasks() override final
     {
         std::unique_lock<std::mutex> lock{m_TasksQueueMtx};
-        if (!m_TasksQueue.empty() || m_NumRunningTasks.load() > 0)
+        if (!m_TasksQueue.empty() || m_NumRunningTasks.load() > 0 || m_DependencyTracker.GetNumWaitingTasks() > 0)
         {
             m_TasksFinishedCond.wait(lock,
                                      [this] //
                                      {
-                                         return m_TasksQueue.empty() && m_NumRunningTasks.load() == 0;
+                                         return m_TasksQueue.empty() && m_NumRunningTasks.load() == 0 && m_DependencyTracker.GetNumWaitingTasks() == 0;
                                      } //
             );
         }
@@ -243,18 +572,36 @@ public:
 
     virtual bool DILIGENT_CALL_TYPE RemoveTask(IAsyncTask* pTask) override final
     {
-        std::unique_lock<std::mutex> lock{m_TasksQueueMtx};
+        bool Removed = false;
+        {
+            std::unique_lock<std::mutex> lock{m_TasksQueueMtx};
 
-        auto it = m_TasksQueue.begin();
-        while (it != m_TasksQueue.end() && it->second.pTask != pTask)
-            ++it;
-        if (it != m_TasksQueue.end())
+            auto it = FindTask(m_TasksQueue, pTask);
+            if (it != m_TasksQueue.end())
+            {
+                m_TasksQueue.erase(it);
+                Removed = true;
+            }
+        }
+
+        auto EnqueueReadyTaskHandler = [this](QueuedTaskInfo&& ReadyTask) {
+            EnqueueReadyTask(std::move(ReadyTask));
+        };
+        if (Removed)
+            m_DependencyTracker.OnTaskRemoved(pTask, EnqueueReadyTaskHandler);
+        else
+            Removed = m_DependencyTracker.RemoveWaitingTask(pTask, EnqueueReadyTaskHandler);
+
+        if (Removed)
         {
-            m_TasksQueue.erase(it);
-            return true;
+            std::unique_lock<std::mutex> lock{m_TasksQueueMtx};
+            if (m_TasksQueue.empty() && m_NumRunningTasks.load() == 0 && m_DependencyTracker.GetNumWaitingTasks() == 0)
+            {
+                m_TasksFinishedCond.notify_one();
+            }
         }
 
-        return false;
+        return Removed;
     }
 
     virtual bool DILIGENT_CALL_TYPE ReprioritizeTask(IAsyncTask* pTask) override final
@@ -263,9 +610,7 @@ public:
 
         std::unique_lock<std::mutex> lock{m_TasksQueueMtx};
 
-        auto it = m_TasksQueue.begin();
-        while (it != m_TasksQueue.end() && it->second.pTask != pTask)
-            ++it;
+        auto it = FindTask(m_TasksQueue, pTask);
         if (it != m_TasksQueue.end())
         {
             if (it->first != Priority)
@@ -277,41 +622,264 @@ public:
 
             return true;
         }
-        return false;
+
+        // Tasks that wait for their prerequisites will be placed into the queue
+        // with their current priority
+        return m_DependencyTracker.IsTaskWaiting(pTask);
     }
 
     virtual void DILIGENT_CALL_TYPE ReprioritizeAllTasks() override final
     {
         std::unique_lock<std::mutex> lock{m_TasksQueueMtx};
+        ReprioritizeQueue(m_TasksQueue, m_ReprioritizationList);
+    }
+
+    Uint32 DILIGENT_CALL_TYPE GetQueueSize() override final
+    {
+        std::unique_lock<std::mutex> lock{m_TasksQueueMtx};
+        return StaticCast<Uint32>(m_TasksQueue.size()) + m_DependencyTracker.GetNumWaitingTasks();
+    }
+
+    virtual Uint32 DILIGENT_CALL_TYPE GetRunningTaskCount() const override final
+    {
+        return m_NumRunningTasks.load();
+    }
+
+    ~ThreadPoolImpl()
+    {
+        StopThreads();
+        VERIFY_EXPR(m_TasksQueue.empty());
+        VERIFY_EXPR(m_NumRunningTasks.load() == 0);
+        VERIFY_EXPR(m_DependencyTracker.GetNumWaitingTasks() == 0);
+    }
 
-        m_ReprioritizationList.clear();
-        for (auto it = m_TasksQueue.begin(); it != m_TasksQueue.end();)
+private:
+    void EnqueueReadyTask(QueuedTaskInfo&& TaskInfo)
+    {
         {
-            QueuedTaskInfo& TaskInfo = it->second;
-            float           Priority = TaskInfo.pTask->GetPriority();
-            if (it->first != Priority)
+            std::unique_lock<std::mutex> lock{m_TasksQueueMtx};
+            const float                  Priority = TaskInfo.pTask->GetPriority();
+            m_TasksQueue.emplace(Priority, std::move(TaskInfo));
+        }
+        m_NextTaskCond.notify_one();
+    }
+
+private:
+    std::vector<std::thread> m_WorkerThreads;
+
+    std::mutex    m_TasksQueueMtx;
+    TaskQueueType m_TasksQueue;
+
+    std::vector<std::pair<float, QueuedTaskInfo>> m_ReprioritizationList;
+
+    std::condition_variable m_NextTaskCond{};
+    std::condition_variable m_TasksFinishedCond{};
+    std::atomic<bool>       m_Stop{false};
+
+    std::atomic<int> m_NumRunningTasks{0};
+
+    TaskDependencyTracker m_DependencyTracker;
+};
+
+class WorkStealingThreadPoolImpl final : public ObjectBase<IThreadPool>
+{
+public:
+    using TBase = ObjectBase<IThreadPool>;
+
+    WorkStealingThreadPoolImpl(IReferenceCounters*         pRefCounters,
+                               const ThreadPoolCreateInfo& PoolCI) :
+        TBase{pRefCounters},
+        m_NumQueues{std::max(PoolCI.NumThreads != 0 ? static_cast<Uint32>(PoolCI.NumThreads) : std::thread::hardware_concurrency(), 1u)},
+        m_Queues{new WorkerQueue[m_NumQueues]}
+    {
+        m_WorkerThreads = StartWorkerThreads(*this, PoolCI);
+    }
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_ThreadPool, TBase)
+
+    virtual bool DILIGENT_CALL_TYPE ProcessTask(Uint32 ThreadId, bool WaitForTask) override final
+    {
+        const Uint32 HomeQueue = ThreadId % m_NumQueues;
+
+        QueuedTaskInfo TaskInfo;
+        while (!PopTask(HomeQueue, TaskInfo))
+        {
+            if (m_Stop.load() && m_NumQueuedTasks.load() == 0)
+                return false;
+
+            if (!WaitForTask)
+                return true;
+
+            std::unique_lock<std::mutex> lock{m_SleepMtx};
+            // NB: the sleeping thread counter must be incremented before the queued task counter
+            //     is checked by the predicate, while EnqueueTask() increments the queued task counter
+            //     before checking the sleeping thread counter. Since both are sequentially consistent,
+            //     at least one of the threads is guaranteed to see the other thread's modification.
+            m_NumSleepingThreads.fetch_add(1);
+            m_NextTaskCond.wait(lock,
+                                [this] //
+                                {
+                                    return m_Stop.load() || m_NumQueuedTasks.load() > 0;
+                                } //
+            );
+            m_NumSleepingThreads.fetch_add(-1);
+        }
+
+        // Tasks enqueued by the running task are placed into this thread's queue
+        const CurrentWorkerInfo PrevWorker = t_CurrentWorker;
+        t_CurrentWorker                    = {this, HomeQueue};
+
+        const bool TaskFinished = RunQueuedTask(TaskInfo, ThreadId);
+
+        t_CurrentWorker = PrevWorker;
+
+        // NB: the task and its dependents that became ready to run must be pushed
+        //     before the running task counter is decremented, otherwise WaitForAllTasks()
+        //     may miss them.
+        if (TaskFinished)
+        {
+            m_DependencyTracker.OnTaskFinished(TaskInfo.pTask,
+                                               [this, HomeQueue](QueuedTaskInfo&& ReadyTask) {
+                                                   PushTask(HomeQueue, std::move(ReadyTask));
+                                               });
+        }
+        else
+        {
+            PushTask(HomeQueue, std::move(TaskInfo));
+        }
+
+        // NB: even if this task was re-enqueued, another thread may have already picked
+        //     it up and finished it, so the check must not depend on TaskFinished.
+        m_NumRunningTasks.fetch_add(-1);
+        NotifyIfAllTasksFinished();
+
+        return true;
+    }
+
+    virtual void DILIGENT_CALL_TYPE EnqueueTask(IAsyncTask*  pTask,
+                                                IAsyncTask** ppPrerequisites,
+                                                Uint32       NumPrerequisites) override final
+    {
+        VERIFY_EXPR(pTask != nullptr);
+        if (pTask == nullptr)
+            return;
+
+        DEV_CHECK_ERR(!m_Stop, "Enqueue on a stopped ThreadPool");
+
+        // Keep the tasks enqueued by the worker thread in its own queue to improve locality,
+        // and distribute the tasks from other threads between all queues.
+        const Uint32 Queue = t_CurrentWorker.pPool == this ?
+            t_CurrentWorker.QueueIdx :
+            m_NextQueue.fetch_add(1) % m_NumQueues;
+
+        QueuedTaskInfo TaskInfo;
+        TaskInfo.pTask = pTask;
+        if (m_DependencyTracker.AddTask(TaskInfo, ppPrerequisites, NumPrerequisites))
+        {
+            PushTask(Queue, std::move(TaskInfo));
+        }
+        // Otherwise, the task will be added to the queue when its last prerequisite is finished
+    }
+
+    virtual void DILIGENT_CALL_TYPE WaitForAllTasks() override final
+    {
+        std::unique_lock<std::mutex> lock{m_SleepMtx};
+        m_TasksFinishedCond.wait(lock,
+                                 [this] //
+                                 {
+                                     return m_NumQueuedTasks.load() == 0 && m_NumRunningTasks.load() == 0 && m_DependencyTracker.GetNumWaitingTasks() == 0;
+                                 } //
+        );
+    }
+
+    virtual void DILIGENT_CALL_TYPE StopThreads() override final
+    {
+        {
+            std::unique_lock<std::mutex> lock{m_SleepMtx};
+            // NB: even if the shared variable is atomic, it must be modified under the mutex
+            //     in order to correctly publish the modification to the waiting thread.
+            m_Stop.store(true);
+        }
+        m_NextTaskCond.notify_all();
+        for (std::thread& worker : m_WorkerThreads)
+            worker.join();
+
+        m_WorkerThreads.clear();
+    }
+
+    virtual bool DILIGENT_CALL_TYPE RemoveTask(IAsyncTask* pTask) override final
+    {
+        bool Removed = false;
+        for (Uint32 q = 0; q < m_NumQueues; ++q)
+        {
+            WorkerQueue&             Queue = m_Queues[q];
+            Threading::SpinLockGuard Guard{Queue.Lock};
+
+            auto it = FindTask(Queue.Tasks, pTask);
+            if (it != Queue.Tasks.end())
             {
-                m_ReprioritizationList.emplace_back(Priority, std::move(TaskInfo));
-                it = m_TasksQueue.erase(it);
+                Queue.Tasks.erase(it);
+                m_NumQueuedTasks.fetch_add(-1);
+                Removed = true;
+                break;
             }
-            else
+        }
+
+        auto EnqueueReadyTask = [this](QueuedTaskInfo&& ReadyTask) {
+            PushTask(m_NextQueue.fetch_add(1) % m_NumQueues, std::move(ReadyTask));
+        };
+        if (Removed)
+            m_DependencyTracker.OnTaskRemoved(pTask, EnqueueReadyTask);
+        else
+            Removed = m_DependencyTracker.RemoveWaitingTask(pTask, EnqueueReadyTask);
+
+        if (Removed)
+            NotifyIfAllTasksFinished();
+
+        return Removed;
+    }
+
+    virtual bool DILIGENT_CALL_TYPE ReprioritizeTask(IAsyncTask* pTask) override final
+    {
+        const float Priority = pTask->GetPriority();
+
+        for (Uint32 q = 0; q < m_NumQueues; ++q)
+        {
+            WorkerQueue&             Queue = m_Queues[q];
+            Threading::SpinLockGuard Guard{Queue.Lock};
+
+            auto it = FindTask(Queue.Tasks, pTask);
+            if (it != Queue.Tasks.end())
             {
-                ++it;
+                if (it->first != Priority)
+                {
+                    QueuedTaskInfo ExistingTaskInfo = std::move(it->second);
+                    Queue.Tasks.erase(it);
+                    Queue.Tasks.emplace(Priority, std::move(ExistingTaskInfo));
+                }
+                return true;
             }
         }
 
-        for (auto& it : m_ReprioritizationList)
+        // Tasks that wait for their prerequisites will be placed into the queue
+        // with their current priority
+        return m_DependencyTracker.IsTaskWaiting(pTask);
+    }
+
+    virtual void DILIGENT_CALL_TYPE ReprioritizeAllTasks() override final
+    {
+        std::vector<std::pair<float, QueuedTaskInfo>> ReprioritizationList;
+        for (Uint32 q = 0; q < m_NumQueues; ++q)
         {
-            m_TasksQueue.emplace(it.first, std::move(it.second));
+            WorkerQueue&             Queue = m_Queues[q];
+            Threading::SpinLockGuard Guard{Queue.Lock};
+            ReprioritizeQueue(Queue.Tasks, ReprioritizationList);
         }
-
-        m_ReprioritizationList.clear();
     }
 
     Uint32 DILIGENT_CALL_TYPE GetQueueSize() override final
     {
-        std::unique_lock<std::mutex> lock{m_TasksQueueMtx};
-        return StaticCast<Uint32>(m_TasksQueue.size());
+        return static_cast<Uint32>(m_NumQueuedTasks.load()) + m_DependencyTracker.GetNumWaitingTasks();
     }
 
     virtual Uint32 DILIGENT_CALL_TYPE GetRunningTaskCount() const override final
@@ -319,36 +887,137 @@ public:
         return m_NumRunningTasks.load();
     }
 
-    ~ThreadPoolImpl()
+    ~WorkStealingThreadPoolImpl()
     {
         StopThreads();
-        VERIFY_EXPR(m_TasksQueue.empty());
+        VERIFY_EXPR(m_NumQueuedTasks.load() == 0);
         VERIFY_EXPR(m_NumRunningTasks.load() == 0);
+        VERIFY_EXPR(m_DependencyTracker.GetNumWaitingTasks() == 0);
     }
 
 private:
-    std::vector<std::thread> m_WorkerThreads;
+    // Align the queues to the cache line size to avoid false sharing
+    struct alignas(64) WorkerQueue
+    {
+        Threading::SpinLock Lock;
+        TaskQueueType       Tasks;
+    };
 
-    struct QueuedTaskInfo
+    struct CurrentWorkerInfo
     {
-        RefCntAutoPtr<IAsyncTask>              pTask;
-        std::vector<RefCntWeakPtr<IAsyncTask>> Prerequisites;
+        const WorkStealingThreadPoolImpl* pPool    = nullptr;
+        Uint32                            QueueIdx = 0;
     };
-    // Priority queue
-    std::mutex                                                m_TasksQueueMtx;
-    std::multimap<float, QueuedTaskInfo, std::greater<float>> m_TasksQueue;
+    static thread_local CurrentWorkerInfo t_CurrentWorker;
 
-    std::vector<std::pair<float, QueuedTaskInfo>> m_ReprioritizationList;
+    void PushTask(Uint32 QueueIdx, QueuedTaskInfo&& TaskInfo)
+    {
+        WorkerQueue& Queue = m_Queues[QueueIdx];
+        {
+            Threading::SpinLockGuard Guard{Queue.Lock};
+            const float              Priority = TaskInfo.pTask->GetPriority();
+            Queue.Tasks.emplace(Priority, std::move(TaskInfo));
+            m_NumQueuedTasks.fetch_add(1);
+        }
+
+        if (m_NumSleepingThreads.load() > 0)
+        {
+            // Lock the mutex to make sure that the sleeping thread is either not checking
+            // the condition or is already waiting on the condition variable.
+            {
+                std::unique_lock<std::mutex> lock{m_SleepMtx};
+            }
+            m_NextTaskCond.notify_one();
+        }
+    }
+
+    bool PopTaskFromQueue(WorkerQueue& Queue, QueuedTaskInfo& TaskInfo)
+    {
+        if (Queue.Tasks.empty())
+            return false;
+
+        auto front = Queue.Tasks.begin();
+        TaskInfo   = std::move(front->second);
+        Queue.Tasks.erase(front);
+        // NB: we must increment the running task counter before decrementing
+        //     the queued task counter, otherwise WaitForAllTasks() may miss the task.
+        m_NumRunningTasks.fetch_add(1);
+        m_NumQueuedTasks.fetch_add(-1);
+        return true;
+    }
+
+    bool PopTask(Uint32 HomeQueue, QueuedTaskInfo& TaskInfo)
+    {
+        {
+            WorkerQueue&             Queue = m_Queues[HomeQueue];
+            Threading::SpinLockGuard Guard{Queue.Lock};
+            if (PopTaskFromQueue(Queue, TaskInfo))
+                return true;
+        }
+
+        // Try to steal a task from other queues without blocking on busy queues first.
+        // If all queues were busy, but there are tasks in the pool, do a blocking pass.
+        for (bool Blocking : {false, true})
+        {
+            for (Uint32 i = 1; i < m_NumQueues && m_NumQueuedTasks.load() > 0; ++i)
+            {
+                WorkerQueue& Queue = m_Queues[(HomeQueue + i) % m_NumQueues];
+                if (Blocking)
+                {
+                    Queue.Lock.lock();
+                }
+                else if (!Queue.Lock.try_lock())
+                {
+                    continue;
+                }
+
+                const bool Stolen = PopTaskFromQueue(Queue, TaskInfo);
+                Queue.Lock.unlock();
+                if (Stolen)
+                    return true;
+            }
+        }
+
+        return false;
+    }
+
+    void NotifyIfAllTasksFinished()
+    {
+        if (m_NumQueuedTasks.load() == 0 && m_NumRunningTasks.load() == 0 && m_DependencyTracker.GetNumWaitingTasks() == 0)
+        {
+            // Lock the mutex to make sure that WaitForAllTasks() is either not checking
+            // the condition or is already waiting on the condition variable.
+            std::unique_lock<std::mutex> lock{m_SleepMtx};
+            m_TasksFinishedCond.notify_all();
+        }
+    }
+
+private:
+    const Uint32                   m_NumQueues;
+    std::unique_ptr<WorkerQueue[]> m_Queues;
+    std::atomic<Uint32>            m_NextQueue{0};
 
+    std::vector<std::thread> m_WorkerThreads;
+
+    std::mutex              m_SleepMtx;
     std::condition_variable m_NextTaskCond{};
     std::condition_variable m_TasksFinishedCond{};
     std::atomic<bool>       m_Stop{false};
 
+    std::atomic<int> m_NumQueuedTasks{0};
     std::atomic<int> m_NumRunningTasks{0};
+    std::atomic<int> m_NumSleepingThreads{0};
+
+    TaskDependencyTracker m_DependencyTracker;
 };
 
+thread_local WorkStealingThreadPoolImpl::CurrentWorkerInfo WorkStealingThreadPoolImpl::t_CurrentWorker;
+
 RefCntAutoPtr<IThreadPool> CreateThreadPool(const ThreadPoolCreateInfo& ThreadPoolCI)
 {
+    if (ThreadPoolCI.EnableWorkStealing)
+        return RefCntAutoPtr<WorkStealingThreadPoolImpl>{MakeNewRCObj<WorkStealingThreadPoolImpl>()(ThreadPoolCI)};
+
     return RefCntAutoPtr<ThreadPoolImpl>{MakeNewRCObj<ThreadPoolImpl>()(ThreadPoolCI)};
 }
 
@@ -395,4 +1064,292 @@ Uint64 PinWorkerThread(Uint32 ThreadId, Uint64 AllowedCoresMask)
     return PrevMask;
 }
 
+
+namespace
+{
+
+// The task that is used by ParallelFor() and TaskGraph.
+// The task objects are kept in the per-thread pool and are reused.
+class PooledTask final : public AsyncTaskBase
+{
+public:
+    using RunFuncType = void (*)(void* pUserData, Uint32 ThreadId);
+
+    explicit PooledTask(IReferenceCounters* pRefCounters) :
+        AsyncTaskBase{pRefCounters}
+    {}
+
+    void Init(RunFuncType RunFunc, void* pUserData, float fPriority)
+    {
+        ResetTask(fPriority);
+        m_RunFunc   = RunFunc;
+        m_pUserData = pUserData;
+    }
+
+    virtual ASYNC_TASK_STATUS DILIGENT_CALL_TYPE Run(Uint32 ThreadId) override final
+    {
+        if (m_bSafelyCancel.load())
+            return ASYNC_TASK_STATUS_CANCELLED;
+
+        m_RunFunc(m_pUserData, ThreadId);
+        return ASYNC_TASK_STATUS_COMPLETE;
+    }
+
+private:
+    RunFuncType m_RunFunc   = nullptr;
+    void*       m_pUserData = nullptr;
+};
+
+class PooledTaskCache
+{
+public:
+    RefCntAutoPtr<PooledTask> Acquire(PooledTask::RunFuncType RunFunc, void* pUserData, float fPriority)
+    {
+        RefCntAutoPtr<PooledTask> pTask;
+
+        // The task may only be reused when no one else holds a reference to it. A thread pool
+        // may hold the task for a short time after it is finished, so only check a few most
+        // recently released tasks.
+        constexpr size_t MaxTasksToCheck = 8;
+        for (size_t i = 0; i < std::min(m_Tasks.size(), MaxTasksToCheck); ++i)
+        {
+            auto it = m_Tasks.end() - 1 - i;
+            if (IsReusable(**it))
+            {
+                pTask = std::move(*it);
+                m_Tasks.erase(it);
+                break;
+            }
+        }
+
+        if (!pTask)
+            pTask = MakeNewRCObj<PooledTask>()();
+
+        pTask->Init(RunFunc, pUserData, fPriority);
+        return pTask;
+    }
+
+    void Release(RefCntAutoPtr<PooledTask> pTask)
+    {
+        constexpr size_t MaxCachedTasks = 64;
+        if (pTask && m_Tasks.size() < MaxCachedTasks)
+            m_Tasks.emplace_back(std::move(pTask));
+    }
+
+    void Release(RefCntAutoPtr<IAsyncTask>& pTask)
+    {
+        Release(RefCntAutoPtr<PooledTask>{ClassPtrCast<PooledTask>(pTask.RawPtr())});
+        pTask.Release();
+    }
+
+    // Returns true if the task is only referenced by its single owner
+    static bool IsReusable(const PooledTask& Task)
+    {
+        const IReferenceCounters* pRefCntrs = Task.GetReferenceCounters();
+        return pRefCntrs->GetNumStrongRefs() == 1 && pRefCntrs->GetNumWeakRefs() == 0;
+    }
+
+    static PooledTaskCache& Get()
+    {
+        static thread_local PooledTaskCache Cache;
+        return Cache;
+    }
+
+private:
+    std::vector<RefCntAutoPtr<PooledTask>> m_Tasks;
+};
+
+struct ParallelForState
+{
+    Uint32                      RangeBegin   = 0;
+    Uint32                      RangeEnd     = 0;
+    Uint32                      Grain        = 0;
+    Uint32                      NumChunks    = 0;
+    ParallelForChunkHandlerType ChunkHandler = nullptr;
+    void*                       pUserData    = nullptr;
+
+    std::atomic<Uint32> NextChunk{0};
+
+    // Processes the chunks until there are no more chunks left
+    void ProcessChunks()
+    {
+        for (Uint32 Chunk = NextChunk.fetch_add(1); Chunk < NumChunks; Chunk = NextChunk.fetch_add(1))
+        {
+            const Uint32 ChunkBegin = RangeBegin + Chunk * Grain;
+            const Uint32 ChunkEnd   = ChunkBegin + std::min(Grain, RangeEnd - ChunkBegin);
+            ChunkHandler(pUserData, ChunkBegin, ChunkEnd);
+        }
+    }
+};
+
+} // namespace
+
+void ParallelFor(IThreadPool*                pThreadPool,
+                 Uint32                      RangeBegin,
+                 Uint32                      RangeEnd,
+                 Uint32                      Grain,
+                 ParallelForChunkHandlerType ChunkHandler,
+                 void*                       pUserData)
+{
+    VERIFY_EXPR(ChunkHandler != nullptr);
+    if (RangeBegin >= RangeEnd)
+        return;
+
+    Grain = std::max(Grain, 1u);
+
+    const Uint32 NumItems  = RangeEnd - RangeBegin;
+    const Uint32 NumChunks = NumItems / Grain + (NumItems % Grain != 0 ? 1 : 0);
+    if (pThreadPool == nullptr || NumChunks == 1)
+    {
+        for (Uint32 ChunkBegin = RangeBegin; ChunkBegin < RangeEnd;)
+        {
+            const Uint32 ChunkEnd = ChunkBegin + std::min(Grain, RangeEnd - ChunkBegin);
+            ChunkHandler(pUserData, ChunkBegin, ChunkEnd);
+            ChunkBegin = ChunkEnd;
+        }
+        return;
+    }
+
+    ParallelForState State;
+    State.RangeBegin   = RangeBegin;
+    State.RangeEnd     = RangeEnd;
+    State.Grain        = Grain;
+    State.NumChunks    = NumChunks;
+    State.ChunkHandler = ChunkHandler;
+    State.pUserData    = pUserData;
+
+    // The calling thread processes the chunks too, so one helper task less is needed
+    const Uint32 NumHelpers = std::min(NumChunks - 1, std::max(std::thread::hardware_concurrency(), 1u));
+
+    PooledTaskCache& TaskCache = PooledTaskCache::Get();
+
+    constexpr Uint32                                       MaxLocalHelpers = 64;
+    std::array<RefCntAutoPtr<PooledTask>, MaxLocalHelpers> LocalHelpers;
+    std::vector<RefCntAutoPtr<PooledTask>>                 ExtraHelpers;
+    auto                                                   GetHelper = [&](Uint32 i) -> RefCntAutoPtr<PooledTask>& {
+        return i < MaxLocalHelpers ? LocalHelpers[i] : ExtraHelpers[i - MaxLocalHelpers];
+    };
+    if (NumHelpers > MaxLocalHelpers)
+        ExtraHelpers.resize(NumHelpers - MaxLocalHelpers);
+
+    for (Uint32 i = 0; i < NumHelpers; ++i)
+    {
+        auto& pHelper = GetHelper(i);
+        pHelper       = TaskCache.Acquire(
+            [](void* pState, Uint32 ThreadId) {
+                static_cast<ParallelForState*>(pState)->ProcessChunks();
+            },
+            &State, 0);
+        pThreadPool->EnqueueTask(pHelper);
+    }
+
+    State.ProcessChunks();
+
+    // All chunks have been claimed at this point. The helpers that have not been started
+    // yet are removed from the queue, and the ones that are running are waited for.
+    // Remove the helpers in the reverse order as the last ones are least likely to have started.
+    for (Uint32 i = NumHelpers; i > 0; --i)
+    {
+        auto& pHelper = GetHelper(i - 1);
+        if (!pThreadPool->RemoveTask(pHelper))
+            pHelper->WaitForCompletion();
+    }
+
+    for (Uint32 i = 0; i < NumHelpers; ++i)
+        TaskCache.Release(std::move(GetHelper(i)));
+}
+
+
+TaskGraph::TaskGraph() noexcept
+{
+}
+
+TaskGraph::~TaskGraph()
+{
+    Wait();
+
+    PooledTaskCache& TaskCache = PooledTaskCache::Get();
+    for (NodeInfo& Node : m_Nodes)
+        TaskCache.Release(Node.pTask);
+}
+
+TaskGraph::NodeIndex TaskGraph::AddNode(NodeHandlerType  Handler,
+                                        const NodeIndex* pPrerequisites,
+                                        Uint32           NumPrerequisites,
+                                        float            fPriority)
+{
+    DEV_CHECK_ERR(IsFinished(), "The graph must not be modified while it is being executed");
+    DEV_CHECK_ERR(Handler, "Node handler must not be empty");
+
+    const NodeIndex NewNode = static_cast<NodeIndex>(m_Nodes.size());
+
+    NodeInfo Node;
+    Node.Handler   = std::move(Handler);
+    Node.fPriority = fPriority;
+    Node.Prerequisites.reserve(NumPrerequisites);
+    for (Uint32 i = 0; i < NumPrerequisites; ++i)
+    {
+        const NodeIndex Prereq = pPrerequisites[i];
+        if (Prereq >= NewNode)
+        {
+            DEV_ERROR("Prerequisite ", Prereq, " of node ", NewNode, " has not been added to the graph. Prerequisites must be added before the node that depends on them.");
+            continue;
+        }
+        Node.Prerequisites.push_back(Prereq);
+    }
+    m_Nodes.emplace_back(std::move(Node));
+
+    return NewNode;
+}
+
+void TaskGraph::Execute(IThreadPool* pThreadPool)
+{
+    DEV_CHECK_ERR(pThreadPool != nullptr, "Thread pool must not be null");
+    DEV_CHECK_ERR(IsFinished(), "The graph is already being executed");
+
+    constexpr PooledTask::RunFuncType RunNode = [](void* pNode, Uint32 ThreadId) {
+        static_cast<NodeInfo*>(pNode)->Handler(ThreadId);
+    };
+
+    PooledTaskCache& TaskCache = PooledTaskCache::Get();
+
+    std::vector<IAsyncTask*> Prerequisites;
+    for (NodeInfo& Node : m_Nodes)
+    {
+        // Reuse the task from the previous execution if the thread pool has released it
+        PooledTask* pTask = ClassPtrCast<PooledTask>(Node.pTask.RawPtr());
+        if (pTask != nullptr && PooledTaskCache::IsReusable(*pTask))
+            pTask->Init(RunNode, &Node, Node.fPriority);
+        else
+            Node.pTask = TaskCache.Acquire(RunNode, &Node, Node.fPriority);
+
+        Prerequisites.clear();
+        for (NodeIndex Prereq : Node.Prerequisites)
+            Prerequisites.push_back(m_Nodes[Prereq].pTask);
+
+        pThreadPool->EnqueueTask(Node.pTask,
+                                 !Prerequisites.empty() ? Prerequisites.data() : nullptr,
+                                 static_cast<Uint32>(Prerequisites.size()));
+    }
+}
+
+void TaskGraph::Wait() const
+{
+    for (const NodeInfo& Node : m_Nodes)
+    {
+        if (Node.pTask)
+            Node.pTask->WaitForCompletion();
+    }
+}
+
+bool TaskGraph::IsFinished() const
+{
+    for (const NodeInfo& Node : m_Nodes)
+    {
+        if (Node.pTask && !Node.pTask->IsFinished())
+            return false;
+    }
+    return true;
+}
+
 } // namespace Diligent
@@ -0,0 +1,113 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "pch.h"
+#include "VirtualMemory.hpp"
+#include "DebugUtilities.hpp"
+
+#if PLATFORM_WIN32
+#    include "WinHPreface.h"
+#    include <Windows.h>
+#    include "WinHPostface.h"
+#    define USE_WIN32_VIRTUAL_MEMORY 1
+#elif PLATFORM_LINUX || PLATFORM_ANDROID || PLATFORM_MACOS || PLATFORM_IOS || PLATFORM_TVOS
+#    include <sys/mman.h>
+#    include <unistd.h>
+#    define USE_POSIX_VIRTUAL_MEMORY 1
+#endif
+
+namespace Diligent
+{
+
+size_t GetVirtualMemoryPageSize()
+{
+    static const size_t PageSize = []() -> size_t {
+#if USE_WIN32_VIRTUAL_MEMORY
+        SYSTEM_INFO SysInfo{};
+        GetSystemInfo(&SysInfo);
+        return SysInfo.dwPageSize;
+#elif USE_POSIX_VIRTUAL_MEMORY
+        const long Size = sysconf(_SC_PAGESIZE);
+        return Size > 0 ? static_cast<size_t>(Size) : 4096;
+#else
+        return 4096;
+#endif
+    }();
+    return PageSize;
+}
+
+void* ReserveVirtualMemory(size_t Size)
+{
+    VERIFY(Size % GetVirtualMemoryPageSize() == 0, "Size (", Size, ") must be a multiple of the page size");
+
+#if USE_WIN32_VIRTUAL_MEMORY
+    return VirtualAlloc(nullptr, Size, MEM_RESERVE, PAGE_NOACCESS);
+#elif USE_POSIX_VIRTUAL_MEMORY
+    // Anonymous mappings are backed by physical pages on first access, so the
+    // range is mapped as read-write and no explicit commit is required.
+    int Flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#    ifdef MAP_NORESERVE
+    Flags |= MAP_NORESERVE;
+#    endif
+    void* Ptr = mmap(nullptr, Size, PROT_READ | PROT_WRITE, Flags, -1, 0);
+    return Ptr != MAP_FAILED ? Ptr : nullptr;
+#else
+    (void)Size;
+    return nullptr;
+#endif
+}
+
+bool CommitVirtualMemory(void* Ptr, size_t Size)
+{
+    VERIFY_EXPR(Ptr != nullptr);
+    VERIFY(reinterpret_cast<size_t>(Ptr) % GetVirtualMemoryPageSize() == 0, "Address is not page-aligned");
+
+#if USE_WIN32_VIRTUAL_MEMORY
+    return VirtualAlloc(Ptr, Size, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+#else
+    (void)Size;
+    return true;
+#endif
+}
+
+void ReleaseVirtualMemory(void* Ptr, size_t Size)
+{
+    if (Ptr == nullptr)
+        return;
+
+#if USE_WIN32_VIRTUAL_MEMORY
+    (void)Size;
+    VirtualFree(Ptr, 0, MEM_RELEASE);
+#elif USE_POSIX_VIRTUAL_MEMORY
+    munmap(Ptr, Size);
+#else
+    (void)Size;
+    UNEXPECTED("Virtual memory is not supported on this platform");
+#endif
+}
+
+} // namespace Diligent
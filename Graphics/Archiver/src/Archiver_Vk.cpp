@@ -40,6 +40,22 @@ namespace Diligent
 namespace
 {
 
+// Appends the shader reflection to SPIR-V so that the shader can be unpacked from the archive
+// without parsing the byte code with SPIRV-Cross (see ShaderVkImpl::Initialize).
+// Returns an empty vector if the shader has no reflection.
+std::vector<Uint32> AppendShaderReflection(const ShaderVkImpl& ShaderVk, const std::vector<Uint32>& SPIRV)
+{
+    const std::shared_ptr<const SPIRVShaderResources>& pResources = ShaderVk.GetShaderResources();
+    if (!pResources || SPIRV.empty())
+        return {};
+
+    const SerializedData Reflection = pResources->SerializeReflection(ShaderVk.GetEntryPoint(), GetRawAllocator());
+    if (!Reflection)
+        return {};
+
+    return AppendSPIRVReflection(SPIRV, Reflection);
+}
+
 struct CompiledShaderVk : SerializedShaderImpl::CompiledShader
 {
     ShaderVkImpl ShaderVk;
@@ -53,13 +69,15 @@ struct CompiledShaderVk : SerializedShaderImpl::CompiledShader
 
     virtual SerializedData Serialize(ShaderCreateInfo ShaderCI) const override final
     {
-        const std::vector<Uint32>& SPIRV = ShaderVk.GetSPIRV();
+        const std::vector<Uint32>& SPIRV    = ShaderVk.GetSPIRV();
+        const std::vector<Uint32>  ByteCode = AppendShaderReflection(ShaderVk, SPIRV);
+        const std::vector<Uint32>& Data     = !ByteCode.empty() ? ByteCode : SPIRV;
 
         ShaderCI.Source       = nullptr;
         ShaderCI.FilePath     = nullptr;
         ShaderCI.Macros       = {};
-        ShaderCI.ByteCode     = SPIRV.data();
-        ShaderCI.ByteCodeSize = SPIRV.size() * sizeof(SPIRV[0]);
+        ShaderCI.ByteCode     = Data.data();
+        ShaderCI.ByteCodeSize = Data.size() * sizeof(Data[0]);
         return SerializedShaderImpl::SerializeCreateInfo(ShaderCI);
     }
 
@@ -186,17 +204,22 @@ void SerializedPipelineStateImpl::PatchShadersVk(const CreateInfoType& CreateInf
     VERIFY_EXPR(m_Data.Shaders[static_cast<size_t>(DeviceType::Vulkan)].empty());
     for (size_t j = 0; j < ShaderStagesVk.size(); ++j)
     {
-        const PipelineStateVkImpl::ShaderStageInfo& Stage = ShaderStagesVk[j];
+        PipelineStateVkImpl::ShaderStageInfo& Stage = ShaderStagesVk[j];
         for (size_t i = 0; i < Stage.Count(); ++i)
         {
-            const std::vector<Uint32>& SPIRV    = Stage.SPIRVs[i];
+            const std::vector<Uint32>& SPIRV    = Stage.SPIRVs[i].Apply();
             ShaderCreateInfo           ShaderCI = ShaderStages[j].Serialized[i]->GetCreateInfo();
 
+            // Patching only changes binding and descriptor set values, so the reflection
+            // offsets remain valid. Stripping reflection invalidates them.
+            const std::vector<Uint32>  ByteCode = !m_Data.Aux.NoShaderReflection ? AppendShaderReflection(*Stage.Shaders[i], SPIRV) : std::vector<Uint32>{};
+            const std::vector<Uint32>& Data     = !ByteCode.empty() ? ByteCode : SPIRV;
+
             ShaderCI.Source       = nullptr;
             ShaderCI.FilePath     = nullptr;
             ShaderCI.Macros       = {};
-            ShaderCI.ByteCode     = SPIRV.data();
-            ShaderCI.ByteCodeSize = SPIRV.size() * sizeof(SPIRV[0]);
+            ShaderCI.ByteCode     = Data.data();
+            ShaderCI.ByteCodeSize = Data.size() * sizeof(Data[0]);
             SerializeShaderCreateInfo(DeviceType::Vulkan, ShaderCI);
         }
     }
@@ -27,6 +27,8 @@
 
 #include "SRBMemoryAllocator.hpp"
 
+#include <algorithm>
+
 namespace Diligent
 {
 
@@ -65,10 +67,13 @@ void SRBMemoryAllocator::Initialize(Uint32              SRBAllocationGranularity
         __FILE__, __LINE__);
     m_DataAllocators = reinterpret_cast<FixedBlockMemoryAllocator*>(pAllocatorsRawMem);
 
+    // SRBs are often created and destroyed from multiple worker threads. Let every thread keep a few
+    // free blocks so that most allocations do not contend for the allocator mutex.
+    const Uint32 ThreadCacheSize = std::min(SRBAllocationGranularity, 16u);
     for (Uint32 s = 0; s < TotalAllocatorCount; ++s)
     {
         size_t size = s < ShaderVariableDataAllocatorCount ? ShaderVariableDataSizes[s] : ResourceCacheDataSizes[s - ShaderVariableDataAllocatorCount];
-        new (m_DataAllocators + s) FixedBlockMemoryAllocator(GetRawAllocator(), size, SRBAllocationGranularity);
+        new (m_DataAllocators + s) FixedBlockMemoryAllocator(GetRawAllocator(), size, SRBAllocationGranularity, ThreadCacheSize);
     }
 }
 
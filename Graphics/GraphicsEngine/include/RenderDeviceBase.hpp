@@ -150,7 +150,7 @@ public:
         m_ShaderObjAllocator  {RawMemAllocator, sizeof(ShaderImplType),                    16},
         m_SamplerObjAllocator {RawMemAllocator, sizeof(SamplerImplType),                   32},
         m_PSOAllocator        {RawMemAllocator, sizeof(PipelineStateImplType),             16},
-        m_SRBAllocator        {RawMemAllocator, sizeof(ShaderResourceBindingImplType),     64},
+        m_SRBAllocator        {RawMemAllocator, sizeof(ShaderResourceBindingImplType),     64, 16},
         m_ResMappingAllocator {RawMemAllocator, sizeof(ResourceMappingImpl),                8},
         m_FenceAllocator      {RawMemAllocator, sizeof(FenceImplType),                     16},
         m_QueryAllocator      {RawMemAllocator, sizeof(QueryImplType),                     16},
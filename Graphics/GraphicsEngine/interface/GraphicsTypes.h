@@ -3485,7 +3485,8 @@ struct EngineCreateInfo
 
     /// If non-zero number is given, pointers to the contexts are written to ppContexts array by the engine factory
     /// functions (IEngineFactoryD3D11::CreateDeviceAndContextsD3D11,
-    /// IEngineFactoryD3D12::CreateDeviceAndContextsD3D12, and IEngineFactoryVk::CreateDeviceAndContextsVk)
+    /// IEngineFactoryD3D12::CreateDeviceAndContextsD3D12, IEngineFactoryVk::CreateDeviceAndContextsVk,
+    /// IEngineFactoryOpenGL::CreateDeviceAndSwapChainGL, and IEngineFactoryOpenGL::AttachToActiveGLContext)
     /// starting at position `max(1, NumImmediateContexts)`.
     ///
     /// \remarks  Additional deferred contexts may be created later by calling IRenderDevice::CreateDeferredContext().
@@ -3523,8 +3524,12 @@ struct EngineCreateInfo
     /// the provided thread pool to compile shaders and pipeline states asynchronously.
     /// If the thread pool is not provided, the engine will create a default thread pool.
     /// 
-    /// \note   Thread pool is not used in OpenGL backend as asynchronous shader compilation
-    ///         is performed by the driver.
+    /// \note   User-provided thread pool is not used in OpenGL backend. Asynchronous shader
+    ///         compilation is performed by the driver when GL_KHR_parallel_shader_compile is
+    ///         supported. Otherwise, the engine creates its own thread pool, where every thread
+    ///         uses a GL context that shares objects with the main context.
+    ///         On Linux, the application must call XInitThreads() before any other Xlib call
+    ///         and set EngineGLCreateInfo::XInitThreadsCalled to true in this case.
     IThreadPool* pAsyncShaderCompilationThreadPool DEFAULT_INITIALIZER(nullptr);
 
     /// When `AsyncShaderCompilation` is enabled, the maximum number of threads that can be used to compile shaders.
@@ -3536,8 +3541,9 @@ struct EngineCreateInfo
     /// If pAsyncShaderCompilationThreadPool is not null, the value is ignored as the user-provided
     /// thread pool is used instead.
     /// 
-    /// In OpenGL backend, the thread pool is not used and the value is passed to glMaxShaderCompilerThreadsKHR()
-    /// function.
+    /// In OpenGL backend, the value is passed to glMaxShaderCompilerThreadsKHR() function when
+    /// GL_KHR_parallel_shader_compile is supported. Otherwise, it defines the number of threads
+    /// in the thread pool created by the engine (at most 4, as every thread needs its own GL context).
     Uint32 NumAsyncShaderCompilationThreads DEFAULT_INITIALIZER(0xFFFFFFFFu);
 
     // The structure must be 8-byte aligned
@@ -3650,6 +3656,14 @@ struct EngineGLCreateInfo DILIGENT_DERIVE(EngineCreateInfo)
     /// * On Linux this affects the `DRI_PRIME` environment variable that is used by Mesa drivers that support PRIME.
     ADAPTER_TYPE PreferredAdapterType DEFAULT_INITIALIZER(ADAPTER_TYPE_UNKNOWN);
 
+    /// Indicates that the application has called XInitThreads() before any other Xlib call (Linux only).
+
+    /// When GL_KHR_parallel_shader_compile is not supported, asynchronous shader compilation
+    /// uses worker threads that make their GL contexts current on the application's display connection.
+    /// This is only safe when Xlib has been initialized for multithreading, so the worker
+    /// contexts are not created unless this member is set to true.
+    Bool XInitThreadsCalled DEFAULT_INITIALIZER(False);
+
 #if PLATFORM_WEB
     /// WebGL context attributes.
     WebGLContextAttribs WebGLAttribs;
@@ -348,7 +348,11 @@ DILIGENT_BEGIN_INTERFACE(IRenderDevice, IObject)
     /// \param [out] ppContext - Address of the memory location where a pointer to the
     ///                          deferred context interface will be written.
     /// 
-    /// \remarks    Deferred contexts are not supported in OpenGL and WebGPU backends.
+    /// \remarks    Deferred contexts are not supported in WebGPU backend.
+    ///             In OpenGL backend, deferred contexts record commands into CPU-side
+    ///             command lists that are replayed by the immediate context in
+    ///             IDeviceContext::ExecuteCommandLists(). Only buffer maps with MAP_WRITE
+    ///             type and MAP_FLAG_DISCARD flag are supported by deferred contexts in this backend.
     VIRTUAL void METHOD(CreateDeferredContext)(THIS_
                                                IDeviceContext** ppContext) PURE;
 
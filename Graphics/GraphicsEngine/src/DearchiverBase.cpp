@@ -416,12 +416,12 @@ bool DearchiverBase::UnpackPSOShaders(ArchiveData&             Archive,
     if (!ShaderIdxData)
         return false;
 
-    DynamicLinearAllocator Allocator{GetRawAllocator()};
+    ThreadScratchArena Allocator;
 
     DeviceObjectArchive::ShaderIndexArray ShaderIndices;
     {
         Serializer<SerializerMode::Read> Ser{ShaderIdxData};
-        if (!PSOSerializer<SerializerMode::Read>::SerializeShaderIndices(Ser, ShaderIndices, &Allocator))
+        if (!PSOSerializer<SerializerMode::Read>::SerializeShaderIndices(Ser, ShaderIndices, &Allocator.Get()))
         {
             LOG_ERROR_MESSAGE("Failed to deserialize PSO shader indices. Archive file may be corrupted or invalid.");
             return false;
@@ -935,9 +935,9 @@ void PipelineStateD3D12Impl::InitializePipeline(const RayTracingPipelineStateCre
 
     ID3D12Device5* pd3d12Device = m_pDevice->GetD3D12Device5();
 
-    DynamicLinearAllocator             TempPool{GetRawAllocator(), 4 << 10};
+    ThreadScratchArena                 TempPool;
     std::vector<D3D12_STATE_SUBOBJECT> Subobjects;
-    BuildRTPipelineDescription(CreateInfo, Subobjects, TempPool, ShaderStages);
+    BuildRTPipelineDescription(CreateInfo, Subobjects, TempPool.Get(), ShaderStages);
 
     D3D12_GLOBAL_ROOT_SIGNATURE GlobalRoot = {m_RootSig->GetD3D12RootSignature()};
     Subobjects.push_back({D3D12_STATE_SUBOBJECT_TYPE_GLOBAL_ROOT_SIGNATURE, &GlobalRoot});
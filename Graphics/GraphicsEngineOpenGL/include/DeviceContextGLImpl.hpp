@@ -28,6 +28,7 @@
 #pragma once
 
 #include <vector>
+#include <memory>
 
 #include "EngineGLImplTraits.hpp"
 #include "DeviceContextBase.hpp"
@@ -43,6 +44,7 @@
 
 #include "GLContextState.hpp"
 #include "GLObjectWrapper.hpp"
+#include "GLCommandStream.hpp"
 
 namespace Diligent
 {
@@ -318,6 +320,16 @@ protected:
 private:
     void CommitDefaultFramebuffer();
 
+    // Returns the command stream of the deferred context, creating it if necessary.
+    GLCommandStream& GetDeferredCommandStream();
+
+    // Replays the commands recorded by a deferred context.
+    void ExecuteCommandStream(const GLCommandStream& CmdStream);
+
+    // Resets the committed pipeline state and resource bindings, but keeps the
+    // GL context state cache intact.
+    void InvalidateCommittedState();
+
     __forceinline void PrepareForDraw(DRAW_FLAGS Flags, bool IsIndexed, GLenum& GlTopology);
     __forceinline void PrepareForIndexedDraw(VALUE_TYPE IndexType, Uint32 FirstIndexLocation, GLenum& GLIndexType, size_t& FirstIndexByteOffset);
     __forceinline void PrepareForIndirectDraw(IBuffer* pAttribsBuffer);
@@ -365,6 +377,11 @@ private:
     GLObjectWrappers::GLFrameBufferObj m_DefaultFBO;
 
     std::vector<OptimizedClearValue> m_AttachmentClearValues;
+
+    // Commands recorded by the deferred context since the last FinishCommandList() call.
+    std::unique_ptr<GLCommandStream> m_pDeferredCmdStream;
+
+    FixedBlockMemoryAllocator m_CmdListAllocator;
 };
 
 } // namespace Diligent
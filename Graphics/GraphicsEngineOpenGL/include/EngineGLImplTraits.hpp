@@ -43,6 +43,7 @@
 #include "QueryGL.h"
 #include "RenderPass.h"
 #include "Framebuffer.h"
+#include "CommandList.h"
 #include "PipelineResourceSignature.h"
 #include "DeviceContextGL.h"
 #include "BaseInterfacesGL.h"
@@ -64,6 +65,7 @@ class FenceGLImpl;
 class QueryGLImpl;
 class RenderPassGLImpl;
 class FramebufferGLImpl;
+class CommandListGLImpl;
 class BottomLevelASGLImpl;
 class TopLevelASGLImpl;
 class ShaderBindingTableGLImpl;
@@ -105,6 +107,7 @@ struct EngineGLImplTraits
     using QueryInterface                     = IQueryGL;
     using RenderPassInterface                = IRenderPass;
     using FramebufferInterface               = IFramebuffer;
+    using CommandListInterface               = ICommandList;
     using PipelineResourceSignatureInterface = IPipelineResourceSignature;
 
     using RenderDeviceImplType              = RenderDeviceGLImpl;
@@ -121,6 +124,7 @@ struct EngineGLImplTraits
     using QueryImplType                     = QueryGLImpl;
     using RenderPassImplType                = RenderPassGLImpl;
     using FramebufferImplType               = FramebufferGLImpl;
+    using CommandListImplType               = CommandListGLImpl;
     using BottomLevelASImplType             = BottomLevelASGLImpl;
     using TopLevelASImplType                = TopLevelASGLImpl;
     using ShaderBindingTableImplType        = ShaderBindingTableGLImpl;
@@ -0,0 +1,413 @@
+/*
+ *  Copyright 2019-2025 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::GLCommandStream class
+
+#include <vector>
+#include <new>
+#include <type_traits>
+
+#include "DeviceContext.h"
+#include "DynamicLinearAllocator.hpp"
+#include "RefCntAutoPtr.hpp"
+
+namespace Diligent
+{
+
+/// Type of a command recorded by a deferred OpenGL context.
+enum class GLCommandType : Uint8
+{
+    SetPipelineState,
+    CommitShaderResources,
+    SetStencilRef,
+    SetBlendFactors,
+    SetVertexBuffers,
+    SetIndexBuffer,
+    SetViewports,
+    SetScissorRects,
+    SetRenderTargets,
+    InvalidateState,
+    BeginRenderPass,
+    NextSubpass,
+    EndRenderPass,
+    Draw,
+    DrawIndexed,
+    DrawIndirect,
+    DrawIndexedIndirect,
+    MultiDraw,
+    MultiDrawIndexed,
+    DispatchCompute,
+    DispatchComputeIndirect,
+    ClearDepthStencil,
+    ClearRenderTarget,
+    UpdateBuffer,
+    CopyBuffer,
+    WriteBuffer,
+    UpdateTexture,
+    CopyTexture,
+    GenerateMips,
+    ResolveTextureSubresource,
+    BeginQuery,
+    EndQuery,
+    BeginDebugGroup,
+    EndDebugGroup,
+    InsertDebugLabel,
+};
+
+/// Header shared by all recorded commands. Commands form a singly-linked list in the stream arena.
+struct GLCommand
+{
+    GLCommand*    pNext = nullptr;
+    GLCommandType Type  = GLCommandType::InvalidateState;
+};
+
+template <GLCommandType CmdType>
+struct GLCommandBase : GLCommand
+{
+    static constexpr GLCommandType CommandType = CmdType;
+};
+
+// clang-format off
+struct GLCmdSetPipelineState : GLCommandBase<GLCommandType::SetPipelineState>
+{
+    IPipelineState* pPSO = nullptr;
+};
+
+struct GLCmdCommitShaderResources : GLCommandBase<GLCommandType::CommitShaderResources>
+{
+    IShaderResourceBinding*        pSRB                = nullptr;
+    RESOURCE_STATE_TRANSITION_MODE StateTransitionMode = RESOURCE_STATE_TRANSITION_MODE_NONE;
+};
+
+struct GLCmdSetStencilRef : GLCommandBase<GLCommandType::SetStencilRef>
+{
+    Uint32 StencilRef = 0;
+};
+
+struct GLCmdSetBlendFactors : GLCommandBase<GLCommandType::SetBlendFactors>
+{
+    float BlendFactors[4]    = {};
+    bool  UseDefaultFactors  = false;
+};
+
+struct GLCmdSetVertexBuffers : GLCommandBase<GLCommandType::SetVertexBuffers>
+{
+    Uint32                         StartSlot           = 0;
+    Uint32                         NumBuffersSet       = 0;
+    IBuffer**                      ppBuffers           = nullptr;
+    Uint64*                        pOffsets            = nullptr;
+    RESOURCE_STATE_TRANSITION_MODE StateTransitionMode = RESOURCE_STATE_TRANSITION_MODE_NONE;
+    SET_VERTEX_BUFFERS_FLAGS       Flags               = SET_VERTEX_BUFFERS_FLAG_NONE;
+};
+
+struct GLCmdSetIndexBuffer : GLCommandBase<GLCommandType::SetIndexBuffer>
+{
+    IBuffer*                       pIndexBuffer        = nullptr;
+    Uint64                         ByteOffset          = 0;
+    RESOURCE_STATE_TRANSITION_MODE StateTransitionMode = RESOURCE_STATE_TRANSITION_MODE_NONE;
+};
+
+struct GLCmdSetViewports : GLCommandBase<GLCommandType::SetViewports>
+{
+    Uint32    NumViewports = 0;
+    Viewport* pViewports   = nullptr;
+    Uint32    RTWidth      = 0;
+    Uint32    RTHeight     = 0;
+};
+
+struct GLCmdSetScissorRects : GLCommandBase<GLCommandType::SetScissorRects>
+{
+    Uint32 NumRects = 0;
+    Rect*  pRects   = nullptr;
+    Uint32 RTWidth  = 0;
+    Uint32 RTHeight = 0;
+};
+
+struct GLCmdSetRenderTargets : GLCommandBase<GLCommandType::SetRenderTargets>
+{
+    SetRenderTargetsAttribs Attribs;
+};
+
+struct GLCmdInvalidateState : GLCommandBase<GLCommandType::InvalidateState>
+{
+};
+
+struct GLCmdBeginRenderPass : GLCommandBase<GLCommandType::BeginRenderPass>
+{
+    BeginRenderPassAttribs Attribs;
+};
+
+struct GLCmdNextSubpass : GLCommandBase<GLCommandType::NextSubpass>
+{
+};
+
+struct GLCmdEndRenderPass : GLCommandBase<GLCommandType::EndRenderPass>
+{
+};
+
+struct GLCmdDraw : GLCommandBase<GLCommandType::Draw>
+{
+    DrawAttribs Attribs;
+};
+
+struct GLCmdDrawIndexed : GLCommandBase<GLCommandType::DrawIndexed>
+{
+    DrawIndexedAttribs Attribs;
+};
+
+struct GLCmdDrawIndirect : GLCommandBase<GLCommandType::DrawIndirect>
+{
+    DrawIndirectAttribs Attribs;
+};
+
+struct GLCmdDrawIndexedIndirect : GLCommandBase<GLCommandType::DrawIndexedIndirect>
+{
+    DrawIndexedIndirectAttribs Attribs;
+};
+
+struct GLCmdMultiDraw : GLCommandBase<GLCommandType::MultiDraw>
+{
+    MultiDrawAttribs Attribs;
+};
+
+struct GLCmdMultiDrawIndexed : GLCommandBase<GLCommandType::MultiDrawIndexed>
+{
+    MultiDrawIndexedAttribs Attribs;
+};
+
+struct GLCmdDispatchCompute : GLCommandBase<GLCommandType::DispatchCompute>
+{
+    DispatchComputeAttribs Attribs;
+};
+
+struct GLCmdDispatchComputeIndirect : GLCommandBase<GLCommandType::DispatchComputeIndirect>
+{
+    DispatchComputeIndirectAttribs Attribs;
+};
+
+struct GLCmdClearDepthStencil : GLCommandBase<GLCommandType::ClearDepthStencil>
+{
+    ITextureView*                  pView               = nullptr;
+    CLEAR_DEPTH_STENCIL_FLAGS      ClearFlags          = CLEAR_DEPTH_FLAG_NONE;
+    float                          fDepth              = 0;
+    Uint8                          Stencil             = 0;
+    RESOURCE_STATE_TRANSITION_MODE StateTransitionMode = RESOURCE_STATE_TRANSITION_MODE_NONE;
+};
+
+struct GLCmdClearRenderTarget : GLCommandBase<GLCommandType::ClearRenderTarget>
+{
+    ITextureView*                  pView               = nullptr;
+    Uint8                          RGBA[16]            = {}; // Four 32-bit float, int or uint components
+    RESOURCE_STATE_TRANSITION_MODE StateTransitionMode = RESOURCE_STATE_TRANSITION_MODE_NONE;
+};
+
+struct GLCmdUpdateBuffer : GLCommandBase<GLCommandType::UpdateBuffer>
+{
+    IBuffer*                       pBuffer             = nullptr;
+    Uint64                         Offset              = 0;
+    Uint64                         Size                = 0;
+    const void*                    pData               = nullptr;
+    RESOURCE_STATE_TRANSITION_MODE StateTransitionMode = RESOURCE_STATE_TRANSITION_MODE_NONE;
+};
+
+struct GLCmdCopyBuffer : GLCommandBase<GLCommandType::CopyBuffer>
+{
+    IBuffer*                       pSrcBuffer              = nullptr;
+    Uint64                         SrcOffset               = 0;
+    RESOURCE_STATE_TRANSITION_MODE SrcBufferTransitionMode = RESOURCE_STATE_TRANSITION_MODE_NONE;
+    IBuffer*                       pDstBuffer              = nullptr;
+    Uint64                         DstOffset               = 0;
+    Uint64                         Size                    = 0;
+    RESOURCE_STATE_TRANSITION_MODE DstBufferTransitionMode = RESOURCE_STATE_TRANSITION_MODE_NONE;
+};
+
+// Contents of a buffer mapped with MAP_WRITE and MAP_FLAG_DISCARD by a deferred context.
+// The data is written directly to the stream arena by the application and is uploaded
+// to the buffer when the command list is executed.
+struct GLCmdWriteBuffer : GLCommandBase<GLCommandType::WriteBuffer>
+{
+    IBuffer* pBuffer = nullptr;
+    Uint64   Size    = 0;
+    void*    pData   = nullptr;
+};
+
+struct GLCmdUpdateTexture : GLCommandBase<GLCommandType::UpdateTexture>
+{
+    ITexture*                      pTexture                     = nullptr;
+    Uint32                         MipLevel                     = 0;
+    Uint32                         Slice                        = 0;
+    Box                            DstBox;
+    TextureSubResData              SubresData;
+    RESOURCE_STATE_TRANSITION_MODE SrcBufferStateTransitionMode = RESOURCE_STATE_TRANSITION_MODE_NONE;
+    RESOURCE_STATE_TRANSITION_MODE TextureStateTransitionMode   = RESOURCE_STATE_TRANSITION_MODE_NONE;
+};
+
+struct GLCmdCopyTexture : GLCommandBase<GLCommandType::CopyTexture>
+{
+    CopyTextureAttribs Attribs;
+};
+
+struct GLCmdGenerateMips : GLCommandBase<GLCommandType::GenerateMips>
+{
+    ITextureView* pTexView = nullptr;
+};
+
+struct GLCmdResolveTextureSubresource : GLCommandBase<GLCommandType::ResolveTextureSubresource>
+{
+    ITexture*                        pSrcTexture = nullptr;
+    ITexture*                        pDstTexture = nullptr;
+    ResolveTextureSubresourceAttribs Attribs;
+};
+
+struct GLCmdBeginQuery : GLCommandBase<GLCommandType::BeginQuery>
+{
+    IQuery* pQuery = nullptr;
+};
+
+struct GLCmdEndQuery : GLCommandBase<GLCommandType::EndQuery>
+{
+    IQuery* pQuery = nullptr;
+};
+
+struct GLCmdBeginDebugGroup : GLCommandBase<GLCommandType::BeginDebugGroup>
+{
+    const Char* Name     = nullptr;
+    float       Color[4] = {};
+    bool        HasColor = false;
+};
+
+struct GLCmdEndDebugGroup : GLCommandBase<GLCommandType::EndDebugGroup>
+{
+};
+
+struct GLCmdInsertDebugLabel : GLCommandBase<GLCommandType::InsertDebugLabel>
+{
+    const Char* Label    = nullptr;
+    float       Color[4] = {};
+    bool        HasColor = false;
+};
+// clang-format on
+
+
+/// CPU-side command stream recorded by a deferred OpenGL context.
+
+/// OpenGL has no native command buffers, so a deferred context records its commands into
+/// a stream that is replayed by the immediate context in IDeviceContext::ExecuteCommandLists().
+/// Commands are plain structures allocated from a linear arena and linked in recording order.
+/// All data the commands point to (arrays, strings, buffer and texture contents) is copied
+/// into the same arena, and every referenced device object is kept alive by the stream,
+/// so the stream is self-contained and may be executed any number of times.
+class GLCommandStream
+{
+public:
+    explicit GLCommandStream(IMemoryAllocator& Allocator);
+    ~GLCommandStream();
+
+    // clang-format off
+    GLCommandStream           (const GLCommandStream&)  = delete;
+    GLCommandStream           (      GLCommandStream&&) = delete;
+    GLCommandStream& operator=(const GLCommandStream&)  = delete;
+    GLCommandStream& operator=(      GLCommandStream&&) = delete;
+    // clang-format on
+
+    /// Allocates a new command of the given type in the arena and appends it to the stream.
+    template <typename CmdType>
+    CmdType& Append()
+    {
+        static_assert(std::is_trivially_destructible<CmdType>::value, "Commands are never destroyed and must be trivially destructible");
+
+        CmdType* pCmd = new (m_Arena.Allocate<CmdType>()) CmdType{};
+        pCmd->Type    = CmdType::CommandType;
+        if (m_pLast != nullptr)
+            m_pLast->pNext = pCmd;
+        else
+            m_pFirst = pCmd;
+        m_pLast = pCmd;
+        ++m_NumCommands;
+        return *pCmd;
+    }
+
+    /// Keeps the object alive for as long as the stream exists and returns the same pointer.
+    template <typename ObjectType>
+    ObjectType* KeepAlive(ObjectType* pObject)
+    {
+        // The same object is often referenced by several consecutive commands
+        if (pObject != nullptr && pObject != m_pLastReferencedObject)
+        {
+            m_Objects.emplace_back(pObject);
+            m_pLastReferencedObject = pObject;
+        }
+        return pObject;
+    }
+
+    /// Copies an array of device object pointers into the arena and keeps all objects alive.
+    template <typename ObjectType>
+    ObjectType** CopyObjectArray(ObjectType* const* ppObjects, Uint32 Count)
+    {
+        if (ppObjects == nullptr || Count == 0)
+            return nullptr;
+
+        ObjectType** ppDstObjects = m_Arena.CopyArray(ppObjects, Count);
+        for (Uint32 i = 0; i < Count; ++i)
+            KeepAlive(ppDstObjects[i]);
+        return ppDstObjects;
+    }
+
+    template <typename T>
+    T* CopyArray(const T* pSrc, size_t Count)
+    {
+        return (pSrc != nullptr && Count != 0) ? m_Arena.CopyArray(pSrc, Count) : nullptr;
+    }
+
+    void* CopyData(const void* pData, size_t Size);
+
+    void* AllocateData(size_t Size);
+
+    const Char* CopyString(const Char* Str)
+    {
+        return m_Arena.CopyString(Str);
+    }
+
+    const GLCommand* GetFirstCommand() const { return m_pFirst; }
+    Uint32           GetNumCommands() const { return m_NumCommands; }
+
+private:
+    DynamicLinearAllocator m_Arena;
+
+    GLCommand* m_pFirst      = nullptr;
+    GLCommand* m_pLast       = nullptr;
+    Uint32     m_NumCommands = 0;
+
+    // Strong references to all objects used by the recorded commands
+    std::vector<RefCntAutoPtr<IObject>> m_Objects;
+
+    const IObject* m_pLastReferencedObject = nullptr;
+};
+
+} // namespace Diligent
@@ -28,6 +28,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include <EGL/egl.h>
 #include <android/native_window.h>
@@ -62,6 +63,22 @@ public:
 
     NativeGLContextType GetCurrentNativeGLContext();
 
+    /// Creates up to NumContexts contexts that share objects with the main context.
+
+    /// Worker contexts are used by the threads that compile shaders and link programs in the
+    /// background. The method must be called from the thread where the main context is current.
+    /// Returns the number of contexts that have been created.
+    Uint32 CreateWorkerContexts(Uint32 NumContexts);
+
+    /// Makes the worker context with the given index current in the calling thread.
+    bool MakeWorkerContextCurrent(Uint32 Index);
+
+    /// Releases the worker context that is current in the calling thread.
+    void ReleaseWorkerContext();
+
+    /// Destroys all worker contexts. The contexts must not be current in any thread.
+    void DestroyWorkerContexts();
+
     int32_t GetScreenWidth() const { return screen_width_; }
     int32_t GetScreenHeight() const { return screen_height_; }
 
@@ -82,6 +99,14 @@ private:
     std::unique_ptr<OpenXRAttribs> openxr_attribs_;
 #endif
 
+    struct WorkerContext
+    {
+        EGLContext context = EGL_NO_CONTEXT;
+        EGLSurface surface = EGL_NO_SURFACE;
+    };
+    EGLDisplay                 worker_display_ = EGL_NO_DISPLAY;
+    std::vector<WorkerContext> worker_contexts_;
+
     EGLint egl_major_version_ = 0;
     EGLint egl_minor_version_ = 0;
 
@@ -46,6 +46,12 @@ public:
     void                Suspend();
     NativeGLContextType GetCurrentNativeGLContext();
 
+    // Worker contexts are not supported on this platform.
+    Uint32 CreateWorkerContexts(Uint32 /*NumContexts*/) { return 0; }
+    bool   MakeWorkerContextCurrent(Uint32 /*Index*/) { return false; }
+    void   ReleaseWorkerContext() {}
+    void   DestroyWorkerContexts() {}
+
 private:
     NativeGLContextType m_GLContext = {};
     bool                m_IsCreated = false;
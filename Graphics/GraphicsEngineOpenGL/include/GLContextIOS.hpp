@@ -41,6 +41,12 @@ public:
               const struct SwapChainDesc*      pSCDesc);
 
     NativeGLContextType GetCurrentNativeGLContext();
+
+    // Worker contexts are not supported on this platform.
+    Uint32 CreateWorkerContexts(Uint32 /*NumContexts*/) { return 0; }
+    bool   MakeWorkerContextCurrent(Uint32 /*Index*/) { return false; }
+    void   ReleaseWorkerContext() {}
+    void   DestroyWorkerContexts() {}
 };
 
 } // namespace Diligent
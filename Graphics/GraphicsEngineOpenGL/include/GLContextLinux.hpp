@@ -27,6 +27,8 @@
 
 #pragma once
 
+#include <vector>
+
 namespace Diligent
 {
 
@@ -44,9 +46,32 @@ public:
 
     NativeGLContextType GetCurrentNativeGLContext();
 
+    /// Creates up to NumContexts contexts that share objects with the main context.
+
+    /// Worker contexts are used by the threads that compile shaders and link programs in the
+    /// background. The method must be called from the thread where the main context is current.
+    /// The worker contexts use the display connection of the main context, so no contexts are
+    /// created unless the application has indicated that it called XInitThreads
+    /// (see EngineGLCreateInfo::XInitThreadsCalled).
+    /// Returns the number of contexts that have been created.
+    Uint32 CreateWorkerContexts(Uint32 NumContexts);
+
+    /// Makes the worker context with the given index current in the calling thread.
+    bool MakeWorkerContextCurrent(Uint32 Index);
+
+    /// Releases the worker context that is current in the calling thread.
+    void ReleaseWorkerContext();
+
+    /// Destroys all worker contexts. The contexts must not be current in any thread.
+    void DestroyWorkerContexts();
+
 private:
-    Uint32 m_WindowId = 0;
-    void*  m_pDisplay = nullptr;
+    Uint32 m_WindowId           = 0;
+    void*  m_pDisplay           = nullptr;
+    bool   m_XInitThreadsCalled = false;
+
+    Display*                m_pWorkerDisplay = nullptr;
+    std::vector<GLXContext> m_WorkerContexts;
 };
 
 } // namespace Diligent
@@ -42,7 +42,9 @@ namespace Diligent
 class GLContextState
 {
 public:
-    GLContextState(class RenderDeviceGLImpl* pDeviceGL);
+    /// Deferred contexts never access the GL context, so their state object
+    /// is not initialized from it and must not be used to issue GL commands.
+    GLContextState(class RenderDeviceGLImpl* pDeviceGL, bool IsDeferredContext = false);
 
     // clang-format off
 
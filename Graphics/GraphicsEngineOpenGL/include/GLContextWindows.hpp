@@ -27,6 +27,8 @@
 
 #pragma once
 
+#include <vector>
+
 namespace Diligent
 {
 
@@ -44,12 +46,31 @@ public:
 
     NativeGLContextType GetCurrentNativeGLContext();
 
+    /// Creates up to NumContexts contexts that share objects with the main context.
+
+    /// Worker contexts are used by the threads that compile shaders and link programs in the
+    /// background. The method must be called from the thread where the main context is current.
+    /// Returns the number of contexts that have been created.
+    Uint32 CreateWorkerContexts(Uint32 NumContexts);
+
+    /// Makes the worker context with the given index current in the calling thread.
+    bool MakeWorkerContextCurrent(Uint32 Index);
+
+    /// Releases the worker context that is current in the calling thread.
+    void ReleaseWorkerContext();
+
+    /// Destroys all worker contexts. The contexts must not be current in any thread.
+    void DestroyWorkerContexts();
+
     HGLRC GetHandle() const { return m_Context; }
     HDC   GetWindowHandleToDeviceContext() const { return m_WindowHandleToDeviceContext; }
 
 private:
     HGLRC m_Context                     = NULL;
     HDC   m_WindowHandleToDeviceContext = NULL;
+
+    HDC                m_WorkerDC = NULL;
+    std::vector<HGLRC> m_WorkerContexts;
 };
 
 } // namespace Diligent
@@ -28,7 +28,9 @@
 
 #include <vector>
 #include <string>
+#include <functional>
 
+#include "AsyncInitializer.hpp"
 #include "GLObjectWrapper.hpp"
 #include "ShaderResourcesGL.hpp"
 #include "PipelineResourceSignatureGLImpl.hpp"
@@ -42,9 +44,27 @@ class GLContextState;
 class GLProgram
 {
 public:
+    /// Program binary previously retrieved with GetBinary().
+    struct Binary
+    {
+        GLenum      Format = 0;
+        const void* pData  = nullptr;
+        size_t      Size   = 0;
+    };
+
+    /// Creates the program and starts linking it.
+
+    /// If pBinary is not null, the program is first loaded from the binary. If the driver
+    /// rejects the binary, the program is linked from the shaders (see IsBinaryRejected()).
+    /// If RetrievableBinary is true, the driver is hinted that the binary will be retrieved.
+    /// If pLinkThreadPool is not null, the program is linked by a thread of this pool, which
+    /// must have a context that shares objects with the main context current.
     GLProgram(ShaderGLImpl* const* ppShaders,
               Uint32               NumShaders,
-              bool                 IsSeparableProgram) noexcept;
+              bool                 IsSeparableProgram,
+              const Binary*        pBinary           = nullptr,
+              bool                 RetrievableBinary = false,
+              IThreadPool*         pLinkThreadPool   = nullptr) noexcept;
     ~GLProgram();
 
     const GLObjectWrappers::GLProgramObj& GetGLHandle() const { return m_GLProg; }
@@ -72,18 +92,40 @@ public:
 
     void SetResources(std::shared_ptr<const ShaderResourcesGL> pResources);
 
+    /// Retrieves the program binary. The program must be successfully linked.
+    bool GetBinary(GLenum& Format, std::vector<Uint8>& Data) const;
+
+    bool IsLoadedFromBinary() const { return m_IsLoadedFromBinary; }
+    bool IsBinaryRejected() const { return m_IsBinaryRejected; }
+
+    using LinkedCallbackType = std::function<void(const GLProgram&)>;
+
+    /// Sets the callback that is called once by GetLinkStatus() when the program is successfully linked.
+    void SetLinkedCallback(LinkedCallbackType Callback) { m_LinkedCallback = std::move(Callback); }
+
     std::shared_ptr<const ShaderResourcesGL>& GetResources()
     {
         return m_pResources;
     }
 
+private:
+    bool LoadBinary(const Binary& Bin) noexcept;
+    void Link(bool IsSeparableProgram, bool RetrievableBinary) noexcept;
+
 private:
     GLObjectWrappers::GLProgramObj   m_GLProg{true};
     std::vector<const ShaderGLImpl*> m_AttachedShaders;
     std::string                      m_InfoLog;
 
-    LinkStatus m_LinkStatus      = LinkStatus::Undefined;
-    bool       m_BindingsApplied = false;
+    LinkStatus m_LinkStatus         = LinkStatus::Undefined;
+    bool       m_BindingsApplied    = false;
+    bool       m_IsLoadedFromBinary = false;
+    bool       m_IsBinaryRejected   = false;
+
+    LinkedCallbackType m_LinkedCallback;
+
+    // The task that links the program in a worker thread
+    std::unique_ptr<AsyncInitializer> m_LinkTask;
 
     std::shared_ptr<const ShaderResourcesGL> m_pResources;
 
@@ -30,8 +30,11 @@
 #include <unordered_map>
 #include <mutex>
 #include <vector>
+#include <string>
 
 #include "GraphicsTypesX.hpp"
+#include "DataBlob.h"
+#include "RefCntAutoPtr.hpp"
 #include "GLProgram.hpp"
 
 namespace Diligent
@@ -63,10 +66,60 @@ public:
         PipelineResourceLayoutDesc*  pResourceLayout    = nullptr;
         IPipelineResourceSignature** ppSignatures       = nullptr;
         Uint32                       NumSignatures      = 0;
+
+        // If not null, a newly created program is linked by a thread of this pool
+        IThreadPool* pLinkThreadPool = nullptr;
     };
 
     SharedGLProgramObjPtr GetProgram(const GetProgramAttribs& Attribs);
 
+    /// Enables the program binary cache and replaces its contents with the binaries from pData, if provided.
+
+    /// DriverId identifies the GL driver (vendor, renderer and version). The data written
+    /// with a different driver id is ignored.
+    /// Returns false if pData is not null and is invalid or corrupted.
+    bool EnableBinaryCache(std::string DriverId, const IDataBlob* pData);
+
+    bool IsBinaryCacheEnabled() const;
+
+    /// Serializes the program binary cache. Returns null if the cache is not enabled.
+    RefCntAutoPtr<IDataBlob> SerializeBinaryCache() const;
+
+private:
+    struct ProgramBinaryKey
+    {
+        Uint64 Low  = 0;
+        Uint64 High = 0;
+
+        constexpr bool operator==(const ProgramBinaryKey& Rhs) const noexcept
+        {
+            return Low == Rhs.Low && High == Rhs.High;
+        }
+
+        struct Hasher
+        {
+            size_t operator()(const ProgramBinaryKey& Key) const noexcept
+            {
+                return static_cast<size_t>(Key.Low);
+            }
+        };
+    };
+
+    struct ProgramBinaryData
+    {
+        GLenum             Format = 0;
+        std::vector<Uint8> Data;
+    };
+    using ProgramBinaryDataPtr = std::shared_ptr<const ProgramBinaryData>;
+
+    // Program binaries are keyed by the shader sources rather than by the shader IDs
+    // so that they can be reused by the next application run.
+    static ProgramBinaryKey ComputeBinaryKey(const GetProgramAttribs& Attribs, const std::string& DriverId);
+
+    SharedGLProgramObjPtr CreateProgram(const GetProgramAttribs& Attribs);
+
+    void StoreBinary(const ProgramBinaryKey& Key, const GLProgram& Program);
+
 private:
     struct ProgramCacheKey
     {
@@ -97,6 +150,11 @@ private:
 
     std::mutex                                                                           m_CacheMtx;
     std::unordered_map<ProgramCacheKey, std::weak_ptr<GLProgram>, ProgramCacheKeyHasher> m_Cache;
+
+    mutable std::mutex                                                                   m_BinaryCacheMtx;
+    bool                                                                                 m_BinaryCacheEnabled = false;
+    std::string                                                                          m_DriverId;
+    std::unordered_map<ProgramBinaryKey, ProgramBinaryDataPtr, ProgramBinaryKey::Hasher> m_Binaries;
 };
 
 } // namespace Diligent
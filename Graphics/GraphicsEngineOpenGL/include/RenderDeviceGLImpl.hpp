@@ -197,6 +197,15 @@ public:
     virtual NativeGLContextAttribs DILIGENT_CALL_TYPE GetNativeGLContextAttribs() const override final;
 #endif
 
+    /// Implementation of IRenderDeviceGL::EnableProgramBinaryCache().
+    virtual Bool DILIGENT_CALL_TYPE EnableProgramBinaryCache(const IDataBlob* pCacheData) override final;
+
+    /// Implementation of IRenderDeviceGL::WriteProgramBinaryCacheToBlob().
+    virtual Bool DILIGENT_CALL_TYPE WriteProgramBinaryCacheToBlob(IDataBlob** ppBlob) override final;
+
+    /// Implementation of IRenderDeviceGL::WriteProgramBinaryCacheToStream().
+    virtual Bool DILIGENT_CALL_TYPE WriteProgramBinaryCacheToStream(IFileStream* pStream) override final;
+
     FBOCache& GetFBOCache(GLContext::NativeGLContextType Context);
     void      OnReleaseTexture(ITexture* pTexture);
 
@@ -255,6 +264,7 @@ private:
     bool         CheckExtension(const Char* ExtensionString) const;
     void         FlagSupportedTexFormats();
     void         InitAdapterInfo();
+    void         InitShaderCompilationWorkers(Uint32 NumThreads);
 
     int m_ShowDebugGLOutput = 1;
 
@@ -75,15 +75,17 @@ DILIGENT_BEGIN_INTERFACE(IEngineFactoryOpenGL, IEngineFactory)
     /// \param [in]  EngineCI           - Engine creation info, see EngineGLCreateInfo.
     /// \param [out] ppDevice           - Address of the memory location where pointer to
     ///                                   the created device will be written.
-    /// \param [out] ppImmediateContext - Address of the memory location where pointer to
-    ///                                   the immediate device context will be written.
+    /// \param [out] ppContexts         - Address of the memory location where pointers to
+    ///                                   the contexts will be written. Immediate context goes at
+    ///                                   position 0. If `EngineCI.NumDeferredContexts > 0`,
+    ///                                   pointers to the deferred contexts are written afterwards.
     /// \param [in]  SCDesc             - Swap chain description.
     /// \param [out] ppSwapChain        - Address of the memory location where pointer to
     ///                                   the created swap chain will be written.
     VIRTUAL void METHOD(CreateDeviceAndSwapChainGL)(THIS_
                                                     const EngineGLCreateInfo REF EngineCI,
                                                     IRenderDevice**              ppDevice,
-                                                    IDeviceContext**             ppImmediateContext,
+                                                    IDeviceContext**             ppContexts,
                                                     const SwapChainDesc REF      SCDesc,
                                                     ISwapChain**                 ppSwapChain) PURE;
 
@@ -99,14 +101,16 @@ DILIGENT_BEGIN_INTERFACE(IEngineFactoryOpenGL, IEngineFactory)
     /// \param [in]  EngineCI           - Engine creation info, see EngineGLCreateInfo.
     /// \param [out] ppDevice           - Address of the memory location where pointer to
     /// 								  the created device will be written.
-    /// \param [out] ppImmediateContext - Address of the memory location where pointer to
-    /// 								  the immediate device context will be written.
+    /// \param [out] ppContexts         - Address of the memory location where pointers to
+    /// 								  the contexts will be written. Immediate context goes at
+    /// 								  position 0. If `EngineCI.NumDeferredContexts > 0`,
+    /// 								  pointers to the deferred contexts are written afterwards.
     /// 
     /// \note The application is responsible for presenting the main frame buffer.
     VIRTUAL void METHOD(AttachToActiveGLContext)(THIS_
                                                  const EngineGLCreateInfo REF EngineCI,
                                                  IRenderDevice**              ppDevice,
-                                                 IDeviceContext**             ppImmediateContext) PURE;
+                                                 IDeviceContext**             ppContexts) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -31,6 +31,8 @@
 /// Definition of the Diligent::IRenderDeviceGL interface
 
 #include "../../GraphicsEngine/interface/RenderDevice.h"
+#include "../../../Primitives/interface/DataBlob.h"
+#include "../../../Primitives/interface/FileStream.h"
 
 /// Namespace for the OpenGL implementation of the graphics engine
 DILIGENT_BEGIN_NAMESPACE(Diligent)
@@ -153,6 +155,46 @@ DILIGENT_BEGIN_INTERFACE(IRenderDeviceGL, IRenderDevice)
     /// Returns platform-specific GL context attributes
     VIRTUAL NativeGLContextAttribs METHOD(GetNativeGLContextAttribs)(THIS) CONST PURE;
 #endif
+
+    /// Enables the program binary cache.
+
+    /// \param [in] pCacheData - Optional data previously written by WriteProgramBinaryCacheToBlob()
+    ///                          or WriteProgramBinaryCacheToStream(). If the data was produced
+    ///                          by a different GL driver (vendor, renderer or version string
+    ///                          do not match) or is corrupted, it is ignored.
+    ///
+    /// \return     true if the cache has been enabled, and false if the driver does not
+    ///             support program binaries (e.g. `GL_NUM_PROGRAM_BINARY_FORMATS` is zero).
+    ///
+    /// When the cache is enabled, programs linked by the pipeline states are stored as
+    /// program binaries keyed by the GLSL sources of their shaders and the driver identity.
+    /// When a pipeline with the same shaders is created again, the program is loaded with
+    /// `glProgramBinary` instead of being linked. If the driver rejects a binary, the program
+    /// is linked from the shaders and the binary is replaced.
+    ///
+    /// \remarks   The method may be called multiple times. Every call replaces the cache contents
+    ///             with the binaries from pCacheData.
+    ///             The method must be called from the thread where the immediate context is current.
+    VIRTUAL Bool METHOD(EnableProgramBinaryCache)(THIS_
+                                                  const IDataBlob* pCacheData DEFAULT_VALUE(nullptr)) PURE;
+
+    /// Writes the program binary cache contents to a memory blob.
+
+    /// \param [out] ppBlob - Address of the memory location where a pointer to the created
+    ///                       data blob will be written.
+    ///
+    /// \return     true if the data was written successfully, and false otherwise
+    ///             (e.g. if the program binary cache is not enabled).
+    VIRTUAL Bool METHOD(WriteProgramBinaryCacheToBlob)(THIS_
+                                                       IDataBlob** ppBlob) PURE;
+
+    /// Writes the program binary cache contents to a file stream.
+
+    /// \param [in] pStream - Pointer to the IFileStream interface to use for writing.
+    ///
+    /// \return     true if the data was written successfully, and false otherwise.
+    VIRTUAL Bool METHOD(WriteProgramBinaryCacheToStream)(THIS_
+                                                         IFileStream* pStream) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -162,10 +204,13 @@ DILIGENT_END_INTERFACE
 
 // clang-format off
 
-#    define IRenderDeviceGL_CreateTextureFromGLHandle(This, ...)CALL_IFACE_METHOD(RenderDeviceGL, CreateTextureFromGLHandle, This, __VA_ARGS__)
-#    define IRenderDeviceGL_CreateBufferFromGLHandle(This, ...) CALL_IFACE_METHOD(RenderDeviceGL, CreateBufferFromGLHandle,  This, __VA_ARGS__)
-#    define IRenderDeviceGL_CreateDummyTexture(This, ...)       CALL_IFACE_METHOD(RenderDeviceGL, CreateDummyTexture,        This, __VA_ARGS__)
-#    define IRenderDeviceGL_GetNativeGLContextAttribs(This)     CALL_IFACE_METHOD(RenderDeviceGL, GetNativeGLContextAttribs, This)
+#    define IRenderDeviceGL_CreateTextureFromGLHandle(This, ...)           CALL_IFACE_METHOD(RenderDeviceGL, CreateTextureFromGLHandle,       This, __VA_ARGS__)
+#    define IRenderDeviceGL_CreateBufferFromGLHandle(This, ...)            CALL_IFACE_METHOD(RenderDeviceGL, CreateBufferFromGLHandle,        This, __VA_ARGS__)
+#    define IRenderDeviceGL_CreateDummyTexture(This, ...)                  CALL_IFACE_METHOD(RenderDeviceGL, CreateDummyTexture,              This, __VA_ARGS__)
+#    define IRenderDeviceGL_GetNativeGLContextAttribs(This)                CALL_IFACE_METHOD(RenderDeviceGL, GetNativeGLContextAttribs,       This)
+#    define IRenderDeviceGL_EnableProgramBinaryCache(This, ...)            CALL_IFACE_METHOD(RenderDeviceGL, EnableProgramBinaryCache,        This, __VA_ARGS__)
+#    define IRenderDeviceGL_WriteProgramBinaryCacheToBlob(This, ...)       CALL_IFACE_METHOD(RenderDeviceGL, WriteProgramBinaryCacheToBlob,   This, __VA_ARGS__)
+#    define IRenderDeviceGL_WriteProgramBinaryCacheToStream(This, ...)     CALL_IFACE_METHOD(RenderDeviceGL, WriteProgramBinaryCacheToStream, This, __VA_ARGS__)
 
 // clang-format on
 
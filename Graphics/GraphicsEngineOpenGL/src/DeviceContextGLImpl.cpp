@@ -49,6 +49,7 @@
 #include "PipelineStateGLImpl.hpp"
 #include "FenceGLImpl.hpp"
 #include "ShaderResourceBindingGLImpl.hpp"
+#include "CommandListGLImpl.hpp"
 
 #include "GLTypeConversions.hpp"
 #include "VAOCache.hpp"
@@ -58,6 +59,32 @@
 namespace Diligent
 {
 
+namespace
+{
+
+// Returns the size of the CPU memory that UpdateTexture() reads from SubresData.pData
+size_t GetTextureUpdateDataSize(const TextureDesc& TexDesc, const Box& DstBox, const TextureSubResData& SubresData)
+{
+    if (!DstBox.IsValid())
+        return 0;
+
+    const TextureFormatAttribs& FmtAttribs = GetTextureFormatAttribs(TexDesc.Format);
+
+    Uint32 NumRows = DstBox.Height();
+    Uint32 NumCols = DstBox.Width();
+    if (FmtAttribs.ComponentType == COMPONENT_TYPE_COMPRESSED)
+    {
+        // Compressed textures are updated by whole blocks
+        NumRows = (NumRows + FmtAttribs.BlockHeight - 1) / FmtAttribs.BlockHeight;
+        NumCols = (NumCols + FmtAttribs.BlockWidth - 1) / FmtAttribs.BlockWidth;
+    }
+    const Uint64 RowSize = Uint64{NumCols} * FmtAttribs.GetElementSize();
+
+    return StaticCast<size_t>(Uint64{DstBox.Depth() - 1} * SubresData.DepthStride + Uint64{NumRows - 1} * SubresData.Stride + RowSize);
+}
+
+} // namespace
+
 DeviceContextGLImpl::DeviceContextGLImpl(IReferenceCounters*      pRefCounters,
                                          RenderDeviceGLImpl*      pDeviceGL,
                                          const DeviceContextDesc& Desc) :
@@ -68,8 +95,9 @@ DeviceContextGLImpl::DeviceContextGLImpl(IReferenceCounters*      pRefCounters,
         pDeviceGL,
         Desc
     },
-    m_ContextState{pDeviceGL},
-    m_DefaultFBO  {false    }
+    m_ContextState    {pDeviceGL, Desc.IsDeferred},
+    m_DefaultFBO      {false    },
+    m_CmdListAllocator{GetRawAllocator(), sizeof(CommandListGLImpl), 64}
 // clang-format on
 {
     m_BoundWritableTextures.reserve(16);
@@ -81,12 +109,35 @@ IMPLEMENT_QUERY_INTERFACE(DeviceContextGLImpl, IID_DeviceContextGL, TDeviceConte
 
 void DeviceContextGLImpl::Begin(Uint32 ImmediateContextId)
 {
-    UNEXPECTED("OpenGL does not support deferred contexts");
-    (void)(ImmediateContextId);
+    DEV_CHECK_ERR(ImmediateContextId == 0, "OpenGL supports only one immediate context");
+    TDeviceContextBase::Begin(DeviceContextIndex{ImmediateContextId}, COMMAND_QUEUE_TYPE_GRAPHICS);
+}
+
+GLCommandStream& DeviceContextGLImpl::GetDeferredCommandStream()
+{
+    VERIFY_EXPR(IsDeferred());
+    DEV_CHECK_ERR(IsRecordingDeferredCommands(), "Deferred context must be in recording state. Call Begin() to start recording commands.");
+    if (!m_pDeferredCmdStream)
+        m_pDeferredCmdStream = std::make_unique<GLCommandStream>(GetRawAllocator());
+    return *m_pDeferredCmdStream;
 }
 
 void DeviceContextGLImpl::SetPipelineState(IPipelineState* pPipelineState)
 {
+    if (IsDeferred())
+    {
+        // The base class tracks the state recorded since the beginning of the command list or the last
+        // InvalidateState() call. This matches the state the immediate context is in when it replays
+        // the commands, so redundant state changes can be dropped at recording time.
+        if (!TDeviceContextBase::SetPipelineState(pPipelineState, PipelineStateGLImpl::IID_InternalImpl))
+            return;
+
+        GLCommandStream&       Stream = GetDeferredCommandStream();
+        GLCmdSetPipelineState& Cmd    = Stream.Append<GLCmdSetPipelineState>();
+        Cmd.pPSO                      = Stream.KeepAlive(pPipelineState);
+        return;
+    }
+
     if (!TDeviceContextBase::SetPipelineState(pPipelineState, PipelineStateGLImpl::IID_InternalImpl))
         return;
 
@@ -171,6 +222,15 @@ void DeviceContextGLImpl::TransitionShaderResources(IShaderResourceBinding* pSha
 
 void DeviceContextGLImpl::CommitShaderResources(IShaderResourceBinding* pShaderResourceBinding, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
+    if (IsDeferred())
+    {
+        GLCommandStream&            Stream = GetDeferredCommandStream();
+        GLCmdCommitShaderResources& Cmd    = Stream.Append<GLCmdCommitShaderResources>();
+        Cmd.pSRB                           = Stream.KeepAlive(pShaderResourceBinding);
+        Cmd.StateTransitionMode            = StateTransitionMode;
+        return;
+    }
+
     DeviceContextBase::CommitShaderResources(pShaderResourceBinding, StateTransitionMode, 0);
 
     ShaderResourceBindingGLImpl* const pShaderResBindingGL = ClassPtrCast<ShaderResourceBindingGLImpl>(pShaderResourceBinding);
@@ -185,6 +245,13 @@ void DeviceContextGLImpl::CommitShaderResources(IShaderResourceBinding* pShaderR
 
 void DeviceContextGLImpl::SetStencilRef(Uint32 StencilRef)
 {
+    if (IsDeferred())
+    {
+        if (TDeviceContextBase::SetStencilRef(StencilRef, 0))
+            GetDeferredCommandStream().Append<GLCmdSetStencilRef>().StencilRef = StencilRef;
+        return;
+    }
+
     if (TDeviceContextBase::SetStencilRef(StencilRef, 0))
     {
         m_ContextState.SetStencilRef(GL_FRONT, StencilRef);
@@ -194,6 +261,28 @@ void DeviceContextGLImpl::SetStencilRef(Uint32 StencilRef)
 
 void DeviceContextGLImpl::SetBlendFactors(const float* pBlendFactors)
 {
+    if (IsDeferred())
+    {
+        if (pBlendFactors != nullptr)
+        {
+            if (!TDeviceContextBase::SetBlendFactors(pBlendFactors, 0))
+                return;
+        }
+        else
+        {
+            // Default factors are resolved at replay time, so make sure the next call is always recorded
+            for (float& Factor : m_BlendFactors)
+                Factor = -1;
+        }
+
+        GLCmdSetBlendFactors& Cmd = GetDeferredCommandStream().Append<GLCmdSetBlendFactors>();
+        if (pBlendFactors != nullptr)
+            memcpy(Cmd.BlendFactors, pBlendFactors, sizeof(Cmd.BlendFactors));
+        else
+            Cmd.UseDefaultFactors = true;
+        return;
+    }
+
     if (TDeviceContextBase::SetBlendFactors(pBlendFactors, 0))
     {
         m_ContextState.SetBlendFactors(m_BlendFactors);
@@ -207,15 +296,40 @@ void DeviceContextGLImpl::SetVertexBuffers(Uint32                         StartS
                                            RESOURCE_STATE_TRANSITION_MODE StateTransitionMode,
                                            SET_VERTEX_BUFFERS_FLAGS       Flags)
 {
+    if (IsDeferred())
+    {
+        GLCommandStream&       Stream = GetDeferredCommandStream();
+        GLCmdSetVertexBuffers& Cmd    = Stream.Append<GLCmdSetVertexBuffers>();
+        Cmd.StartSlot                 = StartSlot;
+        Cmd.NumBuffersSet             = NumBuffersSet;
+        Cmd.ppBuffers                 = Stream.CopyObjectArray(ppBuffers, NumBuffersSet);
+        Cmd.pOffsets                  = Stream.CopyArray(pOffsets, NumBuffersSet);
+        Cmd.StateTransitionMode       = StateTransitionMode;
+        Cmd.Flags                     = Flags;
+        return;
+    }
+
     TDeviceContextBase::SetVertexBuffers(StartSlot, NumBuffersSet, ppBuffers, pOffsets, StateTransitionMode, Flags);
     m_ContextState.InvalidateVAO();
 }
 
 void DeviceContextGLImpl::InvalidateState()
 {
-    TDeviceContextBase::InvalidateState();
+    if (IsDeferred())
+    {
+        TDeviceContextBase::InvalidateState();
+        GetDeferredCommandStream().Append<GLCmdInvalidateState>();
+        return;
+    }
 
+    InvalidateCommittedState();
     m_ContextState.Invalidate();
+}
+
+void DeviceContextGLImpl::InvalidateCommittedState()
+{
+    TDeviceContextBase::InvalidateState();
+
     m_BindInfo.Invalidate();
     m_BoundWritableTextures.clear();
     m_BoundWritableBuffers.clear();
@@ -226,12 +340,37 @@ void DeviceContextGLImpl::InvalidateState()
 
 void DeviceContextGLImpl::SetIndexBuffer(IBuffer* pIndexBuffer, Uint64 ByteOffset, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
+    if (IsDeferred())
+    {
+        if (m_pIndexBuffer.RawPtr() == pIndexBuffer && m_IndexDataStartOffset == ByteOffset)
+            return;
+        TDeviceContextBase::SetIndexBuffer(pIndexBuffer, ByteOffset, StateTransitionMode);
+
+        GLCommandStream&     Stream = GetDeferredCommandStream();
+        GLCmdSetIndexBuffer& Cmd    = Stream.Append<GLCmdSetIndexBuffer>();
+        Cmd.pIndexBuffer            = Stream.KeepAlive(pIndexBuffer);
+        Cmd.ByteOffset              = ByteOffset;
+        Cmd.StateTransitionMode     = StateTransitionMode;
+        return;
+    }
+
     TDeviceContextBase::SetIndexBuffer(pIndexBuffer, ByteOffset, StateTransitionMode);
     m_ContextState.InvalidateVAO();
 }
 
 void DeviceContextGLImpl::SetViewports(Uint32 NumViewports, const Viewport* pViewports, Uint32 RTWidth, Uint32 RTHeight)
 {
+    if (IsDeferred())
+    {
+        GLCommandStream&   Stream = GetDeferredCommandStream();
+        GLCmdSetViewports& Cmd    = Stream.Append<GLCmdSetViewports>();
+        Cmd.NumViewports          = NumViewports;
+        Cmd.pViewports            = Stream.CopyArray(pViewports, NumViewports);
+        Cmd.RTWidth               = RTWidth;
+        Cmd.RTHeight              = RTHeight;
+        return;
+    }
+
     TDeviceContextBase::SetViewports(NumViewports, pViewports, RTWidth, RTHeight);
 
     VERIFY(NumViewports == m_NumViewports, "Unexpected number of viewports");
@@ -315,6 +454,17 @@ void DeviceContextGLImpl::SetViewports(Uint32 NumViewports, const Viewport* pVie
 
 void DeviceContextGLImpl::SetScissorRects(Uint32 NumRects, const Rect* pRects, Uint32 RTWidth, Uint32 RTHeight)
 {
+    if (IsDeferred())
+    {
+        GLCommandStream&      Stream = GetDeferredCommandStream();
+        GLCmdSetScissorRects& Cmd    = Stream.Append<GLCmdSetScissorRects>();
+        Cmd.NumRects                 = NumRects;
+        Cmd.pRects                   = Stream.CopyArray(pRects, NumRects);
+        Cmd.RTWidth                  = RTWidth;
+        Cmd.RTHeight                 = RTHeight;
+        return;
+    }
+
     TDeviceContextBase::SetScissorRects(NumRects, pRects, RTWidth, RTHeight);
 
     VERIFY(NumRects == m_NumScissorRects, "Unexpected number of scissor rects");
@@ -445,6 +595,17 @@ void DeviceContextGLImpl::CommitRenderTargets()
 
 void DeviceContextGLImpl::SetRenderTargetsExt(const SetRenderTargetsAttribs& Attribs)
 {
+    if (IsDeferred())
+    {
+        GLCommandStream&       Stream = GetDeferredCommandStream();
+        GLCmdSetRenderTargets& Cmd    = Stream.Append<GLCmdSetRenderTargets>();
+        Cmd.Attribs                   = Attribs;
+        Cmd.Attribs.ppRenderTargets   = Stream.CopyObjectArray(Attribs.ppRenderTargets, Attribs.NumRenderTargets);
+        Cmd.Attribs.pDepthStencil     = Stream.KeepAlive(Attribs.pDepthStencil);
+        Cmd.Attribs.pShadingRateMap   = Stream.KeepAlive(Attribs.pShadingRateMap);
+        return;
+    }
+
     DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "Calling SetRenderTargets inside active render pass is invalid. End the render pass first");
 
     if (TDeviceContextBase::SetRenderTargets(Attribs))
@@ -660,6 +821,17 @@ void DeviceContextGLImpl::EndSubpass()
 
 void DeviceContextGLImpl::BeginRenderPass(const BeginRenderPassAttribs& Attribs)
 {
+    if (IsDeferred())
+    {
+        GLCommandStream&      Stream = GetDeferredCommandStream();
+        GLCmdBeginRenderPass& Cmd    = Stream.Append<GLCmdBeginRenderPass>();
+        Cmd.Attribs                  = Attribs;
+        Cmd.Attribs.pRenderPass      = Stream.KeepAlive(Attribs.pRenderPass);
+        Cmd.Attribs.pFramebuffer     = Stream.KeepAlive(Attribs.pFramebuffer);
+        Cmd.Attribs.pClearValues     = Stream.CopyArray(Attribs.pClearValues, Attribs.ClearValueCount);
+        return;
+    }
+
     TDeviceContextBase::BeginRenderPass(Attribs);
 
     m_AttachmentClearValues.resize(Attribs.ClearValueCount);
@@ -675,6 +847,12 @@ void DeviceContextGLImpl::BeginRenderPass(const BeginRenderPassAttribs& Attribs)
 
 void DeviceContextGLImpl::NextSubpass()
 {
+    if (IsDeferred())
+    {
+        GetDeferredCommandStream().Append<GLCmdNextSubpass>();
+        return;
+    }
+
     EndSubpass();
     TDeviceContextBase::NextSubpass();
     BeginSubpass();
@@ -682,6 +860,12 @@ void DeviceContextGLImpl::NextSubpass()
 
 void DeviceContextGLImpl::EndRenderPass()
 {
+    if (IsDeferred())
+    {
+        GetDeferredCommandStream().Append<GLCmdEndRenderPass>();
+        return;
+    }
+
     EndSubpass();
     TDeviceContextBase::EndRenderPass();
     m_ContextState.InvalidateFBO();
@@ -895,6 +1079,12 @@ inline void DrawArrays(GLenum  GlTopology,
 
 void DeviceContextGLImpl::Draw(const DrawAttribs& Attribs)
 {
+    if (IsDeferred())
+    {
+        GetDeferredCommandStream().Append<GLCmdDraw>().Attribs = Attribs;
+        return;
+    }
+
     TDeviceContextBase::Draw(Attribs, 0);
 
     GLenum GlTopology;
@@ -933,6 +1123,15 @@ inline void MultiDrawArrays(GLenum         GlTopology,
 
 void DeviceContextGLImpl::MultiDraw(const MultiDrawAttribs& Attribs)
 {
+    if (IsDeferred())
+    {
+        GLCommandStream& Stream = GetDeferredCommandStream();
+        GLCmdMultiDraw&  Cmd    = Stream.Append<GLCmdMultiDraw>();
+        Cmd.Attribs             = Attribs;
+        Cmd.Attribs.pDrawItems  = Stream.CopyArray(Attribs.pDrawItems, Attribs.DrawCount);
+        return;
+    }
+
     TDeviceContextBase::MultiDraw(Attribs, 0);
 
     GLenum GlTopology;
@@ -1027,6 +1226,12 @@ inline void DrawElements(GLenum  GlTopology,
 
 void DeviceContextGLImpl::DrawIndexed(const DrawIndexedAttribs& Attribs)
 {
+    if (IsDeferred())
+    {
+        GetDeferredCommandStream().Append<GLCmdDrawIndexed>().Attribs = Attribs;
+        return;
+    }
+
     TDeviceContextBase::DrawIndexed(Attribs, 0);
 
     GLenum GlTopology;
@@ -1081,6 +1286,15 @@ inline void MultiDrawElements(GLenum   GlTopology,
 
 void DeviceContextGLImpl::MultiDrawIndexed(const MultiDrawIndexedAttribs& Attribs)
 {
+    if (IsDeferred())
+    {
+        GLCommandStream&       Stream = GetDeferredCommandStream();
+        GLCmdMultiDrawIndexed& Cmd    = Stream.Append<GLCmdMultiDrawIndexed>();
+        Cmd.Attribs                   = Attribs;
+        Cmd.Attribs.pDrawItems        = Stream.CopyArray(Attribs.pDrawItems, Attribs.DrawCount);
+        return;
+    }
+
     TDeviceContextBase::MultiDrawIndexed(Attribs, 0);
 
     GLenum GlTopology;
@@ -1193,6 +1407,16 @@ void DeviceContextGLImpl::PrepareForIndirectDrawCount(IBuffer* pCountBuffer)
 
 void DeviceContextGLImpl::DrawIndirect(const DrawIndirectAttribs& Attribs)
 {
+    if (IsDeferred())
+    {
+        GLCommandStream&   Stream = GetDeferredCommandStream();
+        GLCmdDrawIndirect& Cmd    = Stream.Append<GLCmdDrawIndirect>();
+        Cmd.Attribs               = Attribs;
+        Stream.KeepAlive(Attribs.pAttribsBuffer);
+        Stream.KeepAlive(Attribs.pCounterBuffer);
+        return;
+    }
+
     TDeviceContextBase::DrawIndirect(Attribs, 0);
 
     GLenum GlTopology;
@@ -1267,6 +1491,16 @@ void DeviceContextGLImpl::DrawIndirect(const DrawIndirectAttribs& Attribs)
 
 void DeviceContextGLImpl::DrawIndexedIndirect(const DrawIndexedIndirectAttribs& Attribs)
 {
+    if (IsDeferred())
+    {
+        GLCommandStream&          Stream = GetDeferredCommandStream();
+        GLCmdDrawIndexedIndirect& Cmd    = Stream.Append<GLCmdDrawIndexedIndirect>();
+        Cmd.Attribs                      = Attribs;
+        Stream.KeepAlive(Attribs.pAttribsBuffer);
+        Stream.KeepAlive(Attribs.pCounterBuffer);
+        return;
+    }
+
     TDeviceContextBase::DrawIndexedIndirect(Attribs, 0);
 
     GLenum GlTopology;
@@ -1359,6 +1593,12 @@ void DeviceContextGLImpl::DrawMeshIndirect(const DrawMeshIndirectAttribs& Attrib
 
 void DeviceContextGLImpl::DispatchCompute(const DispatchComputeAttribs& Attribs)
 {
+    if (IsDeferred())
+    {
+        GetDeferredCommandStream().Append<GLCmdDispatchCompute>().Attribs = Attribs;
+        return;
+    }
+
     TDeviceContextBase::DispatchCompute(Attribs, 0);
 
 #if GL_ARB_compute_shader
@@ -1389,6 +1629,15 @@ void DeviceContextGLImpl::DispatchCompute(const DispatchComputeAttribs& Attribs)
 
 void DeviceContextGLImpl::DispatchComputeIndirect(const DispatchComputeIndirectAttribs& Attribs)
 {
+    if (IsDeferred())
+    {
+        GLCommandStream&              Stream = GetDeferredCommandStream();
+        GLCmdDispatchComputeIndirect& Cmd    = Stream.Append<GLCmdDispatchComputeIndirect>();
+        Cmd.Attribs                          = Attribs;
+        Stream.KeepAlive(Attribs.pAttribsBuffer);
+        return;
+    }
+
     TDeviceContextBase::DispatchComputeIndirect(Attribs, 0);
 
 #if GL_ARB_compute_shader
@@ -1435,6 +1684,18 @@ void DeviceContextGLImpl::ClearDepthStencil(ITextureView*                  pView
                                             Uint8                          Stencil,
                                             RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
+    if (IsDeferred())
+    {
+        GLCommandStream&        Stream = GetDeferredCommandStream();
+        GLCmdClearDepthStencil& Cmd    = Stream.Append<GLCmdClearDepthStencil>();
+        Cmd.pView                      = Stream.KeepAlive(pView);
+        Cmd.ClearFlags                 = ClearFlags;
+        Cmd.fDepth                     = fDepth;
+        Cmd.Stencil                    = Stencil;
+        Cmd.StateTransitionMode        = StateTransitionMode;
+        return;
+    }
+
     TDeviceContextBase::ClearDepthStencil(pView);
 
     if (pView != m_pBoundDepthStencil)
@@ -1474,6 +1735,18 @@ void DeviceContextGLImpl::ClearDepthStencil(ITextureView*                  pView
 
 void DeviceContextGLImpl::ClearRenderTarget(ITextureView* pView, const void* RGBA, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
+    if (IsDeferred())
+    {
+        GLCommandStream&        Stream = GetDeferredCommandStream();
+        GLCmdClearRenderTarget& Cmd    = Stream.Append<GLCmdClearRenderTarget>();
+        Cmd.pView                      = Stream.KeepAlive(pView);
+        // Null color is equivalent to zero color
+        if (RGBA != nullptr)
+            memcpy(Cmd.RGBA, RGBA, sizeof(Cmd.RGBA));
+        Cmd.StateTransitionMode = StateTransitionMode;
+        return;
+    }
+
     TDeviceContextBase::ClearRenderTarget(pView);
 
     Int32 RTIndex = -1;
@@ -1553,6 +1826,10 @@ void DeviceContextGLImpl::ClearRenderTarget(ITextureView* pView, const void* RGB
 
 void DeviceContextGLImpl::Flush()
 {
+    DEV_CHECK_ERR(!IsDeferred(), "Flush() should only be called for immediate contexts.");
+    if (IsDeferred())
+        return;
+
     DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "Flushing device context inside an active render pass.");
 
     glFlush();
@@ -1567,13 +1844,308 @@ void DeviceContextGLImpl::FinishFrame()
 
 void DeviceContextGLImpl::FinishCommandList(ICommandList** ppCommandList)
 {
-    LOG_ERROR("Deferred contexts are not supported in OpenGL mode");
+    DEV_CHECK_ERR(IsDeferred(), "Only deferred context can record command list");
+    DEV_CHECK_ERR(m_pActiveRenderPass == nullptr, "Finishing command list inside an active render pass.");
+
+    std::unique_ptr<GLCommandStream> pCmdStream = std::move(m_pDeferredCmdStream);
+    if (!pCmdStream)
+        pCmdStream = std::make_unique<GLCommandStream>(GetRawAllocator());
+
+    CommandListGLImpl* pCmdListGL(NEW_RC_OBJ(m_CmdListAllocator, "CommandListGLImpl instance", CommandListGLImpl)(m_pDevice, this, std::move(pCmdStream)));
+    pCmdListGL->QueryInterface(IID_CommandList, reinterpret_cast<IObject**>(ppCommandList));
+
+    TDeviceContextBase::FinishCommandList();
+
+    // The next command list starts from the default state
+    TDeviceContextBase::ClearStateCache();
 }
 
 void DeviceContextGLImpl::ExecuteCommandLists(Uint32               NumCommandLists,
                                               ICommandList* const* ppCommandLists)
 {
-    LOG_ERROR("Deferred contexts are not supported in OpenGL mode");
+    DEV_CHECK_ERR(!IsDeferred(), "Only immediate context can execute command list");
+
+    if (NumCommandLists == 0)
+        return;
+    DEV_CHECK_ERR(ppCommandLists != nullptr, "ppCommandLists must not be null when NumCommandLists is not zero");
+
+    for (Uint32 i = 0; i < NumCommandLists; ++i)
+    {
+        // Every command list starts from the default state, same as in other backends.
+        // The GL context state cache remains valid though, so there is no need to invalidate it.
+        InvalidateCommittedState();
+
+        const CommandListGLImpl* pCmdListGL = ClassPtrCast<const CommandListGLImpl>(ppCommandLists[i]);
+        ExecuteCommandStream(pCmdListGL->GetCommandStream());
+    }
+
+    // Device context is now in default state
+    InvalidateCommittedState();
+}
+
+void DeviceContextGLImpl::ExecuteCommandStream(const GLCommandStream& CmdStream)
+{
+    // Viewports and scissor rects are set by value and are often re-recorded by every command list
+    // (or by every draw). Track the last applied values to skip redundant updates. Any command that
+    // may reset viewports or scissor rects in the base class invalidates the tracked values.
+    const GLCmdSetViewports*    pLastViewports    = nullptr;
+    const GLCmdSetScissorRects* pLastScissorRects = nullptr;
+
+    for (const GLCommand* pCmd = CmdStream.GetFirstCommand(); pCmd != nullptr; pCmd = pCmd->pNext)
+    {
+        switch (pCmd->Type)
+        {
+            case GLCommandType::SetPipelineState:
+            {
+                // Redundant pipeline changes are filtered out by SetPipelineState()
+                const auto& Cmd = static_cast<const GLCmdSetPipelineState&>(*pCmd);
+                SetPipelineState(Cmd.pPSO);
+                break;
+            }
+
+            case GLCommandType::CommitShaderResources:
+            {
+                // Resources must be committed every time as the commit also issues pending memory barriers
+                const auto& Cmd = static_cast<const GLCmdCommitShaderResources&>(*pCmd);
+                CommitShaderResources(Cmd.pSRB, Cmd.StateTransitionMode);
+                break;
+            }
+
+            case GLCommandType::SetStencilRef:
+            {
+                const auto& Cmd = static_cast<const GLCmdSetStencilRef&>(*pCmd);
+                SetStencilRef(Cmd.StencilRef);
+                break;
+            }
+
+            case GLCommandType::SetBlendFactors:
+            {
+                const auto& Cmd = static_cast<const GLCmdSetBlendFactors&>(*pCmd);
+                SetBlendFactors(Cmd.UseDefaultFactors ? nullptr : Cmd.BlendFactors);
+                break;
+            }
+
+            case GLCommandType::SetVertexBuffers:
+            {
+                const auto& Cmd = static_cast<const GLCmdSetVertexBuffers&>(*pCmd);
+
+                // Skip the command if it does not change the bound vertex buffers to avoid invalidating the VAO
+                bool IsRedundant = Cmd.StartSlot + Cmd.NumBuffersSet <= m_NumVertexStreams;
+                if ((Cmd.Flags & SET_VERTEX_BUFFERS_FLAG_RESET) != 0)
+                    IsRedundant = IsRedundant && Cmd.StartSlot == 0 && Cmd.NumBuffersSet == m_NumVertexStreams;
+                for (Uint32 i = 0; i < Cmd.NumBuffersSet && IsRedundant; ++i)
+                {
+                    const VertexStreamInfo<BufferGLImpl>& Stream = m_VertexStreams[Cmd.StartSlot + i];
+
+                    IBuffer* const pBuffer = Cmd.ppBuffers != nullptr ? Cmd.ppBuffers[i] : nullptr;
+                    const Uint64   Offset  = Cmd.pOffsets != nullptr ? Cmd.pOffsets[i] : 0;
+                    IsRedundant            = Stream.pBuffer.RawPtr() == pBuffer && Stream.Offset == Offset;
+                }
+                if (!IsRedundant)
+                    SetVertexBuffers(Cmd.StartSlot, Cmd.NumBuffersSet, Cmd.ppBuffers, Cmd.pOffsets, Cmd.StateTransitionMode, Cmd.Flags);
+                break;
+            }
+
+            case GLCommandType::SetIndexBuffer:
+            {
+                const auto& Cmd = static_cast<const GLCmdSetIndexBuffer&>(*pCmd);
+                if (m_pIndexBuffer.RawPtr() != Cmd.pIndexBuffer || m_IndexDataStartOffset != Cmd.ByteOffset)
+                    SetIndexBuffer(Cmd.pIndexBuffer, Cmd.ByteOffset, Cmd.StateTransitionMode);
+                break;
+            }
+
+            case GLCommandType::SetViewports:
+            {
+                const auto& Cmd = static_cast<const GLCmdSetViewports&>(*pCmd);
+                if (pLastViewports == nullptr ||
+                    pLastViewports->NumViewports != Cmd.NumViewports ||
+                    pLastViewports->RTWidth != Cmd.RTWidth ||
+                    pLastViewports->RTHeight != Cmd.RTHeight ||
+                    !std::equal(Cmd.pViewports, Cmd.pViewports + Cmd.NumViewports, pLastViewports->pViewports))
+                {
+                    SetViewports(Cmd.NumViewports, Cmd.pViewports, Cmd.RTWidth, Cmd.RTHeight);
+                    pLastViewports = &Cmd;
+                }
+                break;
+            }
+
+            case GLCommandType::SetScissorRects:
+            {
+                const auto& Cmd = static_cast<const GLCmdSetScissorRects&>(*pCmd);
+                if (pLastScissorRects == nullptr ||
+                    pLastScissorRects->NumRects != Cmd.NumRects ||
+                    pLastScissorRects->RTWidth != Cmd.RTWidth ||
+                    pLastScissorRects->RTHeight != Cmd.RTHeight ||
+                    !std::equal(Cmd.pRects, Cmd.pRects + Cmd.NumRects, pLastScissorRects->pRects))
+                {
+                    SetScissorRects(Cmd.NumRects, Cmd.pRects, Cmd.RTWidth, Cmd.RTHeight);
+                    pLastScissorRects = &Cmd;
+                }
+                break;
+            }
+
+            case GLCommandType::SetRenderTargets:
+            {
+                // Redundant render target changes are filtered out by SetRenderTargetsExt()
+                const auto& Cmd = static_cast<const GLCmdSetRenderTargets&>(*pCmd);
+                SetRenderTargetsExt(Cmd.Attribs);
+                pLastViewports    = nullptr;
+                pLastScissorRects = nullptr;
+                break;
+            }
+
+            case GLCommandType::InvalidateState:
+                InvalidateCommittedState();
+                pLastViewports    = nullptr;
+                pLastScissorRects = nullptr;
+                break;
+
+            case GLCommandType::BeginRenderPass:
+                BeginRenderPass(static_cast<const GLCmdBeginRenderPass&>(*pCmd).Attribs);
+                pLastViewports    = nullptr;
+                pLastScissorRects = nullptr;
+                break;
+
+            case GLCommandType::NextSubpass:
+                NextSubpass();
+                pLastViewports    = nullptr;
+                pLastScissorRects = nullptr;
+                break;
+
+            case GLCommandType::EndRenderPass:
+                EndRenderPass();
+                pLastViewports    = nullptr;
+                pLastScissorRects = nullptr;
+                break;
+
+            case GLCommandType::Draw:
+                Draw(static_cast<const GLCmdDraw&>(*pCmd).Attribs);
+                break;
+
+            case GLCommandType::DrawIndexed:
+                DrawIndexed(static_cast<const GLCmdDrawIndexed&>(*pCmd).Attribs);
+                break;
+
+            case GLCommandType::DrawIndirect:
+                DrawIndirect(static_cast<const GLCmdDrawIndirect&>(*pCmd).Attribs);
+                break;
+
+            case GLCommandType::DrawIndexedIndirect:
+                DrawIndexedIndirect(static_cast<const GLCmdDrawIndexedIndirect&>(*pCmd).Attribs);
+                break;
+
+            case GLCommandType::MultiDraw:
+                MultiDraw(static_cast<const GLCmdMultiDraw&>(*pCmd).Attribs);
+                break;
+
+            case GLCommandType::MultiDrawIndexed:
+                MultiDrawIndexed(static_cast<const GLCmdMultiDrawIndexed&>(*pCmd).Attribs);
+                break;
+
+            case GLCommandType::DispatchCompute:
+                DispatchCompute(static_cast<const GLCmdDispatchCompute&>(*pCmd).Attribs);
+                break;
+
+            case GLCommandType::DispatchComputeIndirect:
+                DispatchComputeIndirect(static_cast<const GLCmdDispatchComputeIndirect&>(*pCmd).Attribs);
+                break;
+
+            case GLCommandType::ClearDepthStencil:
+            {
+                const auto& Cmd = static_cast<const GLCmdClearDepthStencil&>(*pCmd);
+                ClearDepthStencil(Cmd.pView, Cmd.ClearFlags, Cmd.fDepth, Cmd.Stencil, Cmd.StateTransitionMode);
+                break;
+            }
+
+            case GLCommandType::ClearRenderTarget:
+            {
+                const auto& Cmd = static_cast<const GLCmdClearRenderTarget&>(*pCmd);
+                ClearRenderTarget(Cmd.pView, Cmd.RGBA, Cmd.StateTransitionMode);
+                break;
+            }
+
+            case GLCommandType::UpdateBuffer:
+            {
+                const auto& Cmd = static_cast<const GLCmdUpdateBuffer&>(*pCmd);
+                UpdateBuffer(Cmd.pBuffer, Cmd.Offset, Cmd.Size, Cmd.pData, Cmd.StateTransitionMode);
+                break;
+            }
+
+            case GLCommandType::CopyBuffer:
+            {
+                const auto& Cmd = static_cast<const GLCmdCopyBuffer&>(*pCmd);
+                CopyBuffer(Cmd.pSrcBuffer, Cmd.SrcOffset, Cmd.SrcBufferTransitionMode, Cmd.pDstBuffer, Cmd.DstOffset, Cmd.Size, Cmd.DstBufferTransitionMode);
+                break;
+            }
+
+            case GLCommandType::WriteBuffer:
+            {
+                const auto& Cmd         = static_cast<const GLCmdWriteBuffer&>(*pCmd);
+                PVoid       pMappedData = nullptr;
+                MapBuffer(Cmd.pBuffer, MAP_WRITE, MAP_FLAG_DISCARD, pMappedData);
+                if (pMappedData != nullptr)
+                {
+                    memcpy(pMappedData, Cmd.pData, StaticCast<size_t>(Cmd.Size));
+                    UnmapBuffer(Cmd.pBuffer, MAP_WRITE);
+                }
+                break;
+            }
+
+            case GLCommandType::UpdateTexture:
+            {
+                const auto& Cmd = static_cast<const GLCmdUpdateTexture&>(*pCmd);
+                UpdateTexture(Cmd.pTexture, Cmd.MipLevel, Cmd.Slice, Cmd.DstBox, Cmd.SubresData, Cmd.SrcBufferStateTransitionMode, Cmd.TextureStateTransitionMode);
+                break;
+            }
+
+            case GLCommandType::CopyTexture:
+                CopyTexture(static_cast<const GLCmdCopyTexture&>(*pCmd).Attribs);
+                break;
+
+            case GLCommandType::GenerateMips:
+                GenerateMips(static_cast<const GLCmdGenerateMips&>(*pCmd).pTexView);
+                break;
+
+            case GLCommandType::ResolveTextureSubresource:
+            {
+                // Resolve binds its own framebuffers
+                const auto& Cmd = static_cast<const GLCmdResolveTextureSubresource&>(*pCmd);
+                ResolveTextureSubresource(Cmd.pSrcTexture, Cmd.pDstTexture, Cmd.Attribs);
+                pLastViewports    = nullptr;
+                pLastScissorRects = nullptr;
+                break;
+            }
+
+            case GLCommandType::BeginQuery:
+                BeginQuery(static_cast<const GLCmdBeginQuery&>(*pCmd).pQuery);
+                break;
+
+            case GLCommandType::EndQuery:
+                EndQuery(static_cast<const GLCmdEndQuery&>(*pCmd).pQuery);
+                break;
+
+            case GLCommandType::BeginDebugGroup:
+            {
+                const auto& Cmd = static_cast<const GLCmdBeginDebugGroup&>(*pCmd);
+                BeginDebugGroup(Cmd.Name, Cmd.HasColor ? Cmd.Color : nullptr);
+                break;
+            }
+
+            case GLCommandType::EndDebugGroup:
+                EndDebugGroup();
+                break;
+
+            case GLCommandType::InsertDebugLabel:
+            {
+                const auto& Cmd = static_cast<const GLCmdInsertDebugLabel&>(*pCmd);
+                InsertDebugLabel(Cmd.Label, Cmd.HasColor ? Cmd.Color : nullptr);
+                break;
+            }
+
+            default:
+                UNEXPECTED("Unexpected command type");
+        }
+    }
 }
 
 void DeviceContextGLImpl::EnqueueSignal(IFence* pFence, Uint64 Value)
@@ -1607,6 +2179,13 @@ void DeviceContextGLImpl::WaitForIdle()
 
 void DeviceContextGLImpl::BeginQuery(IQuery* pQuery)
 {
+    if (IsDeferred())
+    {
+        GLCommandStream& Stream                 = GetDeferredCommandStream();
+        Stream.Append<GLCmdBeginQuery>().pQuery = Stream.KeepAlive(pQuery);
+        return;
+    }
+
     TDeviceContextBase::BeginQuery(pQuery, 0);
 
     QueryGLImpl* pQueryGLImpl = ClassPtrCast<QueryGLImpl>(pQuery);
@@ -1654,6 +2233,13 @@ void DeviceContextGLImpl::BeginQuery(IQuery* pQuery)
 
 void DeviceContextGLImpl::EndQuery(IQuery* pQuery)
 {
+    if (IsDeferred())
+    {
+        GLCommandStream& Stream               = GetDeferredCommandStream();
+        Stream.Append<GLCmdEndQuery>().pQuery = Stream.KeepAlive(pQuery);
+        return;
+    }
+
     TDeviceContextBase::EndQuery(pQuery, 0);
 
     QueryGLImpl* pQueryGLImpl = ClassPtrCast<QueryGLImpl>(pQuery);
@@ -1709,6 +2295,10 @@ void DeviceContextGLImpl::EndQuery(IQuery* pQuery)
 
 bool DeviceContextGLImpl::UpdateCurrentGLContext()
 {
+    DEV_CHECK_ERR(!IsDeferred(), "UpdateCurrentGLContext() should only be called for immediate contexts.");
+    if (IsDeferred())
+        return false;
+
     GLContext::NativeGLContextType NativeGLContext = m_pDevice->m_GLContext.GetCurrentNativeGLContext();
     if (NativeGLContext == NULL)
         return false;
@@ -1719,6 +2309,10 @@ bool DeviceContextGLImpl::UpdateCurrentGLContext()
 
 void DeviceContextGLImpl::PurgeCurrentGLContextCaches()
 {
+    DEV_CHECK_ERR(!IsDeferred(), "PurgeCurrentGLContextCaches() should only be called for immediate contexts.");
+    if (IsDeferred())
+        return;
+
     GLContext::NativeGLContextType NativeGLContext = m_pDevice->m_GLContext.GetCurrentNativeGLContext();
     if (NativeGLContext != NULL)
         m_pDevice->PurgeContextCaches(NativeGLContext);
@@ -1730,6 +2324,18 @@ void DeviceContextGLImpl::UpdateBuffer(IBuffer*                       pBuffer,
                                        const void*                    pData,
                                        RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
 {
+    if (IsDeferred())
+    {
+        GLCommandStream&   Stream = GetDeferredCommandStream();
+        GLCmdUpdateBuffer& Cmd    = Stream.Append<GLCmdUpdateBuffer>();
+        Cmd.pBuffer               = Stream.KeepAlive(pBuffer);
+        Cmd.Offset                = Offset;
+        Cmd.Size                  = Size;
+        Cmd.pData                 = Stream.CopyData(pData, StaticCast<size_t>(Size));
+        Cmd.StateTransitionMode   = StateTransitionMode;
+        return;
+    }
+
     TDeviceContextBase::UpdateBuffer(pBuffer, Offset, Size, pData, StateTransitionMode);
 
     BufferGLImpl* pBufferGL = ClassPtrCast<BufferGLImpl>(pBuffer);
@@ -1744,6 +2350,20 @@ void DeviceContextGLImpl::CopyBuffer(IBuffer*                       pSrcBuffer,
                                      Uint64                         Size,
                                      RESOURCE_STATE_TRANSITION_MODE DstBufferTransitionMode)
 {
+    if (IsDeferred())
+    {
+        GLCommandStream& Stream     = GetDeferredCommandStream();
+        GLCmdCopyBuffer& Cmd        = Stream.Append<GLCmdCopyBuffer>();
+        Cmd.pSrcBuffer              = Stream.KeepAlive(pSrcBuffer);
+        Cmd.SrcOffset               = SrcOffset;
+        Cmd.SrcBufferTransitionMode = SrcBufferTransitionMode;
+        Cmd.pDstBuffer              = Stream.KeepAlive(pDstBuffer);
+        Cmd.DstOffset               = DstOffset;
+        Cmd.Size                    = Size;
+        Cmd.DstBufferTransitionMode = DstBufferTransitionMode;
+        return;
+    }
+
     TDeviceContextBase::CopyBuffer(pSrcBuffer, SrcOffset, SrcBufferTransitionMode, pDstBuffer, DstOffset, Size, DstBufferTransitionMode);
 
     BufferGLImpl* pSrcBufferGL = ClassPtrCast<BufferGLImpl>(pSrcBuffer);
@@ -1753,6 +2373,26 @@ void DeviceContextGLImpl::CopyBuffer(IBuffer*                       pSrcBuffer,
 
 void DeviceContextGLImpl::MapBuffer(IBuffer* pBuffer, MAP_TYPE MapType, MAP_FLAGS MapFlags, PVoid& pMappedData)
 {
+    if (IsDeferred())
+    {
+        if (MapType != MAP_WRITE || (MapFlags & MAP_FLAG_DISCARD) == 0)
+        {
+            LOG_ERROR_MESSAGE("Deferred contexts in OpenGL backend only support mapping buffers with MAP_WRITE type and MAP_FLAG_DISCARD flag");
+            pMappedData = nullptr;
+            return;
+        }
+
+        // The application writes the new buffer contents directly to the command stream.
+        // The data is uploaded to the buffer when the command list is executed.
+        GLCommandStream&  Stream = GetDeferredCommandStream();
+        GLCmdWriteBuffer& Cmd    = Stream.Append<GLCmdWriteBuffer>();
+        Cmd.pBuffer              = Stream.KeepAlive(pBuffer);
+        Cmd.Size                 = pBuffer->GetDesc().Size;
+        Cmd.pData                = Stream.AllocateData(StaticCast<size_t>(Cmd.Size));
+        pMappedData              = Cmd.pData;
+        return;
+    }
+
     TDeviceContextBase::MapBuffer(pBuffer, MapType, MapFlags, pMappedData);
     BufferGLImpl* pBufferGL = ClassPtrCast<BufferGLImpl>(pBuffer);
     pBufferGL->Map(m_ContextState, MapType, MapFlags, pMappedData);
@@ -1760,6 +2400,13 @@ void DeviceContextGLImpl::MapBuffer(IBuffer* pBuffer, MAP_TYPE MapType, MAP_FLAG
 
 void DeviceContextGLImpl::UnmapBuffer(IBuffer* pBuffer, MAP_TYPE MapType)
 {
+    if (IsDeferred())
+    {
+        // The data has been written to the command stream by MapBuffer()
+        DEV_CHECK_ERR(MapType == MAP_WRITE, "Deferred contexts in OpenGL backend only support mapping buffers for writing");
+        return;
+    }
+
     TDeviceContextBase::UnmapBuffer(pBuffer, MapType);
     BufferGLImpl* pBufferGL = ClassPtrCast<BufferGLImpl>(pBuffer);
     pBufferGL->Unmap(m_ContextState);
@@ -1773,6 +2420,24 @@ void DeviceContextGLImpl::UpdateTexture(ITexture*                      pTexture,
                                         RESOURCE_STATE_TRANSITION_MODE SrcBufferStateTransitionMode,
                                         RESOURCE_STATE_TRANSITION_MODE TextureStateTransitionMode)
 {
+    if (IsDeferred())
+    {
+        GLCommandStream&    Stream       = GetDeferredCommandStream();
+        GLCmdUpdateTexture& Cmd          = Stream.Append<GLCmdUpdateTexture>();
+        Cmd.pTexture                     = Stream.KeepAlive(pTexture);
+        Cmd.MipLevel                     = MipLevel;
+        Cmd.Slice                        = Slice;
+        Cmd.DstBox                       = DstBox;
+        Cmd.SubresData                   = SubresData;
+        Cmd.SrcBufferStateTransitionMode = SrcBufferStateTransitionMode;
+        Cmd.TextureStateTransitionMode   = TextureStateTransitionMode;
+        if (SubresData.pSrcBuffer != nullptr)
+            Stream.KeepAlive(SubresData.pSrcBuffer);
+        else
+            Cmd.SubresData.pData = Stream.CopyData(SubresData.pData, GetTextureUpdateDataSize(pTexture->GetDesc(), DstBox, SubresData));
+        return;
+    }
+
     TDeviceContextBase::UpdateTexture(pTexture, MipLevel, Slice, DstBox, SubresData, SrcBufferStateTransitionMode, TextureStateTransitionMode);
     TextureBaseGL* pTexGL = ClassPtrCast<TextureBaseGL>(pTexture);
     pTexGL->UpdateData(m_ContextState, MipLevel, Slice, DstBox, SubresData);
@@ -1780,6 +2445,17 @@ void DeviceContextGLImpl::UpdateTexture(ITexture*                      pTexture,
 
 void DeviceContextGLImpl::CopyTexture(const CopyTextureAttribs& CopyAttribs)
 {
+    if (IsDeferred())
+    {
+        GLCommandStream&  Stream = GetDeferredCommandStream();
+        GLCmdCopyTexture& Cmd    = Stream.Append<GLCmdCopyTexture>();
+        Cmd.Attribs              = CopyAttribs;
+        Cmd.Attribs.pSrcTexture  = Stream.KeepAlive(CopyAttribs.pSrcTexture);
+        Cmd.Attribs.pDstTexture  = Stream.KeepAlive(CopyAttribs.pDstTexture);
+        Cmd.Attribs.pSrcBox      = Stream.CopyArray(CopyAttribs.pSrcBox, 1);
+        return;
+    }
+
     TDeviceContextBase::CopyTexture(CopyAttribs);
     TextureBaseGL* pSrcTexGL = ClassPtrCast<TextureBaseGL>(CopyAttribs.pSrcTexture);
     TextureBaseGL* pDstTexGL = ClassPtrCast<TextureBaseGL>(CopyAttribs.pDstTexture);
@@ -1900,6 +2576,13 @@ void DeviceContextGLImpl::MapTextureSubresource(ITexture*                 pTextu
                                                 const Box*                pMapRegion,
                                                 MappedTextureSubresource& MappedData)
 {
+    if (IsDeferred())
+    {
+        LOG_ERROR_MESSAGE("Mapping textures is not supported in deferred contexts in OpenGL backend");
+        MappedData = MappedTextureSubresource{};
+        return;
+    }
+
     TDeviceContextBase::MapTextureSubresource(pTexture, MipLevel, ArraySlice, MapType, MapFlags, pMapRegion, MappedData);
     TextureBaseGL*     pTexGL  = ClassPtrCast<TextureBaseGL>(pTexture);
     const TextureDesc& TexDesc = pTexGL->GetDesc();
@@ -1923,6 +2606,12 @@ void DeviceContextGLImpl::MapTextureSubresource(ITexture*                 pTextu
 
 void DeviceContextGLImpl::UnmapTextureSubresource(ITexture* pTexture, Uint32 MipLevel, Uint32 ArraySlice)
 {
+    if (IsDeferred())
+    {
+        LOG_ERROR_MESSAGE("Mapping textures is not supported in deferred contexts in OpenGL backend");
+        return;
+    }
+
     TDeviceContextBase::UnmapTextureSubresource(pTexture, MipLevel, ArraySlice);
     TextureBaseGL*     pTexGL  = ClassPtrCast<TextureBaseGL>(pTexture);
     const TextureDesc& TexDesc = pTexGL->GetDesc();
@@ -1939,6 +2628,13 @@ void DeviceContextGLImpl::UnmapTextureSubresource(ITexture* pTexture, Uint32 Mip
 
 void DeviceContextGLImpl::GenerateMips(ITextureView* pTexView)
 {
+    if (IsDeferred())
+    {
+        GLCommandStream& Stream                     = GetDeferredCommandStream();
+        Stream.Append<GLCmdGenerateMips>().pTexView = Stream.KeepAlive(pTexView);
+        return;
+    }
+
     TDeviceContextBase::GenerateMips(pTexView);
     TextureViewGLImpl* pTexViewGL = ClassPtrCast<TextureViewGLImpl>(pTexView);
     GLenum             BindTarget = pTexViewGL->GetBindTarget();
@@ -1957,6 +2653,16 @@ void DeviceContextGLImpl::ResolveTextureSubresource(ITexture*
                                                     ITexture*                               pDstTexture,
                                                     const ResolveTextureSubresourceAttribs& ResolveAttribs)
 {
+    if (IsDeferred())
+    {
+        GLCommandStream&                Stream = GetDeferredCommandStream();
+        GLCmdResolveTextureSubresource& Cmd    = Stream.Append<GLCmdResolveTextureSubresource>();
+        Cmd.pSrcTexture                        = Stream.KeepAlive(pSrcTexture);
+        Cmd.pDstTexture                        = Stream.KeepAlive(pDstTexture);
+        Cmd.Attribs                            = ResolveAttribs;
+        return;
+    }
+
     TDeviceContextBase::ResolveTextureSubresource(pSrcTexture, pDstTexture, ResolveAttribs);
     TextureBaseGL*     pSrcTexGl  = ClassPtrCast<TextureBaseGL>(pSrcTexture);
     TextureBaseGL*     pDstTexGl  = ClassPtrCast<TextureBaseGL>(pDstTexture);
@@ -2089,6 +2795,19 @@ void DeviceContextGLImpl::BindSparseResourceMemory(const BindSparseResourceMemor
 
 void DeviceContextGLImpl::BeginDebugGroup(const Char* Name, const float* pColor)
 {
+    if (IsDeferred())
+    {
+        GLCommandStream&      Stream = GetDeferredCommandStream();
+        GLCmdBeginDebugGroup& Cmd    = Stream.Append<GLCmdBeginDebugGroup>();
+        Cmd.Name                     = Stream.CopyString(Name);
+        if (pColor != nullptr)
+        {
+            memcpy(Cmd.Color, pColor, sizeof(Cmd.Color));
+            Cmd.HasColor = true;
+        }
+        return;
+    }
+
     TDeviceContextBase::BeginDebugGroup(Name, pColor, 0);
 
 #if GL_KHR_debug
@@ -2099,6 +2818,12 @@ void DeviceContextGLImpl::BeginDebugGroup(const Char* Name, const float* pColor)
 
 void DeviceContextGLImpl::EndDebugGroup()
 {
+    if (IsDeferred())
+    {
+        GetDeferredCommandStream().Append<GLCmdEndDebugGroup>();
+        return;
+    }
+
     TDeviceContextBase::EndDebugGroup(0);
 
 #if GL_KHR_debug
@@ -2109,6 +2834,19 @@ void DeviceContextGLImpl::EndDebugGroup()
 
 void DeviceContextGLImpl::InsertDebugLabel(const Char* Label, const float* pColor)
 {
+    if (IsDeferred())
+    {
+        GLCommandStream&       Stream = GetDeferredCommandStream();
+        GLCmdInsertDebugLabel& Cmd    = Stream.Append<GLCmdInsertDebugLabel>();
+        Cmd.Label                     = Stream.CopyString(Label);
+        if (pColor != nullptr)
+        {
+            memcpy(Cmd.Color, pColor, sizeof(Cmd.Color));
+            Cmd.HasColor = true;
+        }
+        return;
+    }
+
     TDeviceContextBase::InsertDebugLabel(Label, pColor, 0);
 
 #if GL_KHR_debug
@@ -91,7 +91,7 @@ public:
 
     virtual void DILIGENT_CALL_TYPE CreateDeviceAndSwapChainGL(const EngineGLCreateInfo& EngineCI,
                                                                IRenderDevice**           ppDevice,
-                                                               IDeviceContext**          ppImmediateContext,
+                                                               IDeviceContext**          ppContexts,
                                                                const SwapChainDesc&      SCDesc,
                                                                ISwapChain**              ppSwapChain) override final;
 
@@ -99,7 +99,7 @@ public:
 
     virtual void DILIGENT_CALL_TYPE AttachToActiveGLContext(const EngineGLCreateInfo& EngineCI,
                                                             IRenderDevice**           ppDevice,
-                                                            IDeviceContext**          ppImmediateContext) override final;
+                                                            IDeviceContext**          ppContexts) override final;
 
     virtual void DILIGENT_CALL_TYPE EnumerateAdapters(Version              MinVersion,
                                                       Uint32&              NumAdapters,
@@ -192,14 +192,16 @@ void EngineFactoryOpenGLImpl::EnumerateAdapters(Version              MinVersion,
 /// \param [in]  EngineCI           - Engine creation attributes.
 /// \param [out] ppDevice           - Address of the memory location where pointer to
 ///                                   the created device will be written.
-/// \param [out] ppImmediateContext - Address of the memory location where pointers to
-///                                   the immediate context will be written.
+/// \param [out] ppContexts         - Address of the memory location where pointers to
+///                                   the contexts will be written. Immediate context goes at
+///                                   position 0. If EngineCI.NumDeferredContexts > 0,
+///                                   pointers to the deferred contexts are written afterwards.
 /// \param [in]  SCDesc             - Swap chain description.
 /// \param [out] ppSwapChain        - Address of the memory location where pointer to the new
 ///                                   swap chain will be written.
 void EngineFactoryOpenGLImpl::CreateDeviceAndSwapChainGL(const EngineGLCreateInfo& EngineCI,
                                                          IRenderDevice**           ppDevice,
-                                                         IDeviceContext**          ppImmediateContext,
+                                                         IDeviceContext**          ppContexts,
                                                          const SwapChainDesc&      SCDesc,
                                                          ISwapChain**              ppSwapChain)
 {
@@ -209,25 +211,19 @@ void EngineFactoryOpenGLImpl::CreateDeviceAndSwapChainGL(const EngineGLCreateInf
         return;
     }
 
-    VERIFY(ppDevice && ppImmediateContext && ppSwapChain, "Null pointer provided");
-    if (!ppDevice || !ppImmediateContext || !ppSwapChain)
+    VERIFY(ppDevice && ppContexts && ppSwapChain, "Null pointer provided");
+    if (!ppDevice || !ppContexts || !ppSwapChain)
         return;
 
-    if (EngineCI.NumDeferredContexts > 0)
-    {
-        LOG_ERROR_MESSAGE("OpenGL back-end does not support deferred contexts");
-        return;
-    }
-
     if (EngineCI.NumImmediateContexts > 1)
     {
         LOG_ERROR_MESSAGE("OpenGL back-end does not support multiple immediate contexts");
         return;
     }
 
-    *ppDevice           = nullptr;
-    *ppImmediateContext = nullptr;
-    *ppSwapChain        = nullptr;
+    *ppDevice    = nullptr;
+    *ppSwapChain = nullptr;
+    memset(ppContexts, 0, sizeof(*ppContexts) * (size_t{1} + size_t{EngineCI.NumDeferredContexts}));
 
     try
     {
@@ -258,9 +254,14 @@ void EngineFactoryOpenGLImpl::CreateDeviceAndSwapChainGL(const EngineGLCreateInf
         };
         // We must call AddRef() (implicitly through QueryInterface()) because pRenderDeviceOpenGL will
         // keep a weak reference to the context
-        pDeviceContextOpenGL->QueryInterface(IID_DeviceContext, reinterpret_cast<IObject**>(ppImmediateContext));
+        pDeviceContextOpenGL->QueryInterface(IID_DeviceContext, reinterpret_cast<IObject**>(ppContexts));
         pRenderDeviceOpenGL->SetImmediateContext(0, pDeviceContextOpenGL);
 
+        for (Uint32 DeferredCtx = 0; DeferredCtx < EngineCI.NumDeferredContexts; ++DeferredCtx)
+        {
+            pRenderDeviceOpenGL->CreateDeferredContext(ppContexts + 1 + DeferredCtx);
+        }
+
         TSwapChain* pSwapChainGL = NEW_RC_OBJ(RawMemAllocator, "SwapChainGLImpl instance", TSwapChain)(EngineCI, SCDesc, pRenderDeviceOpenGL, pDeviceContextOpenGL);
         pSwapChainGL->QueryInterface(IID_SwapChain, reinterpret_cast<IObject**>(ppSwapChain));
 
@@ -274,10 +275,13 @@ void EngineFactoryOpenGLImpl::CreateDeviceAndSwapChainGL(const EngineGLCreateInf
             *ppDevice = nullptr;
         }
 
-        if (*ppImmediateContext)
+        for (Uint32 ctx = 0; ctx < 1 + EngineCI.NumDeferredContexts; ++ctx)
         {
-            (*ppImmediateContext)->Release();
-            *ppImmediateContext = nullptr;
+            if (ppContexts[ctx] != nullptr)
+            {
+                ppContexts[ctx]->Release();
+                ppContexts[ctx] = nullptr;
+            }
         }
 
         if (*ppSwapChain)
@@ -296,11 +300,13 @@ void EngineFactoryOpenGLImpl::CreateDeviceAndSwapChainGL(const EngineGLCreateInf
 /// \param [in] EngineCI - Engine creation attributes.
 /// \param [out] ppDevice - Address of the memory location where pointer to
 ///                         the created device will be written.
-/// \param [out] ppImmediateContext - Address of the memory location where pointers to
-///                                   the immediate context will be written.
+/// \param [out] ppContexts - Address of the memory location where pointers to
+///                           the contexts will be written. Immediate context goes at
+///                           position 0. If EngineCI.NumDeferredContexts > 0,
+///                           pointers to the deferred contexts are written afterwards.
 void EngineFactoryOpenGLImpl::AttachToActiveGLContext(const EngineGLCreateInfo& EngineCI,
                                                       IRenderDevice**           ppDevice,
-                                                      IDeviceContext**          ppImmediateContext)
+                                                      IDeviceContext**          ppContexts)
 {
     if (EngineCI.EngineAPIVersion != DILIGENT_API_VERSION)
     {
@@ -308,24 +314,18 @@ void EngineFactoryOpenGLImpl::AttachToActiveGLContext(const EngineGLCreateInfo&
         return;
     }
 
-    VERIFY(ppDevice && ppImmediateContext, "Null pointer provided");
-    if (!ppDevice || !ppImmediateContext)
+    VERIFY(ppDevice && ppContexts, "Null pointer provided");
+    if (!ppDevice || !ppContexts)
         return;
 
-    if (EngineCI.NumDeferredContexts > 0)
-    {
-        LOG_ERROR_MESSAGE("OpenGL back-end does not support deferred contexts");
-        return;
-    }
-
     if (EngineCI.NumImmediateContexts > 1)
     {
         LOG_ERROR_MESSAGE("OpenGL back-end does not support multiple immediate contexts");
         return;
     }
 
-    *ppDevice           = nullptr;
-    *ppImmediateContext = nullptr;
+    *ppDevice = nullptr;
+    memset(ppContexts, 0, sizeof(*ppContexts) * (size_t{1} + size_t{EngineCI.NumDeferredContexts}));
 
     try
     {
@@ -356,8 +356,13 @@ void EngineFactoryOpenGLImpl::AttachToActiveGLContext(const EngineGLCreateInfo&
         };
         // We must call AddRef() (implicitly through QueryInterface()) because pRenderDeviceOpenGL will
         // keep a weak reference to the context
-        pDeviceContextOpenGL->QueryInterface(IID_DeviceContext, reinterpret_cast<IObject**>(ppImmediateContext));
+        pDeviceContextOpenGL->QueryInterface(IID_DeviceContext, reinterpret_cast<IObject**>(ppContexts));
         pRenderDeviceOpenGL->SetImmediateContext(0, pDeviceContextOpenGL);
+
+        for (Uint32 DeferredCtx = 0; DeferredCtx < EngineCI.NumDeferredContexts; ++DeferredCtx)
+        {
+            pRenderDeviceOpenGL->CreateDeferredContext(ppContexts + 1 + DeferredCtx);
+        }
     }
     catch (const std::runtime_error&)
     {
@@ -367,10 +372,13 @@ void EngineFactoryOpenGLImpl::AttachToActiveGLContext(const EngineGLCreateInfo&
             *ppDevice = nullptr;
         }
 
-        if (*ppImmediateContext)
+        for (Uint32 ctx = 0; ctx < 1 + EngineCI.NumDeferredContexts; ++ctx)
         {
-            (*ppImmediateContext)->Release();
-            *ppImmediateContext = nullptr;
+            if (ppContexts[ctx] != nullptr)
+            {
+                ppContexts[ctx]->Release();
+                ppContexts[ctx] = nullptr;
+            }
         }
 
         LOG_ERROR("Failed to initialize OpenGL-based render device");
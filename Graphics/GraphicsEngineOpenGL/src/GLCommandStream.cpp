@@ -0,0 +1,66 @@
+/*
+ *  Copyright 2019-2025 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include "GLCommandStream.hpp"
+
+namespace Diligent
+{
+
+// Most command lists are small, so the arena grows in moderately sized pages.
+static constexpr size_t CommandStreamPageSize = 16 << 10;
+
+// Data copied into the stream (buffer and texture contents, constant arrays) uses
+// the same alignment as the memory returned by the raw allocator.
+static constexpr size_t CommandStreamDataAlignment = 16;
+
+GLCommandStream::GLCommandStream(IMemoryAllocator& Allocator) :
+    m_Arena{Allocator, CommandStreamPageSize}
+{
+    m_Objects.reserve(64);
+}
+
+GLCommandStream::~GLCommandStream()
+{
+}
+
+void* GLCommandStream::AllocateData(size_t Size)
+{
+    return m_Arena.Allocate(Size, CommandStreamDataAlignment);
+}
+
+void* GLCommandStream::CopyData(const void* pData, size_t Size)
+{
+    if (pData == nullptr || Size == 0)
+        return nullptr;
+
+    void* pDst = AllocateData(Size);
+    memcpy(pDst, pData, Size);
+    return pDst;
+}
+
+} // namespace Diligent
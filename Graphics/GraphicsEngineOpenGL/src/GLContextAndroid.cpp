@@ -245,6 +245,101 @@ GLContext::NativeGLContextType GLContext::GetCurrentNativeGLContext()
     return eglGetCurrentContext();
 }
 
+Uint32 GLContext::CreateWorkerContexts(Uint32 NumContexts)
+{
+    VERIFY(worker_contexts_.empty(), "Worker contexts have already been created");
+
+    EGLContext main_context = eglGetCurrentContext();
+    EGLDisplay display      = eglGetCurrentDisplay();
+    if (main_context == EGL_NO_CONTEXT || display == EGL_NO_DISPLAY)
+    {
+        LOG_ERROR_MESSAGE("Failed to create worker contexts: no current EGL context found");
+        return 0;
+    }
+
+    // Worker contexts must use the same config as the main context to share objects with it.
+    EGLint config_id = 0;
+    if (eglQueryContext(display, main_context, EGL_CONFIG_ID, &config_id) == EGL_FALSE)
+    {
+        LOG_WARNING_MESSAGE("Failed to query the config of the main EGL context");
+        return 0;
+    }
+
+    const EGLint config_attribs[] = {EGL_CONFIG_ID, config_id, EGL_NONE};
+    EGLConfig    config           = nullptr;
+    EGLint       num_configs      = 0;
+    if (eglChooseConfig(display, config_attribs, &config, 1, &num_configs) == EGL_FALSE || num_configs == 0)
+    {
+        LOG_WARNING_MESSAGE("Failed to find the config of the main EGL context");
+        return 0;
+    }
+
+    // Without EGL_KHR_surfaceless_context, every worker context needs a surface to be made current.
+    const char* extensions          = eglQueryString(display, EGL_EXTENSIONS);
+    const bool  surfaceless_context = extensions != nullptr && strstr(extensions, "EGL_KHR_surfaceless_context") != nullptr;
+
+    const EGLint context_attribs[] =
+        {
+            EGL_CONTEXT_MAJOR_VERSION, major_version_,
+            EGL_CONTEXT_MINOR_VERSION, minor_version_,
+            EGL_NONE //
+        };
+    const EGLint pbuffer_attribs[] = {EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE};
+
+    for (Uint32 i = 0; i < NumContexts; ++i)
+    {
+        WorkerContext worker;
+        worker.context = eglCreateContext(display, config, main_context, context_attribs);
+        if (worker.context == EGL_NO_CONTEXT)
+        {
+            LOG_WARNING_MESSAGE("Failed to create worker EGL context ", i);
+            break;
+        }
+
+        if (!surfaceless_context)
+        {
+            worker.surface = eglCreatePbufferSurface(display, config, pbuffer_attribs);
+            if (worker.surface == EGL_NO_SURFACE)
+            {
+                LOG_WARNING_MESSAGE("Failed to create pbuffer surface for worker EGL context ", i);
+                eglDestroyContext(display, worker.context);
+                break;
+            }
+        }
+
+        worker_contexts_.push_back(worker);
+    }
+    worker_display_ = display;
+
+    return static_cast<Uint32>(worker_contexts_.size());
+}
+
+bool GLContext::MakeWorkerContextCurrent(Uint32 Index)
+{
+    VERIFY_EXPR(Index < worker_contexts_.size());
+    const WorkerContext& worker = worker_contexts_[Index];
+    return eglMakeCurrent(worker_display_, worker.surface, worker.surface, worker.context) != EGL_FALSE;
+}
+
+void GLContext::ReleaseWorkerContext()
+{
+    eglMakeCurrent(worker_display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    // Release the thread state allocated by EGL for the worker thread.
+    eglReleaseThread();
+}
+
+void GLContext::DestroyWorkerContexts()
+{
+    for (const WorkerContext& worker : worker_contexts_)
+    {
+        if (worker.surface != EGL_NO_SURFACE)
+            eglDestroySurface(worker_display_, worker.surface);
+        eglDestroyContext(worker_display_, worker.context);
+    }
+    worker_contexts_.clear();
+    worker_display_ = EGL_NO_DISPLAY;
+}
+
 void GLContext::InitGLES()
 {
     if (gles_initialized_)
@@ -325,6 +420,7 @@ GLContext::GLContext(const EngineGLCreateInfo& InitAttribs,
 
 GLContext::~GLContext()
 {
+    DestroyWorkerContexts();
     Terminate();
 }
 
@@ -34,12 +34,29 @@
 namespace Diligent
 {
 
+namespace
+{
+
+// X11 macros None, Success, True and False are undefined by pch.h
+constexpr int X11None    = 0;
+constexpr int X11Success = 0;
+constexpr int X11True    = 1;
+constexpr int X11False   = 0;
+
+int IgnoreXErrors(Display*, XErrorEvent*)
+{
+    return 0;
+}
+
+} // namespace
+
 GLContext::GLContext(const EngineGLCreateInfo& InitAttribs,
                      RENDER_DEVICE_TYPE&       DevType,
                      struct Version&           APIVersion,
                      const struct SwapChainDesc* /*pSCDesc*/) :
     m_WindowId(InitAttribs.Window.WindowId),
-    m_pDisplay(InitAttribs.Window.pDisplay)
+    m_pDisplay(InitAttribs.Window.pDisplay),
+    m_XInitThreadsCalled(InitAttribs.XInitThreadsCalled)
 {
     auto CurrentCtx = glXGetCurrentContext();
     if (CurrentCtx == 0)
@@ -68,6 +85,7 @@ GLContext::GLContext(const EngineGLCreateInfo& InitAttribs,
 
 GLContext::~GLContext()
 {
+    DestroyWorkerContexts();
 }
 
 void GLContext::SwapBuffers(int SwapInterval)
@@ -101,4 +119,109 @@ GLContext::NativeGLContextType GLContext::GetCurrentNativeGLContext()
     return glXGetCurrentContext();
 }
 
+Uint32 GLContext::CreateWorkerContexts(Uint32 NumContexts)
+{
+    VERIFY(m_WorkerContexts.empty(), "Worker contexts have already been created");
+
+    GLXContext MainContext = glXGetCurrentContext();
+    Display*   pDisplay    = glXGetCurrentDisplay();
+    if (MainContext == nullptr || pDisplay == nullptr)
+    {
+        LOG_ERROR_MESSAGE("Failed to create worker contexts: no current GL context found");
+        return 0;
+    }
+
+    // Worker threads make their contexts current using the application's display connection,
+    // which is only safe when Xlib has been initialized for multithreading.
+    if (!m_XInitThreadsCalled)
+    {
+        LOG_WARNING_MESSAGE("GL worker contexts will not be created and asynchronous shader compilation will be disabled. "
+                            "To enable it, call XInitThreads before any other Xlib call and set EngineGLCreateInfo::XInitThreadsCalled to true.");
+        return 0;
+    }
+
+    if (!GLXEW_ARB_create_context || glXCreateContextAttribsARB == nullptr)
+    {
+        LOG_INFO_MESSAGE("GLX_ARB_create_context is not supported: worker contexts can't be created");
+        return 0;
+    }
+
+    // Worker contexts must use the same frame buffer configuration as the main context to share objects with it.
+    int FBConfigId = 0, Screen = 0;
+    if (glXQueryContext(pDisplay, MainContext, GLX_FBCONFIG_ID, &FBConfigId) != X11Success ||
+        glXQueryContext(pDisplay, MainContext, GLX_SCREEN, &Screen) != X11Success)
+    {
+        LOG_WARNING_MESSAGE("Failed to query the frame buffer configuration of the main GL context");
+        return 0;
+    }
+
+    const int    ConfigAttribs[] = {GLX_FBCONFIG_ID, FBConfigId, X11None};
+    int          NumConfigs      = 0;
+    GLXFBConfig* pConfigs        = glXChooseFBConfig(pDisplay, Screen, ConfigAttribs, &NumConfigs);
+    if (pConfigs == nullptr || NumConfigs == 0)
+    {
+        LOG_WARNING_MESSAGE("Failed to find the frame buffer configuration of the main GL context");
+        if (pConfigs != nullptr)
+            XFree(pConfigs);
+        return 0;
+    }
+
+    int MajorVersion = 0, MinorVersion = 0, ProfileMask = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &MajorVersion);
+    glGetIntegerv(GL_MINOR_VERSION, &MinorVersion);
+    glGetIntegerv(GL_CONTEXT_PROFILE_MASK, &ProfileMask);
+    if (glGetError() != GL_NO_ERROR)
+        ProfileMask = 0;
+
+    const int ContextAttribs[] =
+        {
+            GLX_CONTEXT_MAJOR_VERSION_ARB, MajorVersion,
+            GLX_CONTEXT_MINOR_VERSION_ARB, MinorVersion,
+            GLX_CONTEXT_PROFILE_MASK_ARB, (ProfileMask & GL_CONTEXT_CORE_PROFILE_BIT) != 0 ? GLX_CONTEXT_CORE_PROFILE_BIT_ARB : GLX_CONTEXT_COMPATIBILITY_PROFILE_BIT_ARB,
+            X11None //
+        };
+
+    // Failed context creation generates an X error that terminates the application
+    // with the default error handler.
+    XSync(pDisplay, X11False);
+    int (*OldErrorHandler)(Display*, XErrorEvent*) = XSetErrorHandler(IgnoreXErrors);
+    for (Uint32 i = 0; i < NumContexts; ++i)
+    {
+        GLXContext WorkerContext = glXCreateContextAttribsARB(pDisplay, pConfigs[0], MainContext, X11True, ContextAttribs);
+        XSync(pDisplay, X11False);
+        if (WorkerContext == nullptr)
+        {
+            LOG_WARNING_MESSAGE("Failed to create worker GL context ", i);
+            break;
+        }
+        m_WorkerContexts.push_back(WorkerContext);
+    }
+    XSetErrorHandler(OldErrorHandler);
+    XFree(pConfigs);
+
+    m_pWorkerDisplay = pDisplay;
+
+    return static_cast<Uint32>(m_WorkerContexts.size());
+}
+
+bool GLContext::MakeWorkerContextCurrent(Uint32 Index)
+{
+    VERIFY_EXPR(Index < m_WorkerContexts.size());
+    // GL 3.0+ contexts created with GLX_ARB_create_context can be made current without a drawable.
+    return glXMakeContextCurrent(m_pWorkerDisplay, X11None, X11None, m_WorkerContexts[Index]) != X11False;
+}
+
+void GLContext::ReleaseWorkerContext()
+{
+    glXMakeContextCurrent(m_pWorkerDisplay, X11None, X11None, nullptr);
+}
+
+void GLContext::DestroyWorkerContexts()
+{
+    for (GLXContext WorkerContext : m_WorkerContexts)
+        glXDestroyContext(m_pWorkerDisplay, WorkerContext);
+    m_WorkerContexts.clear();
+    m_pWorkerDisplay = nullptr;
+}
+
 } // namespace Diligent
@@ -42,7 +42,7 @@ using namespace GLObjectWrappers;
 namespace Diligent
 {
 
-GLContextState::GLContextState(RenderDeviceGLImpl* pDeviceGL)
+GLContextState::GLContextState(RenderDeviceGLImpl* pDeviceGL, bool IsDeferredContext)
 {
     const GraphicsAdapterInfo& AdapterInfo = pDeviceGL->GetAdapterInfo();
     m_Caps.IsFillModeSelectionSupported    = AdapterInfo.Features.WireframeFill;
@@ -50,6 +50,12 @@ GLContextState::GLContextState(RenderDeviceGLImpl* pDeviceGL)
     m_Caps.IsDepthClampSupported           = AdapterInfo.Features.DepthClamp;
     m_Caps.IsFramebufferSRGBSupported      = pDeviceGL->GetGLCaps().FramebufferSRGB;
 
+    if (IsDeferredContext)
+    {
+        // Deferred contexts may be created and used in any thread that has no GL context
+        return;
+    }
+
     {
         m_Caps.MaxCombinedTexUnits = 0;
         glGetIntegerv(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, &m_Caps.MaxCombinedTexUnits);
@@ -232,6 +232,8 @@ GLContext::GLContext(const EngineGLCreateInfo& InitAttribs,
 
 GLContext::~GLContext()
 {
+    DestroyWorkerContexts();
+
     // Do not destroy context if it was created by the app.
     if (m_Context)
     {
@@ -264,4 +266,74 @@ GLContext::NativeGLContextType GLContext::GetCurrentNativeGLContext()
     return wglGetCurrentContext();
 }
 
+Uint32 GLContext::CreateWorkerContexts(Uint32 NumContexts)
+{
+    VERIFY(m_WorkerContexts.empty(), "Worker contexts have already been created");
+
+    HGLRC MainContext = wglGetCurrentContext();
+    HDC   hDC         = wglGetCurrentDC();
+    if (MainContext == NULL || hDC == NULL)
+    {
+        LOG_ERROR_MESSAGE("Failed to create worker contexts: no current GL context found");
+        return 0;
+    }
+
+    if (wglewIsSupported("WGL_ARB_create_context") != 1)
+    {
+        LOG_INFO_MESSAGE("WGL_ARB_create_context is not supported: worker contexts can't be created");
+        return 0;
+    }
+
+    int MajorVersion = 0, MinorVersion = 0, ProfileMask = 0, ContextFlags = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &MajorVersion);
+    glGetIntegerv(GL_MINOR_VERSION, &MinorVersion);
+    glGetIntegerv(GL_CONTEXT_PROFILE_MASK, &ProfileMask);
+    glGetIntegerv(GL_CONTEXT_FLAGS, &ContextFlags);
+    if (glGetError() != GL_NO_ERROR)
+        ProfileMask = ContextFlags = 0;
+
+    // Worker contexts must be compatible with the main context to share objects with it.
+    int attribs[] =
+        {
+            WGL_CONTEXT_MAJOR_VERSION_ARB, MajorVersion,
+            WGL_CONTEXT_MINOR_VERSION_ARB, MinorVersion,
+            WGL_CONTEXT_FLAGS_ARB, (ContextFlags & GL_CONTEXT_FLAG_FORWARD_COMPATIBLE_BIT) != 0 ? WGL_CONTEXT_FORWARD_COMPATIBLE_BIT_ARB : 0,
+            GL_CONTEXT_PROFILE_MASK, (ProfileMask & GL_CONTEXT_CORE_PROFILE_BIT) != 0 ? GL_CONTEXT_CORE_PROFILE_BIT : GL_CONTEXT_COMPATIBILITY_PROFILE_BIT,
+            0, 0 //
+        };
+
+    for (Uint32 i = 0; i < NumContexts; ++i)
+    {
+        HGLRC WorkerContext = wglCreateContextAttribsARB(hDC, MainContext, attribs);
+        if (WorkerContext == NULL)
+        {
+            LOG_WARNING_MESSAGE("Failed to create worker GL context ", i);
+            break;
+        }
+        m_WorkerContexts.push_back(WorkerContext);
+    }
+    m_WorkerDC = hDC;
+
+    return static_cast<Uint32>(m_WorkerContexts.size());
+}
+
+bool GLContext::MakeWorkerContextCurrent(Uint32 Index)
+{
+    VERIFY_EXPR(Index < m_WorkerContexts.size());
+    return wglMakeCurrent(m_WorkerDC, m_WorkerContexts[Index]) != FALSE;
+}
+
+void GLContext::ReleaseWorkerContext()
+{
+    wglMakeCurrent(NULL, NULL);
+}
+
+void GLContext::DestroyWorkerContexts()
+{
+    for (HGLRC WorkerContext : m_WorkerContexts)
+        wglDeleteContext(WorkerContext);
+    m_WorkerContexts.clear();
+    m_WorkerDC = NULL;
+}
+
 } // namespace Diligent
@@ -35,11 +35,65 @@ namespace Diligent
 
 GLProgram::GLProgram(ShaderGLImpl* const* ppShaders,
                      Uint32               NumShaders,
-                     bool                 IsSeparableProgram) noexcept :
+                     bool                 IsSeparableProgram,
+                     const Binary*        pBinary,
+                     bool                 RetrievableBinary,
+                     IThreadPool*         pLinkThreadPool) noexcept :
     m_AttachedShaders{ppShaders, ppShaders + NumShaders}
 {
     VERIFY(!IsSeparableProgram || NumShaders == 1, "Number of shaders must be 1 when separable program is created");
 
+    if (pBinary != nullptr)
+    {
+        // GL_PROGRAM_SEPARABLE parameter must be set before loading the binary!
+        if (IsSeparableProgram)
+        {
+            glProgramParameteri(m_GLProg, GL_PROGRAM_SEPARABLE, GL_TRUE);
+            DEV_CHECK_GL_ERROR("glProgramParameteri(GL_PROGRAM_SEPARABLE) failed");
+        }
+
+        if (LoadBinary(*pBinary))
+        {
+            // The program is ready to use and the shaders are not needed.
+            m_AttachedShaders.clear();
+            m_IsLoadedFromBinary = true;
+            m_LinkStatus         = LinkStatus::Succeeded;
+            return;
+        }
+
+        // The binary may be rejected by the driver (e.g. after a driver update).
+        // In this case, the program is linked from the shaders as usual.
+        m_IsBinaryRejected = true;
+    }
+
+    if (pLinkThreadPool != nullptr)
+    {
+        m_LinkTask = AsyncInitializer::Start(
+            pLinkThreadPool,
+            [this, IsSeparableProgram, RetrievableBinary](Uint32 /*ThreadId*/) {
+                Link(IsSeparableProgram, RetrievableBinary);
+                // Wait until the program is linked and make the results visible to other contexts.
+                GLint IsLinked = GL_FALSE;
+                glGetProgramiv(m_GLProg, GL_LINK_STATUS, &IsLinked);
+                glFinish();
+            });
+    }
+    else
+    {
+        Link(IsSeparableProgram, RetrievableBinary);
+    }
+
+    m_LinkStatus = LinkStatus::InProgress;
+}
+
+GLProgram::~GLProgram()
+{
+    // The link task references the program object
+    AsyncInitializer::Update(m_LinkTask, /*WaitForCompletion = */ true);
+}
+
+void GLProgram::Link(bool IsSeparableProgram, bool RetrievableBinary) noexcept
+{
     // GL_PROGRAM_SEPARABLE parameter must be set before linking!
     if (IsSeparableProgram)
     {
@@ -47,10 +101,15 @@ GLProgram::GLProgram(ShaderGLImpl* const* ppShaders,
         DEV_CHECK_GL_ERROR("glProgramParameteri(GL_PROGRAM_SEPARABLE) failed");
     }
 
-    for (Uint32 i = 0; i < NumShaders; ++i)
+    if (RetrievableBinary)
     {
-        ShaderGLImpl* pCurrShader = ppShaders[i];
-        glAttachShader(m_GLProg, pCurrShader->GetGLShaderHandle());
+        glProgramParameteri(m_GLProg, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        DEV_CHECK_GL_ERROR("glProgramParameteri(GL_PROGRAM_BINARY_RETRIEVABLE_HINT) failed");
+    }
+
+    for (const ShaderGLImpl* pShader : m_AttachedShaders)
+    {
+        glAttachShader(m_GLProg, pShader->GetGLShaderHandle());
         DEV_CHECK_GL_ERROR("glAttachShader() failed");
     }
 
@@ -71,12 +130,46 @@ GLProgram::GLProgram(ShaderGLImpl* const* ppShaders,
     //       However, on NVidia GPUs this completely disables the GL_KHR_parallel_shader_compile
     //       extension, which barely works already. So we keep shaders attached until the program
     //       is linked.
+}
 
-    m_LinkStatus = LinkStatus::InProgress;
+bool GLProgram::LoadBinary(const Binary& Bin) noexcept
+{
+    VERIFY_EXPR(Bin.pData != nullptr && Bin.Size > 0);
+
+    glProgramBinary(m_GLProg, Bin.Format, Bin.pData, static_cast<GLsizei>(Bin.Size));
+    // GL_INVALID_ENUM is generated if the format is not supported by the driver.
+    if (glGetError() != GL_NO_ERROR)
+        return false;
+
+    // If the binary is not compatible with the driver, the link status is set to GL_FALSE.
+    GLint IsLinked = GL_FALSE;
+    glGetProgramiv(m_GLProg, GL_LINK_STATUS, &IsLinked);
+    DEV_CHECK_GL_ERROR("glGetProgramiv(GL_LINK_STATUS) failed");
+
+    return IsLinked != GL_FALSE;
 }
 
-GLProgram::~GLProgram()
+bool GLProgram::GetBinary(GLenum& Format, std::vector<Uint8>& Data) const
 {
+    DEV_CHECK_ERR(m_LinkStatus == LinkStatus::Succeeded, "Program must be successfully linked to get its binary");
+
+    GLint BinaryLength = 0;
+    glGetProgramiv(m_GLProg, GL_PROGRAM_BINARY_LENGTH, &BinaryLength);
+    if (glGetError() != GL_NO_ERROR || BinaryLength <= 0)
+        return false;
+
+    Data.resize(static_cast<size_t>(BinaryLength));
+
+    GLsizei Length = 0;
+    glGetProgramBinary(m_GLProg, BinaryLength, &Length, &Format, Data.data());
+    if (glGetError() != GL_NO_ERROR || Length <= 0)
+    {
+        Data.clear();
+        return false;
+    }
+    Data.resize(static_cast<size_t>(Length));
+
+    return true;
 }
 
 GLProgram::LinkStatus GLProgram::GetLinkStatus(bool WaitForCompletion) noexcept
@@ -85,7 +178,16 @@ GLProgram::LinkStatus GLProgram::GetLinkStatus(bool WaitForCompletion) noexcept
     if (m_LinkStatus != LinkStatus::InProgress)
         return m_LinkStatus;
 
-    if (!WaitForCompletion)
+    if (m_LinkTask)
+    {
+        if (AsyncInitializer::Update(m_LinkTask, WaitForCompletion) != ASYNC_TASK_STATUS_COMPLETE)
+        {
+            VERIFY_EXPR(!WaitForCompletion);
+            return LinkStatus::InProgress;
+        }
+        m_LinkTask.reset();
+    }
+    else if (!WaitForCompletion)
     {
         GLint LinkingComplete = GL_FALSE;
         glGetProgramiv(m_GLProg, GL_COMPLETION_STATUS_KHR, &LinkingComplete);
@@ -132,6 +234,12 @@ GLProgram::LinkStatus GLProgram::GetLinkStatus(bool WaitForCompletion) noexcept
     std::vector<const ShaderGLImpl*> Null{};
     m_AttachedShaders.swap(Null);
 
+    if (m_LinkStatus == LinkStatus::Succeeded && m_LinkedCallback)
+    {
+        m_LinkedCallback(*this);
+        m_LinkedCallback = nullptr;
+    }
+
     return m_LinkStatus;
 }
 
@@ -31,10 +31,34 @@
 #include "RenderDeviceGLImpl.hpp"
 #include "PipelineResourceSignatureGLImpl.hpp"
 #include "HashUtils.hpp"
+#include "DataBlobImpl.hpp"
+#include "Serializer.hpp"
+
+#include "xxhash.h"
 
 namespace Diligent
 {
 
+namespace
+{
+
+constexpr Uint32 ProgramBinaryCacheMagic   = 0x42504C47; // GLPB
+constexpr Uint32 ProgramBinaryCacheVersion = 1;
+
+// The header is followed by the serialized driver id and program binaries.
+// The data size and hash are checked before the data is parsed, so that
+// truncated or corrupted files are rejected up front.
+struct ProgramBinaryCacheHeader
+{
+    Uint32 Magic    = ProgramBinaryCacheMagic;
+    Uint32 Version  = ProgramBinaryCacheVersion;
+    Uint64 DataSize = 0;
+    Uint64 DataHash = 0;
+};
+static_assert(sizeof(ProgramBinaryCacheHeader) == 24, "Unexpected header size");
+
+} // namespace
+
 GLProgramCache::GLProgramCache()
 {
 }
@@ -116,7 +140,7 @@ GLProgramCache::SharedGLProgramObjPtr GLProgramCache::GetProgram(const GetProgra
     // and the rest will be destroyed.
 
     // Linking the program may take a considerable amount of time.
-    std::shared_ptr<GLProgram> NewProgram = std::make_shared<GLProgram>(Attribs.ppShaders, Attribs.NumShaders, Attribs.IsSeparableProgram);
+    std::shared_ptr<GLProgram> NewProgram = CreateProgram(Attribs);
 
     std::lock_guard<std::mutex> Lock{m_CacheMtx};
 
@@ -133,4 +157,238 @@ GLProgramCache::SharedGLProgramObjPtr GLProgramCache::GetProgram(const GetProgra
     }
 }
 
+GLProgramCache::ProgramBinaryKey GLProgramCache::ComputeBinaryKey(const GetProgramAttribs& Attribs, const std::string& DriverId)
+{
+    XXH3_state_t* pState = XXH3_createState();
+    XXH3_128bits_reset(pState);
+
+    XXH3_128bits_update(pState, DriverId.c_str(), DriverId.length() + 1);
+
+    const Uint32 IsSeparableProgram = Attribs.IsSeparableProgram ? 1 : 0;
+    XXH3_128bits_update(pState, &IsSeparableProgram, sizeof(IsSeparableProgram));
+    XXH3_128bits_update(pState, &Attribs.NumShaders, sizeof(Attribs.NumShaders));
+    for (Uint32 i = 0; i < Attribs.NumShaders; ++i)
+    {
+        const ShaderGLImpl* pShader    = Attribs.ppShaders[i];
+        const Uint32        ShaderType = static_cast<Uint32>(pShader->GetDesc().ShaderType);
+        XXH3_128bits_update(pState, &ShaderType, sizeof(ShaderType));
+
+        const void* pSource    = nullptr;
+        Uint64      SourceSize = 0;
+        pShader->GetBytecode(&pSource, SourceSize);
+        XXH3_128bits_update(pState, &SourceSize, sizeof(SourceSize));
+        if (pSource != nullptr)
+            XXH3_128bits_update(pState, pSource, static_cast<size_t>(SourceSize));
+    }
+
+    const XXH128_hash_t Hash = XXH3_128bits_digest(pState);
+    XXH3_freeState(pState);
+
+    return {Hash.low64, Hash.high64};
+}
+
+GLProgramCache::SharedGLProgramObjPtr GLProgramCache::CreateProgram(const GetProgramAttribs& Attribs)
+{
+    bool        BinaryCacheEnabled = false;
+    std::string DriverId;
+    {
+        std::lock_guard<std::mutex> Lock{m_BinaryCacheMtx};
+        BinaryCacheEnabled = m_BinaryCacheEnabled;
+        if (BinaryCacheEnabled)
+            DriverId = m_DriverId;
+    }
+
+    if (!BinaryCacheEnabled)
+        return std::make_shared<GLProgram>(Attribs.ppShaders, Attribs.NumShaders, Attribs.IsSeparableProgram,
+                                           /*pBinary = */ nullptr, /*RetrievableBinary = */ false, Attribs.pLinkThreadPool);
+
+    const ProgramBinaryKey BinaryKey = ComputeBinaryKey(Attribs, DriverId);
+
+    ProgramBinaryDataPtr pBinaryData;
+    {
+        std::lock_guard<std::mutex> Lock{m_BinaryCacheMtx};
+
+        auto it = m_Binaries.find(BinaryKey);
+        if (it != m_Binaries.end())
+            pBinaryData = it->second;
+    }
+
+    GLProgram::Binary Binary;
+    if (pBinaryData)
+    {
+        Binary.Format = pBinaryData->Format;
+        Binary.pData  = pBinaryData->Data.data();
+        Binary.Size   = pBinaryData->Data.size();
+    }
+
+    SharedGLProgramObjPtr Program = std::make_shared<GLProgram>(Attribs.ppShaders, Attribs.NumShaders, Attribs.IsSeparableProgram,
+                                                                pBinaryData ? &Binary : nullptr, /*RetrievableBinary = */ true,
+                                                                Attribs.pLinkThreadPool);
+    if (Program->IsLoadedFromBinary())
+        return Program;
+
+    if (Program->IsBinaryRejected())
+    {
+        LOG_INFO_MESSAGE("Program binary was rejected by the driver. The program will be linked from shaders and the binary will be replaced.");
+
+        std::lock_guard<std::mutex> Lock{m_BinaryCacheMtx};
+
+        auto it = m_Binaries.find(BinaryKey);
+        if (it != m_Binaries.end() && it->second == pBinaryData)
+            m_Binaries.erase(it);
+    }
+
+    // Store the binary once the program is linked
+    Program->SetLinkedCallback([this, BinaryKey](const GLProgram& LinkedProgram) {
+        StoreBinary(BinaryKey, LinkedProgram);
+    });
+
+    return Program;
+}
+
+void GLProgramCache::StoreBinary(const ProgramBinaryKey& Key, const GLProgram& Program)
+{
+    std::shared_ptr<ProgramBinaryData> pBinaryData = std::make_shared<ProgramBinaryData>();
+    if (!Program.GetBinary(pBinaryData->Format, pBinaryData->Data))
+    {
+        LOG_WARNING_MESSAGE("Failed to retrieve the program binary");
+        return;
+    }
+
+    std::lock_guard<std::mutex> Lock{m_BinaryCacheMtx};
+    // The cache may have been disabled or reloaded while the program was linked.
+    if (m_BinaryCacheEnabled)
+        m_Binaries[Key] = std::move(pBinaryData);
+}
+
+bool GLProgramCache::EnableBinaryCache(std::string DriverId, const IDataBlob* pData)
+{
+    VERIFY_EXPR(!DriverId.empty());
+
+    std::unordered_map<ProgramBinaryKey, ProgramBinaryDataPtr, ProgramBinaryKey::Hasher> Binaries;
+
+    bool DataValid = true;
+    if (pData != nullptr && pData->GetSize() > 0)
+    {
+        const Uint8* const pBytes = static_cast<const Uint8*>(pData->GetConstDataPtr());
+
+        ProgramBinaryCacheHeader Header;
+        DataValid = pData->GetSize() >= sizeof(Header);
+        if (DataValid)
+        {
+            memcpy(&Header, pBytes, sizeof(Header));
+            DataValid = (Header.Magic == ProgramBinaryCacheMagic &&
+                         Header.Version == ProgramBinaryCacheVersion &&
+                         Header.DataSize == pData->GetSize() - sizeof(Header) &&
+                         Header.DataHash == XXH3_64bits(pBytes + sizeof(Header), static_cast<size_t>(Header.DataSize)));
+        }
+
+        if (DataValid)
+        {
+            SerializedData                   Data{const_cast<Uint8*>(pBytes + sizeof(Header)), static_cast<size_t>(Header.DataSize)};
+            Serializer<SerializerMode::Read> Ser{Data};
+
+            const char* DataDriverId = nullptr;
+            Uint32      NumBinaries  = 0;
+            DataValid                = Ser(DataDriverId, NumBinaries);
+            if (DataValid && DriverId != DataDriverId)
+            {
+                LOG_INFO_MESSAGE("Program binary cache data was created by a different GL driver and will be ignored.");
+            }
+            else if (DataValid)
+            {
+                Binaries.reserve(NumBinaries);
+                for (Uint32 i = 0; i < NumBinaries && DataValid; ++i)
+                {
+                    ProgramBinaryKey Key;
+                    Uint32           Format     = 0;
+                    const void*      pBinary    = nullptr;
+                    size_t           BinarySize = 0;
+
+                    DataValid = Ser(Key.Low, Key.High, Format) && Ser.SerializeBytes(pBinary, BinarySize);
+                    if (DataValid && BinarySize > 0)
+                    {
+                        std::shared_ptr<ProgramBinaryData> pBinaryData = std::make_shared<ProgramBinaryData>();
+
+                        pBinaryData->Format = static_cast<GLenum>(Format);
+                        pBinaryData->Data.assign(static_cast<const Uint8*>(pBinary), static_cast<const Uint8*>(pBinary) + BinarySize);
+                        Binaries.emplace(Key, std::move(pBinaryData));
+                    }
+                }
+                DataValid = DataValid && Ser.IsEnded();
+            }
+        }
+
+        if (!DataValid)
+        {
+            LOG_WARNING_MESSAGE("Program binary cache data is invalid or corrupted and will be ignored.");
+            Binaries.clear();
+        }
+    }
+
+    std::lock_guard<std::mutex> Lock{m_BinaryCacheMtx};
+    m_BinaryCacheEnabled = true;
+    m_DriverId           = std::move(DriverId);
+    m_Binaries           = std::move(Binaries);
+
+    return DataValid;
+}
+
+bool GLProgramCache::IsBinaryCacheEnabled() const
+{
+    std::lock_guard<std::mutex> Lock{m_BinaryCacheMtx};
+    return m_BinaryCacheEnabled;
+}
+
+RefCntAutoPtr<IDataBlob> GLProgramCache::SerializeBinaryCache() const
+{
+    std::lock_guard<std::mutex> Lock{m_BinaryCacheMtx};
+    if (!m_BinaryCacheEnabled)
+        return {};
+
+    auto SerializeCache = [this](auto& Ser) {
+        const char*  DriverId    = m_DriverId.c_str();
+        const Uint32 NumBinaries = static_cast<Uint32>(m_Binaries.size());
+        if (!Ser(DriverId, NumBinaries))
+            return false;
+
+        for (const auto& it : m_Binaries)
+        {
+            const ProgramBinaryKey&  Key    = it.first;
+            const ProgramBinaryData& Binary = *it.second;
+            const Uint32             Format = static_cast<Uint32>(Binary.Format);
+            if (!Ser(Key.Low, Key.High, Format) || !Ser.SerializeBytes(Binary.Data.data(), Binary.Data.size()))
+                return false;
+        }
+        return true;
+    };
+
+    Serializer<SerializerMode::Measure> MeasureSer;
+    if (!SerializeCache(MeasureSer))
+    {
+        UNEXPECTED("Failed to measure the program binary cache size. This should never happen.");
+        return {};
+    }
+
+    ProgramBinaryCacheHeader Header;
+    Header.DataSize = MeasureSer.GetSize();
+
+    RefCntAutoPtr<DataBlobImpl> pBlob  = DataBlobImpl::Create(sizeof(Header) + static_cast<size_t>(Header.DataSize));
+    Uint8* const                pBytes = pBlob->GetDataPtr<Uint8>();
+
+    SerializedData                    Data{pBytes + sizeof(Header), static_cast<size_t>(Header.DataSize)};
+    Serializer<SerializerMode::Write> WriteSer{Data};
+    if (!SerializeCache(WriteSer))
+    {
+        UNEXPECTED("Failed to serialize the program binary cache. This should never happen.");
+        return {};
+    }
+    VERIFY_EXPR(WriteSer.IsEnded());
+
+    Header.DataHash = XXH3_64bits(pBytes + sizeof(Header), static_cast<size_t>(Header.DataSize));
+    memcpy(pBytes, &Header, sizeof(Header));
+
+    return RefCntAutoPtr<IDataBlob>{pBlob};
+}
+
 } // namespace Diligent
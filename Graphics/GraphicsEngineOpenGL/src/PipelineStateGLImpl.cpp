@@ -260,7 +260,8 @@ public:
     PipelineBuilderBase(PipelineStateGLImpl& Pipeline, const PipelineStateCreateInfo& CreateInfo, TShaderStages Shaders) :
         m_Pipeline{Pipeline},
         m_Shaders{std::move(Shaders)},
-        m_CreateAsynchronously{(CreateInfo.Flags & PSO_CREATE_FLAG_ASYNCHRONOUS) != 0 && Pipeline.GetDevice()->GetDeviceInfo().Features.AsyncShaderCompilation}
+        m_CreateAsynchronously{(CreateInfo.Flags & PSO_CREATE_FLAG_ASYNCHRONOUS) != 0 && Pipeline.GetDevice()->GetDeviceInfo().Features.AsyncShaderCompilation},
+        m_pLinkThreadPool{m_CreateAsynchronously ? Pipeline.GetDevice()->GetShaderCompilationThreadPool() : nullptr}
     {}
 
     virtual ~PipelineBuilderBase() {}
@@ -279,7 +280,9 @@ protected:
     PipelineStateGLImpl& m_Pipeline;
     TShaderStages        m_Shaders;
     const bool           m_CreateAsynchronously;
-    State                m_State = State::Default;
+    // Thread pool that links programs when GL_KHR_parallel_shader_compile is not supported
+    IThreadPool* const m_pLinkThreadPool;
+    State              m_State = State::Default;
 };
 
 template <typename PSOCreateInfoType, typename PSOCreateInfoTypeX>
@@ -399,6 +402,7 @@ private:
                         m_CreateInfo.ResourceSignaturesCount == 0 ? &m_CreateInfo.PSODesc.ResourceLayout : nullptr,
                         m_CreateInfo.ppResourceSignatures,
                         m_CreateInfo.ResourceSignaturesCount,
+                        m_pLinkThreadPool,
                     };
                     m_Pipeline.m_GLPrograms[i]  = m_Pipeline.GetDevice()->GetProgramCache().GetProgram(ProgAttribs);
                     m_Pipeline.m_ShaderTypes[i] = m_Shaders[i]->GetDesc().ShaderType;
@@ -416,6 +420,7 @@ private:
                     m_CreateInfo.ResourceSignaturesCount == 0 ? &m_CreateInfo.PSODesc.ResourceLayout : nullptr,
                     m_CreateInfo.ppResourceSignatures,
                     m_CreateInfo.ResourceSignaturesCount,
+                    m_pLinkThreadPool,
                 };
                 m_Pipeline.m_GLPrograms[0]  = m_Pipeline.GetDevice()->GetProgramCache().GetProgram(ProgAttribs);
                 m_Pipeline.m_ShaderTypes[0] = ActiveStages;
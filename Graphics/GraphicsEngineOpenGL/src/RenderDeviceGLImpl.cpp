@@ -40,6 +40,7 @@
 #include "TextureCubeArray_GL.hpp"
 #include "SamplerGLImpl.hpp"
 #include "DeviceContextGLImpl.hpp"
+#include "SwapChainGL.h"
 #include "PipelineStateGLImpl.hpp"
 #include "ShaderResourceBindingGLImpl.hpp"
 #include "FenceGLImpl.hpp"
@@ -179,8 +180,6 @@ RenderDeviceGLImpl::RenderDeviceGLImpl(IReferenceCounters*       pRefCounters,
 {
     VerifyEngineGLCreateInfo(EngineCI);
 
-    VERIFY(EngineCI.NumDeferredContexts == 0, "EngineCI.NumDeferredContexts > 0 should've been caught by CreateDeviceAndSwapChainGL() or AttachToActiveGLContext()");
-
     GLint NumExtensions = 0;
     glGetIntegerv(GL_NUM_EXTENSIONS, &NumExtensions);
     CHECK_GL_ERROR("Failed to get the number of extensions");
@@ -256,6 +255,14 @@ RenderDeviceGLImpl::RenderDeviceGLImpl(IReferenceCounters*       pRefCounters,
     }
 #endif
 
+    if (EngineCI.Features.AsyncShaderCompilation != DEVICE_FEATURE_STATE_DISABLED &&
+        EngineCI.NumAsyncShaderCompilationThreads != 0 &&
+        !CheckExtension("GL_KHR_parallel_shader_compile"))
+    {
+        // Compile shaders and link programs in worker threads that use shared contexts
+        InitShaderCompilationWorkers(EngineCI.NumAsyncShaderCompilationThreads);
+    }
+
     InitAdapterInfo();
 
     // Enable requested device features
@@ -343,7 +350,7 @@ RenderDeviceGLImpl::RenderDeviceGLImpl(IReferenceCounters*       pRefCounters,
 #endif
 
 #if GL_KHR_parallel_shader_compile
-    if (m_DeviceInfo.Features.AsyncShaderCompilation)
+    if (m_DeviceInfo.Features.AsyncShaderCompilation && !m_pShaderCompilationThreadPool)
     {
         glMaxShaderCompilerThreadsKHR(EngineCI.NumAsyncShaderCompilationThreads);
     }
@@ -352,6 +359,44 @@ RenderDeviceGLImpl::RenderDeviceGLImpl(IReferenceCounters*       pRefCounters,
 
 RenderDeviceGLImpl::~RenderDeviceGLImpl()
 {
+    if (m_pShaderCompilationThreadPool)
+    {
+        // Worker threads must release their contexts before the contexts are destroyed
+        m_pShaderCompilationThreadPool->StopThreads();
+        m_pShaderCompilationThreadPool.Release();
+    }
+}
+
+void RenderDeviceGLImpl::InitShaderCompilationWorkers(Uint32 NumThreads)
+{
+    VERIFY_EXPR(!m_pShaderCompilationThreadPool);
+
+    // Every worker thread needs its own GL context, which is a heavyweight object.
+    constexpr Uint32 MaxWorkerThreads = 4;
+    if (NumThreads == ~0u)
+    {
+        // Leave one core for the main thread
+        const Uint32 NumCores = (std::max)(std::thread::hardware_concurrency(), 1u);
+        NumThreads            = (std::max)(NumCores, 2u) - 1u;
+    }
+    NumThreads = (std::min)(NumThreads, MaxWorkerThreads);
+
+    NumThreads = m_GLContext.CreateWorkerContexts(NumThreads);
+    if (NumThreads == 0)
+        return;
+
+    ThreadPoolCreateInfo ThreadPoolCI;
+    ThreadPoolCI.NumThreads      = NumThreads;
+    ThreadPoolCI.OnThreadStarted = [this](Uint32 ThreadId) {
+        if (!m_GLContext.MakeWorkerContextCurrent(ThreadId))
+            LOG_ERROR_MESSAGE("Failed to make worker GL context ", ThreadId, " current");
+    };
+    ThreadPoolCI.OnThreadExiting = [this](Uint32 /*ThreadId*/) {
+        m_GLContext.ReleaseWorkerContext();
+    };
+    m_pShaderCompilationThreadPool = CreateThreadPool(ThreadPoolCI);
+
+    LOG_INFO_MESSAGE("GL_KHR_parallel_shader_compile is not supported. Shaders will be compiled asynchronously by ", NumThreads, " worker thread(s).");
 }
 
 IMPLEMENT_QUERY_INTERFACE(RenderDeviceGLImpl, IID_RenderDeviceGL, TRenderDeviceBase)
@@ -651,8 +696,7 @@ void RenderDeviceGLImpl::CreatePipelineStateCache(const PipelineStateCacheCreate
 
 void RenderDeviceGLImpl::CreateDeferredContext(IDeviceContext** ppContext)
 {
-    LOG_ERROR_MESSAGE("Deferred contexts are not supported in OpenGL backend.");
-    *ppContext = nullptr;
+    CreateDeferredContextImpl(ppContext);
 }
 
 SparseTextureFormatInfo RenderDeviceGLImpl::GetSparseTextureFormatInfo(TEXTURE_FORMAT     TexFormat,
@@ -873,7 +917,7 @@ void RenderDeviceGLImpl::InitAdapterInfo()
             ENABLE_FEATURE(TextureComponentSwizzle,       IsGL46OrAbove || CheckExtension("GL_ARB_texture_swizzle"));
             ENABLE_FEATURE(TextureSubresourceViews,       IsGL43OrAbove || CheckExtension("GL_ARB_texture_view"));
             ENABLE_FEATURE(NativeMultiDraw,               IsGL46OrAbove || CheckExtension("GL_ARB_shader_draw_parameters")); // Requirements for gl_DrawID
-            ENABLE_FEATURE(AsyncShaderCompilation,        CheckExtension("GL_KHR_parallel_shader_compile"));
+            ENABLE_FEATURE(AsyncShaderCompilation,        CheckExtension("GL_KHR_parallel_shader_compile") || m_pShaderCompilationThreadPool);
             ENABLE_FEATURE(FormattedBuffers,              IsGL40OrAbove);
             // clang-format on
 
@@ -954,7 +998,7 @@ void RenderDeviceGLImpl::InitAdapterInfo()
             ENABLE_FEATURE(TextureComponentSwizzle,   true);
             ENABLE_FEATURE(TextureSubresourceViews,   strstr(Extensions, "texture_view"));
             ENABLE_FEATURE(NativeMultiDraw,           strstr(Extensions, "multi_draw"));
-            ENABLE_FEATURE(AsyncShaderCompilation,    strstr(Extensions, "parallel_shader_compile"));
+            ENABLE_FEATURE(AsyncShaderCompilation,    strstr(Extensions, "parallel_shader_compile") || m_pShaderCompilationThreadPool);
             ENABLE_FEATURE(FormattedBuffers,          IsGLES32OrAbove);
             // clang-format on
 
@@ -1751,6 +1795,67 @@ void RenderDeviceGLImpl::IdleGPU()
     glFinish();
 }
 
+Bool RenderDeviceGLImpl::EnableProgramBinaryCache(const IDataBlob* pCacheData)
+{
+#if PLATFORM_EMSCRIPTEN
+    LOG_WARNING_MESSAGE("Program binaries are not supported in WebGL");
+    return false;
+#else
+    GLint NumBinaryFormats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &NumBinaryFormats);
+    if (glGetError() != GL_NO_ERROR || NumBinaryFormats <= 0)
+    {
+        LOG_WARNING_MESSAGE("Program binary cache can't be enabled because the driver does not support any program binary formats");
+        return false;
+    }
+
+    // Program binaries are only compatible with the same driver, so vendor, renderer
+    // and version strings are all used to identify the driver.
+    std::string DriverId;
+    for (GLenum Name : {GL_VENDOR, GL_RENDERER, GL_VERSION})
+    {
+        if (const GLubyte* Str = glGetString(Name))
+            DriverId += reinterpret_cast<const char*>(Str);
+        DriverId += '\n';
+    }
+
+    // If the data is invalid or was created by a different driver, the cache starts empty.
+    m_ProgramCache.EnableBinaryCache(std::move(DriverId), pCacheData);
+
+    return true;
+#endif
+}
+
+Bool RenderDeviceGLImpl::WriteProgramBinaryCacheToBlob(IDataBlob** ppBlob)
+{
+    DEV_CHECK_ERR(ppBlob != nullptr, "ppBlob must not be null");
+    if (ppBlob == nullptr)
+        return false;
+
+    RefCntAutoPtr<IDataBlob> pData = m_ProgramCache.SerializeBinaryCache();
+    if (!pData)
+    {
+        LOG_ERROR_MESSAGE("Program binary cache is not enabled");
+        return false;
+    }
+
+    *ppBlob = pData.Detach();
+    return true;
+}
+
+Bool RenderDeviceGLImpl::WriteProgramBinaryCacheToStream(IFileStream* pStream)
+{
+    DEV_CHECK_ERR(pStream != nullptr, "pStream must not be null");
+    if (pStream == nullptr)
+        return false;
+
+    RefCntAutoPtr<IDataBlob> pDataBlob;
+    if (!WriteProgramBinaryCacheToBlob(&pDataBlob))
+        return false;
+
+    return pStream->Write(pDataBlob->GetConstDataPtr(), pDataBlob->GetSize());
+}
+
 #if PLATFORM_WIN32
 NativeGLContextAttribs RenderDeviceGLImpl::GetNativeGLContextAttribs() const
 {
@@ -55,9 +55,16 @@ public:
         m_Shader{Shader},
         m_LoadConstantBufferReflection{ShaderCI.LoadConstantBufferReflection},
         m_CreateAsynchronously{(ShaderCI.CompileFlags & SHADER_COMPILE_FLAG_ASYNCHRONOUS) != 0 && Shader.GetDevice()->GetDeviceInfo().Features.AsyncShaderCompilation},
-        m_ppCompilerOutput{GLShaderCI.ppCompilerOutput}
+        m_ppCompilerOutput{GLShaderCI.ppCompilerOutput},
+        m_pCompilationThreadPool{m_CreateAsynchronously ? Shader.GetDevice()->GetShaderCompilationThreadPool() : nullptr}
     {}
 
+    ~ShaderBuilder()
+    {
+        // The compile task references the shader object
+        AsyncInitializer::Update(m_CompileTask, /*WaitForCompletion = */ true);
+    }
+
     bool Tick(bool WaitForCompletion)
     {
         VERIFY(m_State != State::Complete && m_State != State::Failed, "The shader is already in final state, this method should not be called");
@@ -93,7 +100,25 @@ private:
     {
         VERIFY_EXPR(m_State == State::Default);
 
-        m_Shader.CompileShader();
+        if (m_pCompilationThreadPool != nullptr)
+        {
+            // GL_KHR_parallel_shader_compile is not supported: compile the shader
+            // in a worker thread that uses a context shared with the main context.
+            m_CompileTask = AsyncInitializer::Start(
+                m_pCompilationThreadPool,
+                [this](Uint32 /*ThreadId*/) {
+                    m_Shader.CompileShader();
+                    // Wait until the compilation is complete and make the
+                    // results visible to other contexts.
+                    GLint Compiled = GL_FALSE;
+                    glGetShaderiv(m_Shader.m_GLShaderObj, GL_COMPILE_STATUS, &Compiled);
+                    glFinish();
+                });
+        }
+        else
+        {
+            m_Shader.CompileShader();
+        }
         m_State = State::Compiling;
     }
 
@@ -102,7 +127,15 @@ private:
         VERIFY_EXPR(m_State == State::Compiling);
 
         GLint CompilationComplete = GL_FALSE;
-        if (!WaitForCompletion)
+        if (m_CompileTask)
+        {
+            const ASYNC_TASK_STATUS TaskStatus = AsyncInitializer::Update(m_CompileTask, WaitForCompletion);
+            VERIFY_EXPR(!WaitForCompletion || TaskStatus == ASYNC_TASK_STATUS_COMPLETE);
+            CompilationComplete = TaskStatus == ASYNC_TASK_STATUS_COMPLETE ? GL_TRUE : GL_FALSE;
+            if (CompilationComplete)
+                m_CompileTask.reset();
+        }
+        else if (!WaitForCompletion)
         {
             VERIFY_EXPR(m_CreateAsynchronously);
             glGetShaderiv(m_Shader.m_GLShaderObj, GL_COMPLETION_STATUS_KHR, &CompilationComplete);
@@ -131,7 +164,9 @@ private:
             if (!m_Program)
             {
                 ShaderGLImpl* const ThisShader[]{&m_Shader};
-                m_Program = std::make_unique<GLProgram>(ThisShader, 1, /*IsSeparableProgram = */ true);
+                m_Program = std::make_unique<GLProgram>(ThisShader, 1, /*IsSeparableProgram = */ true,
+                                                        /*pBinary = */ nullptr, /*RetrievableBinary = */ false,
+                                                        m_pCompilationThreadPool);
             }
 
             const GLProgram::LinkStatus LinkStatus = m_Program->GetLinkStatus(WaitForCompletion);
@@ -184,6 +219,10 @@ private:
     const bool        m_CreateAsynchronously;
     IDataBlob** const m_ppCompilerOutput;
 
+    // Thread pool that compiles shaders when GL_KHR_parallel_shader_compile is not supported
+    IThreadPool* const                m_pCompilationThreadPool;
+    std::unique_ptr<AsyncInitializer> m_CompileTask;
+
     // Temporary program object used to load shader resources
     std::unique_ptr<GLProgram> m_Program;
 
@@ -32,6 +32,7 @@
 
 #include <vector>
 #include <deque>
+#include <array>
 #include <mutex>
 #include <atomic>
 
@@ -46,7 +47,7 @@ class RenderDeviceVkImpl;
 // This class manages descriptor set allocation.
 // The class destructor calls DescriptorSetAllocator::FreeDescriptorSet() that moves
 // the set into the release queue.
-// sizeof(DescriptorSetAllocation) == 32 (x64)
+// sizeof(DescriptorSetAllocation) == 40 (x64)
 class DescriptorSetAllocation
 {
 public:
@@ -54,11 +55,13 @@ public:
     DescriptorSetAllocation(VkDescriptorSet         _Set,
                             VkDescriptorPool        _Pool,
                             Uint64                  _CmdQueueMask,
-                            DescriptorSetAllocator& _DescrSetAllocator)noexcept :
+                            DescriptorSetAllocator& _DescrSetAllocator,
+                            Uint32                  _ShardIndex)noexcept :
         Set              {_Set               },
         Pool             {_Pool              },
         CmdQueueMask     {_CmdQueueMask      },
-        DescrSetAllocator{&_DescrSetAllocator}
+        DescrSetAllocator{&_DescrSetAllocator},
+        ShardIndex       {_ShardIndex        }
     {}
     DescriptorSetAllocation()noexcept{}
 
@@ -69,7 +72,8 @@ public:
         Set              {rhs.Set              },
         Pool             {rhs.Pool             },
         CmdQueueMask     {rhs.CmdQueueMask     },
-        DescrSetAllocator{rhs.DescrSetAllocator}
+        DescrSetAllocator{rhs.DescrSetAllocator},
+        ShardIndex       {rhs.ShardIndex       }
     {
         rhs.Reset();
     }
@@ -83,6 +87,7 @@ public:
         CmdQueueMask      = rhs.CmdQueueMask;
         Pool              = rhs.Pool;
         DescrSetAllocator = rhs.DescrSetAllocator;
+        ShardIndex        = rhs.ShardIndex;
 
         rhs.Reset();
 
@@ -100,6 +105,7 @@ public:
         Pool              = VK_NULL_HANDLE;
         CmdQueueMask      = 0;
         DescrSetAllocator = nullptr;
+        ShardIndex        = 0;
     }
 
     void Release();
@@ -116,6 +122,7 @@ private:
     VkDescriptorPool        Pool              = VK_NULL_HANDLE;
     Uint64                  CmdQueueMask      = 0;
     DescriptorSetAllocator* DescrSetAllocator = nullptr;
+    Uint32                  ShardIndex        = 0;
 };
 
 
@@ -183,7 +190,27 @@ private:
 
 
 // The class allocates descriptor sets from the main descriptor pool.
-// Descriptors sets can be released and returned to the pool
+// Descriptors sets can be released and returned to the pool.
+//
+// To avoid serializing all threads that create SRBs on a single mutex, descriptor pools
+// are split into NumShards shards. Threads are assigned home shards in round-robin order.
+// A thread always locks its home shard first; when none of the home pools can serve the
+// request, it tries to lock other shards without blocking before creating a new pool, so
+// that idle capacity is reused rather than every shard growing its own pools.
+// A descriptor set must be freed to the pool it was allocated from. If the owning shard is
+// busy at the time the set is released, the set is added to the shard's free list that is
+// drained by the next thread that locks the shard.
+//   ___________________________________________________________________
+//  |                                                                   |
+//  |                       DescriptorSetAllocator                      |
+//  |                                                                   |
+//  |    Shard[0]            Shard[1]                  Shard[N-1]       |
+//  |  | Pool[0] |         | Pool[0] |               | Pool[0] |        |
+//  |  | Pool[1] |         | Pool[1] |      ...      |   ...   |        |
+//  |  |   ...   |         |   ...   |               |         |        |
+//  |  |FreeList |         |FreeList |               |FreeList |        |
+//  |___________________________________________________________________|
+//
 class DescriptorSetAllocator : public DescriptorPoolManager
 {
 public:
@@ -213,6 +240,32 @@ public:
 
     DescriptorSetAllocation Allocate(Uint64 CommandQueueMask, VkDescriptorSetLayout SetLayout, const char* DebugName = "");
 
+    static constexpr Uint32 NumShards = 8;
+
+    struct ShardStats
+    {
+        // The number of descriptor pools owned by the shard
+        Uint32 NumPools = 0;
+
+        // The number of descriptor sets currently allocated from the shard's pools
+        Uint32 NumAllocatedSets = 0;
+
+        // The maximum number of descriptor sets simultaneously allocated from the shard's pools
+        Uint32 PeakAllocatedSets = 0;
+
+        // The total number of descriptor sets allocated from the shard's pools
+        Uint64 NumAllocations = 0;
+
+        // The number of allocations made by threads whose home shard is different
+        Uint64 NumForeignAllocations = 0;
+
+        // The number of descriptor sets that were returned through the free list
+        Uint64 NumDeferredFrees = 0;
+    };
+
+    Uint32     GetNumShards() const { return NumShards; }
+    ShardStats GetShardStats(Uint32 ShardIndex);
+
 #ifdef DILIGENT_DEVELOPMENT
     Int32 GetAllocatedDescriptorSetCounter() const
     {
@@ -221,7 +274,31 @@ public:
 #endif
 
 private:
-    void FreeDescriptorSet(VkDescriptorSet Set, VkDescriptorPool Pool, Uint64 QueueMask);
+    struct Shard
+    {
+        // Protects Pools and Stats
+        std::mutex                                         Mtx;
+        std::deque<VulkanUtilities::DescriptorPoolWrapper> Pools;
+        ShardStats                                         Stats;
+
+        // Descriptor sets released while the shard was locked by another thread
+        std::mutex                                                FreeListMtx;
+        std::vector<std::pair<VkDescriptorPool, VkDescriptorSet>> FreeList;
+        std::atomic<bool>                                         HasPendingFrees{false};
+    };
+
+    static Uint32 GetHomeShardIndex();
+
+    // Tries to allocate the set from one of the existing pools of the shard.
+    // The shard must be locked by the caller.
+    VkDescriptorSet AllocateFromShard(Shard& Shrd, VkDescriptorSetLayout SetLayout, const char* DebugName, VkDescriptorPool& vkPool);
+
+    // Frees all sets from the shard's free list. The shard must be locked by the caller.
+    void DrainFreeList(Shard& Shrd);
+
+    void FreeDescriptorSet(VkDescriptorSet Set, VkDescriptorPool Pool, Uint64 QueueMask, Uint32 ShardIndex);
+
+    std::array<Shard, NumShards> m_Shards;
 
 #ifdef DILIGENT_DEVELOPMENT
     std::atomic<Int32> m_AllocatedSetCounter;
@@ -57,6 +57,8 @@
 #include "VulkanDynamicHeap.hpp"
 #include "ResourceReleaseQueue.hpp"
 #include "DescriptorPoolManager.hpp"
+#include "FramebufferCache.hpp"
+#include "RenderPassCache.hpp"
 #include "HashUtils.hpp"
 #include "ManagedVulkanObject.hpp"
 
@@ -579,6 +581,11 @@ private:
     /// Dynamic rendering info.
     std::unique_ptr<VulkanUtilities::RenderingInfoWrapper> m_DynamicRenderingInfo;
 
+    /// Per-context caches of recently used implicit render passes and framebuffers
+    /// that let the context avoid locking the device-wide caches.
+    RenderPassCache::FrontCache  m_RenderPassFrontCache;
+    FramebufferCache::FrontCache m_FramebufferFrontCache;
+
     FixedBlockMemoryAllocator m_CmdListAllocator;
 
     // Semaphores are not owned by the command context
@@ -33,6 +33,8 @@
 #include <unordered_map>
 #include <mutex>
 #include <memory>
+#include <atomic>
+#include <array>
 
 #include "VulkanUtilities/ObjectWrappers.hpp"
 #include "VulkanUtilities/RenderingInfoWrapper.hpp"
@@ -79,6 +81,40 @@ public:
     void          OnDestroyImageView(VkImageView ImgView);
     void          OnDestroyRenderPass(VkRenderPass Pass);
 
+    // Returns the number of times the cache has evicted framebuffers.
+    Uint32 GetEvictionCount() const
+    {
+        return m_EvictionCount.load(std::memory_order_acquire);
+    }
+
+    // A small per-context cache of recently used framebuffers.
+    //
+    // Device contexts look up framebuffers every time render targets are set. The front cache
+    // lets them do this without taking the shared cache mutex, which becomes contended when
+    // multiple deferred contexts record commands in parallel. The front cache is not thread-safe
+    // and must only be used by one context.
+    //
+    // The front cache is flushed whenever the shared cache evicts any framebuffer. This guarantees
+    // that it never returns a released framebuffer, even if the handle of a destroyed image view
+    // or render pass is reused by a new object.
+    class FrontCache
+    {
+    public:
+        VkFramebuffer GetFramebuffer(FramebufferCache& Cache, const FramebufferCacheKey& Key, uint32_t width, uint32_t height, uint32_t layers);
+
+    private:
+        struct Entry
+        {
+            FramebufferCacheKey Key;
+            VkFramebuffer       vkFramebuffer = VK_NULL_HANDLE;
+        };
+        static constexpr size_t NumEntries = 16;
+
+        std::array<Entry, NumEntries> m_Entries;
+
+        Uint32 m_EvictionCount = 0;
+    };
+
     struct CreateDyanmicRenderInfoAttribs
     {
         VkExtent2D Extent   = {};
@@ -111,6 +147,9 @@ private:
 
     std::unordered_multimap<VkImageView, FramebufferCacheKey>  m_ViewToKeyMap;
     std::unordered_multimap<VkRenderPass, FramebufferCacheKey> m_RenderPassToKeyMap;
+
+    // Incremented every time framebuffers are removed from the cache to let front caches flush stale entries
+    std::atomic<Uint32> m_EvictionCount{0};
 };
 
 } // namespace Diligent
@@ -41,6 +41,7 @@
 #include "FixedBlockMemoryAllocator.hpp"
 #include "SRBMemoryAllocator.hpp"
 #include "PipelineLayoutVk.hpp"
+#include "PatchedSPIRV.hpp"
 #include "VulkanUtilities/ObjectWrappers.hpp"
 #include "VulkanUtilities/CommandBuffer.hpp"
 
@@ -84,8 +85,8 @@ public:
         // Shader stage type. All shaders in the stage must have the same type.
         SHADER_TYPE Type = SHADER_TYPE_UNKNOWN;
 
-        std::vector<const ShaderVkImpl*>   Shaders;
-        std::vector<std::vector<uint32_t>> SPIRVs;
+        std::vector<const ShaderVkImpl*> Shaders;
+        std::vector<PatchedSPIRV>        SPIRVs;
 
         friend SHADER_TYPE GetShaderStageType(const ShaderStageInfo& Stage) { return Stage.Type; }
     };
@@ -234,6 +234,16 @@ public:
         return m_pDxCompiler.get();
     }
 
+    /// Implementation of IRenderDeviceVk::GetNumDescriptorSetAllocatorShards().
+    virtual Uint32 DILIGENT_CALL_TYPE GetNumDescriptorSetAllocatorShards() const override final
+    {
+        return m_DescriptorSetAllocator.GetNumShards();
+    }
+
+    /// Implementation of IRenderDeviceVk::GetDescriptorSetAllocatorShardStats().
+    virtual void DILIGENT_CALL_TYPE GetDescriptorSetAllocatorShardStats(Uint32                              ShardIndex,
+                                                                        DescriptorSetAllocatorShardStatsVk& Stats) override final;
+
     DescriptorSetAllocation AllocateDescriptorSet(Uint64 CommandQueueMask, VkDescriptorSetLayout SetLayout, const char* DebugName = "")
     {
         return m_DescriptorSetAllocator.Allocate(CommandQueueMask, SetLayout, DebugName);
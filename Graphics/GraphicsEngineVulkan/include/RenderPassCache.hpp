@@ -32,6 +32,7 @@
 
 #include <unordered_map>
 #include <mutex>
+#include <array>
 
 #include "GraphicsTypes.h"
 #include "Constants.h"
@@ -130,6 +131,27 @@ public:
 
     void Destroy();
 
+    // A small per-context cache of recently used render passes that lets device contexts
+    // avoid taking the shared cache mutex every time render targets are set.
+    // Render passes are never removed from the shared cache until it is destroyed together
+    // with the device, so the entries never become stale.
+    // The front cache is not thread-safe and must only be used by one context.
+    class FrontCache
+    {
+    public:
+        RenderPassVkImpl* GetRenderPass(RenderPassCache& Cache, const RenderPassCacheKey& Key);
+
+    private:
+        struct Entry
+        {
+            RenderPassCacheKey Key;
+            RenderPassVkImpl*  pRenderPass = nullptr;
+        };
+        static constexpr size_t NumEntries = 8;
+
+        std::array<Entry, NumEntries> m_Entries;
+    };
+
 private:
     struct RenderPassCacheKeyHash
     {
@@ -140,7 +140,7 @@ public:
         explicit operator bool() const { return !IsNull(); }
     };
 
-    // sizeof(DescriptorSet) == 48 (x64, msvc, Release)
+    // sizeof(DescriptorSet) == 56 (x64, msvc, Release)
     class DescriptorSet
     {
     public:
@@ -174,7 +174,7 @@ public:
 /* 0 */ const Uint32            m_NumResources = 0;
 /* 8 */ Resource* const         m_pResources   = nullptr;
 /*16 */ DescriptorSetAllocation m_DescriptorSetAllocation;
-/*48 */ // End of structure
+/*56 */ // End of structure
         // clang-format on
 
     private:
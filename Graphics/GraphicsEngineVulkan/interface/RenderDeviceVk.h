@@ -47,6 +47,31 @@ static DILIGENT_CONSTEXPR INTERFACE_ID IID_RenderDeviceVk =
 
 // clang-format off
 
+/// Statistics of a shard of the descriptor set allocator, see IRenderDeviceVk::GetDescriptorSetAllocatorShardStats().
+struct DescriptorSetAllocatorShardStatsVk
+{
+    /// The number of descriptor pools owned by the shard.
+    Uint32 NumPools              DEFAULT_INITIALIZER(0);
+
+    /// The number of descriptor sets currently allocated from the shard's pools.
+    Uint32 NumAllocatedSets      DEFAULT_INITIALIZER(0);
+
+    /// The maximum number of descriptor sets simultaneously allocated from the shard's pools.
+    Uint32 PeakAllocatedSets     DEFAULT_INITIALIZER(0);
+
+    Uint32 Padding               DEFAULT_INITIALIZER(0);
+
+    /// The total number of descriptor sets allocated from the shard's pools.
+    Uint64 NumAllocations        DEFAULT_INITIALIZER(0);
+
+    /// The number of allocations made by threads whose home shard is different.
+    Uint64 NumForeignAllocations DEFAULT_INITIALIZER(0);
+
+    /// The number of descriptor sets that were released while the shard was locked by another thread.
+    Uint64 NumDeferredFrees      DEFAULT_INITIALIZER(0);
+};
+typedef struct DescriptorSetAllocatorShardStatsVk DescriptorSetAllocatorShardStatsVk;
+
 /// Exposes Vulkan-specific functionality of a render device.
 DILIGENT_BEGIN_INTERFACE(IRenderDeviceVk, IRenderDevice)
 {
@@ -169,6 +194,18 @@ DILIGENT_BEGIN_INTERFACE(IRenderDeviceVk, IRenderDevice)
 
     /// Returns DX compiler interface, or null if the compiler is not loaded.
     VIRTUAL struct IDXCompiler* METHOD(GetDXCompiler)(THIS) CONST PURE;
+
+    /// Returns the number of shards in the descriptor set allocator that is used by shader resource bindings.
+    VIRTUAL Uint32 METHOD(GetNumDescriptorSetAllocatorShards)(THIS) CONST PURE;
+
+    /// Returns the statistics of the descriptor set allocator shard.
+
+    /// \param [in]  ShardIndex - Shard index, must be less than the value returned by
+    ///                           IRenderDeviceVk::GetNumDescriptorSetAllocatorShards().
+    /// \param [out] Stats      - Shard statistics, see Diligent::DescriptorSetAllocatorShardStatsVk.
+    VIRTUAL void METHOD(GetDescriptorSetAllocatorShardStats)(THIS_
+                                                             Uint32                                 ShardIndex,
+                                                             DescriptorSetAllocatorShardStatsVk REF Stats) PURE;
 };
 DILIGENT_END_INTERFACE
 
@@ -178,16 +215,18 @@ DILIGENT_END_INTERFACE
 
 // clang-format off
 
-#    define IRenderDeviceVk_GetVkDevice(This)                         CALL_IFACE_METHOD(RenderDeviceVk, GetVkDevice,                    This)
-#    define IRenderDeviceVk_GetVkPhysicalDevice(This)                 CALL_IFACE_METHOD(RenderDeviceVk, GetVkPhysicalDevice,            This)
-#    define IRenderDeviceVk_GetVkInstance(This)                       CALL_IFACE_METHOD(RenderDeviceVk, GetVkInstance,                  This)
-#    define IRenderDeviceVk_CreateTextureFromVulkanImage(This, ...)   CALL_IFACE_METHOD(RenderDeviceVk, CreateTextureFromVulkanImage,   This, __VA_ARGS__)
-#    define IRenderDeviceVk_CreateBufferFromVulkanResource(This, ...) CALL_IFACE_METHOD(RenderDeviceVk, CreateBufferFromVulkanResource, This, __VA_ARGS__)
-#    define IRenderDeviceVk_CreateBLASFromVulkanResource(This, ...)   CALL_IFACE_METHOD(RenderDeviceVk, CreateBLASFromVulkanResource,   This, __VA_ARGS__)
-#    define IRenderDeviceVk_CreateTLASFromVulkanResource(This, ...)   CALL_IFACE_METHOD(RenderDeviceVk, CreateTLASFromVulkanResource,   This, __VA_ARGS__)
-#    define IRenderDeviceVk_CreateFenceFromVulkanResource(This, ...)  CALL_IFACE_METHOD(RenderDeviceVk, CreateFenceFromVulkanResource,  This, __VA_ARGS__)
-#    define IRenderDeviceVk_GetDeviceFeaturesVk(This, ...)            CALL_IFACE_METHOD(RenderDeviceVk, GetDeviceFeaturesVk,            This, __VA_ARGS__)
-#    define IRenderDeviceVk_GetDXCompiler(This)                       CALL_IFACE_METHOD(RenderDeviceVk, GetDXCompiler,                  This)
+#    define IRenderDeviceVk_GetVkDevice(This)                              CALL_IFACE_METHOD(RenderDeviceVk, GetVkDevice,                         This)
+#    define IRenderDeviceVk_GetVkPhysicalDevice(This)                      CALL_IFACE_METHOD(RenderDeviceVk, GetVkPhysicalDevice,                 This)
+#    define IRenderDeviceVk_GetVkInstance(This)                            CALL_IFACE_METHOD(RenderDeviceVk, GetVkInstance,                       This)
+#    define IRenderDeviceVk_CreateTextureFromVulkanImage(This, ...)        CALL_IFACE_METHOD(RenderDeviceVk, CreateTextureFromVulkanImage,        This, __VA_ARGS__)
+#    define IRenderDeviceVk_CreateBufferFromVulkanResource(This, ...)      CALL_IFACE_METHOD(RenderDeviceVk, CreateBufferFromVulkanResource,      This, __VA_ARGS__)
+#    define IRenderDeviceVk_CreateBLASFromVulkanResource(This, ...)        CALL_IFACE_METHOD(RenderDeviceVk, CreateBLASFromVulkanResource,        This, __VA_ARGS__)
+#    define IRenderDeviceVk_CreateTLASFromVulkanResource(This, ...)        CALL_IFACE_METHOD(RenderDeviceVk, CreateTLASFromVulkanResource,        This, __VA_ARGS__)
+#    define IRenderDeviceVk_CreateFenceFromVulkanResource(This, ...)       CALL_IFACE_METHOD(RenderDeviceVk, CreateFenceFromVulkanResource,       This, __VA_ARGS__)
+#    define IRenderDeviceVk_GetDeviceFeaturesVk(This, ...)                 CALL_IFACE_METHOD(RenderDeviceVk, GetDeviceFeaturesVk,                 This, __VA_ARGS__)
+#    define IRenderDeviceVk_GetDXCompiler(This)                            CALL_IFACE_METHOD(RenderDeviceVk, GetDXCompiler,                       This)
+#    define IRenderDeviceVk_GetNumDescriptorSetAllocatorShards(This)       CALL_IFACE_METHOD(RenderDeviceVk, GetNumDescriptorSetAllocatorShards,  This)
+#    define IRenderDeviceVk_GetDescriptorSetAllocatorShardStats(This, ...) CALL_IFACE_METHOD(RenderDeviceVk, GetDescriptorSetAllocatorShardStats, This, __VA_ARGS__)
 
 // clang-format on
 
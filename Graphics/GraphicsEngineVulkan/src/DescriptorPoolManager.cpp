@@ -37,7 +37,7 @@ void DescriptorSetAllocation::Release()
     if (Set != VK_NULL_HANDLE)
     {
         VERIFY_EXPR(DescrSetAllocator != nullptr && Pool != VK_NULL_HANDLE);
-        DescrSetAllocator->FreeDescriptorSet(Set, Pool, CmdQueueMask);
+        DescrSetAllocator->FreeDescriptorSet(Set, Pool, CmdQueueMask, ShardIndex);
 
         Reset();
     }
@@ -193,51 +193,154 @@ static VkDescriptorSet AllocateDescriptorSet(const VulkanUtilities::LogicalDevic
 DescriptorSetAllocator::~DescriptorSetAllocator()
 {
     DEV_CHECK_ERR(m_AllocatedSetCounter == 0, m_AllocatedSetCounter, " descriptor set(s) have not been returned to the allocator. If there are outstanding references to the sets in release queues, the app will crash when DescriptorSetAllocator::FreeDescriptorSet() is called");
+
+    for (Uint32 ShardIdx = 0; ShardIdx < NumShards; ++ShardIdx)
+    {
+        Shard& Shrd = m_Shards[ShardIdx];
+
+        std::lock_guard<std::mutex> Lock{Shrd.Mtx};
+        DrainFreeList(Shrd);
+
+        const ShardStats& Stats = Shrd.Stats;
+        if (Stats.NumAllocations != 0)
+        {
+            LOG_INFO_MESSAGE(m_PoolName, " shard ", ShardIdx, " stats: ", Stats.NumPools, " pool(s), ",
+                             Stats.NumAllocations, " allocation(s) (", Stats.NumForeignAllocations, " foreign), peak allocated sets: ",
+                             Stats.PeakAllocatedSets, ", deferred frees: ", Stats.NumDeferredFrees);
+        }
+
+        // Move the pools to the base manager so that they are accounted for in its stats
+        for (VulkanUtilities::DescriptorPoolWrapper& Pool : Shrd.Pools)
+            m_Pools.emplace_back(std::move(Pool));
+        Shrd.Pools.clear();
+    }
 }
 
-DescriptorSetAllocation DescriptorSetAllocator::Allocate(Uint64 CommandQueueMask, VkDescriptorSetLayout SetLayout, const char* DebugName)
+Uint32 DescriptorSetAllocator::GetHomeShardIndex()
 {
-    // Descriptor pools are externally synchronized, meaning that the application must not allocate
-    // and/or free descriptor sets from the same pool in multiple threads simultaneously (13.2.3)
-    std::lock_guard<std::mutex> Lock{m_Mutex};
+    // Threads are assigned to shards in round-robin order when they first allocate a set
+    static std::atomic<Uint32> NextThreadIndex{0};
+    thread_local const Uint32  ThreadIndex = NextThreadIndex.fetch_add(1, std::memory_order_relaxed);
+    return ThreadIndex % NumShards;
+}
+
+DescriptorSetAllocator::ShardStats DescriptorSetAllocator::GetShardStats(Uint32 ShardIndex)
+{
+    DEV_CHECK_ERR(ShardIndex < NumShards, "Shard index (", ShardIndex, ") is out of range");
+    Shard& Shrd = m_Shards[ShardIndex];
+
+    std::lock_guard<std::mutex> Lock{Shrd.Mtx};
+    DrainFreeList(Shrd);
+    return Shrd.Stats;
+}
+
+void DescriptorSetAllocator::DrainFreeList(Shard& Shrd)
+{
+    if (!Shrd.HasPendingFrees.load(std::memory_order_acquire))
+        return;
+
+    std::vector<std::pair<VkDescriptorPool, VkDescriptorSet>> FreeList;
+    {
+        std::lock_guard<std::mutex> FreeListLock{Shrd.FreeListMtx};
+        FreeList.swap(Shrd.FreeList);
+        Shrd.HasPendingFrees.store(false, std::memory_order_relaxed);
+    }
+
+    const VulkanUtilities::LogicalDevice& LogicalDevice = m_DeviceVkImpl.GetLogicalDevice();
+    for (const auto& PoolAndSet : FreeList)
+    {
+        LogicalDevice.FreeDescriptorSet(PoolAndSet.first, PoolAndSet.second);
+    }
+    VERIFY_EXPR(Shrd.Stats.NumAllocatedSets >= FreeList.size());
+    Shrd.Stats.NumAllocatedSets -= static_cast<Uint32>(FreeList.size());
+    Shrd.Stats.NumDeferredFrees += FreeList.size();
+}
+
+VkDescriptorSet DescriptorSetAllocator::AllocateFromShard(Shard& Shrd, VkDescriptorSetLayout SetLayout, const char* DebugName, VkDescriptorPool& vkPool)
+{
+    // Return the sets released by other threads first to make room in the pools
+    DrainFreeList(Shrd);
 
     const VulkanUtilities::LogicalDevice& LogicalDevice = m_DeviceVkImpl.GetLogicalDevice();
     // Try all pools starting from the frontmost
-    for (auto it = m_Pools.begin(); it != m_Pools.end(); ++it)
+    for (auto it = Shrd.Pools.begin(); it != Shrd.Pools.end(); ++it)
     {
         VkDescriptorSet vkSet = AllocateDescriptorSet(LogicalDevice, *it, SetLayout, DebugName);
         if (vkSet != VK_NULL_HANDLE)
         {
-            VkDescriptorPool vkPool = *it;
+            vkPool = *it;
             // Move the pool to the front
-            if (it != m_Pools.begin())
+            if (it != Shrd.Pools.begin())
             {
-                std::swap(*it, m_Pools.front());
+                std::swap(*it, Shrd.Pools.front());
             }
+            return vkSet;
+        }
+    }
+
+    return VK_NULL_HANDLE;
+}
 
+DescriptorSetAllocation DescriptorSetAllocator::Allocate(Uint64 CommandQueueMask, VkDescriptorSetLayout SetLayout, const char* DebugName)
+{
+    auto OnAllocated = [this](Shard& Shrd) {
+        ShardStats& Stats = Shrd.Stats;
+        ++Stats.NumAllocations;
+        ++Stats.NumAllocatedSets;
+        Stats.PeakAllocatedSets = std::max(Stats.PeakAllocatedSets, Stats.NumAllocatedSets);
 #ifdef DILIGENT_DEVELOPMENT
-            ++m_AllocatedSetCounter;
+        ++m_AllocatedSetCounter;
 #endif
-            return {vkSet, vkPool, CommandQueueMask, *this};
+    };
+
+    const Uint32 HomeShardIdx = GetHomeShardIndex();
+    Shard&       HomeShard    = m_Shards[HomeShardIdx];
+
+    // Descriptor pools are externally synchronized, meaning that the application must not allocate
+    // and/or free descriptor sets from the same pool in multiple threads simultaneously (13.2.3)
+    std::lock_guard<std::mutex> HomeLock{HomeShard.Mtx};
+
+    VkDescriptorPool vkPool = VK_NULL_HANDLE;
+    if (VkDescriptorSet vkSet = AllocateFromShard(HomeShard, SetLayout, DebugName, vkPool))
+    {
+        OnAllocated(HomeShard);
+        return {vkSet, vkPool, CommandQueueMask, *this, HomeShardIdx};
+    }
+
+    // Home pools are exhausted. Before creating a new pool, try to borrow space from other shards.
+    // Never block on a foreign shard while holding the home shard lock to avoid deadlocks.
+    for (Uint32 i = 1; i < NumShards; ++i)
+    {
+        const Uint32 ShardIdx = (HomeShardIdx + i) % NumShards;
+        Shard&       Shrd     = m_Shards[ShardIdx];
+
+        std::unique_lock<std::mutex> Lock{Shrd.Mtx, std::try_to_lock};
+        if (!Lock.owns_lock())
+            continue;
+
+        if (VkDescriptorSet vkSet = AllocateFromShard(Shrd, SetLayout, DebugName, vkPool))
+        {
+            OnAllocated(Shrd);
+            ++Shrd.Stats.NumForeignAllocations;
+            return {vkSet, vkPool, CommandQueueMask, *this, ShardIdx};
         }
     }
 
     // Failed to allocate descriptor from existing pools -> create a new one
-    LOG_INFO_MESSAGE("Allocated new descriptor pool");
-    m_Pools.emplace_front(CreateDescriptorPool("Descriptor pool"));
+    LOG_INFO_MESSAGE("Allocated new descriptor pool in shard ", HomeShardIdx);
+    HomeShard.Pools.emplace_front(CreateDescriptorPool("Descriptor pool"));
+    ++HomeShard.Stats.NumPools;
 
-    VulkanUtilities::DescriptorPoolWrapper& NewPool = m_Pools.front();
-    VkDescriptorSet                         vkSet   = AllocateDescriptorSet(LogicalDevice, NewPool, SetLayout, DebugName);
+    VulkanUtilities::DescriptorPoolWrapper& NewPool = HomeShard.Pools.front();
+    VkDescriptorSet                         vkSet   = AllocateDescriptorSet(m_DeviceVkImpl.GetLogicalDevice(), NewPool, SetLayout, DebugName);
     DEV_CHECK_ERR(vkSet != VK_NULL_HANDLE, "Failed to allocate descriptor set");
 
-#ifdef DILIGENT_DEVELOPMENT
-    ++m_AllocatedSetCounter;
-#endif
+    OnAllocated(HomeShard);
 
-    return {vkSet, NewPool, CommandQueueMask, *this};
+    return {vkSet, NewPool, CommandQueueMask, *this, HomeShardIdx};
 }
 
-void DescriptorSetAllocator::FreeDescriptorSet(VkDescriptorSet Set, VkDescriptorPool Pool, Uint64 QueueMask)
+void DescriptorSetAllocator::FreeDescriptorSet(VkDescriptorSet Set, VkDescriptorPool Pool, Uint64 QueueMask, Uint32 ShardIndex)
 {
     class DescriptorSetDeleter
     {
@@ -245,10 +348,12 @@ void DescriptorSetAllocator::FreeDescriptorSet(VkDescriptorSet Set, VkDescriptor
         // clang-format off
         DescriptorSetDeleter(DescriptorSetAllocator& _Allocator,
                              VkDescriptorSet         _Set,
-                             VkDescriptorPool        _Pool) :
+                             VkDescriptorPool        _Pool,
+                             Uint32                  _ShardIndex) :
             Allocator {&_Allocator},
             Set       {_Set       },
-            Pool      {_Pool      }
+            Pool      {_Pool      },
+            ShardIndex{_ShardIndex}
         {}
 
         DescriptorSetDeleter             (const DescriptorSetDeleter&) = delete;
@@ -256,9 +361,10 @@ void DescriptorSetAllocator::FreeDescriptorSet(VkDescriptorSet Set, VkDescriptor
         DescriptorSetDeleter& operator = (      DescriptorSetDeleter&&)= delete;
 
         DescriptorSetDeleter(DescriptorSetDeleter&& rhs)noexcept :
-            Allocator {rhs.Allocator},
-            Set       {rhs.Set      },
-            Pool      {rhs.Pool     }
+            Allocator {rhs.Allocator },
+            Set       {rhs.Set       },
+            Pool      {rhs.Pool      },
+            ShardIndex{rhs.ShardIndex}
         {
             rhs.Allocator = nullptr;
             rhs.Set       = VK_NULL_HANDLE;
@@ -270,8 +376,24 @@ void DescriptorSetAllocator::FreeDescriptorSet(VkDescriptorSet Set, VkDescriptor
         {
             if (Allocator != nullptr)
             {
-                std::lock_guard<std::mutex> Lock{Allocator->m_Mutex};
-                Allocator->m_DeviceVkImpl.GetLogicalDevice().FreeDescriptorSet(Pool, Set);
+                Shard& Shrd = Allocator->m_Shards[ShardIndex];
+
+                std::unique_lock<std::mutex> Lock{Shrd.Mtx, std::try_to_lock};
+                if (Lock.owns_lock())
+                {
+                    Allocator->m_DeviceVkImpl.GetLogicalDevice().FreeDescriptorSet(Pool, Set);
+                    VERIFY_EXPR(Shrd.Stats.NumAllocatedSets > 0);
+                    --Shrd.Stats.NumAllocatedSets;
+                    Allocator->DrainFreeList(Shrd);
+                }
+                else
+                {
+                    // The shard is in use by another thread - do not wait and let the
+                    // next thread that locks the shard free the set.
+                    std::lock_guard<std::mutex> FreeListLock{Shrd.FreeListMtx};
+                    Shrd.FreeList.emplace_back(Pool, Set);
+                    Shrd.HasPendingFrees.store(true, std::memory_order_release);
+                }
 #ifdef DILIGENT_DEVELOPMENT
                 --Allocator->m_AllocatedSetCounter;
 #endif
@@ -282,8 +404,10 @@ void DescriptorSetAllocator::FreeDescriptorSet(VkDescriptorSet Set, VkDescriptor
         DescriptorSetAllocator* Allocator;
         VkDescriptorSet         Set;
         VkDescriptorPool        Pool;
+        Uint32                  ShardIndex;
     };
-    m_DeviceVkImpl.SafeReleaseDeviceObject(DescriptorSetDeleter{*this, Set, Pool}, QueueMask);
+    VERIFY_EXPR(ShardIndex < NumShards);
+    m_DeviceVkImpl.SafeReleaseDeviceObject(DescriptorSetDeleter{*this, Set, Pool, ShardIndex}, QueueMask);
 }
 
 
@@ -137,6 +137,30 @@ VkFramebuffer FramebufferCache::GetFramebuffer(const FramebufferCacheKey& Key, u
     }
 }
 
+VkFramebuffer FramebufferCache::FrontCache::GetFramebuffer(FramebufferCache& Cache, const FramebufferCacheKey& Key, uint32_t width, uint32_t height, uint32_t layers)
+{
+    // Read the eviction count before looking up the shared cache: if a framebuffer is evicted
+    // after this point, the count will not match on the next call and the entry will be flushed.
+    const Uint32 EvictionCount = Cache.GetEvictionCount();
+    if (EvictionCount != m_EvictionCount)
+    {
+        for (Entry& CachedEntry : m_Entries)
+            CachedEntry.vkFramebuffer = VK_NULL_HANDLE;
+        m_EvictionCount = EvictionCount;
+    }
+
+    Entry& CachedEntry = m_Entries[Key.GetHash() % NumEntries];
+    if (CachedEntry.vkFramebuffer != VK_NULL_HANDLE && CachedEntry.Key == Key)
+        return CachedEntry.vkFramebuffer;
+
+    VkFramebuffer vkFramebuffer = Cache.GetFramebuffer(Key, width, height, layers);
+
+    CachedEntry.Key           = Key;
+    CachedEntry.vkFramebuffer = vkFramebuffer;
+
+    return vkFramebuffer;
+}
+
 std::unique_ptr<VulkanUtilities::RenderingInfoWrapper> FramebufferCache::CreateDyanmicRenderInfo(const FramebufferCacheKey&            Key,
                                                                                                  const CreateDyanmicRenderInfoAttribs& Attribs)
 {
@@ -200,6 +224,9 @@ void FramebufferCache::OnDestroyImageView(VkImageView ImgView)
     std::lock_guard<std::mutex> Lock{m_Mutex};
 
     auto equal_range = m_ViewToKeyMap.equal_range(ImgView);
+    if (equal_range.first == equal_range.second)
+        return;
+
     for (auto it = equal_range.first; it != equal_range.second; ++it)
     {
         const FramebufferCacheKey& Key = it->second;
@@ -218,7 +245,7 @@ void FramebufferCache::OnDestroyImageView(VkImageView ImgView)
             auto rp_it_range = m_RenderPassToKeyMap.equal_range(Key.Pass);
             for (auto rp_it = rp_it_range.first; rp_it != rp_it_range.second;)
             {
-                if (Key.UsesImageView(ImgView))
+                if (rp_it->second.UsesImageView(ImgView))
                     rp_it = m_RenderPassToKeyMap.erase(rp_it);
                 else
                     ++rp_it;
@@ -226,6 +253,8 @@ void FramebufferCache::OnDestroyImageView(VkImageView ImgView)
         }
     }
     m_ViewToKeyMap.erase(equal_range.first, equal_range.second);
+
+    m_EvictionCount.fetch_add(1, std::memory_order_release);
 }
 
 void FramebufferCache::OnDestroyRenderPass(VkRenderPass Pass)
@@ -233,6 +262,9 @@ void FramebufferCache::OnDestroyRenderPass(VkRenderPass Pass)
     std::lock_guard<std::mutex> Lock{m_Mutex};
 
     auto equal_range = m_RenderPassToKeyMap.equal_range(Pass);
+    if (equal_range.first == equal_range.second)
+        return;
+
     for (auto it = equal_range.first; it != equal_range.second; ++it)
     {
         const FramebufferCacheKey& Key = it->second;
@@ -267,6 +299,8 @@ void FramebufferCache::OnDestroyRenderPass(VkRenderPass Pass)
         PurgeViewToKeyMap(Key.ShadingRate);
     }
     m_RenderPassToKeyMap.erase(equal_range.first, equal_range.second);
+
+    m_EvictionCount.fetch_add(1, std::memory_order_release);
 }
 
 } // namespace Diligent
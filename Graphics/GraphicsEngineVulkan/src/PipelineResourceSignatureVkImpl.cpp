@@ -247,7 +247,7 @@ void PipelineResourceSignatureVkImpl::CreateSetLayouts(const bool IsSerialized)
 
     std::array<std::vector<VkDescriptorSetLayoutBinding>, DESCRIPTOR_SET_ID_NUM_SETS> vkSetLayoutBindings;
 
-    DynamicLinearAllocator TempAllocator{GetRawAllocator(), 256};
+    ThreadScratchArena TempAllocator;
 
     std::vector<bool> ImmutableSamplerWithResource(m_Desc.NumImmutableSamplers, false);
     for (Uint32 i = 0; i < m_Desc.NumResources; ++i)
@@ -283,7 +283,7 @@ void PipelineResourceSignatureVkImpl::CreateSetLayouts(const bool IsSerialized)
             {
                 const RefCntAutoPtr<SamplerVkImpl>& pSamplerVk = m_pImmutableSamplers[SrcImmutableSamplerInd];
 
-                pVkImmutableSamplers = TempAllocator.ConstructArray<VkSampler>(ResDesc.ArraySize, pSamplerVk ? pSamplerVk->GetVkSampler() : VK_NULL_HANDLE);
+                pVkImmutableSamplers = TempAllocator->ConstructArray<VkSampler>(ResDesc.ArraySize, pSamplerVk ? pSamplerVk->GetVkSampler() : VK_NULL_HANDLE);
 
                 ImmutableSamplerWithResource[SrcImmutableSamplerInd] = true;
             }
@@ -423,7 +423,7 @@ void PipelineResourceSignatureVkImpl::CreateSetLayouts(const bool IsSerialized)
         vkSetLayoutBinding.descriptorCount    = 1;
         vkSetLayoutBinding.stageFlags         = ShaderTypesToVkShaderStageFlags(SamplerDesc.ShaderStages);
         vkSetLayoutBinding.descriptorType     = VK_DESCRIPTOR_TYPE_SAMPLER;
-        vkSetLayoutBinding.pImmutableSamplers = TempAllocator.Construct<VkSampler>(pSamplerVk ? pSamplerVk->GetVkSampler() : VK_NULL_HANDLE);
+        vkSetLayoutBinding.pImmutableSamplers = TempAllocator->Construct<VkSampler>(pSamplerVk ? pSamplerVk->GetVkSampler() : VK_NULL_HANDLE);
         vkSetLayoutBindings[SetId].push_back(vkSetLayoutBinding);
     }
 
@@ -63,7 +63,7 @@ void InitPipelineShaderStages(const VulkanUtilities::LogicalDevice&
     for (size_t s = 0; s < ShaderStages.size(); ++s)
     {
         const std::vector<const ShaderVkImpl*>& Shaders    = ShaderStages[s].Shaders;
-        std::vector<std::vector<uint32_t>>&     SPIRVs     = ShaderStages[s].SPIRVs;
+        std::vector<PatchedSPIRV>&              SPIRVs     = ShaderStages[s].SPIRVs;
         const SHADER_TYPE                       ShaderType = ShaderStages[s].Type;
 
         VERIFY_EXPR(Shaders.size() == SPIRVs.size());
@@ -81,8 +81,8 @@ void InitPipelineShaderStages(const VulkanUtilities::LogicalDevice&
 
         for (size_t i = 0; i < Shaders.size(); ++i)
         {
-            const ShaderVkImpl*         pShader = Shaders[i];
-            const std::vector<uint32_t> SPIRV   = SPIRVs[i];
+            const ShaderVkImpl*          pShader = Shaders[i];
+            const std::vector<uint32_t>& SPIRV   = SPIRVs[i].Apply();
 
             ShaderModuleCI.codeSize = SPIRV.size() * sizeof(uint32_t);
             ShaderModuleCI.pCode    = SPIRV.data();
@@ -556,9 +556,11 @@ void VerifyResourceMerge(const char*                       PSOName,
 
 PipelineStateVkImpl::ShaderStageInfo::ShaderStageInfo(const ShaderVkImpl* pShader) :
     Type{pShader->GetDesc().ShaderType},
-    Shaders{pShader},
-    SPIRVs{pShader->GetSPIRV()}
-{}
+    Shaders{pShader}
+{
+    // Do not copy the byte code: it will only be copied if it needs to be patched
+    SPIRVs.emplace_back(pShader->GetSPIRV());
+}
 
 void PipelineStateVkImpl::ShaderStageInfo::Append(const ShaderVkImpl* pShader)
 {
@@ -579,7 +581,7 @@ void PipelineStateVkImpl::ShaderStageInfo::Append(const ShaderVkImpl* pShader)
                GetShaderTypeLiteralName(Type), ").");
     }
     Shaders.push_back(pShader);
-    SPIRVs.push_back(pShader->GetSPIRV());
+    SPIRVs.emplace_back(pShader->GetSPIRV());
 }
 
 size_t PipelineStateVkImpl::ShaderStageInfo::Count() const
@@ -671,15 +673,15 @@ void PipelineStateVkImpl::RemapOrVerifyShaderResources(
     for (size_t s = 0; s < ShaderStages.size(); ++s)
     {
         const std::vector<const ShaderVkImpl*>& Shaders    = ShaderStages[s].Shaders;
-        std::vector<std::vector<uint32_t>>&     SPIRVs     = ShaderStages[s].SPIRVs;
+        std::vector<PatchedSPIRV>&              SPIRVs     = ShaderStages[s].SPIRVs;
         const SHADER_TYPE                       ShaderType = ShaderStages[s].Type;
 
         VERIFY_EXPR(Shaders.size() == SPIRVs.size());
 
         for (size_t i = 0; i < Shaders.size(); ++i)
         {
-            const ShaderVkImpl*    pShader = Shaders[i];
-            std::vector<uint32_t>& SPIRV   = SPIRVs[i];
+            const ShaderVkImpl* pShader = Shaders[i];
+            PatchedSPIRV&       SPIRV   = SPIRVs[i];
 
             const auto& pShaderResources = pShader->GetShaderResources();
             VERIFY_EXPR(pShaderResources);
@@ -753,8 +755,8 @@ void PipelineStateVkImpl::RemapOrVerifyShaderResources(
                     }
                     else
                     {
-                        SPIRV[SPIRVAttribs.BindingDecorationOffset]       = ResourceBinding;
-                        SPIRV[SPIRVAttribs.DescriptorSetDecorationOffset] = DescriptorSet;
+                        SPIRV.Patch(SPIRVAttribs.BindingDecorationOffset, ResourceBinding);
+                        SPIRV.Patch(SPIRVAttribs.DescriptorSetDecorationOffset, DescriptorSet);
                     }
 
                     if (pDvpResourceAttibutions)
@@ -773,9 +775,9 @@ void PipelineStateVkImpl::RemapOrVerifyShaderResources(
                 {
                     OptimizationFlags |= SPIRV_OPTIMIZATION_FLAG_LEGALIZATION;
                 }
-                std::vector<uint32_t> StrippedSPIRV = OptimizeSPIRV(SPIRV, SPV_ENV_MAX, OptimizationFlags);
+                std::vector<uint32_t> StrippedSPIRV = OptimizeSPIRV(SPIRV.Apply(), SPV_ENV_MAX, OptimizationFlags);
                 if (!StrippedSPIRV.empty())
-                    SPIRV = std::move(StrippedSPIRV);
+                    SPIRV.Replace(std::move(StrippedSPIRV));
                 else
                     LOG_ERROR("Failed to strip reflection information from shader '", pShader->GetDesc().Name, "'. This may indicate a problem with the byte code.");
 #endif
@@ -837,4 +837,24 @@ void RenderDeviceVkImpl::GetDeviceFeaturesVk(DeviceFeaturesVk& FeaturesVk) const
     FeaturesVk = PhysicalDeviceFeaturesToDeviceFeaturesVk(m_LogicalDevice->GetEnabledExtFeatures());
 }
 
+void RenderDeviceVkImpl::GetDescriptorSetAllocatorShardStats(Uint32                              ShardIndex,
+                                                             DescriptorSetAllocatorShardStatsVk& Stats)
+{
+    Stats = {};
+    if (ShardIndex >= m_DescriptorSetAllocator.GetNumShards())
+    {
+        DEV_ERROR("Shard index (", ShardIndex, ") is out of range");
+        return;
+    }
+
+    const DescriptorSetAllocator::ShardStats ShardStats = m_DescriptorSetAllocator.GetShardStats(ShardIndex);
+
+    Stats.NumPools              = ShardStats.NumPools;
+    Stats.NumAllocatedSets      = ShardStats.NumAllocatedSets;
+    Stats.PeakAllocatedSets     = ShardStats.PeakAllocatedSets;
+    Stats.NumAllocations        = ShardStats.NumAllocations;
+    Stats.NumForeignAllocations = ShardStats.NumForeignAllocations;
+    Stats.NumDeferredFrees      = ShardStats.NumDeferredFrees;
+}
+
 } // namespace Diligent
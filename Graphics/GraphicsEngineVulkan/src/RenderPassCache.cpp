@@ -250,4 +250,19 @@ RenderPassVkImpl* RenderPassCache::GetRenderPass(const RenderPassCacheKey& Key)
     return it->second;
 }
 
+RenderPassVkImpl* RenderPassCache::FrontCache::GetRenderPass(RenderPassCache& Cache, const RenderPassCacheKey& Key)
+{
+    Entry& CachedEntry = m_Entries[Key.GetHash() % NumEntries];
+    if (CachedEntry.pRenderPass != nullptr && CachedEntry.Key == Key)
+        return CachedEntry.pRenderPass;
+
+    RenderPassVkImpl* pRenderPass = Cache.GetRenderPass(Key);
+    if (pRenderPass != nullptr)
+    {
+        CachedEntry.Key         = Key;
+        CachedEntry.pRenderPass = pRenderPass;
+    }
+    return pRenderPass;
+}
+
 } // namespace Diligent
@@ -227,6 +227,21 @@ void ShaderVkImpl::Initialize(const ShaderCreateInfo& ShaderCI,
         LOG_ERROR_AND_THROW("Shader source must be provided through one of the 'Source', 'FilePath' or 'ByteCode' members");
     }
 
+    // Byte code loaded from an archive may have the reflection data appended to SPIR-V
+    // (see AppendSPIRVReflection). Split it off so that only SPIR-V is passed to Vulkan.
+    std::vector<Uint8> ReflectionData;
+    {
+        size_t      SPIRVWordCount = 0;
+        const void* pReflection    = nullptr;
+        size_t      ReflectionSize = 0;
+        if (FindSPIRVReflection(m_SPIRV.data(), m_SPIRV.size() * sizeof(uint32_t), SPIRVWordCount, pReflection, ReflectionSize))
+        {
+            const Uint8* pReflectionBytes = static_cast<const Uint8*>(pReflection);
+            ReflectionData.assign(pReflectionBytes, pReflectionBytes + ReflectionSize);
+            m_SPIRV.resize(SPIRVWordCount);
+        }
+    }
+
     // We cannot create shader module here because resource bindings are assigned when
     // pipeline state is created
 
@@ -241,17 +256,51 @@ void ShaderVkImpl::Initialize(const ShaderCreateInfo& ShaderCI,
                 ALLOCATE(Allocator, "Memory for SPIRVShaderResources", SPIRVShaderResources, 1),
                 STDDeleterRawMem<void>(Allocator),
             };
-            const bool LoadShaderInputs = m_Desc.ShaderType == SHADER_TYPE_VERTEX;
-            new (pRawMem.get()) SPIRVShaderResources // May throw
+            const bool  LoadShaderInputs      = m_Desc.ShaderType == SHADER_TYPE_VERTEX;
+            const char* CombinedSamplerSuffix = m_Desc.UseCombinedTextureSamplers ? m_Desc.CombinedSamplerSuffix : nullptr;
+
+            bool ResourcesLoaded = false;
+            if (!ReflectionData.empty())
+            {
+                // Use the serialized reflection to avoid parsing SPIR-V with SPIRV-Cross.
+                const SerializedData Reflection{ReflectionData.data(), ReflectionData.size()};
+                if (SPIRVShaderResources::IsReflectionCompatible(Reflection, LoadShaderInputs, ShaderCI.LoadConstantBufferReflection))
                 {
-                    Allocator,
-                    m_SPIRV,
-                    m_Desc,
-                    m_Desc.UseCombinedTextureSamplers ? m_Desc.CombinedSamplerSuffix : nullptr,
-                    LoadShaderInputs,
-                    ShaderCI.LoadConstantBufferReflection,
-                    m_EntryPoint //
-                };
+                    try
+                    {
+                        new (pRawMem.get()) SPIRVShaderResources // May throw
+                            {
+                                Allocator,
+                                Reflection,
+                                m_Desc,
+                                CombinedSamplerSuffix,
+                                LoadShaderInputs,
+                                ShaderCI.LoadConstantBufferReflection,
+                                m_EntryPoint //
+                            };
+                        ResourcesLoaded = true;
+                    }
+                    catch (...)
+                    {
+                        LOG_WARNING_MESSAGE("Failed to load serialized reflection of shader '", m_Desc.Name, "'. Reflection will be loaded from SPIR-V.");
+                        m_EntryPoint.clear();
+                    }
+                }
+            }
+
+            if (!ResourcesLoaded)
+            {
+                new (pRawMem.get()) SPIRVShaderResources // May throw
+                    {
+                        Allocator,
+                        m_SPIRV,
+                        m_Desc,
+                        CombinedSamplerSuffix,
+                        LoadShaderInputs,
+                        ShaderCI.LoadConstantBufferReflection,
+                        m_EntryPoint //
+                    };
+            }
             VERIFY_EXPR(ShaderCI.ByteCode != nullptr || m_EntryPoint == ShaderCI.EntryPoint ||
                         (m_EntryPoint == "main" && (ShaderCI.CompileFlags & SHADER_COMPILE_FLAG_HLSL_TO_SPIRV_VIA_GLSL) != 0));
             m_pShaderResources.reset(static_cast<SPIRVShaderResources*>(pRawMem.release()), STDDeleterRawMem<SPIRVShaderResources>(Allocator));
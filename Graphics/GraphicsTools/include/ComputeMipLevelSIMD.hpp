@@ -0,0 +1,156 @@
+/*
+ *  Copyright 2019-2025 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Vectorized kernels used by ComputeMipLevel.
+
+#include <cstring>
+
+#include "GraphicsTypes.h"
+#include "GraphicsAccessories.hpp"
+
+namespace Diligent
+{
+
+/// Computes the box average of a row of coarse mip level texels.
+
+/// \param [in]  pFineRow0   - Pointer to the first fine mip level row.
+/// \param [in]  pFineRow1   - Pointer to the second fine mip level row. May be equal to pFineRow0.
+/// \param [out] pCoarseRow  - Pointer to the coarse mip level row.
+/// \param [in]  CoarseWidth - Coarse mip level width. The fine rows must contain at least 2 * CoarseWidth texels.
+/// \return      The number of processed texels starting from the beginning of the row.
+///              The remaining texels must be processed by the scalar code.
+///
+/// \remarks     The results are bit-exact with the scalar implementation.
+using MipRowFilterKernelType = Uint32 (*)(const void* pFineRow0, const void* pFineRow1, void* pCoarseRow, Uint32 CoarseWidth);
+
+/// Remaps the alpha channel of a row of RGBA8 texels, see ComputeMipLevelAttribs::AlphaCutoff.
+
+/// \return The number of processed texels starting from the beginning of the row.
+using AlphaRemapRowKernelType = Uint32 (*)(Uint8* pRow, Uint32 Width, float AlphaCutoff);
+
+/// Returns the vectorized box filter row kernel for the given texture format,
+/// or null if there is no kernel for the format or the CPU does not support it.
+MipRowFilterKernelType GetMipRowBoxFilterKernel(const TextureFormatAttribs& FmtAttribs);
+
+/// Returns the vectorized alpha remapping kernel for RGBA8 texels,
+/// or null if the CPU does not support it.
+AlphaRemapRowKernelType GetAlphaRemapRowKernel();
+
+
+/// Converts a half-precision floating-point value to single precision.
+inline float Float16ToFloat32(Uint16 Half)
+{
+    const Uint32 Sign     = (Uint32{Half} & 0x8000u) << 16u;
+    const Uint32 Exponent = (Uint32{Half} >> 10u) & 0x1Fu;
+    Uint32       Mantissa = Uint32{Half} & 0x3FFu;
+
+    Uint32 Bits = 0;
+    if (Exponent == 0x1Fu)
+    {
+        // Inf or NaN. NaNs are quieted like in the hardware conversion.
+        Bits = Sign | 0x7F800000u | (Mantissa != 0 ? 0x400000u | (Mantissa << 13u) : 0u);
+    }
+    else if (Exponent != 0)
+    {
+        Bits = Sign | ((Exponent + (127u - 15u)) << 23u) | (Mantissa << 13u);
+    }
+    else if (Mantissa != 0)
+    {
+        // Denormal: normalize the mantissa
+        Uint32 e = 127u - 15u + 1u;
+        while ((Mantissa & 0x400u) == 0)
+        {
+            Mantissa <<= 1u;
+            --e;
+        }
+        Bits = Sign | (e << 23u) | ((Mantissa & 0x3FFu) << 13u);
+    }
+    else
+    {
+        Bits = Sign;
+    }
+
+    float Value;
+    memcpy(&Value, &Bits, sizeof(Value));
+    return Value;
+}
+
+/// Converts a single-precision floating-point value to half precision using
+/// round-to-nearest-even mode, which matches the hardware conversion.
+inline Uint16 Float32ToFloat16(float Value)
+{
+    Uint32 Bits;
+    memcpy(&Bits, &Value, sizeof(Bits));
+
+    const Uint32 Sign     = (Bits >> 16u) & 0x8000u;
+    const Uint32 Exponent = (Bits >> 23u) & 0xFFu;
+    const Uint32 Mantissa = Bits & 0x7FFFFFu;
+
+    if (Exponent == 0xFFu)
+    {
+        // Inf or NaN. NaNs are quieted and keep the upper bits of the payload.
+        return static_cast<Uint16>(Sign | 0x7C00u | (Mantissa != 0 ? 0x200u | (Mantissa >> 13u) : 0u));
+    }
+
+    const int HalfExponent = static_cast<int>(Exponent) - 127 + 15;
+    if (HalfExponent >= 0x1F)
+    {
+        // Overflow
+        return static_cast<Uint16>(Sign | 0x7C00u);
+    }
+
+    Uint32 HalfBits  = 0;
+    Uint32 Remainder = 0; // Discarded bits aligned to the most significant bit
+    if (HalfExponent <= 0)
+    {
+        // Denormal or zero
+        if (HalfExponent < -10)
+            return static_cast<Uint16>(Sign);
+
+        const Uint32 FullMantissa = Mantissa | 0x800000u;
+        const Uint32 Shift        = static_cast<Uint32>(14 - HalfExponent);
+
+        HalfBits  = FullMantissa >> Shift;
+        Remainder = FullMantissa << (32u - Shift);
+    }
+    else
+    {
+        HalfBits  = (static_cast<Uint32>(HalfExponent) << 10u) | (Mantissa >> 13u);
+        Remainder = Mantissa << 19u;
+    }
+
+    // Round to nearest even. Carry into the exponent correctly produces the next power of two or infinity.
+    if (Remainder > 0x80000000u || (Remainder == 0x80000000u && (HalfBits & 1u) != 0))
+        ++HalfBits;
+
+    return static_cast<Uint16>(Sign | HalfBits);
+}
+
+} // namespace Diligent
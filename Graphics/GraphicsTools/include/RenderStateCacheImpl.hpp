@@ -30,7 +30,11 @@
 /// Definition of the Diligent::RenderStateCacheImpl class
 
 #include <unordered_map>
+#include <unordered_set>
 #include <mutex>
+#include <memory>
+#include <string>
+#include <vector>
 
 #include "RenderStateCache.h"
 #include "SerializationDevice.h"
@@ -92,6 +96,32 @@ public:
         return CreatePipelineState(PSOCreateInfo, ppPipelineState);
     }
 
+    virtual void DILIGENT_CALL_TYPE CreateShaders(Uint32                  NumShaders,
+                                                  const ShaderCreateInfo* pShaderCIs,
+                                                  IThreadPool*            pThreadPool,
+                                                  IShader**               ppShaders,
+                                                  IAsyncTask**            ppTasks) override final;
+
+    virtual void DILIGENT_CALL_TYPE CreateGraphicsPipelineStates(
+        Uint32                                 NumPipelines,
+        const GraphicsPipelineStateCreateInfo* pPSOCreateInfos,
+        IThreadPool*                           pThreadPool,
+        IPipelineState**                       ppPipelineStates,
+        IAsyncTask**                           ppTasks) override final
+    {
+        CreatePipelineStates(NumPipelines, pPSOCreateInfos, pThreadPool, ppPipelineStates, ppTasks);
+    }
+
+    virtual void DILIGENT_CALL_TYPE CreateComputePipelineStates(
+        Uint32                                NumPipelines,
+        const ComputePipelineStateCreateInfo* pPSOCreateInfos,
+        IThreadPool*                          pThreadPool,
+        IPipelineState**                      ppPipelineStates,
+        IAsyncTask**                          ppTasks) override final
+    {
+        CreatePipelineStates(NumPipelines, pPSOCreateInfos, pThreadPool, ppPipelineStates, ppTasks);
+    }
+
     virtual Bool DILIGENT_CALL_TYPE WriteToBlob(Uint32 ContentVersion, IDataBlob** ppBlob) override final;
 
     virtual Bool DILIGENT_CALL_TYPE WriteToStream(Uint32 ContentVersion, IFileStream* pStream) override final;
@@ -134,6 +164,47 @@ private:
     bool CreatePipelineState(const CreateInfoType& PSOCreateInfo,
                              IPipelineState**      ppPipelineState);
 
+    template <typename CreateInfoType>
+    void CreatePipelineStates(Uint32                NumPipelines,
+                              const CreateInfoType* pPSOCreateInfos,
+                              IThreadPool*          pThreadPool,
+                              IPipelineState**      ppPipelineStates,
+                              IAsyncTask**          ppTasks);
+
+    // Groups the create infos by hash and creates one object per group,
+    // either in the calling thread or in the thread pool.
+    template <typename ObjectType, typename CreateInfoType, typename GetHashType, typename CreateObjectType>
+    void CreateObjects(Uint32                NumObjects,
+                       const CreateInfoType* pCreateInfos,
+                       IThreadPool*          pThreadPool,
+                       ObjectType**          ppObjects,
+                       IAsyncTask**          ppTasks,
+                       GetHashType&&         GetHash,
+                       CreateObjectType&&    CreateObject);
+
+    XXH128Hash ComputeShaderHash(const ShaderCreateInfo& ShaderCI);
+
+    template <typename CreateInfoType>
+    XXH128Hash ComputePipelineStateHash(const CreateInfoType& PSOCreateInfo);
+
+    // Content hash of a single source file and the list of files it directly includes.
+    struct SourceFileHashInfo
+    {
+        XXH128Hash               Hash;
+        std::vector<std::string> Includes;
+    };
+
+    std::shared_ptr<const SourceFileHashInfo> GetSourceFileHash(IShaderSourceInputStreamFactory* pFactory, const char* FilePath) noexcept(false);
+
+    void HashSourceFile(XXH128State&                     Hasher,
+                        IShaderSourceInputStreamFactory* pFactory,
+                        const std::string&               FilePath,
+                        std::unordered_set<std::string>& Visited) noexcept(false);
+
+    void HashShaderCIByContent(XXH128State& Hasher, const ShaderCreateInfo& ShaderCI);
+
+    void ClearSourceFileHashes();
+
 private:
     RefCntAutoPtr<IRenderDevice>                   m_pDevice;
     const RENDER_DEVICE_TYPE                       m_DeviceType;
@@ -155,6 +226,16 @@ private:
     std::mutex                                                          m_ReloadablePipelinesMtx;
     std::unordered_map<UniqueIdentifier, RefCntWeakPtr<IPipelineState>> m_ReloadablePipelines;
 
+    // Source file hashes memoized per shader source stream factory.
+    // The map is cleared by Reload() and Reset() so that modified files are re-read.
+    struct FactorySourceFileHashes
+    {
+        RefCntWeakPtr<IShaderSourceInputStreamFactory>                             pFactory;
+        std::unordered_map<std::string, std::shared_ptr<const SourceFileHashInfo>> Files;
+    };
+    std::mutex                                                                    m_SourceFileHashesMtx;
+    std::unordered_map<IShaderSourceInputStreamFactory*, FactorySourceFileHashes> m_SourceFileHashes;
+
     Uint32 m_ReloadVersion = 0;
 };
 
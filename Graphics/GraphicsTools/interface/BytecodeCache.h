@@ -53,12 +53,20 @@ static DILIGENT_CONSTEXPR INTERFACE_ID IID_BytecodeCache = {0xD1F8295F, 0xF9D7,
 // clang-format off
 
 /// Byte code cache interface
+
+/// All methods of the interface are thread-safe. Byte codes may be requested and added
+/// by multiple threads simultaneously.
 DILIGENT_BEGIN_INTERFACE(IBytecodeCache, IObject)
 {
     /// Loads the cache data from the binary blob
 
     /// \param [in] pData - A pointer to the cache data.
     /// \return     true if the data was loaded successfully, and false otherwise.
+    ///
+    /// \remarks    The cache keeps a reference to the data blob produced by Store() and returns
+    ///             bytecodes that point directly to its memory. The data must not be modified
+    ///             after it has been loaded. To avoid reading the entire cache file at startup,
+    ///             map it into memory with MappedFileDataBlob::Create().
     VIRTUAL bool METHOD(Load)(THIS_
                               IDataBlob* pData) PURE;
 
@@ -101,6 +109,20 @@ DILIGENT_BEGIN_INTERFACE(IBytecodeCache, IObject)
     VIRTUAL void METHOD(Store)(THIS_
                                IDataBlob** ppDataBlob) PURE;
 
+    /// Writes the journal of the changes made since the last call to Store or StoreIncremental.
+
+    /// \param [out] ppDataBlob - Address of the memory location where a pointer to the
+    ///                           data blob containing the journal data will be written.
+    ///                           The function calls AddRef(), so that the new object will have
+    ///                           one reference.
+    ///
+    /// \remarks    The journal only contains the byte codes that were added or removed since the
+    ///             previous save, so it is much cheaper to produce than the full cache data.
+    ///             Journal data blobs can be appended to a single file in the order they were
+    ///             produced. To restore the cache, load the data produced by Store first, and then
+    ///             load the journal.
+    VIRTUAL void METHOD(StoreIncremental)(THIS_
+                                          IDataBlob** ppDataBlob) PURE;
 
     /// Clears the cache and resets it to default state.
     VIRTUAL void METHOD(Clear)(THIS) PURE;
@@ -112,12 +134,13 @@ DILIGENT_END_INTERFACE
 #if DILIGENT_C_INTERFACE
 
 // clang-format off
-#    define IBytecodeCache_Load(This, ...)           CALL_IFACE_METHOD(BytecodeCache, Load,           This, __VA_ARGS__)
-#    define IBytecodeCache_GetBytecode(This, ...)    CALL_IFACE_METHOD(BytecodeCache, GetBytecode,    This, __VA_ARGS__)
-#    define IBytecodeCache_AddBytecode(This, ...)    CALL_IFACE_METHOD(BytecodeCache, AddBytecode,    This, __VA_ARGS__)
-#    define IBytecodeCache_RemoveBytecode(This, ...) CALL_IFACE_METHOD(BytecodeCache, RemoveBytecode, This, __VA_ARGS__)
-#    define IBytecodeCache_Store(This, ...)          CALL_IFACE_METHOD(BytecodeCache, Store,          This, __VA_ARGS__)
-#    define IBytecodeCache_Clear(This)               CALL_IFACE_METHOD(BytecodeCache, Clear,          This)
+#    define IBytecodeCache_Load(This, ...)             CALL_IFACE_METHOD(BytecodeCache, Load,             This, __VA_ARGS__)
+#    define IBytecodeCache_GetBytecode(This, ...)      CALL_IFACE_METHOD(BytecodeCache, GetBytecode,      This, __VA_ARGS__)
+#    define IBytecodeCache_AddBytecode(This, ...)      CALL_IFACE_METHOD(BytecodeCache, AddBytecode,      This, __VA_ARGS__)
+#    define IBytecodeCache_RemoveBytecode(This, ...)   CALL_IFACE_METHOD(BytecodeCache, RemoveBytecode,   This, __VA_ARGS__)
+#    define IBytecodeCache_Store(This, ...)            CALL_IFACE_METHOD(BytecodeCache, Store,            This, __VA_ARGS__)
+#    define IBytecodeCache_StoreIncremental(This, ...) CALL_IFACE_METHOD(BytecodeCache, StoreIncremental, This, __VA_ARGS__)
+#    define IBytecodeCache_Clear(This)                 CALL_IFACE_METHOD(BytecodeCache, Clear,            This)
 // clang-format on
 
 #endif
@@ -109,6 +109,20 @@ struct ComputeMipLevelAttribs
     ///     A_new = max(A_old; 1/3 * A_old + 2/3 * AlphaCutoff)
     float AlphaCutoff          DEFAULT_INITIALIZER(0);
 
+    /// An optional thread pool that is used to compute the mip level in parallel.
+
+    /// If the pointer is null, the mip level is computed by the calling thread.
+    /// The result does not depend on whether the thread pool is used.
+    IThreadPool* pThreadPool  DEFAULT_INITIALIZER(nullptr);
+
+    /// Whether to use vectorized kernels when they are available for the format and the CPU.
+
+    /// Vectorized kernels are implemented for the box filter of RGBA8 UNORM and sRGB,
+    /// R16 and RGBA16 float and RGBA32 float formats, and for the alpha remapping.
+    /// The results are bit-exact with the scalar implementation, so this option is
+    /// only intended for testing and benchmarking.
+    Bool UseSIMD               DEFAULT_INITIALIZER(True);
+
 #if DILIGENT_CPP_INTERFACE
     constexpr ComputeMipLevelAttribs() noexcept {}
 
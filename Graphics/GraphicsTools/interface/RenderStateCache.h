@@ -56,6 +56,12 @@ DILIGENT_TYPED_ENUM(RENDER_STATE_CACHE_FILE_HASH_MODE, Uint8)
     /// This is the most reliable method, but it requires reading
     /// the entire file contents, as well as all included files,
     /// which may be time-consuming.
+    ///
+    /// The cache memoizes the hash and the list of includes of every file
+    /// it reads, so each file is only read once. The memoized hashes are
+    /// discarded by `IRenderStateCache::Reload()` and `IRenderStateCache::Reset()`,
+    /// so changes to source files made after a file has been hashed
+    /// are only detected after one of these methods is called.
     RENDER_STATE_CACHE_FILE_HASH_MODE_BY_CONTENT,
 
     /// Hash files by their names.
@@ -244,6 +250,65 @@ DILIGENT_BEGIN_INTERFACE(IRenderStateCache, IObject)
                                                  const TilePipelineStateCreateInfo REF PSOCreateInfo,
                                                  IPipelineState**                      ppPipelineState) PURE;
 
+    /// Creates multiple shader objects in parallel using the thread pool.
+
+    /// \param [in]  NumShaders  - The number of shaders to create.
+    /// \param [in]  pShaderCIs  - An array of NumShaders shader create infos.
+    /// \param [in]  pThreadPool - The thread pool to use to create the shaders.
+    ///                            If it is null, the shaders are created by the calling thread.
+    /// \param [out] ppShaders   - An array of NumShaders elements where pointers to the created
+    ///                            shader objects will be written.
+    /// \param [out] ppTasks     - An optional array of NumShaders elements where pointers to
+    ///                            the tasks that create the shaders will be written.
+    ///
+    /// Create infos that produce the same hash are only processed once, and
+    /// all of them share the same task and receive the same shader object.
+    /// The shader in ppShaders[i] is written by the worker thread and is only
+    /// valid when ppTasks[i] is finished. If the shader could not be created,
+    /// ppShaders[i] is null after the task has finished.
+    ///
+    /// If pThreadPool is null, all shaders are created before the method returns
+    /// and null is written to all elements of ppTasks.
+    ///
+    /// \warning   The application must keep pShaderCIs, all data they reference, and
+    ///            ppShaders alive until all tasks are finished.
+    VIRTUAL void METHOD(CreateShaders)(THIS_
+                                       Uint32                  NumShaders,
+                                       const ShaderCreateInfo* pShaderCIs,
+                                       IThreadPool*            pThreadPool,
+                                       IShader**               ppShaders,
+                                       IAsyncTask**            ppTasks DEFAULT_VALUE(nullptr)) PURE;
+
+    /// Creates multiple graphics pipeline state objects in parallel using the thread pool.
+
+    /// \param [in]  NumPipelines     - The number of pipeline states to create.
+    /// \param [in]  pPSOCreateInfos  - An array of NumPipelines graphics pipeline state create infos.
+    /// \param [in]  pThreadPool      - The thread pool to use to create the pipeline states.
+    ///                                 If it is null, the pipelines are created by the calling thread.
+    /// \param [out] ppPipelineStates - An array of NumPipelines elements where pointers to the
+    ///                                 created pipeline state objects will be written.
+    /// \param [out] ppTasks          - An optional array of NumPipelines elements where pointers
+    ///                                 to the tasks that create the pipelines will be written.
+    ///
+    /// See IRenderStateCache::CreateShaders for details. Create infos are only deduplicated
+    /// when all their shaders are ready at the time of the call.
+    VIRTUAL void METHOD(CreateGraphicsPipelineStates)(THIS_
+                                                      Uint32                                 NumPipelines,
+                                                      const GraphicsPipelineStateCreateInfo* pPSOCreateInfos,
+                                                      IThreadPool*                           pThreadPool,
+                                                      IPipelineState**                       ppPipelineStates,
+                                                      IAsyncTask**                           ppTasks DEFAULT_VALUE(nullptr)) PURE;
+
+    /// Creates multiple compute pipeline state objects in parallel using the thread pool.
+
+    /// See IRenderStateCache::CreateGraphicsPipelineStates for details.
+    VIRTUAL void METHOD(CreateComputePipelineStates)(THIS_
+                                                     Uint32                                NumPipelines,
+                                                     const ComputePipelineStateCreateInfo* pPSOCreateInfos,
+                                                     IThreadPool*                          pThreadPool,
+                                                     IPipelineState**                      ppPipelineStates,
+                                                     IAsyncTask**                          ppTasks DEFAULT_VALUE(nullptr)) PURE;
+
     /// Writes cache contents to a memory blob.
 
     /// \param [in]   ContentVersion - The version of the content to write.
@@ -314,6 +379,9 @@ DILIGENT_END_INTERFACE
 #    define IRenderStateCache_CreateComputePipelineState(This, ...)    CALL_IFACE_METHOD(RenderStateCache, CreateComputePipelineState,   This, __VA_ARGS__)
 #    define IRenderStateCache_CreateRayTracingPipelineState(This, ...) CALL_IFACE_METHOD(RenderStateCache, CreateRayTracingPipelineState,This, __VA_ARGS__)
 #    define IRenderStateCache_CreateTilePipelineState(This, ...)       CALL_IFACE_METHOD(RenderStateCache, CreateTilePipelineState,      This, __VA_ARGS__)
+#    define IRenderStateCache_CreateShaders(This, ...)                 CALL_IFACE_METHOD(RenderStateCache, CreateShaders,                This, __VA_ARGS__)
+#    define IRenderStateCache_CreateGraphicsPipelineStates(This, ...)  CALL_IFACE_METHOD(RenderStateCache, CreateGraphicsPipelineStates, This, __VA_ARGS__)
+#    define IRenderStateCache_CreateComputePipelineStates(This, ...)   CALL_IFACE_METHOD(RenderStateCache, CreateComputePipelineStates,  This, __VA_ARGS__)
 #    define IRenderStateCache_WriteToBlob(This, ...)                   CALL_IFACE_METHOD(RenderStateCache, WriteToBlob,                  This, __VA_ARGS__)
 #    define IRenderStateCache_WriteToStream(This, ...)                 CALL_IFACE_METHOD(RenderStateCache, WriteToStream,                This, __VA_ARGS__)
 #    define IRenderStateCache_Reset(This)                              CALL_IFACE_METHOD(RenderStateCache, Reset,                        This)
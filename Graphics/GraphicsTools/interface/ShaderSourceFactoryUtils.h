@@ -179,6 +179,73 @@ void DILIGENT_GLOBAL_FUNCTION(CreateMemoryShaderSourceFactory)(const MemoryShade
                                                                IShaderSourceInputStreamFactory**             ppFactory);
 
 
+/// Packs shader source files into a single data blob.
+///
+/// \param [in]  Sources - Shader source files to pack, see Diligent::MemoryShaderSourceFactoryCreateInfo.
+///                        The CopySources member is ignored.
+/// \param [out] ppPack  - Address of the memory location where the pointer to the data blob
+///                        containing the packed sources will be written.
+///
+/// The pack can be saved to a file and later loaded by the packed shader source factory
+/// (see Diligent::CreatePackedShaderSourceFactory). Packs can also be built offline from a
+/// directory with the BuildTools/ShaderSourcePack/script.py utility.
+void DILIGENT_GLOBAL_FUNCTION(CreateShaderSourcePack)(const MemoryShaderSourceFactoryCreateInfo REF Sources,
+                                                      IDataBlob**                                   ppPack);
+
+
+/// Packed shader source factory create info.
+struct PackedShaderSourceFactoryCreateInfo
+{
+    /// Shader source pack data created by Diligent::CreateShaderSourcePack.
+    /// The factory keeps a strong reference to the data blob.
+    IDataBlob* pPackData DEFAULT_INITIALIZER(nullptr);
+
+    /// Path to the shader source pack file. The file is mapped into memory.
+    /// Ignored if pPackData is not null.
+    const Char* FilePath DEFAULT_INITIALIZER(nullptr);
+
+#if DILIGENT_CPP_INTERFACE
+    constexpr PackedShaderSourceFactoryCreateInfo() noexcept
+    {}
+
+    constexpr explicit PackedShaderSourceFactoryCreateInfo(IDataBlob* _pPackData) noexcept :
+        pPackData{_pPackData}
+    {}
+
+    constexpr explicit PackedShaderSourceFactoryCreateInfo(const Char* _FilePath) noexcept :
+        FilePath{_FilePath}
+    {}
+#endif
+};
+typedef struct PackedShaderSourceFactoryCreateInfo PackedShaderSourceFactoryCreateInfo;
+
+/// Creates a shader source factory that serves files from a shader source pack.
+///
+/// \param [in]  CreateInfo - Packed shader source factory create info, see Diligent::PackedShaderSourceFactoryCreateInfo.
+/// \param [out] ppFactory  - Address of the memory location where the pointer to the created factory will be written.
+///                           If the pack is invalid, null will be written.
+///
+/// Streams created by the factory reference the pack data directly and do not copy it.
+/// File names are matched exactly, so the names in the pack must use the same form (e.g. forward
+/// slashes) as the names used in #include directives.
+void DILIGENT_GLOBAL_FUNCTION(CreatePackedShaderSourceFactory)(const PackedShaderSourceFactoryCreateInfo REF CreateInfo,
+                                                               IShaderSourceInputStreamFactory**             ppFactory);
+
+
+/// Creates a shader source factory that caches files loaded by another factory.
+///
+/// \param [in]  pFactory  - Factory to load files from when they are requested for the first time.
+/// \param [out] ppFactory - Address of the memory location where the pointer to the created factory will be written.
+///
+/// The factory is thread-safe and is intended to be shared by shaders that are compiled in parallel
+/// so that every include file is loaded from the underlying factory only once. Files that were not
+/// found are not cached and are requested from the underlying factory again every time. Loaded files
+/// are never invalidated, so the factory should not be used when source files may change, e.g. for
+/// shader hot reloading.
+void DILIGENT_GLOBAL_FUNCTION(CreateCachingShaderSourceFactory)(IShaderSourceInputStreamFactory*  pFactory,
+                                                                IShaderSourceInputStreamFactory** ppFactory);
+
+
 #include "../../../Primitives/interface/UndefGlobalFuncHelperMacros.h"
 
 DILIGENT_END_NAMESPACE // namespace Diligent
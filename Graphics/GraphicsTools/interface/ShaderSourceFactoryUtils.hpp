@@ -274,4 +274,35 @@ inline RefCntAutoPtr<IShaderSourceInputStreamFactory> CreateCompoundShaderSource
     return CreateCompoundShaderSourceFactory(CI);
 }
 
+inline RefCntAutoPtr<IDataBlob> CreateShaderSourcePack(const MemoryShaderSourceFactoryCreateInfo& Sources)
+{
+    RefCntAutoPtr<IDataBlob> pPack;
+    CreateShaderSourcePack(Sources, &pPack);
+    return pPack;
+}
+
+inline RefCntAutoPtr<IShaderSourceInputStreamFactory> CreatePackedShaderSourceFactory(const PackedShaderSourceFactoryCreateInfo& CI)
+{
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pFactory;
+    CreatePackedShaderSourceFactory(CI, &pFactory);
+    return pFactory;
+}
+
+inline RefCntAutoPtr<IShaderSourceInputStreamFactory> CreatePackedShaderSourceFactory(IDataBlob* pPackData)
+{
+    return CreatePackedShaderSourceFactory(PackedShaderSourceFactoryCreateInfo{pPackData});
+}
+
+inline RefCntAutoPtr<IShaderSourceInputStreamFactory> CreatePackedShaderSourceFactory(const Char* FilePath)
+{
+    return CreatePackedShaderSourceFactory(PackedShaderSourceFactoryCreateInfo{FilePath});
+}
+
+inline RefCntAutoPtr<IShaderSourceInputStreamFactory> CreateCachingShaderSourceFactory(IShaderSourceInputStreamFactory* pFactory)
+{
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pCachingFactory;
+    CreateCachingShaderSourceFactory(pFactory, &pCachingFactory);
+    return pCachingFactory;
+}
+
 } // namespace Diligent
@@ -25,19 +25,47 @@
  */
 
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <algorithm>
+#include <mutex>
+#include <shared_mutex>
 
 #include "RefCntAutoPtr.hpp"
 #include "DataBlobImpl.hpp"
+#include "ProxyDataBlob.hpp"
 #include "ObjectBase.hpp"
 #include "Serializer.hpp"
 #include "BytecodeCache.h"
 #include "XXH128Hasher.hpp"
-#include "DefaultRawMemoryAllocator.hpp"
+#include "Align.hpp"
+#include "Cast.hpp"
 
 namespace Diligent
 {
 
 /// Implementation of IBytecodeCache
+///
+/// Version 2 of the cache data has the following layout:
+///
+///     | Header | Index (sorted by hash) | Bytecode 0 | Bytecode 1 | ... |
+///
+/// Every index entry contains the hash, the offset of the bytecode from the beginning
+/// of the data and its size. Bytecodes are aligned by BytecodeAlignment bytes.
+/// When version 2 data is loaded, the cache only reads the index and keeps a reference to
+/// the data blob. Bytecodes are returned as proxy data blobs that point directly to the loaded
+/// data, so if the data blob is a memory-mapped file, bytecodes are never copied.
+///
+/// The journal produced by StoreIncremental() is a sequence of chunks:
+///
+///     | Chunk Header | Index | Bytecode 0 | ... | Chunk Header | Index | Bytecode 0 | ... |
+///
+/// Every chunk has the same layout as the version 2 data, but uses a different magic number,
+/// stores its size in the header, and index offsets are relative to the beginning of the chunk.
+/// Removed bytecodes are marked with RemovedOffset. Chunks are padded to BytecodeAlignment bytes,
+/// so that they can simply be appended to each other.
+///
+/// Bytecodes are read under a shared lock, while all modifications take an exclusive lock.
 class BytecodeCacheImpl final : public ObjectBase<IBytecodeCache>
 {
 public:
@@ -46,7 +74,7 @@ public:
     struct BytecodeCacheHeader
     {
         static constexpr Uint32 HeaderMagic   = 0x7ADECACE;
-        static constexpr Uint32 HeaderVersion = 1;
+        static constexpr Uint32 HeaderVersion = 2;
 
         Uint32 Magic   = HeaderMagic;
         Uint32 Version = HeaderVersion;
@@ -60,7 +88,26 @@ public:
         }
     };
 
-    struct BytecodeCacheElementHeader
+    struct JournalChunkHeader
+    {
+        static constexpr Uint32 JournalMagic   = 0x7ADEC0DE;
+        static constexpr Uint32 JournalVersion = 1;
+
+        Uint32 Magic   = JournalMagic;
+        Uint32 Version = JournalVersion;
+
+        Uint64 ElementCount = 0;
+        Uint64 ChunkSize    = 0;
+
+        template <typename SerType>
+        void Serialize(SerType& Stream)
+        {
+            Stream(Magic, Version, ElementCount, ChunkSize);
+        }
+    };
+
+    // Version 1 element header that precedes every bytecode
+    struct BytecodeCacheElementHeaderV1
     {
         XXH128Hash Hash     = {};
         size_t     DataSize = 0;
@@ -72,6 +119,29 @@ public:
         }
     };
 
+    struct BytecodeCacheIndexEntry
+    {
+        XXH128Hash Hash   = {};
+        Uint64     Offset = 0;
+        Uint64     Size   = 0;
+
+        template <typename SerType>
+        void Serialize(SerType& Stream)
+        {
+            Stream(Hash.LowPart, Hash.HighPart, Offset, Size);
+        }
+
+        bool operator<(const BytecodeCacheIndexEntry& RHS) const
+        {
+            return HashLess(Hash, RHS.Hash);
+        }
+    };
+
+    static constexpr size_t BytecodeAlignment = 16;
+
+    // Index entry offset that marks the bytecode removed in the journal
+    static constexpr Uint64 RemovedOffset = ~Uint64{0};
+
 public:
     BytecodeCacheImpl(IReferenceCounters*            pRefCounters,
                       const BytecodeCacheCreateInfo& CreateInfo) :
@@ -90,33 +160,40 @@ public:
             return false;
         }
 
+        if (pDataBlob->GetSize() < sizeof(BytecodeCacheHeader))
+        {
+            LOG_ERROR_MESSAGE("Bytecode cache data is too small");
+            return false;
+        }
+
         Serializer<SerializerMode::Read> Stream{SerializedData{pDataBlob->GetDataPtr(), pDataBlob->GetSize()}};
 
         BytecodeCacheHeader Header;
         Header.Serialize(Stream);
+
+        std::unique_lock<std::shared_mutex> Lock{m_Mtx};
+
+        if (Header.Magic == JournalChunkHeader::JournalMagic)
+            return LoadJournal(pDataBlob);
+
         if (Header.Magic != BytecodeCacheHeader::HeaderMagic)
         {
             LOG_ERROR_MESSAGE("Incorrect bytecode header magic number");
             return false;
         }
 
-        if (Header.Version != BytecodeCacheHeader::HeaderVersion)
+        switch (Header.Version)
         {
-            LOG_ERROR_MESSAGE("Incorrect bytecode header version (", Header.Version, "). ", Uint32{BytecodeCacheHeader::HeaderVersion}, " is expected.");
-            return false;
-        }
+            case 1:
+                return LoadV1(Stream, Header);
 
-        for (Uint64 ItemID = 0; ItemID < Header.ElementCount; ItemID++)
-        {
-            BytecodeCacheElementHeader ElementHeader;
-            ElementHeader.Serialize(Stream);
+            case BytecodeCacheHeader::HeaderVersion:
+                return LoadV2(pDataBlob, Stream, Header);
 
-            RefCntAutoPtr<DataBlobImpl> pBytecode = DataBlobImpl::Create(ElementHeader.DataSize);
-            Stream.CopyBytes(pBytecode->GetDataPtr(), ElementHeader.DataSize);
-            m_HashMap.emplace(ElementHeader.Hash, pBytecode);
+            default:
+                LOG_ERROR_MESSAGE("Incorrect bytecode header version (", Header.Version, "). ", Uint32{BytecodeCacheHeader::HeaderVersion}, " is expected.");
+                return false;
         }
-
-        return true;
     }
 
     virtual void DILIGENT_CALL_TYPE GetBytecode(const ShaderCreateInfo& ShaderCI, IDataBlob** ppByteCode) override final
@@ -125,12 +202,23 @@ public:
         DEV_CHECK_ERR(*ppByteCode == nullptr, "*ppByteCode is not null. Make sure you are not overwriting reference to an existing object as this may result in memory leaks.");
         const XXH128Hash Hash = ComputeHash(ShaderCI);
 
-        const auto Iter = m_HashMap.find(Hash);
-        if (Iter != m_HashMap.end())
+        RefCntAutoPtr<IDataBlob> pObject;
         {
-            RefCntAutoPtr<IDataBlob> pObject = Iter->second;
-            *ppByteCode                      = pObject.Detach();
+            std::shared_lock<std::shared_mutex> Lock{m_Mtx};
+
+            auto Iter = m_HashMap.find(Hash);
+            if (Iter != m_HashMap.end())
+            {
+                // Null bytecode indicates that the loaded entry was removed
+                pObject = Iter->second;
+            }
+            else if (const BytecodeCacheIndexEntry* pEntry = FindLoadedEntry(Hash))
+            {
+                // The view is not kept in the hash map to avoid taking an exclusive lock
+                pObject = CreateBytecodeView(m_pLoadedData, pEntry->Offset, pEntry->Size);
+            }
         }
+        *ppByteCode = pObject.Detach();
     }
 
     virtual void DILIGENT_CALL_TYPE AddBytecode(const ShaderCreateInfo& ShaderCI, IDataBlob* pByteCode) override final
@@ -138,15 +226,21 @@ public:
         DEV_CHECK_ERR(pByteCode != nullptr, "pByteCode must not be null.");
         const XXH128Hash Hash = ComputeHash(ShaderCI);
 
+        std::unique_lock<std::shared_mutex> Lock{m_Mtx};
+
         const auto Iter = m_HashMap.emplace(Hash, pByteCode);
         if (!Iter.second)
             Iter.first->second = pByteCode;
+        m_PendingHashes.emplace(Hash);
     }
 
     virtual void DILIGENT_CALL_TYPE RemoveBytecode(const ShaderCreateInfo& ShaderCI) override final
     {
         const XXH128Hash Hash = ComputeHash(ShaderCI);
-        m_HashMap.erase(Hash);
+
+        std::unique_lock<std::shared_mutex> Lock{m_Mtx};
+        RemoveBytecode(Hash);
+        m_PendingHashes.emplace(Hash);
     }
 
     virtual void DILIGENT_CALL_TYPE Store(IDataBlob** ppDataBlob) override final
@@ -154,40 +248,63 @@ public:
         DEV_CHECK_ERR(ppDataBlob != nullptr, "ppDataBlob must not be null.");
         DEV_CHECK_ERR(*ppDataBlob == nullptr, "*ppDataBlob is not null. Make sure you are not overwriting reference to an existing object as this may result in memory leaks.");
 
-        auto WriteData = [&](auto& Stream) //
+        std::unique_lock<std::shared_mutex> Lock{m_Mtx};
+
+        std::vector<BytecodeInfo> Bytecodes;
+        Bytecodes.reserve(m_HashMap.size() + m_LoadedIndex.size());
+        for (const auto& Pair : m_HashMap)
         {
-            BytecodeCacheHeader Header{};
-            Header.ElementCount = m_HashMap.size();
-            Header.Serialize(Stream);
+            if (const RefCntAutoPtr<IDataBlob>& pBytecode = Pair.second)
+                Bytecodes.push_back({{Pair.first, 0, pBytecode->GetSize()}, pBytecode->GetConstDataPtr()});
+        }
+        for (const BytecodeCacheIndexEntry& Entry : m_LoadedIndex)
+        {
+            // Entries in the hash map override the loaded ones
+            if (m_HashMap.find(Entry.Hash) == m_HashMap.end())
+                Bytecodes.push_back({Entry, Entry.Size > 0 ? m_pLoadedData->GetConstDataPtr(StaticCast<size_t>(Entry.Offset)) : nullptr});
+        }
 
-            for (auto const& Pair : m_HashMap)
-            {
-                const RefCntAutoPtr<IDataBlob>& pBytecode = Pair.second;
+        BytecodeCacheHeader Header{};
+        Header.ElementCount = Bytecodes.size();
 
-                BytecodeCacheElementHeader ElementHeader;
-                ElementHeader.Hash     = Pair.first;
-                ElementHeader.DataSize = pBytecode->GetSize();
-                ElementHeader.Serialize(Stream);
+        *ppDataBlob = WriteData(Header, Bytecodes).Detach();
+        m_PendingHashes.clear();
+    }
 
-                Stream.CopyBytes(pBytecode->GetConstDataPtr(), ElementHeader.DataSize);
-            }
-        };
+    virtual void DILIGENT_CALL_TYPE StoreIncremental(IDataBlob** ppDataBlob) override final
+    {
+        DEV_CHECK_ERR(ppDataBlob != nullptr, "ppDataBlob must not be null.");
+        DEV_CHECK_ERR(*ppDataBlob == nullptr, "*ppDataBlob is not null. Make sure you are not overwriting reference to an existing object as this may result in memory leaks.");
 
-        Serializer<SerializerMode::Measure> MeasureStream{};
-        WriteData(MeasureStream);
+        std::unique_lock<std::shared_mutex> Lock{m_Mtx};
 
-        const SerializedData Memory = MeasureStream.AllocateData(DefaultRawMemoryAllocator::GetAllocator());
+        std::vector<BytecodeInfo> Bytecodes;
+        Bytecodes.reserve(m_PendingHashes.size());
+        for (const XXH128Hash& Hash : m_PendingHashes)
+        {
+            // Pending hashes are always present in the hash map unless the bytecode was removed
+            const auto Iter = m_HashMap.find(Hash);
+            if (Iter != m_HashMap.end() && Iter->second)
+                Bytecodes.push_back({{Hash, 0, Iter->second->GetSize()}, Iter->second->GetConstDataPtr()});
+            else
+                Bytecodes.push_back({{Hash, RemovedOffset, 0}, nullptr});
+        }
 
-        Serializer<SerializerMode::Write> WriteStream{Memory};
-        WriteData(WriteStream);
-        VERIFY_EXPR(WriteStream.IsEnded());
+        JournalChunkHeader Header{};
+        Header.ElementCount = Bytecodes.size();
 
-        *ppDataBlob = DataBlobImpl::Create(Memory.Size(), Memory.Ptr()).Detach();
+        *ppDataBlob = WriteData(Header, Bytecodes).Detach();
+        m_PendingHashes.clear();
     }
 
     virtual void DILIGENT_CALL_TYPE Clear() override final
     {
+        std::unique_lock<std::shared_mutex> Lock{m_Mtx};
+
         m_HashMap.clear();
+        m_LoadedIndex.clear();
+        m_pLoadedData.Release();
+        m_PendingHashes.clear();
     }
 
 private:
@@ -198,10 +315,266 @@ private:
         return Hasher.Digest();
     }
 
+    static bool HashLess(const XXH128Hash& lhs, const XXH128Hash& rhs)
+    {
+        return lhs.HighPart != rhs.HighPart ? lhs.HighPart < rhs.HighPart : lhs.LowPart < rhs.LowPart;
+    }
+
+    const BytecodeCacheIndexEntry* FindLoadedEntry(const XXH128Hash& Hash) const
+    {
+        const auto Iter = std::lower_bound(m_LoadedIndex.begin(), m_LoadedIndex.end(), Hash,
+                                           [](const BytecodeCacheIndexEntry& Entry, const XXH128Hash& Value) {
+                                               return HashLess(Entry.Hash, Value);
+                                           });
+        return (Iter != m_LoadedIndex.end() && Iter->Hash == Hash) ? &*Iter : nullptr;
+    }
+
+    static RefCntAutoPtr<IDataBlob> CreateBytecodeView(IDataBlob* pData, Uint64 Offset, Uint64 Size)
+    {
+        void* pBytecode = Size > 0 ? pData->GetDataPtr(StaticCast<size_t>(Offset)) : nullptr;
+        return RefCntAutoPtr<IDataBlob>{ProxyDataBlob::Create(pBytecode, StaticCast<size_t>(Size), pData)};
+    }
+
+    void RemoveBytecode(const XXH128Hash& Hash)
+    {
+        if (FindLoadedEntry(Hash) != nullptr)
+        {
+            // Keep null bytecode to hide the loaded entry
+            m_HashMap[Hash].Release();
+        }
+        else
+        {
+            m_HashMap.erase(Hash);
+        }
+    }
+
+    struct BytecodeInfo
+    {
+        BytecodeCacheIndexEntry IndexEntry;
+        const void*             pData;
+    };
+
+    // Writes the header, the sorted index and the bytecodes. Removed bytecodes are only
+    // written to the index.
+    template <typename HeaderType>
+    static RefCntAutoPtr<DataBlobImpl> WriteData(HeaderType& Header, std::vector<BytecodeInfo>& Bytecodes)
+    {
+        std::sort(Bytecodes.begin(), Bytecodes.end(),
+                  [](const BytecodeInfo& lhs, const BytecodeInfo& rhs) {
+                      return lhs.IndexEntry < rhs.IndexEntry;
+                  });
+
+        Serializer<SerializerMode::Measure> MeasureStream{};
+        Header.Serialize(MeasureStream);
+        for (BytecodeInfo& Bytecode : Bytecodes)
+            Bytecode.IndexEntry.Serialize(MeasureStream);
+
+        size_t DataSize = MeasureStream.GetSize();
+        for (BytecodeInfo& Bytecode : Bytecodes)
+        {
+            if (Bytecode.IndexEntry.Offset == RemovedOffset)
+                continue;
+            DataSize                   = AlignUp(DataSize, BytecodeAlignment);
+            Bytecode.IndexEntry.Offset = DataSize;
+            DataSize += StaticCast<size_t>(Bytecode.IndexEntry.Size);
+        }
+        // Pad the data so that the next journal chunk is properly aligned
+        DataSize = AlignUp(DataSize, BytecodeAlignment);
+        SetChunkSize(Header, DataSize);
+
+        RefCntAutoPtr<DataBlobImpl> pDataBlob = DataBlobImpl::Create(DataSize);
+
+        Serializer<SerializerMode::Write> WriteStream{SerializedData{pDataBlob->GetDataPtr(), DataSize}};
+        Header.Serialize(WriteStream);
+        for (BytecodeInfo& Bytecode : Bytecodes)
+            Bytecode.IndexEntry.Serialize(WriteStream);
+        memset(pDataBlob->GetDataPtr(WriteStream.GetSize()), 0, DataSize - WriteStream.GetSize());
+
+        for (const BytecodeInfo& Bytecode : Bytecodes)
+        {
+            if (Bytecode.IndexEntry.Size > 0)
+                memcpy(pDataBlob->GetDataPtr(StaticCast<size_t>(Bytecode.IndexEntry.Offset)), Bytecode.pData, StaticCast<size_t>(Bytecode.IndexEntry.Size));
+        }
+
+        return pDataBlob;
+    }
+
+    static void SetChunkSize(BytecodeCacheHeader&, size_t) {}
+    static void SetChunkSize(JournalChunkHeader& Header, size_t Size) { Header.ChunkSize = Size; }
+
+    bool LoadV1(Serializer<SerializerMode::Read>& Stream, const BytecodeCacheHeader& Header)
+    {
+        for (Uint64 ItemID = 0; ItemID < Header.ElementCount; ItemID++)
+        {
+            BytecodeCacheElementHeaderV1 ElementHeader;
+            ElementHeader.Serialize(Stream);
+
+            if (ElementHeader.DataSize > Stream.GetRemainingSize())
+            {
+                LOG_ERROR_MESSAGE("Bytecode cache data is corrupted");
+                return false;
+            }
+
+            RefCntAutoPtr<DataBlobImpl> pBytecode = DataBlobImpl::Create(ElementHeader.DataSize);
+            Stream.CopyBytes(pBytecode->GetDataPtr(), ElementHeader.DataSize);
+
+            // Existing bytecodes take precedence, but removed ones are replaced by the loaded data
+            const auto Iter = m_HashMap.emplace(ElementHeader.Hash, pBytecode);
+            if (!Iter.second && !Iter.first->second)
+            {
+                Iter.first->second = pBytecode;
+                m_PendingHashes.erase(ElementHeader.Hash);
+            }
+        }
+
+        return true;
+    }
+
+    bool LoadV2(IDataBlob* pDataBlob, Serializer<SerializerMode::Read>& Stream, const BytecodeCacheHeader& Header)
+    {
+        const size_t DataSize = pDataBlob->GetSize();
+        if (Header.ElementCount > Stream.GetRemainingSize() / (sizeof(Uint64) * 4))
+        {
+            LOG_ERROR_MESSAGE("Bytecode cache data is corrupted: the index exceeds the data size");
+            return false;
+        }
+
+        std::vector<BytecodeCacheIndexEntry> Index(StaticCast<size_t>(Header.ElementCount));
+        for (size_t i = 0; i < Index.size(); ++i)
+        {
+            BytecodeCacheIndexEntry& Entry = Index[i];
+            Entry.Serialize(Stream);
+            if (Entry.Offset > DataSize || Entry.Size > DataSize - Entry.Offset)
+            {
+                LOG_ERROR_MESSAGE("Bytecode cache data is corrupted: bytecode ", i, " exceeds the data size");
+                return false;
+            }
+            if (i > 0 && !(Index[i - 1] < Entry))
+            {
+                LOG_ERROR_MESSAGE("Bytecode cache data is corrupted: the index is not sorted");
+                return false;
+            }
+        }
+
+        if (m_pLoadedData)
+        {
+            // Only one data blob is referenced at a time. Create views for the entries
+            // of the previously loaded data. Existing entries take precedence.
+            for (const BytecodeCacheIndexEntry& Entry : m_LoadedIndex)
+            {
+                if (m_HashMap.find(Entry.Hash) == m_HashMap.end())
+                    m_HashMap.emplace(Entry.Hash, CreateBytecodeView(m_pLoadedData, Entry.Offset, Entry.Size));
+            }
+        }
+
+        // Null bytecodes only hide the entries of the previously loaded data, which are no longer referenced.
+        // The data being loaded is the latest record for its hashes, so it must not be hidden either.
+        for (auto it = m_HashMap.begin(); it != m_HashMap.end();)
+        {
+            if (!it->second)
+                it = m_HashMap.erase(it);
+            else
+                ++it;
+        }
+        for (const BytecodeCacheIndexEntry& Entry : Index)
+        {
+            // Pending removals of the loaded bytecodes are superseded as well
+            if (m_HashMap.find(Entry.Hash) == m_HashMap.end())
+                m_PendingHashes.erase(Entry.Hash);
+        }
+
+        m_LoadedIndex = std::move(Index);
+        m_pLoadedData = pDataBlob;
+
+        return true;
+    }
+
+    bool LoadJournal(IDataBlob* pDataBlob)
+    {
+        const size_t DataSize = pDataBlob->GetSize();
+
+        // Validate all chunks before applying any changes
+        std::vector<BytecodeCacheIndexEntry> Entries;
+        for (size_t ChunkOffset = 0; ChunkOffset < DataSize;)
+        {
+            const size_t ChunkDataSize = DataSize - ChunkOffset;
+            if (ChunkDataSize < sizeof(JournalChunkHeader))
+            {
+                LOG_ERROR_MESSAGE("Bytecode cache journal is corrupted: chunk at offset ", ChunkOffset, " is truncated");
+                return false;
+            }
+
+            Serializer<SerializerMode::Read> Stream{SerializedData{pDataBlob->GetDataPtr(ChunkOffset), ChunkDataSize}};
+
+            JournalChunkHeader Header;
+            Header.Serialize(Stream);
+            if (Header.Magic != JournalChunkHeader::JournalMagic)
+            {
+                LOG_ERROR_MESSAGE("Incorrect bytecode cache journal magic number at offset ", ChunkOffset);
+                return false;
+            }
+            if (Header.Version != JournalChunkHeader::JournalVersion)
+            {
+                LOG_ERROR_MESSAGE("Incorrect bytecode cache journal version (", Header.Version, "). ", Uint32{JournalChunkHeader::JournalVersion}, " is expected.");
+                return false;
+            }
+            if (Header.ChunkSize < sizeof(JournalChunkHeader) || Header.ChunkSize > ChunkDataSize ||
+                Header.ElementCount > Stream.GetRemainingSize() / (sizeof(Uint64) * 4))
+            {
+                LOG_ERROR_MESSAGE("Bytecode cache journal is corrupted: chunk at offset ", ChunkOffset, " exceeds the data size");
+                return false;
+            }
+
+            for (Uint64 i = 0; i < Header.ElementCount; ++i)
+            {
+                BytecodeCacheIndexEntry Entry;
+                Entry.Serialize(Stream);
+                if (Entry.Offset != RemovedOffset)
+                {
+                    if (Entry.Offset > Header.ChunkSize || Entry.Size > Header.ChunkSize - Entry.Offset)
+                    {
+                        LOG_ERROR_MESSAGE("Bytecode cache journal is corrupted: bytecode ", i, " of the chunk at offset ", ChunkOffset, " exceeds the chunk size");
+                        return false;
+                    }
+                    Entry.Offset += ChunkOffset;
+                }
+                Entries.push_back(Entry);
+            }
+
+            ChunkOffset += StaticCast<size_t>(Header.ChunkSize);
+        }
+
+        // Records are applied in the journal order, so the latest record for every hash wins:
+        // a removal hides all previous records, and a later record replaces the removal.
+        // Loaded entries are not pending as they are already in the journal.
+        for (const BytecodeCacheIndexEntry& Entry : Entries)
+        {
+            if (Entry.Offset == RemovedOffset)
+                RemoveBytecode(Entry.Hash);
+            else
+                m_HashMap[Entry.Hash] = CreateBytecodeView(pDataBlob, Entry.Offset, Entry.Size);
+            m_PendingHashes.erase(Entry.Hash);
+        }
+
+        return true;
+    }
+
 private:
     RENDER_DEVICE_TYPE m_DeviceType;
 
+    // Protects all members below
+    std::shared_mutex m_Mtx;
+
+    // Bytecodes that were added or removed after the data was loaded, as well as bytecodes loaded from the journal.
+    // Null bytecode hides the loaded entry with the same hash.
     std::unordered_map<XXH128Hash, RefCntAutoPtr<IDataBlob>> m_HashMap;
+
+    // Loaded data and its index sorted by hash
+    RefCntAutoPtr<IDataBlob>             m_pLoadedData;
+    std::vector<BytecodeCacheIndexEntry> m_LoadedIndex;
+
+    // Hashes of the bytecodes that were added or removed since the last Store or StoreIncremental
+    std::unordered_set<XXH128Hash> m_PendingHashes;
 };
 
 void CreateBytecodeCache(const BytecodeCacheCreateInfo& CreateInfo,
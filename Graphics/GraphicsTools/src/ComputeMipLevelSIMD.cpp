@@ -0,0 +1,617 @@
+/*
+ *  Copyright 2019-2025 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "ComputeMipLevelSIMD.hpp"
+
+#include <array>
+
+#include "Intrinsics.hpp"
+#include "ColorConversion.h"
+
+#if DILIGENT_AVX2_SUPPORTED && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#    define DILIGENT_SSE2_ENABLED 1
+#endif
+
+#if DILIGENT_AVX2_SUPPORTED && defined(_MSC_VER)
+#    include <intrin.h>
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#    include <arm_neon.h>
+#    define DILIGENT_NEON_ENABLED 1
+#endif
+
+// AVX2 kernels are compiled for the specific target and are only called when the CPU supports them.
+// FMA is intentionally not enabled so that the compiler does not contract multiplications and additions,
+// which would break bit-exactness with the scalar code.
+#if DILIGENT_AVX2_SUPPORTED
+#    if defined(__GNUC__) || defined(__clang__)
+#        define DILIGENT_TARGET_AVX2      __attribute__((target("avx2")))
+#        define DILIGENT_TARGET_AVX2_F16C __attribute__((target("avx2,f16c")))
+#    else
+#        define DILIGENT_TARGET_AVX2
+#        define DILIGENT_TARGET_AVX2_F16C
+#    endif
+#endif
+
+namespace Diligent
+{
+
+namespace
+{
+
+struct CPUFeatures
+{
+    bool AVX2 = false;
+    bool F16C = false;
+};
+
+CPUFeatures DetectCPUFeatures()
+{
+    CPUFeatures Features;
+#if DILIGENT_AVX2_SUPPORTED
+#    if defined(_MSC_VER)
+    int Info[4] = {};
+    __cpuid(Info, 0);
+    const int MaxLeaf = Info[0];
+
+    __cpuid(Info, 1);
+    const bool OSXSave = (Info[2] & (1 << 27)) != 0;
+    const bool AVX     = (Info[2] & (1 << 28)) != 0;
+    const bool F16C    = (Info[2] & (1 << 29)) != 0;
+
+    // Check that the OS saves YMM registers on context switch
+    const bool YMMEnabled = OSXSave && (_xgetbv(0) & 0x6) == 0x6;
+
+    bool AVX2 = false;
+    if (MaxLeaf >= 7)
+    {
+        __cpuidex(Info, 7, 0);
+        AVX2 = (Info[1] & (1 << 5)) != 0;
+    }
+
+    Features.AVX2 = YMMEnabled && AVX && AVX2;
+    Features.F16C = YMMEnabled && AVX && F16C;
+#    else
+    __builtin_cpu_init();
+    Features.AVX2 = __builtin_cpu_supports("avx2") != 0;
+    Features.F16C = __builtin_cpu_supports("f16c") != 0;
+#    endif
+#endif
+    return Features;
+}
+
+const CPUFeatures& GetCPUFeatures()
+{
+    static const CPUFeatures Features = DetectCPUFeatures();
+    return Features;
+}
+
+// Table of FastGammaToLinear values for all 8-bit sRGB values, computed exactly as in the scalar code.
+const float* GetSRGBToLinearTable()
+{
+    static const std::array<float, 256> Table = []() {
+        std::array<float, 256> Values{};
+        for (size_t i = 0; i < Values.size(); ++i)
+            Values[i] = FastGammaToLinear(static_cast<float>(i) * (1.f / 255.f));
+        return Values;
+    }();
+    return Table.data();
+}
+
+#if DILIGENT_SSE2_ENABLED
+
+// Averages four sets of four RGBA8 texels
+inline __m128i BoxAverageRGBA8_SSE2(__m128i Even0, __m128i Odd0, __m128i Even1, __m128i Odd1)
+{
+    const __m128i Zero = _mm_setzero_si128();
+
+    __m128i Lo = _mm_add_epi16(_mm_add_epi16(_mm_unpacklo_epi8(Even0, Zero), _mm_unpacklo_epi8(Odd0, Zero)),
+                               _mm_add_epi16(_mm_unpacklo_epi8(Even1, Zero), _mm_unpacklo_epi8(Odd1, Zero)));
+    __m128i Hi = _mm_add_epi16(_mm_add_epi16(_mm_unpackhi_epi8(Even0, Zero), _mm_unpackhi_epi8(Odd0, Zero)),
+                               _mm_add_epi16(_mm_unpackhi_epi8(Even1, Zero), _mm_unpackhi_epi8(Odd1, Zero)));
+    return _mm_packus_epi16(_mm_srli_epi16(Lo, 2), _mm_srli_epi16(Hi, 2));
+}
+
+Uint32 BoxFilterRowRGBA8_SSE2(const void* pFineRow0, const void* pFineRow1, void* pCoarseRow, Uint32 CoarseWidth)
+{
+    const Uint8* pSrc0 = static_cast<const Uint8*>(pFineRow0);
+    const Uint8* pSrc1 = static_cast<const Uint8*>(pFineRow1);
+    Uint8*       pDst  = static_cast<Uint8*>(pCoarseRow);
+
+    Uint32 col = 0;
+    for (; col + 4 <= CoarseWidth; col += 4)
+    {
+        const __m128 Row0A = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc0 + col * 8)));
+        const __m128 Row0B = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc0 + col * 8 + 16)));
+        const __m128 Row1A = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc1 + col * 8)));
+        const __m128 Row1B = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc1 + col * 8 + 16)));
+
+        // Separate even and odd texels
+        const __m128i Even0 = _mm_castps_si128(_mm_shuffle_ps(Row0A, Row0B, _MM_SHUFFLE(2, 0, 2, 0)));
+        const __m128i Odd0  = _mm_castps_si128(_mm_shuffle_ps(Row0A, Row0B, _MM_SHUFFLE(3, 1, 3, 1)));
+        const __m128i Even1 = _mm_castps_si128(_mm_shuffle_ps(Row1A, Row1B, _MM_SHUFFLE(2, 0, 2, 0)));
+        const __m128i Odd1  = _mm_castps_si128(_mm_shuffle_ps(Row1A, Row1B, _MM_SHUFFLE(3, 1, 3, 1)));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + col * 4), BoxAverageRGBA8_SSE2(Even0, Odd0, Even1, Odd1));
+    }
+    return col;
+}
+
+// Vectorized FastLinearToGamma(x) * 255 clamped to [0, 255] and truncated to integer
+inline __m128i LinearToSRGB8_SSE2(__m128 Linear)
+{
+    const __m128 AbsMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+
+    const __m128 LinearSegment = _mm_mul_ps(_mm_set1_ps(12.92f), Linear);
+    const __m128 PowerSegment  = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(_mm_set1_ps(1.13005f), _mm_sqrt_ps(_mm_and_ps(_mm_sub_ps(Linear, _mm_set1_ps(0.00228f)), AbsMask))),
+                                                      _mm_mul_ps(_mm_set1_ps(0.13448f), Linear)),
+                                           _mm_set1_ps(0.005719f));
+
+    const __m128 IsLinear = _mm_cmplt_ps(Linear, _mm_set1_ps(0.0031308f));
+    __m128       Gamma    = _mm_or_ps(_mm_and_ps(IsLinear, LinearSegment), _mm_andnot_ps(IsLinear, PowerSegment));
+
+    Gamma = _mm_mul_ps(Gamma, _mm_set1_ps(255.f));
+    Gamma = _mm_min_ps(_mm_max_ps(Gamma, _mm_setzero_ps()), _mm_set1_ps(255.f));
+    return _mm_cvttps_epi32(Gamma);
+}
+
+Uint32 SRGBBoxFilterRowRGBA8_SSE2(const void* pFineRow0, const void* pFineRow1, void* pCoarseRow, Uint32 CoarseWidth)
+{
+    const Uint8* pSrc0 = static_cast<const Uint8*>(pFineRow0);
+    const Uint8* pSrc1 = static_cast<const Uint8*>(pFineRow1);
+    Uint8*       pDst  = static_cast<Uint8*>(pCoarseRow);
+
+    const float* LUT = GetSRGBToLinearTable();
+
+    const auto LoadLinear = [LUT](const Uint8* pTexel) {
+        return _mm_setr_ps(LUT[pTexel[0]], LUT[pTexel[1]], LUT[pTexel[2]], LUT[pTexel[3]]);
+    };
+
+    for (Uint32 col = 0; col < CoarseWidth; ++col)
+    {
+        __m128 Sum = _mm_add_ps(LoadLinear(pSrc0 + col * 8), LoadLinear(pSrc0 + col * 8 + 4));
+        Sum        = _mm_add_ps(Sum, LoadLinear(pSrc1 + col * 8));
+        Sum        = _mm_add_ps(Sum, LoadLinear(pSrc1 + col * 8 + 4));
+
+        __m128i Res = LinearToSRGB8_SSE2(_mm_mul_ps(Sum, _mm_set1_ps(0.25f)));
+        Res         = _mm_packs_epi32(Res, Res);
+        Res         = _mm_packus_epi16(Res, Res);
+
+        const int Texel = _mm_cvtsi128_si32(Res);
+        memcpy(pDst + col * 4, &Texel, 4);
+    }
+    return CoarseWidth;
+}
+
+Uint32 BoxFilterRowRGBA32F_SSE2(const void* pFineRow0, const void* pFineRow1, void* pCoarseRow, Uint32 CoarseWidth)
+{
+    const float* pSrc0 = static_cast<const float*>(pFineRow0);
+    const float* pSrc1 = static_cast<const float*>(pFineRow1);
+    float*       pDst  = static_cast<float*>(pCoarseRow);
+
+    for (Uint32 col = 0; col < CoarseWidth; ++col)
+    {
+        __m128 Sum = _mm_add_ps(_mm_loadu_ps(pSrc0 + col * 8), _mm_loadu_ps(pSrc0 + col * 8 + 4));
+        Sum        = _mm_add_ps(Sum, _mm_loadu_ps(pSrc1 + col * 8));
+        Sum        = _mm_add_ps(Sum, _mm_loadu_ps(pSrc1 + col * 8 + 4));
+        _mm_storeu_ps(pDst + col * 4, _mm_mul_ps(Sum, _mm_set1_ps(0.25f)));
+    }
+    return CoarseWidth;
+}
+
+Uint32 AlphaRemapRowRGBA8_SSE2(Uint8* pRow, Uint32 Width, float AlphaCutoff)
+{
+    const __m128  Offset    = _mm_set1_ps(2.f * (AlphaCutoff * 255.f));
+    const __m128  Three     = _mm_set1_ps(3.f);
+    const __m128  MaxAlpha  = _mm_set1_ps(255.f);
+    const __m128i ColorMask = _mm_set1_epi32(0x00FFFFFF);
+
+    Uint32 col = 0;
+    for (; col + 4 <= Width; col += 4)
+    {
+        __m128i Texels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pRow + col * 4));
+
+        const __m128i Alpha    = _mm_srli_epi32(Texels, 24);
+        const __m128  AlphaNew = _mm_min_ps(_mm_div_ps(_mm_add_ps(_mm_cvtepi32_ps(Alpha), Offset), Three), MaxAlpha);
+
+        // Both values are in [0, 255] range, so 16-bit max works for 32-bit lanes
+        const __m128i Remapped = _mm_max_epi16(Alpha, _mm_cvttps_epi32(AlphaNew));
+
+        Texels = _mm_or_si128(_mm_and_si128(Texels, ColorMask), _mm_slli_epi32(Remapped, 24));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pRow + col * 4), Texels);
+    }
+    return col;
+}
+
+#endif // DILIGENT_SSE2_ENABLED
+
+
+#if DILIGENT_AVX2_SUPPORTED
+
+DILIGENT_TARGET_AVX2 Uint32 BoxFilterRowRGBA8_AVX2(const void* pFineRow0, const void* pFineRow1, void* pCoarseRow, Uint32 CoarseWidth)
+{
+    const Uint8* pSrc0 = static_cast<const Uint8*>(pFineRow0);
+    const Uint8* pSrc1 = static_cast<const Uint8*>(pFineRow1);
+    Uint8*       pDst  = static_cast<Uint8*>(pCoarseRow);
+
+    const __m256i Zero = _mm256_setzero_si256();
+
+    Uint32 col = 0;
+    for (; col + 8 <= CoarseWidth; col += 8)
+    {
+        const __m256 Row0A = _mm256_castsi256_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pSrc0 + col * 8)));
+        const __m256 Row0B = _mm256_castsi256_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pSrc0 + col * 8 + 32)));
+        const __m256 Row1A = _mm256_castsi256_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pSrc1 + col * 8)));
+        const __m256 Row1B = _mm256_castsi256_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pSrc1 + col * 8 + 32)));
+
+        // Shuffles work within 128-bit lanes, so the texels are separated as follows:
+        //   Even: | 0  2  8 10 | 4  6 12 14 |
+        //   Odd:  | 1  3  9 11 | 5  7 13 15 |
+        const __m256i Even0 = _mm256_castps_si256(_mm256_shuffle_ps(Row0A, Row0B, _MM_SHUFFLE(2, 0, 2, 0)));
+        const __m256i Odd0  = _mm256_castps_si256(_mm256_shuffle_ps(Row0A, Row0B, _MM_SHUFFLE(3, 1, 3, 1)));
+        const __m256i Even1 = _mm256_castps_si256(_mm256_shuffle_ps(Row1A, Row1B, _MM_SHUFFLE(2, 0, 2, 0)));
+        const __m256i Odd1  = _mm256_castps_si256(_mm256_shuffle_ps(Row1A, Row1B, _MM_SHUFFLE(3, 1, 3, 1)));
+
+        __m256i Lo = _mm256_add_epi16(_mm256_add_epi16(_mm256_unpacklo_epi8(Even0, Zero), _mm256_unpacklo_epi8(Odd0, Zero)),
+                                      _mm256_add_epi16(_mm256_unpacklo_epi8(Even1, Zero), _mm256_unpacklo_epi8(Odd1, Zero)));
+        __m256i Hi = _mm256_add_epi16(_mm256_add_epi16(_mm256_unpackhi_epi8(Even0, Zero), _mm256_unpackhi_epi8(Odd0, Zero)),
+                                      _mm256_add_epi16(_mm256_unpackhi_epi8(Even1, Zero), _mm256_unpackhi_epi8(Odd1, Zero)));
+
+        // Coarse texels are in the following order: | 0 1 4 5 | 2 3 6 7 |
+        __m256i Res = _mm256_packus_epi16(_mm256_srli_epi16(Lo, 2), _mm256_srli_epi16(Hi, 2));
+        Res         = _mm256_permute4x64_epi64(Res, _MM_SHUFFLE(3, 1, 2, 0));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pDst + col * 4), Res);
+    }
+    return col;
+}
+
+DILIGENT_TARGET_AVX2 Uint32 SRGBBoxFilterRowRGBA8_AVX2(const void* pFineRow0, const void* pFineRow1, void* pCoarseRow, Uint32 CoarseWidth)
+{
+    const Uint8* pSrc0 = static_cast<const Uint8*>(pFineRow0);
+    const Uint8* pSrc1 = static_cast<const Uint8*>(pFineRow1);
+    Uint8*       pDst  = static_cast<Uint8*>(pCoarseRow);
+
+    const float* LUT = GetSRGBToLinearTable();
+
+    const __m256 AbsMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+
+    Uint32 col = 0;
+    for (; col + 2 <= CoarseWidth; col += 2)
+    {
+        // Four fine texels from every row
+        const __m128 Row0 = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc0 + col * 8)));
+        const __m128 Row1 = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc1 + col * 8)));
+
+        const __m128i Even0 = _mm_castps_si128(_mm_shuffle_ps(Row0, Row0, _MM_SHUFFLE(2, 0, 2, 0)));
+        const __m128i Odd0  = _mm_castps_si128(_mm_shuffle_ps(Row0, Row0, _MM_SHUFFLE(3, 1, 3, 1)));
+        const __m128i Even1 = _mm_castps_si128(_mm_shuffle_ps(Row1, Row1, _MM_SHUFFLE(2, 0, 2, 0)));
+        const __m128i Odd1  = _mm_castps_si128(_mm_shuffle_ps(Row1, Row1, _MM_SHUFFLE(3, 1, 3, 1)));
+
+        __m256 Sum = _mm256_add_ps(_mm256_i32gather_ps(LUT, _mm256_cvtepu8_epi32(Even0), 4),
+                                   _mm256_i32gather_ps(LUT, _mm256_cvtepu8_epi32(Odd0), 4));
+        Sum        = _mm256_add_ps(Sum, _mm256_i32gather_ps(LUT, _mm256_cvtepu8_epi32(Even1), 4));
+        Sum        = _mm256_add_ps(Sum, _mm256_i32gather_ps(LUT, _mm256_cvtepu8_epi32(Odd1), 4));
+
+        const __m256 Linear = _mm256_mul_ps(Sum, _mm256_set1_ps(0.25f));
+
+        // FastLinearToGamma
+        const __m256 LinearSegment = _mm256_mul_ps(_mm256_set1_ps(12.92f), Linear);
+        const __m256 PowerSegment  = _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(_mm256_set1_ps(1.13005f), _mm256_sqrt_ps(_mm256_and_ps(_mm256_sub_ps(Linear, _mm256_set1_ps(0.00228f)), AbsMask))),
+                                                                _mm256_mul_ps(_mm256_set1_ps(0.13448f), Linear)),
+                                                  _mm256_set1_ps(0.005719f));
+
+        __m256 Gamma = _mm256_blendv_ps(PowerSegment, LinearSegment, _mm256_cmp_ps(Linear, _mm256_set1_ps(0.0031308f), _CMP_LT_OQ));
+        Gamma        = _mm256_mul_ps(Gamma, _mm256_set1_ps(255.f));
+        Gamma        = _mm256_min_ps(_mm256_max_ps(Gamma, _mm256_setzero_ps()), _mm256_set1_ps(255.f));
+
+        const __m256i Res    = _mm256_cvttps_epi32(Gamma);
+        __m128i       Packed = _mm_packus_epi32(_mm256_castsi256_si128(Res), _mm256_extracti128_si256(Res, 1));
+        Packed               = _mm_packus_epi16(Packed, Packed);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(pDst + col * 4), Packed);
+    }
+    return col;
+}
+
+DILIGENT_TARGET_AVX2 Uint32 BoxFilterRowRGBA32F_AVX2(const void* pFineRow0, const void* pFineRow1, void* pCoarseRow, Uint32 CoarseWidth)
+{
+    const float* pSrc0 = static_cast<const float*>(pFineRow0);
+    const float* pSrc1 = static_cast<const float*>(pFineRow1);
+    float*       pDst  = static_cast<float*>(pCoarseRow);
+
+    Uint32 col = 0;
+    for (; col + 2 <= CoarseWidth; col += 2)
+    {
+        const __m256 Row0A = _mm256_loadu_ps(pSrc0 + col * 8);
+        const __m256 Row0B = _mm256_loadu_ps(pSrc0 + col * 8 + 8);
+        const __m256 Row1A = _mm256_loadu_ps(pSrc1 + col * 8);
+        const __m256 Row1B = _mm256_loadu_ps(pSrc1 + col * 8 + 8);
+
+        // | 0 1 | 2 3 | -> | 0 2 |, | 1 3 |
+        __m256 Sum = _mm256_add_ps(_mm256_permute2f128_ps(Row0A, Row0B, 0x20), _mm256_permute2f128_ps(Row0A, Row0B, 0x31));
+        Sum        = _mm256_add_ps(Sum, _mm256_permute2f128_ps(Row1A, Row1B, 0x20));
+        Sum        = _mm256_add_ps(Sum, _mm256_permute2f128_ps(Row1A, Row1B, 0x31));
+        _mm256_storeu_ps(pDst + col * 4, _mm256_mul_ps(Sum, _mm256_set1_ps(0.25f)));
+    }
+    return col;
+}
+
+DILIGENT_TARGET_AVX2_F16C Uint32 BoxFilterRowRGBA16F_AVX2(const void* pFineRow0, const void* pFineRow1, void* pCoarseRow, Uint32 CoarseWidth)
+{
+    const Uint16* pSrc0 = static_cast<const Uint16*>(pFineRow0);
+    const Uint16* pSrc1 = static_cast<const Uint16*>(pFineRow1);
+    Uint16*       pDst  = static_cast<Uint16*>(pCoarseRow);
+
+    Uint32 col = 0;
+    for (; col + 2 <= CoarseWidth; col += 2)
+    {
+        const __m256 Row0A = _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc0 + col * 8)));
+        const __m256 Row0B = _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc0 + col * 8 + 8)));
+        const __m256 Row1A = _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc1 + col * 8)));
+        const __m256 Row1B = _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc1 + col * 8 + 8)));
+
+        __m256 Sum = _mm256_add_ps(_mm256_permute2f128_ps(Row0A, Row0B, 0x20), _mm256_permute2f128_ps(Row0A, Row0B, 0x31));
+        Sum        = _mm256_add_ps(Sum, _mm256_permute2f128_ps(Row1A, Row1B, 0x20));
+        Sum        = _mm256_add_ps(Sum, _mm256_permute2f128_ps(Row1A, Row1B, 0x31));
+
+        const __m128i Res = _mm256_cvtps_ph(_mm256_mul_ps(Sum, _mm256_set1_ps(0.25f)), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + col * 4), Res);
+    }
+    return col;
+}
+
+DILIGENT_TARGET_AVX2_F16C Uint32 BoxFilterRowR16F_AVX2(const void* pFineRow0, const void* pFineRow1, void* pCoarseRow, Uint32 CoarseWidth)
+{
+    const Uint16* pSrc0 = static_cast<const Uint16*>(pFineRow0);
+    const Uint16* pSrc1 = static_cast<const Uint16*>(pFineRow1);
+    Uint16*       pDst  = static_cast<Uint16*>(pCoarseRow);
+
+    Uint32 col = 0;
+    for (; col + 8 <= CoarseWidth; col += 8)
+    {
+        const __m256 Row0A = _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc0 + col * 2)));
+        const __m256 Row0B = _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc0 + col * 2 + 8)));
+        const __m256 Row1A = _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc1 + col * 2)));
+        const __m256 Row1B = _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc1 + col * 2 + 8)));
+
+        __m256 Sum = _mm256_add_ps(_mm256_shuffle_ps(Row0A, Row0B, _MM_SHUFFLE(2, 0, 2, 0)), _mm256_shuffle_ps(Row0A, Row0B, _MM_SHUFFLE(3, 1, 3, 1)));
+        Sum        = _mm256_add_ps(Sum, _mm256_shuffle_ps(Row1A, Row1B, _MM_SHUFFLE(2, 0, 2, 0)));
+        Sum        = _mm256_add_ps(Sum, _mm256_shuffle_ps(Row1A, Row1B, _MM_SHUFFLE(3, 1, 3, 1)));
+        Sum        = _mm256_mul_ps(Sum, _mm256_set1_ps(0.25f));
+
+        // Coarse texels are in the following order: | 0 1 4 5 | 2 3 6 7 |
+        Sum = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(Sum), _MM_SHUFFLE(3, 1, 2, 0)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + col), _mm256_cvtps_ph(Sum, _MM_FROUND_TO_NEAREST_INT));
+    }
+    return col;
+}
+
+#endif // DILIGENT_AVX2_SUPPORTED
+
+
+#if DILIGENT_NEON_ENABLED
+
+Uint32 BoxFilterRowRGBA8_NEON(const void* pFineRow0, const void* pFineRow1, void* pCoarseRow, Uint32 CoarseWidth)
+{
+    const Uint8* pSrc0 = static_cast<const Uint8*>(pFineRow0);
+    const Uint8* pSrc1 = static_cast<const Uint8*>(pFineRow1);
+    Uint8*       pDst  = static_cast<Uint8*>(pCoarseRow);
+
+    Uint32 col = 0;
+    for (; col + 4 <= CoarseWidth; col += 4)
+    {
+        // De-interleaving load separates even and odd texels
+        const uint32x4x2_t Row0 = vld2q_u32(reinterpret_cast<const uint32_t*>(pSrc0 + col * 8));
+        const uint32x4x2_t Row1 = vld2q_u32(reinterpret_cast<const uint32_t*>(pSrc1 + col * 8));
+
+        const uint8x16_t Even0 = vreinterpretq_u8_u32(Row0.val[0]);
+        const uint8x16_t Odd0  = vreinterpretq_u8_u32(Row0.val[1]);
+        const uint8x16_t Even1 = vreinterpretq_u8_u32(Row1.val[0]);
+        const uint8x16_t Odd1  = vreinterpretq_u8_u32(Row1.val[1]);
+
+        const uint16x8_t Lo = vaddq_u16(vaddl_u8(vget_low_u8(Even0), vget_low_u8(Odd0)), vaddl_u8(vget_low_u8(Even1), vget_low_u8(Odd1)));
+        const uint16x8_t Hi = vaddq_u16(vaddl_u8(vget_high_u8(Even0), vget_high_u8(Odd0)), vaddl_u8(vget_high_u8(Even1), vget_high_u8(Odd1)));
+
+        vst1q_u8(pDst + col * 4, vcombine_u8(vshrn_n_u16(Lo, 2), vshrn_n_u16(Hi, 2)));
+    }
+    return col;
+}
+
+Uint32 BoxFilterRowRGBA32F_NEON(const void* pFineRow0, const void* pFineRow1, void* pCoarseRow, Uint32 CoarseWidth)
+{
+    const float* pSrc0 = static_cast<const float*>(pFineRow0);
+    const float* pSrc1 = static_cast<const float*>(pFineRow1);
+    float*       pDst  = static_cast<float*>(pCoarseRow);
+
+    for (Uint32 col = 0; col < CoarseWidth; ++col)
+    {
+        float32x4_t Sum = vaddq_f32(vld1q_f32(pSrc0 + col * 8), vld1q_f32(pSrc0 + col * 8 + 4));
+        Sum             = vaddq_f32(Sum, vld1q_f32(pSrc1 + col * 8));
+        Sum             = vaddq_f32(Sum, vld1q_f32(pSrc1 + col * 8 + 4));
+        vst1q_f32(pDst + col * 4, vmulq_n_f32(Sum, 0.25f));
+    }
+    return CoarseWidth;
+}
+
+inline float32x4_t LoadFloat16x4_NEON(const Uint16* pData)
+{
+    return vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(pData)));
+}
+
+Uint32 BoxFilterRowRGBA16F_NEON(const void* pFineRow0, const void* pFineRow1, void* pCoarseRow, Uint32 CoarseWidth)
+{
+    const Uint16* pSrc0 = static_cast<const Uint16*>(pFineRow0);
+    const Uint16* pSrc1 = static_cast<const Uint16*>(pFineRow1);
+    Uint16*       pDst  = static_cast<Uint16*>(pCoarseRow);
+
+    for (Uint32 col = 0; col < CoarseWidth; ++col)
+    {
+        float32x4_t Sum = vaddq_f32(LoadFloat16x4_NEON(pSrc0 + col * 8), LoadFloat16x4_NEON(pSrc0 + col * 8 + 4));
+        Sum             = vaddq_f32(Sum, LoadFloat16x4_NEON(pSrc1 + col * 8));
+        Sum             = vaddq_f32(Sum, LoadFloat16x4_NEON(pSrc1 + col * 8 + 4));
+        vst1_u16(pDst + col * 4, vreinterpret_u16_f16(vcvt_f16_f32(vmulq_n_f32(Sum, 0.25f))));
+    }
+    return CoarseWidth;
+}
+
+Uint32 BoxFilterRowR16F_NEON(const void* pFineRow0, const void* pFineRow1, void* pCoarseRow, Uint32 CoarseWidth)
+{
+    const Uint16* pSrc0 = static_cast<const Uint16*>(pFineRow0);
+    const Uint16* pSrc1 = static_cast<const Uint16*>(pFineRow1);
+    Uint16*       pDst  = static_cast<Uint16*>(pCoarseRow);
+
+    Uint32 col = 0;
+    for (; col + 4 <= CoarseWidth; col += 4)
+    {
+        const uint16x4x2_t Row0 = vld2_u16(pSrc0 + col * 2);
+        const uint16x4x2_t Row1 = vld2_u16(pSrc1 + col * 2);
+
+        float32x4_t Sum = vaddq_f32(vcvt_f32_f16(vreinterpret_f16_u16(Row0.val[0])), vcvt_f32_f16(vreinterpret_f16_u16(Row0.val[1])));
+        Sum             = vaddq_f32(Sum, vcvt_f32_f16(vreinterpret_f16_u16(Row1.val[0])));
+        Sum             = vaddq_f32(Sum, vcvt_f32_f16(vreinterpret_f16_u16(Row1.val[1])));
+        vst1_u16(pDst + col, vreinterpret_u16_f16(vcvt_f16_f32(vmulq_n_f32(Sum, 0.25f))));
+    }
+    return col;
+}
+
+Uint32 AlphaRemapRowRGBA8_NEON(Uint8* pRow, Uint32 Width, float AlphaCutoff)
+{
+    const float32x4_t Offset    = vdupq_n_f32(2.f * (AlphaCutoff * 255.f));
+    const float32x4_t Three     = vdupq_n_f32(3.f);
+    const float32x4_t MaxAlpha  = vdupq_n_f32(255.f);
+    const uint32x4_t  ColorMask = vdupq_n_u32(0x00FFFFFFu);
+
+    Uint32 col = 0;
+    for (; col + 4 <= Width; col += 4)
+    {
+        uint32x4_t Texels = vreinterpretq_u32_u8(vld1q_u8(pRow + col * 4));
+
+        const uint32x4_t  Alpha    = vshrq_n_u32(Texels, 24);
+        const float32x4_t AlphaNew = vminq_f32(vdivq_f32(vaddq_f32(vcvtq_f32_u32(Alpha), Offset), Three), MaxAlpha);
+        const uint32x4_t  Remapped = vmaxq_u32(Alpha, vcvtq_u32_f32(AlphaNew));
+
+        Texels = vorrq_u32(vandq_u32(Texels, ColorMask), vshlq_n_u32(Remapped, 24));
+        vst1q_u8(pRow + col * 4, vreinterpretq_u8_u32(Texels));
+    }
+    return col;
+}
+
+#endif // DILIGENT_NEON_ENABLED
+
+} // namespace
+
+MipRowFilterKernelType GetMipRowBoxFilterKernel(const TextureFormatAttribs& FmtAttribs)
+{
+    const CPUFeatures& Features = GetCPUFeatures();
+    (void)Features;
+
+    switch (FmtAttribs.ComponentType)
+    {
+        case COMPONENT_TYPE_UNORM:
+        case COMPONENT_TYPE_UINT:
+            if (FmtAttribs.NumComponents == 4 && FmtAttribs.ComponentSize == 1)
+            {
+#if DILIGENT_AVX2_SUPPORTED
+                if (Features.AVX2)
+                    return BoxFilterRowRGBA8_AVX2;
+#endif
+#if DILIGENT_SSE2_ENABLED
+                return BoxFilterRowRGBA8_SSE2;
+#elif DILIGENT_NEON_ENABLED
+                return BoxFilterRowRGBA8_NEON;
+#endif
+            }
+            break;
+
+        case COMPONENT_TYPE_UNORM_SRGB:
+            // There is no NEON version as the compiler may contract the scalar
+            // FastLinearToGamma into fused multiply-add instructions.
+            if (FmtAttribs.NumComponents == 4 && FmtAttribs.ComponentSize == 1)
+            {
+#if DILIGENT_AVX2_SUPPORTED
+                if (Features.AVX2)
+                    return SRGBBoxFilterRowRGBA8_AVX2;
+#endif
+#if DILIGENT_SSE2_ENABLED
+                return SRGBBoxFilterRowRGBA8_SSE2;
+#endif
+            }
+            break;
+
+        case COMPONENT_TYPE_FLOAT:
+            if (FmtAttribs.NumComponents == 4 && FmtAttribs.ComponentSize == 4)
+            {
+#if DILIGENT_AVX2_SUPPORTED
+                if (Features.AVX2)
+                    return BoxFilterRowRGBA32F_AVX2;
+#endif
+#if DILIGENT_SSE2_ENABLED
+                return BoxFilterRowRGBA32F_SSE2;
+#elif DILIGENT_NEON_ENABLED
+                return BoxFilterRowRGBA32F_NEON;
+#endif
+            }
+            else if (FmtAttribs.NumComponents == 4 && FmtAttribs.ComponentSize == 2)
+            {
+#if DILIGENT_AVX2_SUPPORTED
+                if (Features.AVX2 && Features.F16C)
+                    return BoxFilterRowRGBA16F_AVX2;
+#elif DILIGENT_NEON_ENABLED
+                return BoxFilterRowRGBA16F_NEON;
+#endif
+            }
+            else if (FmtAttribs.NumComponents == 1 && FmtAttribs.ComponentSize == 2)
+            {
+#if DILIGENT_AVX2_SUPPORTED
+                if (Features.AVX2 && Features.F16C)
+                    return BoxFilterRowR16F_AVX2;
+#elif DILIGENT_NEON_ENABLED
+                return BoxFilterRowR16F_NEON;
+#endif
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    return nullptr;
+}
+
+AlphaRemapRowKernelType GetAlphaRemapRowKernel()
+{
+#if DILIGENT_SSE2_ENABLED
+    return AlphaRemapRowRGBA8_SSE2;
+#elif DILIGENT_NEON_ENABLED
+    return AlphaRemapRowRGBA8_NEON;
+#else
+    return nullptr;
+#endif
+}
+
+} // namespace Diligent
@@ -35,6 +35,9 @@
 #include "GraphicsAccessories.hpp"
 #include "ColorConversion.h"
 #include "RefCntAutoPtr.hpp"
+#include "ThreadPool.hpp"
+#include "Align.hpp"
+#include "ComputeMipLevelSIMD.hpp"
 
 #define PI_F 3.1415926f
 
@@ -238,6 +241,12 @@ float LinearAverage<float>(float c0, float c1, float c2, float c3, Uint32 /*col*
     return (c0 + c1 + c2 + c3) * 0.25f;
 }
 
+// Half-precision floating-point channels are filtered as raw 16-bit values
+Uint16 Float16Average(Uint16 c0, Uint16 c1, Uint16 c2, Uint16 c3, Uint32 /*col*/, Uint32 /*row*/)
+{
+    return Float32ToFloat16((Float16ToFloat32(c0) + Float16ToFloat32(c1) + Float16ToFloat32(c2) + Float16ToFloat32(c3)) * 0.25f);
+}
+
 
 template <typename ChannelType>
 ChannelType MostFrequentSelector(ChannelType c0, ChannelType c1, ChannelType c2, ChannelType c3, Uint32 col, Uint32 row)
@@ -323,7 +332,8 @@ template <typename ChannelType,
           typename FilterType>
 void FilterMipLevel(const ComputeMipLevelAttribs& Attribs,
                     Uint32                        NumChannels,
-                    FilterType                    Filter)
+                    FilterType                    Filter,
+                    MipRowFilterKernelType        RowKernel = nullptr)
 {
     VERIFY_EXPR(Attribs.FineMipWidth > 0 && Attribs.FineMipHeight > 0);
     DEV_CHECK_ERR(Attribs.FineMipHeight == 1 || Attribs.FineMipStride >= Attribs.FineMipWidth * sizeof(ChannelType) * NumChannels, "Fine mip level stride is too small");
@@ -341,7 +351,13 @@ void FilterMipLevel(const ComputeMipLevelAttribs& Attribs,
         const ChannelType* pSrcRow0 = reinterpret_cast<const ChannelType*>(reinterpret_cast<const Uint8*>(Attribs.pFineMipData) + src_row0 * Attribs.FineMipStride);
         const ChannelType* pSrcRow1 = reinterpret_cast<const ChannelType*>(reinterpret_cast<const Uint8*>(Attribs.pFineMipData) + src_row1 * Attribs.FineMipStride);
 
-        for (Uint32 col = 0; col < CoarseMipWidth; ++col)
+        // The vectorized kernel processes the beginning of the row, and the remaining texels are filtered below.
+        // Every coarse texel has two fine texels unless the fine mip is one texel wide.
+        Uint32 FirstCol = 0;
+        if (RowKernel != nullptr && Attribs.FineMipWidth > 1)
+            FirstCol = RowKernel(pSrcRow0, pSrcRow1, reinterpret_cast<Uint8*>(Attribs.pCoarseMipData) + row * Attribs.CoarseMipStride, CoarseMipWidth);
+
+        for (Uint32 col = FirstCol; col < CoarseMipWidth; ++col)
         {
             Uint32 src_col0 = col * 2;
             Uint32 src_col1 = std::min(col * 2 + 1, Attribs.FineMipWidth - 1);
@@ -367,9 +383,15 @@ void RemapAlpha(const ComputeMipLevelAttribs& Attribs,
 {
     const Uint32 CoarseMipWidth  = std::max(Attribs.FineMipWidth / Uint32{2}, Uint32{1});
     const Uint32 CoarseMipHeight = std::max(Attribs.FineMipHeight / Uint32{2}, Uint32{1});
+
+    const AlphaRemapRowKernelType RowKernel = Attribs.UseSIMD && NumChannels == 4 && AlphaChannelInd == 3 ? GetAlphaRemapRowKernel() : nullptr;
     for (Uint32 row = 0; row < CoarseMipHeight; ++row)
     {
-        for (Uint32 col = 0; col < CoarseMipWidth; ++col)
+        Uint32 FirstCol = 0;
+        if (RowKernel != nullptr)
+            FirstCol = RowKernel(reinterpret_cast<Uint8*>(Attribs.pCoarseMipData) + row * Attribs.CoarseMipStride, CoarseMipWidth, Attribs.AlphaCutoff);
+
+        for (Uint32 col = FirstCol; col < CoarseMipWidth; ++col)
         {
             Uint8& Alpha = (reinterpret_cast<Uint8*>(Attribs.pCoarseMipData) + row * Attribs.CoarseMipStride)[col * NumChannels + AlphaChannelInd];
 
@@ -386,6 +408,15 @@ void RemapAlpha(const ComputeMipLevelAttribs& Attribs,
     }
 }
 
+MipRowFilterKernelType GetRowFilterKernel(const ComputeMipLevelAttribs& Attribs,
+                                          const TextureFormatAttribs&   FmtAttribs,
+                                          MIP_FILTER_TYPE               FilterType)
+{
+    return Attribs.UseSIMD && FilterType != MIP_FILTER_TYPE_MOST_FREQUENT ?
+        GetMipRowBoxFilterKernel(FmtAttribs) :
+        nullptr;
+}
+
 template <typename ChannelType>
 void ComputeMipLevelInternal(const ComputeMipLevelAttribs& Attribs,
                              const TextureFormatAttribs&   FmtAttribs)
@@ -401,7 +432,8 @@ void ComputeMipLevelInternal(const ComputeMipLevelAttribs& Attribs,
     FilterMipLevel<ChannelType>(Attribs, FmtAttribs.NumComponents,
                                 FilterType == MIP_FILTER_TYPE_BOX_AVERAGE ?
                                     LinearAverage<ChannelType> :
-                                    MostFrequentSelector<ChannelType>);
+                                    MostFrequentSelector<ChannelType>,
+                                GetRowFilterKernel(Attribs, FmtAttribs, FilterType));
 }
 
 void ComputeMipLevel(const ComputeMipLevelAttribs& Attribs)
@@ -418,6 +450,28 @@ void ComputeMipLevel(const ComputeMipLevelAttribs& Attribs)
     VERIFY(Attribs.AlphaCutoff == 0 || FmtAttribs.NumComponents == 4 && FmtAttribs.ComponentSize == 1,
            "Alpha remapping is only supported for 4-channel 8-bit textures");
 
+    const Uint32 CoarseMipWidth  = std::max(Attribs.FineMipWidth / Uint32{2}, Uint32{1});
+    const Uint32 CoarseMipHeight = std::max(Attribs.FineMipHeight / Uint32{2}, Uint32{1});
+    if (Attribs.pThreadPool != nullptr && CoarseMipHeight > 1)
+    {
+        // Split the coarse mip into bands of rows and process every band as a separate mip level.
+        // The number of rows in a band must be a multiple of 4 since the most-frequent
+        // filter selects the pseudo-random element based on the row index modulo 4.
+        constexpr Uint32 MinTexelsPerBand = 16384;
+
+        const Uint32 RowsPerBand = AlignUp(std::max(MinTexelsPerBand / CoarseMipWidth, Uint32{1}), Uint32{4});
+        ParallelFor(Attribs.pThreadPool, 0, CoarseMipHeight, RowsPerBand,
+                    [&](Uint32 FirstRow, Uint32 EndRow) {
+                        ComputeMipLevelAttribs BandAttribs{Attribs};
+                        BandAttribs.pThreadPool    = nullptr;
+                        BandAttribs.FineMipHeight  = (EndRow - FirstRow) * 2;
+                        BandAttribs.pFineMipData   = static_cast<const Uint8*>(Attribs.pFineMipData) + size_t{FirstRow} * 2 * Attribs.FineMipStride;
+                        BandAttribs.pCoarseMipData = static_cast<Uint8*>(Attribs.pCoarseMipData) + size_t{FirstRow} * Attribs.CoarseMipStride;
+                        ComputeMipLevel(BandAttribs);
+                    });
+        return;
+    }
+
     switch (FmtAttribs.ComponentType)
     {
         case COMPONENT_TYPE_UNORM_SRGB:
@@ -425,7 +479,8 @@ void ComputeMipLevel(const ComputeMipLevelAttribs& Attribs)
             FilterMipLevel<Uint8>(Attribs, FmtAttribs.NumComponents,
                                   Attribs.FilterType == MIP_FILTER_TYPE_MOST_FREQUENT ?
                                       MostFrequentSelector<Uint8> :
-                                      SRGBAverage<Uint8>);
+                                      SRGBAverage<Uint8>,
+                                  GetRowFilterKernel(Attribs, FmtAttribs, Attribs.FilterType));
             if (Attribs.AlphaCutoff > 0)
             {
                 RemapAlpha(Attribs, FmtAttribs.NumComponents, FmtAttribs.NumComponents - 1);
@@ -479,8 +534,23 @@ void ComputeMipLevel(const ComputeMipLevelAttribs& Attribs)
             break;
 
         case COMPONENT_TYPE_FLOAT:
-            VERIFY(FmtAttribs.ComponentSize == 4, "Only 32-bit float formats are currently supported");
-            ComputeMipLevelInternal<Float32>(Attribs, FmtAttribs);
+            switch (FmtAttribs.ComponentSize)
+            {
+                case 2:
+                    FilterMipLevel<Uint16>(Attribs, FmtAttribs.NumComponents,
+                                           Attribs.FilterType == MIP_FILTER_TYPE_MOST_FREQUENT ?
+                                               MostFrequentSelector<Uint16> :
+                                               Float16Average,
+                                           GetRowFilterKernel(Attribs, FmtAttribs, Attribs.FilterType));
+                    break;
+
+                case 4:
+                    ComputeMipLevelInternal<Float32>(Attribs, FmtAttribs);
+                    break;
+
+                default:
+                    UNEXPECTED("Unexpected component size (", FmtAttribs.ComponentSize, ") for FLOAT texture format");
+            }
             break;
 
         default:
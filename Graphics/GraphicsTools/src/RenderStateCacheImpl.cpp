@@ -35,6 +35,7 @@
 #include <array>
 #include <mutex>
 #include <vector>
+#include <unordered_set>
 
 #include "Archiver.h"
 #include "Dearchiver.h"
@@ -45,9 +46,11 @@
 #include "SerializationDevice.h"
 #include "SerializedShader.h"
 #include "CallbackWrapper.hpp"
+#include "ThreadPool.hpp"
 #include "GraphicsAccessories.hpp"
 #include "GraphicsUtilities.h"
 #include "ShaderSourceFactoryUtils.hpp"
+#include "ShaderToolsCommon.hpp"
 #include "DXCompiler.hpp"
 
 namespace Diligent
@@ -104,6 +107,7 @@ void RenderStateCacheImpl::Reset()
     m_ReloadableShaders.clear();
     m_Pipelines.clear();
     m_ReloadablePipelines.clear();
+    ClearSourceFileHashes();
 }
 
 RefCntAutoPtr<IShader> RenderStateCacheImpl::FindReloadableShader(IShader* pShader)
@@ -338,11 +342,129 @@ static void HashShaderCIByFileName(XXH128State& Hasher, const ShaderCreateInfo&
     }
 }
 
-bool RenderStateCacheImpl::CreateShaderInternal(const ShaderCreateInfo& ShaderCI,
-                                                IShader**               ppShader)
+void RenderStateCacheImpl::ClearSourceFileHashes()
 {
-    VERIFY_EXPR(ppShader != nullptr && *ppShader == nullptr);
+    std::lock_guard<std::mutex> Guard{m_SourceFileHashesMtx};
+    m_SourceFileHashes.clear();
+}
+
+std::shared_ptr<const RenderStateCacheImpl::SourceFileHashInfo> RenderStateCacheImpl::GetSourceFileHash(IShaderSourceInputStreamFactory* pFactory,
+                                                                                                        const char*                      FilePath) noexcept(false)
+{
+    VERIFY_EXPR(FilePath != nullptr);
+    if (pFactory == nullptr)
+        LOG_ERROR_AND_THROW("Shader source stream factory is null. Unable to load file '", FilePath, "'.");
+
+    {
+        std::lock_guard<std::mutex> Guard{m_SourceFileHashesMtx};
+
+        auto factory_it = m_SourceFileHashes.find(pFactory);
+        if (factory_it != m_SourceFileHashes.end())
+        {
+            // The factory may have been released and another one allocated at the same address
+            if (factory_it->second.pFactory.IsValid())
+            {
+                auto file_it = factory_it->second.Files.find(FilePath);
+                if (file_it != factory_it->second.Files.end())
+                    return file_it->second;
+            }
+            else
+            {
+                m_SourceFileHashes.erase(factory_it);
+            }
+        }
+    }
+
+    // Read the file outside of the lock. If two threads miss the same file, both will
+    // read it and compute the same hash, which is harmless.
+    const ShaderSourceFileData SourceData = ReadShaderSourceFile(nullptr, 0, pFactory, FilePath);
+
+    auto pInfo = std::make_shared<SourceFileHashInfo>();
+    {
+        XXH128State FileHasher;
+        if (SourceData.SourceLength > 0)
+            FileHasher.UpdateStr(SourceData.Source, SourceData.SourceLength);
+        pInfo->Hash = FileHasher.Digest();
+    }
+    if (!FindShaderIncludes(SourceData.Source, SourceData.SourceLength, pInfo->Includes, FilePath))
+        LOG_ERROR_AND_THROW("Failed to parse includes in file '", FilePath, "'.");
+
+    std::lock_guard<std::mutex> Guard{m_SourceFileHashesMtx};
+
+    FactorySourceFileHashes& FactoryHashes = m_SourceFileHashes[pFactory];
+    if (!FactoryHashes.pFactory.IsValid())
+    {
+        FactoryHashes.pFactory = RefCntWeakPtr<IShaderSourceInputStreamFactory>{pFactory};
+        FactoryHashes.Files.clear();
+    }
+    return FactoryHashes.Files.emplace(FilePath, std::move(pInfo)).first->second;
+}
+
+void RenderStateCacheImpl::HashSourceFile(XXH128State&                     Hasher,
+                                          IShaderSourceInputStreamFactory* pFactory,
+                                          const std::string&               FilePath,
+                                          std::unordered_set<std::string>& Visited) noexcept(false)
+{
+    const std::shared_ptr<const SourceFileHashInfo> pInfo = GetSourceFileHash(pFactory, FilePath.c_str());
+
+    // Same as ProcessShaderIncludes: includes are hashed depth-first, each file only once,
+    // and the including file is hashed after all of its includes.
+    for (const std::string& Include : pInfo->Includes)
+    {
+        if (Visited.insert(Include).second)
+            HashSourceFile(Hasher, pFactory, Include, Visited);
+    }
+
+    Hasher.Update(pInfo->Hash.LowPart, pInfo->Hash.HighPart);
+}
+
+void RenderStateCacheImpl::HashShaderCIByContent(XXH128State& Hasher, const ShaderCreateInfo& ShaderCI)
+{
+    if (ShaderCI.Source == nullptr && ShaderCI.FilePath == nullptr)
+    {
+        // Byte code
+        Hasher.Update(ShaderCI);
+        return;
+    }
+
+    ShaderCreateInfo HashCI = ShaderCI;
+    HashCI.FilePath         = nullptr;
+    HashCI.Source           = nullptr;
+    Hasher.Update(HashCI);
+
+    try
+    {
+        std::unordered_set<std::string> Visited;
+        if (ShaderCI.Source != nullptr)
+        {
+            const size_t SourceLength = ShaderCI.SourceLength != 0 ? ShaderCI.SourceLength : strlen(ShaderCI.Source);
+
+            std::vector<std::string> Includes;
+            if (!FindShaderIncludes(ShaderCI.Source, SourceLength, Includes, ShaderCI.Desc.Name))
+                return;
+
+            for (const std::string& Include : Includes)
+            {
+                if (Visited.insert(Include).second)
+                    HashSourceFile(Hasher, ShaderCI.pShaderSourceStreamFactory, Include, Visited);
+            }
+            if (SourceLength > 0)
+                Hasher.UpdateStr(ShaderCI.Source, SourceLength);
+        }
+        else
+        {
+            Visited.emplace(ShaderCI.FilePath);
+            HashSourceFile(Hasher, ShaderCI.pShaderSourceStreamFactory, ShaderCI.FilePath, Visited);
+        }
+    }
+    catch (...)
+    {
+        LOG_ERROR_MESSAGE("Failed to hash the source of shader '", (ShaderCI.Desc.Name != nullptr ? ShaderCI.Desc.Name : ""), "'.");
+    }
+}
 
+XXH128Hash RenderStateCacheImpl::ComputeShaderHash(const ShaderCreateInfo& ShaderCI)
+{
     XXH128State Hasher;
 #ifdef DILIGENT_DEBUG
     constexpr bool IsDebug = true;
@@ -352,7 +474,7 @@ bool RenderStateCacheImpl::CreateShaderInternal(const ShaderCreateInfo& ShaderCI
     ComputeDeviceAttribsHash(Hasher, m_pDevice);
     if (m_CI.FileHashMode == RENDER_STATE_CACHE_FILE_HASH_MODE_BY_CONTENT)
     {
-        Hasher.Update(ShaderCI);
+        HashShaderCIByContent(Hasher, ShaderCI);
     }
     else if (m_CI.FileHashMode == RENDER_STATE_CACHE_FILE_HASH_MODE_BY_NAME)
     {
@@ -363,7 +485,15 @@ bool RenderStateCacheImpl::CreateShaderInternal(const ShaderCreateInfo& ShaderCI
         UNEXPECTED("Unexpected file hash mode");
     }
     Hasher.Update(IsDebug);
-    const XXH128Hash Hash = Hasher.Digest();
+    return Hasher.Digest();
+}
+
+bool RenderStateCacheImpl::CreateShaderInternal(const ShaderCreateInfo& ShaderCI,
+                                                IShader**               ppShader)
+{
+    VERIFY_EXPR(ppShader != nullptr && *ppShader == nullptr);
+
+    const XXH128Hash Hash = ComputeShaderHash(ShaderCI);
 
     // First, try to check if the shader has already been requested
     {
@@ -735,6 +865,129 @@ void CreateRenderStateCache(const RenderStateCacheCreateInfo& CreateInfo,
     }
 }
 
+template <typename CreateInfoType>
+XXH128Hash RenderStateCacheImpl::ComputePipelineStateHash(const CreateInfoType& PSOCreateInfo)
+{
+    XXH128State Hasher;
+    ComputeDeviceAttribsHash(Hasher, m_pDevice);
+    Hasher.Update(PSOCreateInfo);
+    return Hasher.Digest();
+}
+
+template <typename ObjectType, typename CreateInfoType, typename GetHashType, typename CreateObjectType>
+void RenderStateCacheImpl::CreateObjects(Uint32                NumObjects,
+                                         const CreateInfoType* pCreateInfos,
+                                         IThreadPool*          pThreadPool,
+                                         ObjectType**          ppObjects,
+                                         IAsyncTask**          ppTasks,
+                                         GetHashType&&         GetHash,
+                                         CreateObjectType&&    CreateObject)
+{
+    if (NumObjects == 0)
+        return;
+
+    if (pCreateInfos == nullptr || ppObjects == nullptr)
+    {
+        DEV_ERROR("pCreateInfos and ppObjects must not be null");
+        return;
+    }
+
+    // Create infos with the same hash form a group that is processed by a single task.
+    std::vector<std::vector<Uint32>>       Groups;
+    std::unordered_map<XXH128Hash, size_t> HashToGroup;
+    Groups.reserve(NumObjects);
+    for (Uint32 i = 0; i < NumObjects; ++i)
+    {
+        DEV_CHECK_ERR(ppObjects[i] == nullptr, "Overwriting reference to existing object may cause memory leaks");
+        ppObjects[i] = nullptr;
+        if (ppTasks != nullptr)
+            ppTasks[i] = nullptr;
+
+        XXH128Hash Hash;
+        if (GetHash(pCreateInfos[i], Hash))
+        {
+            auto it_inserted = HashToGroup.emplace(Hash, Groups.size());
+            if (!it_inserted.second)
+            {
+                Groups[it_inserted.first->second].push_back(i);
+                continue;
+            }
+        }
+        Groups.emplace_back(1, i);
+    }
+
+    for (std::vector<Uint32>& Group : Groups)
+    {
+        auto CreateGroup = [pThis = RefCntAutoPtr<RenderStateCacheImpl>{this}, pCreateInfos, ppObjects, Group = std::move(Group), CreateObject](Uint32 /*ThreadId*/) {
+            RefCntAutoPtr<ObjectType> pObject;
+            CreateObject(*pThis, pCreateInfos[Group[0]], &pObject);
+            if (pObject)
+            {
+                for (Uint32 Idx : Group)
+                {
+                    ppObjects[Idx] = pObject;
+                    ppObjects[Idx]->AddRef();
+                }
+            }
+            return ASYNC_TASK_STATUS_COMPLETE;
+        };
+
+        if (pThreadPool == nullptr)
+        {
+            CreateGroup(0);
+            continue;
+        }
+
+        RefCntAutoPtr<IAsyncTask> pTask = EnqueueAsyncWork(pThreadPool, std::move(CreateGroup));
+        if (ppTasks != nullptr)
+        {
+            for (Uint32 Idx : Group)
+            {
+                ppTasks[Idx] = pTask;
+                ppTasks[Idx]->AddRef();
+            }
+        }
+    }
+}
+
+void RenderStateCacheImpl::CreateShaders(Uint32                  NumShaders,
+                                         const ShaderCreateInfo* pShaderCIs,
+                                         IThreadPool*            pThreadPool,
+                                         IShader**               ppShaders,
+                                         IAsyncTask**            ppTasks)
+{
+    CreateObjects(
+        NumShaders, pShaderCIs, pThreadPool, ppShaders, ppTasks,
+        [this](const ShaderCreateInfo& ShaderCI, XXH128Hash& Hash) {
+            Hash = ComputeShaderHash(ShaderCI);
+            return true;
+        },
+        [](RenderStateCacheImpl& Cache, const ShaderCreateInfo& ShaderCI, IShader** ppShader) {
+            Cache.CreateShader(ShaderCI, ppShader);
+        });
+}
+
+template <typename CreateInfoType>
+void RenderStateCacheImpl::CreatePipelineStates(Uint32                NumPipelines,
+                                                const CreateInfoType* pPSOCreateInfos,
+                                                IThreadPool*          pThreadPool,
+                                                IPipelineState**      ppPipelineStates,
+                                                IAsyncTask**          ppTasks)
+{
+    CreateObjects(
+        NumPipelines, pPSOCreateInfos, pThreadPool, ppPipelineStates, ppTasks,
+        [this](const CreateInfoType& PSOCreateInfo, XXH128Hash& Hash) {
+            // Pipeline hash includes shader byte code, so it can only be computed when all shaders are ready.
+            if (GetPipelineStateCreateInfoShadersStatus(PSOCreateInfo) != SHADER_STATUS_READY)
+                return false;
+            Hash = ComputePipelineStateHash(PSOCreateInfo);
+            return true;
+        },
+        [](RenderStateCacheImpl& Cache, const CreateInfoType& PSOCreateInfo, IPipelineState** ppPipelineState) {
+            Cache.CreatePipelineState(PSOCreateInfo, ppPipelineState);
+        });
+}
+
 template <typename CreateInfoType>
 bool RenderStateCacheImpl::CreatePipelineState(const CreateInfoType& PSOCreateInfo,
                                                IPipelineState**      ppPipelineState)
@@ -808,10 +1061,7 @@ bool RenderStateCacheImpl::CreatePipelineStateInternal(const CreateInfoType& PSO
         return false;
     }
 
-    XXH128State Hasher;
-    ComputeDeviceAttribsHash(Hasher, m_pDevice);
-    Hasher.Update(PSOCreateInfo);
-    const auto Hash = Hasher.Digest();
+    const XXH128Hash Hash = ComputePipelineStateHash(PSOCreateInfo);
 
     // First, try to check if the PSO has already been requested
     {
@@ -942,6 +1192,9 @@ Uint32 RenderStateCacheImpl::Reload(ReloadGraphicsPipelineCallbackType ReloadGra
 
     Uint32 NumStatesReloaded = 0;
 
+    // Source files may have been modified since they were hashed
+    ClearSourceFileHashes();
+
     // Reload all shaders first
     {
         std::lock_guard<std::mutex> Guard{m_ReloadableShadersMtx};
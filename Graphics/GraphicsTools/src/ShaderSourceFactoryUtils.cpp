@@ -27,14 +27,22 @@
 #include "ShaderSourceFactoryUtils.h"
 
 #include <vector>
+#include <algorithm>
+#include <cstring>
 #include <unordered_map>
 #include <string>
+#include <mutex>
+#include <shared_mutex>
 
 #include "ObjectBase.hpp"
 #include "HashUtils.hpp"
 #include "RefCntAutoPtr.hpp"
 #include "StringDataBlobImpl.hpp"
+#include "DataBlobImpl.hpp"
+#include "ProxyDataBlob.hpp"
+#include "MappedFileDataBlob.hpp"
 #include "MemoryFileStream.hpp"
+#include "Serializer.hpp"
 
 namespace Diligent
 {
@@ -200,6 +208,341 @@ void CreateMemoryShaderSourceFactory(const MemoryShaderSourceFactoryCreateInfo&
 }
 
 
+namespace
+{
+
+// Shader source pack layout:
+//   | Magic | Version | NumFiles | Name 0 | Data 0 | ... | Name N-1 | Data N-1 |
+// Names are serialized as null-terminated strings, data as byte arrays aligned to 8 bytes
+// (see Serializer). Keep in sync with BuildTools/ShaderSourcePack/script.py.
+constexpr Uint32 ShaderSourcePackMagic   = 0x50535344; // 'DSSP'
+constexpr Uint32 ShaderSourcePackVersion = 1;
+
+template <SerializerMode Mode>
+bool SerializeShaderSourcePack(Serializer<Mode>& Ser, const MemoryShaderSourceFactoryCreateInfo& Sources)
+{
+    const Uint32 Magic   = ShaderSourcePackMagic;
+    const Uint32 Version = ShaderSourcePackVersion;
+    if (!Ser(Magic, Version, Sources.NumSources))
+        return false;
+
+    for (Uint32 i = 0; i < Sources.NumSources; ++i)
+    {
+        const MemoryShaderSourceFileInfo& Source = Sources.pSources[i];
+
+        const size_t Length = Source.Length != 0 ? Source.Length : strlen(Source.pData);
+        if (!Ser(Source.Name) || !Ser.SerializeBytes(Source.pData, Length))
+            return false;
+    }
+
+    return true;
+}
+
+// Checks that the next file entry of the pack (the name followed by the data, see SerializeShaderSourcePack)
+// is within the data bounds and that the name is a non-empty null-terminated string.
+// Serializer only verifies this in debug builds.
+bool IsValidShaderSourcePackEntry(const Serializer<SerializerMode::Read>& Ser)
+{
+    const Uint8* const pStart   = static_cast<const Uint8*>(Ser.GetCurrentPtr()) - Ser.GetSize();
+    const size_t       PackSize = Ser.GetSize() + Ser.GetRemainingSize();
+
+    size_t Offset     = Ser.GetSize();
+    auto   ReadUint32 = [&](Uint32& Value) {
+        if (PackSize - Offset < sizeof(Value))
+            return false;
+        memcpy(&Value, pStart + Offset, sizeof(Value));
+        Offset += sizeof(Value);
+        return true;
+    };
+
+    Uint32 NameLenWithNull = 0;
+    if (!ReadUint32(NameLenWithNull) || NameLenWithNull < 2 || PackSize - Offset < NameLenWithNull)
+        return false;
+    if (pStart[Offset + NameLenWithNull - 1] != '\0')
+        return false;
+    Offset += NameLenWithNull;
+
+    Uint32 FileSize = 0;
+    if (!ReadUint32(FileSize))
+        return false;
+
+    // File data is aligned the same way as in Serializer::SerializeBytes
+    Offset = AlignUp(Offset, size_t{8});
+    return Offset <= PackSize && PackSize - Offset >= FileSize;
+}
+
+// Creates a stream that reads the data without copying it.
+// The stream keeps a reference to the data container.
+void CreateProxyStream(const void* pData, size_t Size, IObject* pDataContainer, IFileStream** ppStream)
+{
+    RefCntAutoPtr<ProxyDataBlob>    pDataBlob  = ProxyDataBlob::Create(pData, Size, pDataContainer);
+    RefCntAutoPtr<MemoryFileStream> pMemStream = MemoryFileStream::Create(pDataBlob);
+    pMemStream->QueryInterface(IID_FileStream, reinterpret_cast<IObject**>(ppStream));
+}
+
+} // namespace
+
+void CreateShaderSourcePack(const MemoryShaderSourceFactoryCreateInfo& Sources, IDataBlob** ppPack)
+{
+    DEV_CHECK_ERR(ppPack != nullptr, "ppPack must not be null");
+    DEV_CHECK_ERR(*ppPack == nullptr, "Overwriting reference to existing object may cause memory leaks");
+    for (Uint32 i = 0; i < Sources.NumSources; ++i)
+    {
+        DEV_CHECK_ERR(Sources.pSources[i].Name != nullptr && Sources.pSources[i].Name[0] != '\0', "Source name must not be null or empty");
+        DEV_CHECK_ERR(Sources.pSources[i].pData != nullptr, "Source data must not be null");
+    }
+
+    Serializer<SerializerMode::Measure> MeasureSer;
+    if (!SerializeShaderSourcePack(MeasureSer, Sources))
+    {
+        UNEXPECTED("Failed to measure shader source pack size. This should never happen.");
+        return;
+    }
+
+    const size_t                PackSize = MeasureSer.GetSize();
+    RefCntAutoPtr<DataBlobImpl> pPack    = DataBlobImpl::Create(PackSize);
+
+    // The pack data is written directly to the data blob
+    const SerializedData              PackData{pPack->GetDataPtr(), PackSize};
+    Serializer<SerializerMode::Write> WriteSer{PackData};
+    if (!SerializeShaderSourcePack(WriteSer, Sources))
+    {
+        UNEXPECTED("Failed to write shader source pack. This should never happen.");
+        return;
+    }
+    VERIFY_EXPR(WriteSer.IsEnded());
+
+    *ppPack = pPack.Detach();
+}
+
+
+class PackedShaderSourceFactory final : public ObjectBase<IShaderSourceInputStreamFactory>
+{
+public:
+    using TBase = ObjectBase<IShaderSourceInputStreamFactory>;
+
+    static RefCntAutoPtr<IShaderSourceInputStreamFactory> Create(IDataBlob* pPackData)
+    {
+        return RefCntAutoPtr<IShaderSourceInputStreamFactory>{MakeNewRCObj<PackedShaderSourceFactory>()(pPackData)};
+    }
+
+    PackedShaderSourceFactory(IReferenceCounters* pRefCounters,
+                              IDataBlob*          pPackData) :
+        TBase{pRefCounters},
+        m_pPackData{pPackData}
+    {
+        VERIFY_EXPR(m_pPackData);
+
+        const SerializedData Data{const_cast<void*>(m_pPackData->GetConstDataPtr()), m_pPackData->GetSize()};
+        if (Data.Size() < sizeof(Uint32) * 3)
+            LOG_ERROR_AND_THROW("The data is too small to be a shader source pack");
+
+        Serializer<SerializerMode::Read> Ser{Data};
+
+        Uint32 Magic    = 0;
+        Uint32 Version  = 0;
+        Uint32 NumFiles = 0;
+        Ser(Magic, Version, NumFiles);
+        if (Magic != ShaderSourcePackMagic)
+            LOG_ERROR_AND_THROW("The data is not a shader source pack");
+        if (Version != ShaderSourcePackVersion)
+            LOG_ERROR_AND_THROW("Unsupported shader source pack version: ", Version, ". Expected version: ", ShaderSourcePackVersion);
+
+        // Every file takes at least 10 bytes. Do not trust the file count in corrupted data.
+        m_Files.reserve(std::min(size_t{NumFiles}, Ser.GetRemainingSize() / 10));
+        for (Uint32 i = 0; i < NumFiles; ++i)
+        {
+            const char* Name = nullptr;
+            FileData    File;
+            if (!IsValidShaderSourcePackEntry(Ser) || !Ser(Name) || !Ser.SerializeBytes(File.pData, File.Size))
+                LOG_ERROR_AND_THROW("Shader source pack is corrupted");
+
+            // Names point to the pack data that is kept alive by the factory
+            if (!m_Files.emplace(HashMapStringKey{Name}, File).second)
+                LOG_WARNING_MESSAGE("Shader source pack contains multiple files named '", Name, "'. Only the first one will be used.");
+        }
+    }
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_IShaderSourceInputStreamFactory, TBase)
+
+    virtual void DILIGENT_CALL_TYPE CreateInputStream(const Char*   Name,
+                                                      IFileStream** ppStream) override final
+    {
+        CreateInputStream2(Name, CREATE_SHADER_SOURCE_INPUT_STREAM_FLAG_NONE, ppStream);
+    }
+
+    virtual void DILIGENT_CALL_TYPE CreateInputStream2(const Char*                             Name,
+                                                       CREATE_SHADER_SOURCE_INPUT_STREAM_FLAGS Flags,
+                                                       IFileStream**                           ppStream) override final
+    {
+        VERIFY_EXPR(ppStream != nullptr && *ppStream == nullptr);
+
+        auto FileIt = m_Files.find(Name);
+        if (FileIt != m_Files.end())
+        {
+            CreateProxyStream(FileIt->second.pData, FileIt->second.Size, m_pPackData, ppStream);
+        }
+        else if ((Flags & CREATE_SHADER_SOURCE_INPUT_STREAM_FLAG_SILENT) == 0)
+        {
+            LOG_ERROR("Failed to create input stream for source file ", Name);
+        }
+    }
+
+private:
+    struct FileData
+    {
+        const void* pData = nullptr;
+        size_t      Size  = 0;
+    };
+
+    RefCntAutoPtr<IDataBlob> m_pPackData;
+
+    std::unordered_map<HashMapStringKey, FileData> m_Files;
+};
+
+void CreatePackedShaderSourceFactory(const PackedShaderSourceFactoryCreateInfo& CreateInfo, IShaderSourceInputStreamFactory** ppFactory)
+{
+    DEV_CHECK_ERR(ppFactory != nullptr, "ppFactory must not be null");
+    DEV_CHECK_ERR(*ppFactory == nullptr, "Overwriting reference to existing object may cause memory leaks");
+
+    RefCntAutoPtr<IDataBlob> pPackData{CreateInfo.pPackData};
+    if (!pPackData)
+    {
+        if (CreateInfo.FilePath == nullptr)
+        {
+            DEV_ERROR("Either pPackData or FilePath must not be null");
+            return;
+        }
+
+        pPackData = MappedFileDataBlob::Create(CreateInfo.FilePath);
+        if (!pPackData)
+            return;
+    }
+
+    try
+    {
+        RefCntAutoPtr<IShaderSourceInputStreamFactory> pFactory = PackedShaderSourceFactory::Create(pPackData);
+        pFactory->QueryInterface(IID_IShaderSourceInputStreamFactory, reinterpret_cast<IObject**>(ppFactory));
+    }
+    catch (...)
+    {
+        LOG_ERROR("Failed to create packed shader source factory");
+    }
+}
+
+
+class CachingShaderSourceFactory final : public ObjectBase<IShaderSourceInputStreamFactory>
+{
+public:
+    using TBase = ObjectBase<IShaderSourceInputStreamFactory>;
+
+    static RefCntAutoPtr<IShaderSourceInputStreamFactory> Create(IShaderSourceInputStreamFactory* pFactory)
+    {
+        return RefCntAutoPtr<IShaderSourceInputStreamFactory>{MakeNewRCObj<CachingShaderSourceFactory>()(pFactory)};
+    }
+
+    CachingShaderSourceFactory(IReferenceCounters*              pRefCounters,
+                               IShaderSourceInputStreamFactory* pFactory) :
+        TBase{pRefCounters},
+        m_pFactory{pFactory}
+    {
+        VERIFY_EXPR(m_pFactory);
+    }
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_IShaderSourceInputStreamFactory, TBase)
+
+    virtual void DILIGENT_CALL_TYPE CreateInputStream(const Char*   Name,
+                                                      IFileStream** ppStream) override final
+    {
+        CreateInputStream2(Name, CREATE_SHADER_SOURCE_INPUT_STREAM_FLAG_NONE, ppStream);
+    }
+
+    virtual void DILIGENT_CALL_TYPE CreateInputStream2(const Char*                             Name,
+                                                       CREATE_SHADER_SOURCE_INPUT_STREAM_FLAGS Flags,
+                                                       IFileStream**                           ppStream) override final
+    {
+        VERIFY_EXPR(ppStream != nullptr && *ppStream == nullptr);
+
+        RefCntAutoPtr<IDataBlob> pData;
+        bool                     IsCached = false;
+        {
+            std::shared_lock<std::shared_mutex> Lock{m_Mtx};
+
+            auto it = m_Cache.find(Name);
+            if (it != m_Cache.end())
+            {
+                pData    = it->second;
+                IsCached = true;
+            }
+        }
+
+        if (!IsCached)
+        {
+            // Load the file outside of the lock so that other threads are not blocked.
+            // If several threads load the same file, the first one to finish wins.
+            pData = LoadFile(Name);
+
+            // Files that were not found are not cached as they may be created later
+            if (pData)
+            {
+                std::unique_lock<std::shared_mutex> Lock{m_Mtx};
+
+                pData = m_Cache.emplace(HashMapStringKey{Name, true}, std::move(pData)).first->second;
+            }
+        }
+
+        if (pData)
+        {
+            // Streams read the cached data through a read-only proxy so that
+            // the cache can't be modified.
+            const size_t Size = pData->GetSize();
+            CreateProxyStream(Size > 0 ? pData->GetConstDataPtr() : nullptr, Size, pData, ppStream);
+        }
+        else if ((Flags & CREATE_SHADER_SOURCE_INPUT_STREAM_FLAG_SILENT) == 0)
+        {
+            LOG_ERROR("Failed to create input stream for source file ", Name);
+        }
+    }
+
+private:
+    RefCntAutoPtr<IDataBlob> LoadFile(const Char* Name)
+    {
+        RefCntAutoPtr<IFileStream> pStream;
+        m_pFactory->CreateInputStream2(Name, CREATE_SHADER_SOURCE_INPUT_STREAM_FLAG_SILENT, &pStream);
+        if (!pStream)
+            return {};
+
+        // Memory streams are cached without copying the data
+        RefCntAutoPtr<MemoryFileStream> pMemStream{pStream, MemoryFileStream::IID_InternalImpl};
+        if (pMemStream && pMemStream->GetPos() == 0)
+            return RefCntAutoPtr<IDataBlob>{pMemStream->GetDataBlob()};
+
+        RefCntAutoPtr<DataBlobImpl> pData = DataBlobImpl::Create();
+        pStream->ReadBlob(pData);
+        return pData;
+    }
+
+private:
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> m_pFactory;
+
+    std::shared_mutex                                              m_Mtx;
+    std::unordered_map<HashMapStringKey, RefCntAutoPtr<IDataBlob>> m_Cache;
+};
+
+void CreateCachingShaderSourceFactory(IShaderSourceInputStreamFactory* pFactory, IShaderSourceInputStreamFactory** ppFactory)
+{
+    DEV_CHECK_ERR(ppFactory != nullptr, "ppFactory must not be null");
+    DEV_CHECK_ERR(*ppFactory == nullptr, "Overwriting reference to existing object may cause memory leaks");
+    if (pFactory == nullptr)
+    {
+        DEV_ERROR("pFactory must not be null");
+        return;
+    }
+
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pCachingFactory = CachingShaderSourceFactory::Create(pFactory);
+    pCachingFactory->QueryInterface(IID_IShaderSourceInputStreamFactory, reinterpret_cast<IObject**>(ppFactory));
+}
+
 } // namespace Diligent
 
 extern "C"
@@ -215,4 +558,22 @@ extern "C"
     {
         Diligent::CreateMemoryShaderSourceFactory(CreateInfo, ppFactory);
     }
+
+    void Diligent_CreateShaderSourcePack(const Diligent::MemoryShaderSourceFactoryCreateInfo& Sources,
+                                         Diligent::IDataBlob**                                ppPack)
+    {
+        Diligent::CreateShaderSourcePack(Sources, ppPack);
+    }
+
+    void Diligent_CreatePackedShaderSourceFactory(const Diligent::PackedShaderSourceFactoryCreateInfo& CreateInfo,
+                                                  Diligent::IShaderSourceInputStreamFactory**          ppFactory)
+    {
+        Diligent::CreatePackedShaderSourceFactory(CreateInfo, ppFactory);
+    }
+
+    void Diligent_CreateCachingShaderSourceFactory(Diligent::IShaderSourceInputStreamFactory*  pFactory,
+                                                   Diligent::IShaderSourceInputStreamFactory** ppFactory)
+    {
+        Diligent::CreateCachingShaderSourceFactory(pFactory, ppFactory);
+    }
 }
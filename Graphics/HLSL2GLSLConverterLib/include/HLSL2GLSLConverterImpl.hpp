@@ -32,6 +32,8 @@
 #include <unordered_map>
 #include <vector>
 #include <array>
+#include <memory>
+#include <mutex>
 
 #include "HLSL2GLSLConverter.h"
 #include "ObjectBase.hpp"
@@ -40,6 +42,7 @@
 #include "Constants.h"
 #include "HLSLTokenizer.hpp"
 #include "STDAllocator.hpp"
+#include "DynamicLinearAllocator.hpp"
 
 namespace Diligent
 {
@@ -219,9 +222,58 @@ private:
     // Example: {"sampler2D", "Sample", 2} -> {"Sample_2", "_SWIZZLE"}
     std::unordered_map<FunctionStubHashKey, GLSLStubInfo, FunctionStubHashKey::Hasher> m_GLSLStubs;
 
-    using TokenType     = Parsing::HLSLTokenType;
-    using TokenInfo     = Parsing::HLSLTokenInfo;
-    using TokenListType = Parsing::HLSLTokenizer::TokenListType;
+    using TokenType = Parsing::HLSLTokenType;
+    using TokenInfo = Parsing::HLSLTokenInfo;
+
+    // Allocates token list nodes from a linear allocator, if one is provided. Nodes allocated from the
+    // linear allocator are never released individually: the memory is reclaimed when the linear allocator
+    // is destroyed or rewound. Otherwise, nodes are allocated from the heap.
+    template <typename T>
+    struct TokenAllocator
+    {
+        using value_type = T;
+
+        using propagate_on_container_copy_assignment = std::true_type;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap            = std::true_type;
+
+        TokenAllocator() noexcept {}
+
+        explicit TokenAllocator(DynamicLinearAllocator& Allocator) noexcept :
+            pAllocator{&Allocator}
+        {}
+
+        template <typename U>
+        TokenAllocator(const TokenAllocator<U>& Other) noexcept :
+            pAllocator{Other.pAllocator}
+        {}
+
+        T* allocate(size_t Count)
+        {
+            return pAllocator != nullptr ? pAllocator->Allocate<T>(Count) : std::allocator<T>{}.allocate(Count);
+        }
+
+        void deallocate(T* Ptr, size_t Count) noexcept
+        {
+            if (pAllocator == nullptr)
+                std::allocator<T>{}.deallocate(Ptr, Count);
+        }
+
+        template <typename U>
+        bool operator==(const TokenAllocator<U>& Other) const noexcept
+        {
+            return pAllocator == Other.pAllocator;
+        }
+
+        template <typename U>
+        bool operator!=(const TokenAllocator<U>& Other) const noexcept
+        {
+            return !(*this == Other);
+        }
+
+        DynamicLinearAllocator* pAllocator = nullptr;
+    };
+    using TokenListType = std::list<TokenInfo, TokenAllocator<TokenInfo>>;
 
     class ConversionStream : public ObjectBase<IHLSL2GLSLConversionStream>
     {
@@ -242,7 +294,9 @@ private:
         ///                             the input stream factory using InputFileName.
         /// \param [in] NumSymbols    - Number of symbols in the HLSLSource string
         /// \param [in] bPreserveTokens - Whether to preserve original tokens. This must be set to true if the stream
-        ///                               will be used for multiple conversions.
+        ///                               will be used for multiple conversions. In this case, the processing that
+        ///                               does not depend on the entry point and shader type is performed once and
+        ///                               shared by all conversions, and conversion results are cached.
         ConversionStream(IReferenceCounters*              pRefCounters,
                          const HLSL2GLSLConverterImpl&    Converter,
                          const char*                      InputFileName,
@@ -279,6 +333,13 @@ private:
 
         void ParseGlobalPreprocessorDefines();
 
+        void PrepareTokens(const char* SamplerSuffix);
+
+        void PrepareTokensFromCache(const char* SamplerSuffix, DynamicLinearAllocator& Allocator);
+
+        StringAlloc ConvertInternal(const Char* EntryPoint,
+                                    SHADER_TYPE ShaderType);
+
         void ProcessShaderDeclaration(TokenListType::iterator EntryPointToken, SHADER_TYPE ShaderType);
 
         void ProcessObjectMethods(const TokenListType::iterator& ScopeStart, const TokenListType::iterator& ScopeEnd);
@@ -460,15 +521,61 @@ private:
 
         StringAlloc BuildGLSLSource();
 
-        // Tokenized source code
+        // Allocator for the prepared tokens owned by the stream
+        DynamicLinearAllocator m_TokenAllocator;
+
+        // Tokens being converted
         TokenListType m_Tokens;
 
+        // Original source tokens. Only used when m_bPreserveTokens is true.
+        TokenListType m_SourceTokens;
+
         // List of tokens defining structs
         std::unordered_map<HashMapStringKey, TokenListType::iterator> m_StructDefinitions;
 
         // List of preprocessor macro definitions in global scope
         std::unordered_map<HashMapStringKey, TokenListType::iterator> m_PreprocessorDefinitions;
 
+        // List of global function names
+        std::unordered_map<HashMapStringKey, TokenListType::iterator> m_FunctionDefinitions;
+
+        // Tokens after the processing that does not depend on the entry point and shader type
+        // (see PrepareTokens()). Only used when m_bPreserveTokens is true.
+        struct PreparedTokens
+        {
+            bool   UseRowMajorMatrices = false;
+            String SamplerSuffix;
+
+            TokenListType Tokens;
+
+            // Struct, macro and function definition tokens referenced by their position in Tokens.
+            struct TokenRef
+            {
+                enum class RefType : Uint8
+                {
+                    Struct,
+                    Macro,
+                    Function
+                };
+                RefType          Type;
+                HashMapStringKey Name;
+                size_t           Pos;
+            };
+            // Sorted by position
+            std::vector<TokenRef> Refs;
+
+            explicit PreparedTokens(TokenListType&& _Tokens) noexcept :
+                Tokens{std::move(_Tokens)}
+            {}
+        };
+        std::vector<std::unique_ptr<PreparedTokens>> m_PreparedTokens;
+
+        // Converted GLSL sources (without definitions) for every set of conversion parameters.
+        // Only used when m_bPreserveTokens is true.
+        std::unordered_map<String, StringAlloc> m_ConvertedSources;
+
+        std::mutex m_ConversionMtx;
+
         // Stack of parsed objects, for every scope level.
         // There are currently only two levels:
         // level 0 - global scope, contains all global objects
@@ -4427,6 +4427,7 @@ HLSL2GLSLConverterImpl::ConversionStream::ConversionStream(IReferenceCounters*
                                                            bool                             bPreserveTokens) :
     // clang-format off
     TBase            {pRefCounters   },
+    m_TokenAllocator {GetRawAllocator(), 64 << 10},
     m_bPreserveTokens{bPreserveTokens},
     m_Converter      {Converter      },
     m_InputFileName  {InputFileName != nullptr ? InputFileName : "<Unknown>"}
@@ -4456,7 +4457,7 @@ HLSL2GLSLConverterImpl::ConversionStream::ConversionStream(IReferenceCounters*
 
     InsertIncludes(Source, pInputStreamFactory);
 
-    m_Tokens = m_Converter.m_HLSLTokenizer.Tokenize(Source);
+    (m_bPreserveTokens ? m_SourceTokens : m_Tokens) = m_Converter.m_HLSLTokenizer.Tokenize<TokenListType>(Source);
 }
 
 
@@ -4541,17 +4542,8 @@ void HLSL2GLSLConverterImpl::ConversionStream::Convert(const Char* EntryPoint,
     }
 }
 
-StringAlloc HLSL2GLSLConverterImpl::ConversionStream::Convert(const Char* EntryPoint,
-                                                              SHADER_TYPE ShaderType,
-                                                              bool        IncludeDefintions,
-                                                              const char* SamplerSuffix,
-                                                              bool        UseInOutLocationQualifiers,
-                                                              bool        UseRowMajorMatrices)
+void HLSL2GLSLConverterImpl::ConversionStream::PrepareTokens(const char* SamplerSuffix)
 {
-    m_bUseInOutLocationQualifiers = UseInOutLocationQualifiers;
-    m_bUseRowMajorMatrices        = UseRowMajorMatrices;
-    TokenListType TokensCopy(m_bPreserveTokens ? m_Tokens : TokenListType());
-
     Uint32 ShaderStorageBlockBinding = 0;
     Uint32 ImageBinding              = 0;
 
@@ -4608,7 +4600,6 @@ StringAlloc HLSL2GLSLConverterImpl::ConversionStream::Convert(const Char* EntryP
 
     ParseGlobalPreprocessorDefines();
 
-    auto ShaderEntryPointToken = m_Tokens.end();
     // Process textures and search for the shader entry point.
     // GLSL does not allow local variables of sampler type, so the
     // only two scopes where textures can be declared are global scope
@@ -4657,8 +4648,8 @@ StringAlloc HLSL2GLSLConverterImpl::ConversionStream::Convert(const Char* EntryP
                 if ((ReturnTypeToken->IsBuiltInType() || ReturnTypeToken->Type == TokenType::Identifier) &&
                     OpenParenToken->Type == TokenType::OpenParen)
                 {
-                    if (Token->Literal == EntryPoint)
-                        ShaderEntryPointToken = Token;
+                    // Later definitions override the earlier ones (e.g. function declarations)
+                    m_FunctionDefinitions[HashMapStringKey{Token->Literal}] = Token;
 
                     Token = OpenParenToken;
                     // float4 Func ( in float2 f2UV,
@@ -4780,6 +4771,114 @@ StringAlloc HLSL2GLSLConverterImpl::ConversionStream::Convert(const Char* EntryP
                 ++Token;
         }
     }
+}
+
+void HLSL2GLSLConverterImpl::ConversionStream::PrepareTokensFromCache(const char* SamplerSuffix, DynamicLinearAllocator& Allocator)
+{
+    VERIFY_EXPR(m_bPreserveTokens);
+
+    using TokenRef = PreparedTokens::TokenRef;
+
+    PreparedTokens* pPrepared = nullptr;
+    for (const std::unique_ptr<PreparedTokens>& pTokens : m_PreparedTokens)
+    {
+        if (pTokens->UseRowMajorMatrices == m_bUseRowMajorMatrices && pTokens->SamplerSuffix == SamplerSuffix)
+        {
+            pPrepared = pTokens.get();
+            break;
+        }
+    }
+
+    if (pPrepared == nullptr)
+    {
+        // Note that PrepareTokens() may change m_bUseRowMajorMatrices
+        const bool UseRowMajorMatrices = m_bUseRowMajorMatrices;
+
+        m_Tokens = TokenListType(m_SourceTokens, TokenAllocator<TokenInfo>{m_TokenAllocator});
+        PrepareTokens(SamplerSuffix);
+
+        // Moving the list does not invalidate the iterators
+        std::unique_ptr<PreparedTokens> pNewTokens = std::make_unique<PreparedTokens>(std::move(m_Tokens));
+        pNewTokens->UseRowMajorMatrices            = UseRowMajorMatrices;
+        pNewTokens->SamplerSuffix                  = SamplerSuffix;
+
+        // Find positions of the definition tokens
+        std::unordered_map<const TokenInfo*, size_t> TokenPositions;
+        for (const auto* pDefinitions : {&m_StructDefinitions, &m_PreprocessorDefinitions, &m_FunctionDefinitions})
+        {
+            for (const auto& it : *pDefinitions)
+                TokenPositions.emplace(&*it.second, ~size_t{0});
+        }
+        size_t Pos = 0;
+        for (const TokenInfo& Token : pNewTokens->Tokens)
+        {
+            auto pos_it = TokenPositions.find(&Token);
+            if (pos_it != TokenPositions.end())
+                pos_it->second = Pos;
+            ++Pos;
+        }
+
+        auto AddRefs = [&](const std::unordered_map<HashMapStringKey, TokenListType::iterator>& Definitions, TokenRef::RefType Type) {
+            for (const auto& it : Definitions)
+            {
+                const size_t TokenPos = TokenPositions.at(&*it.second);
+                VERIFY_EXPR(TokenPos != ~size_t{0});
+                pNewTokens->Refs.push_back({Type, it.first.Clone(), TokenPos});
+            }
+        };
+        AddRefs(m_StructDefinitions, TokenRef::RefType::Struct);
+        AddRefs(m_PreprocessorDefinitions, TokenRef::RefType::Macro);
+        AddRefs(m_FunctionDefinitions, TokenRef::RefType::Function);
+        std::sort(pNewTokens->Refs.begin(), pNewTokens->Refs.end(),
+                  [](const TokenRef& Ref1, const TokenRef& Ref2) {
+                      return Ref1.Pos < Ref2.Pos;
+                  });
+
+        pPrepared = pNewTokens.get();
+        m_PreparedTokens.emplace_back(std::move(pNewTokens));
+    }
+
+    m_StructDefinitions.clear();
+    m_PreprocessorDefinitions.clear();
+    m_FunctionDefinitions.clear();
+    m_Objects.clear();
+
+    // Copy the prepared tokens and restore the definitions
+    m_Tokens = TokenListType(pPrepared->Tokens, TokenAllocator<TokenInfo>{Allocator});
+
+    auto   RefIt = pPrepared->Refs.begin();
+    size_t Pos   = 0;
+    for (auto Token = m_Tokens.begin(); Token != m_Tokens.end() && RefIt != pPrepared->Refs.end(); ++Token, ++Pos)
+    {
+        for (; RefIt != pPrepared->Refs.end() && RefIt->Pos == Pos; ++RefIt)
+        {
+            switch (RefIt->Type)
+            {
+                case TokenRef::RefType::Struct:
+                    m_StructDefinitions.emplace(RefIt->Name.Clone(), Token);
+                    break;
+
+                case TokenRef::RefType::Macro:
+                    m_PreprocessorDefinitions.emplace(RefIt->Name.Clone(), Token);
+                    break;
+
+                case TokenRef::RefType::Function:
+                    m_FunctionDefinitions.emplace(RefIt->Name.Clone(), Token);
+                    break;
+
+                default:
+                    UNEXPECTED("Unexpected token reference type");
+            }
+        }
+    }
+    VERIFY_EXPR(RefIt == pPrepared->Refs.end());
+}
+
+StringAlloc HLSL2GLSLConverterImpl::ConversionStream::ConvertInternal(const Char* EntryPoint,
+                                                                      SHADER_TYPE ShaderType)
+{
+    auto EntryPointIt          = m_FunctionDefinitions.find(EntryPoint);
+    auto ShaderEntryPointToken = EntryPointIt != m_FunctionDefinitions.end() ? EntryPointIt->second : m_Tokens.end();
     VERIFY_PARSER_STATE(ShaderEntryPointToken, ShaderEntryPointToken != m_Tokens.end(), "Unable to find shader entry point \"", EntryPoint, '\"');
 
     ProcessShaderDeclaration(ShaderEntryPointToken, ShaderType);
@@ -4788,14 +4887,64 @@ StringAlloc HLSL2GLSLConverterImpl::ConversionStream::Convert(const Char* EntryP
 
     RemoveSpecialShaderAttributes();
 
-    StringAlloc GLSLSource = BuildGLSLSource();
+    return BuildGLSLSource();
+}
+
+StringAlloc HLSL2GLSLConverterImpl::ConversionStream::Convert(const Char* EntryPoint,
+                                                              SHADER_TYPE ShaderType,
+                                                              bool        IncludeDefintions,
+                                                              const char* SamplerSuffix,
+                                                              bool        UseInOutLocationQualifiers,
+                                                              bool        UseRowMajorMatrices)
+{
+    std::lock_guard<std::mutex> Lock{m_ConversionMtx};
+
+    m_bUseInOutLocationQualifiers = UseInOutLocationQualifiers;
+    m_bUseRowMajorMatrices        = UseRowMajorMatrices;
 
+    StringAlloc GLSLSource{STD_ALLOCATOR_RAW_MEM(Char, GetRawAllocator(), "Allocator for String")};
     if (m_bPreserveTokens)
     {
-        m_Tokens.swap(TokensCopy);
-        m_StructDefinitions.clear();
-        m_PreprocessorDefinitions.clear();
-        m_Objects.clear();
+        // The result only depends on the conversion parameters, so permutations that
+        // only differ by macros (which are not expanded by the converter) share the result.
+        String ConversionKey{EntryPoint};
+        ConversionKey += '|';
+        ConversionKey += std::to_string(static_cast<Uint32>(ShaderType));
+        ConversionKey += '|';
+        ConversionKey += SamplerSuffix;
+        ConversionKey += '|';
+        ConversionKey += UseInOutLocationQualifiers ? '1' : '0';
+        ConversionKey += UseRowMajorMatrices ? '1' : '0';
+
+        auto it = m_ConvertedSources.find(ConversionKey);
+        if (it == m_ConvertedSources.end())
+        {
+            // Tokens being converted are allocated from the scratch arena
+            ThreadScratchArena ScratchArena;
+
+            // Release the tokens before the arena is rewound, also when conversion fails
+            struct ConversionStateReset
+            {
+                ConversionStream& Stream;
+                ~ConversionStateReset()
+                {
+                    Stream.m_Tokens.clear();
+                    Stream.m_StructDefinitions.clear();
+                    Stream.m_PreprocessorDefinitions.clear();
+                    Stream.m_FunctionDefinitions.clear();
+                    Stream.m_Objects.clear();
+                }
+            } StateReset{*this};
+
+            PrepareTokensFromCache(SamplerSuffix, ScratchArena.Get());
+            it = m_ConvertedSources.emplace(std::move(ConversionKey), ConvertInternal(EntryPoint, ShaderType)).first;
+        }
+        GLSLSource = it->second;
+    }
+    else
+    {
+        PrepareTokens(SamplerSuffix);
+        GLSLSource = ConvertInternal(EntryPoint, ShaderType);
     }
 
     if (IncludeDefintions)
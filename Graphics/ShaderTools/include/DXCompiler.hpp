@@ -85,7 +85,15 @@ struct IDXCompiler
     /// Compiles HLSL source code to DXIL or SPIRV.
     ///
     /// \remarks    The method is thread-safe.
-    ///             For each compilation, the method creates a new IDxcCompiler instance.
+    ///             DXC objects are not thread-safe, so every thread uses its own set of
+    ///             IDxcLibrary, IDxcCompiler and IDxcValidator instances. These instances
+    ///             are created on the first compilation in the thread and are reused by
+    ///             subsequent compilations (see SetSessionPoolingEnabled).
+    ///
+    ///             If the compilation cache is enabled (see SetCompilationCacheDirectory),
+    ///             the source is first preprocessed, and the compiled byte code is looked up
+    ///             in the cache by the hash of the preprocessed source, entry point, profile,
+    ///             defines, arguments and the compiler version.
     virtual bool Compile(const CompileAttribs& Attribs) = 0;
 
     virtual void Compile(const ShaderCreateInfo& ShaderCI,
@@ -114,6 +122,36 @@ struct IDXCompiler
     /// Attempts to extract shader reflection from the bytecode using DXC.
     virtual void GetD3D12ShaderReflection(IDxcBlob*                pShaderBytecode,
                                           ID3D12ShaderReflection** ppShaderReflection) = 0;
+
+    /// Sets the directory where compiled byte code is persistently cached.
+
+    /// \param [in] Path - Path to the cache directory. The directory is created if it does not exist.
+    ///                    If null or empty, the compilation cache is disabled (this is the default).
+    ///
+    /// \remarks    Every cache entry is stored in a separate file named after its hash, so
+    ///             the same directory may be shared by multiple compilers and processes.
+    ///             Only successful compilations are cached. Compiler output (e.g. warnings)
+    ///             is not stored in the cache.
+    ///             Cache entries are keyed by the compiler build (version and commit), so the cache
+    ///             is not used if the compiler library does not report its commit information.
+    virtual void SetCompilationCacheDirectory(const char* Path) = 0;
+
+    struct CompilationCacheStats
+    {
+        /// The number of compilations whose byte code was found in the cache.
+        Uint32 NumHits = 0;
+
+        /// The number of compilations that had to run the compiler.
+        Uint32 NumMisses = 0;
+    };
+    /// Returns the compilation cache statistics.
+    virtual CompilationCacheStats GetCompilationCacheStats() const = 0;
+
+    /// Enables or disables reusing per-thread DXC instances between compilations.
+
+    /// \remarks    Pooling is enabled by default. When it is disabled, new DXC
+    ///             instances are created for every compilation.
+    virtual void SetSessionPoolingEnabled(bool Enabled) = 0;
 };
 
 // Use this function to load the DX Compiler library.
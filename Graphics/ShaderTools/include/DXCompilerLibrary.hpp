@@ -94,6 +94,14 @@ public:
         return m_Version;
     }
 
+    // Returns the string that identifies the compiler build (version, flags and commit),
+    // or an empty string if the library does not report the commit information.
+    const std::string& GetBuildId() const
+    {
+        VERIFY(m_Loaded.load(), "DXCompiler library is not loaded");
+        return m_BuildId;
+    }
+
     ShaderVersion GetMaxShaderModel() const
     {
         VERIFY(m_Loaded.load(), "DXCompiler library is not loaded");
@@ -109,6 +117,7 @@ private:
     void Load();
     void Unload();
     void InitVersion();
+    void InitBuildId();
     void DetectMaxShaderModel();
 
 private:
@@ -120,6 +129,7 @@ private:
     std::atomic<bool>     m_Loaded{false};
     DxcCreateInstanceProc m_DxcCreateInstance = nullptr;
     Version               m_Version;
+    std::string           m_BuildId;
     ShaderVersion         m_MaxShaderModel;
 };
 
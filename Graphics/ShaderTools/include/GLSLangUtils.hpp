@@ -73,6 +73,11 @@ std::vector<unsigned int> HLSLtoSPIRV(const ShaderCreateInfo& ShaderCI,
                                       const char*             ExtraDefinitions,
                                       IDataBlob**             ppCompilerOutput);
 
+// Selects whether HLSLtoSPIRV uses the per-thread cached preamble with comments and empty
+// lines stripped from the HLSL definitions (default), or assembles the full preamble for every
+// shader. The latter is only intended to measure the effect of the cached preamble.
+void SetUseCachedHLSLPreamble(bool UseCached);
+
 } // namespace GLSLangUtils
 
 } // namespace Diligent
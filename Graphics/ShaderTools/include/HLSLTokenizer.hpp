@@ -28,6 +28,7 @@
 
 #include <unordered_map>
 #include <list>
+#include <vector>
 
 #include "ParsingTools.hpp"
 #include "HLSLKeywords.h"
@@ -175,6 +176,90 @@ struct HLSLTokenInfo
     }
 };
 
+/// Compact token record that references the source buffer instead of
+/// owning copies of the token strings.
+struct HLSLTokenRecord
+{
+    using TokenType = HLSLTokenType;
+
+    TokenType Type = TokenType::Undefined;
+
+    // The length of the delimiter (white spaces and comments) preceding the token
+    Uint32 DelimiterLen = 0;
+
+    // The length of the token literal
+    Uint32 LiteralLen = 0;
+
+    // Token literal in the source buffer. For string constants, the quotes are not included.
+    const char* Literal = nullptr;
+
+    HLSLTokenRecord() noexcept {}
+
+    HLSLTokenRecord(TokenType   _Type,
+                    const char* DelimStart,
+                    const char* DelimEnd,
+                    const char* LiteralStart,
+                    const char* LiteralEnd) noexcept :
+        Type{_Type},
+        DelimiterLen{static_cast<Uint32>(DelimEnd - DelimStart)},
+        LiteralLen{static_cast<Uint32>(LiteralEnd - LiteralStart)},
+        Literal{LiteralStart}
+    {}
+
+    void SetType(TokenType _Type)
+    {
+        Type = _Type;
+    }
+
+    TokenType GetType() const { return Type; }
+
+    bool CompareLiteral(const char* Str) const
+    {
+        return strlen(Str) == LiteralLen && memcmp(Literal, Str, LiteralLen) == 0;
+    }
+
+    bool CompareLiteral(const char* Start, const char* End) const
+    {
+        return static_cast<size_t>(End - Start) == LiteralLen && memcmp(Literal, Start, LiteralLen) == 0;
+    }
+
+    // The tokenizer only extends literals with the characters that immediately follow them
+    void ExtendLiteral(const char* Start, const char* End)
+    {
+        LiteralLen += static_cast<Uint32>(End - Start);
+    }
+
+    size_t GetDelimiterLen() const
+    {
+        return DelimiterLen;
+    }
+    size_t GetLiteralLen() const
+    {
+        return LiteralLen;
+    }
+    const std::pair<const char*, const char*> GetDelimiter() const
+    {
+        const char* DelimEnd = Type == TokenType::StringConstant ? Literal - 1 : Literal;
+        return {DelimEnd - DelimiterLen, DelimEnd};
+    }
+    const std::pair<const char*, const char*> GetLiteral() const
+    {
+        return {Literal, Literal + LiteralLen};
+    }
+
+    std::ostream& OutputDelimiter(std::ostream& os) const
+    {
+        const std::pair<const char*, const char*> Delimiter = GetDelimiter();
+        os.write(Delimiter.first, Delimiter.second - Delimiter.first);
+        return os;
+    }
+    std::ostream& OutputLiteral(std::ostream& os) const
+    {
+        os.write(Literal, LiteralLen);
+        return os;
+    }
+};
+
 class HLSLTokenizer
 {
 public:
@@ -187,12 +272,63 @@ public:
     }
 
     using TokenListType = std::list<HLSLTokenInfo>;
-    TokenListType Tokenize(const String& Source) const;
+
+    /// Tokenizes the HLSL source.
+
+    /// \tparam ContainerType - Type of the list of HLSLTokenInfo objects to tokenize the source into.
+    /// \return  Tokenized source, or an empty list in case of a parsing error.
+    template <typename ContainerType = TokenListType>
+    ContainerType Tokenize(const String& Source) const
+    {
+        try
+        {
+            size_t TokenIdx = 0;
+            return Parsing::Tokenize<HLSLTokenInfo, ContainerType>(
+                Source.begin(), Source.end(),
+                [&TokenIdx](HLSLTokenType                      Type,
+                            const std::string::const_iterator& DelimStart,
+                            const std::string::const_iterator& DelimEnd,
+                            const std::string::const_iterator& LiteralStart,
+                            const std::string::const_iterator& LiteralEnd) //
+                {
+                    return HLSLTokenInfo::Create(Type, DelimStart, DelimEnd, LiteralStart, LiteralEnd, TokenIdx++);
+                },
+                [&](const std::string::const_iterator& Start, const std::string::const_iterator& End) //
+                {
+                    return GetTokenType(&*Start, End - Start);
+                });
+        }
+        catch (...)
+        {
+            return {};
+        }
+    }
+
+    using TokenRecordListType = std::vector<HLSLTokenRecord>;
+
+    /// Tokenizes the HLSL source into compact token records that reference the source buffer.
+
+    /// \param [in]  Source    - HLSL source. The buffer must outlive the records.
+    /// \param [in]  SourceLen - The length of the source.
+    /// \param [out] Records   - Token records. The container is cleared before tokenization, but its
+    ///                          memory is reused, so repeated tokenization into the same container
+    ///                          does not allocate memory once the container has grown large enough.
+    /// \return  true if the source has been tokenized successfully, and false otherwise.
+    ///
+    /// \remarks The records match the tokens produced by Tokenize(const String&): the first
+    ///          record is an empty token of undefined type.
+    bool Tokenize(const char* Source, size_t SourceLen, TokenRecordListType& Records) const;
 
 private:
+    // Returns the keyword token type if the literal is a keyword, and HLSLTokenType::Identifier otherwise.
+    HLSLTokenType GetTokenType(const char* Literal, size_t Length) const;
+
     // HLSL keyword -> token info hash map
     // Example: "Texture2D" -> TokenInfo{TokenType::Texture2D, "Texture2D"}
     std::unordered_map<HashMapStringKey, HLSLTokenInfo> m_Keywords;
+
+    // The maximum keyword length. Longer literals are always identifiers.
+    size_t m_MaxKeywordLen = 0;
 };
 
 } // namespace Parsing
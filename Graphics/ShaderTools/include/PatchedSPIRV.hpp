@@ -0,0 +1,91 @@
+/*
+ *  Copyright 2025 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Declaration of Diligent::PatchedSPIRV class
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace Diligent
+{
+
+/// SPIR-V byte code with pending word patches.
+
+/// The object references the original byte code (which must outlive it) and records
+/// patches such as binding and descriptor set remapping. The byte code is only copied
+/// when the patches are applied and at least one of them changes the code.
+class PatchedSPIRV
+{
+public:
+    explicit PatchedSPIRV(const std::vector<uint32_t>& Original) noexcept :
+        m_pCode{&Original}
+    {}
+
+    // m_pCode may point to m_Copy, so the object must not be copied.
+    PatchedSPIRV(const PatchedSPIRV&) = delete;
+    PatchedSPIRV& operator=(const PatchedSPIRV&) = delete;
+
+    PatchedSPIRV(PatchedSPIRV&& Other) noexcept;
+    PatchedSPIRV& operator=(PatchedSPIRV&& Other) noexcept;
+
+    /// Returns the word at the specified offset with all pending patches applied.
+    uint32_t operator[](size_t Offset) const;
+
+    /// Records a patch that sets the word at the specified offset to the given value.
+    /// Patches that do not change the word are ignored.
+    void Patch(size_t Offset, uint32_t Value);
+
+    /// Applies all pending patches and returns the resulting byte code.
+    const std::vector<uint32_t>& Apply();
+
+    /// Replaces the byte code with a new one. All pending patches are discarded.
+    void Replace(std::vector<uint32_t>&& Code);
+
+    /// Returns true if the byte code has been copied from the original.
+    bool IsCopied() const { return m_pCode == &m_Copy; }
+
+    /// Returns the number of pending patches.
+    size_t GetNumPendingPatches() const { return m_Patches.size(); }
+
+private:
+    struct WordPatch
+    {
+        size_t   Offset;
+        uint32_t Value;
+    };
+
+    // Points either to the original byte code or to m_Copy.
+    const std::vector<uint32_t>* m_pCode = nullptr;
+
+    std::vector<uint32_t>  m_Copy;
+    std::vector<WordPatch> m_Patches;
+};
+
+} // namespace Diligent
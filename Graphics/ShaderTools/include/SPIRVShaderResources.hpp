@@ -46,6 +46,7 @@
 #include "STDAllocator.hpp"
 #include "RefCntAutoPtr.hpp"
 #include "StringPool.hpp"
+#include "Serializer.hpp"
 
 #ifdef DILIGENT_SPIRV_CROSS_NAMESPACE
 #    define diligent_spirv_cross DILIGENT_SPIRV_CROSS_NAMESPACE
@@ -111,6 +112,28 @@ struct SPIRVShaderResourceAttribs
                                Uint32                                _BufferStaticSize = 0,
                                Uint32                                _BufferStride     = 0) noexcept;
 
+    SPIRVShaderResourceAttribs(const char*        _Name,
+                               Uint16             _ArraySize,
+                               ResourceType       _Type,
+                               RESOURCE_DIMENSION _ResourceDim,
+                               bool               _IsMS,
+                               uint32_t           _BindingDecorationOffset,
+                               uint32_t           _DescriptorSetDecorationOffset,
+                               Uint32             _BufferStaticSize,
+                               Uint32             _BufferStride) noexcept :
+        // clang-format off
+        Name                          {_Name},
+        ArraySize                     {_ArraySize},
+        Type                          {_Type},
+        ResourceDim                   {static_cast<Uint8>(_ResourceDim)},
+        IsMS                          {_IsMS ? Uint8{1} : Uint8{0}},
+        BindingDecorationOffset       {_BindingDecorationOffset},
+        DescriptorSetDecorationOffset {_DescriptorSetDecorationOffset},
+        BufferStaticSize              {_BufferStaticSize},
+        BufferStride                  {_BufferStride}
+    // clang-format on
+    {}
+
     ShaderResourceDesc GetResourceDesc() const
     {
         return ShaderResourceDesc{Name, GetShaderResourceType(Type), ArraySize};
@@ -155,6 +178,20 @@ public:
                          bool                  LoadUniformBufferReflection,
                          std::string&          EntryPoint) noexcept(false);
 
+    /// Initializes the resources from the reflection data produced by SerializeReflection()
+    /// without parsing the SPIR-V byte code.
+    ///
+    /// \remarks The reflection data must contain all information requested by LoadShaderStageInputs
+    ///          and LoadUniformBufferReflection flags (see IsReflectionCompatible()).
+    ///          The constructor throws an exception if the data is invalid.
+    SPIRVShaderResources(IMemoryAllocator&     Allocator,
+                         const SerializedData& Reflection,
+                         const ShaderDesc&     shaderDesc,
+                         const char*           CombinedSamplerSuffix,
+                         bool                  LoadShaderStageInputs,
+                         bool                  LoadUniformBufferReflection,
+                         std::string&          EntryPoint) noexcept(false);
+
     // clang-format off
     SPIRVShaderResources             (const SPIRVShaderResources&)  = delete;
     SPIRVShaderResources             (      SPIRVShaderResources&&) = delete;
@@ -336,7 +373,26 @@ public:
     // Sets the input location decorations using the HLSL semantic names.
     void MapHLSLVertexShaderInputs(std::vector<uint32_t>& SPIRV) const;
 
+    /// Serializes the reflection data so that the resources can later be initialized
+    /// without parsing the SPIR-V byte code.
+    ///
+    /// \param [in] EntryPoint - Shader entry point name.
+    /// \param [in] Allocator  - Allocator for the serialized data.
+    ///
+    /// \remarks Resource names, decoration offsets, buffer sizes, shader stage inputs and
+    ///          uniform buffer reflection (if loaded) are serialized. The combined sampler suffix
+    ///          and the shader name are not serialized as they are defined by the shader description.
+    SerializedData SerializeReflection(const char* EntryPoint, IMemoryAllocator& Allocator) const;
+
+    /// Checks if the serialized reflection data is valid and contains all information requested by the flags.
+    static bool IsReflectionCompatible(const SerializedData& Reflection,
+                                       bool                  LoadShaderStageInputs,
+                                       bool                  LoadUniformBufferReflection) noexcept;
+
 private:
+    template <SerializerMode Mode>
+    bool SerializeReflection(Serializer<Mode>& Ser, const char* EntryPoint) const;
+
     void Initialize(IMemoryAllocator&       Allocator,
                     const ResourceCounters& Counters,
                     Uint32                  NumShaderStageInputs,
@@ -403,6 +459,29 @@ private:
 
     // Indicates if the shader was compiled from HLSL source.
     bool m_IsHLSLSource = false;
+
+    // Indicates if shader stage inputs were requested when the resources were loaded.
+    // Note that the inputs may still be empty, e.g. if the shader was not compiled from HLSL.
+    bool m_ShaderStageInputsRequested = false;
 };
 
+/// Appends the serialized reflection data (see SPIRVShaderResources::SerializeReflection())
+/// to the SPIR-V byte code so that it can be stored next to the SPIR-V, for example in a device
+/// object archive. The byte code must be split with FindSPIRVReflection() before it is used.
+std::vector<uint32_t> AppendSPIRVReflection(const std::vector<uint32_t>& SPIRV, const SerializedData& Reflection);
+
+/// Checks if the byte code contains SPIR-V with the reflection data appended by AppendSPIRVReflection().
+///
+/// \param [in]  pByteCode      - Byte code.
+/// \param [in]  ByteCodeSize   - Byte code size, in bytes.
+/// \param [out] SPIRVWordCount - The size of the SPIR-V part, in 32-bit words.
+/// \param [out] pReflection    - Pointer to the reflection data in the byte code.
+/// \param [out] ReflectionSize - The size of the reflection data, in bytes.
+/// \return  true if the byte code contains the reflection data, and false otherwise.
+bool FindSPIRVReflection(const void*  pByteCode,
+                         size_t       ByteCodeSize,
+                         size_t&      SPIRVWordCount,
+                         const void*& pReflection,
+                         size_t&      ReflectionSize) noexcept;
+
 } // namespace Diligent
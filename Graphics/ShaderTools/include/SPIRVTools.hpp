@@ -29,6 +29,7 @@
 #include <vector>
 
 #include "FlagEnum.h"
+#include "DataBlob.h"
 
 #include "spirv-tools/libspirv.h"
 
@@ -45,8 +46,61 @@ enum SPIRV_OPTIMIZATION_FLAGS : Uint32
 DEFINE_FLAG_ENUM_OPERATORS(SPIRV_OPTIMIZATION_FLAGS);
 
 
+/// Optimizes SPIR-V using the specified passes.
+
+/// \remarks   If the SPIR-V optimization cache is enabled (see SetSPIRVOptimizationCacheSize),
+///            the result is looked up in the cache by the hash of the source SPIR-V, target environment
+///            and optimization flags, and the optimizer only runs on a cache miss.
 std::vector<uint32_t> OptimizeSPIRV(const std::vector<uint32_t>& SrcSPIRV,
                                     spv_target_env               TargetEnv,
                                     SPIRV_OPTIMIZATION_FLAGS     Passes);
 
+
+/// SPIR-V optimization cache statistics.
+struct SPIRVOptimizationCacheStats
+{
+    /// The number of OptimizeSPIRV calls that found the result in the cache.
+    Uint64 NumHits = 0;
+
+    /// The number of OptimizeSPIRV calls that had to run the optimizer.
+    Uint64 NumMisses = 0;
+
+    /// The number of entries currently in the cache.
+    size_t NumEntries = 0;
+
+    /// The total size of the optimized SPIR-V currently in the cache, in bytes.
+    size_t DataSize = 0;
+};
+
+/// Sets the maximum size of the process-wide SPIR-V optimization cache.
+
+/// \param [in] MaxDataSize - The maximum total size, in bytes, of the optimized SPIR-V kept in the cache.
+///                           When the limit is exceeded, the least recently used entries are evicted.
+///                           Zero disables the cache and releases all entries (this is the default).
+void SetSPIRVOptimizationCacheSize(size_t MaxDataSize);
+
+/// Removes all entries from the SPIR-V optimization cache and resets the statistics.
+void ClearSPIRVOptimizationCache();
+
+/// Returns the SPIR-V optimization cache statistics.
+SPIRVOptimizationCacheStats GetSPIRVOptimizationCacheStats();
+
+/// Writes the contents of the SPIR-V optimization cache to a data blob.
+
+/// \param [out] ppData - Address of the memory location where the pointer to the data blob will be written.
+///
+/// \return     true if the data was written successfully, and false otherwise.
+///
+/// \remarks   The data can be saved to disk and loaded in another process with LoadSPIRVOptimizationCache.
+bool StoreSPIRVOptimizationCache(IDataBlob** ppData);
+
+/// Adds the entries from the data previously written by StoreSPIRVOptimizationCache to the cache.
+
+/// \return     true if the data was loaded successfully, and false otherwise.
+///
+/// \remarks   The cache must be enabled by SetSPIRVOptimizationCacheSize before loading the data.
+///            Data written by a different version of the cache format or SPIRV-Tools is ignored.
+///            Corrupted data is rejected as a whole and does not modify the cache.
+bool LoadSPIRVOptimizationCache(const IDataBlob* pData);
+
 } // namespace Diligent
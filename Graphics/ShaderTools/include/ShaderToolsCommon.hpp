@@ -30,6 +30,7 @@
 #include <functional>
 #include <string>
 #include <memory>
+#include <vector>
 
 #include "GraphicsTypes.h"
 #include "Shader.h"
@@ -137,6 +138,11 @@ struct ShaderIncludePreprocessInfo
 /// Includes are processed in a depth-first order such that original source file is processed last.
 bool ProcessShaderIncludes(const ShaderCreateInfo& ShaderCI, std::function<void(const ShaderIncludePreprocessInfo&)> IncludeHandler) noexcept;
 
+/// Finds all include directives in the source and adds the included file paths to the Includes
+/// vector in the order they appear. Included files are not processed recursively.
+/// FilePath is only used for error reporting and may be null.
+bool FindShaderIncludes(const char* Source, size_t SourceLength, std::vector<std::string>& Includes, const char* FilePath = nullptr) noexcept;
+
 ///  Unrolls all include files into a single file
 std::string UnrollShaderIncludes(const ShaderCreateInfo& ShaderCI) noexcept(false);
 
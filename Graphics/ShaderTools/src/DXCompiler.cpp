@@ -34,6 +34,12 @@
 #include <atomic>
 #include <array>
 #include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
 
 #if PLATFORM_WIN32 || PLATFORM_UNIVERSAL_WINDOWS
 #    include "WinHPreface.h"
@@ -58,13 +64,18 @@
 #include "DXCompiler.hpp"
 
 #include "DataBlobImpl.hpp"
+#include "ProxyDataBlob.hpp"
 #include "RefCntAutoPtr.hpp"
+#include "FileWrapper.hpp"
+#include "FileSystem.hpp"
 #include "ShaderToolsCommon.hpp"
 
 #include "HLSLUtils.hpp"
 
 #include "dxc/DxilContainer/DxilContainer.h"
 
+#include "xxhash.h"
+
 namespace Diligent
 {
 
@@ -73,6 +84,95 @@ namespace
 constexpr Uint32 VK_API_VERSION_1_1 = (1u << 22) | (1u << 12);
 constexpr Uint32 VK_API_VERSION_1_2 = (1u << 22) | (2u << 12);
 
+// DXC objects used by a single thread
+struct DxcSession
+{
+    CComPtr<IDxcLibrary>   pLibrary;
+    CComPtr<IDxcCompiler>  pCompiler;
+    CComPtr<IDxcValidator> pValidator;
+};
+
+// Sessions of all threads that used a compiler. The registry is shared with the
+// threads so that they can release their sessions when they exit.
+struct DxcSessionRegistry
+{
+    std::mutex                                      Mtx;
+    std::unordered_map<std::thread::id, DxcSession> Sessions;
+
+    void ReleaseSession(std::thread::id ThreadId)
+    {
+        DxcSession Session;
+        {
+            std::lock_guard<std::mutex> Lock{Mtx};
+
+            auto it = Sessions.find(ThreadId);
+            if (it == Sessions.end())
+                return;
+            Session = std::move(it->second);
+            Sessions.erase(it);
+        }
+        // Release the DXC objects outside of the lock
+    }
+};
+
+// Releases the sessions of the current thread in all compilers when the thread exits
+class DxcThreadSessions
+{
+public:
+    static void Register(const std::shared_ptr<DxcSessionRegistry>& pRegistry)
+    {
+        thread_local DxcThreadSessions ThreadSessions;
+        ThreadSessions.Add(pRegistry);
+    }
+
+    ~DxcThreadSessions()
+    {
+        const std::thread::id ThreadId = std::this_thread::get_id();
+        for (const std::weak_ptr<DxcSessionRegistry>& wpRegistry : m_Registries)
+        {
+            if (std::shared_ptr<DxcSessionRegistry> pRegistry = wpRegistry.lock())
+                pRegistry->ReleaseSession(ThreadId);
+        }
+    }
+
+private:
+    void Add(const std::shared_ptr<DxcSessionRegistry>& pRegistry)
+    {
+        // Remove registries of the compilers that have been destroyed
+        m_Registries.erase(std::remove_if(m_Registries.begin(), m_Registries.end(),
+                                          [](const std::weak_ptr<DxcSessionRegistry>& wpRegistry) { return wpRegistry.expired(); }),
+                           m_Registries.end());
+
+        for (const std::weak_ptr<DxcSessionRegistry>& wpRegistry : m_Registries)
+        {
+            if (wpRegistry.lock() == pRegistry)
+                return;
+        }
+        m_Registries.emplace_back(pRegistry);
+    }
+
+private:
+    std::vector<std::weak_ptr<DxcSessionRegistry>> m_Registries;
+};
+
+struct DxcCacheKey
+{
+    Uint64 Low  = 0;
+    Uint64 High = 0;
+};
+
+constexpr Uint32 DxcCacheEntryMagic   = 0x43435844; // 'DXCC'
+constexpr Uint32 DxcCacheEntryVersion = 1;
+
+struct DxcCacheEntryHeader
+{
+    Uint32 Magic    = DxcCacheEntryMagic;
+    Uint32 Version  = DxcCacheEntryVersion;
+    Uint64 KeyLow   = 0;
+    Uint64 KeyHigh  = 0;
+    Uint64 DataSize = 0;
+};
+
 
 class DXCompilerImpl final : public IDXCompiler
 {
@@ -82,6 +182,14 @@ public:
         m_APIVersion{APIVersion}
     {}
 
+    ~DXCompilerImpl()
+    {
+        // Threads that are still running may keep the registry alive. Release all sessions
+        // now so that they are not destroyed after the library has been unloaded.
+        std::lock_guard<std::mutex> Lock{m_pSessionRegistry->Mtx};
+        m_pSessionRegistry->Sessions.clear();
+    }
+
     ShaderVersion GetMaxShaderModel() override final
     {
         // Force loading the library
@@ -122,8 +230,44 @@ public:
                                        IDxcBlob*                  pSrcBytecode,
                                        IDxcBlob**                 ppDstByteCode) override final;
 
+    virtual void SetCompilationCacheDirectory(const char* Path) override final;
+
+    virtual CompilationCacheStats GetCompilationCacheStats() const override final
+    {
+        CompilationCacheStats Stats;
+        Stats.NumHits   = m_NumCacheHits.load();
+        Stats.NumMisses = m_NumCacheMisses.load();
+        return Stats;
+    }
+
+    virtual void SetSessionPoolingEnabled(bool Enabled) override final
+    {
+        m_SessionPoolingEnabled.store(Enabled);
+        if (!Enabled)
+        {
+            std::lock_guard<std::mutex> Lock{m_pSessionRegistry->Mtx};
+            m_pSessionRegistry->Sessions.clear();
+        }
+    }
+
 private:
-    bool ValidateAndSign(DxcCreateInstanceProc CreateInstance, IDxcLibrary* pdxcLibrary, CComPtr<IDxcBlob>& pCompiled, IDxcBlob** ppOutput) const noexcept(false);
+    bool ValidateAndSign(IDxcValidator* pdxcValidator, IDxcLibrary* pdxcLibrary, CComPtr<IDxcBlob>& pCompiled, IDxcBlob** ppOutput) const noexcept(false);
+
+    DxcSession CreateSession(DxcCreateInstanceProc CreateInstance) const noexcept(false);
+    DxcSession GetSession(DxcCreateInstanceProc CreateInstance) noexcept(false);
+
+    bool ComputeCacheKey(const DxcSession&     Session,
+                         IDxcBlob*             pSourceBlob,
+                         IDxcIncludeHandler*   pIncludeHandler,
+                         const CompileAttribs& Attribs,
+                         DxcCacheKey&          Key) const;
+
+    std::string GetCacheDirectory() const;
+
+    static std::string GetCacheFilePath(std::string CacheDir, const DxcCacheKey& Key);
+
+    static bool LoadCachedByteCode(const std::string& FilePath, const DxcCacheKey& Key, IDxcBlob** ppByteCode);
+    static void StoreCachedByteCode(const std::string& FilePath, const DxcCacheKey& Key, IDxcBlob* pByteCode);
 
     enum RES_TYPE : Uint32
     {
@@ -161,6 +305,18 @@ private:
 private:
     DXCompilerLibrary m_Library;
     const Uint32      m_APIVersion;
+
+    // DXC sessions of all threads that used the compiler. Every session is only used
+    // by its thread, so the mutex only protects the map itself. A session is released
+    // when its thread exits (see DxcThreadSessions).
+    const std::shared_ptr<DxcSessionRegistry> m_pSessionRegistry = std::make_shared<DxcSessionRegistry>();
+    std::atomic<bool>                         m_SessionPoolingEnabled{true};
+
+    mutable std::mutex m_CacheDirMtx;
+    std::string        m_CacheDir;
+
+    std::atomic<Uint32> m_NumCacheHits{0};
+    std::atomic<Uint32> m_NumCacheMisses{0};
 };
 
 #define CHECK_D3D_RESULT(Expr, Message)   \
@@ -210,11 +366,24 @@ public:
         if (fileName.size() > 2 && fileName[0] == '.' && (fileName[1] == '\\' || fileName[1] == '/'))
             fileName.erase(0, 2);
 
+        // The same handler is used to preprocess and then compile the source, so
+        // the files are only loaded (and the errors are only reported) once.
+        auto LoadedIt = m_LoadedFiles.find(fileName);
+        if (LoadedIt != m_LoadedFiles.end())
+        {
+            if (!LoadedIt->second)
+                return E_FAIL;
+
+            LoadedIt->second->QueryInterface(IID_PPV_ARGS(ppIncludeSource));
+            return S_OK;
+        }
+
         RefCntAutoPtr<IFileStream> pSourceStream;
         m_pStreamFactory->CreateInputStream(fileName.c_str(), &pSourceStream);
         if (pSourceStream == nullptr)
         {
             LOG_ERROR("Failed to open shader include file ", fileName, ". Check that the file exists");
+            m_LoadedFiles.emplace(std::move(fileName), nullptr);
             return E_FAIL;
         }
 
@@ -233,6 +402,7 @@ public:
         m_FileDataCache.emplace_back(std::move(pFileData));
 
         pSourceBlob->QueryInterface(IID_PPV_ARGS(ppIncludeSource));
+        m_LoadedFiles.emplace(std::move(fileName), std::move(pSourceBlob));
         return S_OK;
     }
 
@@ -257,6 +427,8 @@ private:
     IShaderSourceInputStreamFactory* const m_pStreamFactory;
     std::atomic_long                       m_RefCount{0};
     std::vector<RefCntAutoPtr<IDataBlob>>  m_FileDataCache;
+
+    std::unordered_map<String, CComPtr<IDxcBlobEncoding>> m_LoadedFiles;
 };
 
 class DxcBlobWrapper final : public IDxcBlob
@@ -331,6 +503,213 @@ std::unique_ptr<IDXCompiler> CreateDXCompiler(DXCompilerTarget Target, Uint32 AP
     return std::make_unique<DXCompilerImpl>(Target, APIVersion, pLibraryName);
 }
 
+DxcSession DXCompilerImpl::CreateSession(DxcCreateInstanceProc CreateInstance) const noexcept(false)
+{
+    DxcSession Session;
+    CHECK_D3D_RESULT(CreateInstance(CLSID_DxcLibrary, IID_PPV_ARGS(&Session.pLibrary)), "Failed to create DXC Library");
+    CHECK_D3D_RESULT(CreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&Session.pCompiler)), "Failed to create DXC Compiler");
+    if (m_Library.GetTarget() == DXCompilerTarget::Direct3D12)
+    {
+        CHECK_D3D_RESULT(CreateInstance(CLSID_DxcValidator, IID_PPV_ARGS(&Session.pValidator)), "Failed to create DXC Validator");
+    }
+    return Session;
+}
+
+DxcSession DXCompilerImpl::GetSession(DxcCreateInstanceProc CreateInstance) noexcept(false)
+{
+    // NOTE: The call to DxcCreateInstance is thread-safe, but objects created by DxcCreateInstance aren't thread-safe.
+    // Compiler objects should be created and then used on the same thread.
+    // https://github.com/microsoft/DirectXShaderCompiler/wiki/Using-dxc.exe-and-dxcompiler.dll#dxcompiler-dll-interface
+    if (!m_SessionPoolingEnabled.load())
+        return CreateSession(CreateInstance);
+
+    const std::thread::id ThreadId = std::this_thread::get_id();
+    {
+        std::lock_guard<std::mutex> Lock{m_pSessionRegistry->Mtx};
+
+        auto it = m_pSessionRegistry->Sessions.find(ThreadId);
+        if (it != m_pSessionRegistry->Sessions.end())
+            return it->second;
+    }
+
+    DxcSession Session = CreateSession(CreateInstance);
+    {
+        std::lock_guard<std::mutex> Lock{m_pSessionRegistry->Mtx};
+        m_pSessionRegistry->Sessions.emplace(ThreadId, Session);
+    }
+    DxcThreadSessions::Register(m_pSessionRegistry);
+
+    return Session;
+}
+
+void DXCompilerImpl::SetCompilationCacheDirectory(const char* Path)
+{
+    std::string CacheDir{Path != nullptr ? Path : ""};
+    if (!CacheDir.empty() && !FileSystem::PathExists(CacheDir.c_str()))
+    {
+        if (!FileSystem::CreateDirectory(CacheDir.c_str()))
+        {
+            LOG_ERROR_MESSAGE("Failed to create DXC compilation cache directory '", CacheDir, "'. The cache will be disabled.");
+            CacheDir.clear();
+        }
+    }
+
+    std::lock_guard<std::mutex> Lock{m_CacheDirMtx};
+    m_CacheDir = std::move(CacheDir);
+}
+
+std::string DXCompilerImpl::GetCacheDirectory() const
+{
+    std::lock_guard<std::mutex> Lock{m_CacheDirMtx};
+    return m_CacheDir;
+}
+
+std::string DXCompilerImpl::GetCacheFilePath(std::string CacheDir, const DxcCacheKey& Key)
+{
+    VERIFY_EXPR(!CacheDir.empty());
+    std::string FilePath = std::move(CacheDir);
+    if (!FileSystem::IsSlash(FilePath.back()))
+        FilePath.push_back(FileSystem::SlashSymbol);
+
+    char Name[40];
+    snprintf(Name, sizeof(Name), "%016llx%016llx.dxc", static_cast<unsigned long long>(Key.High), static_cast<unsigned long long>(Key.Low));
+    FilePath.append(Name);
+    return FilePath;
+}
+
+bool DXCompilerImpl::ComputeCacheKey(const DxcSession&     Session,
+                                     IDxcBlob*             pSourceBlob,
+                                     IDxcIncludeHandler*   pIncludeHandler,
+                                     const CompileAttribs& Attribs,
+                                     DxcCacheKey&          Key) const
+{
+    // Compiler builds that report the same version can't be told apart without the build identity
+    if (m_Library.GetBuildId().empty())
+        return false;
+
+    // Hashing the preprocessed source accounts for the included files and the defines
+    CComPtr<IDxcOperationResult> pdxcResult;
+    HRESULT                      hr = Session.pCompiler->Preprocess(
+        pSourceBlob,
+        L"",
+        Attribs.pArgs, UINT32{Attribs.ArgsCount},
+        Attribs.pDefines, UINT32{Attribs.DefinesCount},
+        pIncludeHandler,
+        &pdxcResult);
+    if (FAILED(hr) || !pdxcResult)
+        return false;
+
+    HRESULT status = E_FAIL;
+    if (FAILED(pdxcResult->GetStatus(&status)) || FAILED(status))
+        return false;
+
+    CComPtr<IDxcBlob> pPreprocessed;
+    if (FAILED(pdxcResult->GetResult(&pPreprocessed)) || !pPreprocessed)
+        return false;
+
+    XXH3_state_t* pState = XXH3_createState();
+    XXH3_128bits_reset(pState);
+
+    const auto HashString = [pState](const wchar_t* Str) {
+        if (Str == nullptr)
+            Str = L"";
+        // Include the terminating null so that adjacent strings are delimited
+        XXH3_128bits_update(pState, Str, (wcslen(Str) + 1) * sizeof(wchar_t));
+    };
+
+    const Uint32 CompilerInfo[] =
+        {
+            DxcCacheEntryVersion,
+            static_cast<Uint32>(m_Library.GetTarget()),
+            m_APIVersion,
+        };
+    XXH3_128bits_update(pState, CompilerInfo, sizeof(CompilerInfo));
+    // Build identity distinguishes compiler builds that report the same version
+    const std::string& BuildId = m_Library.GetBuildId();
+    XXH3_128bits_update(pState, BuildId.c_str(), BuildId.length() + 1);
+    XXH3_128bits_update(pState, m_Library.GetLibName().c_str(), m_Library.GetLibName().length() + 1);
+
+    XXH3_128bits_update(pState, pPreprocessed->GetBufferPointer(), pPreprocessed->GetBufferSize());
+    HashString(Attribs.EntryPoint);
+    HashString(Attribs.Profile);
+    for (Uint32 i = 0; i < Attribs.DefinesCount; ++i)
+    {
+        HashString(Attribs.pDefines[i].Name);
+        HashString(Attribs.pDefines[i].Value);
+    }
+    for (Uint32 i = 0; i < Attribs.ArgsCount; ++i)
+        HashString(Attribs.pArgs[i]);
+
+    const XXH128_hash_t Hash = XXH3_128bits_digest(pState);
+    XXH3_freeState(pState);
+
+    Key.Low  = Hash.low64;
+    Key.High = Hash.high64;
+    return true;
+}
+
+bool DXCompilerImpl::LoadCachedByteCode(const std::string& FilePath, const DxcCacheKey& Key, IDxcBlob** ppByteCode)
+{
+    if (!FileSystem::FileExists(FilePath.c_str()))
+        return false;
+
+    RefCntAutoPtr<IDataBlob> pFileData;
+    if (!FileWrapper::ReadWholeFile(FilePath.c_str(), &pFileData, /*Silent = */ true))
+        return false;
+
+    const size_t FileSize = pFileData->GetSize();
+    if (FileSize < sizeof(DxcCacheEntryHeader))
+        return false;
+
+    DxcCacheEntryHeader Header;
+    memcpy(&Header, pFileData->GetConstDataPtr(), sizeof(Header));
+    if (Header.Magic != DxcCacheEntryMagic ||
+        Header.Version != DxcCacheEntryVersion ||
+        Header.KeyLow != Key.Low ||
+        Header.KeyHigh != Key.High ||
+        Header.DataSize == 0 ||
+        Header.DataSize != FileSize - sizeof(Header))
+    {
+        LOG_WARNING_MESSAGE("DXC compilation cache entry '", FilePath, "' is invalid and will be ignored.");
+        return false;
+    }
+
+    RefCntAutoPtr<IDataBlob> pByteCode = ProxyDataBlob::Create(pFileData->GetDataPtr(sizeof(Header)), static_cast<size_t>(Header.DataSize), pFileData);
+    CreateDxcBlobWrapper(pByteCode, ppByteCode);
+    return true;
+}
+
+void DXCompilerImpl::StoreCachedByteCode(const std::string& FilePath, const DxcCacheKey& Key, IDxcBlob* pByteCode)
+{
+    DxcCacheEntryHeader Header;
+    Header.KeyLow   = Key.Low;
+    Header.KeyHigh  = Key.High;
+    Header.DataSize = pByteCode->GetBufferSize();
+
+    // Write to a temporary file first so that other threads and processes never see a partially written entry
+    std::stringstream TmpPathSS;
+    TmpPathSS << FilePath << '.' << std::this_thread::get_id() << ".tmp";
+    const std::string TmpPath = TmpPathSS.str();
+
+    bool Written = false;
+    {
+        FileWrapper File{TmpPath.c_str(), EFileAccessMode::Overwrite};
+        if (File)
+        {
+            Written = (File->Write(&Header, sizeof(Header)) &&
+                       File->Write(pByteCode->GetBufferPointer(), pByteCode->GetBufferSize()));
+        }
+    }
+
+    // If another thread has already stored the same entry, rename may fail, which is fine.
+    if (!Written || std::rename(TmpPath.c_str(), FilePath.c_str()) != 0)
+    {
+        if (!Written)
+            LOG_WARNING_MESSAGE("Failed to write DXC compilation cache entry '", FilePath, "'.");
+        FileSystem::DeleteFile(TmpPath.c_str());
+    }
+}
+
 bool DXCompilerImpl::Compile(const CompileAttribs& Attribs)
 {
     try
@@ -349,20 +728,36 @@ bool DXCompilerImpl::Compile(const CompileAttribs& Attribs)
 
         HRESULT hr;
 
-        // NOTE: The call to DxcCreateInstance is thread-safe, but objects created by DxcCreateInstance aren't thread-safe.
-        // Compiler objects should be created and then used on the same thread.
-        // https://github.com/microsoft/DirectXShaderCompiler/wiki/Using-dxc.exe-and-dxcompiler.dll#dxcompiler-dll-interface
-
-        CComPtr<IDxcLibrary> pdxcLibrary;
-        CHECK_D3D_RESULT(CreateInstance(CLSID_DxcLibrary, IID_PPV_ARGS(&pdxcLibrary)), "Failed to create DXC Library");
-
-        CComPtr<IDxcCompiler> pdxcCompiler;
-        CHECK_D3D_RESULT(CreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&pdxcCompiler)), "Failed to create DXC Compiler");
+        const DxcSession    Session      = GetSession(CreateInstance);
+        IDxcLibrary* const  pdxcLibrary  = Session.pLibrary;
+        IDxcCompiler* const pdxcCompiler = Session.pCompiler;
 
         CComPtr<IDxcBlobEncoding> pSourceBlob;
         CHECK_D3D_RESULT(pdxcLibrary->CreateBlobWithEncodingFromPinned(Attribs.Source, UINT32{Attribs.SourceLength}, CP_UTF8, &pSourceBlob), "Failed to create DXC Blob Encoding");
 
         DxcIncludeHandlerImpl IncludeHandler{Attribs.pShaderSourceStreamFactory, pdxcLibrary};
+        IDxcIncludeHandler*   pIncludeHandler = Attribs.pShaderSourceStreamFactory ? &IncludeHandler : nullptr;
+
+        std::string CacheFilePath = GetCacheDirectory();
+        DxcCacheKey CacheKey;
+        if (!CacheFilePath.empty())
+        {
+            // If preprocessing fails, compile the shader anyway to report the errors
+            if (ComputeCacheKey(Session, pSourceBlob, pIncludeHandler, Attribs, CacheKey))
+            {
+                CacheFilePath = GetCacheFilePath(std::move(CacheFilePath), CacheKey);
+                if (LoadCachedByteCode(CacheFilePath, CacheKey, Attribs.ppBlobOut))
+                {
+                    m_NumCacheHits.fetch_add(1);
+                    return true;
+                }
+                m_NumCacheMisses.fetch_add(1);
+            }
+            else
+            {
+                CacheFilePath.clear();
+            }
+        }
 
         CComPtr<IDxcOperationResult> pdxcResult;
         hr = pdxcCompiler->Compile(
@@ -372,7 +767,7 @@ bool DXCompilerImpl::Compile(const CompileAttribs& Attribs)
             Attribs.Profile,
             Attribs.pArgs, UINT32{Attribs.ArgsCount},
             Attribs.pDefines, UINT32{Attribs.DefinesCount},
-            Attribs.pShaderSourceStreamFactory ? &IncludeHandler : nullptr,
+            pIncludeHandler,
             &pdxcResult);
 
         if (SUCCEEDED(hr))
@@ -403,13 +798,18 @@ bool DXCompilerImpl::Compile(const CompileAttribs& Attribs)
         // Validate and sign
         if (m_Library.GetTarget() == DXCompilerTarget::Direct3D12)
         {
-            return ValidateAndSign(CreateInstance, pdxcLibrary, pCompiledBlob, Attribs.ppBlobOut);
+            if (!ValidateAndSign(Session.pValidator, pdxcLibrary, pCompiledBlob, Attribs.ppBlobOut))
+                return false;
         }
         else
         {
             *Attribs.ppBlobOut = pCompiledBlob.Detach();
-            return true;
         }
+
+        if (!CacheFilePath.empty() && *Attribs.ppBlobOut != nullptr)
+            StoreCachedByteCode(CacheFilePath, CacheKey, *Attribs.ppBlobOut);
+
+        return true;
     }
     catch (...)
     {
@@ -417,11 +817,8 @@ bool DXCompilerImpl::Compile(const CompileAttribs& Attribs)
     }
 }
 
-bool DXCompilerImpl::ValidateAndSign(DxcCreateInstanceProc CreateInstance, IDxcLibrary* library, CComPtr<IDxcBlob>& compiled, IDxcBlob** ppBlobOut) const noexcept(false)
+bool DXCompilerImpl::ValidateAndSign(IDxcValidator* pdxcValidator, IDxcLibrary* library, CComPtr<IDxcBlob>& compiled, IDxcBlob** ppBlobOut) const noexcept(false)
 {
-    CComPtr<IDxcValidator> pdxcValidator;
-    CHECK_D3D_RESULT(CreateInstance(CLSID_DxcValidator, IID_PPV_ARGS(&pdxcValidator)), "Failed to create DXC Validator");
-
     CComPtr<IDxcOperationResult> pdxcResult;
     CHECK_D3D_RESULT(pdxcValidator->Validate(compiled, DxcValidatorFlags_InPlaceEdit, &pdxcResult), "Failed to validate shader bytecode");
 
@@ -833,15 +1230,13 @@ bool DXCompilerImpl::RemapResourceBindings(const TResourceBindingMap& ResourceMa
             return false;
         }
 
-        CComPtr<IDxcLibrary> pdxcLibrary;
-        CHECK_D3D_RESULT(CreateInstance(CLSID_DxcLibrary, IID_PPV_ARGS(&pdxcLibrary)), "Failed to create DXC Library");
+        const DxcSession    Session      = GetSession(CreateInstance);
+        IDxcLibrary* const  pdxcLibrary  = Session.pLibrary;
+        IDxcCompiler* const pdxcCompiler = Session.pCompiler;
 
         CComPtr<IDxcAssembler> pdxcAssembler;
         CHECK_D3D_RESULT(CreateInstance(CLSID_DxcAssembler, IID_PPV_ARGS(&pdxcAssembler)), "Failed to create DXC assembler");
 
-        CComPtr<IDxcCompiler> pdxcCompiler;
-        CHECK_D3D_RESULT(CreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&pdxcCompiler)), "Failed to create DXC Compiler");
-
         CComPtr<IDxcBlobEncoding> pdxcDisasm;
         CHECK_D3D_RESULT(pdxcCompiler->Disassemble(pSrcBytecode, &pdxcDisasm), "Failed to disassemble bytecode");
 
@@ -994,7 +1389,11 @@ bool DXCompilerImpl::RemapResourceBindings(const TResourceBindingMap& ResourceMa
         CComPtr<IDxcBlob> pCompiledBlob;
         CHECK_D3D_RESULT(pdxcResult->GetResult(static_cast<IDxcBlob**>(&pCompiledBlob)), "Failed to get compiled blob from DXC result");
 
-        return ValidateAndSign(CreateInstance, pdxcLibrary, pCompiledBlob, ppDstByteCode);
+        CComPtr<IDxcValidator> pdxcValidator = Session.pValidator;
+        if (!pdxcValidator)
+            CHECK_D3D_RESULT(CreateInstance(CLSID_DxcValidator, IID_PPV_ARGS(&pdxcValidator)), "Failed to create DXC Validator");
+
+        return ValidateAndSign(pdxcValidator, pdxcLibrary, pCompiledBlob, ppDstByteCode);
     }
     catch (...)
     {
@@ -59,6 +59,54 @@ void DXCompilerLibrary::InitVersion()
     {
         UNEXPECTED("Failed to create DXC validator instance");
     }
+
+    InitBuildId();
+}
+
+void DXCompilerLibrary::InitBuildId()
+{
+    VERIFY_EXPR(m_DxcCreateInstance != nullptr);
+
+    CComPtr<IDxcCompiler> pdxcCompiler;
+    if (FAILED(m_DxcCreateInstance(CLSID_DxcCompiler, IID_PPV_ARGS(&pdxcCompiler))))
+        return;
+
+    CComPtr<IDxcVersionInfo2> pdxcVerInfo2;
+    if (SUCCEEDED(pdxcCompiler->QueryInterface(IID_PPV_ARGS(&pdxcVerInfo2))))
+    {
+        UINT32 MajorVer    = 0;
+        UINT32 MinorVer    = 0;
+        UINT32 Flags       = 0;
+        UINT32 CommitCount = 0;
+        char*  CommitHash  = nullptr;
+        pdxcVerInfo2->GetVersion(&MajorVer, &MinorVer);
+        pdxcVerInfo2->GetFlags(&Flags);
+        if (SUCCEEDED(pdxcVerInfo2->GetCommitInfo(&CommitCount, &CommitHash)) && CommitHash != nullptr)
+        {
+            m_BuildId = std::to_string(MajorVer) + '.' + std::to_string(MinorVer) +
+                " flags " + std::to_string(Flags) +
+                " commit " + std::to_string(CommitCount) + '-' + CommitHash;
+        }
+        if (CommitHash != nullptr)
+            CoTaskMemFree(CommitHash);
+    }
+
+    if (m_BuildId.empty())
+    {
+        LOG_WARNING_MESSAGE("DX Shader Compiler does not report the commit information. The compilation cache will be disabled.");
+        return;
+    }
+
+    // Custom builds may report the same commit
+    CComPtr<IDxcVersionInfo3> pdxcVerInfo3;
+    if (SUCCEEDED(pdxcCompiler->QueryInterface(IID_PPV_ARGS(&pdxcVerInfo3))))
+    {
+        char* CustomVersion = nullptr;
+        if (SUCCEEDED(pdxcVerInfo3->GetCustomVersionString(&CustomVersion)) && CustomVersion != nullptr)
+            m_BuildId.append(" ").append(CustomVersion);
+        if (CustomVersion != nullptr)
+            CoTaskMemFree(CustomVersion);
+    }
 }
 
 #define CHECK_D3D_RESULT(Expr, Message)   \
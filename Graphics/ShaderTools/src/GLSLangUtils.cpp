@@ -31,6 +31,7 @@
 #include <unordered_map>
 #include <memory>
 #include <array>
+#include <atomic>
 
 #ifdef VK_USE_PLATFORM_METAL_EXT
 #    include <MoltenGLSLToSPIRVConverter/GLSLToSPIRVConverter.h>
@@ -47,6 +48,7 @@
 #include "DataBlobImpl.hpp"
 #include "RefCntAutoPtr.hpp"
 #include "ShaderToolsCommon.hpp"
+#include "ParsingTools.hpp"
 #ifdef USE_SPIRV_TOOLS
 #    include "SPIRVTools.hpp"
 #endif
@@ -403,6 +405,52 @@ void SetupWithSpirvVersion(::glslang::TShader&  Shader,
     }
 }
 
+// Returns HLSL definitions with comments and empty lines removed.
+// The definitions are stripped once and shared by all threads.
+const std::string& GetStrippedHLSLDefinitions()
+{
+    static const std::string StrippedDefinitions = []() {
+        // Exclude the terminating null character
+        const char* const DefinitionsEnd = &g_HLSLDefinitions[0] + sizeof(g_HLSLDefinitions) - 1;
+        try
+        {
+            return Parsing::StripCommentsAndEmptyLines(&g_HLSLDefinitions[0], DefinitionsEnd);
+        }
+        catch (...)
+        {
+            UNEXPECTED("Failed to strip comments from HLSL definitions");
+            return std::string{&g_HLSLDefinitions[0], DefinitionsEnd};
+        }
+    }();
+    return StrippedDefinitions;
+}
+
+// Returns the part of the HLSL preamble that only depends on the shader type and
+// matrix packing. Preambles are built once per thread and reused by all subsequent
+// compilations, so that the definitions are not re-assembled for every shader.
+const std::string& GetHLSLPreamblePrefix(SHADER_TYPE ShaderType, bool PackMatrixRowMajor)
+{
+    static thread_local std::unordered_map<Uint32, std::string> Prefixes;
+
+    const Uint32 Key = (static_cast<Uint32>(ShaderType) << 1u) | (PackMatrixRowMajor ? 1u : 0u);
+
+    auto it = Prefixes.find(Key);
+    if (it == Prefixes.end())
+    {
+        std::string Prefix;
+        if (PackMatrixRowMajor)
+            Prefix += "#pragma pack_matrix(row_major)\n\n";
+        Prefix.append("#define GLSLANG\n\n");
+        Prefix.append(GetStrippedHLSLDefinitions());
+        AppendShaderTypeDefinitions(Prefix, ShaderType);
+
+        it = Prefixes.emplace(Key, std::move(Prefix)).first;
+    }
+    return it->second;
+}
+
+std::atomic<bool> g_UseCachedHLSLPreamble{true};
+
 #ifdef USE_SPIRV_TOOLS
 spv_target_env SpirvVersionToSpvTargetEnv(SpirvVersion Version)
 {
@@ -426,6 +474,11 @@ spv_target_env SpirvVersionToSpvTargetEnv(SpirvVersion Version)
 
 } // namespace
 
+void SetUseCachedHLSLPreamble(bool UseCached)
+{
+    g_UseCachedHLSLPreamble.store(UseCached, std::memory_order_relaxed);
+}
+
 std::vector<unsigned int> HLSLtoSPIRV(const ShaderCreateInfo& ShaderCI,
                                       SpirvVersion            Version,
                                       const char*             ExtraDefinitions,
@@ -451,12 +504,23 @@ std::vector<unsigned int> HLSLtoSPIRV(const ShaderCreateInfo& ShaderCI,
 
     const ShaderSourceFileData SourceData = ReadShaderSourceFile(ShaderCI);
 
-    std::string Preamble;
-    if ((ShaderCI.CompileFlags & SHADER_COMPILE_FLAG_PACK_MATRIX_ROW_MAJOR) != 0)
-        Preamble += "#pragma pack_matrix(row_major)\n\n";
-    Preamble.append("#define GLSLANG\n\n");
-    Preamble.append(g_HLSLDefinitions);
-    AppendShaderTypeDefinitions(Preamble, ShaderCI.Desc.ShaderType);
+    const bool PackMatrixRowMajor = (ShaderCI.CompileFlags & SHADER_COMPILE_FLAG_PACK_MATRIX_ROW_MAJOR) != 0;
+
+    // Reuse the thread's preamble buffer to avoid allocating it for every shader
+    static thread_local std::string Preamble;
+    if (g_UseCachedHLSLPreamble.load(std::memory_order_relaxed))
+    {
+        Preamble = GetHLSLPreamblePrefix(ShaderCI.Desc.ShaderType, PackMatrixRowMajor);
+    }
+    else
+    {
+        Preamble.clear();
+        if (PackMatrixRowMajor)
+            Preamble += "#pragma pack_matrix(row_major)\n\n";
+        Preamble.append("#define GLSLANG\n\n");
+        Preamble.append(g_HLSLDefinitions);
+        AppendShaderTypeDefinitions(Preamble, ShaderCI.Desc.ShaderType);
+    }
 
     if (ExtraDefinitions != nullptr)
         Preamble += ExtraDefinitions;
@@ -34,8 +34,8 @@ namespace Diligent
 namespace Parsing
 {
 
-static std::pair<std::string, TEXTURE_FORMAT> ParseRWTextureDefinition(HLSLTokenizer::TokenListType::const_iterator& Token,
-                                                                       HLSLTokenizer::TokenListType::const_iterator  End)
+static std::pair<std::string, TEXTURE_FORMAT> ParseRWTextureDefinition(HLSLTokenizer::TokenRecordListType::const_iterator& Token,
+                                                                       HLSLTokenizer::TokenRecordListType::const_iterator  End)
 {
     // RWTexture2D<unorm  /*format=rg8*/ float4>  g_RWTex;
     // ^
@@ -43,11 +43,11 @@ static std::pair<std::string, TEXTURE_FORMAT> ParseRWTextureDefinition(HLSLToken
     ++Token;
     // RWTexture2D<unorm  /*format=rg8*/ float4>  g_RWTex;
     //            ^
-    if (Token == End || Token->Literal != "<")
+    if (Token == End || !Token->CompareLiteral("<"))
         return {};
 
     TEXTURE_FORMAT Fmt = TEX_FORMAT_UNKNOWN;
-    while (Token != End && Token->Literal != ">")
+    while (Token != End && !Token->CompareLiteral(">"))
     {
         ++Token;
         if (Token != End)
@@ -58,7 +58,8 @@ static std::pair<std::string, TEXTURE_FORMAT> ParseRWTextureDefinition(HLSLToken
             //                                   ^
             // RWTexture2D< unorm float4 /*format=rg8*/> g_RWTex;
             //                                         ^
-            std::string FormatStr = ExtractGLSLImageFormatFromComment(Token->Delimiter.begin(), Token->Delimiter.end());
+            const auto  Delimiter = Token->GetDelimiter();
+            std::string FormatStr = ExtractGLSLImageFormatFromComment(Delimiter.first, Delimiter.second);
             if (!FormatStr.empty())
             {
                 Fmt = ParseGLSLImageFormat(FormatStr);
@@ -80,17 +81,19 @@ static std::pair<std::string, TEXTURE_FORMAT> ParseRWTextureDefinition(HLSLToken
     if (Token->Type != HLSLTokenType::Identifier)
         return {};
 
-    return {Token->Literal, Fmt};
+    return {std::string{Token->Literal, Token->LiteralLen}, Fmt};
 }
 
 std::unordered_map<HashMapStringKey, TEXTURE_FORMAT> ExtractGLSLImageFormatsFromHLSL(const std::string& HLSLSource)
 {
-    HLSLTokenizer                      Tokenizer;
-    const HLSLTokenizer::TokenListType Tokens = Tokenizer.Tokenize(HLSLSource);
+    static const HLSLTokenizer Tokenizer;
+
+    HLSLTokenizer::TokenRecordListType Tokens;
+    Tokenizer.Tokenize(HLSLSource.c_str(), HLSLSource.length(), Tokens);
 
     std::unordered_map<HashMapStringKey, TEXTURE_FORMAT> ImageFormats;
 
-    auto Token      = Tokens.begin();
+    auto Token      = Tokens.cbegin();
     int  ScopeLevel = 0;
     while (Token != Tokens.end())
     {
@@ -38,38 +38,56 @@ HLSLTokenizer::HLSLTokenizer()
 #define DEFINE_KEYWORD(keyword) m_Keywords.insert(std::make_pair(#keyword, HLSLTokenInfo(HLSLTokenType::kw_##keyword, #keyword)));
     ITERATE_HLSL_KEYWORDS(DEFINE_KEYWORD)
 #undef DEFINE_KEYWORD
+
+    for (const auto& Keyword : m_Keywords)
+        m_MaxKeywordLen = std::max(m_MaxKeywordLen, Keyword.second.Literal.length());
+}
+
+HLSLTokenType HLSLTokenizer::GetTokenType(const char* Literal, size_t Length) const
+{
+    // Copy the literal to a null-terminated buffer on the stack to avoid allocating
+    // a string for every identifier.
+    char Name[64];
+    VERIFY(m_MaxKeywordLen < _countof(Name), "The keyword buffer is too small");
+    if (Length > m_MaxKeywordLen)
+        return HLSLTokenType::Identifier;
+
+    memcpy(Name, Literal, Length);
+    Name[Length] = '\0';
+
+    auto KeywordIt = m_Keywords.find(HashMapStringKey{Name});
+    if (KeywordIt != m_Keywords.end())
+    {
+        VERIFY(KeywordIt->second.Literal == Name, "Inconsistent literal");
+        return KeywordIt->second.Type;
+    }
+    return HLSLTokenType::Identifier;
 }
 
-HLSLTokenizer::TokenListType HLSLTokenizer::Tokenize(const String& Source) const
+bool HLSLTokenizer::Tokenize(const char* Source, size_t SourceLen, TokenRecordListType& Records) const
 {
+    Records.clear();
     try
     {
-        size_t TokenIdx = 0;
-        return Parsing::Tokenize<HLSLTokenInfo, TokenListType>(
-            Source.begin(), Source.end(),
-            [&TokenIdx](HLSLTokenType                      Type,
-                        const std::string::const_iterator& DelimStart,
-                        const std::string::const_iterator& DelimEnd,
-                        const std::string::const_iterator& LiteralStart,
-                        const std::string::const_iterator& LiteralEnd) //
+        Parsing::Tokenize<HLSLTokenRecord>(
+            Source, Source + SourceLen,
+            [](HLSLTokenType Type, const char* DelimStart, const char* DelimEnd, const char* LiteralStart, const char* LiteralEnd) //
             {
-                return HLSLTokenInfo::Create(Type, DelimStart, DelimEnd, LiteralStart, LiteralEnd, TokenIdx++);
+                return HLSLTokenRecord{Type, DelimStart, DelimEnd, LiteralStart, LiteralEnd};
             },
-            [&](const std::string::const_iterator& Start, const std::string::const_iterator& End) //
+            [this](const char* Start, const char* End) //
             {
-                auto KeywordIt = m_Keywords.find(HashMapStringKey{std::string{Start, End}});
-                if (KeywordIt != m_Keywords.end())
-                {
-                    VERIFY(std::string(Start, End) == KeywordIt->second.Literal, "Inconsistent literal");
-                    return KeywordIt->second.Type;
-                }
-                return HLSLTokenType::Identifier;
-            });
+                return GetTokenType(Start, End - Start);
+            },
+            Records);
     }
     catch (...)
     {
-        return {};
+        Records.clear();
+        return false;
     }
+
+    return true;
 }
 
 } // namespace Parsing
@@ -0,0 +1,96 @@
+/*
+ *  Copyright 2025 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "PatchedSPIRV.hpp"
+
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+uint32_t PatchedSPIRV::operator[](size_t Offset) const
+{
+    for (auto it = m_Patches.rbegin(); it != m_Patches.rend(); ++it)
+    {
+        if (it->Offset == Offset)
+            return it->Value;
+    }
+    VERIFY_EXPR(Offset < m_pCode->size());
+    return (*m_pCode)[Offset];
+}
+
+void PatchedSPIRV::Patch(size_t Offset, uint32_t Value)
+{
+    VERIFY_EXPR(Offset < m_pCode->size());
+    if ((*this)[Offset] != Value)
+        m_Patches.push_back({Offset, Value});
+}
+
+const std::vector<uint32_t>& PatchedSPIRV::Apply()
+{
+    if (m_Patches.empty())
+        return *m_pCode;
+
+    if (!IsCopied())
+    {
+        m_Copy  = *m_pCode;
+        m_pCode = &m_Copy;
+    }
+    for (const WordPatch& PendingPatch : m_Patches)
+        m_Copy[PendingPatch.Offset] = PendingPatch.Value;
+    m_Patches.clear();
+
+    return m_Copy;
+}
+
+void PatchedSPIRV::Replace(std::vector<uint32_t>&& Code)
+{
+    m_Copy  = std::move(Code);
+    m_pCode = &m_Copy;
+    m_Patches.clear();
+}
+
+PatchedSPIRV::PatchedSPIRV(PatchedSPIRV&& Other) noexcept :
+    m_pCode{Other.IsCopied() ? &m_Copy : Other.m_pCode},
+    m_Copy{std::move(Other.m_Copy)},
+    m_Patches{std::move(Other.m_Patches)}
+{
+    Other.m_pCode = nullptr;
+}
+
+PatchedSPIRV& PatchedSPIRV::operator=(PatchedSPIRV&& Other) noexcept
+{
+    if (this != &Other)
+    {
+        m_pCode       = Other.IsCopied() ? &m_Copy : Other.m_pCode;
+        m_Copy        = std::move(Other.m_Copy);
+        m_Patches     = std::move(Other.m_Patches);
+        Other.m_pCode = nullptr;
+    }
+    return *this;
+}
+
+} // namespace Diligent
@@ -383,7 +383,8 @@ SPIRVShaderResources::SPIRVShaderResources(IMemoryAllocator&     Allocator,
                                            bool                  LoadShaderStageInputs,
                                            bool                  LoadUniformBufferReflection,
                                            std::string&          EntryPoint) noexcept(false) :
-    m_ShaderType{shaderDesc.ShaderType}
+    m_ShaderType{shaderDesc.ShaderType},
+    m_ShaderStageInputsRequested{LoadShaderStageInputs}
 {
     // https://github.com/KhronosGroup/SPIRV-Cross/wiki/Reflection-API-user-guide
     diligent_spirv_cross::Parser parser{std::move(spirv_binary)};
@@ -731,6 +732,350 @@ SPIRVShaderResources::SPIRVShaderResources(IMemoryAllocator&     Allocator,
     //LOG_INFO_MESSAGE(DumpResources());
 }
 
+namespace
+{
+
+// Serialized reflection data layout version. Increment when the layout changes.
+constexpr Uint32 SPIRVReflectionVersion = 1;
+
+// Marks the end of the byte code that contains SPIR-V with appended reflection data.
+constexpr Uint32 SPIRVReflectionMagic = 0x4C464552; // 'REFL'
+
+enum SPIRV_REFLECTION_FLAGS : Uint32
+{
+    SPIRV_REFLECTION_FLAG_NONE          = 0u,
+    SPIRV_REFLECTION_FLAG_HLSL_SOURCE   = 1u << 0u,
+    SPIRV_REFLECTION_FLAG_STAGE_INPUTS  = 1u << 1u,
+    SPIRV_REFLECTION_FLAG_UB_REFLECTION = 1u << 2u
+};
+
+struct SerializedResourceAttribs
+{
+    const char*                              Name                          = nullptr;
+    Uint16                                   ArraySize                     = 0;
+    SPIRVShaderResourceAttribs::ResourceType Type                          = SPIRVShaderResourceAttribs::ResourceType::NumResourceTypes;
+    Uint8                                    ResourceDim                   = 0;
+    Uint8                                    IsMS                          = 0;
+    Uint32                                   BindingDecorationOffset       = 0;
+    Uint32                                   DescriptorSetDecorationOffset = 0;
+    Uint32                                   BufferStaticSize              = 0;
+    Uint32                                   BufferStride                  = 0;
+};
+
+struct SerializedStageInputAttribs
+{
+    const char* Semantic                 = nullptr;
+    Uint32      LocationDecorationOffset = 0;
+};
+
+template <typename SerializerType, typename AttribsType>
+bool SerializeResourceAttribs(SerializerType& Ser, AttribsType& Attribs)
+{
+    return Ser(Attribs.Name, Attribs.ArraySize, Attribs.Type, Attribs.ResourceDim, Attribs.IsMS,
+               Attribs.BindingDecorationOffset, Attribs.DescriptorSetDecorationOffset,
+               Attribs.BufferStaticSize, Attribs.BufferStride);
+}
+
+template <typename SerializerType, typename AttribsType>
+bool SerializeStageInputAttribs(SerializerType& Ser, AttribsType& Attribs)
+{
+    return Ser(Attribs.Semantic, Attribs.LocationDecorationOffset);
+}
+
+template <SerializerMode Mode>
+bool SerializeShaderCodeVariable(Serializer<Mode>& Ser, const ShaderCodeVariableDesc& Var)
+{
+    if (!Ser(Var.Name, Var.TypeName, Var.Class, Var.BasicType, Var.NumRows, Var.NumColumns, Var.Offset, Var.ArraySize, Var.NumMembers))
+        return false;
+
+    for (Uint32 i = 0; i < Var.NumMembers; ++i)
+    {
+        if (!SerializeShaderCodeVariable(Ser, Var.pMembers[i]))
+            return false;
+    }
+    return true;
+}
+
+bool DeserializeShaderCodeVariable(Serializer<SerializerMode::Read>& Ser, ShaderCodeVariableDescX& Var)
+{
+    ShaderCodeVariableDesc Desc;
+    Uint32                 NumMembers = 0;
+    if (!Ser(Desc.Name, Desc.TypeName, Desc.Class, Desc.BasicType, Desc.NumRows, Desc.NumColumns, Desc.Offset, Desc.ArraySize, NumMembers))
+        return false;
+
+    Var = ShaderCodeVariableDescX{Desc};
+    for (Uint32 i = 0; i < NumMembers; ++i)
+    {
+        ShaderCodeVariableDescX Member;
+        if (!DeserializeShaderCodeVariable(Ser, Member))
+            return false;
+        Var.AddMember(std::move(Member));
+    }
+    return true;
+}
+
+bool ReadReflectionHeader(const SerializedData& Reflection, Uint32& Version, Uint32& Flags)
+{
+    if (!Reflection || Reflection.Size() < sizeof(Version) + sizeof(Flags))
+        return false;
+
+    Serializer<SerializerMode::Read> Ser{Reflection};
+    return Ser(Version, Flags);
+}
+
+} // namespace
+
+template <SerializerMode Mode>
+bool SPIRVShaderResources::SerializeReflection(Serializer<Mode>& Ser, const char* EntryPoint) const
+{
+    Uint32 Flags = SPIRV_REFLECTION_FLAG_NONE;
+    if (m_IsHLSLSource)
+        Flags |= SPIRV_REFLECTION_FLAG_HLSL_SOURCE;
+    if (m_ShaderStageInputsRequested)
+        Flags |= SPIRV_REFLECTION_FLAG_STAGE_INPUTS;
+    if (m_UBReflectionBuffer)
+        Flags |= SPIRV_REFLECTION_FLAG_UB_REFLECTION;
+
+    const Uint32 Version = SPIRVReflectionVersion;
+
+    const Uint32 NumUBs               = GetNumUBs();
+    const Uint32 NumSBs               = GetNumSBs();
+    const Uint32 NumImgs              = GetNumImgs();
+    const Uint32 NumSmpldImgs         = GetNumSmpldImgs();
+    const Uint32 NumACs               = GetNumACs();
+    const Uint32 NumSepSmplrs         = GetNumSepSmplrs();
+    const Uint32 NumSepImgs           = GetNumSepImgs();
+    const Uint32 NumInptAtts          = GetNumInptAtts();
+    const Uint32 NumAccelStructs      = GetNumAccelStructs();
+    const Uint32 NumShaderStageInputs = GetNumShaderStageInputs();
+    static_assert(Uint32{SPIRVShaderResourceAttribs::ResourceType::NumResourceTypes} == 12, "Please serialize the new resource type counter here");
+
+    if (!Ser(Version, Flags, EntryPoint,
+             NumUBs, NumSBs, NumImgs, NumSmpldImgs, NumACs, NumSepSmplrs, NumSepImgs, NumInptAtts, NumAccelStructs,
+             NumShaderStageInputs, m_ComputeGroupSize))
+        return false;
+
+    // Resources are stored in the same order as in the memory buffer
+    for (Uint32 n = 0; n < GetTotalResources(); ++n)
+    {
+        const SPIRVShaderResourceAttribs& Res = GetResource(n);
+
+        SerializedResourceAttribs Attribs;
+        Attribs.Name                          = Res.Name;
+        Attribs.ArraySize                     = Res.ArraySize;
+        Attribs.Type                          = Res.Type;
+        Attribs.ResourceDim                   = Res.ResourceDim;
+        Attribs.IsMS                          = Res.IsMS;
+        Attribs.BindingDecorationOffset       = Res.BindingDecorationOffset;
+        Attribs.DescriptorSetDecorationOffset = Res.DescriptorSetDecorationOffset;
+        Attribs.BufferStaticSize              = Res.BufferStaticSize;
+        Attribs.BufferStride                  = Res.BufferStride;
+        if (!SerializeResourceAttribs(Ser, Attribs))
+            return false;
+    }
+
+    for (Uint32 n = 0; n < GetNumShaderStageInputs(); ++n)
+    {
+        if (!SerializeStageInputAttribs(Ser, GetShaderStageInputAttribs(n)))
+            return false;
+    }
+
+    if (m_UBReflectionBuffer)
+    {
+        for (Uint32 n = 0; n < GetNumUBs(); ++n)
+        {
+            const ShaderCodeBufferDesc* pUBDesc = GetUniformBufferDesc(n);
+            VERIFY_EXPR(pUBDesc != nullptr);
+            if (!Ser(pUBDesc->Size, pUBDesc->NumVariables))
+                return false;
+
+            for (Uint32 i = 0; i < pUBDesc->NumVariables; ++i)
+            {
+                if (!SerializeShaderCodeVariable(Ser, pUBDesc->pVariables[i]))
+                    return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+SerializedData SPIRVShaderResources::SerializeReflection(const char* EntryPoint, IMemoryAllocator& Allocator) const
+{
+    Serializer<SerializerMode::Measure> MeasureSer;
+    if (!SerializeReflection(MeasureSer, EntryPoint))
+    {
+        UNEXPECTED("Failed to measure the reflection data size. This should never happen.");
+        return {};
+    }
+
+    SerializedData Reflection = MeasureSer.AllocateData(Allocator);
+
+    Serializer<SerializerMode::Write> WriteSer{Reflection};
+    if (!SerializeReflection(WriteSer, EntryPoint))
+    {
+        UNEXPECTED("Failed to serialize the reflection data. This should never happen.");
+        return {};
+    }
+    VERIFY_EXPR(WriteSer.IsEnded());
+
+    return Reflection;
+}
+
+bool SPIRVShaderResources::IsReflectionCompatible(const SerializedData& Reflection,
+                                                  bool                  LoadShaderStageInputs,
+                                                  bool                  LoadUniformBufferReflection) noexcept
+{
+    Uint32 Version = 0;
+    Uint32 Flags   = SPIRV_REFLECTION_FLAG_NONE;
+    if (!ReadReflectionHeader(Reflection, Version, Flags))
+        return false;
+
+    if (Version != SPIRVReflectionVersion)
+        return false;
+
+    if (LoadShaderStageInputs && (Flags & SPIRV_REFLECTION_FLAG_STAGE_INPUTS) == 0)
+        return false;
+
+    if (LoadUniformBufferReflection && (Flags & SPIRV_REFLECTION_FLAG_UB_REFLECTION) == 0)
+        return false;
+
+    return true;
+}
+
+SPIRVShaderResources::SPIRVShaderResources(IMemoryAllocator&     Allocator,
+                                           const SerializedData& Reflection,
+                                           const ShaderDesc&     shaderDesc,
+                                           const char*           CombinedSamplerSuffix,
+                                           bool                  LoadShaderStageInputs,
+                                           bool                  LoadUniformBufferReflection,
+                                           std::string&          EntryPoint) noexcept(false) :
+    m_ShaderType{shaderDesc.ShaderType},
+    m_ShaderStageInputsRequested{LoadShaderStageInputs}
+{
+    if (!IsReflectionCompatible(Reflection, LoadShaderStageInputs, LoadUniformBufferReflection))
+    {
+        LOG_ERROR_AND_THROW("Reflection data of shader '", shaderDesc.Name, "' is invalid or does not contain the requested information");
+    }
+
+    Serializer<SerializerMode::Read> Ser{Reflection};
+
+    Uint32           Version              = 0;
+    Uint32           Flags                = SPIRV_REFLECTION_FLAG_NONE;
+    const char*      SerializedEntryPoint = nullptr;
+    ResourceCounters ResCounters;
+    Uint32           NumShaderStageInputs = 0;
+    if (!Ser(Version, Flags, SerializedEntryPoint,
+             ResCounters.NumUBs, ResCounters.NumSBs, ResCounters.NumImgs, ResCounters.NumSmpldImgs, ResCounters.NumACs,
+             ResCounters.NumSepSmplrs, ResCounters.NumSepImgs, ResCounters.NumInptAtts, ResCounters.NumAccelStructs,
+             NumShaderStageInputs, m_ComputeGroupSize))
+    {
+        LOG_ERROR_AND_THROW("Failed to read reflection data header of shader '", shaderDesc.Name, "'");
+    }
+    static_assert(Uint32{SPIRVShaderResourceAttribs::ResourceType::NumResourceTypes} == 12, "Please read the new resource type counter here");
+
+    m_IsHLSLSource = (Flags & SPIRV_REFLECTION_FLAG_HLSL_SOURCE) != 0;
+
+    if (EntryPoint.empty())
+        EntryPoint = SerializedEntryPoint;
+
+    const Uint32 TotalResources = ResCounters.NumUBs + ResCounters.NumSBs + ResCounters.NumImgs + ResCounters.NumSmpldImgs + ResCounters.NumACs +
+        ResCounters.NumSepSmplrs + ResCounters.NumSepImgs + ResCounters.NumInptAtts + ResCounters.NumAccelStructs;
+
+    // Read all attributes first to compute the names pool size.
+    std::vector<SerializedResourceAttribs> Resources(TotalResources);
+    for (SerializedResourceAttribs& Attribs : Resources)
+    {
+        if (!SerializeResourceAttribs(Ser, Attribs) || Attribs.Type >= SPIRVShaderResourceAttribs::ResourceType::NumResourceTypes)
+            LOG_ERROR_AND_THROW("Failed to read resource attributes of shader '", shaderDesc.Name, "'");
+    }
+
+    std::vector<SerializedStageInputAttribs> StageInputs(NumShaderStageInputs);
+    for (SerializedStageInputAttribs& Attribs : StageInputs)
+    {
+        if (!SerializeStageInputAttribs(Ser, Attribs))
+            LOG_ERROR_AND_THROW("Failed to read stage input attributes of shader '", shaderDesc.Name, "'");
+    }
+    if (!LoadShaderStageInputs)
+        StageInputs.clear();
+
+    size_t ResourceNamesPoolSize = 0;
+    for (const SerializedResourceAttribs& Attribs : Resources)
+        ResourceNamesPoolSize += strlen(Attribs.Name) + 1;
+    for (const SerializedStageInputAttribs& Attribs : StageInputs)
+        ResourceNamesPoolSize += strlen(Attribs.Semantic) + 1;
+
+    if (CombinedSamplerSuffix != nullptr)
+    {
+        ResourceNamesPoolSize += strlen(CombinedSamplerSuffix) + 1;
+    }
+
+    VERIFY_EXPR(shaderDesc.Name != nullptr);
+    ResourceNamesPoolSize += strlen(shaderDesc.Name) + 1;
+
+    // Resource names pool is only needed to facilitate string allocation.
+    StringPool ResourceNamesPool;
+    Initialize(Allocator, ResCounters, static_cast<Uint32>(StageInputs.size()), ResourceNamesPoolSize, ResourceNamesPool);
+    VERIFY_EXPR(GetTotalResources() == TotalResources);
+
+    for (Uint32 n = 0; n < TotalResources; ++n)
+    {
+        const SerializedResourceAttribs& Attribs = Resources[n];
+        new (&GetResource(n)) SPIRVShaderResourceAttribs //
+            {
+                ResourceNamesPool.CopyString(Attribs.Name),
+                Attribs.ArraySize,
+                Attribs.Type,
+                static_cast<RESOURCE_DIMENSION>(Attribs.ResourceDim),
+                Attribs.IsMS != 0,
+                Attribs.BindingDecorationOffset,
+                Attribs.DescriptorSetDecorationOffset,
+                Attribs.BufferStaticSize,
+                Attribs.BufferStride //
+            };
+    }
+
+    if (CombinedSamplerSuffix != nullptr)
+    {
+        m_CombinedSamplerSuffix = ResourceNamesPool.CopyString(CombinedSamplerSuffix);
+    }
+
+    m_ShaderName = ResourceNamesPool.CopyString(shaderDesc.Name);
+
+    for (Uint32 n = 0; n < StageInputs.size(); ++n)
+    {
+        new (&GetShaderStageInputAttribs(n)) SPIRVShaderStageInputAttribs //
+            {
+                ResourceNamesPool.CopyString(StageInputs[n].Semantic),
+                StageInputs[n].LocationDecorationOffset //
+            };
+    }
+
+    VERIFY(ResourceNamesPool.GetRemainingSize() == 0, "Names pool must be empty");
+
+    if (LoadUniformBufferReflection && GetNumUBs() > 0)
+    {
+        VERIFY_EXPR((Flags & SPIRV_REFLECTION_FLAG_UB_REFLECTION) != 0);
+
+        std::vector<ShaderCodeBufferDescX> UBReflections(GetNumUBs());
+        for (ShaderCodeBufferDescX& UBRefl : UBReflections)
+        {
+            Uint32 NumVariables = 0;
+            if (!Ser(UBRefl.Size, NumVariables))
+                LOG_ERROR_AND_THROW("Failed to read uniform buffer reflection of shader '", shaderDesc.Name, "'");
+
+            for (Uint32 i = 0; i < NumVariables; ++i)
+            {
+                ShaderCodeVariableDescX Var;
+                if (!DeserializeShaderCodeVariable(Ser, Var))
+                    LOG_ERROR_AND_THROW("Failed to read uniform buffer reflection of shader '", shaderDesc.Name, "'");
+                UBRefl.AddVariable(std::move(Var));
+            }
+        }
+        m_UBReflectionBuffer = ShaderCodeBufferDescX::PackArray(UBReflections.cbegin(), UBReflections.cend(), GetRawAllocator());
+    }
+}
+
 void SPIRVShaderResources::Initialize(IMemoryAllocator&       Allocator,
                                       const ResourceCounters& Counters,
                                       Uint32                  NumShaderStageInputs,
@@ -973,4 +1318,60 @@ std::string SPIRVShaderResources::DumpResources() const
     return ss.str();
 }
 
+std::vector<uint32_t> AppendSPIRVReflection(const std::vector<uint32_t>& SPIRV, const SerializedData& Reflection)
+{
+    VERIFY_EXPR(!SPIRV.empty() && Reflection);
+
+    // | SPIR-V | Reflection data (padded to 4 bytes) | SPIR-V word count | Reflection data size | Magic |
+    const size_t ReflectionWordCount = AlignUp(Reflection.Size(), sizeof(uint32_t)) / sizeof(uint32_t);
+
+    std::vector<uint32_t> ByteCode;
+    ByteCode.reserve(SPIRV.size() + ReflectionWordCount + 3);
+    ByteCode.assign(SPIRV.begin(), SPIRV.end());
+    ByteCode.resize(SPIRV.size() + ReflectionWordCount, 0);
+    memcpy(&ByteCode[SPIRV.size()], Reflection.Ptr(), Reflection.Size());
+    ByteCode.push_back(static_cast<uint32_t>(SPIRV.size()));
+    ByteCode.push_back(static_cast<uint32_t>(Reflection.Size()));
+    ByteCode.push_back(SPIRVReflectionMagic);
+
+    return ByteCode;
+}
+
+bool FindSPIRVReflection(const void*  pByteCode,
+                         size_t       ByteCodeSize,
+                         size_t&      SPIRVWordCount,
+                         const void*& pReflection,
+                         size_t&      ReflectionSize) noexcept
+{
+    constexpr size_t TrailerSize = sizeof(uint32_t) * 3;
+    if (pByteCode == nullptr || ByteCodeSize % sizeof(uint32_t) != 0 || ByteCodeSize < sizeof(uint32_t) + TrailerSize)
+        return false;
+
+    // The byte code may not be aligned
+    const Uint8* pBytes = static_cast<const Uint8*>(pByteCode);
+
+    uint32_t Trailer[3] = {};
+    memcpy(Trailer, pBytes + ByteCodeSize - TrailerSize, TrailerSize);
+    if (Trailer[2] != SPIRVReflectionMagic)
+        return false;
+
+    const size_t WordCount = Trailer[0];
+    const size_t DataSize  = Trailer[1];
+    if (WordCount == 0 || DataSize == 0 ||
+        WordCount >= ByteCodeSize / sizeof(uint32_t) || DataSize >= ByteCodeSize ||
+        WordCount * sizeof(uint32_t) + AlignUp(DataSize, sizeof(uint32_t)) + TrailerSize != ByteCodeSize)
+        return false;
+
+    uint32_t SPIRVMagic = 0;
+    memcpy(&SPIRVMagic, pBytes, sizeof(SPIRVMagic));
+    if (SPIRVMagic != spv::MagicNumber)
+        return false;
+
+    SPIRVWordCount = WordCount;
+    pReflection    = pBytes + WordCount * sizeof(uint32_t);
+    ReflectionSize = DataSize;
+
+    return true;
+}
+
 } // namespace Diligent
@@ -25,9 +25,20 @@
  */
 
 #include "SPIRVTools.hpp"
+
+#include <mutex>
+#include <atomic>
+#include <list>
+#include <unordered_map>
+#include <cstring>
+#include <cstddef>
+
 #include "DebugUtilities.hpp"
+#include "DataBlobImpl.hpp"
+#include "HashUtils.hpp"
 
 #include "spirv-tools/optimizer.hpp"
+#include "xxhash.h"
 
 namespace Diligent
 {
@@ -105,15 +116,355 @@ spv_target_env SpvTargetEnvFromSPIRV(const std::vector<uint32_t>& SPIRV)
     }
 }
 
-} // namespace
-
-std::vector<uint32_t> OptimizeSPIRV(const std::vector<uint32_t>& SrcSPIRV, spv_target_env TargetEnv, SPIRV_OPTIMIZATION_FLAGS Passes)
+// Process-wide cache of optimized SPIR-V keyed by the hash of the source SPIR-V,
+// target environment, optimization flags and SPIRV-Tools version.
+class SPIRVOptimizationCache
 {
-    VERIFY_EXPR(Passes != SPIRV_OPTIMIZATION_FLAG_NONE);
+public:
+    struct Key
+    {
+        Uint64 LowPart  = 0;
+        Uint64 HighPart = 0;
 
-    if (TargetEnv == SPV_ENV_MAX)
-        TargetEnv = SpvTargetEnvFromSPIRV(SrcSPIRV);
+        bool operator==(const Key& RHS) const noexcept
+        {
+            return LowPart == RHS.LowPart && HighPart == RHS.HighPart;
+        }
+
+        struct Hasher
+        {
+            size_t operator()(const Key& K) const noexcept
+            {
+                return ComputeHash(K.LowPart, K.HighPart);
+            }
+        };
+    };
+
+    static SPIRVOptimizationCache& Get()
+    {
+        static SPIRVOptimizationCache Cache;
+        return Cache;
+    }
+
+    static Key ComputeKey(const std::vector<uint32_t>& SrcSPIRV, spv_target_env TargetEnv, SPIRV_OPTIMIZATION_FLAGS Passes)
+    {
+        XXH3_state_t* pState = XXH3_createState();
+        XXH3_128bits_reset(pState);
+        XXH3_128bits_update(pState, SrcSPIRV.data(), SrcSPIRV.size() * sizeof(uint32_t));
+
+        const Uint32 Env = static_cast<Uint32>(TargetEnv);
+        XXH3_128bits_update(pState, &Env, sizeof(Env));
+        XXH3_128bits_update(pState, &Passes, sizeof(Passes));
+
+        const Uint64 ToolsVersionHash = GetToolsVersionHash();
+        XXH3_128bits_update(pState, &ToolsVersionHash, sizeof(ToolsVersionHash));
+
+        const XXH128_hash_t Hash = XXH3_128bits_digest(pState);
+        XXH3_freeState(pState);
+
+        return Key{Hash.low64, Hash.high64};
+    }
+
+    // Returns the hash of the SPIRV-Tools version string. Optimized SPIR-V depends on the
+    // optimizer version, so the data written by a different version must not be reused.
+    static Uint64 GetToolsVersionHash()
+    {
+        static const Uint64 ToolsVersionHash = []() {
+            const char* ToolsVersion = spvSoftwareVersionDetailsString();
+            return static_cast<Uint64>(XXH3_64bits(ToolsVersion, strlen(ToolsVersion)));
+        }();
+        return ToolsVersionHash;
+    }
+
+    bool IsEnabled() const
+    {
+        return m_MaxDataSize.load() != 0;
+    }
+
+    void SetMaxDataSize(size_t MaxDataSize)
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        m_MaxDataSize.store(MaxDataSize);
+        Evict();
+    }
+
+    bool Find(const Key& K, std::vector<uint32_t>& SPIRV)
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
+        auto it = m_Entries.find(K);
+        if (it == m_Entries.end())
+        {
+            ++m_NumMisses;
+            return false;
+        }
+
+        ++m_NumHits;
+        // Move the entry to the front of the LRU list
+        m_LRU.splice(m_LRU.begin(), m_LRU, it->second.LRUIt);
+        SPIRV = it->second.SPIRV;
+        return true;
+    }
+
+    void Add(const Key& K, std::vector<uint32_t> SPIRV)
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        AddInternal(K, std::move(SPIRV));
+    }
+
+    void Clear()
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        m_Entries.clear();
+        m_LRU.clear();
+        m_DataSize  = 0;
+        m_NumHits   = 0;
+        m_NumMisses = 0;
+    }
+
+    SPIRVOptimizationCacheStats GetStats()
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
+        SPIRVOptimizationCacheStats Stats;
+        Stats.NumHits    = m_NumHits;
+        Stats.NumMisses  = m_NumMisses;
+        Stats.NumEntries = m_Entries.size();
+        Stats.DataSize   = m_DataSize;
+        return Stats;
+    }
+
+    // Data layout:
+    //  Header
+    //  {Key, Uint32 NumWords, Uint32 Words[NumWords]} x NumEntries
+    bool Store(IDataBlob** ppData)
+    {
+        if (ppData == nullptr)
+        {
+            DEV_ERROR("ppData must not be null");
+            return false;
+        }
+        DEV_CHECK_ERR(*ppData == nullptr, "Overwriting reference to an existing object may result in memory leaks");
+
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
+        size_t DataSize = sizeof(Header);
+        for (const auto& it : m_Entries)
+            DataSize += sizeof(Key) + sizeof(Uint32) + it.second.SPIRV.size() * sizeof(uint32_t);
+
+        RefCntAutoPtr<DataBlobImpl> pData = DataBlobImpl::Create(DataSize);
+        Uint8*                      pDst  = pData->GetDataPtr<Uint8>();
+
+        Header Hdr;
+        Hdr.NumEntries       = static_cast<Uint32>(m_Entries.size());
+        Hdr.ToolsVersionHash = GetToolsVersionHash();
+        Hdr.DataSize         = DataSize - sizeof(Header);
+        WriteData(pDst, &Hdr, sizeof(Hdr));
+
+        // Write the entries from the least to the most recently used so that
+        // the LRU order is preserved when the data is loaded.
+        for (auto lru_it = m_LRU.rbegin(); lru_it != m_LRU.rend(); ++lru_it)
+        {
+            const std::vector<uint32_t>& SPIRV = m_Entries.at(*lru_it).SPIRV;
+
+            const Uint32 NumWords = static_cast<Uint32>(SPIRV.size());
+            WriteData(pDst, &*lru_it, sizeof(Key));
+            WriteData(pDst, &NumWords, sizeof(NumWords));
+            WriteData(pDst, SPIRV.data(), SPIRV.size() * sizeof(uint32_t));
+        }
+        VERIFY_EXPR(pDst == pData->GetDataPtr<Uint8>() + DataSize);
+
+        // Write the hash of the entire data to detect corruption
+        const Uint64 DataHash = ComputeDataHash(pData->GetDataPtr<Uint8>(), DataSize);
+        memcpy(pData->GetDataPtr<Uint8>() + offsetof(Header, DataHash), &DataHash, sizeof(DataHash));
+
+        *ppData = pData.Detach();
+        return true;
+    }
+
+    bool Load(const IDataBlob* pData)
+    {
+        if (pData == nullptr)
+        {
+            DEV_ERROR("pData must not be null");
+            return false;
+        }
+
+        const Uint8*       pSrc    = pData->GetConstDataPtr<Uint8>();
+        const Uint8* const pSrcEnd = pSrc + pData->GetSize();
+
+        Header Hdr;
+        if (!ReadData(pSrc, pSrcEnd, &Hdr, sizeof(Hdr)))
+        {
+            LOG_ERROR_MESSAGE("SPIR-V optimization cache data is too small");
+            return false;
+        }
+        if (Hdr.Magic != Header{}.Magic || Hdr.Version != Header{}.Version)
+        {
+            LOG_INFO_MESSAGE("Ignoring SPIR-V optimization cache data written by a different version of the cache");
+            return false;
+        }
+        if (Hdr.DataSize != static_cast<size_t>(pSrcEnd - pSrc) ||
+            Hdr.DataHash != ComputeDataHash(pData->GetConstDataPtr<Uint8>(), pData->GetSize()))
+        {
+            LOG_ERROR_MESSAGE("SPIR-V optimization cache data is corrupted");
+            return false;
+        }
+        if (Hdr.ToolsVersionHash != GetToolsVersionHash())
+        {
+            LOG_INFO_MESSAGE("Ignoring SPIR-V optimization cache data written by a different version of SPIRV-Tools");
+            return false;
+        }
+
+        // Parse all entries before modifying the cache so that invalid data does not leave it partially loaded
+        std::vector<std::pair<Key, std::vector<uint32_t>>> Entries;
+        Entries.reserve(Hdr.NumEntries);
+        for (Uint32 i = 0; i < Hdr.NumEntries; ++i)
+        {
+            Key    K;
+            Uint32 NumWords = 0;
+            if (!ReadData(pSrc, pSrcEnd, &K, sizeof(K)) ||
+                !ReadData(pSrc, pSrcEnd, &NumWords, sizeof(NumWords)) ||
+                static_cast<size_t>(pSrcEnd - pSrc) < size_t{NumWords} * sizeof(uint32_t))
+            {
+                LOG_ERROR_MESSAGE("SPIR-V optimization cache data is corrupted");
+                return false;
+            }
+
+            std::vector<uint32_t> SPIRV(NumWords);
+            ReadData(pSrc, pSrcEnd, SPIRV.data(), SPIRV.size() * sizeof(uint32_t));
+            Entries.emplace_back(K, std::move(SPIRV));
+        }
+        if (pSrc != pSrcEnd)
+        {
+            LOG_ERROR_MESSAGE("SPIR-V optimization cache data is corrupted");
+            return false;
+        }
+
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+        if (m_MaxDataSize.load() == 0)
+        {
+            LOG_WARNING_MESSAGE("SPIR-V optimization cache is disabled. Call SetSPIRVOptimizationCacheSize before loading the data.");
+            return false;
+        }
+
+        for (auto& Entry : Entries)
+            AddInternal(Entry.first, std::move(Entry.second));
+
+        return true;
+    }
 
+private:
+    struct Header
+    {
+        Uint32 Magic      = 0x53505643; // 'SPVC'
+        Uint32 Version    = 2;
+        Uint32 NumEntries = 0;
+        Uint32 Reserved   = 0;
+
+        // Hash of the SPIRV-Tools version string, see GetToolsVersionHash()
+        Uint64 ToolsVersionHash = 0;
+
+        // The size of the data that follows the header
+        Uint64 DataSize = 0;
+
+        // Hash of the entire data, including the header with DataHash set to zero
+        Uint64 DataHash = 0;
+    };
+    static_assert(sizeof(Header) == 40, "Header must not have padding");
+
+    static Uint64 ComputeDataHash(const Uint8* pData, size_t Size)
+    {
+        VERIFY_EXPR(Size >= sizeof(Header));
+
+        Header Hdr;
+        memcpy(&Hdr, pData, sizeof(Hdr));
+        Hdr.DataHash = 0;
+
+        XXH3_state_t* pState = XXH3_createState();
+        XXH3_64bits_reset(pState);
+        XXH3_64bits_update(pState, &Hdr, sizeof(Hdr));
+        XXH3_64bits_update(pState, pData + sizeof(Hdr), Size - sizeof(Hdr));
+        const Uint64 Hash = XXH3_64bits_digest(pState);
+        XXH3_freeState(pState);
+
+        return Hash;
+    }
+
+    struct Entry
+    {
+        std::vector<uint32_t>    SPIRV;
+        std::list<Key>::iterator LRUIt;
+    };
+
+    static void WriteData(Uint8*& pDst, const void* pSrc, size_t Size)
+    {
+        if (Size != 0)
+            memcpy(pDst, pSrc, Size);
+        pDst += Size;
+    }
+
+    static bool ReadData(const Uint8*& pSrc, const Uint8* pSrcEnd, void* pDst, size_t Size)
+    {
+        if (static_cast<size_t>(pSrcEnd - pSrc) < Size)
+            return false;
+        if (Size != 0)
+            memcpy(pDst, pSrc, Size);
+        pSrc += Size;
+        return true;
+    }
+
+    void AddInternal(const Key& K, std::vector<uint32_t>&& SPIRV)
+    {
+        // The cache may have been disabled while the SPIR-V was being optimized
+        if (m_MaxDataSize.load() == 0)
+            return;
+
+        auto it = m_Entries.find(K);
+        if (it != m_Entries.end())
+        {
+            // Another thread has optimized the same SPIR-V
+            m_LRU.splice(m_LRU.begin(), m_LRU, it->second.LRUIt);
+            return;
+        }
+
+        m_DataSize += SPIRV.size() * sizeof(uint32_t);
+        m_LRU.push_front(K);
+        m_Entries.emplace(K, Entry{std::move(SPIRV), m_LRU.begin()});
+
+        Evict();
+    }
+
+    void Evict()
+    {
+        const size_t MaxDataSize = m_MaxDataSize.load();
+        while (!m_LRU.empty() && m_DataSize > MaxDataSize)
+        {
+            auto it = m_Entries.find(m_LRU.back());
+            VERIFY_EXPR(it != m_Entries.end());
+            VERIFY_EXPR(m_DataSize >= it->second.SPIRV.size() * sizeof(uint32_t));
+            m_DataSize -= it->second.SPIRV.size() * sizeof(uint32_t);
+            m_Entries.erase(it);
+            m_LRU.pop_back();
+        }
+    }
+
+private:
+    std::mutex m_Mtx;
+
+    std::atomic<size_t> m_MaxDataSize{0};
+
+    std::unordered_map<Key, Entry, Key::Hasher> m_Entries;
+    // Most recently used entries are at the front
+    std::list<Key> m_LRU;
+
+    size_t m_DataSize  = 0;
+    Uint64 m_NumHits   = 0;
+    Uint64 m_NumMisses = 0;
+};
+
+std::vector<uint32_t> OptimizeSPIRVInternal(const std::vector<uint32_t>& SrcSPIRV, spv_target_env TargetEnv, SPIRV_OPTIMIZATION_FLAGS Passes)
+{
     spvtools::Optimizer SpirvOptimizer(TargetEnv);
     SpirvOptimizer.SetMessageConsumer(SpvOptimizerMessageConsumer);
 
@@ -153,4 +504,56 @@ std::vector<uint32_t> OptimizeSPIRV(const std::vector<uint32_t>& SrcSPIRV, spv_t
     return OptimizedSPIRV;
 }
 
+} // namespace
+
+std::vector<uint32_t> OptimizeSPIRV(const std::vector<uint32_t>& SrcSPIRV, spv_target_env TargetEnv, SPIRV_OPTIMIZATION_FLAGS Passes)
+{
+    VERIFY_EXPR(Passes != SPIRV_OPTIMIZATION_FLAG_NONE);
+
+    if (TargetEnv == SPV_ENV_MAX)
+        TargetEnv = SpvTargetEnvFromSPIRV(SrcSPIRV);
+
+    SPIRVOptimizationCache& Cache = SPIRVOptimizationCache::Get();
+    if (!Cache.IsEnabled())
+        return OptimizeSPIRVInternal(SrcSPIRV, TargetEnv, Passes);
+
+    const SPIRVOptimizationCache::Key Key = SPIRVOptimizationCache::ComputeKey(SrcSPIRV, TargetEnv, Passes);
+
+    std::vector<uint32_t> OptimizedSPIRV;
+    if (Cache.Find(Key, OptimizedSPIRV))
+        return OptimizedSPIRV;
+
+    OptimizedSPIRV = OptimizeSPIRVInternal(SrcSPIRV, TargetEnv, Passes);
+    // Do not cache failures so that the errors are reported every time
+    if (!OptimizedSPIRV.empty())
+        Cache.Add(Key, OptimizedSPIRV);
+
+    return OptimizedSPIRV;
+}
+
+void SetSPIRVOptimizationCacheSize(size_t MaxDataSize)
+{
+    SPIRVOptimizationCache::Get().SetMaxDataSize(MaxDataSize);
+}
+
+void ClearSPIRVOptimizationCache()
+{
+    SPIRVOptimizationCache::Get().Clear();
+}
+
+SPIRVOptimizationCacheStats GetSPIRVOptimizationCacheStats()
+{
+    return SPIRVOptimizationCache::Get().GetStats();
+}
+
+bool StoreSPIRVOptimizationCache(IDataBlob** ppData)
+{
+    return SPIRVOptimizationCache::Get().Store(ppData);
+}
+
+bool LoadSPIRVOptimizationCache(const IDataBlob* pData)
+{
+    return SPIRVOptimizationCache::Get().Load(pData);
+}
+
 } // namespace Diligent
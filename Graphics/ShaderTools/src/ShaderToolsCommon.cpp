@@ -33,6 +33,7 @@
 #include "DebugUtilities.hpp"
 #include "DataBlobImpl.hpp"
 #include "StringDataBlobImpl.hpp"
+#include "MemoryFileStream.hpp"
 #include "GraphicsAccessories.hpp"
 #include "ParsingTools.hpp"
 
@@ -242,8 +243,18 @@ ShaderSourceFileData ReadShaderSourceFile(const char*                      Sourc
                 if (pSourceStream == nullptr)
                     LOG_ERROR_AND_THROW("Failed to load shader source file '", FilePath, '\'');
 
-                SourceData.pFileData = DataBlobImpl::Create();
-                pSourceStream->ReadBlob(SourceData.pFileData);
+                // Memory streams (e.g. the ones created by memory or packed shader source factories)
+                // are read directly from their data blob without copying.
+                RefCntAutoPtr<MemoryFileStream> pMemStream{pSourceStream, MemoryFileStream::IID_InternalImpl};
+                if (pMemStream && pMemStream->GetPos() == 0 && pMemStream->GetSize() > 0)
+                {
+                    SourceData.pFileData = pMemStream->GetDataBlob();
+                }
+                else
+                {
+                    SourceData.pFileData = DataBlobImpl::Create();
+                    pSourceStream->ReadBlob(SourceData.pFileData);
+                }
                 SourceData.Source       = SourceData.pFileData->GetConstDataPtr<char>();
                 SourceData.SourceLength = StaticCast<Uint32>(SourceData.pFileData->GetSize());
             }
@@ -471,6 +482,21 @@ bool ProcessShaderIncludes(const ShaderCreateInfo& ShaderCI, std::function<void(
     }
 }
 
+bool FindShaderIncludes(const char* Source, size_t SourceLength, std::vector<std::string>& Includes, const char* FilePath) noexcept
+{
+    if (Source == nullptr)
+        return true;
+
+    return FindIncludes(
+        Source, SourceLength != 0 ? SourceLength : strlen(Source),
+        [&Includes](std::string Path, size_t, size_t) {
+            Includes.emplace_back(std::move(Path));
+        },
+        [FilePath](const std::string& Error) {
+            LOG_ERROR_MESSAGE("Failed to find includes in ", (FilePath != nullptr ? FilePath : "shader source"), ": ", Error);
+        });
+}
+
 static std::string UnrollShaderIncludesImpl(ShaderCreateInfo ShaderCI, std::unordered_set<std::string>& AllIncludes) noexcept(false)
 {
     const ShaderSourceFileData SourceData = ReadShaderSourceFile(ShaderCI);
@@ -233,4 +233,86 @@ TEST(Shader, AsyncPipeline_AsyncShaders)
     TestAsyncPipeline(SHADER_COMPILE_FLAG_ASYNCHRONOUS, PSO_CREATE_FLAG_ASYNCHRONOUS);
 }
 
+// Without GL_KHR_parallel_shader_compile, the OpenGL backend compiles shaders and links programs
+// in worker threads that use contexts shared with the main context.
+TEST(Shader, AsyncPipeline_GL)
+{
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    IRenderDevice*          pDevice    = GPUTestingEnvironment::GetInstance()->GetDevice();
+    const RenderDeviceInfo& DeviceInfo = pDevice->GetDeviceInfo();
+    if (!DeviceInfo.IsGLDevice())
+    {
+        GTEST_SKIP() << "This test is specific to OpenGL";
+    }
+    if (!DeviceInfo.Features.AsyncShaderCompilation)
+    {
+        GTEST_SKIP() << "Async shader compilation is not supported by this device";
+    }
+
+    constexpr bool SimplifiedShader = true;
+
+    RefCntAutoPtr<IShader> pVS = CreateShader("AsyncShaderCompilationTest.vsh", "Async GL pipeline test VS", SHADER_TYPE_VERTEX, SHADER_COMPILE_FLAG_ASYNCHRONOUS, SimplifiedShader);
+    ASSERT_NE(pVS, nullptr);
+
+    std::vector<RefCntAutoPtr<IPipelineState>> pPSOs;
+    for (size_t i = 0; i < 8; ++i)
+    {
+        RefCntAutoPtr<IShader> pPS = CreateShader("AsyncShaderCompilationTest.psh", "Async GL pipeline test PS", SHADER_TYPE_PIXEL, SHADER_COMPILE_FLAG_ASYNCHRONOUS, SimplifiedShader);
+        ASSERT_NE(pPS, nullptr);
+
+        InputLayoutDescX InputLayout;
+        InputLayout.Add(0u, 0u, 3u, VT_FLOAT32, False);
+
+        PipelineResourceLayoutDescX ResourceLayout;
+        ResourceLayout.AddVariable(SHADER_TYPE_PIXEL, "g_Tex2D", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC);
+
+        GraphicsPipelineStateCreateInfoX PSOCreateInfo;
+        PSOCreateInfo
+            .SetName("Async GL pipeline test PSO")
+            .AddShader(pVS)
+            .AddShader(pPS)
+            .AddRenderTarget(TEX_FORMAT_RGBA8_UNORM)
+            .SetDepthFormat(TEX_FORMAT_D32_FLOAT)
+            .SetInputLayout(InputLayout)
+            .SetResourceLayout(ResourceLayout)
+            .SetFlags(PSO_CREATE_FLAG_ASYNCHRONOUS);
+
+        RefCntAutoPtr<IPipelineState> pPSO;
+        pDevice->CreatePipelineState(PSOCreateInfo, &pPSO);
+        ASSERT_NE(pPSO, nullptr);
+        pPSOs.emplace_back(std::move(pPSO));
+    }
+
+    constexpr double Timeout = 60;
+
+    Timer  T;
+    double StartTime = T.GetElapsedTime();
+    while (true)
+    {
+        Uint32 NumPSOsReady = 0;
+        for (RefCntAutoPtr<IPipelineState>& pPSO : pPSOs)
+        {
+            const PIPELINE_STATE_STATUS Status = pPSO->GetStatus();
+            ASSERT_NE(Status, PIPELINE_STATE_STATUS_FAILED) << pPSO->GetDesc().Name;
+            if (Status == PIPELINE_STATE_STATUS_READY)
+                ++NumPSOsReady;
+        }
+        if (NumPSOsReady == pPSOs.size())
+            break;
+        ASSERT_LT(T.GetElapsedTime() - StartTime, Timeout) << "Only " << NumPSOsReady << " of " << pPSOs.size() << " PSOs are ready";
+        std::this_thread::yield();
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    }
+
+    EXPECT_EQ(pVS->GetStatus(), SHADER_STATUS_READY);
+    for (RefCntAutoPtr<IPipelineState>& pPSO : pPSOs)
+    {
+        // Programs linked by the worker contexts must be usable in the main context
+        RefCntAutoPtr<IShaderResourceBinding> pSRB;
+        pPSO->CreateShaderResourceBinding(&pSRB, true);
+        EXPECT_NE(pSRB, nullptr);
+    }
+}
+
 } // namespace
@@ -28,9 +28,16 @@
 #include "DXCompiler.hpp"
 #include "GPUTestingEnvironment.hpp"
 #include "StringTools.hpp"
+#include "FileSystem.hpp"
+#include "Timer.hpp"
 
 #include "gtest/gtest.h"
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
 #include <atlcomcli.h>
 #include <d3d12shader.h>
 
@@ -693,4 +700,163 @@ float4 main(in float4 f4Position : SV_Position) : SV_TARGET
     }
 }
 
+const std::string CacheTest_PS = R"hlsl(
+Texture2D    g_Tex;
+SamplerState g_TexSampler;
+
+cbuffer cbConstants
+{
+    float4 g_Scale;
+};
+
+float4 main(in float4 Pos : SV_Position, in float2 UV : TEXCOORD) : SV_Target
+{
+    float4 Color = float4(0.0, 0.0, 0.0, 0.0);
+    for (int i = 0; i < 8; ++i)
+        Color += g_Tex.Sample(g_TexSampler, UV + float2(i, i) * g_Scale.xy) * PS_WEIGHT;
+    return Color;
+}
+)hlsl";
+
+bool CompileCacheTestShader(IDXCompiler* pDXC, Uint32 Variant, IDxcBlob** ppDXIL)
+{
+    const std::wstring Weight = std::to_wstring(Variant + 1) + L".0";
+
+    DxcDefine Defines[] = {{L"PS_WEIGHT", Weight.c_str()}};
+
+    IDXCompiler::CompileAttribs CA;
+    CA.Source       = CacheTest_PS.c_str();
+    CA.SourceLength = static_cast<Uint32>(CacheTest_PS.length());
+    CA.EntryPoint   = L"main";
+    CA.Profile      = L"ps_6_0";
+    CA.pDefines     = Defines;
+    CA.DefinesCount = _countof(Defines);
+    CA.pArgs        = DXCArgs;
+    CA.ArgsCount    = _countof(DXCArgs);
+
+    CComPtr<IDxcBlob> pOutput;
+    CA.ppBlobOut        = ppDXIL;
+    CA.ppCompilerOutput = &pOutput.p;
+    return pDXC->Compile(CA);
+}
+
+TEST(DXCompilerTest, CompilationCache)
+{
+    const char* CacheDir = "DXCompilerTest_Cache";
+
+    auto pDXC = CreateDXCompiler(DXCompilerTarget::Direct3D12, 0, nullptr);
+    ASSERT_TRUE(pDXC);
+    if (FileSystem::PathExists(CacheDir))
+        FileSystem::DeleteDirectory(CacheDir);
+    pDXC->SetCompilationCacheDirectory(CacheDir);
+
+    constexpr Uint32 NumVariants = 4;
+
+    std::vector<CComPtr<IDxcBlob>> RefDXIL(NumVariants);
+    for (Uint32 i = 0; i < NumVariants; ++i)
+    {
+        ASSERT_TRUE(CompileCacheTestShader(pDXC.get(), i, &RefDXIL[i].p));
+        ASSERT_TRUE(RefDXIL[i]);
+    }
+    EXPECT_EQ(pDXC->GetCompilationCacheStats().NumHits, 0u);
+    EXPECT_EQ(pDXC->GetCompilationCacheStats().NumMisses, NumVariants);
+
+    // The cache is shared between compiler instances
+    auto pDXC2 = CreateDXCompiler(DXCompilerTarget::Direct3D12, 0, nullptr);
+    ASSERT_TRUE(pDXC2);
+    pDXC2->SetCompilationCacheDirectory(CacheDir);
+    for (Uint32 i = 0; i < NumVariants; ++i)
+    {
+        CComPtr<IDxcBlob> pDXIL;
+        ASSERT_TRUE(CompileCacheTestShader(pDXC2.get(), i, &pDXIL.p));
+        ASSERT_TRUE(pDXIL);
+        ASSERT_EQ(pDXIL->GetBufferSize(), RefDXIL[i]->GetBufferSize());
+        EXPECT_EQ(memcmp(pDXIL->GetBufferPointer(), RefDXIL[i]->GetBufferPointer(), pDXIL->GetBufferSize()), 0);
+
+        CComPtr<ID3D12ShaderReflection> pReflection;
+        pDXC2->GetD3D12ShaderReflection(pDXIL, &pReflection);
+        EXPECT_TRUE(pReflection);
+    }
+    EXPECT_EQ(pDXC2->GetCompilationCacheStats().NumHits, NumVariants);
+    EXPECT_EQ(pDXC2->GetCompilationCacheStats().NumMisses, 0u);
+
+    pDXC.reset();
+    pDXC2.reset();
+    FileSystem::DeleteDirectory(CacheDir);
+}
+
+double RunDXCompilerBenchmark(IDXCompiler* pDXC, Uint32 NumThreads, Uint32 NumShadersPerThread)
+{
+    std::vector<std::thread> Threads(NumThreads);
+    std::atomic<bool>        Succeeded{true};
+
+    Timer T;
+    for (Uint32 i = 0; i < NumThreads; ++i)
+    {
+        Threads[i] = std::thread(
+            [&](Uint32 ThreadId) {
+                for (Uint32 s = 0; s < NumShadersPerThread; ++s)
+                {
+                    CComPtr<IDxcBlob> pDXIL;
+                    if (!CompileCacheTestShader(pDXC, ThreadId * NumShadersPerThread + s, &pDXIL.p) || !pDXIL)
+                        Succeeded.store(false);
+                }
+            },
+            i);
+    }
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    EXPECT_TRUE(Succeeded.load());
+    return T.GetElapsedTime();
+}
+
+TEST(DXCompilerTest, ParallelCompilationBenchmark)
+{
+    const char* CacheDir = "DXCompilerTest_BenchmarkCache";
+
+    constexpr Uint32 NumShadersPerThread = 16;
+
+    const Uint32 NumThreads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    auto pDXC = CreateDXCompiler(DXCompilerTarget::Direct3D12, 0, nullptr);
+    ASSERT_TRUE(pDXC);
+    if (FileSystem::PathExists(CacheDir))
+        FileSystem::DeleteDirectory(CacheDir);
+
+    // Load the library before measuring
+    {
+        CComPtr<IDxcBlob> pDXIL;
+        ASSERT_TRUE(CompileCacheTestShader(pDXC.get(), 0, &pDXIL.p));
+    }
+
+    // Every compilation creates new DXC instances
+    pDXC->SetSessionPoolingEnabled(false);
+    const double NoPoolingTime = RunDXCompilerBenchmark(pDXC.get(), NumThreads, NumShadersPerThread);
+
+    pDXC->SetSessionPoolingEnabled(true);
+    const double PoolingTime = RunDXCompilerBenchmark(pDXC.get(), NumThreads, NumShadersPerThread);
+
+    // The first run populates the cache, the second one only reads from it
+    pDXC->SetCompilationCacheDirectory(CacheDir);
+    const double ColdCacheTime = RunDXCompilerBenchmark(pDXC.get(), NumThreads, NumShadersPerThread);
+    const double WarmCacheTime = RunDXCompilerBenchmark(pDXC.get(), NumThreads, NumShadersPerThread);
+    pDXC->SetCompilationCacheDirectory(nullptr);
+
+    const Uint32 NumShaders = NumThreads * NumShadersPerThread;
+    EXPECT_EQ(pDXC->GetCompilationCacheStats().NumHits, NumShaders);
+    EXPECT_EQ(pDXC->GetCompilationCacheStats().NumMisses, NumShaders);
+
+    const auto ShadersPerSecond = [NumShaders](double Time) {
+        return static_cast<Uint32>(NumShaders / Time);
+    };
+    LOG_INFO_MESSAGE(NumShaders, " shaders on ", NumThreads, " threads: no pooling: ", ShadersPerSecond(NoPoolingTime),
+                     " shaders/s, pooling: ", ShadersPerSecond(PoolingTime),
+                     " shaders/s, cold cache: ", ShadersPerSecond(ColdCacheTime),
+                     " shaders/s, warm cache: ", ShadersPerSecond(WarmCacheTime), " shaders/s");
+
+    pDXC.reset();
+    FileSystem::DeleteDirectory(CacheDir);
+}
+
 } // namespace
@@ -0,0 +1,333 @@
+/*
+ *  Copyright 2019-2025 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include <array>
+#include <cstring>
+
+#include "GL/TestingEnvironmentGL.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+static const char* VSSource = R"(
+float4 main(uint VertId : SV_VertexID) : SV_Position
+{
+    return float4(float(VertId), 0.0, 0.0, 1.0);
+}
+)";
+
+static const char* PSSource = R"(
+float4 main() : SV_Target
+{
+    return float4(1.0, 0.0, 0.0, 1.0);
+}
+)";
+
+IDeviceContext* GetDeferredContextGL(GPUTestingEnvironment* pEnv)
+{
+    if (!pEnv->GetDevice()->GetDeviceInfo().IsGLDevice() || pEnv->GetNumDeferredContexts() == 0)
+        return nullptr;
+    return pEnv->GetDeferredContext(0);
+}
+
+RefCntAutoPtr<IBuffer> CreateBuffer(IRenderDevice* pDevice, const char* Name, Uint64 Size, BIND_FLAGS BindFlags, USAGE Usage, const void* pInitData)
+{
+    BufferDesc BuffDesc;
+    BuffDesc.Name      = Name;
+    BuffDesc.Size      = Size;
+    BuffDesc.BindFlags = BindFlags;
+    BuffDesc.Usage     = Usage;
+    if (Usage == USAGE_DYNAMIC)
+        BuffDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+    else if (Usage == USAGE_STAGING)
+        BuffDesc.CPUAccessFlags = CPU_ACCESS_READ;
+
+    BufferData InitData{pInitData, Size};
+
+    RefCntAutoPtr<IBuffer> pBuffer;
+    pDevice->CreateBuffer(BuffDesc, pInitData != nullptr ? &InitData : nullptr, &pBuffer);
+    return pBuffer;
+}
+
+template <size_t NumElements>
+std::array<Uint32, NumElements> ReadBuffer(GPUTestingEnvironment* pEnv, IBuffer* pBuffer)
+{
+    IRenderDevice*  pDevice  = pEnv->GetDevice();
+    IDeviceContext* pContext = pEnv->GetDeviceContext();
+
+    std::array<Uint32, NumElements> Data{};
+
+    RefCntAutoPtr<IBuffer> pStaging = CreateBuffer(pDevice, "Deferred context GL test - staging buffer", sizeof(Data), BIND_NONE, USAGE_STAGING, nullptr);
+    if (!pStaging)
+    {
+        ADD_FAILURE() << "Failed to create staging buffer";
+        return Data;
+    }
+
+    pContext->CopyBuffer(pBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, pStaging, 0, sizeof(Data), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->WaitForIdle();
+
+    void* pMappedData = nullptr;
+    pContext->MapBuffer(pStaging, MAP_READ, MAP_FLAG_DO_NOT_WAIT, pMappedData);
+    if (pMappedData == nullptr)
+    {
+        ADD_FAILURE() << "Failed to map staging buffer";
+        return Data;
+    }
+    memcpy(Data.data(), pMappedData, sizeof(Data));
+    pContext->UnmapBuffer(pStaging, MAP_READ);
+
+    return Data;
+}
+
+// Buffer commands recorded by a deferred context must be replayed by the immediate context
+// in the recording order, and every command list must see the results of the previous ones.
+TEST(DeferredContextGL, ReplayCommandStream)
+{
+    TestingEnvironmentGL* pEnv         = TestingEnvironmentGL::GetInstance();
+    IDeviceContext*       pDeferredCtx = GetDeferredContextGL(pEnv);
+    if (pDeferredCtx == nullptr)
+    {
+        GTEST_SKIP() << "This test requires an OpenGL device with deferred contexts";
+    }
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    IRenderDevice*  pDevice       = pEnv->GetDevice();
+    IDeviceContext* pImmediateCtx = pEnv->GetDeviceContext();
+
+    constexpr Uint32 NumElements = 8;
+
+    const std::array<Uint32, NumElements> InitData{};
+    RefCntAutoPtr<IBuffer>                pBuffer0 = CreateBuffer(pDevice, "Deferred context GL test - buffer 0", sizeof(InitData), BIND_VERTEX_BUFFER, USAGE_DEFAULT, InitData.data());
+    RefCntAutoPtr<IBuffer>                pBuffer1 = CreateBuffer(pDevice, "Deferred context GL test - buffer 1", sizeof(InitData), BIND_VERTEX_BUFFER, USAGE_DEFAULT, InitData.data());
+    RefCntAutoPtr<IBuffer>                pDynBuff = CreateBuffer(pDevice, "Deferred context GL test - dynamic buffer", sizeof(InitData), BIND_VERTEX_BUFFER, USAGE_DYNAMIC, nullptr);
+    ASSERT_NE(pBuffer0, nullptr);
+    ASSERT_NE(pBuffer1, nullptr);
+    ASSERT_NE(pDynBuff, nullptr);
+
+    // First command list: update buffer 0, then overwrite its second half.
+    RefCntAutoPtr<ICommandList> pCmdList0;
+    {
+        pDeferredCtx->Begin(0);
+
+        std::array<Uint32, NumElements> Data;
+        for (Uint32 i = 0; i < NumElements; ++i)
+            Data[i] = i + 1;
+        pDeferredCtx->UpdateBuffer(pBuffer0, 0, sizeof(Data), Data.data(), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+        // The data is copied into the command stream, so modifying the source must not affect the result
+        for (Uint32 i = 0; i < NumElements; ++i)
+            Data[i] = 100 + i;
+        pDeferredCtx->UpdateBuffer(pBuffer0, sizeof(Uint32) * NumElements / 2, sizeof(Uint32) * NumElements / 2, Data.data(), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        Data.fill(0);
+
+        pDeferredCtx->FinishCommandList(&pCmdList0);
+        ASSERT_NE(pCmdList0, nullptr);
+    }
+
+    // Second command list: write the dynamic buffer and copy both buffers into buffer 1.
+    RefCntAutoPtr<ICommandList> pCmdList1;
+    {
+        pDeferredCtx->Begin(0);
+
+        void* pMappedData = nullptr;
+        pDeferredCtx->MapBuffer(pDynBuff, MAP_WRITE, MAP_FLAG_DISCARD, pMappedData);
+        ASSERT_NE(pMappedData, nullptr);
+        Uint32* pDynData = static_cast<Uint32*>(pMappedData);
+        for (Uint32 i = 0; i < NumElements; ++i)
+            pDynData[i] = 1000 + i;
+        pDeferredCtx->UnmapBuffer(pDynBuff, MAP_WRITE);
+
+        constexpr Uint64 HalfSize = sizeof(Uint32) * NumElements / 2;
+        pDeferredCtx->CopyBuffer(pBuffer0, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, pBuffer1, 0, HalfSize, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        pDeferredCtx->CopyBuffer(pDynBuff, HalfSize, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, pBuffer1, HalfSize, HalfSize, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+        pDeferredCtx->FinishCommandList(&pCmdList1);
+        ASSERT_NE(pCmdList1, nullptr);
+    }
+    pDeferredCtx->FinishFrame();
+
+    // Nothing is executed until the command lists are submitted
+    EXPECT_EQ(ReadBuffer<NumElements>(pEnv, pBuffer0), InitData);
+
+    ICommandList* pCmdLists[] = {pCmdList0, pCmdList1};
+    pImmediateCtx->ExecuteCommandLists(_countof(pCmdLists), pCmdLists);
+
+    {
+        const std::array<Uint32, NumElements> RefData0{1, 2, 3, 4, 100, 101, 102, 103};
+        EXPECT_EQ(ReadBuffer<NumElements>(pEnv, pBuffer0), RefData0);
+
+        const std::array<Uint32, NumElements> RefData1{1, 2, 3, 4, 1004, 1005, 1006, 1007};
+        EXPECT_EQ(ReadBuffer<NumElements>(pEnv, pBuffer1), RefData1);
+    }
+
+    // Command lists can be executed multiple times
+    pImmediateCtx->UpdateBuffer(pBuffer0, 0, sizeof(InitData), InitData.data(), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pImmediateCtx->ExecuteCommandLists(1, pCmdLists);
+    {
+        const std::array<Uint32, NumElements> RefData0{1, 2, 3, 4, 100, 101, 102, 103};
+        EXPECT_EQ(ReadBuffer<NumElements>(pEnv, pBuffer0), RefData0);
+    }
+}
+
+// State changes that do not modify the state recorded since the beginning of the command list
+// or the last InvalidateState() call must not be added to the command stream.
+TEST(DeferredContextGL, DropRedundantStateDuringRecording)
+{
+    TestingEnvironmentGL* pEnv         = TestingEnvironmentGL::GetInstance();
+    IDeviceContext*       pDeferredCtx = GetDeferredContextGL(pEnv);
+    if (pDeferredCtx == nullptr)
+    {
+        GTEST_SKIP() << "This test requires an OpenGL device with deferred contexts";
+    }
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    IRenderDevice*  pDevice       = pEnv->GetDevice();
+    IDeviceContext* pImmediateCtx = pEnv->GetDeviceContext();
+
+    RefCntAutoPtr<IPipelineState> pPSO0;
+    RefCntAutoPtr<IPipelineState> pPSO1;
+    {
+        GraphicsPipelineStateCreateInfo PSOCreateInfo;
+
+        PSOCreateInfo.GraphicsPipeline.NumRenderTargets             = 1;
+        PSOCreateInfo.GraphicsPipeline.RTVFormats[0]                = TEX_FORMAT_RGBA8_UNORM;
+        PSOCreateInfo.GraphicsPipeline.DepthStencilDesc.DepthEnable = False;
+
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+        ShaderCI.ShaderCompiler = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+        ShaderCI.EntryPoint     = "main";
+
+        RefCntAutoPtr<IShader> pVS;
+        ShaderCI.Desc   = {"Deferred context GL test VS", SHADER_TYPE_VERTEX, true};
+        ShaderCI.Source = VSSource;
+        pDevice->CreateShader(ShaderCI, &pVS);
+        ASSERT_NE(pVS, nullptr);
+
+        RefCntAutoPtr<IShader> pPS;
+        ShaderCI.Desc   = {"Deferred context GL test PS", SHADER_TYPE_PIXEL, true};
+        ShaderCI.Source = PSSource;
+        pDevice->CreateShader(ShaderCI, &pPS);
+        ASSERT_NE(pPS, nullptr);
+
+        PSOCreateInfo.pVS = pVS;
+        PSOCreateInfo.pPS = pPS;
+
+        PSOCreateInfo.PSODesc.Name = "Deferred context GL test PSO 0";
+        pDevice->CreateGraphicsPipelineState(PSOCreateInfo, &pPSO0);
+        ASSERT_NE(pPSO0, nullptr);
+
+        PSOCreateInfo.PSODesc.Name = "Deferred context GL test PSO 1";
+        pDevice->CreateGraphicsPipelineState(PSOCreateInfo, &pPSO1);
+        ASSERT_NE(pPSO1, nullptr);
+    }
+
+    const Uint32           Indices[] = {0, 1, 2, 0, 1, 2};
+    RefCntAutoPtr<IBuffer> pIB       = CreateBuffer(pDevice, "Deferred context GL test - index buffer", sizeof(Indices), BIND_INDEX_BUFFER, USAGE_DEFAULT, Indices);
+    ASSERT_NE(pIB, nullptr);
+
+    const float BlendFactors0[] = {0.25f, 0.5f, 0.75f, 1.f};
+    const float BlendFactors1[] = {1.f, 0.75f, 0.5f, 0.25f};
+
+    pDeferredCtx->ClearStats();
+    pDeferredCtx->Begin(0);
+    for (Uint32 i = 0; i < 3; ++i)
+    {
+        pDeferredCtx->SetPipelineState(pPSO0);
+        pDeferredCtx->SetStencilRef(1);
+        pDeferredCtx->SetBlendFactors(BlendFactors0);
+        pDeferredCtx->SetIndexBuffer(pIB, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    }
+    // Changed state must be recorded
+    pDeferredCtx->SetPipelineState(pPSO1);
+    pDeferredCtx->SetStencilRef(2);
+    pDeferredCtx->SetBlendFactors(BlendFactors1);
+    pDeferredCtx->SetIndexBuffer(pIB, sizeof(Uint32) * 3, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    // The state is unknown after InvalidateState(), so the same state must be recorded again
+    pDeferredCtx->InvalidateState();
+    pDeferredCtx->SetPipelineState(pPSO1);
+    pDeferredCtx->SetStencilRef(2);
+    pDeferredCtx->SetBlendFactors(BlendFactors1);
+    pDeferredCtx->SetIndexBuffer(pIB, sizeof(Uint32) * 3, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    RefCntAutoPtr<ICommandList> pCmdList0;
+    pDeferredCtx->FinishCommandList(&pCmdList0);
+    ASSERT_NE(pCmdList0, nullptr);
+
+    {
+        const DeviceContextCommandCounters& Counters = pDeferredCtx->GetStats().CommandCounters;
+        EXPECT_EQ(Counters.SetPipelineState, 3u);
+        EXPECT_EQ(Counters.SetStencilRef, 3u);
+        EXPECT_EQ(Counters.SetBlendFactors, 3u);
+        EXPECT_EQ(Counters.SetIndexBuffer, 3u);
+    }
+
+    // Every command list starts from the default state, so the state from
+    // the previous command list must not be used to drop commands.
+    pDeferredCtx->ClearStats();
+    pDeferredCtx->Begin(0);
+    pDeferredCtx->SetPipelineState(pPSO1);
+    pDeferredCtx->SetStencilRef(2);
+    pDeferredCtx->SetBlendFactors(BlendFactors1);
+    pDeferredCtx->SetIndexBuffer(pIB, sizeof(Uint32) * 3, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    RefCntAutoPtr<ICommandList> pCmdList1;
+    pDeferredCtx->FinishCommandList(&pCmdList1);
+    ASSERT_NE(pCmdList1, nullptr);
+    pDeferredCtx->FinishFrame();
+
+    {
+        const DeviceContextCommandCounters& Counters = pDeferredCtx->GetStats().CommandCounters;
+        EXPECT_EQ(Counters.SetPipelineState, 1u);
+        EXPECT_EQ(Counters.SetStencilRef, 1u);
+        EXPECT_EQ(Counters.SetBlendFactors, 1u);
+        EXPECT_EQ(Counters.SetIndexBuffer, 1u);
+    }
+
+    // The immediate context must observe the same state changes when replaying the command lists
+    pImmediateCtx->ClearStats();
+    ICommandList* pCmdLists[] = {pCmdList0, pCmdList1};
+    pImmediateCtx->ExecuteCommandLists(_countof(pCmdLists), pCmdLists);
+    {
+        const DeviceContextCommandCounters& Counters = pImmediateCtx->GetStats().CommandCounters;
+        EXPECT_EQ(Counters.SetPipelineState, 4u);
+        EXPECT_EQ(Counters.SetStencilRef, 4u);
+        EXPECT_EQ(Counters.SetBlendFactors, 4u);
+        EXPECT_EQ(Counters.SetIndexBuffer, 4u);
+    }
+    pImmediateCtx->InvalidateState();
+}
+
+} // namespace
@@ -0,0 +1,193 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include <vector>
+
+#include "GL/TestingEnvironmentGL.hpp"
+#include "RenderDeviceGL.h"
+#include "DataBlobImpl.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+static const char* VSSource = R"(
+float4 main(uint VertId : SV_VertexID) : SV_Position
+{
+    return float4(float(VertId), 0.0, 0.0, 1.0);
+}
+)";
+
+static const char* PSSource = R"(
+cbuffer Constants
+{
+    float4 g_Color;
+};
+
+float4 main() : SV_Target
+{
+    return g_Color;
+}
+)";
+
+RefCntAutoPtr<IPipelineState> CreateTestPSO(GPUTestingEnvironment* pEnv)
+{
+    IRenderDevice* pDevice = pEnv->GetDevice();
+
+    GraphicsPipelineStateCreateInfo PSOCreateInfo;
+
+    PSOCreateInfo.PSODesc.Name                                  = "Program binary cache test";
+    PSOCreateInfo.GraphicsPipeline.NumRenderTargets             = 1;
+    PSOCreateInfo.GraphicsPipeline.RTVFormats[0]                = TEX_FORMAT_RGBA8_UNORM;
+    PSOCreateInfo.GraphicsPipeline.DepthStencilDesc.DepthEnable = False;
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.ShaderCompiler = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+    ShaderCI.EntryPoint     = "main";
+
+    RefCntAutoPtr<IShader> pVS;
+    {
+        ShaderCI.Desc   = {"Program binary cache test VS", SHADER_TYPE_VERTEX, true};
+        ShaderCI.Source = VSSource;
+        pDevice->CreateShader(ShaderCI, &pVS);
+        if (!pVS)
+        {
+            ADD_FAILURE() << "Failed to create vertex shader";
+            return {};
+        }
+    }
+
+    RefCntAutoPtr<IShader> pPS;
+    {
+        ShaderCI.Desc   = {"Program binary cache test PS", SHADER_TYPE_PIXEL, true};
+        ShaderCI.Source = PSSource;
+        pDevice->CreateShader(ShaderCI, &pPS);
+        if (!pPS)
+        {
+            ADD_FAILURE() << "Failed to create pixel shader";
+            return {};
+        }
+    }
+
+    PSOCreateInfo.pVS = pVS;
+    PSOCreateInfo.pPS = pPS;
+
+    RefCntAutoPtr<IPipelineState> pPSO;
+    pDevice->CreateGraphicsPipelineState(PSOCreateInfo, &pPSO);
+    return pPSO;
+}
+
+RefCntAutoPtr<IDataBlob> WriteCache(IRenderDeviceGL* pDeviceGL)
+{
+    RefCntAutoPtr<IDataBlob> pData;
+    EXPECT_TRUE(pDeviceGL->WriteProgramBinaryCacheToBlob(&pData));
+    return pData;
+}
+
+TEST(ProgramBinaryCacheGL, WriteAndLoad)
+{
+    TestingEnvironmentGL* pEnv    = TestingEnvironmentGL::GetInstance();
+    IRenderDevice*        pDevice = pEnv->GetDevice();
+    if (!pDevice->GetDeviceInfo().IsGLDevice())
+    {
+        GTEST_SKIP() << "Program binary cache is only supported in OpenGL";
+    }
+
+    RefCntAutoPtr<IRenderDeviceGL> pDeviceGL{pDevice, IID_RenderDeviceGL};
+    ASSERT_NE(pDeviceGL, nullptr);
+
+    if (!pDeviceGL->EnableProgramBinaryCache())
+    {
+        GTEST_SKIP() << "Program binaries are not supported by this driver";
+    }
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    RefCntAutoPtr<IDataBlob> pEmptyCache = WriteCache(pDeviceGL);
+    ASSERT_NE(pEmptyCache, nullptr);
+
+    // Link the program and store its binary
+    {
+        RefCntAutoPtr<IPipelineState> pPSO = CreateTestPSO(pEnv);
+        ASSERT_NE(pPSO, nullptr);
+    }
+    RefCntAutoPtr<IDataBlob> pCache = WriteCache(pDeviceGL);
+    ASSERT_NE(pCache, nullptr);
+    EXPECT_GT(pCache->GetSize(), pEmptyCache->GetSize());
+
+    // Load the program from the binary. The binary is not stored again, so the cache must not change.
+    EXPECT_TRUE(pDeviceGL->EnableProgramBinaryCache(pCache));
+    {
+        RefCntAutoPtr<IPipelineState> pPSO = CreateTestPSO(pEnv);
+        ASSERT_NE(pPSO, nullptr);
+    }
+    {
+        RefCntAutoPtr<IDataBlob> pCache2 = WriteCache(pDeviceGL);
+        ASSERT_NE(pCache2, nullptr);
+        EXPECT_EQ(pCache2->GetSize(), pCache->GetSize());
+    }
+
+    // Corrupted data is ignored and the cache starts empty. The program is linked from shaders and stored again.
+    {
+        RefCntAutoPtr<DataBlobImpl> pCorrupted = DataBlobImpl::Create(pCache->GetSize(), pCache->GetConstDataPtr());
+        Uint8*                      pBytes     = pCorrupted->GetDataPtr<Uint8>();
+        for (size_t i = pCorrupted->GetSize() - 16; i < pCorrupted->GetSize(); ++i)
+            pBytes[i] ^= 0x5A;
+
+        EXPECT_TRUE(pDeviceGL->EnableProgramBinaryCache(pCorrupted));
+        {
+            RefCntAutoPtr<IDataBlob> pCache2 = WriteCache(pDeviceGL);
+            ASSERT_NE(pCache2, nullptr);
+            EXPECT_EQ(pCache2->GetSize(), pEmptyCache->GetSize());
+        }
+
+        {
+            RefCntAutoPtr<IPipelineState> pPSO = CreateTestPSO(pEnv);
+            ASSERT_NE(pPSO, nullptr);
+        }
+        RefCntAutoPtr<IDataBlob> pCache2 = WriteCache(pDeviceGL);
+        ASSERT_NE(pCache2, nullptr);
+        EXPECT_EQ(pCache2->GetSize(), pCache->GetSize());
+    }
+
+    // Data that is not a program binary cache is ignored as well
+    {
+        const std::vector<Uint8>    Garbage(64, 0xCD);
+        RefCntAutoPtr<DataBlobImpl> pGarbage = DataBlobImpl::Create(Garbage.size(), Garbage.data());
+        EXPECT_TRUE(pDeviceGL->EnableProgramBinaryCache(pGarbage));
+
+        RefCntAutoPtr<IDataBlob> pCache2 = WriteCache(pDeviceGL);
+        ASSERT_NE(pCache2, nullptr);
+        EXPECT_EQ(pCache2->GetSize(), pEmptyCache->GetSize());
+    }
+}
+
+} // namespace
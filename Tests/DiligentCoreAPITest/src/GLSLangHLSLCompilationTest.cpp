@@ -0,0 +1,145 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "GPUTestingEnvironment.hpp"
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+#include "ShaderMacroHelper.hpp"
+#include "Timer.hpp"
+
+#if VULKAN_SUPPORTED && !DILIGENT_NO_GLSLANG
+#    include "GLSLangUtils.hpp"
+#endif
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+struct ShaderFileInfo
+{
+    const char* const FilePath;
+    const SHADER_TYPE Type;
+};
+
+// Measures the time it takes to compile a set of HLSL shaders with glslang, with the full
+// preamble assembled for every shader (baseline) and with the cached stripped preamble.
+// The first iteration of each mode includes one-time initialization costs (e.g. preparing the
+// HLSL prelude), so it is reported separately from the remaining iterations.
+TEST(Shader, GLSLangHLSLCompilationTime)
+{
+    GPUTestingEnvironment* pEnv    = GPUTestingEnvironment::GetInstance();
+    IRenderDevice*         pDevice = pEnv->GetDevice();
+    if (!pDevice->GetDeviceInfo().IsVulkanDevice())
+    {
+        GTEST_SKIP() << "HLSL compilation with glslang is only tested in Vulkan";
+    }
+#if !VULKAN_SUPPORTED || DILIGENT_NO_GLSLANG
+    GTEST_SKIP() << "glslang is not available";
+#else
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pShaderSourceFactory;
+    pDevice->GetEngineFactory()->CreateDefaultShaderSourceStreamFactory("shaders;shaders/RenderStateCache", &pShaderSourceFactory);
+    ASSERT_NE(pShaderSourceFactory, nullptr);
+
+    constexpr ShaderFileInfo Shaders[] = {
+        {"DotNetCube.vsh", SHADER_TYPE_VERTEX},
+        {"DotNetCube.psh", SHADER_TYPE_PIXEL},
+        {"ShaderVariableAccessTestDX.vsh", SHADER_TYPE_VERTEX},
+        {"ShaderVariableAccessTestDX.psh", SHADER_TYPE_PIXEL},
+        {"AsyncShaderCompilationTest.vsh", SHADER_TYPE_VERTEX},
+        {"AsyncShaderCompilationTest.psh", SHADER_TYPE_PIXEL},
+        {"RenderStateCache/VertexShader.vsh", SHADER_TYPE_VERTEX},
+        {"RenderStateCache/PixelShader.psh", SHADER_TYPE_PIXEL},
+    };
+
+    ShaderMacroHelper Macros;
+    Macros.Add("SIMPLIFIED", 1);
+    Macros.Add("INTERNAL_MACROS", 1);
+    Macros.Add("EXTERNAL_MACROS", 2);
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.pShaderSourceStreamFactory = pShaderSourceFactory;
+    ShaderCI.EntryPoint                 = "main";
+    ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.ShaderCompiler             = SHADER_COMPILER_GLSLANG;
+    ShaderCI.Macros                     = Macros;
+
+    constexpr Uint32 NumIterations = 5;
+    constexpr Uint32 NumShaders    = _countof(Shaders);
+
+    struct CompilationTime
+    {
+        double FirstIteration = 0; // ms/shader
+        double Subsequent     = 0; // ms/shader
+    };
+    auto MeasureCompilationTime = [&](bool UseCachedPreamble) {
+        GLSLangUtils::SetUseCachedHLSLPreamble(UseCachedPreamble);
+
+        double FirstIterationTime = 0;
+        double TotalTime          = 0;
+        for (Uint32 iter = 0; iter < NumIterations; ++iter)
+        {
+            Timer T;
+            for (const ShaderFileInfo& Info : Shaders)
+            {
+                ShaderCI.FilePath = Info.FilePath;
+                ShaderCI.Desc     = {Info.FilePath, Info.Type, true};
+
+                const std::vector<unsigned int> SPIRV = GLSLangUtils::HLSLtoSPIRV(ShaderCI, GLSLangUtils::SpirvVersion::Vk100, nullptr, nullptr);
+                EXPECT_FALSE(SPIRV.empty()) << Info.FilePath;
+            }
+            const double IterTime = T.GetElapsedTime();
+            if (iter == 0)
+                FirstIterationTime = IterTime;
+            else
+                TotalTime += IterTime;
+        }
+
+        CompilationTime Time;
+        Time.FirstIteration = FirstIterationTime * 1000.0 / NumShaders;
+        Time.Subsequent     = TotalTime * 1000.0 / ((NumIterations - 1) * NumShaders);
+        return Time;
+    };
+
+    const CompilationTime FullPreambleTime   = MeasureCompilationTime(false);
+    const CompilationTime CachedPreambleTime = MeasureCompilationTime(true);
+
+    LOG_INFO_MESSAGE("glslang HLSL compilation time, full preamble: first iteration: ", FullPreambleTime.FirstIteration,
+                     " ms/shader; subsequent iterations: ", FullPreambleTime.Subsequent, " ms/shader");
+    LOG_INFO_MESSAGE("glslang HLSL compilation time, cached preamble: first iteration: ", CachedPreambleTime.FirstIteration,
+                     " ms/shader; subsequent iterations: ", CachedPreambleTime.Subsequent, " ms/shader (",
+                     FullPreambleTime.Subsequent / std::max(CachedPreambleTime.Subsequent, 1e-6), "x speedup)");
+#endif
+}
+
+} // namespace
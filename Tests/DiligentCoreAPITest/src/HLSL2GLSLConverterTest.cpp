@@ -25,8 +25,12 @@
  *  of the possibility of such damages.
  */
 
+#include <cstring>
+#include <vector>
+
 #include "GPUTestingEnvironment.hpp"
 #include "HLSL2GLSLConverter.h"
+#include "Timer.hpp"
 
 #include "gtest/gtest.h"
 
@@ -175,4 +179,90 @@ TEST(HLSL2GLSLConverterTest, Preprocessor)
     }
 }
 
+// Converts several entry points from the same source using a single conversion stream and
+// compares the throughput with converting every entry point from a freshly created stream.
+TEST(HLSL2GLSLConverterTest, ConversionStreamThroughput)
+{
+    GPUTestingEnvironment* pEnv    = GPUTestingEnvironment::GetInstance();
+    IRenderDevice*         pDevice = pEnv->GetDevice();
+
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pShaderSourceFactory;
+    pDevice->GetEngineFactory()->CreateDefaultShaderSourceStreamFactory("shaders/HLSL2GLSLConverter", &pShaderSourceFactory);
+    ASSERT_NE(pShaderSourceFactory, nullptr);
+
+    RefCntAutoPtr<IHLSL2GLSLConverter> pConverter;
+    CreateHLSL2GLSLConverter(&pConverter);
+    ASSERT_NE(pConverter, nullptr);
+
+    struct EntryPointInfo
+    {
+        const char* const Name;
+        const SHADER_TYPE Type;
+    };
+    constexpr EntryPointInfo EntryPoints[] =
+        {
+            {"main1", SHADER_TYPE_PIXEL},
+            {"main2", SHADER_TYPE_PIXEL},
+            {"main3", SHADER_TYPE_PIXEL},
+        };
+    constexpr char FileName[] = "PreprocessorTest.hlsl";
+
+    auto Convert = [](IHLSL2GLSLConversionStream* pStream, const EntryPointInfo& EntryPoint, bool UseRowMajorMatrices) {
+        RefCntAutoPtr<IDataBlob> pGLSLSource;
+        pStream->Convert(EntryPoint.Name, EntryPoint.Type, true, "_sampler", true, UseRowMajorMatrices, &pGLSLSource);
+        return pGLSLSource;
+    };
+
+    constexpr Uint32 NumIterations = 20;
+
+    double StreamTime     = 0;
+    double StandaloneTime = 0;
+    for (Uint32 iter = 0; iter < NumIterations; ++iter)
+    {
+        const bool UseRowMajorMatrices = (iter & 0x01) != 0;
+
+        std::vector<RefCntAutoPtr<IDataBlob>> StreamSources;
+        {
+            Timer T;
+
+            RefCntAutoPtr<IHLSL2GLSLConversionStream> pStream;
+            pConverter->CreateStream(FileName, pShaderSourceFactory, nullptr, 0, &pStream);
+            ASSERT_NE(pStream, nullptr);
+            for (const EntryPointInfo& EntryPoint : EntryPoints)
+                StreamSources.emplace_back(Convert(pStream, EntryPoint, UseRowMajorMatrices));
+
+            StreamTime += T.GetElapsedTime();
+        }
+
+        std::vector<RefCntAutoPtr<IDataBlob>> StandaloneSources;
+        {
+            Timer T;
+
+            for (const EntryPointInfo& EntryPoint : EntryPoints)
+            {
+                RefCntAutoPtr<IHLSL2GLSLConversionStream> pStream;
+                pConverter->CreateStream(FileName, pShaderSourceFactory, nullptr, 0, &pStream);
+                ASSERT_NE(pStream, nullptr);
+                StandaloneSources.emplace_back(Convert(pStream, EntryPoint, UseRowMajorMatrices));
+            }
+
+            StandaloneTime += T.GetElapsedTime();
+        }
+
+        for (size_t i = 0; i < _countof(EntryPoints); ++i)
+        {
+            const IDataBlob* pStreamSrc     = StreamSources[i];
+            const IDataBlob* pStandaloneSrc = StandaloneSources[i];
+            ASSERT_NE(pStreamSrc, nullptr) << EntryPoints[i].Name;
+            ASSERT_NE(pStandaloneSrc, nullptr) << EntryPoints[i].Name;
+            ASSERT_EQ(pStreamSrc->GetSize(), pStandaloneSrc->GetSize()) << EntryPoints[i].Name;
+            EXPECT_EQ(memcmp(pStreamSrc->GetConstDataPtr(), pStandaloneSrc->GetConstDataPtr(), pStreamSrc->GetSize()), 0) << EntryPoints[i].Name;
+        }
+    }
+
+    constexpr Uint32 NumConversions = NumIterations * _countof(EntryPoints);
+    LOG_INFO_MESSAGE("HLSL2GLSL conversion throughput: shared stream: ", StreamTime * 1000.0 / NumConversions,
+                     " ms/conversion; stream per conversion: ", StandaloneTime * 1000.0 / NumConversions, " ms/conversion");
+}
+
 } // namespace
@@ -31,9 +31,16 @@
 
 #include "GPUTestingEnvironment.hpp"
 #include "ThreadSignal.hpp"
+#include "Timer.hpp"
+#include "GraphicsTypesX.hpp"
 #if D3D12_SUPPORTED
 #    include "D3D12/D3D12DebugLayerSetNameBugWorkaround.hpp"
 #endif
+#if VULKAN_SUPPORTED
+#    define VK_NO_PROTOTYPES
+#    include "vulkan/vulkan.h"
+#    include "RenderDeviceVk.h"
+#endif
 
 #include "gtest/gtest.h"
 
@@ -43,6 +50,22 @@ using namespace Diligent::Testing;
 namespace
 {
 
+#if VULKAN_SUPPORTED
+std::vector<DescriptorSetAllocatorShardStatsVk> GetDescriptorSetAllocatorShardStats(IRenderDevice* pDevice)
+{
+    std::vector<DescriptorSetAllocatorShardStatsVk> Stats;
+
+    RefCntAutoPtr<IRenderDeviceVk> pDeviceVk{pDevice, IID_RenderDeviceVk};
+    if (pDeviceVk)
+    {
+        Stats.resize(pDeviceVk->GetNumDescriptorSetAllocatorShards());
+        for (Uint32 i = 0; i < Stats.size(); ++i)
+            pDeviceVk->GetDescriptorSetAllocatorShardStats(i, Stats[i]);
+    }
+    return Stats;
+}
+#endif
+
 static const char g_ShaderSource[] = R"(
 void VSMain(out float4 pos : SV_POSITION)
 {
@@ -55,6 +78,21 @@ void PSMain(out float4 col : SV_TARGET)
 }
 )";
 
+static const char g_SRBTestPSSource[] = R"(
+cbuffer cbConstants
+{
+    float4 g_Color;
+}
+
+Texture2D g_Tex2D;
+
+void PSMain(in  float4 Pos : SV_POSITION,
+            out float4 Col : SV_TARGET)
+{
+    Col = g_Tex2D.Load(int3(0, 0, 0)) * g_Color;
+}
+)";
+
 
 class MultithreadedResourceCreationTest : public ::testing::Test
 {
@@ -82,7 +120,7 @@ protected:
 #ifdef DILIGENT_DEBUG
     static const int NumIterations = 10;
 #else
-    static const int NumIterations = 30;
+    static const int NumIterations    = 30;
 #endif
 };
 
@@ -326,4 +364,159 @@ TEST_F(MultithreadedResourceCreationTest, CreateResources)
         t.join();
 }
 
+
+TEST(MultithreadedSRBCreationTest, CreateSRBs)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+    auto* pCtx    = pEnv->GetDeviceContext();
+    if (pDevice->GetDeviceInfo().IsGLDevice())
+    {
+        GTEST_SKIP() << "Multithreading resource creation is not supported in OpenGL";
+    }
+
+    if (pDevice->GetDeviceInfo().IsWebGPUDevice())
+    {
+        GTEST_SKIP() << "Multithreading resource creation is not supported in WebGPU";
+    }
+
+    GPUTestingEnvironment::ScopedReset EnvironmentAutoReset;
+
+    RefCntAutoPtr<IPipelineState> pPSO;
+    {
+        ShaderCreateInfo ShaderCI;
+        ShaderCI.Source         = g_ShaderSource;
+        ShaderCI.EntryPoint     = "VSMain";
+        ShaderCI.Desc           = {"SRB creation test VS", SHADER_TYPE_VERTEX, true};
+        ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+        ShaderCI.ShaderCompiler = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+        RefCntAutoPtr<IShader> pVS;
+        pDevice->CreateShader(ShaderCI, &pVS);
+        ASSERT_NE(pVS, nullptr);
+
+        ShaderCI.Source     = g_SRBTestPSSource;
+        ShaderCI.EntryPoint = "PSMain";
+        ShaderCI.Desc       = {"SRB creation test PS", SHADER_TYPE_PIXEL, true};
+        RefCntAutoPtr<IShader> pPS;
+        pDevice->CreateShader(ShaderCI, &pPS);
+        ASSERT_NE(pPS, nullptr);
+
+        PipelineResourceLayoutDescX ResourceLayout;
+        ResourceLayout
+            .SetDefaultVariableType(SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE)
+            .AddVariable(SHADER_TYPE_PIXEL, "cbConstants", SHADER_RESOURCE_VARIABLE_TYPE_STATIC);
+
+        GraphicsPipelineStateCreateInfoX PSOCreateInfo{"SRB creation test PSO"};
+        PSOCreateInfo
+            .AddShader(pVS)
+            .AddShader(pPS)
+            .AddRenderTarget(TEX_FORMAT_RGBA8_UNORM)
+            .SetPrimitiveTopology(PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP)
+            .SetResourceLayout(ResourceLayout);
+        PSOCreateInfo.GraphicsPipeline.DepthStencilDesc.DepthEnable = False;
+
+        pDevice->CreateGraphicsPipelineState(PSOCreateInfo, &pPSO);
+        ASSERT_NE(pPSO, nullptr);
+    }
+
+    RefCntAutoPtr<IBuffer> pConstants = pEnv->CreateBuffer({"SRB creation test constants", 16, BIND_UNIFORM_BUFFER});
+    ASSERT_NE(pConstants, nullptr);
+    pPSO->GetStaticVariableByName(SHADER_TYPE_PIXEL, "cbConstants")->Set(pConstants);
+
+    RefCntAutoPtr<ITexture> pTex = pEnv->CreateTexture("SRB creation test texture", TEX_FORMAT_RGBA8_UNORM, BIND_SHADER_RESOURCE, 4, 4);
+    ASSERT_NE(pTex, nullptr);
+    ITextureView* pTexSRV = pTex->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE);
+
+#ifdef DILIGENT_DEBUG
+    constexpr Uint32 NumSRBsPerThread = 1000;
+#else
+    constexpr Uint32 NumSRBsPerThread = 10000;
+#endif
+    // Keep this many SRBs alive in each thread so that descriptor pools are
+    // shared between live and released sets.
+    constexpr Uint32 NumLiveSRBs = 256;
+
+    const Uint32 NumThreads = std::max(std::thread::hardware_concurrency(), 4u);
+
+#if VULKAN_SUPPORTED
+    const std::vector<DescriptorSetAllocatorShardStatsVk> StartShardStats = GetDescriptorSetAllocatorShardStats(pDevice);
+#endif
+
+    Threading::Signal StartSignal;
+    std::atomic_int   NumThreadsRunning{static_cast<int>(NumThreads)};
+
+    std::vector<std::thread> Threads(NumThreads);
+    for (std::thread& t : Threads)
+    {
+        t = std::thread{
+            [&]() {
+                StartSignal.Wait();
+
+                std::vector<RefCntAutoPtr<IShaderResourceBinding>> SRBs(NumLiveSRBs);
+                for (Uint32 i = 0; i < NumSRBsPerThread; ++i)
+                {
+                    // Release the oldest SRB. Its descriptor set will be returned to the allocator
+                    // by the main thread while other threads keep allocating.
+                    RefCntAutoPtr<IShaderResourceBinding>& pSRB = SRBs[i % NumLiveSRBs];
+                    pSRB.Release();
+
+                    pPSO->CreateShaderResourceBinding(&pSRB, true);
+                    if (!pSRB)
+                    {
+                        ADD_FAILURE() << "Failed to create SRB";
+                        break;
+                    }
+                    pSRB->GetVariableByName(SHADER_TYPE_PIXEL, "g_Tex2D")->Set(pTexSRV);
+                }
+
+                --NumThreadsRunning;
+            }};
+    }
+
+    Timer  T;
+    double StartTime = T.GetElapsedTime();
+    StartSignal.Trigger(true);
+
+    // Release stale resources while worker threads are creating SRBs
+    while (NumThreadsRunning > 0)
+    {
+        pCtx->Flush();
+        pCtx->FinishFrame();
+        pDevice->ReleaseStaleResources();
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+
+    for (std::thread& t : Threads)
+        t.join();
+
+    const double ElapsedTime = T.GetElapsedTime() - StartTime;
+    const Uint32 TotalSRBs   = NumSRBsPerThread * NumThreads;
+    LOG_INFO_MESSAGE("Created ", TotalSRBs, " SRBs in ", NumThreads, " threads in ", ElapsedTime * 1000, " ms (",
+                     static_cast<Uint32>(TotalSRBs / std::max(ElapsedTime, 1e-6)), " SRBs/s)");
+
+#if VULKAN_SUPPORTED
+    const std::vector<DescriptorSetAllocatorShardStatsVk> EndShardStats = GetDescriptorSetAllocatorShardStats(pDevice);
+    if (!EndShardStats.empty())
+    {
+        ASSERT_EQ(StartShardStats.size(), EndShardStats.size());
+
+        // Worker threads must be spread across shards, and most sets must be allocated from the home shard
+        Uint32 NumUsedShards         = 0;
+        Uint64 NumAllocations        = 0;
+        Uint64 NumForeignAllocations = 0;
+        for (size_t i = 0; i < EndShardStats.size(); ++i)
+        {
+            const Uint64 ShardAllocations = EndShardStats[i].NumAllocations - StartShardStats[i].NumAllocations;
+            if (ShardAllocations > 0)
+                ++NumUsedShards;
+            NumAllocations += ShardAllocations;
+            NumForeignAllocations += EndShardStats[i].NumForeignAllocations - StartShardStats[i].NumForeignAllocations;
+        }
+        EXPECT_GT(NumUsedShards, 1u);
+        EXPECT_GE(NumAllocations, TotalSRBs);
+        EXPECT_LE(NumForeignAllocations, NumAllocations / 2);
+    }
+#endif
+}
+
 } // namespace
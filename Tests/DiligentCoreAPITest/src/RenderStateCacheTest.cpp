@@ -25,6 +25,11 @@
  */
 
 #include <functional>
+#include <thread>
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <string>
 
 #include "GPUTestingEnvironment.hpp"
 #include "TestingSwapChainBase.hpp"
@@ -34,6 +39,11 @@
 #include "GraphicsTypesX.hpp"
 #include "CallbackWrapper.hpp"
 #include "ResourceLayoutTestCommon.hpp"
+#include "ThreadPool.hpp"
+#include "Timer.hpp"
+#include "ObjectBase.hpp"
+#include "MemoryFileStream.hpp"
+#include "DataBlobImpl.hpp"
 
 #include "InlineShaders/RayTracingTestHLSL.h"
 #include "InlineShaders/DrawCommandTestHLSL.h"
@@ -1797,4 +1807,361 @@ TEST(RenderStateCacheTest, GLExtensions)
     }
 }
 
+// Shader source factory whose files can be edited and that counts the streams it opens
+class EditableShaderSourceFactory final : public ObjectBase<IShaderSourceInputStreamFactory>
+{
+public:
+    using TBase = ObjectBase<IShaderSourceInputStreamFactory>;
+
+    EditableShaderSourceFactory(IReferenceCounters* pRefCounters) :
+        TBase{pRefCounters}
+    {}
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_IShaderSourceInputStreamFactory, TBase)
+
+    virtual void DILIGENT_CALL_TYPE CreateInputStream(const Char* Name, IFileStream** ppStream) override final
+    {
+        CreateInputStream2(Name, CREATE_SHADER_SOURCE_INPUT_STREAM_FLAG_NONE, ppStream);
+    }
+
+    virtual void DILIGENT_CALL_TYPE CreateInputStream2(const Char*                             Name,
+                                                       CREATE_SHADER_SOURCE_INPUT_STREAM_FLAGS Flags,
+                                                       IFileStream**                           ppStream) override final
+    {
+        std::lock_guard<std::mutex> Guard{m_Mtx};
+        ++m_NumStreamsOpened;
+
+        auto it = m_Files.find(Name);
+        if (it == m_Files.end())
+            return;
+
+        RefCntAutoPtr<IDataBlob>        pDataBlob = DataBlobImpl::Create(it->second.length(), it->second.c_str());
+        RefCntAutoPtr<MemoryFileStream> pMemStream{MakeNewRCObj<MemoryFileStream>()(pDataBlob)};
+        pMemStream->QueryInterface(IID_FileStream, reinterpret_cast<IObject**>(ppStream));
+    }
+
+    void SetFile(const char* Name, const char* Source)
+    {
+        std::lock_guard<std::mutex> Guard{m_Mtx};
+        m_Files[Name] = Source;
+    }
+
+    Uint32 GetNumStreamsOpened()
+    {
+        std::lock_guard<std::mutex> Guard{m_Mtx};
+        return m_NumStreamsOpened;
+    }
+
+    void ResetNumStreamsOpened()
+    {
+        std::lock_guard<std::mutex> Guard{m_Mtx};
+        m_NumStreamsOpened = 0;
+    }
+
+private:
+    std::mutex                         m_Mtx;
+    std::map<std::string, std::string> m_Files;
+    Uint32                             m_NumStreamsOpened = 0;
+};
+
+TEST(RenderStateCacheTest, SourceFileHashMemo)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    GPUTestingEnvironment::ScopedReset AutoReset;
+
+    static constexpr char MainSource[] = R"(
+#include "Color.fxh"
+
+float4 main() : SV_Target
+{
+    return GetColor();
+}
+)";
+
+    static constexpr char ColorSource[] = R"(
+float4 GetColor()
+{
+    return float4(1.0, 0.0, 0.0, 1.0);
+}
+)";
+
+    static constexpr char EditedColorSource[] = R"(
+float4 GetColor()
+{
+    return float4(0.0, 1.0, 0.0, 1.0);
+}
+)";
+
+    RefCntAutoPtr<EditableShaderSourceFactory> pFactory{MakeNewRCObj<EditableShaderSourceFactory>()()};
+    pFactory->SetFile("Main.psh", MainSource);
+    pFactory->SetFile("Color.fxh", ColorSource);
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.pShaderSourceStreamFactory = pFactory;
+    ShaderCI.SourceLanguage             = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.ShaderCompiler             = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+    ShaderCI.Desc                       = {"RenderStateCache - Source file hash memo", SHADER_TYPE_PIXEL, true};
+    ShaderCI.FilePath                   = "Main.psh";
+    ShaderCI.EntryPoint                 = "main";
+
+    // Reload() must re-read the edited include
+    {
+        auto pCache = CreateCache(pDevice, /*HotReload = */ true);
+        ASSERT_TRUE(pCache);
+
+        RefCntAutoPtr<IShader> pShader;
+        CreateShader(pCache, ShaderCI, false, pShader);
+
+        // Warm lookup must not open any streams
+        pFactory->ResetNumStreamsOpened();
+        RefCntAutoPtr<IShader> pShader2;
+        CreateShader(pCache, ShaderCI, true, pShader2);
+        EXPECT_EQ(pShader, pShader2);
+        EXPECT_EQ(pFactory->GetNumStreamsOpened(), 0u);
+
+        EXPECT_EQ(pCache->Reload(), 0u);
+
+        // Memoized hashes are only invalidated by Reload() and Reset()
+        pFactory->SetFile("Color.fxh", EditedColorSource);
+        RefCntAutoPtr<IShader> pShader3;
+        CreateShader(pCache, ShaderCI, true, pShader3);
+        EXPECT_EQ(pShader, pShader3);
+
+        // The shader hash changes, so the shader must be recreated
+        EXPECT_EQ(pCache->Reload(), 1u);
+        EXPECT_GT(pFactory->GetNumStreamsOpened(), 0u);
+
+        pFactory->ResetNumStreamsOpened();
+        RefCntAutoPtr<IShader> pShader4;
+        CreateShader(pCache, ShaderCI, true, pShader4);
+        EXPECT_EQ(pFactory->GetNumStreamsOpened(), 0u);
+    }
+
+    // Reset() must re-read the edited include
+    {
+        pFactory->SetFile("Color.fxh", ColorSource);
+
+        RefCntAutoPtr<IDataBlob> pData;
+        {
+            auto pCache = CreateCache(pDevice, /*HotReload = */ false);
+            ASSERT_TRUE(pCache);
+
+            RefCntAutoPtr<IShader> pShader;
+            CreateShader(pCache, ShaderCI, false, pShader);
+            pCache->WriteToBlob(ContentVersion, &pData);
+            ASSERT_TRUE(pData);
+        }
+
+        auto pCache = CreateCache(pDevice, /*HotReload = */ false, pData);
+        ASSERT_TRUE(pCache);
+        {
+            RefCntAutoPtr<IShader> pShader;
+            CreateShader(pCache, ShaderCI, true, pShader);
+        }
+
+        pFactory->SetFile("Color.fxh", EditedColorSource);
+        pCache->Reset();
+        EXPECT_TRUE(pCache->Load(pData, ContentVersion));
+        {
+            // The archive only contains the shader with the original include
+            RefCntAutoPtr<IShader> pShader;
+            CreateShader(pCache, ShaderCI, false, pShader);
+        }
+    }
+}
+
+TEST(RenderStateCacheTest, CreateInBatch)
+{
+    auto* pEnv       = GPUTestingEnvironment::GetInstance();
+    auto* pDevice    = pEnv->GetDevice();
+    auto* pSwapChain = pEnv->GetSwapChain();
+
+    GPUTestingEnvironment::ScopedReset AutoReset;
+
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pShaderSourceFactory;
+    pDevice->GetEngineFactory()->CreateDefaultShaderSourceStreamFactory("shaders/RenderStateCache", &pShaderSourceFactory);
+    ASSERT_TRUE(pShaderSourceFactory);
+
+    constexpr Uint32 NumVariants   = 32;
+    constexpr Uint32 NumDuplicates = 8;
+
+    // Every variant defines a unique macro, so that all variants have different hashes.
+    std::vector<std::string>      VariantStrings(NumVariants);
+    std::vector<ShaderMacro>      VariantMacros(NumVariants * 2);
+    std::vector<ShaderCreateInfo> ShaderCIs(NumVariants + NumDuplicates);
+    for (Uint32 i = 0; i < NumVariants; ++i)
+    {
+        VariantStrings[i]        = std::to_string(i);
+        VariantMacros[i * 2 + 0] = {"EXTERNAL_MACROS", "2"};
+        VariantMacros[i * 2 + 1] = {"BATCH_VARIANT", VariantStrings[i].c_str()};
+
+        ShaderCreateInfo& ShaderCI              = ShaderCIs[i];
+        ShaderCI.pShaderSourceStreamFactory     = pShaderSourceFactory;
+        ShaderCI.SourceLanguage                 = SHADER_SOURCE_LANGUAGE_HLSL;
+        ShaderCI.ShaderCompiler                 = pEnv->GetDefaultCompiler(ShaderCI.SourceLanguage);
+        ShaderCI.Macros                         = {&VariantMacros[i * 2], 2};
+        ShaderCI.Desc                           = {"RenderStateCache - Batch PS", SHADER_TYPE_PIXEL, true};
+        ShaderCI.FilePath                       = "PixelShader.psh";
+        ShaderCI.WebGPUEmulatedArrayIndexSuffix = "_";
+    }
+    for (Uint32 i = 0; i < NumDuplicates; ++i)
+        ShaderCIs[NumVariants + i] = ShaderCIs[i];
+
+    const Uint32 NumShaders = static_cast<Uint32>(ShaderCIs.size());
+
+    RefCntAutoPtr<IShader> pVS;
+    {
+        auto pCache = CreateCache(pDevice, /*HotReload = */ false);
+        CreateShader(pCache, pShaderSourceFactory, SHADER_TYPE_VERTEX, SHADER_COMPILE_FLAG_NONE, "RenderStateCache - VS", "VertexShader.vsh", false, pVS);
+        ASSERT_TRUE(pVS);
+    }
+
+    const Uint32 NumThreads = std::max(std::thread::hardware_concurrency(), 2u);
+
+    RefCntAutoPtr<IThreadPool> pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{NumThreads});
+    ASSERT_TRUE(pThreadPool);
+
+    auto CreateShadersInBatch = [&](IRenderStateCache* pCache, IThreadPool* pPool, std::vector<RefCntAutoPtr<IShader>>& Shaders) {
+        std::vector<IShader*>    ppShaders(NumShaders);
+        std::vector<IAsyncTask*> ppTasks(NumShaders);
+
+        Timer T;
+        pCache->CreateShaders(NumShaders, ShaderCIs.data(), pPool, ppShaders.data(), ppTasks.data());
+        // Shaders with identical create infos share the same task
+        for (Uint32 i = 0; i < NumDuplicates; ++i)
+            EXPECT_EQ(ppTasks[i], ppTasks[NumVariants + i]);
+        for (Uint32 i = 0; i < NumShaders; ++i)
+        {
+            if (pPool != nullptr)
+            {
+                EXPECT_NE(ppTasks[i], nullptr);
+                if (ppTasks[i] == nullptr)
+                    continue;
+                ppTasks[i]->WaitForCompletion();
+                EXPECT_EQ(ppTasks[i]->GetStatus(), ASYNC_TASK_STATUS_COMPLETE);
+                ppTasks[i]->Release();
+            }
+            else
+            {
+                EXPECT_EQ(ppTasks[i], nullptr);
+            }
+        }
+        const double Time = T.GetElapsedTime();
+
+        Shaders.resize(NumShaders);
+        for (Uint32 i = 0; i < NumShaders; ++i)
+            Shaders[i].Attach(ppShaders[i]);
+
+        return Time;
+    };
+
+    auto VerifyShaders = [&](IRenderStateCache* pCache, const std::vector<RefCntAutoPtr<IShader>>& Shaders) {
+        for (Uint32 i = 0; i < NumShaders; ++i)
+        {
+            ASSERT_NE(Shaders[i], nullptr) << "i = " << i;
+            EXPECT_EQ(Shaders[i]->GetStatus(true), SHADER_STATUS_READY);
+        }
+        // Duplicate create infos must produce the same objects
+        for (Uint32 i = 0; i < NumDuplicates; ++i)
+            EXPECT_EQ(Shaders[i], Shaders[NumVariants + i]);
+
+        // The single-object path must find the same shaders in the cache
+        for (Uint32 i = 0; i < NumShaders; ++i)
+        {
+            RefCntAutoPtr<IShader> pShader;
+            EXPECT_TRUE(pCache->CreateShader(ShaderCIs[i], &pShader)) << "i = " << i;
+            EXPECT_EQ(pShader, Shaders[i]) << "i = " << i;
+        }
+    };
+
+    for (Uint32 HotReload = 0; HotReload < 2; ++HotReload)
+    {
+        // Warm up the cache offline: compile all variants through the cache's serialization device.
+        RefCntAutoPtr<IDataBlob> pData;
+
+        double SerialTime = 0;
+        {
+            auto pCache = CreateCache(pDevice, HotReload);
+            ASSERT_TRUE(pCache);
+
+            std::vector<RefCntAutoPtr<IShader>> Shaders;
+            SerialTime = CreateShadersInBatch(pCache, nullptr, Shaders);
+            VerifyShaders(pCache, Shaders);
+        }
+
+        double ParallelTime = 0;
+        {
+            auto pCache = CreateCache(pDevice, HotReload);
+            ASSERT_TRUE(pCache);
+
+            std::vector<RefCntAutoPtr<IShader>> Shaders;
+            ParallelTime = CreateShadersInBatch(pCache, pThreadPool, Shaders);
+            VerifyShaders(pCache, Shaders);
+
+            pCache->WriteToBlob(ContentVersion, &pData);
+            ASSERT_TRUE(pData);
+        }
+
+        LOG_INFO_MESSAGE("Compiled ", NumVariants, " shader variants in ", SerialTime * 1000, " ms serially and in ", ParallelTime * 1000,
+                         " ms using ", NumThreads, " threads (", SerialTime / std::max(ParallelTime, 1e-6), "x speedup)");
+
+        // All shaders must now be found in the cache
+        {
+            auto pCache = CreateCache(pDevice, HotReload, pData);
+            ASSERT_TRUE(pCache);
+
+            std::vector<RefCntAutoPtr<IShader>> Shaders;
+            CreateShadersInBatch(pCache, pThreadPool, Shaders);
+            VerifyShaders(pCache, Shaders);
+
+            std::vector<GraphicsPipelineStateCreateInfo> PsoCIs(NumShaders);
+            for (Uint32 i = 0; i < NumShaders; ++i)
+            {
+                GraphicsPipelineStateCreateInfo& PsoCI = PsoCIs[i];
+
+                PsoCI.PSODesc.Name                                  = "Render State Cache Test - Batch";
+                PsoCI.PSODesc.ResourceLayout                        = GetGraphicsPSOLayout();
+                PsoCI.GraphicsPipeline.NumRenderTargets             = 1;
+                PsoCI.GraphicsPipeline.RTVFormats[0]                = pSwapChain->GetDesc().ColorBufferFormat;
+                PsoCI.GraphicsPipeline.DepthStencilDesc.DepthEnable = False;
+
+                PsoCI.pVS = pVS;
+                PsoCI.pPS = Shaders[i];
+            }
+
+            std::vector<IPipelineState*> ppPSOs(NumShaders);
+            std::vector<IAsyncTask*>     ppTasks(NumShaders);
+            pCache->CreateGraphicsPipelineStates(NumShaders, PsoCIs.data(), pThreadPool, ppPSOs.data(), ppTasks.data());
+            for (Uint32 i = 0; i < NumShaders; ++i)
+            {
+                ASSERT_NE(ppTasks[i], nullptr);
+                ppTasks[i]->WaitForCompletion();
+            }
+            // Pipelines with identical create infos share the same task
+            for (Uint32 i = 0; i < NumDuplicates; ++i)
+                EXPECT_EQ(ppTasks[i], ppTasks[NumVariants + i]);
+
+            std::vector<RefCntAutoPtr<IPipelineState>> PSOs(NumShaders);
+            for (Uint32 i = 0; i < NumShaders; ++i)
+            {
+                ppTasks[i]->Release();
+                PSOs[i].Attach(ppPSOs[i]);
+                ASSERT_NE(PSOs[i], nullptr) << "i = " << i;
+            }
+            for (Uint32 i = 0; i < NumDuplicates; ++i)
+                EXPECT_EQ(PSOs[i], PSOs[NumVariants + i]);
+
+            // The single-object path must find the same pipelines in the cache
+            for (Uint32 i = 0; i < NumShaders; ++i)
+            {
+                RefCntAutoPtr<IPipelineState> pPSO;
+                EXPECT_TRUE(pCache->CreateGraphicsPipelineState(PsoCIs[i], &pPSO)) << "i = " << i;
+                EXPECT_EQ(pPSO, PSOs[i]) << "i = " << i;
+            }
+        }
+    }
+}
+
 } // namespace
@@ -29,9 +29,14 @@
 #include "GraphicsTypesX.hpp"
 #include "FastRand.hpp"
 
+#include "ThreadSignal.hpp"
+
 #include "gtest/gtest.h"
 
 #include <array>
+#include <vector>
+#include <thread>
+#include <atomic>
 
 using namespace Diligent;
 using namespace Diligent::Testing;
@@ -535,4 +540,136 @@ TEST_F(RenderTargetTest, InactiveRenderTargets)
     }
 }
 
+// Sets random combinations of render targets on multiple deferred contexts in parallel,
+// and releases the render targets between rounds so that new views may reuse the handles
+// of the destroyed ones. This verifies that framebuffer and render pass caches shared
+// between contexts (as well as per-context front caches) never return stale objects.
+TEST_F(RenderTargetTest, DeferredContextsStress)
+{
+    GPUTestingEnvironment* pEnv = GPUTestingEnvironment::GetInstance();
+    if (pEnv->GetNumDeferredContexts() == 0)
+    {
+        GTEST_SKIP() << "Deferred contexts are not supported by this device";
+    }
+
+    IDeviceContext*      pContext   = pEnv->GetDeviceContext();
+    ISwapChain*          pSwapChain = pEnv->GetSwapChain();
+    const SwapChainDesc& SCDesc     = pSwapChain->GetDesc();
+
+    RefCntAutoPtr<ITestingSwapChain> pTestingSwapChain{pSwapChain, IID_TestingSwapChain};
+    ASSERT_NE(pTestingSwapChain, nullptr);
+
+    const float4 FinalColor{sm_Rnd(), sm_Rnd(), sm_Rnd(), sm_Rnd()};
+    {
+        ITextureView* pRTV = sm_Resources.pRT->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET);
+        pContext->SetRenderTargets(1, &pRTV, nullptr, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        pContext->ClearRenderTarget(pRTV, FinalColor.Data(), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+        StateTransitionDesc Barrier{sm_Resources.pRT, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_COPY_SOURCE, STATE_TRANSITION_FLAG_UPDATE_STATE};
+        pContext->TransitionResourceStates(1, &Barrier);
+
+        pContext->Flush();
+        pContext->WaitForIdle();
+
+        pTestingSwapChain->TakeSnapshot(sm_Resources.pRT);
+
+        pContext->InvalidateState();
+    }
+
+    const Uint32 NumThreads = static_cast<Uint32>(std::min(pEnv->GetNumDeferredContexts(), size_t{4}));
+
+    constexpr Uint32 NumRounds         = 8;
+    constexpr Uint32 NumIterations     = 64;
+    constexpr Uint32 TexturesPerThread = 3;
+
+    for (Uint32 round = 0; round < NumRounds; ++round)
+    {
+        // Every thread only uses its own render targets to avoid state transition conflicts
+        std::vector<RefCntAutoPtr<ITexture>> pRTs(NumThreads * TexturesPerThread);
+        std::vector<StateTransitionDesc>     Barriers;
+        for (RefCntAutoPtr<ITexture>& pRT : pRTs)
+        {
+            pRT = pEnv->CreateTexture("Render Target Test - deferred contexts stress", SCDesc.ColorBufferFormat, BIND_RENDER_TARGET, SCDesc.Width, SCDesc.Height);
+            ASSERT_NE(pRT, nullptr);
+            Barriers.emplace_back(pRT, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_RENDER_TARGET, STATE_TRANSITION_FLAG_UPDATE_STATE);
+        }
+        pContext->TransitionResourceStates(static_cast<Uint32>(Barriers.size()), Barriers.data());
+
+        std::vector<std::thread>                 WorkerThreads(NumThreads);
+        std::vector<RefCntAutoPtr<ICommandList>> CmdLists(NumThreads);
+        std::vector<ICommandList*>               CmdListPtrs(NumThreads);
+
+        std::atomic<Uint32> NumCmdListsReady{0};
+        Threading::Signal   FinishFrameSignal;
+        Threading::Signal   ExecuteCommandListsSignal;
+        for (Uint32 i = 0; i < NumThreads; ++i)
+        {
+            WorkerThreads[i] = std::thread(
+                [&](Uint32 thread_id) //
+                {
+                    IDeviceContext* pCtx = pEnv->GetDeferredContext(thread_id);
+
+                    ITextureView* pThreadRTVs[TexturesPerThread] = {};
+                    for (Uint32 tex = 0; tex < TexturesPerThread; ++tex)
+                        pThreadRTVs[tex] = pRTs[thread_id * TexturesPerThread + tex]->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET);
+
+                    FastRandInt   Rnd{round * NumThreads + thread_id, 0, TexturesPerThread - 1};
+                    FastRandFloat RndColor{round * NumThreads + thread_id, 0.f, 1.f};
+
+                    pCtx->Begin(0);
+                    for (Uint32 iter = 0; iter <= NumIterations; ++iter)
+                    {
+                        // Bind all render targets in the last iteration
+                        const Uint32 NumRTs = iter < NumIterations ? 1 + static_cast<Uint32>(Rnd()) : TexturesPerThread;
+                        const Uint32 First  = static_cast<Uint32>(Rnd());
+
+                        ITextureView* pRTVs[TexturesPerThread] = {};
+                        for (Uint32 rt = 0; rt < NumRTs; ++rt)
+                            pRTVs[rt] = pThreadRTVs[(First + rt) % TexturesPerThread];
+
+                        pCtx->SetRenderTargets(NumRTs, pRTVs, nullptr, RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+                        for (Uint32 rt = 0; rt < NumRTs; ++rt)
+                        {
+                            const float4 ClearColor = iter < NumIterations ? float4{RndColor(), RndColor(), RndColor(), RndColor()} : FinalColor;
+                            pCtx->ClearRenderTarget(pRTVs[rt], ClearColor.Data(), RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+                        }
+                    }
+                    pCtx->FinishCommandList(&CmdLists[thread_id]);
+                    CmdListPtrs[thread_id] = CmdLists[thread_id];
+
+                    const Uint32 NumReadyLists = NumCmdListsReady.fetch_add(1) + 1;
+                    if (NumReadyLists == NumThreads)
+                        ExecuteCommandListsSignal.Trigger();
+
+                    FinishFrameSignal.Wait(true, NumThreads);
+
+                    // IMPORTANT: In Metal backend FinishFrame must be called from the same
+                    //            thread that issued rendering commands.
+                    pCtx->FinishFrame();
+                },
+                i);
+        }
+
+        ExecuteCommandListsSignal.Wait(true, 1);
+
+        pContext->ExecuteCommandLists(NumThreads, CmdListPtrs.data());
+
+        FinishFrameSignal.Trigger(true);
+        for (std::thread& t : WorkerThreads)
+            t.join();
+
+        CmdLists.clear();
+
+        for (RefCntAutoPtr<ITexture>& pRT : pRTs)
+            pTestingSwapChain->CompareWithSnapshot(pRT);
+
+        pContext->InvalidateState();
+
+        // Release the render targets. Their views are destroyed, and the framebuffers
+        // that use them must be evicted from the caches before the next round.
+        pRTs.clear();
+        pContext->FinishFrame();
+    }
+}
+
 } // namespace
@@ -26,11 +26,17 @@
  */
 
 #include <array>
+#include <algorithm>
+#include <thread>
+#include <vector>
+#include <atomic>
 
 #include "DefaultRawMemoryAllocator.hpp"
 #include "FixedBlockMemoryAllocator.hpp"
 #include "FixedLinearAllocator.hpp"
 #include "DynamicLinearAllocator.hpp"
+#include "ThreadSignal.hpp"
+#include "Timer.hpp"
 
 #include "gtest/gtest.h"
 
@@ -124,6 +130,162 @@ TEST(Common_FixedBlockMemoryAllocator, UnalignedSize)
     }
 }
 
+TEST(Common_FixedBlockMemoryAllocator, ThreadCache)
+{
+    constexpr Uint32 AllocSize             = 32;
+    constexpr Uint32 NumAllocationsPerPage = 16;
+    constexpr Uint32 ThreadCacheSize       = 8;
+
+    FixedBlockMemoryAllocator TestAllocator{DefaultRawMemoryAllocator::GetAllocator(), AllocSize, NumAllocationsPerPage, ThreadCacheSize};
+    EXPECT_EQ(TestAllocator.GetThreadCacheSize(), ThreadCacheSize);
+
+    // The first allocation refills the cache with ThreadCacheSize / 2 blocks
+    void* pRawMem0 = TestAllocator.Allocate(AllocSize, "Thread cache test", __FILE__, __LINE__);
+    ASSERT_NE(pRawMem0, nullptr);
+    {
+        const auto Stats = TestAllocator.GetThreadCacheStats();
+        EXPECT_EQ(Stats.NumRefills, Uint64{1});
+        EXPECT_EQ(Stats.NumHits, Uint64{0});
+        EXPECT_EQ(Stats.BytesHeld, size_t{AllocSize * (ThreadCacheSize / 2 - 1)});
+    }
+
+    // The remaining blocks are served from the cache
+    std::vector<void*> Allocations{pRawMem0};
+    for (Uint32 i = 1; i < ThreadCacheSize / 2; ++i)
+        Allocations.push_back(TestAllocator.Allocate(AllocSize, "Thread cache test", __FILE__, __LINE__));
+    {
+        const auto Stats = TestAllocator.GetThreadCacheStats();
+        EXPECT_EQ(Stats.NumRefills, Uint64{1});
+        EXPECT_EQ(Stats.NumHits, Uint64{ThreadCacheSize / 2 - 1});
+        EXPECT_EQ(Stats.BytesHeld, size_t{0});
+    }
+
+    // Freed block must be returned by the next allocation
+    TestAllocator.Free(Allocations.back());
+    EXPECT_EQ(TestAllocator.Allocate(AllocSize, "Thread cache test", __FILE__, __LINE__), Allocations.back());
+
+    for (Uint32 i = static_cast<Uint32>(Allocations.size()); i < NumAllocationsPerPage * 2; ++i)
+        Allocations.push_back(TestAllocator.Allocate(AllocSize, "Thread cache test", __FILE__, __LINE__));
+
+    std::sort(Allocations.begin(), Allocations.end());
+    EXPECT_EQ(std::unique(Allocations.begin(), Allocations.end()), Allocations.end()) << "The same block was allocated twice";
+
+    for (void* pRawMem : Allocations)
+        TestAllocator.Free(pRawMem);
+    {
+        // Overflowing cache must have been flushed to the pages
+        const auto Stats = TestAllocator.GetThreadCacheStats();
+        EXPECT_GT(Stats.NumFlushes, Uint64{0});
+        EXPECT_LE(Stats.BytesHeld, size_t{AllocSize * ThreadCacheSize});
+        EXPECT_GT(Stats.BytesHeld, size_t{0});
+    }
+
+    TestAllocator.FlushThreadCaches();
+    EXPECT_EQ(TestAllocator.GetTotalThreadCacheStats().BytesHeld, size_t{0});
+}
+
+TEST(Common_FixedBlockMemoryAllocator, ThreadCacheMultithreaded)
+{
+    constexpr Uint32 AllocSize             = 64;
+    constexpr Uint32 NumAllocationsPerPage = 32;
+    constexpr Uint32 NumThreads            = 8;
+    constexpr Uint32 NumIterations         = 500;
+    constexpr Uint32 NumLiveAllocations    = 40;
+
+    FixedBlockMemoryAllocator TestAllocator{DefaultRawMemoryAllocator::GetAllocator(), AllocSize, NumAllocationsPerPage, 16};
+
+    std::vector<std::thread> Threads(NumThreads);
+    for (Uint32 t = 0; t < NumThreads; ++t)
+    {
+        Threads[t] = std::thread(
+            [&](Uint32 ThreadId) {
+                std::array<Uint32*, NumLiveAllocations> Allocations{};
+                for (Uint32 i = 0; i < NumIterations; ++i)
+                {
+                    for (Uint32 a = 0; a < NumLiveAllocations; ++a)
+                    {
+                        Allocations[a] = static_cast<Uint32*>(TestAllocator.Allocate(AllocSize, "Thread cache test", __FILE__, __LINE__));
+                        for (Uint32 j = 0; j < AllocSize / sizeof(Uint32); ++j)
+                            Allocations[a][j] = ThreadId * NumLiveAllocations + a;
+                    }
+
+                    // Blocks must not be shared with other threads
+                    for (Uint32 a = 0; a < NumLiveAllocations; ++a)
+                    {
+                        for (Uint32 j = 0; j < AllocSize / sizeof(Uint32); ++j)
+                            EXPECT_EQ(Allocations[a][j], ThreadId * NumLiveAllocations + a);
+                    }
+
+                    // Free the blocks from alternating ends to move them between pages
+                    for (Uint32 a = 0; a < NumLiveAllocations; ++a)
+                        TestAllocator.Free(Allocations[(i & 0x01) ? a : NumLiveAllocations - 1 - a]);
+                }
+            },
+            t);
+    }
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    const auto Stats = TestAllocator.GetTotalThreadCacheStats();
+    EXPECT_GT(Stats.NumHits, Uint64{0});
+    EXPECT_GT(Stats.NumRefills, Uint64{0});
+    EXPECT_GT(Stats.NumFlushes, Uint64{0});
+}
+
+double RunFixedBlockAllocatorBenchmark(Uint32 NumThreads, Uint32 ThreadCacheSize)
+{
+    constexpr Uint32 AllocSize             = 128;
+    constexpr Uint32 NumAllocationsPerPage = 64;
+    constexpr Uint32 NumIterations         = 2000;
+    constexpr Uint32 NumLiveAllocations    = 16;
+
+    FixedBlockMemoryAllocator TestAllocator{DefaultRawMemoryAllocator::GetAllocator(), AllocSize, NumAllocationsPerPage, ThreadCacheSize};
+
+    std::vector<std::thread> Threads(NumThreads);
+    Threading::Signal        StartSignal;
+    std::atomic<Uint32>      NumThreadsReady{0};
+    for (Uint32 t = 0; t < NumThreads; ++t)
+    {
+        Threads[t] = std::thread(
+            [&]() {
+                std::array<void*, NumLiveAllocations> Allocations{};
+                NumThreadsReady.fetch_add(1);
+                StartSignal.Wait();
+                for (Uint32 i = 0; i < NumIterations; ++i)
+                {
+                    for (Uint32 a = 0; a < NumLiveAllocations; ++a)
+                        Allocations[a] = TestAllocator.Allocate(AllocSize, "Fixed block allocator benchmark", __FILE__, __LINE__);
+                    for (Uint32 a = 0; a < NumLiveAllocations; ++a)
+                        TestAllocator.Free(Allocations[a]);
+                }
+            });
+    }
+    while (NumThreadsReady.load() < NumThreads)
+        std::this_thread::yield();
+
+    Timer T;
+    StartSignal.Trigger(true);
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    return T.GetElapsedTime();
+}
+
+TEST(Common_FixedBlockMemoryAllocator, ContentionBenchmark)
+{
+    constexpr Uint32 NumOpsPerThread = 2000 * 16 * 2;
+
+    for (Uint32 NumThreads : {1, 2, 4, 8, 16, 32})
+    {
+        const double NoCacheTime = RunFixedBlockAllocatorBenchmark(NumThreads, 0);
+        const double CacheTime   = RunFixedBlockAllocatorBenchmark(NumThreads, 32);
+
+        const double NumOps = static_cast<double>(NumThreads) * NumOpsPerThread;
+        LOG_INFO_MESSAGE(NumThreads, " threads: no thread cache: ", static_cast<Uint32>(NumOps / NoCacheTime),
+                         " ops/s, thread cache: ", static_cast<Uint32>(NumOps / CacheTime), " ops/s");
+    }
+}
+
 TEST(Common_FixedLinearAllocator, EmptyAllocator)
 {
     FixedLinearAllocator Allocator{DefaultRawMemoryAllocator::GetAllocator()};
@@ -289,4 +451,112 @@ TEST(Common_DynamicLinearAllocator, ObjectConstruction)
     EXPECT_TRUE(reinterpret_cast<size_t>(Allocator.Allocate(200, 64)) % 64 == 0);
 }
 
+TEST(Common_DynamicLinearAllocator, RewindToMarker)
+{
+    for (bool UseVirtualMemory : {false, true})
+    {
+        DynamicLinearAllocator Allocator{DefaultRawMemoryAllocator::GetAllocator(), 256, UseVirtualMemory};
+
+        const auto Marker0 = Allocator.GetMarker();
+        Allocator.RewindTo(Marker0);
+
+        void* pData0 = Allocator.Allocate(100, 16);
+        ASSERT_NE(pData0, nullptr);
+
+        const auto Marker1 = Allocator.GetMarker();
+
+        void* pData1 = Allocator.Allocate(100, 16);
+        ASSERT_NE(pData1, nullptr);
+
+        // Allocate enough memory to spill into new blocks
+        std::vector<void*> Allocations;
+        for (size_t i = 0; i < 100; ++i)
+        {
+            Allocations.push_back(Allocator.Allocate(200, 8));
+            ASSERT_NE(Allocations.back(), nullptr);
+            memset(Allocations.back(), static_cast<int>(i), 200);
+        }
+        const size_t NumBlocks = Allocator.GetBlockCount();
+        EXPECT_GE(NumBlocks, UseVirtualMemory ? size_t{1} : size_t{50});
+
+        // Rewinding to the marker must release all allocations made after it,
+        // and the same memory must be reused
+        Allocator.RewindTo(Marker1);
+        EXPECT_EQ(Allocator.Allocate(100, 16), pData1);
+        for (size_t i = 0; i < 100; ++i)
+        {
+            EXPECT_EQ(Allocator.Allocate(200, 8), Allocations[i]);
+        }
+        EXPECT_EQ(Allocator.GetBlockCount(), NumBlocks);
+
+        Allocator.RewindTo(Marker0);
+        EXPECT_EQ(Allocator.Allocate(100, 16), pData0);
+
+        Allocator.Discard();
+        EXPECT_EQ(Allocator.Allocate(100, 16), pData0);
+    }
+}
+
+TEST(Common_DynamicLinearAllocator, VirtualMemory)
+{
+    DynamicLinearAllocator Allocator{DefaultRawMemoryAllocator::GetAllocator(), 4 << 10, /*UseVirtualMemory = */ true};
+
+    // Small allocations must all come from one reserved range
+    Uint8* pPrevData = nullptr;
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        Uint8* pData = Allocator.Allocate<Uint8>(1000);
+        ASSERT_NE(pData, nullptr);
+        memset(pData, 0xCD, 1000);
+        if (pPrevData != nullptr)
+        {
+            EXPECT_EQ(pData, pPrevData + 1000);
+        }
+        pPrevData = pData;
+    }
+    EXPECT_EQ(Allocator.GetBlockCount(), size_t{1});
+
+    // Allocation that is larger than the reserved range
+    constexpr size_t LargeSize = DynamicLinearAllocator::VirtualBlockReserveSize + 1000;
+
+    Uint8* pLargeData = Allocator.Allocate<Uint8>(LargeSize);
+    ASSERT_NE(pLargeData, nullptr);
+    pLargeData[0]             = 1;
+    pLargeData[LargeSize - 1] = 2;
+    EXPECT_EQ(Allocator.GetBlockCount(), size_t{2});
+}
+
+TEST(Common_DynamicLinearAllocator, ThreadScratchArena)
+{
+    auto TestArena = []() {
+        void* pOuterData = nullptr;
+        {
+            ThreadScratchArena OuterArena;
+
+            pOuterData = OuterArena->Allocate(64, 16);
+            ASSERT_NE(pOuterData, nullptr);
+
+            void* pInnerData = nullptr;
+            {
+                ThreadScratchArena InnerArena;
+
+                pInnerData = InnerArena->Allocate(64, 16);
+                EXPECT_NE(pInnerData, pOuterData);
+            }
+
+            // The memory released by the inner arena must be reused
+            EXPECT_EQ(OuterArena->Allocate(64, 16), pInnerData);
+        }
+
+        ThreadScratchArena Arena;
+        EXPECT_EQ(Arena->Allocate(64, 16), pOuterData);
+    };
+
+    TestArena();
+
+    // Every thread has its own allocator
+    std::thread Thread{TestArena};
+    Thread.join();
+}
+
 } // namespace
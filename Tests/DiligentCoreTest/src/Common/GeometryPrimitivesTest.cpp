@@ -0,0 +1,94 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "GeometryPrimitives.h"
+
+#include <cstring>
+
+#include "ThreadPool.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+void TestGeometryPrimitiveThreadPool(GeometryPrimitiveAttributes& Attribs)
+{
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    for (Uint32 NumSubdivisions : {1u, 3u, 64u, 511u})
+    {
+        Attribs.NumSubdivisions = NumSubdivisions;
+
+        Attribs.pThreadPool = nullptr;
+        RefCntAutoPtr<IDataBlob> pRefVertices;
+        RefCntAutoPtr<IDataBlob> pRefIndices;
+        GeometryPrimitiveInfo    RefInfo;
+        CreateGeometryPrimitive(Attribs, &pRefVertices, &pRefIndices, &RefInfo);
+        ASSERT_NE(pRefVertices, nullptr);
+        ASSERT_NE(pRefIndices, nullptr);
+
+        Attribs.pThreadPool = pThreadPool;
+        RefCntAutoPtr<IDataBlob> pVertices;
+        RefCntAutoPtr<IDataBlob> pIndices;
+        GeometryPrimitiveInfo    Info;
+        CreateGeometryPrimitive(Attribs, &pVertices, &pIndices, &Info);
+        ASSERT_NE(pVertices, nullptr);
+        ASSERT_NE(pIndices, nullptr);
+
+        EXPECT_EQ(Info.NumVertices, RefInfo.NumVertices);
+        EXPECT_EQ(Info.NumIndices, RefInfo.NumIndices);
+        EXPECT_EQ(Info.VertexSize, RefInfo.VertexSize);
+
+        ASSERT_EQ(pVertices->GetSize(), pRefVertices->GetSize());
+        EXPECT_EQ(memcmp(pVertices->GetConstDataPtr(), pRefVertices->GetConstDataPtr(), pVertices->GetSize()), 0) << NumSubdivisions;
+
+        ASSERT_EQ(pIndices->GetSize(), pRefIndices->GetSize());
+        EXPECT_EQ(memcmp(pIndices->GetConstDataPtr(), pRefIndices->GetConstDataPtr(), pIndices->GetSize()), 0) << NumSubdivisions;
+
+        // Check that all indices reference valid vertices
+        const Uint32* pIdx = static_cast<const Uint32*>(pIndices->GetConstDataPtr());
+        for (Uint32 i = 0; i < Info.NumIndices; ++i)
+            ASSERT_LT(pIdx[i], Info.NumVertices);
+    }
+}
+
+TEST(Common_GeometryPrimitives, CubeThreadPool)
+{
+    CubeGeometryPrimitiveAttributes Attribs{2.f, GEOMETRY_PRIMITIVE_VERTEX_FLAG_ALL};
+    TestGeometryPrimitiveThreadPool(Attribs);
+}
+
+TEST(Common_GeometryPrimitives, SphereThreadPool)
+{
+    SphereGeometryPrimitiveAttributes Attribs{3.f, GEOMETRY_PRIMITIVE_VERTEX_FLAG_POS_NORM};
+    TestGeometryPrimitiveThreadPool(Attribs);
+}
+
+} // namespace
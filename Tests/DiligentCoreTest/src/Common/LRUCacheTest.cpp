@@ -32,6 +32,8 @@
 #include <functional>
 
 #include "ThreadSignal.hpp"
+#include "FastRand.hpp"
+#include "Timer.hpp"
 
 using namespace Diligent;
 
@@ -43,9 +45,10 @@ struct CacheData
     Uint32 Value = ~0u;
 };
 
-TEST(Common_LRUCache, Get)
+template <typename CacheType>
+void TestGet()
 {
-    LRUCache<int, CacheData> Cache{16};
+    CacheType Cache{16};
 
     constexpr Uint32         NumThreads = 16;
     std::vector<std::thread> Threads(NumThreads);
@@ -80,10 +83,21 @@ TEST(Common_LRUCache, Get)
     }
 }
 
+TEST(Common_LRUCache, Get)
+{
+    TestGet<LRUCache<int, CacheData>>();
+}
 
-TEST(Common_LRUCache, ReleaseQueue)
+TEST(Common_LRUCache, ShardedGet)
 {
-    LRUCache<int, CacheData> Cache{16};
+    TestGet<ShardedLRUCache<int, CacheData>>();
+}
+
+
+template <typename CacheType>
+void TestReleaseQueue()
+{
+    CacheType Cache{16};
 
     constexpr Uint32                    NumThreads = 16;
     std::vector<std::thread>            Threads(NumThreads);
@@ -126,10 +140,21 @@ TEST(Common_LRUCache, ReleaseQueue)
     }
 }
 
+TEST(Common_LRUCache, ReleaseQueue)
+{
+    TestReleaseQueue<LRUCache<int, CacheData>>();
+}
 
-TEST(Common_LRUCache, Exceptions)
+TEST(Common_LRUCache, ShardedReleaseQueue)
+{
+    TestReleaseQueue<ShardedLRUCache<int, CacheData>>();
+}
+
+
+template <typename CacheType>
+void TestExceptions()
 {
-    LRUCache<int, CacheData> Cache{16};
+    CacheType Cache{16};
 
     constexpr Uint32                    NumThreads = 15; // Use odd number
     std::vector<std::thread>            Threads(NumThreads);
@@ -183,4 +208,125 @@ TEST(Common_LRUCache, Exceptions)
     }
 }
 
+TEST(Common_LRUCache, Exceptions)
+{
+    TestExceptions<LRUCache<int, CacheData>>();
+}
+
+TEST(Common_LRUCache, ShardedExceptions)
+{
+    TestExceptions<ShardedLRUCache<int, CacheData>>();
+}
+
+TEST(Common_LRUCache, ShardedEviction)
+{
+    // Use a single shard to make the eviction order deterministic
+    ShardedLRUCache<int, CacheData, std::hash<int>, 1> Cache{4};
+
+    std::vector<int> NumInitCalls(16);
+    auto             Get = [&](int Key) {
+        return Cache.Get(Key,
+                         [&](CacheData& Data, size_t& Size) //
+                         {
+                             ++NumInitCalls[Key];
+                             Data.Value = static_cast<Uint32>(Key);
+                             Size       = 1;
+                         });
+    };
+
+    for (int i = 0; i < 4; ++i)
+        EXPECT_EQ(Get(i).Value, static_cast<Uint32>(i));
+    EXPECT_EQ(Cache.GetCurrSize(), size_t{4});
+
+    // Promote 0, so that 1 becomes the least recently used entry
+    Get(0);
+    EXPECT_EQ(NumInitCalls[0], 1);
+
+    // Add 4, which evicts 1
+    Get(4);
+    EXPECT_EQ(Cache.GetCurrSize(), size_t{4});
+
+    Get(0);
+    Get(2);
+    Get(3);
+    Get(4);
+    EXPECT_EQ(NumInitCalls[0], 1);
+    EXPECT_EQ(NumInitCalls[2], 1);
+    EXPECT_EQ(NumInitCalls[3], 1);
+    EXPECT_EQ(NumInitCalls[4], 1);
+
+    // 1 has been evicted and must be initialized again
+    Get(1);
+    EXPECT_EQ(NumInitCalls[1], 2);
+    EXPECT_EQ(Cache.GetCurrSize(), size_t{4});
+
+    // Shrink the cache
+    Cache.SetMaxSize(2);
+    Get(1);
+    EXPECT_EQ(Cache.GetCurrSize(), size_t{2});
+
+    // Disable the cache
+    Cache.SetMaxSize(0);
+    Get(1);
+    EXPECT_EQ(Cache.GetCurrSize(), size_t{0});
+}
+
+template <typename CacheType>
+double RunLRUCacheBenchmark(Uint32 NumThreads, Uint32 NumKeys, size_t MaxSize, Uint32 NumRequestsPerThread)
+{
+    CacheType Cache{MaxSize};
+
+    std::vector<std::thread> Threads(NumThreads);
+    Threading::Signal        StartSignal;
+    std::atomic<Uint32>      NumThreadsReady{0};
+    for (Uint32 i = 0; i < NumThreads; ++i)
+    {
+        Threads[i] = std::thread(
+            [&](Uint32 ThreadId) {
+                FastRandInt Rnd{ThreadId, 0, static_cast<int>(NumKeys - 1)};
+                NumThreadsReady.fetch_add(1);
+                StartSignal.Wait();
+                for (Uint32 r = 0; r < NumRequestsPerThread; ++r)
+                {
+                    const int  Key  = Rnd();
+                    const auto Data = Cache.Get(Key,
+                                                [&](CacheData& Data, size_t& Size) //
+                                                {
+                                                    Data.Value = static_cast<Uint32>(Key);
+                                                    Size       = 1;
+                                                });
+                    VERIFY_EXPR(Data.Value == static_cast<Uint32>(Key));
+                }
+            },
+            i);
+    }
+    while (NumThreadsReady.load() < NumThreads)
+        std::this_thread::yield();
+
+    Timer T;
+    StartSignal.Trigger(true);
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    return T.GetElapsedTime();
+}
+
+TEST(Common_LRUCache, Benchmark)
+{
+    // The cache holds half of the keys, so that every other request evicts an entry
+    constexpr Uint32 NumKeys              = 16384;
+    constexpr size_t MaxSize              = NumKeys / 2;
+    constexpr Uint32 NumRequestsPerThread = 20000;
+
+    for (Uint32 NumThreads : {1, 4, 16})
+    {
+        const double LRUCacheTime        = RunLRUCacheBenchmark<LRUCache<int, CacheData>>(NumThreads, NumKeys, MaxSize, NumRequestsPerThread);
+        const double ShardedLRUCacheTime = RunLRUCacheBenchmark<ShardedLRUCache<int, CacheData>>(NumThreads, NumKeys, MaxSize, NumRequestsPerThread);
+
+        const double NumRequests = static_cast<double>(NumThreads) * NumRequestsPerThread;
+        LOG_INFO_MESSAGE(NumThreads, " threads: LRUCache: ", static_cast<Uint32>(NumRequests / LRUCacheTime),
+                         " requests/s, ShardedLRUCache: ", static_cast<Uint32>(NumRequests / ShardedLRUCacheTime), " requests/s");
+    }
+}
+
 } // namespace
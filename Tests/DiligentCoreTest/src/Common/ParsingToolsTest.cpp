@@ -1662,4 +1662,51 @@ void main()
          {{"version"}, {"extension"}, {"error"}});
 }
 
+TEST(Common_ParsingTools, StripCommentsAndEmptyLines)
+{
+    auto Test = [](const std::string& Source, const std::string& RefSource) {
+        const std::string Stripped = StripCommentsAndEmptyLines(Source.begin(), Source.end());
+        EXPECT_STREQ(Stripped.c_str(), RefSource.c_str());
+    };
+
+    Test("", "");
+    Test(" ", "");
+    Test("\n\n\r\n", "");
+    Test("// Comment", "");
+    Test("/* Comment */", "");
+    Test("a", "a\n");
+    Test("  a  ", "a\n");
+    Test("a // Comment\nb", "a\nb\n");
+    Test("a/* Comment */b", "a b\n");
+    Test("a /* Multi\nline\ncomment */ b", "a   b\n");
+    Test("a / b", "a / b\n");
+    Test("#define X 1 // Comment\n#define Y 2", "#define X 1\n#define Y 2\n");
+
+    Test(R"(
+// Comment
+#ifndef _HEADER_
+#   define _HEADER_
+
+float Func( float x ) /* Comment */
+{
+    return x; // Comment
+}
+
+#endif
+)",
+         "#ifndef _HEADER_\n"
+         "#   define _HEADER_\n"
+         "float Func( float x )\n"
+         "{\n"
+         "return x;\n"
+         "}\n"
+         "#endif\n");
+
+    {
+        const std::string Source{"a /* Comment"};
+        using ErrorType = std::pair<std::string::const_iterator, const char*>;
+        EXPECT_THROW(StripCommentsAndEmptyLines(Source.begin(), Source.end()), ErrorType);
+    }
+}
+
 } // namespace
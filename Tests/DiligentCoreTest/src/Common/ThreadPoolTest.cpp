@@ -30,8 +30,13 @@
 
 #include <array>
 #include <cmath>
+#include <thread>
+#include <vector>
+#include <chrono>
 
 #include "ThreadSignal.hpp"
+#include "Timer.hpp"
+#include "FastRand.hpp"
 
 
 using namespace Diligent;
@@ -39,11 +44,12 @@ using namespace Diligent;
 namespace
 {
 
-TEST(Common_ThreadPool, EnqueueTask)
+void TestEnqueueTask(bool EnableWorkStealing)
 {
     constexpr Uint32     NumThreads = 4;
     constexpr Uint32     NumTasks   = 32;
     ThreadPoolCreateInfo PoolCI{NumThreads};
+    PoolCI.EnableWorkStealing = EnableWorkStealing;
 
     std::array<std::atomic<bool>, NumThreads> ThreadStarted{};
 
@@ -100,13 +106,26 @@ TEST(Common_ThreadPool, EnqueueTask)
     EXPECT_EQ(NumThreadsFinished.load(), PoolCI.NumThreads);
 }
 
+TEST(Common_ThreadPool, EnqueueTask)
+{
+    TestEnqueueTask(false);
+}
 
-TEST(Common_ThreadPool, ProcessTask)
+TEST(Common_ThreadPool, EnqueueTask_WorkStealing)
+{
+    TestEnqueueTask(true);
+}
+
+
+void TestProcessTask(bool EnableWorkStealing)
 {
     constexpr Uint32 NumThreads = 4;
     constexpr Uint32 NumTasks   = 32;
 
-    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{0});
+    ThreadPoolCreateInfo PoolCI{0};
+    PoolCI.EnableWorkStealing = EnableWorkStealing;
+
+    auto pThreadPool = CreateThreadPool(PoolCI);
     ASSERT_NE(pThreadPool, nullptr);
 
     std::vector<std::thread> WorkerThreads(NumThreads);
@@ -164,6 +183,16 @@ TEST(Common_ThreadPool, ProcessTask)
     }
 }
 
+TEST(Common_ThreadPool, ProcessTask)
+{
+    TestProcessTask(false);
+}
+
+TEST(Common_ThreadPool, ProcessTask_WorkStealing)
+{
+    TestProcessTask(true);
+}
+
 class WaitTask : public AsyncTaskBase
 {
 public:
@@ -197,11 +226,14 @@ public:
     }
 };
 
-TEST(Common_ThreadPool, RemoveTask)
+void TestRemoveTask(bool EnableWorkStealing)
 {
     constexpr Uint32 NumThreads = 4;
 
-    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{NumThreads});
+    ThreadPoolCreateInfo PoolCI{NumThreads};
+    PoolCI.EnableWorkStealing = EnableWorkStealing;
+
+    auto pThreadPool = CreateThreadPool(PoolCI);
     ASSERT_NE(pThreadPool, nullptr);
 
     Threading::Signal Signal;
@@ -213,6 +245,14 @@ TEST(Common_ThreadPool, RemoveTask)
         pThreadPool->EnqueueTask(Task);
     }
 
+    if (EnableWorkStealing)
+    {
+        // In work-stealing mode, an idle thread may steal a dummy task from another
+        // thread's queue before the wait task, so wait until all wait tasks are running.
+        for (auto& Task : WaitTasks)
+            Task->WaitUntilRunning();
+    }
+
     std::array<RefCntAutoPtr<DummyTask>, 16> DummyTasks;
     for (auto& Task : DummyTasks)
     {
@@ -250,12 +290,80 @@ TEST(Common_ThreadPool, RemoveTask)
     EXPECT_EQ(pThreadPool->GetQueueSize(), 0u);
 }
 
+TEST(Common_ThreadPool, RemoveTask)
+{
+    TestRemoveTask(false);
+}
 
-TEST(Common_ThreadPool, Reprioritize)
+TEST(Common_ThreadPool, RemoveTask_WorkStealing)
+{
+    TestRemoveTask(true);
+}
+
+
+void TestRemoveWaitingTask(bool EnableWorkStealing)
+{
+    constexpr Uint32 NumThreads = 2;
+
+    ThreadPoolCreateInfo PoolCI{NumThreads};
+    PoolCI.EnableWorkStealing = EnableWorkStealing;
+
+    auto pThreadPool = CreateThreadPool(PoolCI);
+    ASSERT_NE(pThreadPool, nullptr);
+
+    Threading::Signal Signal;
+
+    std::array<RefCntAutoPtr<WaitTask>, NumThreads> WaitTasks;
+    for (auto& Task : WaitTasks)
+    {
+        Task = MakeNewRCObj<WaitTask>()(Signal);
+        pThreadPool->EnqueueTask(Task);
+    }
+    for (auto& Task : WaitTasks)
+        Task->WaitUntilRunning();
+
+    RefCntAutoPtr<DummyTask> pPrereq{MakeNewRCObj<DummyTask>()()};
+    pThreadPool->EnqueueTask(pPrereq);
+
+    // The dependent task waits for its prerequisite outside of the queue
+    RefCntAutoPtr<DummyTask> pDependent{MakeNewRCObj<DummyTask>()()};
+    IAsyncTask*              pPrereqs[] = {pPrereq};
+    pThreadPool->EnqueueTask(pDependent, pPrereqs, 1);
+    EXPECT_EQ(pThreadPool->GetQueueSize(), 2u);
+
+    pDependent->SetPriority(-1);
+    EXPECT_TRUE(pThreadPool->ReprioritizeTask(pDependent));
+    EXPECT_TRUE(pThreadPool->RemoveTask(pDependent));
+    EXPECT_FALSE(pThreadPool->RemoveTask(pDependent));
+    EXPECT_EQ(pThreadPool->GetQueueSize(), 1u);
+
+    Signal.Trigger(true, 1);
+
+    pThreadPool->WaitForAllTasks();
+    EXPECT_EQ(pThreadPool->GetQueueSize(), 0u);
+    EXPECT_EQ(pPrereq->GetStatus(), ASYNC_TASK_STATUS_COMPLETE);
+    EXPECT_EQ(pDependent->GetStatus(), ASYNC_TASK_STATUS_NOT_STARTED);
+}
+
+TEST(Common_ThreadPool, RemoveWaitingTask)
+{
+    TestRemoveWaitingTask(false);
+}
+
+TEST(Common_ThreadPool, RemoveWaitingTask_WorkStealing)
+{
+    TestRemoveWaitingTask(true);
+}
+
+
+void TestReprioritize(bool EnableWorkStealing)
 {
     constexpr Uint32 NumThreads = 4;
 
-    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{NumThreads});
+    ThreadPoolCreateInfo PoolCI{NumThreads};
+    PoolCI.EnableWorkStealing = EnableWorkStealing;
+
+    auto pThreadPool = CreateThreadPool(PoolCI);
     ASSERT_NE(pThreadPool, nullptr);
 
     Threading::Signal Signal;
@@ -267,6 +375,14 @@ TEST(Common_ThreadPool, Reprioritize)
         pThreadPool->EnqueueTask(Task);
     }
 
+    if (EnableWorkStealing)
+    {
+        // In work-stealing mode, an idle thread may steal a dummy task from another
+        // thread's queue before the wait task, so wait until all wait tasks are running.
+        for (auto& Task : WaitTasks)
+            Task->WaitUntilRunning();
+    }
+
     std::array<RefCntAutoPtr<DummyTask>, 16> DummyTasks;
     for (auto& Task : DummyTasks)
     {
@@ -298,8 +414,18 @@ TEST(Common_ThreadPool, Reprioritize)
     pThreadPool->WaitForAllTasks();
 }
 
+TEST(Common_ThreadPool, Reprioritize)
+{
+    TestReprioritize(false);
+}
 
-TEST(Common_ThreadPool, Priorities)
+TEST(Common_ThreadPool, Reprioritize_WorkStealing)
+{
+    TestReprioritize(true);
+}
+
+
+void TestPriorities(bool EnableWorkStealing)
 {
     constexpr Uint32 NumThreads  = 1;
     constexpr Uint32 NumTasks    = 8;
@@ -307,7 +433,10 @@ TEST(Common_ThreadPool, Priorities)
 
     for (Uint32 k = 0; k < RepeatCount; ++k)
     {
-        auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{NumThreads});
+        ThreadPoolCreateInfo PoolCI{NumThreads};
+        PoolCI.EnableWorkStealing = EnableWorkStealing;
+
+        auto pThreadPool = CreateThreadPool(PoolCI);
         ASSERT_NE(pThreadPool, nullptr);
 
         Threading::Signal       Signal;
@@ -361,12 +490,25 @@ TEST(Common_ThreadPool, Priorities)
     }
 }
 
+TEST(Common_ThreadPool, Priorities)
+{
+    TestPriorities(false);
+}
 
-TEST(Common_ThreadPool, Prerequisites)
+TEST(Common_ThreadPool, Priorities_WorkStealing)
+{
+    TestPriorities(true);
+}
+
+
+void TestPrerequisites(bool EnableWorkStealing)
 {
     for (Uint32 NumThreads : {1, 8})
     {
-        auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{NumThreads});
+        ThreadPoolCreateInfo PoolCI{NumThreads};
+        PoolCI.EnableWorkStealing = EnableWorkStealing;
+
+        auto pThreadPool = CreateThreadPool(PoolCI);
         ASSERT_NE(pThreadPool, nullptr);
 
         constexpr Uint32               NumTasks = 16;
@@ -414,10 +556,125 @@ TEST(Common_ThreadPool, Prerequisites)
     }
 }
 
+TEST(Common_ThreadPool, Prerequisites)
+{
+    TestPrerequisites(false);
+}
 
-TEST(Common_ThreadPool, ReRunTasks)
+TEST(Common_ThreadPool, Prerequisites_WorkStealing)
 {
-    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+    TestPrerequisites(true);
+}
+
+
+void TestPrerequisitesDAG(bool EnableWorkStealing)
+{
+    constexpr Uint32 NumThreads      = 4;
+    constexpr Uint32 NumTasks        = 10000;
+    constexpr Uint32 MaxPrereqs      = 3;
+    constexpr Uint32 MaxPrereqWindow = 64;
+
+    ThreadPoolCreateInfo PoolCI{0};
+    PoolCI.EnableWorkStealing = EnableWorkStealing;
+
+    auto pThreadPool = CreateThreadPool(PoolCI);
+    ASSERT_NE(pThreadPool, nullptr);
+
+    // Every call to ProcessTask() that returns true dequeues exactly one task.
+    // If the task can't run because its prerequisites are not finished, the dequeue is wasted.
+    std::atomic<Uint32>      NumDequeues{0};
+    std::vector<std::thread> WorkerThreads(NumThreads);
+    for (Uint32 i = 0; i < NumThreads; ++i)
+    {
+        WorkerThreads[i] = std::thread{
+            [&ThreadPool = *pThreadPool, &NumDequeues, i] //
+            {
+                while (ThreadPool.ProcessTask(i, true))
+                {
+                    NumDequeues.fetch_add(1);
+                }
+            }};
+    }
+
+    FastRand Rnd{0};
+
+    std::vector<std::vector<Uint32>> Prerequisites(NumTasks);
+    for (Uint32 task = 1; task < NumTasks; ++task)
+    {
+        const Uint32 NumPrereqs = 1 + Rnd() % MaxPrereqs;
+        for (Uint32 i = 0; i < NumPrereqs; ++i)
+            Prerequisites[task].push_back(task - 1 - Rnd() % std::min(task, MaxPrereqWindow));
+    }
+
+    std::vector<std::atomic<bool>> TaskComplete(NumTasks);
+    std::atomic<Uint32>            NumOrderViolations{0};
+
+    Timer T;
+
+    std::vector<RefCntAutoPtr<IAsyncTask>> Tasks(NumTasks);
+    std::vector<IAsyncTask*>               pPrereqTasks;
+    for (Uint32 task = 0; task < NumTasks; ++task)
+    {
+        pPrereqTasks.clear();
+        for (Uint32 prereq : Prerequisites[task])
+            pPrereqTasks.push_back(Tasks[prereq]);
+
+        Tasks[task] =
+            EnqueueAsyncWork(
+                pThreadPool,
+                pPrereqTasks.data(),
+                static_cast<Uint32>(pPrereqTasks.size()),
+                [task, &Prerequisites, &TaskComplete, &NumOrderViolations](Uint32 ThreadId) //
+                {
+                    for (Uint32 prereq : Prerequisites[task])
+                    {
+                        if (!TaskComplete[prereq].load())
+                            NumOrderViolations.fetch_add(1);
+                    }
+
+                    // Do some work to let other threads dequeue the dependents
+                    volatile float f = 0.5;
+                    for (size_t k = 0; k < 256; ++k)
+                        f = std::sin(f + 1.f);
+
+                    TaskComplete[task].store(true);
+                    return ASYNC_TASK_STATUS_COMPLETE;
+                });
+    }
+
+    pThreadPool->WaitForAllTasks();
+    const double Time = T.GetElapsedTime();
+
+    EXPECT_EQ(pThreadPool->GetQueueSize(), 0u);
+    EXPECT_EQ(NumOrderViolations.load(), 0u);
+    for (Uint32 task = 0; task < NumTasks; ++task)
+        EXPECT_TRUE(TaskComplete[task].load()) << "task=" << task;
+
+    pThreadPool->StopThreads();
+    for (auto& Thread : WorkerThreads)
+        Thread.join();
+
+    const Uint32 NumWastedDequeues = NumDequeues.load() - NumTasks;
+    LOG_INFO_MESSAGE("Processed ", NumTasks, "-node DAG in ", Time * 1000.0, " ms; wasted dequeues: ", NumWastedDequeues);
+    EXPECT_EQ(NumWastedDequeues, 0u);
+}
+
+TEST(Common_ThreadPool, PrerequisitesDAG)
+{
+    TestPrerequisitesDAG(false);
+}
+
+TEST(Common_ThreadPool, PrerequisitesDAG_WorkStealing)
+{
+    TestPrerequisitesDAG(true);
+}
+
+void TestReRunTasks(bool EnableWorkStealing)
+{
+    ThreadPoolCreateInfo PoolCI{4};
+    PoolCI.EnableWorkStealing = EnableWorkStealing;
+
+    auto pThreadPool = CreateThreadPool(PoolCI);
     ASSERT_NE(pThreadPool, nullptr);
 
     constexpr Uint32              NumTasks = 32;
@@ -442,4 +699,318 @@ TEST(Common_ThreadPool, ReRunTasks)
         EXPECT_EQ(ReRunCounters[i], 0) << i;
 }
 
+TEST(Common_ThreadPool, ReRunTasks)
+{
+    TestReRunTasks(false);
+}
+
+TEST(Common_ThreadPool, ReRunTasks_WorkStealing)
+{
+    TestReRunTasks(true);
+}
+
+TEST(Common_ThreadPool, WaitForCompletion)
+{
+    ThreadPoolCreateInfo PoolCI{1};
+
+    auto pThreadPool = CreateThreadPool(PoolCI);
+    ASSERT_NE(pThreadPool, nullptr);
+
+    Threading::Signal Signal;
+
+    RefCntAutoPtr<WaitTask> pWaitTask{MakeNewRCObj<WaitTask>()(Signal)};
+    pThreadPool->EnqueueTask(pWaitTask);
+    pWaitTask->WaitUntilRunning();
+    EXPECT_EQ(pWaitTask->GetStatus(), ASYNC_TASK_STATUS_RUNNING);
+
+    // The task is blocked by the signal, so the wait must time out
+    EXPECT_FALSE(pWaitTask->WaitForCompletionWithTimeout(1000));
+    EXPECT_FALSE(pWaitTask->WaitForCompletionWithTimeout(0));
+
+    // Threads blocked in WaitForCompletion must be woken up when the task finishes
+    std::atomic<bool>        WaitFinished{false};
+    std::vector<std::thread> Waiters;
+    for (size_t i = 0; i < 4; ++i)
+    {
+        Waiters.emplace_back([&]() {
+            pWaitTask->WaitForCompletion();
+            EXPECT_TRUE(pWaitTask->IsFinished());
+            WaitFinished.store(true);
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    EXPECT_FALSE(WaitFinished.load());
+
+    Signal.Trigger(true, 1);
+
+    EXPECT_TRUE(pWaitTask->WaitForCompletionWithTimeout(60'000'000));
+    for (auto& Waiter : Waiters)
+        Waiter.join();
+    EXPECT_TRUE(WaitFinished.load());
+
+    // Waiting for a finished task must return immediately
+    EXPECT_TRUE(pWaitTask->WaitForCompletionWithTimeout(0));
+    pWaitTask->WaitForCompletion();
+
+    pThreadPool->WaitForAllTasks();
+}
+
+TEST(Common_ThreadPool, WorkStealing_NestedTasks)
+{
+    constexpr Uint32 NumThreads     = 4;
+    constexpr Uint32 NumRootTasks   = 64;
+    constexpr Uint32 NumNestedTasks = 16;
+
+    ThreadPoolCreateInfo PoolCI{NumThreads};
+    PoolCI.EnableWorkStealing = true;
+
+    auto pThreadPool = CreateThreadPool(PoolCI);
+    ASSERT_NE(pThreadPool, nullptr);
+
+    std::atomic<Uint32> NumTasksComplete{0};
+    for (Uint32 i = 0; i < NumRootTasks; ++i)
+    {
+        EnqueueAsyncWork(pThreadPool,
+                         [&NumTasksComplete, pThreadPool = pThreadPool.RawPtr()](Uint32 ThreadId) //
+                         {
+                             // Tasks enqueued from the worker thread go to the thread's own queue
+                             for (Uint32 j = 0; j < NumNestedTasks; ++j)
+                             {
+                                 EnqueueAsyncWork(pThreadPool,
+                                                  [&NumTasksComplete](Uint32 ThreadId) //
+                                                  {
+                                                      NumTasksComplete.fetch_add(1);
+                                                      return ASYNC_TASK_STATUS_COMPLETE;
+                                                  });
+                             }
+                             NumTasksComplete.fetch_add(1);
+                             return ASYNC_TASK_STATUS_COMPLETE;
+                         });
+    }
+
+    pThreadPool->WaitForAllTasks();
+    EXPECT_EQ(NumTasksComplete.load(), NumRootTasks * (NumNestedTasks + 1));
+    EXPECT_EQ(pThreadPool->GetQueueSize(), 0u);
+    EXPECT_EQ(pThreadPool->GetRunningTaskCount(), 0u);
+}
+
+
+void TestParallelFor(bool EnableWorkStealing)
+{
+    constexpr Uint32 NumThreads = 4;
+
+    ThreadPoolCreateInfo PoolCI{NumThreads};
+    PoolCI.EnableWorkStealing = EnableWorkStealing;
+
+    auto pThreadPool = CreateThreadPool(PoolCI);
+    ASSERT_NE(pThreadPool, nullptr);
+
+    for (IThreadPool* pPool : {static_cast<IThreadPool*>(nullptr), pThreadPool.RawPtr()})
+    {
+        for (Uint32 Grain : {1u, 7u, 64u, 1000u, 5000u})
+        {
+            constexpr Uint32 RangeBegin = 10;
+            constexpr Uint32 RangeEnd   = 4010;
+
+            std::vector<std::atomic<Uint32>> ItemCounters(RangeEnd);
+            ParallelFor(pPool, RangeBegin, RangeEnd, Grain,
+                        [&](Uint32 ChunkBegin, Uint32 ChunkEnd) {
+                            EXPECT_EQ((ChunkBegin - RangeBegin) % Grain, 0u);
+                            EXPECT_TRUE(ChunkEnd - ChunkBegin == Grain || ChunkEnd == RangeEnd);
+                            for (Uint32 i = ChunkBegin; i < ChunkEnd; ++i)
+                                ItemCounters[i].fetch_add(1);
+                        });
+            for (Uint32 i = 0; i < RangeEnd; ++i)
+                EXPECT_EQ(ItemCounters[i].load(), i >= RangeBegin ? 1u : 0u) << "Item " << i << ", grain " << Grain;
+        }
+
+        // Empty range
+        ParallelFor(pPool, 5, 5, 1, [](Uint32 ChunkBegin, Uint32 ChunkEnd) {
+            ADD_FAILURE() << "Handler must not be called for an empty range";
+        });
+    }
+
+    // Nested parallel-for calls from the worker threads must not deadlock
+    constexpr Uint32    NumOuterItems = 16;
+    constexpr Uint32    NumInnerItems = 256;
+    std::atomic<Uint32> NumItemsProcessed{0};
+    ParallelFor(pThreadPool, 0, NumOuterItems, 1,
+                [&](Uint32 OuterBegin, Uint32 OuterEnd) {
+                    ParallelFor(pThreadPool, 0, NumInnerItems, 16,
+                                [&](Uint32 InnerBegin, Uint32 InnerEnd) {
+                                    NumItemsProcessed.fetch_add(InnerEnd - InnerBegin);
+                                });
+                });
+    EXPECT_EQ(NumItemsProcessed.load(), NumOuterItems * NumInnerItems);
+
+    pThreadPool->WaitForAllTasks();
+    EXPECT_EQ(pThreadPool->GetQueueSize(), 0u);
+}
+
+TEST(Common_ThreadPool, ParallelFor)
+{
+    TestParallelFor(false);
+}
+
+TEST(Common_ThreadPool, ParallelFor_WorkStealing)
+{
+    TestParallelFor(true);
+}
+
+void TestTaskGraph(bool EnableWorkStealing)
+{
+    constexpr Uint32 NumThreads = 4;
+
+    ThreadPoolCreateInfo PoolCI{NumThreads};
+    PoolCI.EnableWorkStealing = EnableWorkStealing;
+
+    auto pThreadPool = CreateThreadPool(PoolCI);
+    ASSERT_NE(pThreadPool, nullptr);
+
+    //         .-> B -.
+    //   A ---|        |--> D --> E
+    //         '-> C -'
+    std::atomic<Uint32>                Counter{0};
+    std::array<std::atomic<Uint32>, 5> Order{};
+
+    TaskGraph Graph;
+
+    auto MakeNode = [&](Uint32 Idx) {
+        return [&, Idx](Uint32 ThreadId) {
+            Order[Idx].store(Counter.fetch_add(1));
+        };
+    };
+    const auto A = Graph.AddNode(MakeNode(0));
+    const auto B = Graph.AddNode(MakeNode(1), {A});
+    const auto C = Graph.AddNode(MakeNode(2), {A});
+    const auto D = Graph.AddNode(MakeNode(3), {B, C});
+    const auto E = Graph.AddNode(MakeNode(4), {D});
+    EXPECT_EQ(Graph.GetNumNodes(), 5u);
+
+    std::array<IAsyncTask*, 5> PrevTasks{};
+    for (Uint32 Run = 0; Run < 4; ++Run)
+    {
+        Counter.store(0);
+        Graph.Execute(pThreadPool);
+        Graph.Wait();
+        EXPECT_TRUE(Graph.IsFinished());
+
+        EXPECT_EQ(Order[A].load(), 0u);
+        EXPECT_LT(Order[A].load(), Order[B].load());
+        EXPECT_LT(Order[A].load(), Order[C].load());
+        EXPECT_GT(Order[D].load(), Order[B].load());
+        EXPECT_GT(Order[D].load(), Order[C].load());
+        EXPECT_EQ(Order[E].load(), 4u);
+
+        Uint32 NumReusedTasks = 0;
+        for (Uint32 i = 0; i < Graph.GetNumNodes(); ++i)
+        {
+            IAsyncTask* pTask = Graph.GetNodeTask(i);
+            ASSERT_NE(pTask, nullptr);
+            EXPECT_EQ(pTask->GetStatus(), ASYNC_TASK_STATUS_COMPLETE);
+            if (pTask == PrevTasks[i])
+                ++NumReusedTasks;
+            PrevTasks[i] = pTask;
+        }
+        // The thread pool may still hold references to a few tasks for a short time
+        // after they are finished, but most of the tasks are expected to be reused.
+        if (Run > 0)
+        {
+            EXPECT_GT(NumReusedTasks, 0u);
+        }
+
+        pThreadPool->WaitForAllTasks();
+    }
+
+    // Large graph: every node depends on a few random previous nodes
+    TaskGraph LargeGraph;
+
+    constexpr Uint32                 NumNodes = 1000;
+    std::vector<std::atomic<Uint32>> NodeOrder(NumNodes);
+    std::vector<std::vector<Uint32>> NodePrereqs(NumNodes);
+
+    FastRandInt Rnd{0, 0, NumNodes};
+    for (Uint32 i = 0; i < NumNodes; ++i)
+    {
+        for (Uint32 j = 0; j < 3 && i > 0; ++j)
+            NodePrereqs[i].push_back(static_cast<Uint32>(Rnd()) % i);
+
+        LargeGraph.AddNode(
+            [&, i](Uint32 ThreadId) {
+                NodeOrder[i].store(Counter.fetch_add(1) + 1);
+            },
+            NodePrereqs[i].data(), static_cast<Uint32>(NodePrereqs[i].size()));
+    }
+
+    Counter.store(0);
+    LargeGraph.Execute(pThreadPool);
+    LargeGraph.Wait();
+    for (Uint32 i = 0; i < NumNodes; ++i)
+    {
+        ASSERT_NE(NodeOrder[i].load(), 0u);
+        for (Uint32 Prereq : NodePrereqs[i])
+            EXPECT_LT(NodeOrder[Prereq].load(), NodeOrder[i].load());
+    }
+}
+
+TEST(Common_ThreadPool, TaskGraph)
+{
+    TestTaskGraph(false);
+}
+
+TEST(Common_ThreadPool, TaskGraph_WorkStealing)
+{
+    TestTaskGraph(true);
+}
+
+
+TEST(Common_ThreadPool, Throughput)
+{
+    constexpr Uint32 NumRootTasks   = 256;
+    constexpr Uint32 NumNestedTasks = 16;
+
+    for (Uint32 NumThreads : {1, 4, 16, 64})
+    {
+        double Time[2] = {};
+        for (bool EnableWorkStealing : {false, true})
+        {
+            ThreadPoolCreateInfo PoolCI{NumThreads};
+            PoolCI.EnableWorkStealing = EnableWorkStealing;
+
+            auto pThreadPool = CreateThreadPool(PoolCI);
+            ASSERT_NE(pThreadPool, nullptr);
+
+            std::atomic<Uint32> NumTasksComplete{0};
+
+            Timer T;
+            for (Uint32 i = 0; i < NumRootTasks; ++i)
+            {
+                EnqueueAsyncWork(pThreadPool,
+                                 [&NumTasksComplete, pThreadPool = pThreadPool.RawPtr()](Uint32 ThreadId) //
+                                 {
+                                     for (Uint32 j = 0; j < NumNestedTasks; ++j)
+                                     {
+                                         EnqueueAsyncWork(pThreadPool,
+                                                          [&NumTasksComplete](Uint32 ThreadId) //
+                                                          {
+                                                              NumTasksComplete.fetch_add(1);
+                                                              return ASYNC_TASK_STATUS_COMPLETE;
+                                                          });
+                                     }
+                                     NumTasksComplete.fetch_add(1);
+                                     return ASYNC_TASK_STATUS_COMPLETE;
+                                 });
+            }
+            pThreadPool->WaitForAllTasks();
+            Time[EnableWorkStealing ? 1 : 0] = T.GetElapsedTime();
+
+            EXPECT_EQ(NumTasksComplete.load(), NumRootTasks * (NumNestedTasks + 1));
+        }
+
+        constexpr Uint32 NumTasks = NumRootTasks * (NumNestedTasks + 1);
+        LOG_INFO_MESSAGE(NumThreads, " threads: global queue: ", static_cast<Uint32>(NumTasks / Time[0]),
+                         " tasks/s, work stealing: ", static_cast<Uint32>(NumTasks / Time[1]), " tasks/s");
+    }
+}
+
 } // namespace
@@ -28,6 +28,9 @@
 #include "GraphicsUtilities.h"
 #include "FastRand.hpp"
 #include "ColorConversion.h"
+#include "GraphicsAccessories.hpp"
+#include "ThreadPool.hpp"
+#include "Timer.hpp"
 
 #include <vector>
 #include <array>
@@ -575,4 +578,215 @@ TEST(GraphicsTools_CalculateMipLevel, sRGB_BOX_AVE)
     EXPECT_TRUE(CoarseData == RefCoarseData);
 }
 
+TEST(GraphicsTools_CalculateMipLevel, ThreadPool)
+{
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    struct TestInfo
+    {
+        TEXTURE_FORMAT  Fmt;
+        MIP_FILTER_TYPE Filter;
+        float           AlphaCutoff;
+    };
+    // clang-format off
+    const TestInfo Tests[] =
+    {
+        {TEX_FORMAT_RGBA8_UNORM,      MIP_FILTER_TYPE_BOX_AVERAGE,   0},
+        {TEX_FORMAT_RGBA8_UNORM,      MIP_FILTER_TYPE_BOX_AVERAGE,   0.5f},
+        {TEX_FORMAT_RGBA8_UNORM_SRGB, MIP_FILTER_TYPE_DEFAULT,       0},
+        {TEX_FORMAT_RGBA8_UINT,       MIP_FILTER_TYPE_MOST_FREQUENT, 0},
+        {TEX_FORMAT_R16_SINT,         MIP_FILTER_TYPE_MOST_FREQUENT, 0},
+        {TEX_FORMAT_R32_FLOAT,        MIP_FILTER_TYPE_BOX_AVERAGE,   0},
+    };
+    // clang-format on
+
+    for (const auto& Test : Tests)
+    {
+        for (Uint32 FineHeight : {2u, 7u, 255u, 1021u})
+        {
+            const Uint32 FineWidth    = 301;
+            const Uint32 CoarseWidth  = FineWidth / 2;
+            const Uint32 CoarseHeight = std::max(FineHeight / 2, 1u);
+
+            const auto&  FmtAttribs   = GetTextureFormatAttribs(Test.Fmt);
+            const Uint32 TexelSize    = FmtAttribs.GetElementSize();
+            const size_t FineStride   = FineWidth * TexelSize + 12;
+            const size_t CoarseStride = CoarseWidth * TexelSize + 4;
+
+            std::vector<Uint8> FineData(FineStride * FineHeight);
+
+            // Use a small set of values so that the most frequent filter has to select between equal elements
+            FastRandInt rnd(0, 0, 3);
+            for (auto& c : FineData)
+                c = static_cast<Uint8>(rnd() * (Test.Fmt == TEX_FORMAT_R32_FLOAT ? 1 : 60));
+
+            ComputeMipLevelAttribs Attribs{Test.Fmt, FineWidth, FineHeight, FineData.data(), FineStride, nullptr, CoarseStride, Test.Filter, Test.AlphaCutoff};
+
+            std::vector<Uint8> RefCoarseData(CoarseStride * CoarseHeight);
+            Attribs.pCoarseMipData = RefCoarseData.data();
+            ComputeMipLevel(Attribs);
+
+            std::vector<Uint8> CoarseData(RefCoarseData.size());
+            Attribs.pCoarseMipData = CoarseData.data();
+            Attribs.pThreadPool    = pThreadPool;
+            ComputeMipLevel(Attribs);
+
+            EXPECT_TRUE(CoarseData == RefCoarseData) << FmtAttribs.Name << ' ' << FineWidth << 'x' << FineHeight;
+        }
+    }
+}
+
+
+TEST(GraphicsTools_CalculateMipLevel, FLOAT16)
+{
+    // 1.0, 2.0, 3.0, 4.0, -0.5, 0.25, 65504 (max), 6.1e-5 (min normal)
+    const Uint16 FineData[] = //
+        {
+            0x3C00, 0x4000, 0xB800, 0x3400,
+            0x4200, 0x4400, 0x7BFF, 0x0400 //
+        };
+
+    {
+        Uint16 CoarseData[2] = {};
+        ComputeMipLevel({TEX_FORMAT_R16_FLOAT, 4, 2, FineData, 8, CoarseData, 4, MIP_FILTER_TYPE_BOX_AVERAGE});
+        EXPECT_EQ(CoarseData[0], Uint16{0x4100}); // 2.5
+        EXPECT_EQ(CoarseData[1], Uint16{0x73FF}); // (-0.5 + 0.25 + 65504 + 6.1e-5) / 4 is rounded to 16376
+    }
+
+    {
+        // Denormal values must be preserved
+        const Uint16 FineRGBA[] = {0x3C00, 0x3C00, 0x0001, 0x0400, 0x0000, 0x0000, 0x0001, 0x0400};
+
+        Uint16 CoarseData[4] = {};
+        ComputeMipLevel({TEX_FORMAT_RGBA16_FLOAT, 2, 1, FineRGBA, 0, CoarseData, 0, MIP_FILTER_TYPE_BOX_AVERAGE});
+        EXPECT_EQ(CoarseData[0], Uint16{0x3800}); // 0.5
+        EXPECT_EQ(CoarseData[1], Uint16{0x3800}); // 0.5
+        EXPECT_EQ(CoarseData[2], Uint16{0x0001}); // Smallest denormal
+        EXPECT_EQ(CoarseData[3], Uint16{0x0400}); // Smallest normal
+    }
+}
+
+std::vector<Uint8> GenerateRandomMipData(TEXTURE_FORMAT Fmt, size_t Size, Uint32 Seed)
+{
+    std::vector<Uint8> Data(Size);
+
+    const auto& FmtAttribs = GetTextureFormatAttribs(Fmt);
+    if (FmtAttribs.ComponentType == COMPONENT_TYPE_FLOAT && FmtAttribs.ComponentSize == 4)
+    {
+        FastRandReal<float> rnd{Seed, -1000.f, 1000.f};
+        for (size_t i = 0; i + 4 <= Size; i += 4)
+        {
+            const float Value = rnd();
+            memcpy(&Data[i], &Value, sizeof(Value));
+        }
+    }
+    else if (FmtAttribs.ComponentType == COMPONENT_TYPE_FLOAT && FmtAttribs.ComponentSize == 2)
+    {
+        // Random bit patterns including denormals, but without infinities and NaNs
+        FastRandInt rnd{Seed, 0, 255};
+        for (size_t i = 0; i + 2 <= Size; i += 2)
+        {
+            Uint16 Value = static_cast<Uint16>(rnd() | (rnd() << 8));
+            if ((Value & 0x7C00) == 0x7C00)
+                Value &= 0xBFFF;
+            memcpy(&Data[i], &Value, sizeof(Value));
+        }
+    }
+    else
+    {
+        FastRandInt rnd{Seed, 0, 255};
+        for (auto& c : Data)
+            c = static_cast<Uint8>(rnd());
+    }
+
+    return Data;
+}
+
+struct SIMDTestInfo
+{
+    TEXTURE_FORMAT  Fmt;
+    MIP_FILTER_TYPE Filter;
+    float           AlphaCutoff;
+};
+// clang-format off
+const SIMDTestInfo SIMDTests[] =
+{
+    {TEX_FORMAT_RGBA8_UNORM,      MIP_FILTER_TYPE_BOX_AVERAGE, 0},
+    {TEX_FORMAT_RGBA8_UNORM,      MIP_FILTER_TYPE_BOX_AVERAGE, 0.3f},
+    {TEX_FORMAT_RGBA8_UNORM_SRGB, MIP_FILTER_TYPE_DEFAULT,     0},
+    {TEX_FORMAT_RGBA8_UNORM_SRGB, MIP_FILTER_TYPE_DEFAULT,     0.7f},
+    {TEX_FORMAT_RGBA32_FLOAT,     MIP_FILTER_TYPE_DEFAULT,     0},
+    {TEX_FORMAT_RGBA16_FLOAT,     MIP_FILTER_TYPE_DEFAULT,     0},
+    {TEX_FORMAT_R16_FLOAT,        MIP_FILTER_TYPE_DEFAULT,     0},
+};
+// clang-format on
+
+TEST(GraphicsTools_CalculateMipLevel, SIMD)
+{
+    for (const auto& Test : SIMDTests)
+    {
+        const auto&  FmtAttribs = GetTextureFormatAttribs(Test.Fmt);
+        const Uint32 TexelSize  = FmtAttribs.GetElementSize();
+        for (Uint32 FineWidth : {1u, 2u, 3u, 7u, 16u, 17u, 64u, 301u})
+        {
+            for (Uint32 FineHeight : {1u, 2u, 5u, 64u})
+            {
+                const Uint32 CoarseWidth  = std::max(FineWidth / 2, 1u);
+                const Uint32 CoarseHeight = std::max(FineHeight / 2, 1u);
+                const size_t FineStride   = FineWidth * TexelSize + 12;
+                const size_t CoarseStride = CoarseWidth * TexelSize + 4;
+
+                const std::vector<Uint8> FineData = GenerateRandomMipData(Test.Fmt, FineStride * FineHeight, FineWidth * 31 + FineHeight);
+
+                ComputeMipLevelAttribs Attribs{Test.Fmt, FineWidth, FineHeight, FineData.data(), FineStride, nullptr, CoarseStride, Test.Filter, Test.AlphaCutoff};
+
+                std::vector<Uint8> RefCoarseData(CoarseStride * CoarseHeight);
+                Attribs.pCoarseMipData = RefCoarseData.data();
+                Attribs.UseSIMD        = false;
+                ComputeMipLevel(Attribs);
+
+                std::vector<Uint8> CoarseData(RefCoarseData.size());
+                Attribs.pCoarseMipData = CoarseData.data();
+                Attribs.UseSIMD        = true;
+                ComputeMipLevel(Attribs);
+
+                EXPECT_TRUE(CoarseData == RefCoarseData) << FmtAttribs.Name << ' ' << FineWidth << 'x' << FineHeight << " alpha cutoff: " << Test.AlphaCutoff;
+            }
+        }
+    }
+}
+
+TEST(GraphicsTools_CalculateMipLevel, SIMD_Performance)
+{
+    constexpr Uint32 FineWidth  = 2048;
+    constexpr Uint32 FineHeight = 2048;
+    constexpr int    NumRuns    = 4;
+
+    for (const auto& Test : SIMDTests)
+    {
+        const auto&  FmtAttribs = GetTextureFormatAttribs(Test.Fmt);
+        const size_t FineStride = size_t{FineWidth} * FmtAttribs.GetElementSize();
+
+        const std::vector<Uint8> FineData = GenerateRandomMipData(Test.Fmt, FineStride * FineHeight, 0);
+        std::vector<Uint8>       CoarseData(FineStride * FineHeight / 4);
+
+        ComputeMipLevelAttribs Attribs{Test.Fmt, FineWidth, FineHeight, FineData.data(), FineStride, CoarseData.data(), FineStride / 2, Test.Filter, Test.AlphaCutoff};
+
+        double Time[2] = {};
+        for (int UseSIMD = 0; UseSIMD < 2; ++UseSIMD)
+        {
+            Attribs.UseSIMD = UseSIMD != 0;
+
+            Timer T;
+            for (int i = 0; i < NumRuns; ++i)
+                ComputeMipLevel(Attribs);
+            Time[UseSIMD] = T.GetElapsedTime() / NumRuns;
+        }
+
+        LOG_INFO_MESSAGE(FmtAttribs.Name, (Test.AlphaCutoff > 0 ? " with alpha cutoff" : ""), ": scalar: ", Time[0] * 1000.0, " ms, SIMD: ", Time[1] * 1000.0,
+                         " ms, speedup: ", Time[0] / Time[1]);
+    }
+}
+
 } // namespace
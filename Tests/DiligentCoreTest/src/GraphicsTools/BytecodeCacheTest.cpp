@@ -27,8 +27,17 @@
 #include "BytecodeCache.h"
 #include "DataBlobImpl.hpp"
 #include "DefaultShaderSourceStreamFactory.h"
+#include "MappedFileDataBlob.hpp"
+#include "FileWrapper.hpp"
+#include "Serializer.hpp"
+#include "XXH128Hasher.hpp"
 #include "gtest/gtest.h"
 
+#include <string>
+#include <vector>
+#include <thread>
+#include <algorithm>
+
 using namespace Diligent;
 
 namespace
@@ -186,4 +195,451 @@ TEST(BytecodeCacheTest, Include)
     }
 }
 
+ShaderCreateInfo GetTestShaderCI(const std::string& Source)
+{
+    ShaderCreateInfo ShaderCI{};
+    ShaderCI.Desc.ShaderType = SHADER_TYPE_COMPUTE;
+    ShaderCI.Desc.Name       = "TestName";
+    ShaderCI.Source          = Source.c_str();
+    ShaderCI.SourceLength    = Source.length();
+    return ShaderCI;
+}
+
+std::string GetTestBytecode(size_t Id)
+{
+    // Bytecodes of different sizes
+    return std::string(Id * 37 + 5, static_cast<char>('a' + Id % 26));
+}
+
+void CheckBytecode(IBytecodeCache* pCache, const std::string& Source, const std::string& RefBytecode, IDataBlob* pLoadedData = nullptr)
+{
+    RefCntAutoPtr<IDataBlob> pBytecode;
+    pCache->GetBytecode(GetTestShaderCI(Source), &pBytecode);
+    ASSERT_NE(pBytecode, nullptr) << Source;
+    ASSERT_EQ(pBytecode->GetSize(), RefBytecode.length()) << Source;
+    EXPECT_EQ(memcmp(pBytecode->GetConstDataPtr(), RefBytecode.data(), RefBytecode.length()), 0) << Source;
+
+    if (pLoadedData != nullptr)
+    {
+        // The bytecode must point directly to the loaded data
+        const Uint8* pData = static_cast<const Uint8*>(pBytecode->GetConstDataPtr());
+        const Uint8* pBase = static_cast<const Uint8*>(pLoadedData->GetConstDataPtr());
+        EXPECT_GE(pData, pBase);
+        EXPECT_LE(pData + RefBytecode.length(), pBase + pLoadedData->GetSize());
+        EXPECT_EQ((pData - pBase) % 16, 0);
+    }
+}
+
+TEST(BytecodeCacheTest, LazyLoad)
+{
+    constexpr size_t NumBytecodes = 32;
+
+    std::vector<std::string> Sources;
+    for (size_t i = 0; i < NumBytecodes; ++i)
+        Sources.emplace_back("Source" + std::to_string(i));
+
+    RefCntAutoPtr<IDataBlob> pCacheData;
+    {
+        RefCntAutoPtr<IBytecodeCache> pCache;
+        CreateBytecodeCache({RENDER_DEVICE_TYPE_VULKAN}, &pCache);
+        ASSERT_NE(pCache, nullptr);
+
+        for (size_t i = 0; i < NumBytecodes; ++i)
+        {
+            const std::string Bytecode = GetTestBytecode(i);
+            pCache->AddBytecode(GetTestShaderCI(Sources[i]), DataBlobImpl::Create(Bytecode.length(), Bytecode.data()));
+        }
+        pCache->Store(&pCacheData);
+        ASSERT_NE(pCacheData, nullptr);
+    }
+
+    RefCntAutoPtr<IDataBlob> pCacheData2;
+    {
+        RefCntAutoPtr<IBytecodeCache> pCache;
+        CreateBytecodeCache({RENDER_DEVICE_TYPE_VULKAN}, &pCache);
+        ASSERT_NE(pCache, nullptr);
+        ASSERT_TRUE(pCache->Load(pCacheData));
+
+        for (size_t i = 0; i < NumBytecodes; ++i)
+            CheckBytecode(pCache, Sources[i], GetTestBytecode(i), pCacheData);
+
+        // Remove and replace loaded bytecodes
+        pCache->RemoveBytecode(GetTestShaderCI(Sources[0]));
+        pCache->RemoveBytecode(GetTestShaderCI(Sources[1]));
+        {
+            const std::string Bytecode = GetTestBytecode(100);
+            pCache->AddBytecode(GetTestShaderCI(Sources[2]), DataBlobImpl::Create(Bytecode.length(), Bytecode.data()));
+        }
+        {
+            RefCntAutoPtr<IDataBlob> pBytecode;
+            pCache->GetBytecode(GetTestShaderCI(Sources[0]), &pBytecode);
+            EXPECT_EQ(pBytecode, nullptr);
+        }
+        CheckBytecode(pCache, Sources[2], GetTestBytecode(100));
+
+        pCache->Store(&pCacheData2);
+        ASSERT_NE(pCacheData2, nullptr);
+    }
+
+    {
+        RefCntAutoPtr<IBytecodeCache> pCache;
+        CreateBytecodeCache({RENDER_DEVICE_TYPE_VULKAN}, &pCache);
+        ASSERT_NE(pCache, nullptr);
+        ASSERT_TRUE(pCache->Load(pCacheData2));
+
+        for (size_t i = 0; i < 2; ++i)
+        {
+            RefCntAutoPtr<IDataBlob> pBytecode;
+            pCache->GetBytecode(GetTestShaderCI(Sources[i]), &pBytecode);
+            EXPECT_EQ(pBytecode, nullptr);
+        }
+        CheckBytecode(pCache, Sources[2], GetTestBytecode(100), pCacheData2);
+        for (size_t i = 3; i < NumBytecodes; ++i)
+            CheckBytecode(pCache, Sources[i], GetTestBytecode(i), pCacheData2);
+
+        // Loading another data blob must keep the existing entries
+        ASSERT_TRUE(pCache->Load(pCacheData));
+        CheckBytecode(pCache, Sources[0], GetTestBytecode(0), pCacheData);
+        CheckBytecode(pCache, Sources[2], GetTestBytecode(100), pCacheData2);
+        CheckBytecode(pCache, Sources[3], GetTestBytecode(3));
+    }
+}
+
+TEST(BytecodeCacheTest, MappedFile)
+{
+    const std::string Source{"MappedFileSource"};
+    const std::string Bytecode{"MappedFileBytecode"};
+
+    const char* FilePath = "BytecodeCacheTest_MappedFile.bin";
+    {
+        RefCntAutoPtr<IBytecodeCache> pCache;
+        CreateBytecodeCache({RENDER_DEVICE_TYPE_VULKAN}, &pCache);
+        ASSERT_NE(pCache, nullptr);
+        pCache->AddBytecode(GetTestShaderCI(Source), DataBlobImpl::Create(Bytecode.length(), Bytecode.data()));
+
+        RefCntAutoPtr<IDataBlob> pCacheData;
+        pCache->Store(&pCacheData);
+        ASSERT_NE(pCacheData, nullptr);
+        ASSERT_TRUE(FileWrapper::WriteFile(FilePath, pCacheData->GetConstDataPtr(), pCacheData->GetSize()));
+    }
+
+    {
+        RefCntAutoPtr<IBytecodeCache> pCache;
+        CreateBytecodeCache({RENDER_DEVICE_TYPE_VULKAN}, &pCache);
+        ASSERT_NE(pCache, nullptr);
+
+        RefCntAutoPtr<IDataBlob> pFileData = MappedFileDataBlob::Create(FilePath);
+        ASSERT_NE(pFileData, nullptr);
+        ASSERT_TRUE(pCache->Load(pFileData));
+        CheckBytecode(pCache, Source, Bytecode, pFileData);
+    }
+
+    FileSystem::DeleteFile(FilePath);
+}
+
+TEST(BytecodeCacheTest, LoadVersion1)
+{
+    const std::string Source{"Version1Source"};
+    const std::string Bytecode{"Version1Bytecode"};
+
+    XXH128State Hasher;
+    Hasher.Update(GetTestShaderCI(Source), RENDER_DEVICE_TYPE_VULKAN);
+    XXH128Hash Hash = Hasher.Digest();
+
+    // Version 1 layout: header, then element header followed by the bytecode for every element
+    auto WriteData = [&](auto& Stream) {
+        Uint32 Magic        = 0x7ADECACE;
+        Uint32 Version      = 1;
+        Uint64 ElementCount = 1;
+        Stream(Magic, Version, ElementCount);
+
+        size_t DataSize = Bytecode.length();
+        Stream(Hash.LowPart, Hash.HighPart, DataSize);
+        Stream.CopyBytes(Bytecode.data(), Bytecode.length());
+    };
+
+    Serializer<SerializerMode::Measure> MeasureStream;
+    WriteData(MeasureStream);
+
+    RefCntAutoPtr<DataBlobImpl>       pCacheData = DataBlobImpl::Create(MeasureStream.GetSize());
+    Serializer<SerializerMode::Write> WriteStream{SerializedData{pCacheData->GetDataPtr(), pCacheData->GetSize()}};
+    WriteData(WriteStream);
+    ASSERT_TRUE(WriteStream.IsEnded());
+
+    RefCntAutoPtr<IBytecodeCache> pCache;
+    CreateBytecodeCache({RENDER_DEVICE_TYPE_VULKAN}, &pCache);
+    ASSERT_NE(pCache, nullptr);
+    ASSERT_TRUE(pCache->Load(pCacheData));
+    CheckBytecode(pCache, Source, Bytecode);
+}
+
+
+TEST(BytecodeCacheTest, Journal)
+{
+    constexpr size_t NumBytecodes = 8;
+
+    std::vector<std::string> Sources;
+    for (size_t i = 0; i < NumBytecodes; ++i)
+        Sources.emplace_back("JournalSource" + std::to_string(i));
+
+    auto AddBytecode = [&](IBytecodeCache* pCache, size_t SrcId, size_t BytecodeId) {
+        const std::string Bytecode = GetTestBytecode(BytecodeId);
+        pCache->AddBytecode(GetTestShaderCI(Sources[SrcId]), DataBlobImpl::Create(Bytecode.length(), Bytecode.data()));
+    };
+
+    RefCntAutoPtr<IDataBlob> pCacheData;
+    RefCntAutoPtr<IDataBlob> pJournal;
+    {
+        RefCntAutoPtr<IBytecodeCache> pCache;
+        CreateBytecodeCache({RENDER_DEVICE_TYPE_VULKAN}, &pCache);
+        ASSERT_NE(pCache, nullptr);
+
+        for (size_t i = 0; i < 4; ++i)
+            AddBytecode(pCache, i, i);
+        pCache->Store(&pCacheData);
+        ASSERT_NE(pCacheData, nullptr);
+
+        // Nothing has changed since the last save
+        RefCntAutoPtr<IDataBlob> pEmptyChunk;
+        pCache->StoreIncremental(&pEmptyChunk);
+        ASSERT_NE(pEmptyChunk, nullptr);
+
+        AddBytecode(pCache, 4, 4);
+        AddBytecode(pCache, 5, 5);
+        AddBytecode(pCache, 0, 100);
+        RefCntAutoPtr<IDataBlob> pChunk1;
+        pCache->StoreIncremental(&pChunk1);
+        ASSERT_NE(pChunk1, nullptr);
+
+        AddBytecode(pCache, 6, 6);
+        AddBytecode(pCache, 4, 104);
+        pCache->RemoveBytecode(GetTestShaderCI(Sources[1]));
+        pCache->RemoveBytecode(GetTestShaderCI(Sources[5]));
+        RefCntAutoPtr<IDataBlob> pChunk2;
+        pCache->StoreIncremental(&pChunk2);
+        ASSERT_NE(pChunk2, nullptr);
+
+        // Chunks are appended to each other
+        const size_t JournalSize = pEmptyChunk->GetSize() + pChunk1->GetSize() + pChunk2->GetSize();
+        pJournal                 = DataBlobImpl::Create(JournalSize);
+        Uint8* pDst              = pJournal->GetDataPtr<Uint8>();
+        for (IDataBlob* pChunk : {pEmptyChunk.RawPtr(), pChunk1.RawPtr(), pChunk2.RawPtr()})
+        {
+            memcpy(pDst, pChunk->GetConstDataPtr(), pChunk->GetSize());
+            pDst += pChunk->GetSize();
+        }
+    }
+
+    RefCntAutoPtr<IBytecodeCache> pCache;
+    CreateBytecodeCache({RENDER_DEVICE_TYPE_VULKAN}, &pCache);
+    ASSERT_NE(pCache, nullptr);
+    ASSERT_TRUE(pCache->Load(pCacheData));
+    ASSERT_TRUE(pCache->Load(pJournal));
+
+    CheckBytecode(pCache, Sources[0], GetTestBytecode(100), pJournal);
+    CheckBytecode(pCache, Sources[2], GetTestBytecode(2), pCacheData);
+    CheckBytecode(pCache, Sources[3], GetTestBytecode(3), pCacheData);
+    CheckBytecode(pCache, Sources[4], GetTestBytecode(104), pJournal);
+    CheckBytecode(pCache, Sources[6], GetTestBytecode(6), pJournal);
+    for (size_t i : {1, 5, 7})
+    {
+        RefCntAutoPtr<IDataBlob> pBytecode;
+        pCache->GetBytecode(GetTestShaderCI(Sources[i]), &pBytecode);
+        EXPECT_EQ(pBytecode, nullptr) << Sources[i];
+    }
+
+    // Loaded journal entries are not written to the next journal chunk
+    RefCntAutoPtr<IDataBlob> pChunk;
+    pCache->StoreIncremental(&pChunk);
+    ASSERT_NE(pChunk, nullptr);
+    RefCntAutoPtr<IDataBlob> pEmptyChunk;
+    {
+        RefCntAutoPtr<IBytecodeCache> pEmptyCache;
+        CreateBytecodeCache({RENDER_DEVICE_TYPE_VULKAN}, &pEmptyCache);
+        pEmptyCache->StoreIncremental(&pEmptyChunk);
+    }
+    EXPECT_EQ(pChunk->GetSize(), pEmptyChunk->GetSize());
+
+    // Truncated journal must be rejected
+    RefCntAutoPtr<DataBlobImpl> pTruncated = DataBlobImpl::Create(pJournal->GetSize() - 8, pJournal->GetConstDataPtr());
+    EXPECT_FALSE(pCache->Load(pTruncated));
+}
+
+TEST(BytecodeCacheTest, RemoveReAddReload)
+{
+    const std::string Source{"RemoveReAddSource"};
+    const std::string OtherSource{"RemoveReAddOtherSource"};
+
+    auto AddBytecode = [](IBytecodeCache* pCache, const std::string& Src, size_t BytecodeId) {
+        const std::string Bytecode = GetTestBytecode(BytecodeId);
+        pCache->AddBytecode(GetTestShaderCI(Src), DataBlobImpl::Create(Bytecode.length(), Bytecode.data()));
+    };
+
+    auto StoreChunk = [](IBytecodeCache* pCache) {
+        RefCntAutoPtr<IDataBlob> pChunk;
+        pCache->StoreIncremental(&pChunk);
+        EXPECT_NE(pChunk, nullptr);
+        return pChunk;
+    };
+
+    auto ConcatChunks = [](std::initializer_list<IDataBlob*> Chunks) {
+        size_t JournalSize = 0;
+        for (IDataBlob* pChunk : Chunks)
+            JournalSize += pChunk->GetSize();
+        RefCntAutoPtr<DataBlobImpl> pJournal = DataBlobImpl::Create(JournalSize);
+        Uint8*                      pDst     = pJournal->GetDataPtr<Uint8>();
+        for (IDataBlob* pChunk : Chunks)
+        {
+            memcpy(pDst, pChunk->GetConstDataPtr(), pChunk->GetSize());
+            pDst += pChunk->GetSize();
+        }
+        return pJournal;
+    };
+
+    auto IsRemoved = [](IBytecodeCache* pCache, const std::string& Src) {
+        RefCntAutoPtr<IDataBlob> pBytecode;
+        pCache->GetBytecode(GetTestShaderCI(Src), &pBytecode);
+        return pBytecode == nullptr;
+    };
+
+    RefCntAutoPtr<IDataBlob> pCacheData;
+    RefCntAutoPtr<IDataBlob> pRemoveChunk;
+    RefCntAutoPtr<IDataBlob> pReAddChunk;
+    RefCntAutoPtr<IDataBlob> pRemoveChunk2;
+    {
+        RefCntAutoPtr<IBytecodeCache> pCache;
+        CreateBytecodeCache({RENDER_DEVICE_TYPE_VULKAN}, &pCache);
+        ASSERT_NE(pCache, nullptr);
+
+        AddBytecode(pCache, Source, 0);
+        AddBytecode(pCache, OtherSource, 1);
+        pCache->Store(&pCacheData);
+        ASSERT_NE(pCacheData, nullptr);
+
+        pCache->RemoveBytecode(GetTestShaderCI(Source));
+        pRemoveChunk = StoreChunk(pCache);
+
+        AddBytecode(pCache, Source, 100);
+        pReAddChunk = StoreChunk(pCache);
+        CheckBytecode(pCache, Source, GetTestBytecode(100));
+
+        pCache->RemoveBytecode(GetTestShaderCI(OtherSource));
+        pRemoveChunk2 = StoreChunk(pCache);
+    }
+
+    // The re-added bytecode must not be hidden by the removal recorded before it
+    {
+        RefCntAutoPtr<IBytecodeCache> pCache;
+        CreateBytecodeCache({RENDER_DEVICE_TYPE_VULKAN}, &pCache);
+        ASSERT_NE(pCache, nullptr);
+        ASSERT_TRUE(pCache->Load(pCacheData));
+
+        RefCntAutoPtr<IDataBlob> pJournal = ConcatChunks({pRemoveChunk, pReAddChunk, pRemoveChunk2});
+        ASSERT_TRUE(pCache->Load(pJournal));
+        CheckBytecode(pCache, Source, GetTestBytecode(100), pJournal);
+        EXPECT_TRUE(IsRemoved(pCache, OtherSource));
+    }
+
+    // Same, but the chunks are loaded one by one
+    {
+        RefCntAutoPtr<IBytecodeCache> pCache;
+        CreateBytecodeCache({RENDER_DEVICE_TYPE_VULKAN}, &pCache);
+        ASSERT_NE(pCache, nullptr);
+        ASSERT_TRUE(pCache->Load(pCacheData));
+
+        ASSERT_TRUE(pCache->Load(pRemoveChunk));
+        EXPECT_TRUE(IsRemoved(pCache, Source));
+        CheckBytecode(pCache, OtherSource, GetTestBytecode(1), pCacheData);
+
+        ASSERT_TRUE(pCache->Load(pReAddChunk));
+        CheckBytecode(pCache, Source, GetTestBytecode(100), pReAddChunk);
+
+        ASSERT_TRUE(pCache->Load(pRemoveChunk2));
+        CheckBytecode(pCache, Source, GetTestBytecode(100), pReAddChunk);
+        EXPECT_TRUE(IsRemoved(pCache, OtherSource));
+    }
+
+    // Reloading the data re-adds the removed bytecodes
+    {
+        RefCntAutoPtr<IBytecodeCache> pCache;
+        CreateBytecodeCache({RENDER_DEVICE_TYPE_VULKAN}, &pCache);
+        ASSERT_NE(pCache, nullptr);
+        ASSERT_TRUE(pCache->Load(pCacheData));
+
+        pCache->RemoveBytecode(GetTestShaderCI(Source));
+        EXPECT_TRUE(IsRemoved(pCache, Source));
+
+        ASSERT_TRUE(pCache->Load(pCacheData));
+        CheckBytecode(pCache, Source, GetTestBytecode(0), pCacheData);
+        CheckBytecode(pCache, OtherSource, GetTestBytecode(1), pCacheData);
+
+        // The removal is superseded by the loaded data and must not be written to the journal
+        RefCntAutoPtr<IDataBlob> pChunk = StoreChunk(pCache);
+        RefCntAutoPtr<IDataBlob> pEmptyChunk;
+        {
+            RefCntAutoPtr<IBytecodeCache> pEmptyCache;
+            CreateBytecodeCache({RENDER_DEVICE_TYPE_VULKAN}, &pEmptyCache);
+            pEmptyChunk = StoreChunk(pEmptyCache);
+        }
+        ASSERT_NE(pChunk, nullptr);
+        ASSERT_NE(pEmptyChunk, nullptr);
+        EXPECT_EQ(pChunk->GetSize(), pEmptyChunk->GetSize());
+    }
+}
+
+TEST(BytecodeCacheTest, Multithreaded)
+{
+    constexpr size_t NumBytecodes = 64;
+    const size_t     NumThreads   = std::max(std::thread::hardware_concurrency(), 4u);
+
+    std::vector<std::string> Sources;
+    for (size_t i = 0; i < NumBytecodes * (NumThreads + 1); ++i)
+        Sources.emplace_back("MTSource" + std::to_string(i));
+
+    RefCntAutoPtr<IBytecodeCache> pCache;
+    CreateBytecodeCache({RENDER_DEVICE_TYPE_VULKAN}, &pCache);
+    ASSERT_NE(pCache, nullptr);
+
+    // Bytecodes in the loaded data are shared by all threads
+    {
+        for (size_t i = 0; i < NumBytecodes; ++i)
+        {
+            const std::string Bytecode = GetTestBytecode(i);
+            pCache->AddBytecode(GetTestShaderCI(Sources[i]), DataBlobImpl::Create(Bytecode.length(), Bytecode.data()));
+        }
+        RefCntAutoPtr<IDataBlob> pCacheData;
+        pCache->Store(&pCacheData);
+        pCache->Clear();
+        ASSERT_TRUE(pCache->Load(pCacheData));
+    }
+
+    std::vector<std::thread> Threads(NumThreads);
+    for (size_t t = 0; t < NumThreads; ++t)
+    {
+        Threads[t] = std::thread{[&, t]() {
+            const size_t FirstId = NumBytecodes * (t + 1);
+            for (size_t i = 0; i < NumBytecodes; ++i)
+            {
+                const std::string Bytecode = GetTestBytecode(FirstId + i);
+                pCache->AddBytecode(GetTestShaderCI(Sources[FirstId + i]), DataBlobImpl::Create(Bytecode.length(), Bytecode.data()));
+
+                CheckBytecode(pCache, Sources[i], GetTestBytecode(i));
+                CheckBytecode(pCache, Sources[FirstId + i], Bytecode);
+
+                if (t == 0 && i % 8 == 0)
+                {
+                    RefCntAutoPtr<IDataBlob> pJournal;
+                    pCache->StoreIncremental(&pJournal);
+                    EXPECT_NE(pJournal, nullptr);
+                }
+            }
+        }};
+    }
+    for (std::thread& Thread : Threads)
+        Thread.join();
+
+    for (size_t i = 0; i < Sources.size(); ++i)
+        CheckBytecode(pCache, Sources[i], GetTestBytecode(i));
+}
+
 } // namespace
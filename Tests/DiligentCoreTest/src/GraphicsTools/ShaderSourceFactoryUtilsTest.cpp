@@ -0,0 +1,333 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "ShaderSourceFactoryUtils.hpp"
+#include "ShaderToolsCommon.hpp"
+#include "MemoryFileStream.hpp"
+#include "DataBlobImpl.hpp"
+#include "FileWrapper.hpp"
+#include "FileSystem.hpp"
+#include "TestingEnvironment.hpp"
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+const MemoryShaderSourceFileInfo TestSources[] = {
+    {"Main.hlsl", "#include \"Common/Structures.fxh\"\n#include \"Common/Functions.fxh\"\nvoid main(){}\n"},
+    {"Common/Structures.fxh", "struct VSInput { float4 Pos : ATTRIB0; };\n"},
+    {"Common/Functions.fxh", "#include \"Structures.fxh\"\nfloat4 GetPos(VSInput In) { return In.Pos; }\n"},
+    {"Structures.fxh", "#include \"Common/Structures.fxh\"\n"},
+    {"Empty.fxh", ""},
+};
+
+std::string ReadStream(IShaderSourceInputStreamFactory* pFactory, const char* Name)
+{
+    RefCntAutoPtr<IFileStream> pStream;
+    pFactory->CreateInputStream(Name, &pStream);
+    if (!pStream)
+        return "<null>";
+
+    std::string Data(pStream->GetSize(), '\0');
+    if (!Data.empty())
+        pStream->Read(&Data[0], Data.size());
+    return Data;
+}
+
+void CheckSources(IShaderSourceInputStreamFactory* pFactory)
+{
+    for (const MemoryShaderSourceFileInfo& Source : TestSources)
+    {
+        EXPECT_EQ(ReadStream(pFactory, Source.Name), Source.pData) << Source.Name;
+    }
+}
+
+RefCntAutoPtr<IDataBlob> CreateTestPack()
+{
+    return CreateShaderSourcePack(MemoryShaderSourceFactoryCreateInfo{TestSources, _countof(TestSources)});
+}
+
+TEST(ShaderSourceFactoryUtilsTest, PackedFactory)
+{
+    RefCntAutoPtr<IDataBlob> pPack = CreateTestPack();
+    ASSERT_NE(pPack, nullptr);
+
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pFactory = CreatePackedShaderSourceFactory(pPack);
+    ASSERT_NE(pFactory, nullptr);
+    CheckSources(pFactory);
+
+    {
+        RefCntAutoPtr<IFileStream> pStream;
+        pFactory->CreateInputStream2("Missing.fxh", CREATE_SHADER_SOURCE_INPUT_STREAM_FLAG_SILENT, &pStream);
+        EXPECT_EQ(pStream, nullptr);
+    }
+
+    {
+        TestingEnvironment::ErrorScope ExpectedErrors{"Failed to create input stream for source file Missing.fxh"};
+
+        RefCntAutoPtr<IFileStream> pStream;
+        pFactory->CreateInputStream("Missing.fxh", &pStream);
+        EXPECT_EQ(pStream, nullptr);
+    }
+
+    // Streams must reference the pack data directly
+    {
+        RefCntAutoPtr<IFileStream> pStream;
+        pFactory->CreateInputStream("Common/Structures.fxh", &pStream);
+        ASSERT_NE(pStream, nullptr);
+
+        RefCntAutoPtr<MemoryFileStream> pMemStream{pStream, MemoryFileStream::IID_InternalImpl};
+        ASSERT_NE(pMemStream, nullptr);
+
+        const char* pPackStart = pPack->GetConstDataPtr<char>();
+        const char* pFileData  = static_cast<const char*>(pMemStream->GetDataBlob()->GetConstDataPtr());
+        EXPECT_GE(pFileData, pPackStart);
+        EXPECT_LT(pFileData, pPackStart + pPack->GetSize());
+    }
+
+    // The factory must keep the pack alive
+    pPack.Release();
+    CheckSources(pFactory);
+}
+
+TEST(ShaderSourceFactoryUtilsTest, PackedFactoryFromFile)
+{
+    const char* FilePath = "ShaderSourceFactoryUtilsTest_Pack.bin";
+    {
+        RefCntAutoPtr<IDataBlob> pPack = CreateTestPack();
+        ASSERT_NE(pPack, nullptr);
+        ASSERT_TRUE(FileWrapper::WriteFile(FilePath, pPack->GetConstDataPtr(), pPack->GetSize()));
+    }
+
+    {
+        RefCntAutoPtr<IShaderSourceInputStreamFactory> pFactory = CreatePackedShaderSourceFactory(FilePath);
+        ASSERT_NE(pFactory, nullptr);
+        CheckSources(pFactory);
+    }
+
+    FileSystem::DeleteFile(FilePath);
+}
+
+TEST(ShaderSourceFactoryUtilsTest, InvalidPack)
+{
+    const std::string        Data{"This is not a shader source pack"};
+    RefCntAutoPtr<IDataBlob> pData = DataBlobImpl::Create(Data.length(), Data.c_str());
+
+    TestingEnvironment::ErrorScope ExpectedErrors{"The data is not a shader source pack", "Failed to create packed shader source factory"};
+
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pFactory = CreatePackedShaderSourceFactory(pData);
+    EXPECT_EQ(pFactory, nullptr);
+}
+
+TEST(ShaderSourceFactoryUtilsTest, CorruptPack)
+{
+    RefCntAutoPtr<IDataBlob> pPack = CreateTestPack();
+    ASSERT_NE(pPack, nullptr);
+
+    const Uint8* pPackData = pPack->GetConstDataPtr<Uint8>();
+    const size_t PackSize  = pPack->GetSize();
+
+    auto TestCorruptPack = [](const std::vector<Uint8>& Data) {
+        TestingEnvironment::ErrorScope ExpectedErrors{"Shader source pack is corrupted", "Failed to create packed shader source factory"};
+
+        RefCntAutoPtr<IDataBlob>                       pData    = DataBlobImpl::Create(Data.size(), Data.data());
+        RefCntAutoPtr<IShaderSourceInputStreamFactory> pFactory = CreatePackedShaderSourceFactory(pData);
+        EXPECT_EQ(pFactory, nullptr);
+    };
+
+    // Truncated data
+    for (size_t Size : {size_t{12}, size_t{16}, size_t{20}, PackSize / 2, PackSize - 1})
+    {
+        TestCorruptPack(std::vector<Uint8>(pPackData, pPackData + Size));
+    }
+
+    // Pack layout: | Magic | Version | NumFiles | Name 0 length | Name 0 | ...
+    constexpr size_t Name0LenOffset = sizeof(Uint32) * 3;
+    constexpr size_t Name0Offset    = Name0LenOffset + sizeof(Uint32);
+
+    Uint32 Name0Len = 0;
+    memcpy(&Name0Len, pPackData + Name0LenOffset, sizeof(Name0Len));
+    ASSERT_GT(Name0Len, Uint32{1});
+
+    // Name is not null-terminated
+    {
+        std::vector<Uint8> Data(pPackData, pPackData + PackSize);
+        Data[Name0Offset + Name0Len - 1] = 'x';
+        TestCorruptPack(Data);
+    }
+
+    // Name length is out of bounds
+    for (Uint32 Len : {Uint32{0}, Uint32{1}, static_cast<Uint32>(PackSize), ~Uint32{0}})
+    {
+        std::vector<Uint8> Data(pPackData, pPackData + PackSize);
+        memcpy(&Data[Name0LenOffset], &Len, sizeof(Len));
+        TestCorruptPack(Data);
+    }
+
+    // File size is out of bounds
+    {
+        std::vector<Uint8> Data(pPackData, pPackData + PackSize);
+        const Uint32       FileSize = static_cast<Uint32>(PackSize);
+        memcpy(&Data[Name0Offset + Name0Len], &FileSize, sizeof(FileSize));
+        TestCorruptPack(Data);
+    }
+}
+
+TEST(ShaderSourceFactoryUtilsTest, ProcessIncludes)
+{
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pFactory = CreatePackedShaderSourceFactory(CreateTestPack());
+    ASSERT_NE(pFactory, nullptr);
+
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.FilePath                   = "Main.hlsl";
+    ShaderCI.pShaderSourceStreamFactory = pFactory;
+
+    std::vector<std::string> Includes;
+    EXPECT_TRUE(ProcessShaderIncludes(ShaderCI, [&](const ShaderIncludePreprocessInfo& ProcessInfo) {
+        Includes.push_back(ProcessInfo.FilePath);
+    }));
+
+    const std::vector<std::string> ExpectedIncludes{"Common/Structures.fxh", "Structures.fxh", "Common/Functions.fxh", "Main.hlsl"};
+    EXPECT_EQ(Includes, ExpectedIncludes);
+}
+
+class CountingShaderSourceFactory final : public ObjectBase<IShaderSourceInputStreamFactory>
+{
+public:
+    using TBase = ObjectBase<IShaderSourceInputStreamFactory>;
+
+    CountingShaderSourceFactory(IReferenceCounters* pRefCounters, IShaderSourceInputStreamFactory* pFactory) :
+        TBase{pRefCounters},
+        m_pFactory{pFactory}
+    {}
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_IShaderSourceInputStreamFactory, TBase)
+
+    virtual void DILIGENT_CALL_TYPE CreateInputStream(const Char* Name, IFileStream** ppStream) override final
+    {
+        CreateInputStream2(Name, CREATE_SHADER_SOURCE_INPUT_STREAM_FLAG_NONE, ppStream);
+    }
+
+    virtual void DILIGENT_CALL_TYPE CreateInputStream2(const Char*                             Name,
+                                                       CREATE_SHADER_SOURCE_INPUT_STREAM_FLAGS Flags,
+                                                       IFileStream**                           ppStream) override final
+    {
+        m_NumRequests.fetch_add(1);
+        m_pFactory->CreateInputStream2(Name, Flags, ppStream);
+    }
+
+    int GetNumRequests() const
+    {
+        return m_NumRequests.load();
+    }
+
+private:
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> m_pFactory;
+
+    std::atomic<int> m_NumRequests{0};
+};
+
+TEST(ShaderSourceFactoryUtilsTest, CachingFactory)
+{
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pMemFactory = CreateMemoryShaderSourceFactory(MemoryShaderSourceFactoryCreateInfo{TestSources, _countof(TestSources), true});
+    ASSERT_NE(pMemFactory, nullptr);
+
+    RefCntAutoPtr<CountingShaderSourceFactory> pCountingFactory{MakeNewRCObj<CountingShaderSourceFactory>()(pMemFactory)};
+
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pFactory = CreateCachingShaderSourceFactory(pCountingFactory);
+    ASSERT_NE(pFactory, nullptr);
+
+    CheckSources(pFactory);
+    EXPECT_EQ(pCountingFactory->GetNumRequests(), static_cast<int>(_countof(TestSources)));
+
+    {
+        RefCntAutoPtr<IFileStream> pStream;
+        pFactory->CreateInputStream2("Missing.fxh", CREATE_SHADER_SOURCE_INPUT_STREAM_FLAG_SILENT, &pStream);
+        EXPECT_EQ(pStream, nullptr);
+        pFactory->CreateInputStream2("Missing.fxh", CREATE_SHADER_SOURCE_INPUT_STREAM_FLAG_SILENT, &pStream);
+        EXPECT_EQ(pStream, nullptr);
+    }
+    // Files that were not found must not be cached
+    EXPECT_EQ(pCountingFactory->GetNumRequests(), static_cast<int>(_countof(TestSources)) + 2);
+
+    const size_t NumThreads = std::max(std::thread::hardware_concurrency(), 4u);
+
+    std::vector<std::thread> Threads;
+    for (size_t i = 0; i < NumThreads; ++i)
+    {
+        Threads.emplace_back([&]() {
+            for (size_t j = 0; j < 100; ++j)
+                CheckSources(pFactory);
+        });
+    }
+    for (std::thread& Thread : Threads)
+        Thread.join();
+
+    EXPECT_EQ(pCountingFactory->GetNumRequests(), static_cast<int>(_countof(TestSources)) + 2);
+}
+
+TEST(ShaderSourceFactoryUtilsTest, CachingFactoryConcurrentLoad)
+{
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pPackedFactory = CreatePackedShaderSourceFactory(CreateTestPack());
+    ASSERT_NE(pPackedFactory, nullptr);
+
+    RefCntAutoPtr<IShaderSourceInputStreamFactory> pFactory = CreateCachingShaderSourceFactory(pPackedFactory);
+    ASSERT_NE(pFactory, nullptr);
+
+    // All threads request the files for the first time simultaneously
+    const size_t NumThreads = std::max(std::thread::hardware_concurrency(), 4u);
+
+    std::atomic<size_t>      NumThreadsReady{0};
+    std::vector<std::thread> Threads;
+    for (size_t i = 0; i < NumThreads; ++i)
+    {
+        Threads.emplace_back([&]() {
+            NumThreadsReady.fetch_add(1);
+            while (NumThreadsReady.load() < NumThreads)
+                std::this_thread::yield();
+
+            ShaderCreateInfo ShaderCI;
+            ShaderCI.FilePath                   = "Main.hlsl";
+            ShaderCI.pShaderSourceStreamFactory = pFactory;
+            EXPECT_TRUE(ProcessShaderIncludes(ShaderCI, nullptr));
+            CheckSources(pFactory);
+        });
+    }
+    for (std::thread& Thread : Threads)
+        Thread.join();
+}
+
+} // namespace
@@ -0,0 +1,172 @@
+/*
+ *  Copyright 2019-2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "HLSLTokenizer.hpp"
+
+#include <sstream>
+
+#include "Timer.hpp"
+
+#include "TestingEnvironment.hpp"
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Parsing;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+static constexpr char g_TestHLSL[] = R"(
+#include "Common.fxh"
+
+/* Multi-line
+   comment ** with asterisks */
+cbuffer Constants // single-line comment
+{
+    float4x4 g_WorldViewProj;
+    float4   g_Color;
+    int      g_Flags;
+};
+
+Texture2D<float4 /*format=rgba8*/> g_Texture;
+SamplerState g_Texture_sampler;
+
+struct VSOutput
+{
+    float4 Pos : SV_Position;
+    float2 UV  : TEX_COORD;
+};
+
+float4 ComputeColor(in VSOutput In, uniform bool bUseTexture)
+{
+    float4 Color = g_Color * -1.5e-3f + float4(0.5, .25, 1.0f, +2);
+    if (bUseTexture && (g_Flags & 0x01) != 0 || g_Flags >= 10)
+        Color *= g_Texture.Sample(g_Texture_sampler, In.UV);
+    for (int i = 0; i < 4; ++i)
+    {
+        Color.r += i <= 2 ? 0.1 : -0.1;
+        Color.g -= (g_Flags >> 2) == i ? 0.2 : 0.0;
+        Color.b = max(Color.b, 0.0)--;
+    }
+    const char* Str = "string constant";
+    return Color;
+}
+
+void main(in VSOutput In, out float4 Color : SV_Target)
+{
+    Color = ComputeColor(In, true);
+}
+)";
+
+TEST(HLSLTokenizer, TokenRecords)
+{
+    const HLSLTokenizer Tokenizer;
+
+    const std::string                  Source = g_TestHLSL;
+    const HLSLTokenizer::TokenListType Tokens = Tokenizer.Tokenize(Source);
+    ASSERT_FALSE(Tokens.empty());
+
+    HLSLTokenizer::TokenRecordListType Records;
+    ASSERT_TRUE(Tokenizer.Tokenize(Source.c_str(), Source.length(), Records));
+    ASSERT_EQ(Records.size(), Tokens.size());
+
+    auto Token = Tokens.begin();
+    for (const HLSLTokenRecord& Record : Records)
+    {
+        EXPECT_EQ(Record.GetType(), Token->GetType()) << Token->Literal;
+        EXPECT_EQ(std::string(Record.GetLiteral().first, Record.GetLiteral().second), Token->Literal);
+        EXPECT_EQ(std::string(Record.GetDelimiter().first, Record.GetDelimiter().second), Token->Delimiter);
+        ++Token;
+    }
+
+    EXPECT_EQ(BuildSource(Records), Source);
+
+    // Tokenizing into the same container must produce the same result
+    const HLSLTokenizer::TokenRecordListType Records2 = Records;
+    ASSERT_TRUE(Tokenizer.Tokenize(Source.c_str(), Source.length(), Records));
+    ASSERT_EQ(Records.size(), Records2.size());
+    for (size_t i = 0; i < Records.size(); ++i)
+    {
+        EXPECT_EQ(Records[i].Type, Records2[i].Type);
+        EXPECT_EQ(Records[i].Literal, Records2[i].Literal);
+        EXPECT_EQ(Records[i].LiteralLen, Records2[i].LiteralLen);
+        EXPECT_EQ(Records[i].DelimiterLen, Records2[i].DelimiterLen);
+    }
+}
+
+TEST(HLSLTokenizer, TokenRecordsError)
+{
+    const HLSLTokenizer Tokenizer;
+
+    TestingEnvironment::ErrorScope ExpectedErrors{"Unable to tokenize string", "Unable to find the end of the multiline comment"};
+
+    const std::string                  Source = "float4 Color; /* unterminated comment";
+    HLSLTokenizer::TokenRecordListType Records;
+    EXPECT_FALSE(Tokenizer.Tokenize(Source.c_str(), Source.length(), Records));
+    EXPECT_TRUE(Records.empty());
+}
+
+// Measures the tokenizer throughput on a large shader source.
+TEST(HLSLTokenizer, Throughput)
+{
+    const HLSLTokenizer Tokenizer;
+
+    std::string Source;
+    for (size_t i = 0; i < 256; ++i)
+        Source += g_TestHLSL;
+
+    constexpr Uint32 NumIterations = 8;
+
+    size_t NumTokens       = 0;
+    double TokenListTime   = 0;
+    double TokenRecordTime = 0;
+
+    HLSLTokenizer::TokenRecordListType Records;
+    for (Uint32 iter = 0; iter < NumIterations; ++iter)
+    {
+        {
+            Timer                              T;
+            const HLSLTokenizer::TokenListType Tokens = Tokenizer.Tokenize(Source);
+            TokenListTime += T.GetElapsedTime();
+            NumTokens = Tokens.size();
+        }
+
+        {
+            Timer T;
+            ASSERT_TRUE(Tokenizer.Tokenize(Source.c_str(), Source.length(), Records));
+            TokenRecordTime += T.GetElapsedTime();
+            ASSERT_EQ(Records.size(), NumTokens);
+        }
+    }
+
+    const double TotalTokens = static_cast<double>(NumTokens) * NumIterations;
+    LOG_INFO_MESSAGE("HLSL tokenizer throughput (", Source.length() / 1024, " KB, ", NumTokens, " tokens): token list: ",
+                     TotalTokens / TokenListTime * 1e-6, " M tokens/s, token records: ", TotalTokens / TokenRecordTime * 1e-6, " M tokens/s");
+}
+
+} // namespace
@@ -0,0 +1,167 @@
+/*
+ *  Copyright 2025 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "PatchedSPIRV.hpp"
+
+#include <memory>
+#include <utility>
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+const std::vector<uint32_t> OriginalSPIRV = {0x07230203, 0x00010000, 0x0008000B, 16, 0, 33, 1, 2};
+
+TEST(ShaderTools_PatchedSPIRV, NoChanges)
+{
+    PatchedSPIRV SPIRV{OriginalSPIRV};
+
+    // Patches that keep the original values must be ignored
+    SPIRV.Patch(5, 33);
+    SPIRV.Patch(6, 1);
+    EXPECT_EQ(SPIRV.GetNumPendingPatches(), size_t{0});
+    EXPECT_EQ(SPIRV[5], 33u);
+
+    // Repeating a pending patch must be ignored as well
+    SPIRV.Patch(7, 5);
+    EXPECT_EQ(SPIRV[7], 5u);
+    SPIRV.Patch(7, 5);
+    EXPECT_EQ(SPIRV.GetNumPendingPatches(), size_t{1});
+
+    PatchedSPIRV SPIRV2{OriginalSPIRV};
+    SPIRV2.Patch(0, OriginalSPIRV[0]);
+
+    const std::vector<uint32_t>& Code = SPIRV2.Apply();
+    EXPECT_EQ(&Code, &OriginalSPIRV);
+    EXPECT_FALSE(SPIRV2.IsCopied());
+}
+
+TEST(ShaderTools_PatchedSPIRV, FirstWrite)
+{
+    PatchedSPIRV SPIRV{OriginalSPIRV};
+
+    SPIRV.Patch(5, 40);
+    SPIRV.Patch(6, 3);
+    EXPECT_FALSE(SPIRV.IsCopied()) << "The byte code must not be copied before the patches are applied";
+    EXPECT_EQ(SPIRV[5], 40u);
+    EXPECT_EQ(SPIRV[6], 3u);
+
+    const std::vector<uint32_t>& Code = SPIRV.Apply();
+    EXPECT_TRUE(SPIRV.IsCopied());
+    EXPECT_NE(&Code, &OriginalSPIRV);
+    EXPECT_EQ(SPIRV.GetNumPendingPatches(), size_t{0});
+
+    std::vector<uint32_t> RefCode = OriginalSPIRV;
+    RefCode[5]                    = 40;
+    RefCode[6]                    = 3;
+    EXPECT_EQ(Code, RefCode);
+
+    // The original byte code must not be modified
+    EXPECT_EQ(OriginalSPIRV[5], 33u);
+    EXPECT_EQ(OriginalSPIRV[6], 1u);
+
+    // Subsequent patches are applied to the same copy
+    SPIRV.Patch(7, 9);
+    const std::vector<uint32_t>& Code2 = SPIRV.Apply();
+    EXPECT_EQ(&Code2, &Code);
+    RefCode[7] = 9;
+    EXPECT_EQ(Code2, RefCode);
+}
+
+TEST(ShaderTools_PatchedSPIRV, MovePatched)
+{
+    std::vector<uint32_t> RefCode = OriginalSPIRV;
+    RefCode[5]                    = 40;
+
+    // Move construction
+    {
+        std::unique_ptr<PatchedSPIRV> pSPIRV = std::make_unique<PatchedSPIRV>(OriginalSPIRV);
+        pSPIRV->Patch(5, 40);
+        pSPIRV->Apply();
+        ASSERT_TRUE(pSPIRV->IsCopied());
+
+        PatchedSPIRV Moved{std::move(*pSPIRV)};
+        EXPECT_TRUE(Moved.IsCopied());
+        EXPECT_FALSE(pSPIRV->IsCopied());
+
+        // Destroy the source object to make sure the moved object does not reference its data
+        pSPIRV.reset();
+
+        const std::vector<uint32_t>& Code = Moved.Apply();
+        EXPECT_EQ(Code, RefCode);
+        EXPECT_EQ(Moved[5], 40u);
+    }
+
+    // Move assignment
+    {
+        PatchedSPIRV SPIRV{OriginalSPIRV};
+        SPIRV.Patch(5, 40);
+        SPIRV.Apply();
+
+        const std::vector<uint32_t> OtherSPIRV = {1, 2, 3};
+
+        PatchedSPIRV Moved{OtherSPIRV};
+        Moved = std::move(SPIRV);
+        EXPECT_TRUE(Moved.IsCopied());
+
+        Moved.Patch(6, 7);
+        const std::vector<uint32_t>& Code = Moved.Apply();
+
+        std::vector<uint32_t> RefCode2 = RefCode;
+        RefCode2[6]                    = 7;
+        EXPECT_EQ(Code, RefCode2);
+    }
+
+    // Objects that have not been copied must keep referencing the original byte code
+    {
+        PatchedSPIRV SPIRV{OriginalSPIRV};
+        SPIRV.Patch(5, 40);
+
+        PatchedSPIRV Moved{std::move(SPIRV)};
+        EXPECT_FALSE(Moved.IsCopied());
+        EXPECT_EQ(Moved.GetNumPendingPatches(), size_t{1});
+        EXPECT_EQ(Moved.Apply(), RefCode);
+    }
+
+    // Vector reallocation moves the elements
+    {
+        std::vector<PatchedSPIRV> SPIRVs;
+        SPIRVs.emplace_back(OriginalSPIRV);
+        SPIRVs[0].Patch(5, 40);
+        SPIRVs[0].Apply();
+        for (size_t i = 0; i < 16; ++i)
+            SPIRVs.emplace_back(OriginalSPIRV);
+
+        EXPECT_TRUE(SPIRVs[0].IsCopied());
+        EXPECT_EQ(SPIRVs[0].Apply(), RefCode);
+        EXPECT_EQ(&SPIRVs[1].Apply(), &OriginalSPIRV);
+    }
+}
+
+} // namespace
@@ -0,0 +1,325 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "SPIRVShaderResources.hpp"
+#include "GLSLangUtils.hpp"
+#include "EngineMemory.h"
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "TestingEnvironment.hpp"
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+constexpr char TestVS[] = R"(
+cbuffer cbTransforms
+{
+    float4x4 g_WorldViewProj;
+    float4   g_Color;
+    uint     g_Flags;
+    float3   g_Offsets[2];
+};
+
+struct InstanceData
+{
+    float4 Offset;
+};
+StructuredBuffer<InstanceData> g_Instances;
+
+Texture2D      g_Tex2D;
+SamplerState   g_Tex2D_sampler;
+Texture2DArray g_TexArr[2];
+SamplerState   g_Sampler;
+
+struct VSInput
+{
+    float3 Pos    : ATTRIB0;
+    float2 UV     : ATTRIB1;
+    float4 Color  : ATTRIB2;
+    uint   InstID : SV_InstanceID;
+};
+
+void main(in VSInput VSIn, out float4 Pos : SV_Position, out float4 Color : COLOR)
+{
+    float3 WorldPos = VSIn.Pos + g_Instances[VSIn.InstID].Offset.xyz + g_Offsets[VSIn.InstID & 1u];
+    Pos   = mul(float4(WorldPos, 1.0), g_WorldViewProj);
+    Color = VSIn.Color * g_Color * g_Tex2D.SampleLevel(g_Tex2D_sampler, VSIn.UV, 0.0) +
+            g_TexArr[1].SampleLevel(g_Sampler, float3(VSIn.UV, 0.0), 0.0) * float(g_Flags);
+}
+)";
+
+const ShaderDesc TestVSDesc{"SPIRVShaderResourcesTest VS", SHADER_TYPE_VERTEX, true /*UseCombinedTextureSamplers*/};
+
+std::vector<uint32_t> CompileTestVS()
+{
+    ShaderCreateInfo ShaderCI;
+    ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+    ShaderCI.Source         = TestVS;
+    ShaderCI.Desc           = TestVSDesc;
+    ShaderCI.EntryPoint     = "main";
+
+    GLSLangUtils::InitializeGlslang();
+    std::vector<unsigned int> SPIRV = GLSLangUtils::HLSLtoSPIRV(ShaderCI, GLSLangUtils::SpirvVersion::Vk100, nullptr, nullptr);
+    GLSLangUtils::FinalizeGlslang();
+
+    return {SPIRV.begin(), SPIRV.end()};
+}
+
+std::unique_ptr<SPIRVShaderResources> CreateResources(const std::vector<uint32_t>& SPIRV,
+                                                      bool                         LoadShaderStageInputs,
+                                                      bool                         LoadUniformBufferReflection)
+{
+    std::string EntryPoint;
+    return std::make_unique<SPIRVShaderResources>(GetRawAllocator(), SPIRV, TestVSDesc, "_sampler",
+                                                  LoadShaderStageInputs, LoadUniformBufferReflection, EntryPoint);
+}
+
+void CompareResources(const SPIRVShaderResources& Ref, const SPIRVShaderResources& Res, bool CompareUBReflection)
+{
+    EXPECT_EQ(Res.GetNumUBs(), Ref.GetNumUBs());
+    EXPECT_EQ(Res.GetNumSBs(), Ref.GetNumSBs());
+    EXPECT_EQ(Res.GetNumImgs(), Ref.GetNumImgs());
+    EXPECT_EQ(Res.GetNumSmpldImgs(), Ref.GetNumSmpldImgs());
+    EXPECT_EQ(Res.GetNumACs(), Ref.GetNumACs());
+    EXPECT_EQ(Res.GetNumSepSmplrs(), Ref.GetNumSepSmplrs());
+    EXPECT_EQ(Res.GetNumSepImgs(), Ref.GetNumSepImgs());
+    EXPECT_EQ(Res.GetNumInptAtts(), Ref.GetNumInptAtts());
+    EXPECT_EQ(Res.GetNumAccelStructs(), Ref.GetNumAccelStructs());
+    ASSERT_EQ(Res.GetTotalResources(), Ref.GetTotalResources());
+
+    EXPECT_EQ(Res.GetShaderType(), Ref.GetShaderType());
+    EXPECT_EQ(Res.GetComputeGroupSize(), Ref.GetComputeGroupSize());
+    EXPECT_EQ(Res.IsHLSLSource(), Ref.IsHLSLSource());
+    EXPECT_STREQ(Res.GetCombinedSamplerSuffix(), Ref.GetCombinedSamplerSuffix());
+    EXPECT_STREQ(Res.GetShaderName(), Ref.GetShaderName());
+
+    for (Uint32 i = 0; i < Ref.GetTotalResources(); ++i)
+    {
+        const SPIRVShaderResourceAttribs& RefAttribs = Ref.GetResource(i);
+        const SPIRVShaderResourceAttribs& Attribs    = Res.GetResource(i);
+
+        EXPECT_STREQ(Attribs.Name, RefAttribs.Name);
+        EXPECT_EQ(Attribs.ArraySize, RefAttribs.ArraySize) << RefAttribs.Name;
+        EXPECT_EQ(Attribs.Type, RefAttribs.Type) << RefAttribs.Name;
+        EXPECT_EQ(Attribs.GetResourceDimension(), RefAttribs.GetResourceDimension()) << RefAttribs.Name;
+        EXPECT_EQ(Attribs.IsMultisample(), RefAttribs.IsMultisample()) << RefAttribs.Name;
+        EXPECT_EQ(Attribs.BindingDecorationOffset, RefAttribs.BindingDecorationOffset) << RefAttribs.Name;
+        EXPECT_EQ(Attribs.DescriptorSetDecorationOffset, RefAttribs.DescriptorSetDecorationOffset) << RefAttribs.Name;
+        EXPECT_EQ(Attribs.BufferStaticSize, RefAttribs.BufferStaticSize) << RefAttribs.Name;
+        EXPECT_EQ(Attribs.BufferStride, RefAttribs.BufferStride) << RefAttribs.Name;
+    }
+
+    ASSERT_EQ(Res.GetNumShaderStageInputs(), Ref.GetNumShaderStageInputs());
+    for (Uint32 i = 0; i < Ref.GetNumShaderStageInputs(); ++i)
+    {
+        const SPIRVShaderStageInputAttribs& RefInput = Ref.GetShaderStageInputAttribs(i);
+        const SPIRVShaderStageInputAttribs& Input    = Res.GetShaderStageInputAttribs(i);
+
+        EXPECT_STREQ(Input.Semantic, RefInput.Semantic);
+        EXPECT_EQ(Input.LocationDecorationOffset, RefInput.LocationDecorationOffset) << RefInput.Semantic;
+    }
+
+    if (CompareUBReflection)
+    {
+        for (Uint32 i = 0; i < Ref.GetNumUBs(); ++i)
+        {
+            const ShaderCodeBufferDesc* pRefDesc = Ref.GetUniformBufferDesc(i);
+            const ShaderCodeBufferDesc* pDesc    = Res.GetUniformBufferDesc(i);
+            ASSERT_NE(pRefDesc, nullptr);
+            ASSERT_NE(pDesc, nullptr);
+            EXPECT_EQ(*pDesc, *pRefDesc) << Ref.GetUB(i).Name;
+        }
+    }
+}
+
+TEST(SPIRVShaderResourcesTest, SerializeReflection)
+{
+    const std::vector<uint32_t> SPIRV = CompileTestVS();
+    ASSERT_FALSE(SPIRV.empty());
+
+    std::unique_ptr<SPIRVShaderResources> pRefResources = CreateResources(SPIRV, true, true);
+    ASSERT_NE(pRefResources, nullptr);
+    EXPECT_TRUE(pRefResources->IsHLSLSource());
+    EXPECT_EQ(pRefResources->GetNumUBs(), Uint32{1});
+    EXPECT_EQ(pRefResources->GetNumSBs(), Uint32{1});
+    EXPECT_EQ(pRefResources->GetNumSmpldImgs(), Uint32{1});
+    EXPECT_EQ(pRefResources->GetNumSepImgs(), Uint32{1});
+    EXPECT_EQ(pRefResources->GetNumSepSmplrs(), Uint32{1});
+    EXPECT_GE(pRefResources->GetNumShaderStageInputs(), Uint32{3});
+
+    const SerializedData Reflection = pRefResources->SerializeReflection("main", GetRawAllocator());
+    ASSERT_TRUE(Reflection);
+    EXPECT_TRUE(SPIRVShaderResources::IsReflectionCompatible(Reflection, true, true));
+    EXPECT_TRUE(SPIRVShaderResources::IsReflectionCompatible(Reflection, false, false));
+
+    // Serialization must be deterministic
+    EXPECT_EQ(pRefResources->SerializeReflection("main", GetRawAllocator()), Reflection);
+
+    {
+        std::string          EntryPoint;
+        SPIRVShaderResources Resources{GetRawAllocator(), Reflection, TestVSDesc, "_sampler", true, true, EntryPoint};
+        EXPECT_EQ(EntryPoint, "main");
+        CompareResources(*pRefResources, Resources, true);
+
+        // Reflection of the deserialized resources must match the original
+        EXPECT_EQ(Resources.SerializeReflection("main", GetRawAllocator()), Reflection);
+    }
+
+    // Stage inputs and UB reflection are not requested
+    {
+        std::string          EntryPoint;
+        SPIRVShaderResources Resources{GetRawAllocator(), Reflection, TestVSDesc, "_sampler", false, false, EntryPoint};
+        EXPECT_EQ(Resources.GetNumShaderStageInputs(), Uint32{0});
+
+        std::unique_ptr<SPIRVShaderResources> pRefResources2 = CreateResources(SPIRV, false, false);
+        CompareResources(*pRefResources2, Resources, false);
+    }
+}
+
+TEST(SPIRVShaderResourcesTest, IsReflectionCompatible)
+{
+    const std::vector<uint32_t> SPIRV = CompileTestVS();
+    ASSERT_FALSE(SPIRV.empty());
+
+    auto TestCompatibility = [&SPIRV](bool LoadShaderStageInputs, bool LoadUniformBufferReflection) {
+        std::unique_ptr<SPIRVShaderResources> pResources = CreateResources(SPIRV, LoadShaderStageInputs, LoadUniformBufferReflection);
+        ASSERT_NE(pResources, nullptr);
+
+        const SerializedData Reflection = pResources->SerializeReflection("main", GetRawAllocator());
+        ASSERT_TRUE(Reflection);
+
+        EXPECT_TRUE(SPIRVShaderResources::IsReflectionCompatible(Reflection, false, false));
+        EXPECT_EQ(SPIRVShaderResources::IsReflectionCompatible(Reflection, true, false), LoadShaderStageInputs);
+        EXPECT_EQ(SPIRVShaderResources::IsReflectionCompatible(Reflection, false, true), LoadUniformBufferReflection);
+        EXPECT_EQ(SPIRVShaderResources::IsReflectionCompatible(Reflection, true, true), LoadShaderStageInputs && LoadUniformBufferReflection);
+
+        if (!LoadShaderStageInputs || !LoadUniformBufferReflection)
+        {
+            TestingEnvironment::ErrorScope ExpectedErrors{"does not contain the requested information"};
+
+            std::string EntryPoint;
+            EXPECT_THROW(SPIRVShaderResources(GetRawAllocator(), Reflection, TestVSDesc, "_sampler", true, true, EntryPoint), std::runtime_error);
+        }
+    };
+    TestCompatibility(false, false);
+    TestCompatibility(true, false);
+    TestCompatibility(false, true);
+    TestCompatibility(true, true);
+
+    // Empty and truncated data
+    EXPECT_FALSE(SPIRVShaderResources::IsReflectionCompatible(SerializedData{}, false, false));
+
+    std::unique_ptr<SPIRVShaderResources> pResources = CreateResources(SPIRV, true, true);
+    const SerializedData                  Reflection = pResources->SerializeReflection("main", GetRawAllocator());
+    ASSERT_TRUE(Reflection);
+    std::vector<Uint8> Data{Reflection.Ptr<const Uint8>(), Reflection.Ptr<const Uint8>() + Reflection.Size()};
+    EXPECT_FALSE(SPIRVShaderResources::IsReflectionCompatible(SerializedData{Data.data(), sizeof(Uint32)}, false, false));
+
+    // Different version
+    Data[0] ^= 0xFF;
+    EXPECT_FALSE(SPIRVShaderResources::IsReflectionCompatible(SerializedData{Data.data(), Data.size()}, false, false));
+}
+
+TEST(SPIRVShaderResourcesTest, FindSPIRVReflection)
+{
+    const std::vector<uint32_t> SPIRV = CompileTestVS();
+    ASSERT_FALSE(SPIRV.empty());
+
+    std::unique_ptr<SPIRVShaderResources> pResources = CreateResources(SPIRV, true, true);
+    const SerializedData                  Reflection = pResources->SerializeReflection("main", GetRawAllocator());
+    ASSERT_TRUE(Reflection);
+
+    const std::vector<uint32_t> ByteCode = AppendSPIRVReflection(SPIRV, Reflection);
+    ASSERT_GT(ByteCode.size(), SPIRV.size());
+
+    auto Find = [](const std::vector<uint32_t>& Data, size_t Size) {
+        size_t      SPIRVWordCount = 0;
+        const void* pReflection    = nullptr;
+        size_t      ReflectionSize = 0;
+        return FindSPIRVReflection(Data.data(), Size, SPIRVWordCount, pReflection, ReflectionSize);
+    };
+
+    {
+        size_t      SPIRVWordCount = 0;
+        const void* pReflection    = nullptr;
+        size_t      ReflectionSize = 0;
+        ASSERT_TRUE(FindSPIRVReflection(ByteCode.data(), ByteCode.size() * sizeof(uint32_t), SPIRVWordCount, pReflection, ReflectionSize));
+        EXPECT_EQ(SPIRVWordCount, SPIRV.size());
+        EXPECT_EQ(memcmp(ByteCode.data(), SPIRV.data(), SPIRV.size() * sizeof(uint32_t)), 0);
+        ASSERT_EQ(ReflectionSize, Reflection.Size());
+        EXPECT_EQ(memcmp(pReflection, Reflection.Ptr(), ReflectionSize), 0);
+
+        // The reflection found in the byte code must be usable
+        std::string          EntryPoint;
+        SPIRVShaderResources Resources{GetRawAllocator(), SerializedData{const_cast<void*>(pReflection), ReflectionSize}, TestVSDesc, "_sampler", true, true, EntryPoint};
+        CompareResources(*pResources, Resources, true);
+    }
+
+    // Plain SPIR-V
+    EXPECT_FALSE(Find(SPIRV, SPIRV.size() * sizeof(uint32_t)));
+    EXPECT_FALSE(Find(SPIRV, 0));
+
+    const size_t ByteCodeSize = ByteCode.size() * sizeof(uint32_t);
+
+    // Truncated byte code
+    EXPECT_FALSE(Find(ByteCode, ByteCodeSize - 1));
+    EXPECT_FALSE(Find(ByteCode, ByteCodeSize - sizeof(uint32_t)));
+    EXPECT_FALSE(Find(ByteCode, ByteCodeSize / 2));
+    EXPECT_FALSE(Find(ByteCode, sizeof(uint32_t) * 3));
+
+    // Corrupt trailer and SPIR-V header
+    auto TestCorrupt = [&](size_t WordIdx, uint32_t Value) {
+        std::vector<uint32_t> Corrupt = ByteCode;
+        Corrupt[WordIdx]              = Value;
+        EXPECT_FALSE(Find(Corrupt, ByteCodeSize)) << "Word " << WordIdx << ": " << Value;
+    };
+    const size_t NumWords = ByteCode.size();
+    // Magic
+    TestCorrupt(NumWords - 1, ByteCode[NumWords - 1] ^ 1u);
+    // Reflection size
+    TestCorrupt(NumWords - 2, 0);
+    TestCorrupt(NumWords - 2, static_cast<uint32_t>(Reflection.Size() + 4));
+    TestCorrupt(NumWords - 2, static_cast<uint32_t>(ByteCodeSize));
+    TestCorrupt(NumWords - 2, ~0u);
+    // SPIR-V word count
+    TestCorrupt(NumWords - 3, 0);
+    TestCorrupt(NumWords - 3, static_cast<uint32_t>(SPIRV.size() - 1));
+    TestCorrupt(NumWords - 3, static_cast<uint32_t>(SPIRV.size() + 1));
+    TestCorrupt(NumWords - 3, static_cast<uint32_t>(NumWords));
+    TestCorrupt(NumWords - 3, ~0u);
+    // SPIR-V magic number
+    TestCorrupt(0, 0);
+}
+
+} // namespace
@@ -0,0 +1,268 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "SPIRVTools.hpp"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "DataBlobImpl.hpp"
+#include "RefCntAutoPtr.hpp"
+
+#include "spirv-tools/libspirv.hpp"
+
+#include "TestingEnvironment.hpp"
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+std::vector<uint32_t> AssembleComputeShader(Uint32 LocalSizeX)
+{
+    const std::string SPIRVAsm = R"(
+               OpCapability Shader
+               OpMemoryModel Logical GLSL450
+               OpEntryPoint GLCompute %main "main"
+               OpExecutionMode %main LocalSize )" +
+        std::to_string(LocalSizeX) + R"( 1 1
+       %void = OpTypeVoid
+     %fnType = OpTypeFunction %void
+       %main = OpFunction %void None %fnType
+      %entry = OpLabel
+               OpReturn
+               OpFunctionEnd
+)";
+
+    spvtools::SpirvTools  Tools{SPV_ENV_VULKAN_1_0};
+    std::vector<uint32_t> SPIRV;
+    EXPECT_TRUE(Tools.Assemble(SPIRVAsm, &SPIRV));
+    return SPIRV;
+}
+
+class SPIRVOptimizationCacheTest : public ::testing::Test
+{
+protected:
+    static constexpr size_t LargeCacheSize = size_t{1} << 20;
+
+    void SetUp() override
+    {
+        SetSPIRVOptimizationCacheSize(LargeCacheSize);
+        ClearSPIRVOptimizationCache();
+    }
+
+    void TearDown() override
+    {
+        SetSPIRVOptimizationCacheSize(0);
+    }
+
+    static void ExpectStats(Uint64 NumHits, Uint64 NumMisses, size_t NumEntries)
+    {
+        const SPIRVOptimizationCacheStats Stats = GetSPIRVOptimizationCacheStats();
+        EXPECT_EQ(Stats.NumHits, NumHits);
+        EXPECT_EQ(Stats.NumMisses, NumMisses);
+        EXPECT_EQ(Stats.NumEntries, NumEntries);
+    }
+};
+
+TEST_F(SPIRVOptimizationCacheTest, KeySensitivity)
+{
+    const std::vector<uint32_t> SPIRV0 = AssembleComputeShader(1);
+    const std::vector<uint32_t> SPIRV1 = AssembleComputeShader(2);
+    ASSERT_FALSE(SPIRV0.empty());
+    ASSERT_FALSE(SPIRV1.empty());
+
+    const std::vector<uint32_t> Optimized0 = OptimizeSPIRV(SPIRV0, SPV_ENV_VULKAN_1_0, SPIRV_OPTIMIZATION_FLAG_PERFORMANCE);
+    ASSERT_FALSE(Optimized0.empty());
+    ExpectStats(0, 1, 1);
+
+    // Same input - must hit and return the same result
+    EXPECT_EQ(OptimizeSPIRV(SPIRV0, SPV_ENV_VULKAN_1_0, SPIRV_OPTIMIZATION_FLAG_PERFORMANCE), Optimized0);
+    ExpectStats(1, 1, 1);
+
+    // Different SPIR-V
+    EXPECT_FALSE(OptimizeSPIRV(SPIRV1, SPV_ENV_VULKAN_1_0, SPIRV_OPTIMIZATION_FLAG_PERFORMANCE).empty());
+    ExpectStats(1, 2, 2);
+
+    // Different target environment
+    EXPECT_FALSE(OptimizeSPIRV(SPIRV0, SPV_ENV_VULKAN_1_1, SPIRV_OPTIMIZATION_FLAG_PERFORMANCE).empty());
+    ExpectStats(1, 3, 3);
+
+    // Different optimization flags
+    EXPECT_FALSE(OptimizeSPIRV(SPIRV0, SPV_ENV_VULKAN_1_0, SPIRV_OPTIMIZATION_FLAG_PERFORMANCE | SPIRV_OPTIMIZATION_FLAG_STRIP_REFLECTION).empty());
+    ExpectStats(1, 4, 4);
+
+    // All previous entries must still be found
+    OptimizeSPIRV(SPIRV1, SPV_ENV_VULKAN_1_0, SPIRV_OPTIMIZATION_FLAG_PERFORMANCE);
+    OptimizeSPIRV(SPIRV0, SPV_ENV_VULKAN_1_1, SPIRV_OPTIMIZATION_FLAG_PERFORMANCE);
+    OptimizeSPIRV(SPIRV0, SPV_ENV_VULKAN_1_0, SPIRV_OPTIMIZATION_FLAG_PERFORMANCE | SPIRV_OPTIMIZATION_FLAG_STRIP_REFLECTION);
+    ExpectStats(4, 4, 4);
+
+    ClearSPIRVOptimizationCache();
+    ExpectStats(0, 0, 0);
+    EXPECT_EQ(GetSPIRVOptimizationCacheStats().DataSize, size_t{0});
+}
+
+TEST_F(SPIRVOptimizationCacheTest, LRUEviction)
+{
+    const std::vector<uint32_t> SPIRV0 = AssembleComputeShader(1);
+    const std::vector<uint32_t> SPIRV1 = AssembleComputeShader(2);
+    const std::vector<uint32_t> SPIRV2 = AssembleComputeShader(3);
+
+    OptimizeSPIRV(SPIRV0, SPV_ENV_VULKAN_1_0, SPIRV_OPTIMIZATION_FLAG_PERFORMANCE);
+    const size_t EntrySize = GetSPIRVOptimizationCacheStats().DataSize;
+    ASSERT_GT(EntrySize, size_t{0});
+
+    // The shaders only differ by the local size, so all entries have the same size.
+    // Only two entries fit into the cache.
+    SetSPIRVOptimizationCacheSize(EntrySize * 5 / 2);
+    ExpectStats(0, 1, 1);
+
+    OptimizeSPIRV(SPIRV1, SPV_ENV_VULKAN_1_0, SPIRV_OPTIMIZATION_FLAG_PERFORMANCE);
+    ExpectStats(0, 2, 2);
+
+    // Make SPIRV0 the most recently used entry
+    OptimizeSPIRV(SPIRV0, SPV_ENV_VULKAN_1_0, SPIRV_OPTIMIZATION_FLAG_PERFORMANCE);
+    ExpectStats(1, 2, 2);
+
+    // SPIRV1 is the least recently used entry and must be evicted
+    OptimizeSPIRV(SPIRV2, SPV_ENV_VULKAN_1_0, SPIRV_OPTIMIZATION_FLAG_PERFORMANCE);
+    ExpectStats(1, 3, 2);
+    EXPECT_LE(GetSPIRVOptimizationCacheStats().DataSize, EntrySize * 5 / 2);
+
+    OptimizeSPIRV(SPIRV0, SPV_ENV_VULKAN_1_0, SPIRV_OPTIMIZATION_FLAG_PERFORMANCE);
+    ExpectStats(2, 3, 2);
+    OptimizeSPIRV(SPIRV2, SPV_ENV_VULKAN_1_0, SPIRV_OPTIMIZATION_FLAG_PERFORMANCE);
+    ExpectStats(3, 3, 2);
+    OptimizeSPIRV(SPIRV1, SPV_ENV_VULKAN_1_0, SPIRV_OPTIMIZATION_FLAG_PERFORMANCE);
+    ExpectStats(3, 4, 2);
+
+    // Shrinking the cache evicts the entries that no longer fit
+    SetSPIRVOptimizationCacheSize(EntrySize);
+    ExpectStats(3, 4, 1);
+
+    // Zero size disables the cache and releases all entries
+    SetSPIRVOptimizationCacheSize(0);
+    ExpectStats(3, 4, 0);
+}
+
+TEST_F(SPIRVOptimizationCacheTest, StoreLoad)
+{
+    const std::vector<uint32_t> SPIRV0 = AssembleComputeShader(1);
+    const std::vector<uint32_t> SPIRV1 = AssembleComputeShader(2);
+
+    const std::vector<uint32_t> Optimized0 = OptimizeSPIRV(SPIRV0, SPV_ENV_VULKAN_1_0, SPIRV_OPTIMIZATION_FLAG_PERFORMANCE);
+    const std::vector<uint32_t> Optimized1 = OptimizeSPIRV(SPIRV1, SPV_ENV_VULKAN_1_0, SPIRV_OPTIMIZATION_FLAG_LEGALIZATION);
+    ExpectStats(0, 2, 2);
+    const size_t DataSize = GetSPIRVOptimizationCacheStats().DataSize;
+
+    RefCntAutoPtr<IDataBlob> pData;
+    ASSERT_TRUE(StoreSPIRVOptimizationCache(&pData));
+    ASSERT_NE(pData, nullptr);
+
+    ClearSPIRVOptimizationCache();
+    ExpectStats(0, 0, 0);
+
+    ASSERT_TRUE(LoadSPIRVOptimizationCache(pData));
+    ExpectStats(0, 0, 2);
+    EXPECT_EQ(GetSPIRVOptimizationCacheStats().DataSize, DataSize);
+
+    EXPECT_EQ(OptimizeSPIRV(SPIRV0, SPV_ENV_VULKAN_1_0, SPIRV_OPTIMIZATION_FLAG_PERFORMANCE), Optimized0);
+    EXPECT_EQ(OptimizeSPIRV(SPIRV1, SPV_ENV_VULKAN_1_0, SPIRV_OPTIMIZATION_FLAG_LEGALIZATION), Optimized1);
+    ExpectStats(2, 0, 2);
+
+    // Loading the same data again must not duplicate the entries
+    ASSERT_TRUE(LoadSPIRVOptimizationCache(pData));
+    ExpectStats(2, 0, 2);
+    EXPECT_EQ(GetSPIRVOptimizationCacheStats().DataSize, DataSize);
+
+    // The data can't be loaded when the cache is disabled
+    SetSPIRVOptimizationCacheSize(0);
+    EXPECT_FALSE(LoadSPIRVOptimizationCache(pData));
+    ExpectStats(2, 0, 0);
+}
+
+TEST_F(SPIRVOptimizationCacheTest, CorruptData)
+{
+    OptimizeSPIRV(AssembleComputeShader(1), SPV_ENV_VULKAN_1_0, SPIRV_OPTIMIZATION_FLAG_PERFORMANCE);
+    OptimizeSPIRV(AssembleComputeShader(2), SPV_ENV_VULKAN_1_0, SPIRV_OPTIMIZATION_FLAG_PERFORMANCE);
+
+    RefCntAutoPtr<IDataBlob> pData;
+    ASSERT_TRUE(StoreSPIRVOptimizationCache(&pData));
+    ASSERT_NE(pData, nullptr);
+
+    const Uint8* pSrcData = pData->GetConstDataPtr<Uint8>();
+    const size_t DataSize = pData->GetSize();
+    ASSERT_GT(DataSize, size_t{64});
+
+    ClearSPIRVOptimizationCache();
+
+    // Truncated data
+    {
+        TestingEnvironment::ErrorScope ExpectedErrors{"SPIR-V optimization cache data is too small"};
+
+        RefCntAutoPtr<DataBlobImpl> pTruncated = DataBlobImpl::Create(8, pSrcData);
+        EXPECT_FALSE(LoadSPIRVOptimizationCache(pTruncated));
+    }
+    for (size_t Size : {DataSize / 2, DataSize - 4, DataSize - 1})
+    {
+        TestingEnvironment::ErrorScope ExpectedErrors{"SPIR-V optimization cache data is corrupted"};
+
+        RefCntAutoPtr<DataBlobImpl> pTruncated = DataBlobImpl::Create(Size, pSrcData);
+        EXPECT_FALSE(LoadSPIRVOptimizationCache(pTruncated));
+        ExpectStats(0, 0, 0);
+    }
+
+    // Trailing data
+    {
+        TestingEnvironment::ErrorScope ExpectedErrors{"SPIR-V optimization cache data is corrupted"};
+
+        RefCntAutoPtr<DataBlobImpl> pExtended = DataBlobImpl::Create(DataSize + 4);
+        memcpy(pExtended->GetDataPtr(), pSrcData, DataSize);
+        EXPECT_FALSE(LoadSPIRVOptimizationCache(pExtended));
+        ExpectStats(0, 0, 0);
+    }
+
+    // Flip a byte in the header (after the magic number and version) and in the entries
+    for (size_t Offset : {size_t{8}, size_t{16}, size_t{24}, size_t{32}, size_t{48}, DataSize / 2, DataSize - 1})
+    {
+        TestingEnvironment::ErrorScope ExpectedErrors{"SPIR-V optimization cache data is corrupted"};
+
+        RefCntAutoPtr<DataBlobImpl> pCorrupt = DataBlobImpl::Create(DataSize, pSrcData);
+        pCorrupt->GetDataPtr<Uint8>()[Offset] ^= 0x5A;
+        EXPECT_FALSE(LoadSPIRVOptimizationCache(pCorrupt)) << "Offset: " << Offset;
+        ExpectStats(0, 0, 0);
+    }
+
+    // The original data must still load
+    EXPECT_TRUE(LoadSPIRVOptimizationCache(pData));
+    ExpectStats(0, 0, 2);
+}
+
+} // namespace
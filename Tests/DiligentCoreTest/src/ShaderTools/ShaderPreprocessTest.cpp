@@ -158,6 +158,40 @@ TEST(ShaderPreprocessTest, InvalidInclude)
     }
 }
 
+TEST(ShaderPreprocessTest, FindShaderIncludes)
+{
+    {
+        constexpr char Source[] =
+            "#include \"File0.h\"\n"
+            "// #include \"Commented.h\"\n"
+            "/* #include \"Commented.h\" */\n"
+            "#define MACRO\n"
+            "  #  include <File1.h>\n"
+            "#include \"File0.h\"\n";
+
+        std::vector<std::string> Includes;
+        EXPECT_TRUE(FindShaderIncludes(Source, 0, Includes));
+        ASSERT_EQ(Includes.size(), 3u);
+        EXPECT_EQ(Includes[0], "File0.h");
+        EXPECT_EQ(Includes[1], "File1.h");
+        EXPECT_EQ(Includes[2], "File0.h");
+    }
+
+    {
+        std::vector<std::string> Includes;
+        EXPECT_TRUE(FindShaderIncludes("", 0, Includes));
+        EXPECT_TRUE(FindShaderIncludes(nullptr, 0, Includes));
+        EXPECT_TRUE(Includes.empty());
+    }
+
+    {
+        TestingEnvironment::ErrorScope ExpectedErrors{"Failed to find includes in InvalidInclude.hlsl"};
+
+        std::vector<std::string> Includes;
+        EXPECT_FALSE(FindShaderIncludes("#include \"File0.h", 0, Includes, "InvalidInclude.hlsl"));
+    }
+}
+
 TEST(ShaderPreprocessTest, UnrollIncludes)
 {
     RefCntAutoPtr<IShaderSourceInputStreamFactory> pShaderSourceFactory;
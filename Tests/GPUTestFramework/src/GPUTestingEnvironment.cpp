@@ -352,9 +352,14 @@ GPUTestingEnvironment::GPUTestingEnvironment(const CreateInfo& EnvCI, const Swap
             // Always enable validation
             EngineCI.SetValidationLevel(VALIDATION_LEVEL_1);
 
-            EngineCI.Window   = Window;
-            EngineCI.Features = EnvCI.Features;
-            NumDeferredCtx    = 0;
+            EngineCI.Window              = Window;
+            EngineCI.Features            = EnvCI.Features;
+            NumDeferredCtx               = EnvCI.NumDeferredContexts;
+            EngineCI.NumDeferredContexts = NumDeferredCtx / 2;
+#    if PLATFORM_LINUX
+            // CreateNativeWindow() calls XInitThreads
+            EngineCI.XInitThreadsCalled = true;
+#    endif
             ppContexts.resize(std::max(size_t{1}, ContextCI.size()) + NumDeferredCtx);
             RefCntAutoPtr<ISwapChain> pSwapChain; // We will use testing swap chain instead
             pFactoryOpenGL->CreateDeviceAndSwapChainGL(
@@ -39,6 +39,9 @@ namespace Testing
 
 NativeWindow GPUTestingEnvironment::CreateNativeWindow()
 {
+    // The OpenGL backend uses the display in the asynchronous shader compilation threads
+    XInitThreads();
+
     auto* display = XOpenDisplay(0);
 
     // clang-format off
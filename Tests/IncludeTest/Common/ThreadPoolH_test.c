@@ -39,6 +39,8 @@ void TestAsyncTask()
     bool IsFinished = IAsyncTask_IsFinished((IAsyncTask*)NULL);
     (void)IsFinished;
     IAsyncTask_WaitForCompletion((IAsyncTask*)NULL);
+    bool IsComplete = IAsyncTask_WaitForCompletionWithTimeout((IAsyncTask*)NULL, 1000);
+    (void)IsComplete;
     IAsyncTask_WaitUntilRunning((IAsyncTask*)NULL);
 }
 
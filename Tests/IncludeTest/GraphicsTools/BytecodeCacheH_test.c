@@ -38,5 +38,6 @@ void TestBytecodeCacheCInterface()
     IBytecodeCache_AddBytecode(pCache, (ShaderCreateInfo*)NULL, (IDataBlob*)NULL);
     IBytecodeCache_RemoveBytecode(pCache, (ShaderCreateInfo*)NULL);
     IBytecodeCache_Store(pCache, (IDataBlob**)NULL);
+    IBytecodeCache_StoreIncremental(pCache, (IDataBlob**)NULL);
     IBytecodeCache_Clear(pCache);
 }
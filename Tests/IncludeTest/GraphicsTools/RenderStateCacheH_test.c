@@ -48,6 +48,9 @@ void TestRenderStateCacheCInterface()
     IRenderStateCache_CreateComputePipelineState(pCache, (ComputePipelineStateCreateInfo*)NULL, &pPSO);
     IRenderStateCache_CreateRayTracingPipelineState(pCache, (RayTracingPipelineStateCreateInfo*)NULL, &pPSO);
     IRenderStateCache_CreateTilePipelineState(pCache, (TilePipelineStateCreateInfo*)NULL, &pPSO);
+    IRenderStateCache_CreateShaders(pCache, 1, (ShaderCreateInfo*)NULL, (IThreadPool*)NULL, &pShader, (IAsyncTask**)NULL);
+    IRenderStateCache_CreateGraphicsPipelineStates(pCache, 1, (GraphicsPipelineStateCreateInfo*)NULL, (IThreadPool*)NULL, &pPSO, (IAsyncTask**)NULL);
+    IRenderStateCache_CreateComputePipelineStates(pCache, 1, (ComputePipelineStateCreateInfo*)NULL, (IThreadPool*)NULL, &pPSO, (IAsyncTask**)NULL);
     IRenderStateCache_WriteToBlob(pCache, 1234, (IDataBlob**)NULL);
     IRenderStateCache_WriteToStream(pCache, 1234, (IFileStream*)NULL);
     IRenderStateCache_Reset(pCache);